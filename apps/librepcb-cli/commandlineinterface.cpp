@@ -30,7 +30,7 @@
 #include <librepcb/core/export/bomcsvwriter.h>
 #include <librepcb/core/export/graphicsexport.h>
 #include <librepcb/core/export/pickplacecsvwriter.h>
-#include <librepcb/core/fileio/csvfile.h>
+#include <librepcb/core/fileio/csvwriter.h>
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/library/cat/componentcategory.h>
@@ -40,6 +40,7 @@
 #include <librepcb/core/library/library.h>
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/memoryaccounting.h>
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/board/boardd356netlistexport.h>
 #include <librepcb/core/project/board/boardfabricationoutputsettings.h>
@@ -56,11 +57,16 @@
 #include <librepcb/core/project/projectattributelookup.h>
 #include <librepcb/core/project/projectloader.h>
 #include <librepcb/core/project/schematic/schematicpainter.h>
+#include <librepcb/core/tracer.h>
+#include <librepcb/core/utils/concurrency.h>
+#include <librepcb/core/utils/scopeguard.h>
 #include <librepcb/core/utils/toolbox.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 
 #include <algorithm>
+#include <type_traits>
 
 /*******************************************************************************
  *  Namespace
@@ -82,6 +88,12 @@ CommandLineInterface::CommandLineInterface() noexcept {
 int CommandLineInterface::execute(const QStringList& args) noexcept {
   QStringList positionalArgNames;
   QMap<QString, QPair<QString, QString>> commands = {
+      {"batch",
+       {tr("Execute multiple commands from a file in a single process."),
+        "batch [command_options]"}},  // no tr()!
+      {"benchmark",
+       {tr("Measure the execution time of common operations on a project."),
+        "benchmark [command_options]"}},  // no tr()!
       {"open-project",
        {tr("Open a project to execute project-related tasks."),
         "open-project [command_options]"}},  // no tr()!
@@ -106,6 +118,19 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
   parser.addOption(versionOption);
   QCommandLineOption verboseOption({"v", "verbose"}, tr("Verbose output."));
   parser.addOption(verboseOption);
+  QCommandLineOption traceOption(
+      "trace",
+      tr("Write a timing trace of expensive operations to this file, in the "
+         "Chrome trace JSON format (e.g. for Perfetto)."),
+      tr("file"));
+  parser.addOption(traceOption);
+  QCommandLineOption jobsOption(
+      "jobs",
+      tr("Maximum number of threads used by each parallelized operation "
+         "(default: number of CPU cores). Nested operations may use additional "
+         "threads."),
+      tr("count"));
+  parser.addOption(jobsOption);
   parser.addPositionalArgument("command",
                                tr("The command to execute (see list below)."));
   positionalArgNames.append("command");
@@ -127,6 +152,18 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
          "settings. If not set, the settings from the boards will be used "
          "instead."),
       tr("file"));
+  QCommandLineOption drcProfileOption(
+      "drc-profile",
+      tr("Name of the DRC profile to use, either '%1' (default), '%2' or a "
+         "custom profile defined in the DRC settings.")
+          .arg("full", "quick"),
+      tr("name"));
+  QCommandLineOption drcTimingsOption(
+      "drc-timings",
+      tr("Write the execution time and the number of messages of each DRC "
+         "check to this JSON file. Only makes sense in conjunction with '%1'.")
+          .arg("--drc"),
+      tr("file"));
   QCommandLineOption runSpecificJobOption(
       "run-job",
       tr("Run a particular output job. Can be given multiple times to run "
@@ -144,6 +181,16 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
       tr("Override the output base directory of jobs. If not set, the "
          "standard output directory from the project is used."),
       tr("path"));
+  QCommandLineOption outputCacheOption(
+      "output-cache",
+      tr("Reuse the output files of jobs whose inputs did not change since "
+         "their last run with this option, instead of running these jobs "
+         "again."));
+  QCommandLineOption skipUnchangedOption(
+      "skip-unchanged",
+      tr("Do not overwrite output files whose content did not change "
+         "(ignoring creation dates), to keep their modification time. "
+         "Afterwards, the files which actually changed are listed."));
   QCommandLineOption exportSchematicsOption(
       "export-schematics",
       tr("Export schematics to given file(s). Existing files will be "
@@ -176,8 +223,9 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
   QCommandLineOption pcbFabricationSettingsOption(
       "pcb-fabrication-settings",
       tr("Override PCB fabrication output settings by providing a *.lp file "
-         "containing custom settings. If not set, the settings from the boards "
-         "will be used instead."),
+         "containing custom settings. Can be given multiple times to export "
+         "several settings profiles at once. If not set, the settings from the "
+         "boards will be used instead."),
       tr("file"));
   QCommandLineOption exportPnpTopOption(
       "export-pnp-top",
@@ -241,6 +289,32 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
          "there would be changes when saving the project. Note that "
          "this option is not available for *.lppz files."));
 
+  // Define options for "benchmark"
+  QCommandLineOption benchIterationsOption(
+      "iterations",
+      tr("Number of times each operation is executed. The median of all "
+         "iterations is reported (default: %1).")
+          .arg(5),
+      tr("count"));
+  QCommandLineOption benchBaselineOption(
+      "baseline",
+      tr("Compare the results with a JSON file written by '%1' and report "
+         "failure (exit code = 1) if any operation got slower than allowed "
+         "by '%2'.")
+          .arg("--output", "--threshold"),
+      tr("file"));
+  QCommandLineOption benchOutputOption(
+      "output",
+      tr("Write the results to this JSON file, e.g. to be used as a baseline "
+         "for later runs."),
+      tr("file"));
+  QCommandLineOption benchThresholdOption(
+      "threshold",
+      tr("Maximum allowed slowdown compared to the baseline, in percent "
+         "(default: %1).")
+          .arg(20),
+      tr("percent"));
+
   // Define options for "open-library"
   QCommandLineOption libAllOption(
       "all",
@@ -300,7 +374,25 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
   // Add command-dependent options
   const QString command = parser.positionalArguments().value(0);
   parser.clearPositionalArguments();
-  if (command == "open-project") {
+  if (command == "batch") {
+    parser.addPositionalArgument(command, commands[command].first,
+                                 commands[command].second);
+    parser.addPositionalArgument(
+        "file",
+        tr("Path to a JSON file containing an array of commands, each given as "
+           "an array of command line arguments. Use '-' to read from stdin."));
+    positionalArgNames.append("file");
+  } else if (command == "benchmark") {
+    parser.addPositionalArgument(command, commands[command].first,
+                                 commands[command].second);
+    parser.addPositionalArgument("project",
+                                 tr("Path to project file (*.lpp[z])."));
+    positionalArgNames.append("project");
+    parser.addOption(benchIterationsOption);
+    parser.addOption(benchBaselineOption);
+    parser.addOption(benchOutputOption);
+    parser.addOption(benchThresholdOption);
+  } else if (command == "open-project") {
     parser.addPositionalArgument(command, commands[command].first,
                                  commands[command].second);
     parser.addPositionalArgument("project",
@@ -309,10 +401,14 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     parser.addOption(ercOption);
     parser.addOption(drcOption);
     parser.addOption(drcSettingsOption);
+    parser.addOption(drcProfileOption);
+    parser.addOption(drcTimingsOption);
     parser.addOption(runSpecificJobOption);
     parser.addOption(runAllJobsOption);
     parser.addOption(customJobsOption);
     parser.addOption(customOutDirOption);
+    parser.addOption(outputCacheOption);
+    parser.addOption(skipUnchangedOption);
     parser.addOption(exportSchematicsOption);
     parser.addOption(exportBomOption);
     parser.addOption(exportBoardBomOption);
@@ -379,6 +475,24 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     OccModel::setVerboseOutput(true);
   }
 
+  // --trace
+  if (parser.isSet(traceOption)) {
+    Tracer::instance().setOutputFile(
+        FilePath(QFileInfo(parser.value(traceOption)).absoluteFilePath()));
+  }
+
+  // --jobs
+  if (parser.isSet(jobsOption)) {
+    bool ok = false;
+    const int jobs = parser.value(jobsOption).toInt(&ok);
+    if ((!ok) || (jobs < 1)) {
+      printErr(
+          tr("Invalid number of jobs: '%1'").arg(parser.value(jobsOption)));
+      return 1;
+    }
+    Concurrency::setMaxThreadCount(jobs);
+  }
+
   // --help (also shown if no arguments supplied)
   if (parser.isSet(helpOption) || (args.count() <= 1)) {
     print(helpText);
@@ -421,22 +535,53 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
 
   // Execute command
   bool cmdSuccess = false;
-  if (command == "open-project") {
+  if (command == "batch") {
+    cmdSuccess = runBatch(executable,  // executable
+                          positionalArgs.value(1)  // batch file path
+    );
+  } else if (command == "benchmark") {
+    bool iterationsOk = true;
+    bool thresholdOk = true;
+    const int iterations = parser.isSet(benchIterationsOption)
+        ? parser.value(benchIterationsOption).toInt(&iterationsOk)
+        : 5;
+    const qreal threshold = parser.isSet(benchThresholdOption)
+        ? parser.value(benchThresholdOption).toDouble(&thresholdOk)
+        : 20;
+    if ((!iterationsOk) || (iterations < 1)) {
+      printErr(tr("ERROR: Invalid number of iterations: '%1'")
+                   .arg(parser.value(benchIterationsOption)));
+    } else if ((!thresholdOk) || (threshold < 0)) {
+      printErr(tr("ERROR: Invalid threshold: '%1'")
+                   .arg(parser.value(benchThresholdOption)));
+    } else {
+      cmdSuccess = runBenchmark(positionalArgs.value(1),  // project filepath
+                                iterations,  // number of iterations
+                                parser.value(benchBaselineOption),  // baseline
+                                parser.value(benchOutputOption),  // output
+                                threshold  // allowed slowdown [%]
+      );
+    }
+  } else if (command == "open-project") {
     cmdSuccess = openProject(
         positionalArgs.value(1),  // project filepath
         parser.isSet(ercOption),  // run ERC
         parser.isSet(drcOption),  // run DRC
         parser.value(drcSettingsOption),  // DRC settings
+        parser.value(drcProfileOption),  // DRC profile
+        parser.value(drcTimingsOption),  // DRC timings output
         parser.values(runSpecificJobOption),  // run specific output jobs
         parser.isSet(runAllJobsOption),  // run all output jobs
         parser.value(customJobsOption).trimmed(),  // custom jobs file path
         parser.value(customOutDirOption).trimmed(),  // custom jobs outdir
+        parser.isSet(outputCacheOption),  // reuse unchanged job outputs
+        parser.isSet(skipUnchangedOption),  // skip unchanged output files
         parser.values(exportSchematicsOption),  // export schematics
         parser.values(exportBomOption),  // export generic BOM
         parser.values(exportBoardBomOption),  // export board BOM
         parser.value(bomAttributesOption),  // BOM attributes
         parser.isSet(exportPcbFabricationDataOption),  // export PCB fab. data
-        parser.value(pcbFabricationSettingsOption),  // PCB fab. settings
+        parser.values(pcbFabricationSettingsOption),  // PCB fab. settings
         parser.values(exportPnpTopOption),  // export PnP top
         parser.values(exportPnpBottomOption),  // export PnP bottom
         parser.values(exportNetlistOption),  // export netlist
@@ -481,11 +626,14 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
 
 bool CommandLineInterface::openProject(
     const QString& projectFile, bool runErc, bool runDrc,
-    const QString& drcSettingsPath, const QStringList& runJobs, bool runAllJobs,
+    const QString& drcSettingsPath, const QString& drcProfile,
+    const QString& drcTimingsPath, const QStringList& runJobs, bool runAllJobs,
     const QString& customJobsPath, const QString& customOutDir,
-    const QStringList& exportSchematicsFiles, const QStringList& exportBomFiles,
-    const QStringList& exportBoardBomFiles, const QString& bomAttributes,
-    bool exportPcbFabricationData, const QString& pcbFabricationSettingsPath,
+    bool outputCache, bool skipUnchanged,
+    const QStringList& exportSchematicsFiles,
+    const QStringList& exportBomFiles, const QStringList& exportBoardBomFiles,
+    const QString& bomAttributes, bool exportPcbFabricationData,
+    const QStringList& pcbFabricationSettingsPaths,
     const QStringList& exportPnpTopFiles,
     const QStringList& exportPnpBottomFiles,
     const QStringList& exportNetlistFiles, const QStringList& boardNames,
@@ -497,6 +645,12 @@ bool CommandLineInterface::openProject(
     QMap<FilePath, int> writtenFilesCounter;
     QMap<FilePath, int> writtenOutputJobFilesCounter;
 
+    // The bundled fonts are only needed when rendering graphics.
+    if ((!exportSchematicsFiles.isEmpty()) || (!runJobs.isEmpty()) ||
+        runAllJobs) {
+      Application::loadBundledFonts();
+    }
+
     // Open project
     FilePath projectFp(QFileInfo(projectFile).absoluteFilePath());
     print(tr("Open project '%1'...").arg(prettyPath(projectFp, projectFile)));
@@ -639,9 +793,9 @@ bool CommandLineInterface::openProject(
       foreach (Board* board, boards) {
         qInfo().nospace().noquote() << "Rebuilding all planes of board '"
                                     << *board->getName() << "'...";
-        BoardPlaneFragmentsBuilder builder;
-        builder.runSynchronously(*board);  // can throw
       }
+      BoardPlaneFragmentsBuilder::runSynchronously(
+          boards, Application::getCacheDir().getPathTo("planes"));  // can throw
     } else {
       qInfo() << "No need to rebuild planes, thus skipped.";
     }
@@ -707,11 +861,36 @@ bool CommandLineInterface::openProject(
           boardsToCheck.clear();  // avoid exporting any boards
         }
       }
+      QJsonArray timings;
       foreach (Board* board, boardsToCheck) {
         print("  " % tr("Board '%1':").arg(*board->getName()));
-        BoardDesignRuleCheck drc(
-            *board, customSettings ? *customSettings : board->getDrcSettings());
-        drc.execute(false);
+        const BoardDesignRuleCheckSettings& settings =
+            customSettings ? *customSettings : board->getDrcSettings();
+        const QString profileName = drcProfile.isEmpty()
+            ? BoardDesignRuleCheckSettings::getFullProfile().name
+            : drcProfile;
+        const tl::optional<BoardDesignRuleCheckSettings::Profile> profile =
+            settings.findProfile(profileName);
+        if (!profile) {
+          printErr("    " %
+                   tr("ERROR: Unknown DRC profile: '%1'").arg(profileName));
+          success = false;
+          continue;
+        }
+        BoardDesignRuleCheck drc(*board, settings);
+        drc.execute(*profile);
+        QJsonArray checkTimings;
+        foreach (const auto& timing, drc.getTimings()) {
+          QJsonObject obj;
+          obj["name"] = timing.name;
+          obj["duration_ms"] = timing.durationNs / 1e6;
+          obj["messages"] = timing.messageCount;
+          checkTimings.append(obj);
+        }
+        QJsonObject boardTimings;
+        boardTimings["board"] = *board->getName();
+        boardTimings["checks"] = checkTimings;
+        timings.append(boardTimings);
         int approvedMsgCount = 0;
         const QStringList nonApproved = prepareRuleCheckMessages(
             drc.getMessages(), board->getDrcMessageApprovals(),
@@ -724,6 +903,11 @@ bool CommandLineInterface::openProject(
           success = false;
         }
       }
+      if (!drcTimingsPath.isEmpty()) {
+        const FilePath fp(QFileInfo(drcTimingsPath).absoluteFilePath());
+        FileUtils::writeFile(fp, QJsonDocument(timings).toJson());  // can throw
+        print(QString("  => '%1'").arg(prettyPath(fp, drcTimingsPath)));
+      }
     }
 
     // Run output jobs.
@@ -782,7 +966,24 @@ bool CommandLineInterface::openProject(
           }
           qDebug() << "Using output base directory:"
                    << runner.getOutputDirectory().toNative();
+          runner.setCacheEnabled(outputCache);
+          runner.setSkipUnchangedFiles(skipUnchanged);
           runner.run(jobs);  // can throw
+          if (skipUnchanged) {
+            QList<FilePath> changedFiles;
+            foreach (const FilePath& fp, runner.getWrittenFiles()) {
+              if (!runner.getUnchangedFiles().contains(fp)) {
+                changedFiles.append(fp);
+              }
+            }
+            std::sort(changedFiles.begin(), changedFiles.end());
+            print(tr("Changed output files: %1 of %2")
+                      .arg(changedFiles.count())
+                      .arg(runner.getWrittenFiles().count()));
+            foreach (const FilePath& fp, changedFiles) {
+              print(QString("  * '%1'").arg(prettyPath(fp, projectFile)));
+            }
+          }
         } catch (const Exception& e) {
           printErr(tr("ERROR:") % " " % e.getMsg());
           success = false;
@@ -874,8 +1075,9 @@ bool CommandLineInterface::openProject(
             QString suffix = destStr.split('.').last().toLower();
             if (suffix == "csv") {
               BomCsvWriter writer(*bom);
-              std::shared_ptr<CsvFile> csv = writer.generateCsv();  // can throw
-              csv->saveToFile(fp);  // can throw
+              CsvWriter csv;
+              writer.writeCsv(csv);
+              csv.saveToFile(fp);  // can throw
               writtenFilesCounter[fp]++;
             } else {
               printErr("  " % tr("ERROR: Unknown extension '%1'.").arg(suffix));
@@ -889,31 +1091,36 @@ bool CommandLineInterface::openProject(
     // Export PCB fabrication data
     if (exportPcbFabricationData) {
       print(tr("Export PCB fabrication data..."));
-      tl::optional<BoardFabricationOutputSettings> customSettings;
+      QVector<BoardFabricationOutputSettings> customSettings;
       QList<Board*> boardsToExport = boards;
-      if (!pcbFabricationSettingsPath.isEmpty()) {
+      foreach (const QString& settingsPath, pcbFabricationSettingsPaths) {
         try {
           qDebug() << "Load custom fabrication output settings:"
-                   << pcbFabricationSettingsPath;
-          const FilePath fp(
-              QFileInfo(pcbFabricationSettingsPath).absoluteFilePath());
+                   << settingsPath;
+          const FilePath fp(QFileInfo(settingsPath).absoluteFilePath());
           const SExpression root =
               SExpression::parse(FileUtils::readFile(fp), fp);
-          customSettings = BoardFabricationOutputSettings(root);  // can throw
+          customSettings.append(
+              BoardFabricationOutputSettings(root));  // can throw
         } catch (const Exception& e) {
           printErr(
               tr("ERROR: Failed to load custom settings: %1").arg(e.getMsg()));
           success = false;
           boardsToExport.clear();  // avoid exporting any boards
+          break;
         }
       }
       foreach (const Board* board, boardsToExport) {
         print("  " % tr("Board '%1':").arg(*board->getName()));
+        // All settings profiles are exported at once to generate the files
+        // with the same content (e.g. copper layers) only once.
         BoardGerberExport grbExport(*board);
-        grbExport.exportPcbLayers(
-            customSettings
-                ? *customSettings
-                : board->getFabricationOutputSettings());  // can throw
+        if (customSettings.isEmpty()) {
+          grbExport.exportPcbLayers(
+              board->getFabricationOutputSettings());  // can throw
+        } else {
+          grbExport.exportPcbLayers(customSettings);  // can throw
+        }
         foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
           print(QString("    => '%1'").arg(prettyPath(fp, projectFile)));
           writtenFilesCounter[fp]++;
@@ -960,8 +1167,9 @@ bool CommandLineInterface::openProject(
               PickPlaceCsvWriter writer(*data);
               writer.setIncludeMetadataComment(true);
               writer.setBoardSide(job.boardSideCsv);
-              std::shared_ptr<CsvFile> csv = writer.generateCsv();  // can throw
-              csv->saveToFile(fp);  // can throw
+              CsvWriter csv;
+              writer.writeCsv(csv);
+              csv.saveToFile(fp);  // can throw
               writtenFilesCounter[fp]++;
             } else if (suffix == "gbr") {
               BoardGerberExport gen(*board);
@@ -1039,6 +1247,11 @@ bool CommandLineInterface::openProject(
       success = false;
     }
 
+    // Memory usage of the opened project (only visible with --verbose)
+    foreach (const QString& line, MemoryAccounting::instance().getReport()) {
+      qDebug().noquote() << "Memory usage:" << line;
+    }
+
     return success;
   } catch (const Exception& e) {
     printErr(tr("ERROR: %1").arg(e.getMsg()));
@@ -1061,122 +1274,30 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
     std::unique_ptr<Library> lib =
         Library::open(std::unique_ptr<TransactionalDirectory>(
             new TransactionalDirectory(libFs)));  // can throw
-    processLibraryElement(libDir, *libFs, *lib, runCheck, minifyStepFiles, save,
-                          strict,
-                          success);  // can throw
-
-    // Open all component categories
-    if (all) {
-      QStringList elements = lib->searchForElements<ComponentCategory>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 component categories...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<ComponentCategory> element =
-            ComponentCategory::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
-
-    // Open all package categories
-    if (all) {
-      QStringList elements = lib->searchForElements<PackageCategory>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 package categories...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<PackageCategory> element =
-            PackageCategory::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
+    processLibraryElement(libDir, *libFs, *lib,
+                          runCheck ? lib->runChecks() : RuleCheckMessageList(),
+                          {}, runCheck, save, strict, success);  // can throw
 
-    // Open all symbols
+    // Open all library elements
     if (all) {
-      QStringList elements = lib->searchForElements<Symbol>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 symbols...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Symbol> element =
-            Symbol::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
-
-    // Open all packages
-    if (all) {
-      QStringList elements = lib->searchForElements<Package>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 packages...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Package> element =
-            Package::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
-
-    // Open all components
-    if (all) {
-      QStringList elements = lib->searchForElements<Component>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 components...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Component> element =
-            Component::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
-    }
-
-    // Open all devices
-    if (all) {
-      QStringList elements = lib->searchForElements<Device>();
-      elements.sort();  // For deterministic console output.
-      print(tr("Process %1 devices...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Device> element =
-            Device::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<ComponentCategory>(
+          libDir, *lib, tr("Process %1 component categories..."), runCheck,
+          minifyStepFiles, save, strict, success);  // can throw
+      processLibraryElements<PackageCategory>(
+          libDir, *lib, tr("Process %1 package categories..."), runCheck,
+          minifyStepFiles, save, strict, success);  // can throw
+      processLibraryElements<Symbol>(libDir, *lib, tr("Process %1 symbols..."),
+                                     runCheck, minifyStepFiles, save, strict,
+                                     success);  // can throw
+      processLibraryElements<Package>(
+          libDir, *lib, tr("Process %1 packages..."), runCheck,
+          minifyStepFiles, save, strict, success);  // can throw
+      processLibraryElements<Component>(
+          libDir, *lib, tr("Process %1 components..."), runCheck,
+          minifyStepFiles, save, strict, success);  // can throw
+      processLibraryElements<Device>(libDir, *lib, tr("Process %1 devices..."),
+                                     runCheck, minifyStepFiles, save, strict,
+                                     success);  // can throw
     }
 
     return success;
@@ -1186,9 +1307,66 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
   }
 }
 
+template <typename T>
+void CommandLineInterface::processLibraryElements(
+    const QString& libDir, const Library& lib, const QString& title,
+    bool runCheck, bool minifyStepFiles, bool save, bool strict,
+    bool& success) const {
+  QStringList elements = lib.searchForElements<T>();
+  elements.sort();  // For deterministic console output.
+  print(title.arg(elements.count()));
+
+  // Opening and checking the elements, as well as minifying STEP models,
+  // is the most expensive part, thus it is done on a thread pool. The
+  // remaining steps are done in order from this thread to keep the console
+  // output deterministic.
+  struct LoadedElement {
+    FilePath fp;
+    std::shared_ptr<TransactionalFileSystem> fs;
+    std::shared_ptr<T> element;
+    RuleCheckMessageList messages;
+    QVector<MinifiedStepFile> minifiedSteps;
+  };
+  QThread* thread = QThread::currentThread();
+  const bool minifySteps = minifyStepFiles && std::is_same<T, Package>::value;
+  auto load = [thread, runCheck, minifySteps, save](const FilePath& fp) {
+    LoadedElement loaded;
+    loaded.fp = fp;
+    loaded.fs = TransactionalFileSystem::open(loaded.fp, save);  // can throw
+    loaded.element = T::open(std::unique_ptr<TransactionalDirectory>(
+        new TransactionalDirectory(loaded.fs)));  // can throw
+    if (runCheck) {
+      loaded.messages = loaded.element->runChecks();  // can throw
+    }
+    if (minifySteps) {
+      loaded.minifiedSteps = minifyStepModels(*loaded.fs);
+    }
+    loaded.element->moveToThread(thread);
+    return loaded;
+  };
+  QThreadPool threadPool;  // Waits for all workers on destruction.
+  Concurrency::apply(threadPool);
+  QQueue<QFuture<LoadedElement>> pending;
+  for (int i = 0; (i < elements.count()) || (!pending.isEmpty());) {
+    // Limit the number of loaded elements kept in memory.
+    if ((i < elements.count()) &&
+        (pending.count() < (threadPool.maxThreadCount() * 2))) {
+      const FilePath fp = lib.getDirectory().getAbsPath(elements.at(i++));
+      pending.enqueue(QtConcurrent::run(&threadPool, load, fp));
+      continue;
+    }
+    const LoadedElement loaded = pending.dequeue().result();  // can throw
+    qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(loaded.fp, libDir));
+    processLibraryElement(libDir, *loaded.fs, *loaded.element, loaded.messages,
+                          loaded.minifiedSteps, runCheck, save, strict,
+                          success);  // can throw
+  }
+}
+
 void CommandLineInterface::processLibraryElement(
     const QString& libDir, TransactionalFileSystem& fs,
-    LibraryBaseElement& element, bool runCheck, bool minifyStepFiles, bool save,
+    LibraryBaseElement& element, const RuleCheckMessageList& messages,
+    const QVector<MinifiedStepFile>& minifiedSteps, bool runCheck, bool save,
     bool strict, bool& success) const {
   // Helper function to print an error header to console only once, if
   // there is at least one error.
@@ -1207,31 +1385,21 @@ void CommandLineInterface::processLibraryElement(
     element.save();  // can throw
   }
 
-  // Minify STEP files, if needed.
-  if (minifyStepFiles && dynamic_cast<Package*>(&element)) {
-    foreach (const QString& file, fs.getFiles()) {
-      if (file.endsWith(".step")) {
-        const QString fp = prettyPath(fs.getAbsPath(file), libDir);
-        qInfo().noquote() << tr("Minify STEP model '%1'...").arg(fp);
-        try {
-          const QByteArray content = fs.read(file);  // can throw
-          const QByteArray minified =
-              OccModel::minifyStep(content);  // can throw
-          if (minified != content) {
-            print(tr("  - Minified '%1' from %2 to %3 bytes")
-                      .arg(fp)
-                      .arg(content.size())
-                      .arg(minified.size()));
-            OccModel::loadStep(minified);  // throws if STEP is invalid
-            fs.write(file, minified);
-          }
-        } catch (const Exception& e) {
-          printErrorHeaderOnce();
-          printErr(QString("    - Failed to minify STEP model '%1': %2")
-                       .arg(fp, e.getMsg()));
-          success = false;
-        }
-      }
+  // Write minified STEP files, if needed.
+  foreach (const MinifiedStepFile& step, minifiedSteps) {
+    const QString fp = prettyPath(fs.getAbsPath(step.file), libDir);
+    qInfo().noquote() << tr("Minify STEP model '%1'...").arg(fp);
+    if (!step.error.isEmpty()) {
+      printErrorHeaderOnce();
+      printErr(QString("    - Failed to minify STEP model '%1': %2")
+                   .arg(fp, step.error));
+      success = false;
+    } else if (!step.minified.isNull()) {
+      print(tr("  - Minified '%1' from %2 to %3 bytes")
+                .arg(fp)
+                .arg(step.originalSize)
+                .arg(step.minified.size()));
+      fs.write(step.file, step.minified);
     }
   }
 
@@ -1258,7 +1426,6 @@ void CommandLineInterface::processLibraryElement(
     qInfo().noquote() << tr("Check '%1' for non-approved messages...")
                              .arg(prettyPath(fs.getPath(), libDir));
     int approvedMsgCount = 0;
-    const RuleCheckMessageList messages = element.runChecks();
     const QStringList nonApproved = prepareRuleCheckMessages(
         messages, element.getMessageApprovals(), approvedMsgCount);
     qInfo().noquote() << "  " %
@@ -1288,6 +1455,32 @@ void CommandLineInterface::processLibraryElement(
   fs.discardChanges();
 }
 
+QVector<CommandLineInterface::MinifiedStepFile>
+    CommandLineInterface::minifyStepModels(
+        const TransactionalFileSystem& fs) noexcept {
+  // Note: This method is called from worker threads of the thread pool!
+  QVector<MinifiedStepFile> result;
+  foreach (const QString& file, fs.getFiles()) {
+    if (file.endsWith(".step")) {
+      MinifiedStepFile step{file, 0, QByteArray(), QString()};
+      try {
+        const QByteArray content = fs.read(file);  // can throw
+        step.originalSize = content.size();
+        const QByteArray minified =
+            OccModel::minifyStep(content);  // can throw
+        if (minified != content) {
+          OccModel::loadStep(minified);  // throws if STEP is invalid
+          step.minified = minified;
+        }
+      } catch (const Exception& e) {
+        step.error = e.getMsg();
+      }
+      result.append(step);
+    }
+  }
+  return result;
+}
+
 bool CommandLineInterface::openStep(const QString& filePath, bool minify,
                                     bool tesselate,
                                     const QString& saveTo) const noexcept {
@@ -1364,6 +1557,238 @@ bool CommandLineInterface::openStep(const QString& filePath, bool minify,
   }
 }
 
+bool CommandLineInterface::runBenchmark(const QString& projectFile,
+                                        int iterations,
+                                        const QString& baselinePath,
+                                        const QString& outputPath,
+                                        qreal thresholdPercent) const noexcept {
+  try {
+    bool success = true;
+
+    // Load the baseline first to fail early if it is invalid.
+    QHash<QString, qreal> baseline;  // Key: Operation, value: Median [ms]
+    if (!baselinePath.isEmpty()) {
+      const FilePath fp(QFileInfo(baselinePath).absoluteFilePath());
+      QJsonParseError error;
+      const QJsonDocument doc =
+          QJsonDocument::fromJson(FileUtils::readFile(fp), &error);
+      if (error.error != QJsonParseError::NoError) {
+        throw RuntimeError(__FILE__, __LINE__, error.errorString());
+      }
+      const QJsonValue operations = doc.object().value("operations");
+      if (!operations.isObject()) {
+        throw RuntimeError(
+            __FILE__, __LINE__,
+            tr("The baseline does not contain any operations."));
+      }
+      const QJsonObject obj = operations.toObject();
+      for (auto it = obj.begin(); it != obj.end(); ++it) {
+        const QJsonValue median = it.value().toObject().value("median_ms");
+        if (!median.isDouble()) {
+          throw RuntimeError(
+              __FILE__, __LINE__,
+              tr("Invalid median of operation '%1' in the baseline.")
+                  .arg(it.key()));
+        }
+        baseline.insert(it.key(), median.toDouble());
+      }
+    }
+
+    // Note: The project is opened read-only and saved only into memory, so
+    // the files on disk are never modified.
+    const FilePath projectFp(QFileInfo(projectFile).absoluteFilePath());
+    print(tr("Benchmark project '%1' with %n iteration(s)...", nullptr,
+             iterations)
+              .arg(prettyPath(projectFp, projectFile)));
+    auto openProject = [&projectFp]() {
+      std::shared_ptr<TransactionalFileSystem> fs =
+          TransactionalFileSystem::openRO(projectFp.getParentDir());
+      QString fileName = projectFp.getFilename();
+      if (projectFp.getSuffix() == "lppz") {
+        fs->removeDirRecursively();  // 1) get a clean initial state
+        fs->loadFromZip(projectFp);  // 2) load files from ZIP
+        foreach (const QString& fn, fs->getFiles()) {
+          if (fn.endsWith(".lpp")) {
+            fileName = fn;
+          }
+        }
+      }
+      ProjectLoader loader;
+      return loader.open(std::unique_ptr<TransactionalDirectory>(
+                             new TransactionalDirectory(fs)),
+                         fileName);  // can throw
+    };
+
+    // Output jobs write into a temporary directory.
+    const FilePath outDir = FilePath::getRandomTempPath();
+    auto outDirGuard = scopeGuard([&outDir]() {
+      try {
+        FileUtils::removeDirRecursively(outDir);  // can throw
+      } catch (const Exception& e) {
+        qWarning() << "Failed to remove temporary directory:" << e.getMsg();
+      }
+    });
+
+    QStringList names;  // To keep the order of the operations.
+    QHash<QString, QVector<qint64>> durations;  // Key: Operation
+    QElapsedTimer timer;
+    auto measure = [&](const QString& name, const std::function<void()>& fn) {
+      timer.start();
+      fn();  // can throw
+      const qint64 ns = timer.nsecsElapsed();
+      if (!durations.contains(name)) {
+        names.append(name);
+      }
+      durations[name].append(ns);
+    };
+    for (int i = 0; i < iterations; ++i) {
+      qInfo().noquote() << QString("Iteration %1/%2...").arg(i + 1).arg(
+          iterations);
+      std::unique_ptr<Project> project;
+      measure("load", [&]() { project = openProject(); });  // can throw
+      measure("planes", [&]() {
+        foreach (Board* board, project->getBoards()) {
+          BoardPlaneFragmentsBuilder builder;
+          builder.setFileCache(FilePath());  // Measure actual calculations.
+          builder.runSynchronously(*board);  // can throw
+        }
+      });
+      measure("erc", [&]() {
+        ElectricalRuleCheck erc(*project);
+        erc.runChecks();  // can throw
+      });
+      const QList<BoardDesignRuleCheckSettings::Profile> profiles = {
+          BoardDesignRuleCheckSettings::getFullProfile(),
+          BoardDesignRuleCheckSettings::getQuickProfile(),
+      };
+      foreach (const auto& profile, profiles) {
+        measure("drc-" % profile.name, [&]() {
+          foreach (Board* board, project->getBoards()) {
+            BoardDesignRuleCheck drc(*board, board->getDrcSettings());
+            drc.execute(profile);  // can throw
+          }
+        });
+      }
+      OutputJobRunner runner(*project);
+      runner.setOutputDirectory(outDir);
+      runner.setCacheEnabled(false);
+      for (const auto& job : project->getOutputJobs().values()) {
+        measure("job-" % job->getType() % ":" % *job->getName(),
+                [&]() { runner.run({job}); });  // can throw
+      }
+      measure("save", [&]() { project->save(); });  // can throw
+    }
+
+    // Evaluate the results.
+    QJsonObject operations;
+    foreach (const QString& name, names) {
+      QVector<qint64> values = durations.value(name);
+      std::sort(values.begin(), values.end());
+      const qreal median = values.at(values.count() / 2) / 1e6;
+      QString line = QString("  %1 %2 ms")
+                         .arg(name.leftJustified(40))
+                         .arg(median, 10, 'f', 1);
+      bool regression = false;
+      if (baseline.contains(name)) {
+        const qreal reference = baseline.value(name);
+        const qreal change = (reference > 0)
+            ? (100 * (median - reference) / reference)
+            : qreal(0);
+        line += QString(" (%1%2%)")
+                    .arg((change >= 0) ? "+" : "")
+                    .arg(change, 0, 'f', 1);
+        // Ignore differences of less than a millisecond since they are
+        // usually just noise.
+        regression =
+            (change > thresholdPercent) && ((median - reference) >= 1);
+      }
+      if (regression) {
+        printErr(line % " " % tr("ERROR: Slower than allowed!"));
+        success = false;
+      } else {
+        print(line);
+      }
+      QJsonObject obj;
+      obj["median_ms"] = median;
+      obj["min_ms"] = values.first() / 1e6;
+      obj["max_ms"] = values.last() / 1e6;
+      operations[name] = obj;
+    }
+    if (!outputPath.isEmpty()) {
+      QJsonObject root;
+      root["version"] = Application::getVersion();
+      root["iterations"] = iterations;
+      root["operations"] = operations;
+      const FilePath fp(QFileInfo(outputPath).absoluteFilePath());
+      FileUtils::writeFile(fp, QJsonDocument(root).toJson());  // can throw
+      print(QString("  => '%1'").arg(prettyPath(fp, outputPath)));
+    }
+
+    return success;
+  } catch (const Exception& e) {
+    printErr(tr("ERROR: %1").arg(e.getMsg()));
+    return false;
+  }
+}
+
+bool CommandLineInterface::runBatch(const QString& executable,
+                                    const QString& filePath) noexcept {
+  try {
+    // Read the batch file.
+    QByteArray content;
+    if (filePath == "-") {
+      QFile file;
+      file.open(stdin, QIODevice::ReadOnly);
+      content = file.readAll();
+    } else {
+      const FilePath fp(QFileInfo(filePath).absoluteFilePath());
+      print(tr("Open batch file '%1'...").arg(prettyPath(fp, filePath)));
+      content = FileUtils::readFile(fp);  // can throw
+    }
+
+    // Parse all commands before executing any of them to fail early.
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(content, &error);
+    if (error.error != QJsonParseError::NoError) {
+      printErr(tr("ERROR: %1").arg(error.errorString()));
+      return false;
+    } else if (!doc.isArray()) {
+      printErr(tr("ERROR: %1").arg(tr("The file does not contain an array.")));
+      return false;
+    }
+    QList<QStringList> commands;
+    foreach (const QJsonValue& value, doc.array()) {
+      QStringList args;
+      foreach (const QJsonValue& arg, value.toArray()) {
+        args.append(arg.toString());
+      }
+      if (args.isEmpty() || (args.first() == "batch")) {
+        printErr(tr("ERROR: %1").arg(tr("Invalid command in batch file.")));
+        return false;
+      }
+      commands.append(args);
+    }
+
+    // Execute all commands within this process, thus the (expensive)
+    // application initialization is done only once. Note that all commands
+    // are executed, even if some of them fail.
+    bool success = true;
+    for (int i = 0; i < commands.count(); ++i) {
+      print(tr("Execute command %1 of %2: %3")
+                .arg(i + 1)
+                .arg(commands.count())
+                .arg(commands.at(i).join(" ")));
+      if (execute(QStringList{executable} + commands.at(i)) != 0) {
+        success = false;
+      }
+    }
+    return success;
+  } catch (const Exception& e) {
+    printErr(tr("ERROR: %1").arg(e.getMsg()));
+    return false;
+  }
+}
+
 QStringList CommandLineInterface::prepareRuleCheckMessages(
     RuleCheckMessageList messages, const QSet<SExpression>& approvals,
     int& approvedMsgCount) noexcept {
@@ -33,6 +33,7 @@
 namespace librepcb {
 
 class FilePath;
+class Library;
 class LibraryBaseElement;
 class SExpression;
 class TransactionalFileSystem;
@@ -57,15 +58,25 @@ public:
   // General Methods
   int execute(const QStringList& args) noexcept;
 
+private:  // Types
+  struct MinifiedStepFile {
+    QString file;  ///< Relative file path
+    int originalSize;  ///< Size of the original file [bytes]
+    QByteArray minified;  ///< Minified and validated content
+    QString error;  ///< Error message if minification failed
+  };
+
 private:  // Methods
   bool openProject(
       const QString& projectFile, bool runErc, bool runDrc,
-      const QString& drcSettingsPath, const QStringList& runJobs,
+      const QString& drcSettingsPath, const QString& drcProfile,
+      const QString& drcTimingsPath, const QStringList& runJobs,
       bool runAllJobs, const QString& customJobsPath,
-      const QString& customOutDir, const QStringList& exportSchematicsFiles,
+      const QString& customOutDir, bool outputCache, bool skipUnchanged,
+      const QStringList& exportSchematicsFiles,
       const QStringList& exportBomFiles, const QStringList& exportBoardBomFiles,
       const QString& bomAttributes, bool exportPcbFabricationData,
-      const QString& pcbFabricationSettingsPath,
+      const QStringList& pcbFabricationSettingsPaths,
       const QStringList& exportPnpTopFiles,
       const QStringList& exportPnpBottomFiles,
       const QStringList& exportNetlistFiles, const QStringList& boardNames,
@@ -74,12 +85,25 @@ private:  // Methods
       const QString& setDefaultAv, bool save, bool strict) const noexcept;
   bool openLibrary(const QString& libDir, bool all, bool runCheck,
                    bool minifyStepFiles, bool save, bool strict) const noexcept;
+  template <typename T>
+  void processLibraryElements(const QString& libDir, const Library& lib,
+                              const QString& title, bool runCheck,
+                              bool minifyStepFiles, bool save, bool strict,
+                              bool& success) const;
   void processLibraryElement(const QString& libDir, TransactionalFileSystem& fs,
-                             LibraryBaseElement& element, bool runCheck,
-                             bool minifyStepFiles, bool save, bool strict,
+                             LibraryBaseElement& element,
+                             const RuleCheckMessageList& messages,
+                             const QVector<MinifiedStepFile>& minifiedSteps,
+                             bool runCheck, bool save, bool strict,
                              bool& success) const;
+  static QVector<MinifiedStepFile> minifyStepModels(
+      const TransactionalFileSystem& fs) noexcept;
   bool openStep(const QString& filePath, bool minify, bool tesselate,
                 const QString& saveTo) const noexcept;
+  bool runBenchmark(const QString& projectFile, int iterations,
+                    const QString& baselinePath, const QString& outputPath,
+                    qreal thresholdPercent) const noexcept;
+  bool runBatch(const QString& executable, const QString& filePath) noexcept;
   static QStringList prepareRuleCheckMessages(
       RuleCheckMessageList messages, const QSet<SExpression>& approvals,
       int& approvedMsgCount) noexcept;
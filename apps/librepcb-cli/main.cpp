@@ -59,9 +59,9 @@ int main(int argc, char* argv[]) {
   QGuiApplication::setApplicationName("LibrePCB CLI");
   QGuiApplication::setApplicationVersion(Application::getVersion());
 
-  // Perform global initialization tasks. This must be done before any widget is
-  // shown.
-  Application::loadBundledFonts();
+  // Perform global initialization tasks. Note that the bundled fonts are
+  // only loaded on demand by commands which actually render graphics, since
+  // this is not needed for most commands.
   Application::setTranslationLocale(QLocale::system());
 
   // Run application
@@ -24,6 +24,7 @@
 #include <librepcb/core/debug.h>
 #include <librepcb/core/exceptions.h>
 #include <librepcb/core/network/networkaccessmanager.h>
+#include <librepcb/core/tracer.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 #include <librepcb/editor/dialogs/directorylockhandlerdialog.h>
@@ -47,16 +48,24 @@ using namespace librepcb::editor;
 static void setApplicationMetadata() noexcept;
 static void configureApplicationSettings() noexcept;
 static void writeLogHeader() noexcept;
+static void logStartupTime(const char* step) noexcept;
 static int runApplication() noexcept;
 static bool isFileFormatStableOrAcceptUnstable() noexcept;
 static int openWorkspace(FilePath& path);
 static int appExec() noexcept;
 
+/*******************************************************************************
+ *  Global Variables
+ ******************************************************************************/
+
+static QElapsedTimer sStartupTimer;
+
 /*******************************************************************************
  *  main()
  ******************************************************************************/
 
 int main(int argc, char* argv[]) {
+  sStartupTimer.start();
   QApplication app(argc, argv);
 
   // Set the organization / application names must be done very early because
@@ -76,8 +85,12 @@ int main(int argc, char* argv[]) {
 
   // Perform global initialization tasks. This must be done before any widget is
   // shown.
-  Application::loadBundledFonts();
-  Application::setTranslationLocale(QLocale::system());
+  {
+    Tracer::Span span("startup", "Global initialization");
+    Application::loadBundledFonts();
+    Application::setTranslationLocale(QLocale::system());
+  }
+  logStartupTime("Global initialization");
 
   // This is to remove the ugly frames around widgets in all status bars...
   // (from http://www.qtcentre.org/threads/1904)
@@ -159,6 +172,16 @@ static void writeLogHeader() noexcept {
   qInfo() << "Cache directory:" << Application::getCacheDir().toNative();
 }
 
+/*******************************************************************************
+ *  logStartupTime()
+ ******************************************************************************/
+
+static void logStartupTime(const char* step) noexcept {
+  // Startup profile to find out what delays showing the first window.
+  qDebug().nospace() << "Startup: " << step << " finished after "
+                     << sStartupTimer.elapsed() << "ms.";
+}
+
 /*******************************************************************************
  *  openWorkspace()
  ******************************************************************************/
@@ -265,8 +288,12 @@ static int openWorkspace(FilePath& path) {
 
   // Open the workspace (can throw). If it is locked, a dialog will show
   // an error and possibly provides an option to override the lock.
+  std::unique_ptr<Tracer::Span> span(
+      new Tracer::Span("startup", "Open workspace"));
   Workspace ws(wizard.getWorkspacePath(), wizard.getDataDir(),
                DirectoryLockHandlerDialog::createDirectoryLockCallback());
+  logStartupTime("Open workspace");
+  span.reset(new Tracer::Span("startup", "Show control panel"));
 
   // Now since workspace settings are loaded, switch to the locale defined
   // there (until now, the system locale was used).
@@ -299,6 +326,8 @@ static int openWorkspace(FilePath& path) {
   // Open the control panel.
   ControlPanel p(ws, wizard.getWorkspaceContainsNewerFileFormats());
   p.show();
+  span.reset();
+  logStartupTime("Show control panel");
 
   return appExec();
 }
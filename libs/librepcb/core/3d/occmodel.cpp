@@ -77,6 +77,12 @@ namespace librepcb {
 
 bool OccModel::sOutputVerbosityConfigured = false;
 
+#if USE_OPENCASCADE
+/// Serializes reading STEP files since the OpenCascade STEP reader is not
+/// thread-safe
+static QMutex sStepReaderMutex;
+#endif
+
 /*******************************************************************************
  *  Data
  ******************************************************************************/
@@ -614,6 +620,7 @@ std::unique_ptr<OccModel> OccModel::createBoard(const librepcb::Path& outline,
 std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
   std::unique_ptr<OccModel> result;
 #if USE_OPENCASCADE
+  QMutexLocker lock(&sStepReaderMutex);
   try {
     initOpenCascade();
 
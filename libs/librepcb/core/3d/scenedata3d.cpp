@@ -26,9 +26,12 @@
 #include "../types/pcbcolor.h"
 #include "../utils/toolbox.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 #include <QtGui>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -116,68 +119,99 @@ void SceneData3D::preprocess(bool center, bool sortDevices, Length* width,
   }
 
   // Perform hole transformations.
-  for (auto& hole : mHoles) {
+  std::function<void(HoleData&)> transformHole = [](HoleData& hole) {
     hole.path = hole.transform.map(hole.path);
     hole.transform = Transform();
-  }
+  };
+  QtConcurrent::blockingMap(mHoles, transformHole);
 
   // Perform area transformations.
-  for (auto& area : mAreas) {
-    area.outline = area.transform.map(area.outline);
+  std::function<void(AreaData&)> transformArea = [](AreaData& area) {
+    area.outline = area.transform.map(std::move(area.outline));
     area.transform = Transform();
-  }
+  };
+  QtConcurrent::blockingMap(mAreas, transformArea);
 
-  // Convert polygons to areas.
-  foreach (const auto& obj, mPolygons) {
-    const Layer& layer = obj.transform.map(obj.polygon.getLayer());
-    const Path path = obj.transform.map(obj.polygon.getPath());
-    const bool isOutline = layer.isBoardEdge();
-    if ((!isOutline) && (obj.polygon.getLineWidth() > 0)) {
-      foreach (
-          const Path& outline,
-          path.toOutlineStrokes(PositiveLength(*obj.polygon.getLineWidth()))) {
-        mAreas.append(AreaData{&layer, outline, Transform()});
+  // Convert polygons, circles and strokes to areas. Especially the outline
+  // strokes are expensive to calculate, so all objects are converted in
+  // parallel. The resulting areas are appended in the original order to keep
+  // the output deterministic.
+  typedef QVector<AreaData> Areas;
+  auto appendAreas = [this](const QList<Areas>& results) {
+    for (const Areas& areas : results) {
+      for (const AreaData& area : areas) {
+        mAreas.append(area);
       }
     }
-    if ((isOutline || obj.polygon.isFilled()) &&
-        obj.polygon.getPath().isClosed()) {
-      mAreas.append(AreaData{&layer, path, Transform()});
-    }
-  }
+  };
+
+  // Convert polygons to areas.
+  std::function<Areas(const PolygonData&)> convertPolygon =
+      [](const PolygonData& obj) {
+        Areas areas;
+        const Layer& layer = obj.transform.map(obj.polygon.getLayer());
+        const Path path = obj.transform.map(obj.polygon.getPath());
+        const bool isOutline = layer.isBoardEdge();
+        if ((!isOutline) && (obj.polygon.getLineWidth() > 0)) {
+          foreach (const Path& outline,
+                   path.toOutlineStrokes(
+                       PositiveLength(*obj.polygon.getLineWidth()))) {
+            areas.append(AreaData{&layer, outline, Transform()});
+          }
+        }
+        if ((isOutline || obj.polygon.isFilled()) &&
+            obj.polygon.getPath().isClosed()) {
+          areas.append(AreaData{&layer, path, Transform()});
+        }
+        return areas;
+      };
+  appendAreas(
+      QtConcurrent::blockingMapped<QList<Areas>>(mPolygons, convertPolygon));
   mPolygons.clear();
 
   // Convert circles to areas.
-  foreach (const auto& obj, mCircles) {
-    const Layer& layer = obj.transform.map(obj.circle.getLayer());
-    const Point center = obj.transform.map(obj.circle.getCenter());
-    const Path path = Path::circle(obj.circle.getDiameter()).translated(center);
-    const bool isOutline = layer.isBoardEdge();
-    if ((!isOutline) && (obj.circle.getLineWidth() > 0)) {
-      foreach (
-          const Path& outline,
-          path.toOutlineStrokes(PositiveLength(*obj.circle.getLineWidth()))) {
-        mAreas.append(AreaData{&layer, outline, Transform()});
-      }
-    }
-    if (isOutline || obj.circle.isFilled()) {
-      mAreas.append(AreaData{&layer, path, Transform()});
-    }
-  }
+  std::function<Areas(const CircleData&)> convertCircle =
+      [](const CircleData& obj) {
+        Areas areas;
+        const Layer& layer = obj.transform.map(obj.circle.getLayer());
+        const Point center = obj.transform.map(obj.circle.getCenter());
+        const Path path =
+            Path::circle(obj.circle.getDiameter()).translated(center);
+        const bool isOutline = layer.isBoardEdge();
+        if ((!isOutline) && (obj.circle.getLineWidth() > 0)) {
+          foreach (const Path& outline,
+                   path.toOutlineStrokes(
+                       PositiveLength(*obj.circle.getLineWidth()))) {
+            areas.append(AreaData{&layer, outline, Transform()});
+          }
+        }
+        if (isOutline || obj.circle.isFilled()) {
+          areas.append(AreaData{&layer, path, Transform()});
+        }
+        return areas;
+      };
+  appendAreas(
+      QtConcurrent::blockingMapped<QList<Areas>>(mCircles, convertCircle));
   mCircles.clear();
 
   // Convert strokes to areas.
-  foreach (const auto& obj, mStrokes) {
-    Q_ASSERT(obj.layer);
-    if (obj.width > 0) {
-      foreach (const Path& stroke, obj.paths) {
-        foreach (const Path& outline,
-                 obj.transform.map(stroke).toOutlineStrokes(
-                     PositiveLength(obj.width))) {
-          mAreas.append(AreaData{obj.layer, outline, Transform()});
+  std::function<Areas(const StrokeData&)> convertStroke =
+      [](const StrokeData& obj) {
+        Areas areas;
+        Q_ASSERT(obj.layer);
+        if (obj.width > 0) {
+          foreach (const Path& stroke, obj.paths) {
+            foreach (const Path& outline,
+                     obj.transform.map(stroke).toOutlineStrokes(
+                         PositiveLength(obj.width))) {
+              areas.append(AreaData{obj.layer, outline, Transform()});
+            }
+          }
         }
-      }
-    }
-  }
+        return areas;
+      };
+  appendAreas(
+      QtConcurrent::blockingMapped<QList<Areas>>(mStrokes, convertStroke));
   mStrokes.clear();
 
   // Convert vias to holes & areas.
@@ -172,6 +172,19 @@ public:
                bool plated, bool via, const Transform& transform) noexcept;
   void addArea(const Layer& layer, const Path& outline,
                const Transform& transform) noexcept;
+
+  /**
+   * @brief Convert all objects to areas and holes without transformation
+   *
+   * The objects are converted in parallel in the global thread pool. Calling
+   * this again on already preprocessed data is cheap since only the areas
+   * and holes are left.
+   *
+   * @param center        Whether to move the board center to the origin.
+   * @param sortDevices   Whether to sort the devices by name.
+   * @param width         If not `nullptr`, the board width is returned here.
+   * @param height        If not `nullptr`, the board height is returned here.
+   */
   void preprocess(bool center, bool sortDevices = false,
                   Length* width = nullptr, Length* height = nullptr);
 
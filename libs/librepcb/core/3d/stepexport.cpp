@@ -26,6 +26,7 @@
 #include "../fileio/fileutils.h"
 #include "../types/pcbcolor.h"
 #include "../utils/clipperhelpers.h"
+#include "../utils/concurrency.h"
 #include "../utils/scopeguard.h"
 #include "occmodel.h"
 #include "scenedata3d.h"
@@ -139,24 +140,69 @@ QString StepExport::run(std::shared_ptr<SceneData3D> data, FilePath fp,
     }
     emit progressPercent(20);
 
+    // Load all device models. Identical models are loaded only once. Note
+    // that OccModel::loadStep() serializes the actual STEP reading since
+    // OpenCascade is not thread-safe, the workers only avoid blocking this
+    // thread while reading the next files. A separate thread pool is used
+    // because this export is already running in the global one.
+    struct LoadedModel {
+      std::shared_ptr<OccModel> model;
+      QString error;
+    };
+    QThreadPool threadPool;  // Waits for all workers on destruction.
+    Concurrency::apply(threadPool);
+    QHash<QString, QFuture<LoadedModel>> futures;  // Key: File path
+    std::shared_ptr<FileSystem> fs = data->getFileSystem();
+    if (fs) {
+      emit progressStatus(tr("Loading device models..."));
+      for (const auto& obj : data->getDevices()) {
+        if (futures.contains(obj.stepFile)) {
+          continue;
+        }
+        const QByteArray content = fs->readIfExists(obj.stepFile);
+        futures.insert(obj.stepFile,
+                       QtConcurrent::run(&threadPool, [this, content]() {
+                         LoadedModel result;
+                         if (mAbort || content.isEmpty()) {
+                           return result;
+                         }
+                         try {
+                           result.model = OccModel::loadStep(content);
+                         } catch (const Exception& e) {
+                           result.error = e.getMsg();
+                         }
+                         return result;
+                       }));
+      }
+      int i = 1;
+      foreach (const QFuture<LoadedModel>& future, futures) {
+        future.waitForFinished();
+        emit progressPercent(20 + ((50 * i) / futures.count()));
+        if (mAbort) return QString();
+        ++i;
+      }
+    }
+
     // Add devices.
     int deviceErrors = 0;
     QString lastError;
-    if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
+    if (fs) {
       int i = 1;
       for (const auto& obj : data->getDevices()) {
         try {
           emit progressStatus(tr("Exporting device %1/%2...")
                                   .arg(i)
                                   .arg(data->getDevices().count()));
-          const QByteArray content = fs->readIfExists(obj.stepFile);
-          if (!content.isEmpty()) {
+          const LoadedModel loaded = futures.value(obj.stepFile).result();
+          if (!loaded.error.isEmpty()) {
+            throw RuntimeError(__FILE__, __LINE__, loaded.error);
+          }
+          if (loaded.model) {
             Point3D pos = obj.stepPosition;
             if (!obj.transform.getMirrored()) {
               std::get<2>(pos) += *data->getThickness();
             }
-            std::unique_ptr<OccModel> devModel = OccModel::loadStep(content);
-            model->addToAssembly(*devModel, pos, obj.stepRotation,
+            model->addToAssembly(*loaded.model, pos, obj.stepRotation,
                                  obj.transform, obj.name);
           }
         } catch (const Exception& e) {
@@ -165,7 +211,7 @@ QString StepExport::run(std::shared_ptr<SceneData3D> data, FilePath fp,
           ++deviceErrors;
           lastError = obj.name % ": " % e.getMsg();
         }
-        emit progressPercent(20 + ((70 * i) / data->getDevices().count()));
+        emit progressPercent(70 + ((20 * i) / data->getDevices().count()));
         if (mAbort) return QString();
         ++i;
       }
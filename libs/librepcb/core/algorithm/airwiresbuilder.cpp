@@ -22,7 +22,10 @@
  ******************************************************************************/
 #include "airwiresbuilder.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
 
 #include <QtCore>
 
@@ -54,19 +57,30 @@ public:
   }
 
   AirWiresBuilder::AirWires buildAirWires() noexcept {
+    // For small nets, building the MST directly is much cheaper than
+    // triangulating the points first.
+    if (mPoints.size() <= sMaxPointsForDirectMst) {
+      return primMst();
+    }
+
     // remember how many edges are already known as connected
     uint connectedEdges = mEdges.size();
 
     // determine additional edges between found points (candidates for airwires)
-    if (mPoints.size() == 2) {
-      mEdges.emplace_back(mPoints[0], mPoints[1], -1);
-    } else if (mPoints.size() == 3) {
-      // manually triangulate since it is easy and more stable than the
-      // delaunay-triangulation library
-      mEdges.emplace_back(mPoints[0], mPoints[1], -1);
-      mEdges.emplace_back(mPoints[1], mPoints[2], -1);
-      mEdges.emplace_back(mPoints[2], mPoints[0], -1);
-    } else if (mPoints.size() >= 3) {
+    if (areAllPointsCollinear()) {
+      // The delaunay-triangulation library doesn't work well with collinear
+      // points (e.g. pin headers), but then the MST only consists of edges
+      // between neighbors along the line.
+      std::vector<int> ids(mPoints.size());
+      std::iota(ids.begin(), ids.end(), 0);
+      std::sort(ids.begin(), ids.end(), [this](int a, int b) {
+        return std::make_pair(mPoints[a].x, mPoints[a].y) <
+            std::make_pair(mPoints[b].x, mPoints[b].y);
+      });
+      for (std::size_t i = 1; i < ids.size(); ++i) {
+        mEdges.emplace_back(mPoints[ids[i - 1]], mPoints[ids[i]], -1);
+      }
+    } else {
       // since delaunay-triangulation sometimes doesn't work well, add fallback
       // edges to make sure at least all points are connected somehow
       for (std::size_t i = 1; i < mPoints.size(); ++i) {
@@ -91,6 +105,101 @@ public:
   AirWiresBuilderImpl& operator=(const AirWiresBuilderImpl& rhs) = delete;
 
 private:  // Methods
+  static int findRoot(std::vector<int>& parents, int node) noexcept {
+    int root = node;
+    while (parents[root] != root) root = parents[root];
+    while (parents[node] != root) {
+      const int next = parents[node];
+      parents[node] = root;
+      node = next;
+    }
+    return root;
+  }
+
+  bool areAllPointsCollinear() const noexcept {
+    // Note: Coordinates are integers (nanometers), so the check is exact as
+    // long as the cross products don't overflow. For huge coordinates, just
+    // assume the points are not collinear.
+    const qint64 limit = qint64(1) << 31;
+    const delaunay::Vector2<qreal>& p0 = mPoints.front();
+    const delaunay::Vector2<qreal>* p1 = nullptr;
+    for (const delaunay::Vector2<qreal>& p : mPoints) {
+      const qint64 dx = qint64(p.x - p0.x);
+      const qint64 dy = qint64(p.y - p0.y);
+      if ((qAbs(dx) >= limit) || (qAbs(dy) >= limit)) {
+        return false;
+      } else if ((dx == 0) && (dy == 0)) {
+        continue;
+      } else if (!p1) {
+        p1 = &p;
+      } else if ((qint64(p1->x - p0.x) * dy) != (qint64(p1->y - p0.y) * dx)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Prim's algorithm on the complete graph of all points, with all points
+   * of an already connected group being added to the tree at once. This is
+   * O(n^2), but without any overhead, thus ideal for small nets.
+   */
+  AirWiresBuilder::AirWires primMst() noexcept {
+    AirWiresBuilder::AirWires mst;
+    const int count = mPoints.size();
+    if (count < 2) {
+      return mst;
+    }
+
+    // Determine the groups of already connected points.
+    std::vector<int> roots(count);
+    std::iota(roots.begin(), roots.end(), 0);
+    for (const delaunay::Edge<qreal>& edge : mEdges) {
+      const int root1 = findRoot(roots, edge.p1.id);
+      const int root2 = findRoot(roots, edge.p2.id);
+      roots[root2] = root1;
+    }
+    for (int i = 0; i < count; ++i) {
+      roots[i] = findRoot(roots, i);
+    }
+
+    // Grow the tree, starting at the group of the first point.
+    std::vector<bool> inTree(count, false);
+    std::vector<qreal> distances(count, std::numeric_limits<qreal>::max());
+    std::vector<int> nearest(count, -1);
+    auto addGroup = [&](int root) {
+      for (int i = 0; i < count; ++i) {
+        if ((!inTree[i]) && (roots[i] == root)) {
+          inTree[i] = true;
+          for (int k = 0; k < count; ++k) {
+            if (!inTree[k]) {
+              const qreal distance = mPoints[i].dist2(mPoints[k]);
+              if (distance < distances[k]) {
+                distances[k] = distance;
+                nearest[k] = i;
+              }
+            }
+          }
+        }
+      }
+    };
+    addGroup(roots[0]);
+    while (true) {
+      int next = -1;
+      for (int i = 0; i < count; ++i) {
+        if ((!inTree[i]) && ((next < 0) || (distances[i] < distances[next]))) {
+          next = i;
+        }
+      }
+      if (next < 0) {
+        break;
+      }
+      mst.append(std::make_pair(nearest[next], next));
+      addGroup(roots[next]);
+    }
+    return mst;
+  }
+
   // adapted from horizon/kicad
   AirWiresBuilder::AirWires kruskalMst() noexcept {
     unsigned int nodeNumber = mPoints.size();
@@ -98,24 +207,15 @@ private:  // Methods
     unsigned int mstSize = 0;
     bool ratsnestLines = false;
 
-    // printf("mst nodes : %d edges : %d\n", mPoints.size(), mEdges.size () );
     // The output
     AirWiresBuilder::AirWires mst;
 
-    // Set tags for marking cycles
-    std::unordered_map<int, int> tags;
-    unsigned int tag = 0;
-
-    for (auto& node : mPoints) {
-      node.tag = tag;
-      tags[node.id] = tag++;
-    }
-
-    // Lists of nodes connected together (subtrees) to detect cycles in the
-    // graph
-    std::vector<std::list<int>> cycles(nodeNumber);
-
-    for (unsigned int i = 0; i < nodeNumber; ++i) cycles[i].push_back(i);
+    // Disjoint-set forest of the nodes connected together (subtrees) to
+    // detect cycles in the graph. Using union by size and path compression
+    // makes this almost linear even for nets with thousands of points.
+    std::vector<int> parents(nodeNumber);
+    std::vector<int> sizes(nodeNumber, 1);
+    for (unsigned int i = 0; i < nodeNumber; ++i) parents[i] = i;
 
     // Kruskal algorithm requires edges to be sorted by their weight
     std::sort(
@@ -127,59 +227,30 @@ private:  // Methods
     while (mstSize < mstExpectedSize && !mEdges.empty()) {
       auto& dt = mEdges.back();
 
-      int srcTag = tags[dt.p1.id];
-      int trgTag = tags[dt.p2.id];
-      // printf("mstSize %d %d %f %d<>%d\n", mstSize, mstExpectedSize,
-      // dt.weight, srcTag, trgTag);
+      int srcRoot = findRoot(parents, dt.p1.id);
+      int trgRoot = findRoot(parents, dt.p2.id);
 
       // Check if by adding this edge we are going to join two different
       // forests
-      if (srcTag != trgTag) {
+      if (srcRoot != trgRoot) {
         // Because edges are sorted by their weight, first we always process
-        // connected
-        // items (weight == 0). Once we stumble upon an edge with non-zero
-        // weight,
-        // it means that the rest of the lines are ratsnest.
+        // connected items (weight == 0). Once we stumble upon an edge with
+        // non-zero weight, it means that the rest of the lines are ratsnest.
         if (!ratsnestLines && dt.weight >= 0) ratsnestLines = true;
 
-        // Update tags
         if (ratsnestLines) {
-          for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-               ++it) {
-            tags[mPoints[*it].id] = srcTag;
-          }
-
-          // Do a copy of edge, but make it RN_EDGE_MST. In contrary to
-          // RN_EDGE,
-          // RN_EDGE_MST saves both source and target node and does not
-          // require any other
-          // edges to exist for getting source/target nodes
-          // CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(),
-          // dt.GetWeight() );
-
-          // assert( newEdge.GetSourceNode()->GetTag() !=
-          // newEdge.GetTargetNode()->GetTag() );
-          // assert(dt.p1.tag != dt.p2.tag);
           mst.append(std::make_pair(dt.p1.id, dt.p2.id));
           ++mstSize;
         } else {
-          // for( it = cycles[trgTag].begin(), itEnd =
-          // cycles[trgTag].end(); it != itEnd; ++it )
-          // for( auto it : cycles[trgTag] )
-          for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-               ++it) {
-            tags[mPoints[*it].id] = srcTag;
-            mPoints[*it].tag = srcTag;
-          }
-
           // Processing a connection, decrease the expected size of the
           // ratsnest MST
           --mstExpectedSize;
         }
 
-        // Move nodes that were marked with old tag to the list marked with
-        // the new tag
-        cycles[srcTag].splice(cycles[srcTag].end(), cycles[trgTag]);
+        // Merge the smaller subtree into the larger one
+        if (sizes[srcRoot] < sizes[trgRoot]) std::swap(srcRoot, trgRoot);
+        parents[trgRoot] = srcRoot;
+        sizes[srcRoot] += sizes[trgRoot];
       }
 
       // Remove the edge that was just processed
@@ -190,6 +261,9 @@ private:  // Methods
   }
 
 private:  // Data
+  /// Maximum number of points to build the MST without triangulation
+  static constexpr std::size_t sMaxPointsForDirectMst = 64;
+
   std::vector<delaunay::Vector2<qreal>> mPoints;
   std::vector<delaunay::Edge<qreal>> mEdges;
 };
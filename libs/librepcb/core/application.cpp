@@ -218,6 +218,14 @@ QString Application::getDefaultStrokeFontName() noexcept {
  ******************************************************************************/
 
 void Application::loadBundledFonts() noexcept {
+  // Registering the fonts takes some time, so do it only once, even if
+  // called several times (e.g. lazily by the CLI).
+  static bool loaded = false;
+  if (loaded) {
+    return;
+  }
+  loaded = true;
+
   QDir fontsDir(Application::getResourcesDir().getPathTo("fonts").toStr());
   fontsDir.setFilter(QDir::Files);
   fontsDir.setNameFilters({"*.ttf", "*.otf"});
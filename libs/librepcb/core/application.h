@@ -186,7 +186,8 @@ public:
   /**
    * @brief Load all bundled fonts to make them available in the application
    *
-   * To be called once at application startup.
+   * To be called at application startup, or before rendering graphics.
+   * Subsequent calls do nothing.
    */
   static void loadBundledFonts() noexcept;
 
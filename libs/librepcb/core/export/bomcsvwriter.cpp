@@ -23,6 +23,7 @@
 #include "bomcsvwriter.h"
 
 #include "../fileio/csvfile.h"
+#include "../fileio/csvwriter.h"
 #include "bom.h"
 
 #include <QtCore>
@@ -53,11 +54,32 @@ void BomCsvWriter::setIncludeNonMountedParts(bool include) noexcept {
 
 std::shared_ptr<CsvFile> BomCsvWriter::generateCsv() const {
   std::shared_ptr<CsvFile> file(new CsvFile());
+  file->setHeader(getHeader());
+  forEachRow([&file](const QStringList& values) {
+    file->addValue(values);  // can throw
+  });
+  return file;
+}
+
+void BomCsvWriter::writeCsv(CsvWriter& writer) const {
+  writer.writeHeader(getHeader());
+  forEachRow([&writer](const QStringList& values) {
+    writer.writeRow(values);
+  });
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
 
+QStringList BomCsvWriter::getHeader() const noexcept {
   // Don't translate the CSV header to make BOM files independent of the
   // user's language.
-  file->setHeader(QStringList{"Quantity", "Designators"} + mBom.getColumns());
+  return QStringList{"Quantity", "Designators"} + mBom.getColumns();
+}
 
+void BomCsvWriter::forEachRow(
+    const std::function<void(const QStringList&)>& callback) const {
   foreach (const BomItem& item, mBom.getItems()) {
     const int count = item.isMount() ? item.getDesignators().count() : 0;
     if ((count == 0) && (!mIncludeNonMountedParts)) {
@@ -70,10 +92,8 @@ std::shared_ptr<CsvFile> BomCsvWriter::generateCsv() const {
     foreach (const QString& attribute, item.getAttributes()) {
       values += attribute;
     }
-    file->addValue(values);  // can throw
+    callback(values);  // can throw
   }
-
-  return file;
 }
 
 /*******************************************************************************
@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include <QtCore>
 
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -34,6 +35,7 @@ namespace librepcb {
 
 class Bom;
 class CsvFile;
+class CsvWriter;
 
 /*******************************************************************************
  *  Class BomCsvWriter
@@ -56,10 +58,24 @@ public:
   void setIncludeNonMountedParts(bool include) noexcept;
   std::shared_ptr<CsvFile> generateCsv() const;
 
+  /**
+   * @brief Write the CSV directly to a streaming writer
+   *
+   * Same content as #generateCsv(), but without keeping all rows in memory.
+   *
+   * @param writer  The writer to append the CSV content to.
+   */
+  void writeCsv(CsvWriter& writer) const;
+
   // Operator Overloadings
   BomCsvWriter& operator=(const BomCsvWriter& rhs) = delete;
 
-private:
+private:  // Methods
+  QStringList getHeader() const noexcept;
+  void forEachRow(
+      const std::function<void(const QStringList&)>& callback) const;
+
+private:  // Data
   const Bom& mBom;
   bool mIncludeNonMountedParts;
 };
@@ -27,6 +27,9 @@
 
 #include <QtCore>
 
+#include <algorithm>
+#include <cstring>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -138,17 +141,38 @@ void D356NetlistGenerator::buriedVia(const QString& netName,
 }
 
 QByteArray D356NetlistGenerator::generate() const {
-  QStringList lines;
+  // Every line has at most 80 characters, thus the output is written directly
+  // into a preallocated buffer instead of building and joining a string list.
+  QByteArray output;
+  output.reserve((mComments.count() + mRecords.count() + 2) * 81);
+  QByteArray line;
+  line.reserve(100);
+  auto appendLine = [&output, &line]() {
+    output += line.trimmed();
+    output += '\n';
+    line.resize(0);
+  };
+  auto appendField = [&line](const QByteArray& str, int width) {
+    line += str;
+    if (str.length() < width) {
+      line.append(QByteArray(width - str.length(), ' '));
+    }
+  };
+  auto appendNumber = [&line](int number, int digits) {
+    line += QByteArray::number(number).rightJustified(digits, '0');
+  };
 
   // Add header.
   foreach (const QString& comment, mComments) {
     // Limit length to 80 characters in total (with or without newline?).
-    lines.append(cleanString("C  " % comment).left(79));
+    output += cleanString("C  " % comment).left(79).toLatin1();
+    output += '\n';
   }
-  lines.append("P  UNITS CUST 1");  // Millimeters / degrees
+  line += "P  UNITS CUST 1";  // Millimeters / degrees
+  appendLine();
 
   // Guarantee unique signal names by adding their index as a suffix.
-  QHash<QString, QString> signalNameMap;
+  QHash<QString, QByteArray> signalNameMap;
   const int signalNameLength = 14;
   foreach (const Record& record, mRecords) {
     if (auto name = record.signalName) {
@@ -159,81 +183,100 @@ QByteArray D356NetlistGenerator::generate() const {
           const QString nbr = QString("{%1}").arg(signalNameMap.count() + 1);
           name = cleanString(*name).left(signalNameLength - nbr.length()) % nbr;
         }
-        signalNameMap[*record.signalName] = *name;
+        signalNameMap[*record.signalName] = name->toLatin1();
       }
     }
   }
 
+  // Component and pad names are repeated for many records, thus clean each of
+  // them only once.
+  QHash<QString, QByteArray> cleanedNames;
+  auto cleanName = [&cleanedNames](const QString& name, int length) {
+    auto it = cleanedNames.find(name);
+    if (it == cleanedNames.end()) {
+      it = cleanedNames.insert(name, cleanString(name).toLatin1());
+    }
+    return it->left(length);
+  };
+
   // Add records.
   foreach (const Record& record, mRecords) {
-    QString line;
-    line += QString("%1").arg(static_cast<int>(record.code), 3, 10,
-                              QLatin1Char('0'));
+    appendNumber(static_cast<int>(record.code), 3);
     if (const auto name = record.signalName) {
-      line += QString("%1").arg(signalNameMap[*name], -signalNameLength);
+      appendField(signalNameMap[*name], signalNameLength);
     } else {
-      line += QString(" ").repeated(signalNameLength);
+      appendField(QByteArray(), signalNameLength);
     }
     line += "   ";
-    line += QString("%1").arg(cleanString(record.componentName).left(6), -6);
+    appendField(cleanName(record.componentName, 6), 6);
     line += record.padName.isEmpty() ? " " : "-";
-    line += QString("%1").arg(cleanString(record.padName).left(4), -4);
+    appendField(cleanName(record.padName, 4), 4);
     line += record.midPoint ? "M" : " ";
     if (const auto hole = record.hole) {
-      line += QString("D%1%2")
-                  .arg(formatLength(*hole->first, false, 4))
-                  .arg(hole->second ? "P" : "U");
+      line += 'D';
+      line += formatLength(*hole->first, false, 4);
+      line += hole->second ? 'P' : 'U';
     } else {
       line += "      ";
     }
     if (const auto accessCode = record.accessCode) {
-      line += QString("A%1").arg(*accessCode, 2, 10, QLatin1Char('0'));
+      line += 'A';
+      appendNumber(*accessCode, 2);
     } else {
       line += "   ";
     }
-    line += QString("X%1Y%2")
-                .arg(formatLength(record.position.getX(), true, 6))
-                .arg(formatLength(record.position.getY(), true, 6));
+    line += 'X';
+    line += formatLength(record.position.getX(), true, 6);
+    line += 'Y';
+    line += formatLength(record.position.getY(), true, 6);
     if (const auto width = record.width) {
-      line += QString("X%1").arg(formatLength(**width, false, 4));
+      line += 'X';
+      line += formatLength(**width, false, 4);
     } else {
       line += "     ";
     }
     if (const auto height = record.height) {
-      line += QString("Y%1").arg(formatLength(**height, false, 4));
+      line += 'Y';
+      line += formatLength(**height, false, 4);
     } else {
       line += "     ";
     }
     if (const auto rotation = record.rotation) {
-      line += QString("R%1").arg(rotation->mappedTo0_360deg().toDeg(), 3, 'f',
-                                 0, '0');
+      line += 'R';
+      line += QByteArray::number(rotation->mappedTo0_360deg().toDeg(), 'f', 0)
+                  .rightJustified(3, '0');
     } else {
       line += "    ";
     }
     line += " ";
     if (const auto mask = record.solderMask) {
-      line += QString("S%1").arg(static_cast<int>(*mask));
+      line += 'S';
+      line += QByteArray::number(static_cast<int>(*mask));
     } else {
       line += "  ";
     }
     if (const auto layer = record.startLayer) {
-      line += QString("L%1").arg(*layer, 2, 10, QLatin1Char('0'));
+      line += 'L';
+      appendNumber(*layer, 2);
     } else {
       line += "   ";
     }
     if (const auto layer = record.endLayer) {
-      line += QString("L%1").arg(*layer, 2, 10, QLatin1Char('0'));
+      line += 'L';
+      appendNumber(*layer, 2);
     } else {
       line += "   ";
     }
-    lines.append(line.trimmed());
+    appendLine();
   }
 
   // Add footer, including a final linebreak.
-  lines.append("999\n");
+  line += "999";
+  appendLine();
 
-  // Make sure there are no non-ASCII characters in the file.
-  return lines.join("\n").toLatin1();
+  // Note: There are no non-ASCII characters in the file since all strings
+  // have been cleaned.
+  return output;
 }
 
 /*******************************************************************************
@@ -241,6 +284,22 @@ QByteArray D356NetlistGenerator::generate() const {
  ******************************************************************************/
 
 QString D356NetlistGenerator::cleanString(QString str) noexcept {
+  // Only allow some characters for maximum compatibility with readers.
+  auto isValid = [](const QChar& c) {
+    static const char specialChars[] = "-_+/!?<>\"'(){}.|&@# ,;$:=~";
+    const ushort u = c.unicode();
+    return ((u >= 'a') && (u <= 'z')) || ((u >= 'A') && (u <= 'Z')) ||
+        ((u >= '0') && (u <= '9')) ||
+        ((u > 0) && (u < 128) &&
+         std::strchr(specialChars, static_cast<char>(u)));
+  };
+
+  // Most strings contain only valid characters, so avoid the expensive
+  // normalization for them.
+  if (std::all_of(str.constBegin(), str.constEnd(), isValid)) {
+    return str;
+  }
+
   // Remove CRLF newlines.
   str.remove('\r');
 
@@ -250,11 +309,15 @@ QString D356NetlistGenerator::cleanString(QString str) noexcept {
   // Perform compatibility decomposition (NFKD).
   str = str.normalized(QString::NormalizationForm_KD);
 
-  // Remove all invalid characters for maximum compatibility with readers.
-  const QString validChars("-a-zA-Z0-9_+/!?<>\"'(){}.|&@# ,;$:=~");
-  str.remove(QRegularExpression(QString("[^%1]").arg(validChars)));
-
-  return str;
+  // Remove all invalid characters.
+  QString result;
+  result.reserve(str.length());
+  for (const QChar& c : str) {
+    if (isValid(c)) {
+      result.append(c);
+    }
+  }
+  return result;
 }
 
 QString D356NetlistGenerator::checkedComponentName(
@@ -266,13 +329,14 @@ QString D356NetlistGenerator::checkedComponentName(
   }
 }
 
-QString D356NetlistGenerator::formatLength(const Length& value, bool isSigned,
-                                           int digits) noexcept {
-  QString str =
-      QString("%1").arg(value.abs().toMicrometers(), digits, 'f', 0, '0');
+QByteArray D356NetlistGenerator::formatLength(const Length& value,
+                                              bool isSigned,
+                                              int digits) noexcept {
+  QByteArray str = QByteArray::number(value.abs().toMicrometers(), 'f', 0)
+                       .rightJustified(digits, '0');
   if (str.length() > digits) {
     qWarning() << "Too large number in IPC-D-356A export clipped!";
-    str = QString("9").repeated(digits);
+    str = QByteArray(digits, '9');
   }
   if (isSigned) {
     str.prepend((value < 0) ? "-" : "+");
@@ -86,8 +86,8 @@ public:
 private:  // Methods
   static QString cleanString(QString str) noexcept;
   static QString checkedComponentName(const QString& name) noexcept;
-  static QString formatLength(const Length& value, bool isSigned,
-                              int digits) noexcept;
+  static QByteArray formatLength(const Length& value, bool isSigned,
+                                 int digits) noexcept;
 
 private:  // Data
   enum class OperationCode : int {
@@ -122,7 +122,7 @@ private:  // Data
   };
 
   QStringList mComments;
-  QList<Record> mRecords;
+  QVector<Record> mRecords;
 };
 
 /*******************************************************************************
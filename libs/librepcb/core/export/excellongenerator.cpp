@@ -107,7 +107,7 @@ void ExcellonGenerator::generate() {
 }
 
 void ExcellonGenerator::saveToFile(const FilePath& filepath) const {
-  FileUtils::writeFile(filepath, mOutput.toLatin1());  // can throw
+  FileUtils::writeFile(filepath, mOutput);  // can throw
 }
 
 /*******************************************************************************
@@ -119,7 +119,7 @@ void ExcellonGenerator::printHeader() noexcept {
 
   // Add file attributes.
   foreach (const GerberAttribute& a, mFileAttributes) {
-    mOutput.append(a.toExcellonString());
+    mOutput.append(a.toExcellonString().toLatin1());
   }
 
   mOutput.append("FMAT,2\n");  // Use Format 2 commands
@@ -141,20 +141,28 @@ void ExcellonGenerator::printToolList() noexcept {
     GerberAttribute apertureFunctionAttribute = (mPlating == Plating::Mixed)
         ? GerberAttribute::apertureFunctionMixedPlatingDrill(plated, function)
         : GerberAttribute::apertureFunction(function);
-    mOutput.append(apertureFunctionAttribute.toExcellonString());
+    mOutput.append(apertureFunctionAttribute.toExcellonString().toLatin1());
 
     Length dia = std::get<0>(tools.at(i));
-    mOutput.append(QString("T%1C%2\n").arg(i + 1).arg(dia.toMmString()));
+    mOutput.append('T');
+    Toolbox::appendInteger(mOutput, i + 1);
+    mOutput.append('C');
+    Toolbox::appendDecimalFixedPoint(mOutput, dia.toNm(), 6);
+    mOutput.append('\n');
   }
 }
 
 void ExcellonGenerator::printDrills() {
-  for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-    mOutput.append(QString("T%1\n").arg(i + 1));  // Select Tool
-    auto tool = mDrillList.uniqueKeys().value(i);
-    foreach (const NonEmptyPath& path, mDrillList.values(tool)) {
-      printPath(path);
+  // Iterate over the sorted list only once, selecting the next tool whenever
+  // the key changes. This yields the same tool numbers as printToolList().
+  int toolNumber = 0;
+  for (auto it = mDrillList.constBegin(); it != mDrillList.constEnd(); ++it) {
+    if ((it == mDrillList.constBegin()) || (it.key() != (it - 1).key())) {
+      mOutput.append('T');  // Select Tool
+      Toolbox::appendInteger(mOutput, ++toolNumber);
+      mOutput.append('\n');
     }
+    printPath(it.value());
   }
 }
 
@@ -171,8 +179,8 @@ void ExcellonGenerator::printPath(const NonEmptyPath& path) {
 }
 
 void ExcellonGenerator::printDrill(const Point& pos) noexcept {
-  mOutput.append(QString("X%1Y%2\n")
-                     .arg(pos.getX().toMmString(), pos.getY().toMmString()));
+  appendCoordinates(pos);
+  mOutput.append('\n');
 }
 
 void ExcellonGenerator::printSlot(const NonEmptyPath& path) {
@@ -185,11 +193,10 @@ void ExcellonGenerator::printSlot(const NonEmptyPath& path) {
           tr("Using the G85 slot command is not possible for curved slots. "
              "Either remove curved slots or disable the G85 export option."));
     }
-    mOutput.append(QString("X%1Y%2G85X%3Y%4\n")
-                       .arg(v0.getPos().getX().toMmString(),
-                            v0.getPos().getY().toMmString(),
-                            v1.getPos().getX().toMmString(),
-                            v1.getPos().getY().toMmString()));
+    appendCoordinates(v0.getPos());
+    mOutput.append("G85");
+    appendCoordinates(v1.getPos());
+    mOutput.append('\n');
   }
 }
 
@@ -219,22 +226,32 @@ void ExcellonGenerator::printRout(const NonEmptyPath& path) noexcept {
 }
 
 void ExcellonGenerator::printMoveTo(const Point& pos) noexcept {
-  mOutput.append(QString("G00X%1Y%2\n")
-                     .arg(pos.getX().toMmString(), pos.getY().toMmString()));
+  mOutput.append("G00");
+  appendCoordinates(pos);
+  mOutput.append('\n');
 }
 
 void ExcellonGenerator::printLinearInterpolation(const Point& pos) noexcept {
-  mOutput.append(QString("G01X%1Y%2\n")
-                     .arg(pos.getX().toMmString(), pos.getY().toMmString()));
+  mOutput.append("G01");
+  appendCoordinates(pos);
+  mOutput.append('\n');
 }
 
 void ExcellonGenerator::printCircularInterpolation(
     const Point& from, const Point& to, const Angle& angle) noexcept {
-  const QString cmd = (angle < 0) ? "G02" : "G03";
   const Length radius = Toolbox::arcRadius(from, to, angle).abs();
-  mOutput.append(QString("%1X%2Y%3A%4\n")
-                     .arg(cmd, to.getX().toMmString(), to.getY().toMmString(),
-                          radius.toMmString()));
+  mOutput.append((angle < 0) ? "G02" : "G03");
+  appendCoordinates(to);
+  mOutput.append('A');
+  Toolbox::appendDecimalFixedPoint(mOutput, radius.toNm(), 6);
+  mOutput.append('\n');
+}
+
+void ExcellonGenerator::appendCoordinates(const Point& pos) noexcept {
+  mOutput.append('X');
+  Toolbox::appendDecimalFixedPoint(mOutput, pos.getX().toNm(), 6);
+  mOutput.append('Y');
+  Toolbox::appendDecimalFixedPoint(mOutput, pos.getY().toNm(), 6);
 }
 
 void ExcellonGenerator::printFooter() noexcept {
@@ -64,7 +64,8 @@ public:
   void setUseG85Slots(bool use) noexcept { mUseG85Slots = use; }
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  QString toStr() const noexcept { return QString::fromLatin1(mOutput); }
+  const QByteArray& toByteArray() const noexcept { return mOutput; }
 
   // General Methods
   void drill(const Point& pos, const PositiveLength& dia, bool plated,
@@ -89,6 +90,7 @@ private:
   void printLinearInterpolation(const Point& pos) noexcept;
   void printCircularInterpolation(const Point& from, const Point& to,
                                   const Angle& angle) noexcept;
+  void appendCoordinates(const Point& pos) noexcept;
   void printFooter() noexcept;
 
   // Types
@@ -102,7 +104,7 @@ private:
   bool mUseG85Slots;
 
   // Excellon Data
-  QString mOutput;
+  QByteArray mOutput;
   QMultiMap<Tool, NonEmptyPath> mDrillList;
 };
 
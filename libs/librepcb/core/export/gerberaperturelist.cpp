@@ -74,13 +74,95 @@ QString GerberApertureList::generateString() const noexcept {
 
 int GerberApertureList::addCircle(const UnsignedLength& dia,
                                   Function function) {
-  return addAperture(QString("%ADD{}C,%1*%\n").arg(dia->toMmString()),
-                     function);
+  const ApertureKey key = makeKey(ApertureKey::Shape::Circle, *dia, Length(0),
+                                  Length(0), Angle::deg0(), function);
+  int number = mKeyIndex.value(key, -1);
+  if (number < 0) {
+    number = createCircle(dia, function);
+    mKeyIndex.insert(key, number);
+  }
+  return number;
 }
 
 int GerberApertureList::addObround(const PositiveLength& w,
                                    const PositiveLength& h, const Angle& rot,
                                    Function function) noexcept {
+  const ApertureKey key =
+      makeKey(ApertureKey::Shape::Obround, *w, *h, Length(0), rot, function);
+  int number = mKeyIndex.value(key, -1);
+  if (number < 0) {
+    number = createObround(w, h, rot, function);
+    mKeyIndex.insert(key, number);
+  }
+  return number;
+}
+
+int GerberApertureList::addRect(const PositiveLength& w,
+                                const PositiveLength& h,
+                                const UnsignedLength& r, const Angle& rot,
+                                Function function) noexcept {
+  const ApertureKey key =
+      makeKey(ApertureKey::Shape::Rect, *w, *h, *r, rot, function);
+  int number = mKeyIndex.value(key, -1);
+  if (number < 0) {
+    number = createRect(w, h, r, rot, function);
+    mKeyIndex.insert(key, number);
+  }
+  return number;
+}
+
+int GerberApertureList::addOctagon(const PositiveLength& w,
+                                   const PositiveLength& h,
+                                   const UnsignedLength& r, const Angle& rot,
+                                   Function function) noexcept {
+  const ApertureKey key =
+      makeKey(ApertureKey::Shape::Octagon, *w, *h, *r, rot, function);
+  int number = mKeyIndex.value(key, -1);
+  if (number < 0) {
+    number = createOctagon(w, h, r, rot, function);
+    mKeyIndex.insert(key, number);
+  }
+  return number;
+}
+
+int GerberApertureList::addOutline(const StraightAreaPath& path,
+                                   const Angle& rot,
+                                   Function function) noexcept {
+  return addOutline("OUTLINE", *path, rot.mappedTo0_360deg(), function);
+}
+
+int GerberApertureList::addComponentMain() noexcept {
+  // Note: The aperture shape, size and function is defined in the Gerber
+  // specs, do not change them!
+  return addCircle(UnsignedLength(300000),
+                   GerberAttribute::ApertureFunction::ComponentMain);
+}
+
+int GerberApertureList::addComponentPin(bool isPin1) noexcept {
+  // Note: The aperture shape, size and function is defined in the Gerber
+  // specs, do not change them!
+  if (isPin1) {
+    return addAperture("%ADD{}P,0.36X4X0.0*%\n",
+                       GerberAttribute::ApertureFunction::ComponentPin);
+  } else {
+    return addAperture("%ADD{}C,0*%\n",
+                       GerberAttribute::ApertureFunction::ComponentPin);
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+int GerberApertureList::createCircle(const UnsignedLength& dia,
+                                     Function function) noexcept {
+  return addAperture(QString("%ADD{}C,%1*%\n").arg(dia->toMmString()),
+                     function);
+}
+
+int GerberApertureList::createObround(const PositiveLength& w,
+                                      const PositiveLength& h, const Angle& rot,
+                                      Function function) noexcept {
   if (w == h) {
     // For maximum compatibility, use a circle if width==height.
     return addCircle(positiveToUnsigned(w), function);
@@ -124,10 +206,10 @@ int GerberApertureList::addObround(const PositiveLength& w,
   }
 }
 
-int GerberApertureList::addRect(const PositiveLength& w,
-                                const PositiveLength& h,
-                                const UnsignedLength& r, const Angle& rot,
-                                Function function) noexcept {
+int GerberApertureList::createRect(const PositiveLength& w,
+                                   const PositiveLength& h,
+                                   const UnsignedLength& r, const Angle& rot,
+                                   Function function) noexcept {
   // Handle simple cases first.
   if ((r == 0) && (rot % Angle::deg180() == 0)) {
     return addAperture(
@@ -190,10 +272,10 @@ int GerberApertureList::addRect(const PositiveLength& w,
   }
 }
 
-int GerberApertureList::addOctagon(const PositiveLength& w,
-                                   const PositiveLength& h,
-                                   const UnsignedLength& r, const Angle& rot,
-                                   Function function) noexcept {
+int GerberApertureList::createOctagon(const PositiveLength& w,
+                                      const PositiveLength& h,
+                                      const UnsignedLength& r, const Angle& rot,
+                                      Function function) noexcept {
   // Note: If w==h, we could theoretically use the "Gegular Polygon (P)"
   // aperture. However, it seems some CAM software render such polygons the
   // wrong way. From the Gerber specs:
@@ -248,35 +330,17 @@ int GerberApertureList::addOctagon(const PositiveLength& w,
   }
 }
 
-int GerberApertureList::addOutline(const StraightAreaPath& path,
-                                   const Angle& rot,
-                                   Function function) noexcept {
-  return addOutline("OUTLINE", *path, rot.mappedTo0_360deg(), function);
-}
-
-int GerberApertureList::addComponentMain() noexcept {
-  // Note: The aperture shape, size and function is defined in the Gerber
-  // specs, do not change them!
-  return addCircle(UnsignedLength(300000),
-                   GerberAttribute::ApertureFunction::ComponentMain);
-}
-
-int GerberApertureList::addComponentPin(bool isPin1) noexcept {
-  // Note: The aperture shape, size and function is defined in the Gerber
-  // specs, do not change them!
-  if (isPin1) {
-    return addAperture("%ADD{}P,0.36X4X0.0*%\n",
-                       GerberAttribute::ApertureFunction::ComponentPin);
-  } else {
-    return addAperture("%ADD{}C,0*%\n",
-                       GerberAttribute::ApertureFunction::ComponentPin);
-  }
+GerberApertureList::ApertureKey GerberApertureList::makeKey(
+    ApertureKey::Shape shape, const Length& w, const Length& h,
+    const Length& r, const Angle& rot, Function function) noexcept {
+  return ApertureKey{shape,
+                     w.toNm(),
+                     h.toNm(),
+                     r.toNm(),
+                     rot.toMicroDeg(),
+                     function ? static_cast<int>(*function) : -1};
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
-
 int GerberApertureList::addOutline(const QString& name, const Path& path,
                                    const Angle& rot,
                                    Function function) noexcept {
@@ -303,12 +367,14 @@ QString GerberApertureList::buildOutlineMacro(Path path,
 
 int GerberApertureList::addAperture(QString aperture,
                                     Function function) noexcept {
-  auto value = std::make_pair(function, aperture);
-  int number = mApertures.key(value, -1);
+  const QPair<int, QString> key =
+      qMakePair(function ? static_cast<int>(*function) : -1, aperture);
+  int number = mDefinitionIndex.value(key, -1);
   if (number < 0) {
     number = mApertures.count() + 10;  // 10 is the number of the first aperture
     Q_ASSERT(!mApertures.contains(number));
-    mApertures.insert(number, value);
+    mApertures.insert(number, std::make_pair(function, aperture));
+    mDefinitionIndex.insert(key, number);
   }
   return number;
 }
@@ -175,7 +175,53 @@ public:
   // Operator Overloadings
   GerberApertureList& operator=(const GerberApertureList& rhs) = delete;
 
+private:  // Types
+  /**
+   * @brief Typed key of the parameters passed to the public add methods
+   *
+   * Used to look up already added apertures without building their
+   * definition string again.
+   */
+  struct ApertureKey {
+    enum class Shape { Circle, Obround, Rect, Octagon };
+    Shape shape;
+    qint64 width;
+    qint64 height;
+    qint64 radius;
+    qint32 rotation;  ///< Micro degrees
+    int function;  ///< -1 if no function is set
+
+    bool operator==(const ApertureKey& rhs) const noexcept {
+      return (shape == rhs.shape) && (width == rhs.width) &&
+          (height == rhs.height) && (radius == rhs.radius) &&
+          (rotation == rhs.rotation) && (function == rhs.function);
+    }
+    friend uint qHash(const ApertureKey& key, uint seed) noexcept {
+      seed = ::qHash(qMakePair(static_cast<int>(key.shape), key.function),
+                     seed);
+      seed = ::qHash(qMakePair(key.width, key.height), seed);
+      return ::qHash(qMakePair(key.radius, key.rotation), seed);
+    }
+  };
+
 private:  // Methods
+  /**
+   * @brief Build a typed lookup key for the given aperture parameters
+   */
+  static ApertureKey makeKey(ApertureKey::Shape shape, const Length& w,
+                             const Length& h, const Length& r,
+                             const Angle& rot, Function function) noexcept;
+
+  int createCircle(const UnsignedLength& dia, Function function) noexcept;
+  int createObround(const PositiveLength& w, const PositiveLength& h,
+                    const Angle& rot, Function function) noexcept;
+  int createRect(const PositiveLength& w, const PositiveLength& h,
+                 const UnsignedLength& r, const Angle& rot,
+                 Function function) noexcept;
+  int createOctagon(const PositiveLength& w, const PositiveLength& h,
+                    const UnsignedLength& r, const Angle& rot,
+                    Function function) noexcept;
+
   /**
    * @brief Add a custom outline aperture
    *
@@ -225,6 +271,12 @@ private:  // Data
   ///           instead of the aperture number. Needs to be substituted by the
   ///           aperture number when serializing.
   QMap<int, std::pair<Function, QString>> mApertures;
+
+  /// Index of #mApertures by function (-1 for none) and definition
+  QHash<QPair<int, QString>, int> mDefinitionIndex;
+
+  /// Index of aperture numbers by the parameters passed to the add methods
+  QHash<ApertureKey, int> mKeyIndex;
 };
 
 /*******************************************************************************
@@ -23,6 +23,7 @@
 #include "gerbergenerator.h"
 
 #include "../application.h"
+#include "../exceptions.h"
 #include "../fileio/fileutils.h"
 #include "../geometry/circle.h"
 #include "../geometry/path.h"
@@ -394,17 +395,24 @@ void GerberGenerator::flashComponentPin(
 
 void GerberGenerator::generate() {
   mOutput.clear();
-  printHeader();
-  printApertureList();
-  printContent();
-  printFooter();
+  QBuffer buffer(&mOutput);
+  buffer.open(QIODevice::WriteOnly);
+  generate(buffer);
+}
+
+void GerberGenerator::generate(QIODevice& device) {
+  OutputSink sink(device);
+  printHeader(sink);  // can throw
+  printApertureList(sink);  // can throw
+  printContent(sink);  // can throw
+  printFooter(sink);  // can throw
 }
 
 void GerberGenerator::saveToFile(const FilePath& filepath) const {
   // Note: Although we save it as UTF-8, usually it will still contain only
   // ASCII characters for maximum compatibility with legacy crappy readers.
   // Unicode is only required when exporting Gerber X3 assembly attributes.
-  FileUtils::writeFile(filepath, mOutput.toUtf8());  // can throw
+  FileUtils::writeFile(filepath, mOutput);  // can throw
 }
 
 /*******************************************************************************
@@ -452,12 +460,14 @@ void GerberGenerator::setCurrentAttributes(
   if (componentRotation) {
     attributes.append(GerberAttribute::componentRotation(*componentRotation));
   }
-  mContent.append(mAttributeWriter->setAttributes(attributes));
+  mContent.append(mAttributeWriter->setAttributes(attributes).toUtf8());
 }
 
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    mContent.append('D');
+    Toolbox::appendInteger(mContent, number);
+    mContent.append("*\n");
     mCurrentApertureNumber = number;
   }
 }
@@ -483,22 +493,25 @@ void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos);
+  mContent.append("D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos);
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
                                                     const Point& center,
                                                     const Point& end) noexcept {
   Point diff = center - start;
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  appendCoordinates(end);
+  mContent.append('I');
+  Toolbox::appendInteger(mContent, diff.getX().toNm());
+  mContent.append('J');
+  Toolbox::appendInteger(mContent, diff.getY().toNm());
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::interpolateBetween(const Vertex& from,
@@ -521,16 +534,24 @@ void GerberGenerator::interpolateBetween(const Vertex& from,
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos);
+  mContent.append("D03*\n");
 }
 
-void GerberGenerator::printHeader() noexcept {
-  mOutput.append("G04 --- HEADER BEGIN --- *\n");
+void GerberGenerator::appendCoordinates(const Point& pos) noexcept {
+  // Coordinate format FSLAX66 is equal to integer nanometers.
+  mContent.append('X');
+  Toolbox::appendInteger(mContent, pos.getX().toNm());
+  mContent.append('Y');
+  Toolbox::appendInteger(mContent, pos.getY().toNm());
+}
+
+void GerberGenerator::printHeader(OutputSink& sink) const {
+  sink.write("G04 --- HEADER BEGIN --- *\n");
 
   // Add file attributes.
   foreach (const GerberAttribute& a, mFileAttributes) {
-    mOutput.append(a.toGerberString());
+    sink.write(a.toGerberString().toUtf8());
   }
 
   // coordinate format specification:
@@ -538,49 +559,65 @@ void GerberGenerator::printHeader() noexcept {
   //  - absolute coordinates
   //  - coordiante format "6.6" --> allows us to directly use LengthBase_t
   //  (nanometers)!
-  mOutput.append("%FSLAX66Y66*%\n");
+  sink.write("%FSLAX66Y66*%\n");
 
   // set unit to millimeters
-  mOutput.append("%MOMM*%\n");
+  sink.write("%MOMM*%\n");
 
   // start linear interpolation mode
-  mOutput.append("G01*\n");
+  sink.write("G01*\n");
 
   // Use multi quadrant arc mode (single quadrant mode is buggy in some CAM
   // software and is now deprecated in the current Gerber specs).
   // See https://github.com/LibrePCB/LibrePCB/issues/247.
-  mOutput.append("G75*\n");
+  sink.write("G75*\n");
 
-  mOutput.append("G04 --- HEADER END --- *\n");
+  sink.write("G04 --- HEADER END --- *\n");
 }
 
-void GerberGenerator::printApertureList() noexcept {
-  mOutput.append("G04 --- APERTURE LIST BEGIN --- *\n");
-  mOutput.append(mApertureList->generateString());
-  mOutput.append("G04 --- APERTURE LIST END --- *\n");
+void GerberGenerator::printApertureList(OutputSink& sink) const {
+  sink.write("G04 --- APERTURE LIST BEGIN --- *\n");
+  sink.write(mApertureList->generateString().toUtf8());
+  sink.write("G04 --- APERTURE LIST END --- *\n");
 }
 
-void GerberGenerator::printContent() noexcept {
-  mOutput.append("G04 --- BOARD BEGIN --- *\n");
-  mOutput.append(mContent);
-  mOutput.append("G04 --- BOARD END --- *\n");
+void GerberGenerator::printContent(OutputSink& sink) const {
+  sink.write("G04 --- BOARD BEGIN --- *\n");
+  sink.write(mContent);
+  sink.write("G04 --- BOARD END --- *\n");
 }
 
-void GerberGenerator::printFooter() noexcept {
+void GerberGenerator::printFooter(OutputSink& sink) const {
   // MD5 checksum over content
-  mOutput.append(
-      GerberAttribute::fileMd5(calcOutputMd5Checksum()).toGerberString());
+  sink.write(GerberAttribute::fileMd5(sink.getMd5Checksum())
+                 .toGerberString()
+                 .toUtf8());
 
   // end of file
-  mOutput.append("M02*\n");
+  sink.write("M02*\n");
+}
+
+void GerberGenerator::OutputSink::write(const QByteArray& data) {
+  // According to the RS-274C standard, linebreaks are not included in the
+  // checksum.
+  int start = 0;
+  while (start < data.size()) {
+    int end = data.indexOf('\n', start);
+    if (end < 0) {
+      end = data.size();
+    }
+    mMd5.addData(data.constData() + start, end - start);
+    start = end + 1;
+  }
+  if (mDevice.write(data) != data.size()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       QString("Failed to write Gerber output: %1")
+                           .arg(mDevice.errorString()));
+  }
 }
 
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
-  // according to the RS-274C standard, linebreaks are not included in the
-  // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+QString GerberGenerator::OutputSink::getMd5Checksum() const noexcept {
+  return QString(mMd5.result().toHex());
 }
 
 /*******************************************************************************
@@ -67,7 +67,8 @@ public:
   ~GerberGenerator() noexcept;
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  QString toStr() const noexcept { return QString::fromUtf8(mOutput); }
+  const QByteArray& toByteArray() const noexcept { return mOutput; }
 
   // Plot Methods
   void setFileFunctionOutlines(bool plated) noexcept;
@@ -129,13 +130,46 @@ public:
                          bool isPin1) noexcept;
 
   // General Methods
+
+  /**
+   * @brief Generate the output into memory
+   *
+   * Afterwards, the output is available by #toByteArray() or #toStr().
+   */
   void generate();
+
+  /**
+   * @brief Stream the output into an I/O device
+   *
+   * In contrast to #generate(), the output is not kept in memory.
+   *
+   * @param device  An opened, writable device (e.g. a file or buffer).
+   */
+  void generate(QIODevice& device);
+
   void saveToFile(const FilePath& filepath) const;
 
   // Operator Overloadings
   GerberGenerator& operator=(const GerberGenerator& rhs) = delete;
 
 private:
+  // Private Types
+
+  /**
+   * @brief Writes output to a device and calculates its checksum on the fly
+   */
+  class OutputSink final {
+  public:
+    explicit OutputSink(QIODevice& device) noexcept
+      : mDevice(device), mMd5(QCryptographicHash::Md5) {}
+    void write(const QByteArray& data);
+    QString getMd5Checksum() const noexcept;
+
+  private:
+    QIODevice& mDevice;
+    QCryptographicHash mMd5;
+  };
+
   // Private Methods
   void setCurrentAttributes(
       Function apertureFunction, const tl::optional<QString>& netName,
@@ -157,18 +191,18 @@ private:
                                      const Point& end) noexcept;
   void interpolateBetween(const Vertex& from, const Vertex& to) noexcept;
   void flashAtPosition(const Point& pos) noexcept;
-  void printHeader() noexcept;
-  void printApertureList() noexcept;
-  void printContent() noexcept;
-  void printFooter() noexcept;
-  QString calcOutputMd5Checksum() const noexcept;
+  void appendCoordinates(const Point& pos) noexcept;
+  void printHeader(OutputSink& sink) const;
+  void printApertureList(OutputSink& sink) const;
+  void printContent(OutputSink& sink) const;
+  void printFooter(OutputSink& sink) const;
 
   // Metadata
   QVector<GerberAttribute> mFileAttributes;
 
   // Gerber Data
-  QString mOutput;
-  QString mContent;
+  QByteArray mOutput;
+  QByteArray mContent;  ///< UTF-8 encoded, like the output
   QScopedPointer<GerberAttributeWriter> mAttributeWriter;
   QScopedPointer<GerberApertureList> mApertureList;
   int mCurrentApertureNumber;
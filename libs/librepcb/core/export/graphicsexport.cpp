@@ -24,6 +24,8 @@
 
 #include "../application.h"
 #include "../fileio/fileutils.h"
+#include "../tracer.h"
+#include "../utils/concurrency.h"
 #include "graphicsexportsettings.h"
 #include "utils/qtmetatyperegistration.h"
 
@@ -36,6 +38,8 @@
 Q_DECLARE_METATYPE(QImage)
 Q_DECLARE_METATYPE(std::shared_ptr<QPicture>)
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -45,6 +49,9 @@ namespace librepcb {
 static QtMetaTypeRegistration<QImage> sImageMetaType;
 static QtMetaTypeRegistration<std::shared_ptr<QPicture>> sSharedPictureMetaType;
 
+// Height of the bands rendered concurrently in tiled rendering mode [px].
+static const int sTileHeight = 256;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -54,9 +61,15 @@ GraphicsExport::GraphicsExport(QObject* parent) noexcept
     mCreator(QString("LibrePCB %1").arg(Application::getVersion())),
     mDocumentName(),
     mFuture(),
-    mAbort(false) {
-  connect(this, &GraphicsExport::imageCopiedToClipboard, qApp->clipboard(),
-          &QClipboard::setImage, Qt::BlockingQueuedConnection);
+    mAbort(false),
+    mTiledRendering(true) {
+  // Note: The clipboard must not be created from a worker thread, e.g. when
+  // running output jobs concurrently. Copying to the clipboard is only
+  // supported by exports created in the main thread.
+  if (QThread::currentThread() == qApp->thread()) {
+    connect(this, &GraphicsExport::imageCopiedToClipboard, qApp->clipboard(),
+            &QClipboard::setImage, Qt::BlockingQueuedConnection);
+  }
 }
 
 GraphicsExport::~GraphicsExport() noexcept {
@@ -129,6 +142,7 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
   // Note: This method is called from a different thread, thus be careful with
   //       calling other methods to only call thread-safe methods!
 
+  Tracer::Span span("export", "GraphicsExport::run");
   QElapsedTimer timer;
   timer.start();
   qDebug() << "Start graphics export in worker thread...";
@@ -179,12 +193,59 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
       emit savingFile(args.filePath);
     }
 
+    // Previews don't share an output device, so each page is rendered
+    // completely in a worker thread and published as soon as it is ready.
+    if (args.preview) {
+      QThreadPool threadPool;  // Waits for all workers on destruction.
+      Concurrency::apply(threadPool);
+      QVector<QFuture<void>> futures;
+      for (int index = 0; index < args.pages.count(); ++index) {
+        const Page page = args.pages.at(index);
+        futures.append(QtConcurrent::run(&threadPool, [this, index, page]() {
+          if (!mAbort) {
+            renderPreview(index, page);
+          }
+        }));
+      }
+      for (int index = 0; index < futures.count(); ++index) {
+        futures[index].waitForFinished();
+        emit progress(20 + (80 * (index + 1)) / futures.count(), index + 1,
+                      futures.count());
+      }
+      qDebug() << "Successfully generated preview in" << timer.elapsed()
+               << "ms.";
+      emit progress(100, args.pages.count(), args.pages.count());
+      emit succeeded();
+      return result;
+    }
+
     // QPagedPaintDevice fails if there are no pages, so let's throw a clear
     // error in that case.
     if ((pagedPaintDevice) && args.pages.isEmpty()) {
       throw RuntimeError(__FILE__, __LINE__, tr("No pages to export/print."));
     }
 
+    // Prepare the layout of all pages concurrently since it involves painting
+    // each page once to determine its bounding rect. Only the painting onto
+    // the output device is serialized. Note that this method already runs in
+    // the global thread pool, so let's use a dedicated pool to not compete
+    // with ourselves for worker threads.
+    int deviceDpi = 0;  // 0 = Use pixmap DPI of the page settings.
+    if (printer) {
+      deviceDpi = printer->resolution();
+    } else if (pdfWriter) {
+      deviceDpi = pdfWriter->resolution();
+    }
+    QThreadPool threadPool;  // Waits for all workers on destruction.
+    Concurrency::apply(threadPool);
+    QVector<QFuture<PageLayout>> layoutFutures;
+    auto prepare = [this, deviceDpi](const Page& page) {
+      return mAbort ? PageLayout() : calcPageLayout(page, deviceDpi);
+    };
+    foreach (const Page& page, args.pages) {
+      layoutFutures.append(QtConcurrent::run(&threadPool, prepare, page));
+    }
+
     // Export all pages.
     QPainter painter;
     for (int index = 0; index < args.pages.count(); ++index) {
@@ -196,49 +257,22 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
         break;
       }
 
-      // Determine source bounding rect.
-      QRectF sourceRectPx = calcSourceRect(*page.first, *page.second);
-      QTransform sourceTransform = getSourceTransformation(*page.second);
-      QRectF sourceRectTransformedPx = sourceTransform.mapRect(sourceRectPx);
+      // Wait until the layout of this page is prepared.
+      const PageLayout layout = layoutFutures[index].result();
+      const QRect& pageRectPx = layout.pageRectPx;
+      const int dpi = layout.dpi;
 
-      // Determine output page size.
-      QPageSize pageSize;
-      if (page.second->getPageSize() && page.second->getPageSize()->isValid()) {
-        // Fixed page size is specified.
-        pageSize = *page.second->getPageSize();
-      } else {
-        // Derive page size from source size.
-        Length width = Length::fromPx(sourceRectTransformedPx.width()) +
-            *page.second->getMarginLeft() + *page.second->getMarginRight();
-        Length height = Length::fromPx(sourceRectTransformedPx.height()) +
-            *page.second->getMarginTop() + *page.second->getMarginBottom();
-        pageSize =
-            QPageSize(QSizeF(width.toMm(), height.toMm()),
-                      QPageSize::Millimeter, "Custom", QPageSize::ExactMatch);
-      }
-      if (pagedPaintDevice && (!pagedPaintDevice->setPageSize(pageSize))) {
+      // Setup page of paged output devices.
+      if (pagedPaintDevice &&
+          (!pagedPaintDevice->setPageSize(layout.pageSize))) {
         qCritical().nospace()
             << "Failed to set page size for graphics export to "
-            << pageSize.name() << ".";
-      }
-
-      // Determine output page orientation.
-      QPageLayout::Orientation pageOrientation;
-      switch (page.second->getOrientation()) {
-        case GraphicsExportSettings::Orientation::Landscape:
-          pageOrientation = QPageLayout::Landscape;
-          break;
-        case GraphicsExportSettings::Orientation::Portrait:
-          pageOrientation = QPageLayout::Portrait;
-          break;
-        case GraphicsExportSettings::Orientation::Auto:
-        default:
-          pageOrientation = getOrientation(sourceRectTransformedPx.size());
-          break;
+            << layout.pageSize.name() << ".";
       }
       if (pagedPaintDevice) {
-        QPageLayout::Orientation orientation = pageOrientation;
-        if (getOrientation(pageSize.sizePoints()) == QPageLayout::Landscape) {
+        QPageLayout::Orientation orientation = layout.orientation;
+        if (getOrientation(layout.pageSize.sizePoints()) ==
+            QPageLayout::Landscape) {
           // QPagedPaintDevice orientation seems to be swapped if page size is
           // landscape (e.g. the Ledger/Tabloid page size).
           if (orientation == QPageLayout::Landscape) {
@@ -252,37 +286,6 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
         }
       }
 
-      // Determine DPI.
-      int dpi;
-      if (printer) {
-        dpi = printer->resolution();
-      } else if (pdfWriter) {
-        dpi = pdfWriter->resolution();
-      } else {
-        dpi = page.second->getPixmapDpi();
-      }
-      const qreal pxScale = static_cast<qreal>(dpi) / Length(25400000).toPx();
-
-      // Calculate page margins in output device pixels.
-      const QMarginsF pageMarginsPx(
-          page.second->getMarginLeft()->toInch() * dpi,
-          page.second->getMarginTop()->toInch() * dpi,
-          page.second->getMarginRight()->toInch() * dpi,
-          page.second->getMarginBottom()->toInch() * dpi);
-
-      // Determine output page rect.
-      QRect pageRectPx = pageSize.rectPixels(dpi);
-      if (getOrientation(pageRectPx.size()) != pageOrientation) {
-        pageRectPx.setSize(pageRectPx.size().transposed());
-      }
-      const QRectF pageContentRectPx = pageRectPx - pageMarginsPx;
-
-      // Calculate final scale factor.
-      const qreal scale = page.second->getScale()
-          ? pxScale
-          : qMin(pageContentRectPx.width() / sourceRectTransformedPx.width(),
-                 pageContentRectPx.height() / sourceRectTransformedPx.height());
-
       // Determine output file path.
       const FilePath outputFilePath = (!outputFilePathTmpl.isEmpty())
           ? FilePath(outputFilePathTmpl.arg(index + 1))
@@ -299,7 +302,7 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
       bool beginSuccess = false;
       QScopedPointer<QSvgGenerator> svgGenerator;
       QScopedPointer<QImage> image;
-      std::shared_ptr<QPicture> picture;
+      bool tiled = false;
       if (pagedPaintDevice) {
         qDebug().nospace() << "Export page " << (index + 1) << " to "
                            << args.printerName % args.filePath.toStr() << "...";
@@ -320,7 +323,7 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
         beginSuccess = painter.begin(svgGenerator.data());
         result.writtenFiles.append(outputFilePath);
         emit savingFile(outputFilePath);
-      } else if (!args.preview) {
+      } else {
         QString target =
             outputFilePath.isValid() ? outputFilePath.toStr() : "clipboard";
         qDebug().nospace() << "Export page " << (index + 1) << " as pixmap to "
@@ -328,15 +331,14 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
         image.reset(
             new QImage(pageRectPx.size(), QImage::Format_ARGB32_Premultiplied));
         image->fill(Qt::transparent);
-        beginSuccess = painter.begin(image.data());
-        painter.setRenderHints(QPainter::Antialiasing |
-                               QPainter::SmoothPixmapTransform);
-      } else {
-        qDebug().nospace() << "Generate preview of page " << index + 1 << "...";
-        picture = std::make_shared<QPicture>();
-        beginSuccess = painter.begin(picture.get());
-        painter.setRenderHints(QPainter::Antialiasing |
-                               QPainter::SmoothPixmapTransform);
+        tiled = mTiledRendering && (image->height() > sTileHeight);
+        if (tiled) {
+          beginSuccess = !image->isNull();  // Painters are created per tile.
+        } else {
+          beginSuccess = painter.begin(image.data());
+          painter.setRenderHints(QPainter::Antialiasing |
+                                 QPainter::SmoothPixmapTransform);
+        }
       }
       if (!beginSuccess) {
         throw RuntimeError(
@@ -345,20 +347,15 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
       }
 
       // Perform the export.
-      painter.save();
-      if (page.second->getBackgroundColor().alpha() > 0) {
-        painter.fillRect(pageRectPx, page.second->getBackgroundColor());
+      auto paint = [&](QPainter& p) { paintPage(p, page, layout, nullptr); };
+      if (tiled) {
+        renderImageTiled(*image, paint);  // can throw
+      } else {
+        paint(painter);
       }
-      painter.translate(pageContentRectPx.center().x(),
-                        pageContentRectPx.center().y());
-      painter.setTransform(sourceTransform, true);
-      painter.scale(scale, scale);
-      painter.translate(-sourceRectPx.center().x(), -sourceRectPx.center().y());
-      page.first->paint(painter, *page.second);
-      painter.restore();
 
       // Finish painting of current page.
-      if ((!pagedPaintDevice) && (!painter.end())) {
+      if ((!pagedPaintDevice) && (!tiled) && (!painter.end())) {
         throw RuntimeError(__FILE__, __LINE__, "Failed to finish painting.");
       }
       if (image && outputFilePath.isValid()) {
@@ -377,9 +374,6 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
         // connection.
         emit imageCopiedToClipboard(*image, QClipboard::Clipboard);
       }
-      if (picture) {
-        emit previewReady(index, pageRectPx.size(), pageContentRectPx, picture);
-      }
       emit progress(20 + std::ceil(percentPerPage * (index + 1)), index + 1,
                     args.pages.count());
     }
@@ -420,6 +414,160 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
   }
 }
 
+void GraphicsExport::renderImageTiled(
+    QImage& image, const std::function<void(QPainter&)>& paint) const {
+  // Each tile is a QImage referencing a band of scanlines of the output image,
+  // thus the tiles are rendered directly into the output buffer without any
+  // copying. Since the bands don't overlap, the workers don't interfere.
+  // Note that this method already runs in the global thread pool, so let's
+  // use a dedicated pool to not compete with ourselves for worker threads.
+  const int width = image.width();
+  const int bytesPerLine = image.bytesPerLine();
+  const QImage::Format format = image.format();
+  uchar* bits = image.bits();  // Detach before starting the workers.
+  QThreadPool threadPool;  // Waits for all workers on destruction.
+  Concurrency::apply(threadPool);
+  QVector<QFuture<bool>> futures;
+  for (int y = 0; y < image.height(); y += sTileHeight) {
+    const int height = std::min(sTileHeight, image.height() - y);
+    futures.append(QtConcurrent::run(&threadPool, [=, &paint]() {
+      if (mAbort) {
+        return true;
+      }
+      QImage tile(bits + (y * bytesPerLine), width, height, bytesPerLine,
+                  format);
+      QPainter painter;
+      if (!painter.begin(&tile)) {
+        return false;
+      }
+      painter.setRenderHints(QPainter::Antialiasing |
+                             QPainter::SmoothPixmapTransform);
+      painter.translate(0, -y);
+      paint(painter);
+      return painter.end();
+    }));
+  }
+  bool success = true;
+  for (QFuture<bool>& future : futures) {
+    success = future.result() && success;
+  }
+  if (!success) {
+    throw RuntimeError(__FILE__, __LINE__, "Failed to paint image tile.");
+  }
+}
+
+void GraphicsExport::renderPreview(int index, const Page& page) noexcept {
+  // Note: This method is called from worker threads, thus be careful with
+  //       calling other methods to only call thread-safe methods!
+
+  // The page content is recorded only once while determining the layout and
+  // then just replayed into the preview, which is much cheaper than painting
+  // it a second time.
+  QPicture content;
+  const PageLayout layout = calcPageLayout(page, 0, &content);
+  std::shared_ptr<QPicture> picture = std::make_shared<QPicture>();
+  QPainter painter;
+  if (!painter.begin(picture.get())) {
+    qCritical() << "Failed to generate preview of page" << (index + 1);
+    return;
+  }
+  painter.setRenderHints(QPainter::Antialiasing |
+                         QPainter::SmoothPixmapTransform);
+  paintPage(painter, page, layout, &content);
+  painter.end();
+  emit previewReady(index, layout.pageRectPx.size(), layout.pageContentRectPx,
+                    picture);
+}
+
+void GraphicsExport::paintPage(QPainter& painter, const Page& page,
+                               const PageLayout& layout,
+                               const QPicture* content) noexcept {
+  painter.save();
+  if (page.second->getBackgroundColor().alpha() > 0) {
+    painter.fillRect(layout.pageRectPx, page.second->getBackgroundColor());
+  }
+  painter.translate(layout.pageContentRectPx.center().x(),
+                    layout.pageContentRectPx.center().y());
+  painter.setTransform(layout.sourceTransform, true);
+  painter.scale(layout.scale, layout.scale);
+  painter.translate(-layout.sourceRectPx.center().x(),
+                    -layout.sourceRectPx.center().y());
+  if (content) {
+    painter.drawPicture(0, 0, *content);
+  } else {
+    page.first->paint(painter, *page.second);
+  }
+  painter.restore();
+}
+
+GraphicsExport::PageLayout GraphicsExport::calcPageLayout(
+    const Page& page, int deviceDpi, QPicture* content) noexcept {
+  PageLayout layout;
+
+  // Determine source bounding rect.
+  QPicture picture;
+  layout.sourceRectPx = calcSourceRect(*page.first, *page.second,
+                                       content ? *content : picture);
+  layout.sourceTransform = getSourceTransformation(*page.second);
+  const QRectF sourceRectTransformedPx =
+      layout.sourceTransform.mapRect(layout.sourceRectPx);
+
+  // Determine output page size.
+  if (page.second->getPageSize() && page.second->getPageSize()->isValid()) {
+    // Fixed page size is specified.
+    layout.pageSize = *page.second->getPageSize();
+  } else {
+    // Derive page size from source size.
+    Length width = Length::fromPx(sourceRectTransformedPx.width()) +
+        *page.second->getMarginLeft() + *page.second->getMarginRight();
+    Length height = Length::fromPx(sourceRectTransformedPx.height()) +
+        *page.second->getMarginTop() + *page.second->getMarginBottom();
+    layout.pageSize =
+        QPageSize(QSizeF(width.toMm(), height.toMm()), QPageSize::Millimeter,
+                  "Custom", QPageSize::ExactMatch);
+  }
+
+  // Determine output page orientation.
+  switch (page.second->getOrientation()) {
+    case GraphicsExportSettings::Orientation::Landscape:
+      layout.orientation = QPageLayout::Landscape;
+      break;
+    case GraphicsExportSettings::Orientation::Portrait:
+      layout.orientation = QPageLayout::Portrait;
+      break;
+    case GraphicsExportSettings::Orientation::Auto:
+    default:
+      layout.orientation = getOrientation(sourceRectTransformedPx.size());
+      break;
+  }
+
+  // Determine DPI.
+  const int dpi = (deviceDpi > 0) ? deviceDpi : page.second->getPixmapDpi();
+  const qreal pxScale = static_cast<qreal>(dpi) / Length(25400000).toPx();
+  layout.dpi = dpi;
+
+  // Calculate page margins in output device pixels.
+  const QMarginsF pageMarginsPx(page.second->getMarginLeft()->toInch() * dpi,
+                                page.second->getMarginTop()->toInch() * dpi,
+                                page.second->getMarginRight()->toInch() * dpi,
+                                page.second->getMarginBottom()->toInch() * dpi);
+
+  // Determine output page rect.
+  layout.pageRectPx = layout.pageSize.rectPixels(dpi);
+  if (getOrientation(layout.pageRectPx.size()) != layout.orientation) {
+    layout.pageRectPx.setSize(layout.pageRectPx.size().transposed());
+  }
+  layout.pageContentRectPx = layout.pageRectPx - pageMarginsPx;
+
+  // Calculate final scale factor.
+  layout.scale = page.second->getScale()
+      ? pxScale
+      : qMin(layout.pageContentRectPx.width() / sourceRectTransformedPx.width(),
+             layout.pageContentRectPx.height() /
+                 sourceRectTransformedPx.height());
+  return layout;
+}
+
 QTransform GraphicsExport::getSourceTransformation(
     const GraphicsExportSettings& settings) noexcept {
   QTransform t;
@@ -437,8 +585,7 @@ QTransform GraphicsExport::getSourceTransformation(
 
 QRectF GraphicsExport::calcSourceRect(
     const GraphicsPagePainter& page,
-    const GraphicsExportSettings& settings) noexcept {
-  QPicture picture;
+    const GraphicsExportSettings& settings, QPicture& picture) noexcept {
   QPainter painter;
   painter.begin(&picture);
   page.paint(painter, settings);
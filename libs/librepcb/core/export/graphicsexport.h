@@ -33,6 +33,7 @@
 #include <QtGui>
 #include <QtPrintSupport>
 
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -116,11 +117,23 @@ public:
    */
   void setDocumentName(const QString& name) noexcept { mDocumentName = name; }
 
+  /**
+   * @brief Enable or disable tiled rendering of pixmap exports
+   *
+   * If enabled (the default), pixmaps are split into horizontal bands which
+   * are rasterized concurrently. The resulting images are identical in both
+   * modes, so this is mainly useful for debugging.
+   *
+   * @param tiled   Whether pixmaps shall be rendered in parallel tiles.
+   */
+  void setTiledRendering(bool tiled) noexcept { mTiledRendering = tiled; }
+
   /**
    * @brief Start creating previews asynchronously
    *
    * The signal #previewReady() will be emitted from a worker thread for
-   * each processed page.
+   * each processed page. Pages are rendered concurrently, thus the signals
+   * may be emitted in any order.
    *
    * @param pages     The pages to create the preview of.
    */
@@ -204,12 +217,32 @@ private:  // Types
     int copies;
   };
 
+  struct PageLayout {
+    QRectF sourceRectPx;
+    QTransform sourceTransform;
+    QPageSize pageSize;
+    QPageLayout::Orientation orientation = QPageLayout::Portrait;
+    int dpi = 0;
+    QRect pageRectPx;
+    QRectF pageContentRectPx;
+    qreal scale = 1;
+  };
+
 private:  // Methods
   Result run(RunArgs args) noexcept;
+  void renderImageTiled(QImage& image,
+                        const std::function<void(QPainter&)>& paint) const;
+  void renderPreview(int index, const Page& page) noexcept;
+  static void paintPage(QPainter& painter, const Page& page,
+                        const PageLayout& layout,
+                        const QPicture* content) noexcept;
+  static PageLayout calcPageLayout(const Page& page, int deviceDpi,
+                                   QPicture* content = nullptr) noexcept;
   static QTransform getSourceTransformation(
       const GraphicsExportSettings& settings) noexcept;
   static QRectF calcSourceRect(const GraphicsPagePainter& page,
-                               const GraphicsExportSettings& settings) noexcept;
+                               const GraphicsExportSettings& settings,
+                               QPicture& picture) noexcept;
   static QPageLayout::Orientation getOrientation(const QSizeF& size) noexcept;
 
 private:  // Data
@@ -217,6 +250,7 @@ private:  // Data
   QString mDocumentName;
   QFuture<Result> mFuture;
   bool mAbort;
+  bool mTiledRendering;
 };
 
 /*******************************************************************************
@@ -24,6 +24,7 @@
 
 #include "../application.h"
 #include "../fileio/csvfile.h"
+#include "../fileio/csvwriter.h"
 #include "pickplacedata.h"
 
 #include <QtCore>
@@ -59,57 +60,61 @@ PickPlaceCsvWriter::~PickPlaceCsvWriter() noexcept {
  ******************************************************************************/
 
 std::shared_ptr<CsvFile> PickPlaceCsvWriter::generateCsv() const {
-  // Names for all mount types.
-  static QVector<PickPlaceDataItem::Type> types = {
-      PickPlaceDataItem::Type::Tht,   PickPlaceDataItem::Type::Smt,
-      PickPlaceDataItem::Type::Mixed, PickPlaceDataItem::Type::Fiducial,
-      PickPlaceDataItem::Type::Other,
-  };
-  static QStringList typeNames = {
-      "THT", "SMT", "THT+SMT", "Fiducial", "Other",
-  };
-  auto getTypeName = [](PickPlaceDataItem::Type type) {
-    return typeNames.value(types.indexOf(type), "Other");
-  };
-
   std::shared_ptr<CsvFile> file(new CsvFile());
+  file->setComment(getComment());
+  file->setHeader(getHeader());
+  forEachRow([&file](const QStringList& values) {
+    file->addValue(values);  // can throw
+  });
+  return file;
+}
+
+void PickPlaceCsvWriter::writeCsv(CsvWriter& writer) const {
+  writer.writeComment(getComment());
+  writer.writeHeader(getHeader());
+  forEachRow([&writer](const QStringList& values) {
+    writer.writeRow(values);
+  });
+}
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QString PickPlaceCsvWriter::getComment() const noexcept {
   // Optionally add some metadata to to the CSV as a help for readers.
-  if (mIncludeMetadataComment) {
-    QStringList enabledTypeNames;
-    foreach (auto type, types) {
-      if (mTypeFilter.contains(type)) {
-        enabledTypeNames.append(getTypeName(type));
-      }
+  if (!mIncludeMetadataComment) {
+    return QString();
+  }
+  QStringList enabledTypeNames;
+  foreach (auto type, getTypes()) {
+    if (mTypeFilter.contains(type)) {
+      enabledTypeNames.append(getTypeName(type));
     }
-    QString comment =
-        QString(
-            "Pick&Place Position Data File\n"
-            "\n"
-            "Project Name:        %1\n"
-            "Project Version:     %2\n"
-            "Board Name:          %3\n"
-            "Generation Software: LibrePCB %4\n"
-            "Generation Date:     %5\n"
-            "Unit:                mm\n"
-            "Rotation:            Degrees CCW\n"
-            "Board Side:          %6\n"
-            "Assembly Types:      %7")
-            .arg(mData.getProjectName())
-            .arg(mData.getProjectVersion())
-            .arg(mData.getBoardName())
-            .arg(Application::getVersion())
-            .arg(QDateTime::currentDateTime().toString(Qt::ISODate))
-            .arg(boardSideToString(mBoardSide))
-            .arg(enabledTypeNames.join(", "));
-    file->setComment(comment);
   }
+  return QString(
+             "Pick&Place Position Data File\n"
+             "\n"
+             "Project Name:        %1\n"
+             "Project Version:     %2\n"
+             "Board Name:          %3\n"
+             "Generation Software: LibrePCB %4\n"
+             "Generation Date:     %5\n"
+             "Unit:                mm\n"
+             "Rotation:            Degrees CCW\n"
+             "Board Side:          %6\n"
+             "Assembly Types:      %7")
+      .arg(mData.getProjectName())
+      .arg(mData.getProjectVersion())
+      .arg(mData.getBoardName())
+      .arg(Application::getVersion())
+      .arg(QDateTime::currentDateTime().toString(Qt::ISODate))
+      .arg(boardSideToString(mBoardSide))
+      .arg(enabledTypeNames.join(", "));
+}
 
-  // Don't translate the CSV header to make pick&place files independent of the
-  // user's language.
-  file->setHeader({"Designator", "Value", "Device", "Package", "Position X",
-                   "Position Y", "Rotation", "Side", "Type"});
-
+void PickPlaceCsvWriter::forEachRow(
+    const std::function<void(const QStringList&)>& callback) const {
   foreach (const PickPlaceDataItem& item, mData.getItems()) {
     if (isOnBoardSide(item, mBoardSide) &&
         (mTypeFilter.contains(item.getType())) &&
@@ -126,16 +131,35 @@ std::shared_ptr<CsvFile> PickPlaceCsvWriter::generateCsv() const {
           ? "Top"
           : "Bottom";
       values += getTypeName(item.getType());
-      file->addValue(values);  // can throw
+      callback(values);  // can throw
     }
   }
+}
 
-  return file;
+QStringList PickPlaceCsvWriter::getHeader() noexcept {
+  // Don't translate the CSV header to make pick&place files independent of the
+  // user's language.
+  return {"Designator", "Value", "Device", "Package", "Position X",
+          "Position Y", "Rotation", "Side", "Type"};
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
+const QVector<PickPlaceDataItem::Type>&
+    PickPlaceCsvWriter::getTypes() noexcept {
+  static QVector<PickPlaceDataItem::Type> types = {
+      PickPlaceDataItem::Type::Tht,   PickPlaceDataItem::Type::Smt,
+      PickPlaceDataItem::Type::Mixed, PickPlaceDataItem::Type::Fiducial,
+      PickPlaceDataItem::Type::Other,
+  };
+  return types;
+}
+
+QString PickPlaceCsvWriter::getTypeName(PickPlaceDataItem::Type type) noexcept {
+  // Names for all mount types.
+  static QStringList typeNames = {
+      "THT", "SMT", "THT+SMT", "Fiducial", "Other",
+  };
+  return typeNames.value(getTypes().indexOf(type), "Other");
+}
 
 bool PickPlaceCsvWriter::isOnBoardSide(const PickPlaceDataItem& item,
                                        BoardSide side) noexcept {
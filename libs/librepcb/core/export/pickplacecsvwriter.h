@@ -27,6 +27,7 @@
 
 #include <QtCore>
 
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -35,6 +36,7 @@
 namespace librepcb {
 
 class CsvFile;
+class CsvWriter;
 
 /*******************************************************************************
  *  Class PickPlaceCsvWriter
@@ -70,10 +72,25 @@ public:
   // General Methods
   std::shared_ptr<CsvFile> generateCsv() const;
 
+  /**
+   * @brief Write the CSV directly to a streaming writer
+   *
+   * Same content as #generateCsv(), but without keeping all rows in memory.
+   *
+   * @param writer  The writer to append the CSV content to.
+   */
+  void writeCsv(CsvWriter& writer) const;
+
   // Operator Overloadings
   PickPlaceCsvWriter& operator=(const PickPlaceCsvWriter& rhs) = delete;
 
 private:  // Methods
+  QString getComment() const noexcept;
+  void forEachRow(
+      const std::function<void(const QStringList&)>& callback) const;
+  static QStringList getHeader() noexcept;
+  static const QVector<PickPlaceDataItem::Type>& getTypes() noexcept;
+  static QString getTypeName(PickPlaceDataItem::Type type) noexcept;
   static bool isOnBoardSide(const PickPlaceDataItem& item,
                             BoardSide side) noexcept;
   static QString boardSideToString(BoardSide side) noexcept;
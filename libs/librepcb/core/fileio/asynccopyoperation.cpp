@@ -23,15 +23,25 @@
 #include "asynccopyoperation.h"
 
 #include "../exceptions.h"
+#include "../utils/concurrency.h"
 #include "fileutils.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
+#include <atomic>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/// Maximum number of files copied by a single worker task
+static const int sBatchMaxFiles = 64;
+
+/// Maximum number of bytes copied by a single worker task
+static const qint64 sBatchMaxBytes = 8 * 1024 * 1024;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -39,7 +49,11 @@ namespace librepcb {
 AsyncCopyOperation::AsyncCopyOperation(const FilePath& source,
                                        const FilePath& destination,
                                        QObject* parent) noexcept
-  : QThread(parent), mSource(source), mDestination(destination), mAbort(false) {
+  : QThread(parent),
+    mSource(source),
+    mDestination(destination),
+    mParallelCopy(true),
+    mAbort(false) {
 }
 
 AsyncCopyOperation::~AsyncCopyOperation() noexcept {
@@ -84,24 +98,78 @@ void AsyncCopyOperation::run() noexcept {
 
     // Get list of entries to copy
     emit progressStatus(tr("Looking for files to copy..."));
-    QList<FilePath> files = FileUtils::getFilesInDirectory(
+    const QList<FilePath> files = FileUtils::getFilesInDirectory(
         mSource, QStringList(), true);  // can throw
+    QVector<qint64> sizes;
+    qint64 totalBytes = 0;
+    foreach (const FilePath& src, files) {
+      sizes.append(QFileInfo(src.toStr()).size());
+      totalBytes += sizes.last();
+    }
 
     try {
-      for (int i = 0; i < files.count(); ++i) {
-        if (mAbort) {
-          throw UserCanceled(__FILE__, __LINE__);
+      // Create all directories upfront to avoid creating them concurrently.
+      QSet<FilePath> dirs;
+      foreach (const FilePath& src, files) {
+        const FilePath dir =
+            tmpDst.getPathTo(src.toRelative(mSource)).getParentDir();
+        if (!dirs.contains(dir)) {
+          FileUtils::makePath(dir);  // can throw
+          dirs.insert(dir);
+        }
+      }
+
+      // Copy files in batches on a thread pool, to reduce the overhead of
+      // many small files. Note: QFile::copy() already makes use of cheap
+      // file clones on supporting file systems.
+      std::atomic<bool> cancel(false);
+      std::atomic<int> copiedFiles(0);
+      std::atomic<qint64> copiedBytes(0);
+      auto copyBatch = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          if (mAbort || cancel) {
+            throw UserCanceled(__FILE__, __LINE__);
+          }
+          const FilePath src = files.at(i);
+          const FilePath dst = tmpDst.getPathTo(src.toRelative(mSource));
+          FileUtils::copyFile(src, dst);  // can throw
+          copiedBytes += sizes.at(i);
+          ++copiedFiles;
         }
-        FilePath src = files.at(i);
-        QString srcRelative = src.toRelative(mSource);
-        FilePath dst = tmpDst.getPathTo(srcRelative);
-        if (i % ((files.count() / 100) + 1) == 0) {
-          emit progressStatus(
-              tr("Copy file %1 of %2...").arg(i + 1).arg(files.count()));
-          emit progressPercent((95 * (i + 1)) / files.count());
+      };
+      QThreadPool threadPool;  // Waits for all workers on destruction.
+      Concurrency::apply(threadPool);
+      if (!mParallelCopy) {
+        threadPool.setMaxThreadCount(1);
+      }
+      QList<QFuture<void>> futures;
+      for (int begin = 0; begin < files.count();) {
+        int end = begin;
+        qint64 batchBytes = 0;
+        while ((end < files.count()) && ((end - begin) < sBatchMaxFiles) &&
+               (batchBytes < sBatchMaxBytes)) {
+          batchBytes += sizes.at(end++);
+        }
+        futures.append(QtConcurrent::run(&threadPool, copyBatch, begin, end));
+        begin = end;
+      }
+      try {
+        foreach (QFuture<void> future, futures) {
+          future.waitForFinished();  // can throw
+          const int fileCount = copiedFiles;
+          const qint64 byteCount = copiedBytes;
+          const int percent = (totalBytes > 0)
+              ? static_cast<int>((95 * byteCount) / totalBytes)
+              : ((95 * fileCount) / files.count());
+          emit progressStatus(tr("Copy file %1 of %2...")
+                                  .arg(std::min(fileCount + 1, files.count()))
+                                  .arg(files.count()));
+          emit progressPercent(percent);
+          emit progressBytes(byteCount, totalBytes);
         }
-        FileUtils::makePath(dst.getParentDir());  // can throw
-        FileUtils::copyFile(src, dst);  // can throw
+      } catch (...) {
+        cancel = true;  // Stop all other workers as soon as possible.
+        throw;
       }
 
       emit progressStatus(tr("Renaming temporary directory..."));
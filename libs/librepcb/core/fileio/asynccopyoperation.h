@@ -55,6 +55,17 @@ public:
   const FilePath& getSource() const noexcept { return mSource; }
   const FilePath& getDestination() const noexcept { return mDestination; }
 
+  // Setters
+
+  /**
+   * @brief Enable or disable copying files in parallel
+   *
+   * @param parallel  If true (default), files are copied by a thread pool.
+   *
+   * @note Must be called before starting the operation.
+   */
+  void setParallelCopy(bool parallel) noexcept { mParallelCopy = parallel; }
+
   // General Methods
 
   /**
@@ -77,6 +88,7 @@ signals:
   void started();
   void progressStatus(const QString& status);
   void progressPercent(int percent);
+  void progressBytes(qint64 copied, qint64 total);
   void succeeded();
   void failed(const QString& error);
   void finished();
@@ -87,6 +99,7 @@ private:  // Methods
 private:  // Data
   FilePath mSource;
   FilePath mDestination;
+  bool mParallelCopy;
   volatile bool mAbort;
 };
 
@@ -24,6 +24,7 @@
 
 #include "../exceptions.h"
 #include "../fileio/fileutils.h"
+#include "csvwriter.h"
 
 #include <QtCore>
 
@@ -64,63 +65,25 @@ void CsvFile::addValue(const QStringList& value) {
 }
 
 QString CsvFile::toString() const noexcept {
-  QString str = getCommentLines();
-  str += lineToString(mHeader);
-  foreach (const QStringList& value, mValues) {
-    str += lineToString(value);
-  }
-  return str;
+  return QString::fromUtf8(toUtf8());
 }
 
 void CsvFile::saveToFile(const FilePath& csvFp) const {
-  FileUtils::writeFile(csvFp, toString().toUtf8());
+  FileUtils::writeFile(csvFp, toUtf8());
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-QString CsvFile::getCommentLines() const noexcept {
-  QString str;
-  if (!mComment.isEmpty()) {
-    foreach (QString line, mComment.split("\n", QString::KeepEmptyParts)) {
-      str += "# " % line;
-      while (str[str.count() - 1].isSpace()) {
-        str.chop(1);
-      }
-      str += "\n";
-    }
-    str += "\n";  // separate comment and CSV data with an empty line
-  }
-  return str;
-}
-
-QString CsvFile::lineToString(const QStringList& line) const noexcept {
-  QString str;
-  // Note: To guarantee equal value count on each line, we always use the
-  //       header to determine the value count. If a line contains more values,
-  //       they are ignored. If a line contains less values, empty strings will
-  //       be used instead.
-  for (int i = 0; i < mHeader.count(); ++i) {
-    str += escapeValue(line.value(i));
-    if (i < mHeader.count() - 1) {
-      str += ",";
-    } else {
-      str += "\n";
-    }
-  }
-  return str;
-}
-
-QString CsvFile::escapeValue(const QString& value) noexcept {
-  QString escaped = value;
-  escaped.remove("\r");  // remove DOS line endings, if any
-  escaped.replace("\n", " ");  // replace linebreaks by spaces
-  if (escaped.contains(",") || escaped.contains("\"")) {
-    escaped.replace("\"", "\"\"");  // escape quotes
-    escaped = "\"" + escaped + "\"";  // add quotes around value
+QByteArray CsvFile::toUtf8() const noexcept {
+  CsvWriter writer;
+  writer.writeComment(mComment);
+  writer.writeHeader(mHeader);
+  foreach (const QStringList& value, mValues) {
+    writer.writeRow(value);
   }
-  return escaped;
+  return writer.getData();
 }
 
 /*******************************************************************************
@@ -53,6 +53,9 @@ class FilePath;
  *       #addValue()! This is needed to make sure all value rows have the same
  *       value count as the header.
  *
+ * @note For large files which don't need to be kept in memory, consider
+ *       using ::librepcb::CsvWriter instead.
+ *
  * @see https://en.wikipedia.org/wiki/Comma-separated_values
  */
 class CsvFile final {
@@ -131,9 +134,7 @@ public:
   CsvFile& operator=(const CsvFile& rhs) = delete;
 
 private:  // Methods
-  QString getCommentLines() const noexcept;
-  QString lineToString(const QStringList& line) const noexcept;
-  static QString escapeValue(const QString& value) noexcept;
+  QByteArray toUtf8() const noexcept;
 
 private:  // Data
   QString mComment;
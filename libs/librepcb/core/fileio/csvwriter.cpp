@@ -0,0 +1,101 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "csvwriter.h"
+
+#include "fileutils.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+CsvWriter::CsvWriter() noexcept : mColumnCount(0), mData() {
+}
+
+CsvWriter::~CsvWriter() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void CsvWriter::writeComment(const QString& comment) noexcept {
+  if (!comment.isEmpty()) {
+    foreach (QString line, comment.split("\n", QString::KeepEmptyParts)) {
+      line = "# " % line;
+      while ((!line.isEmpty()) && line.at(line.count() - 1).isSpace()) {
+        line.chop(1);
+      }
+      mData += line.toUtf8();
+      mData += '\n';
+    }
+    mData += '\n';  // separate comment and CSV data with an empty line
+  }
+}
+
+void CsvWriter::writeHeader(const QStringList& header) noexcept {
+  mColumnCount = header.count();
+  writeLine(header);
+}
+
+void CsvWriter::writeRow(const QStringList& values) noexcept {
+  writeLine(values);
+}
+
+void CsvWriter::saveToFile(const FilePath& csvFp) const {
+  FileUtils::writeFile(csvFp, mData);  // can throw
+}
+
+QString CsvWriter::escapeValue(const QString& value) noexcept {
+  QString escaped = value;
+  escaped.remove("\r");  // remove DOS line endings, if any
+  escaped.replace("\n", " ");  // replace linebreaks by spaces
+  if (escaped.contains(",") || escaped.contains("\"")) {
+    escaped.replace("\"", "\"\"");  // escape quotes
+    escaped = "\"" + escaped + "\"";  // add quotes around value
+  }
+  return escaped;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CsvWriter::writeLine(const QStringList& line) noexcept {
+  for (int i = 0; i < mColumnCount; ++i) {
+    mData += escapeValue(line.value(i)).toUtf8();
+    mData += (i < mColumnCount - 1) ? ',' : '\n';
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
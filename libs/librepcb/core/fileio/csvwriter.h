@@ -0,0 +1,131 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_CSVWRITER_H
+#define LIBREPCB_CORE_CSVWRITER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+/*******************************************************************************
+ *  Class CsvWriter
+ ******************************************************************************/
+
+/**
+ * @brief Streaming writer for comma-separated values (CSV) files
+ *
+ * In contrast to ::librepcb::CsvFile, this class does not keep the rows in
+ * memory. Every row is escaped and appended as UTF-8 to an output buffer
+ * immediately, which avoids the overhead of storing all values as strings
+ * and serializing them at the end. This is intended for large exports like
+ * pick&place files of panels. The written content is exactly the same as
+ * generated by ::librepcb::CsvFile::toString().
+ *
+ * The comment (if any) needs to be written first, followed by the header
+ * and then the value rows. The header determines the value count of all
+ * rows: If a row contains more values, they are ignored. If a row contains
+ * less values, empty strings are written instead.
+ *
+ * @see ::librepcb::CsvFile
+ */
+class CsvWriter final {
+public:
+  // Constructors / Destructor
+  CsvWriter() noexcept;
+  CsvWriter(const CsvWriter& other) = delete;
+  ~CsvWriter() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Get the written CSV file content
+   *
+   * @return The UTF-8 encoded content written so far.
+   */
+  const QByteArray& getData() const noexcept { return mData; }
+
+  // General Methods
+
+  /**
+   * @brief Write the file comment
+   *
+   * @param comment   The comment to write. May contain linebreaks. If empty,
+   *                  nothing is written.
+   */
+  void writeComment(const QString& comment) noexcept;
+
+  /**
+   * @brief Write the header items
+   *
+   * @param header  The header items.
+   */
+  void writeHeader(const QStringList& header) noexcept;
+
+  /**
+   * @brief Write a row of values
+   *
+   * @param values  The value row items.
+   */
+  void writeRow(const QStringList& values) noexcept;
+
+  /**
+   * @brief Write the CSV file content to a file
+   *
+   * @param csvFp   The destination file path.
+   *
+   * @throw ::librepcb::Exception if the file could not be written.
+   */
+  void saveToFile(const FilePath& csvFp) const;
+
+  /**
+   * @brief Escape a single CSV value
+   *
+   * @param value   The raw value.
+   *
+   * @return The value with linebreaks replaced and quotes added, if needed.
+   */
+  static QString escapeValue(const QString& value) noexcept;
+
+  // Operator Overloadings
+  CsvWriter& operator=(const CsvWriter& rhs) = delete;
+
+private:  // Methods
+  void writeLine(const QStringList& line) noexcept;
+
+private:  // Data
+  int mColumnCount;
+  QByteArray mData;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
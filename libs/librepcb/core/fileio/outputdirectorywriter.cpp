@@ -41,9 +41,12 @@ OutputDirectoryWriter::OutputDirectoryWriter(const FilePath& dirPath) noexcept
   : QObject(),
     mDirPath(dirPath),
     mIndexFilePath(dirPath.getPathTo(".librepcb-output")),
+    mInputHashesFilePath(dirPath.getPathTo(".librepcb-output-hashes")),
     mIndex(),
+    mInputHashes(),
     mIndexLoaded(false),
-    mIndexModified(false) {
+    mIndexModified(false),
+    mSkipUnchangedFiles(false) {
 }
 
 OutputDirectoryWriter::~OutputDirectoryWriter() noexcept {
@@ -57,6 +60,45 @@ OutputDirectoryWriter::~OutputDirectoryWriter() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QList<FilePath> OutputDirectoryWriter::getWrittenFiles(const Uuid& job) const
+    noexcept {
+  QMutexLocker lock(&mMutex);
+  return mWrittenFiles.values(job);
+}
+
+QList<FilePath> OutputDirectoryWriter::getIndexedFiles(const Uuid& job) const
+    noexcept {
+  QMutexLocker lock(&mMutex);
+  return mIndex.keys(job);
+}
+
+QByteArray OutputDirectoryWriter::getInputHash(const Uuid& job) const
+    noexcept {
+  QMutexLocker lock(&mMutex);
+  return mInputHashes.value(job);
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void OutputDirectoryWriter::setInputHash(const Uuid& job,
+                                         const QByteArray& hash) noexcept {
+  QMutexLocker lock(&mMutex);
+  if (mInputHashes.value(job) != hash) {
+    if (hash.isEmpty()) {
+      mInputHashes.remove(job);
+    } else {
+      mInputHashes.insert(job, hash);
+    }
+    mIndexModified = true;
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -77,6 +119,20 @@ bool OutputDirectoryWriter::loadIndex() {
         }
       }
     }
+    mInputHashes.clear();
+    if (mInputHashesFilePath.isExistingFile()) {
+      const QString content =
+          FileUtils::readFile(mInputHashesFilePath);  // can throw
+      const QStringList lines = content.split("\n", QString::SkipEmptyParts);
+      foreach (const QString& line, lines) {
+        const QStringList values = line.split(" | ", QString::KeepEmptyParts);
+        if (values.count() >= 2) {
+          const Uuid uuid = Uuid::fromString(values.first());
+          mInputHashes.insert(uuid,
+                              QByteArray::fromHex(values.value(1).toUtf8()));
+        }
+      }
+    }
     success = true;
   } catch (const Exception& e) {
     qCritical() << e.getMsg();
@@ -98,6 +154,23 @@ void OutputDirectoryWriter::storeIndex() {
   std::sort(lines.begin(), lines.end());
   const QString content = lines.join("\n") % "\n";
   FileUtils::writeFile(mIndexFilePath, content.toUtf8());  // can throw
+
+  // Only create the input hashes file if there are any, i.e. if the output
+  // cache is used at all.
+  QStringList hashLines;
+  for (auto it = mInputHashes.begin(); it != mInputHashes.end(); ++it) {
+    hashLines.append(QString("%1 | %2")
+                         .arg(it.key().toStr())
+                         .arg(QString(it.value().toHex())));
+  }
+  std::sort(hashLines.begin(), hashLines.end());
+  if (!hashLines.isEmpty()) {
+    const QString hashContent = hashLines.join("\n") % "\n";
+    FileUtils::writeFile(mInputHashesFilePath,
+                         hashContent.toUtf8());  // can throw
+  } else if (mInputHashesFilePath.isExistingFile()) {
+    FileUtils::removeFile(mInputHashesFilePath);  // can throw
+  }
   mIndexModified = false;
 }
 
@@ -115,6 +188,7 @@ FilePath OutputDirectoryWriter::beginWritingFile(const Uuid& job,
         __FILE__, __LINE__,
         "Sorry, the character '|' cannot be used in output filenames.");
   }
+  QMutexLocker lock(&mMutex);
   if (mWrittenFiles.values().contains(fp)) {
     throw RuntimeError(
         __FILE__, __LINE__,
@@ -133,18 +207,44 @@ FilePath OutputDirectoryWriter::beginWritingFile(const Uuid& job,
   return fp;
 }
 
+void OutputDirectoryWriter::writeFile(const FilePath& fp,
+                                      const QByteArray& content) {
+  if (mSkipUnchangedFiles && fp.isExistingFile()) {
+    try {
+      if (isEquivalentContent(FileUtils::readFile(fp), content)) {
+        QMutexLocker lock(&mMutex);
+        mUnchangedFiles.insert(fp);
+        return;
+      }
+    } catch (const Exception& e) {
+      // Not critical, the file will just be overwritten.
+      qWarning() << "Failed to compare output file:" << e.getMsg();
+    }
+  }
+  FileUtils::writeFile(fp, content);  // can throw
+  QMutexLocker lock(&mMutex);
+  mUnchangedFiles.remove(fp);
+}
+
 void OutputDirectoryWriter::removeObsoleteFiles(const Uuid& job) {
-  const auto tmpIndex = mIndex;  // Avoid removing while iterating.
-  for (auto it = tmpIndex.begin(); it != tmpIndex.end(); ++it) {
-    if ((it.value() == job) &&
-        (!mWrittenFiles.values(job).contains(it.key()))) {
-      emit aboutToRemoveFile(it.key());
-      if (it.key().isExistingFile()) {
-        FileUtils::removeFile(it.key());  // can throw
+  QList<FilePath> obsoleteFiles;
+  {
+    QMutexLocker lock(&mMutex);
+    const QList<FilePath> writtenFiles = mWrittenFiles.values(job);
+    for (auto it = mIndex.begin(); it != mIndex.end(); ++it) {
+      if ((it.value() == job) && (!writtenFiles.contains(it.key()))) {
+        obsoleteFiles.append(it.key());
       }
-      mIndex.remove(it.key());
     }
   }
+  foreach (const FilePath& fp, obsoleteFiles) {
+    emit aboutToRemoveFile(fp);
+    if (fp.isExistingFile()) {
+      FileUtils::removeFile(fp);  // can throw
+    }
+    QMutexLocker lock(&mMutex);
+    mIndex.remove(fp);
+  }
 }
 
 QList<FilePath> OutputDirectoryWriter::findUnknownFiles(
@@ -157,6 +257,7 @@ QList<FilePath> OutputDirectoryWriter::findUnknownFiles(
     // Note: Ignore hidden files such as .DS_Store or Thumbs.db.
     result = FileUtils::getFilesInDirectory(mDirPath, {}, true, true);
     result.removeOne(mIndexFilePath);
+    result.removeOne(mInputHashesFilePath);
     for (auto it = mIndex.begin(); it != mIndex.end(); ++it) {
       if (knownJobs.contains(it.value())) {
         result.removeOne(it.key());
@@ -177,6 +278,37 @@ void OutputDirectoryWriter::removeUnknownFiles(const QList<FilePath>& files) {
   }
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+bool OutputDirectoryWriter::isEquivalentContent(const QByteArray& a,
+                                                const QByteArray& b) noexcept {
+  if (a == b) {
+    return true;
+  }
+
+  // Compare line by line, but skip lines which differ on every export even
+  // if nothing has been modified.
+  auto isVolatile = [](const QByteArray& line) {
+    return line.contains("TF.CreationDate,") || line.contains("TF.MD5,") ||
+        line.contains("Generation Date:");
+  };
+  const QList<QByteArray> linesA = a.split('\n');
+  const QList<QByteArray> linesB = b.split('\n');
+  if (linesA.count() != linesB.count()) {
+    return false;
+  }
+  for (int i = 0; i < linesA.count(); ++i) {
+    const QByteArray& lineA = linesA.at(i);
+    const QByteArray& lineB = linesB.at(i);
+    if ((lineA != lineB) && ((!isVolatile(lineA)) || (!isVolatile(lineB)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -40,6 +40,15 @@ class Uuid;
 
 /**
  * @brief The OutputDirectoryWriter class
+ *
+ * Besides the index of written files, the writer also keeps a hash of the
+ * inputs of each job (see #setInputHash()), which allows to reuse output
+ * files of jobs whose inputs did not change.
+ *
+ * @note  #beginWritingFile(), #writeFile(), #removeObsoleteFiles(), the
+ *        getters taking a job UUID and #setInputHash() are thread-safe to
+ *        allow running multiple output jobs concurrently. All other methods
+ *        must not be called while jobs are running.
  */
 class OutputDirectoryWriter final : public QObject {
   Q_OBJECT
@@ -56,11 +65,47 @@ public:
   const QMultiHash<Uuid, FilePath>& getWrittenFiles() const noexcept {
     return mWrittenFiles;
   }
+  QList<FilePath> getWrittenFiles(const Uuid& job) const noexcept;
+  QList<FilePath> getIndexedFiles(const Uuid& job) const noexcept;
+  QByteArray getInputHash(const Uuid& job) const noexcept;
+  const QSet<FilePath>& getUnchangedFiles() const noexcept {
+    return mUnchangedFiles;
+  }
+
+  // Setters
+
+  /**
+   * @brief Set or clear the hash of the inputs a job was run with
+   *
+   * Stored together with the index, thus it must only be set for jobs whose
+   * output files are written completely.
+   *
+   * @param job   UUID of the job.
+   * @param hash  Hash of the job inputs, or an empty array to remove it.
+   */
+  void setInputHash(const Uuid& job, const QByteArray& hash) noexcept;
+
+  /**
+   * @brief Enable or disable skipping writes of unchanged files
+   *
+   * Disabled by default. If enabled, #writeFile() compares the new content
+   * with the existing file and keeps the file untouched (including its
+   * modification time) if the content is the same. Volatile metadata like
+   * creation dates is ignored for the comparison (see
+   * #isEquivalentContent()). Skipped files are reported by
+   * #getUnchangedFiles().
+   *
+   * @param skip    Whether unchanged files shall not be written again.
+   */
+  void setSkipUnchangedFiles(bool skip) noexcept {
+    mSkipUnchangedFiles = skip;
+  }
 
   // General Methods
   bool loadIndex();
   void storeIndex();
   FilePath beginWritingFile(const Uuid& job, const QString& relPath);
+  void writeFile(const FilePath& fp, const QByteArray& content);
   void removeObsoleteFiles(const Uuid& job);
   QList<FilePath> findUnknownFiles(const QSet<Uuid>& knownJobs) const;
   void removeUnknownFiles(const QList<FilePath>& files);
@@ -68,6 +113,23 @@ public:
   // Operator Overloadings
   OutputDirectoryWriter& operator=(const OutputDirectoryWriter& rhs) = delete;
 
+  // Static Methods
+
+  /**
+   * @brief Check if two output file contents are equivalent
+   *
+   * Lines containing volatile metadata (creation dates and the Gerber MD5
+   * checksum which depends on them) are ignored, all other content must be
+   * exactly the same.
+   *
+   * @param a   Content of the first file.
+   * @param b   Content of the second file.
+   *
+   * @return Whether the contents are equivalent.
+   */
+  static bool isEquivalentContent(const QByteArray& a,
+                                  const QByteArray& b) noexcept;
+
 signals:
   void aboutToWriteFile(const FilePath& fp);
   void aboutToRemoveFile(const FilePath& fp);
@@ -75,10 +137,15 @@ signals:
 private:  // Data
   const FilePath mDirPath;
   const FilePath mIndexFilePath;
+  const FilePath mInputHashesFilePath;
   QMap<FilePath, Uuid> mIndex;
+  QHash<Uuid, QByteArray> mInputHashes;
   bool mIndexLoaded;
   bool mIndexModified;
   QMultiHash<Uuid, FilePath> mWrittenFiles;
+  bool mSkipUnchangedFiles;
+  QSet<FilePath> mUnchangedFiles;  ///< Written files with unchanged content
+  mutable QMutex mMutex;  ///< Protects all the containers above
 };
 
 /*******************************************************************************
@@ -25,6 +25,7 @@
 #include "../serialization/sexpression.h"
 #include "../utils/toolbox.h"
 #include "fileutils.h"
+#include "zipwriter.h"
 
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
@@ -35,6 +36,10 @@
  ******************************************************************************/
 namespace librepcb {
 
+/// Size of modified files which are stored in temporary files instead of
+/// being kept in memory
+static const int sSpillThreshold = 1024 * 1024;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -47,7 +52,8 @@ TransactionalFileSystem::TransactionalFileSystem(
     mIsWritable(writable),
     mLock(filepath),
     mRestoredFromAutosave(false),
-    mMutex(QMutex::Recursive) {
+    mStateLock(QReadWriteLock::Recursive),
+    mSpillCounter(0) {
   // Load the backup if there is one (i.e. last save operation has failed).
   FilePath backupFile = mFilePath.getPathTo(".backup/backup.lp");
   if (backupFile.isExistingFile()) {
@@ -86,6 +92,8 @@ TransactionalFileSystem::~TransactionalFileSystem() noexcept {
       qWarning() << "Failed to remove autosave directory:" << e.getMsg();
     }
   }
+
+  clearModifiedFiles();
 }
 
 /*******************************************************************************
@@ -102,7 +110,7 @@ QStringList TransactionalFileSystem::getDirs(
   QSet<QString> dirnames;
   QString dirpath = cleanPath(path);
   if (!dirpath.isEmpty()) dirpath.append("/");
-  QMutexLocker lock(&mMutex);
+  QReadLocker lock(&mStateLock);
 
   // add directories from file system, if not removed
   QDir dir(mFilePath.getPathTo(path).toStr());
@@ -131,7 +139,7 @@ QStringList TransactionalFileSystem::getFiles(
   QSet<QString> filenames;
   QString dirpath = cleanPath(path);
   if (!dirpath.isEmpty()) dirpath.append("/");
-  QMutexLocker lock(&mMutex);
+  QReadLocker lock(&mStateLock);
 
   // add files from file system, if not removed
   QDir dir(mFilePath.getPathTo(path).toStr());
@@ -156,7 +164,7 @@ QStringList TransactionalFileSystem::getFiles(
 
 bool TransactionalFileSystem::fileExists(const QString& path) const noexcept {
   const QString cleanedPath = cleanPath(path);
-  QMutexLocker lock(&mMutex);
+  QReadLocker lock(&mStateLock);
   if (mModifiedFiles.contains(cleanedPath)) {
     return true;
   } else if (isRemoved(cleanedPath)) {
@@ -179,13 +187,15 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
 
 QByteArray TransactionalFileSystem::readIfExists(const QString& path) const {
   const QString cleanedPath = cleanPath(path);
-  QMutexLocker lock(&mMutex);
+  QReadLocker lock(&mStateLock);
   if (mModifiedFiles.contains(cleanedPath)) {
-    return mModifiedFiles.value(cleanedPath);
+    return getModifiedFile(cleanedPath);  // can throw
   } else if (!isRemoved(cleanedPath)) {
     const FilePath fp = mFilePath.getPathTo(cleanedPath);
     if (fp.isExistingFile()) {
-      return FileUtils::readFile(fp);  // can throw
+      const QByteArray content = FileUtils::readFile(fp);  // can throw
+      recordDiskFile(cleanedPath, content);
+      return content;
     }
   }
   return QByteArray();
@@ -194,8 +204,15 @@ QByteArray TransactionalFileSystem::readIfExists(const QString& path) const {
 void TransactionalFileSystem::write(const QString& path,
                                     const QByteArray& content) {
   const QString cleanedPath = cleanPath(path);
-  QMutexLocker lock(&mMutex);
-  mModifiedFiles[cleanedPath] = content;
+  QWriteLocker lock(&mStateLock);
+  if ((!mSpilledFiles.contains(cleanedPath)) &&
+      (!mZipFiles.contains(cleanedPath)) &&
+      (mModifiedFiles.contains(cleanedPath)) &&
+      (mModifiedFiles.value(cleanedPath) == content)) {
+    // Content not modified, keep the file in the last autosave valid.
+    return;
+  }
+  setModifiedFile(cleanedPath, content);
   mRemovedFiles.remove(cleanedPath);
 }
 
@@ -207,18 +224,18 @@ void TransactionalFileSystem::renameFile(const QString& src,
 
 void TransactionalFileSystem::removeFile(const QString& path) {
   const QString cleanedPath = cleanPath(path);
-  QMutexLocker lock(&mMutex);
-  mModifiedFiles.remove(cleanedPath);
+  QWriteLocker lock(&mStateLock);
+  removeModifiedFile(cleanedPath);
   mRemovedFiles.insert(cleanedPath);
 }
 
 void TransactionalFileSystem::removeDirRecursively(const QString& path) {
   QString dirpath = cleanPath(path);
   if (!dirpath.isEmpty()) dirpath.append("/");
-  QMutexLocker lock(&mMutex);
+  QWriteLocker lock(&mStateLock);
   foreach (const QString& fp, mModifiedFiles.keys()) {
     if (dirpath.isEmpty() || fp.startsWith(dirpath)) {
-      mModifiedFiles.remove(fp);
+      removeModifiedFile(fp);
     }
   }
   foreach (const QString& fp, mRemovedFiles) {
@@ -240,7 +257,7 @@ void TransactionalFileSystem::loadFromZip(QByteArray content) {
     throw RuntimeError(__FILE__, __LINE__, tr("Failed to open ZIP file '%1'."));
   }
   QuaZipFile file(&zip);
-  QMutexLocker lock(&mMutex);
+  QWriteLocker lock(&mStateLock);
   for (bool f = zip.goToFirstFile(); f; f = zip.goToNextFile()) {
     const QString fileName = file.getActualFileName();
     if ((!fileName.endsWith("/")) && (!fileName.endsWith("\\"))) {
@@ -253,76 +270,56 @@ void TransactionalFileSystem::loadFromZip(QByteArray content) {
 }
 
 void TransactionalFileSystem::loadFromZip(const FilePath& fp) {
-  QuaZip zip(fp.toStr());
-  if (!zip.open(QuaZip::mdUnzip)) {
+  // Only read the index of the ZIP file, its entries are extracted on demand.
+  // The ZIP file is kept open as long as any of its entries is needed.
+  std::shared_ptr<QuaZip> zip = std::make_shared<QuaZip>(fp.toStr());
+  if (!zip->open(QuaZip::mdUnzip)) {
     throw RuntimeError(
         __FILE__, __LINE__,
         tr("Failed to open the ZIP file '%1'.").arg(fp.toNative()));
   }
-  QuaZipFile file(&zip);
-  QMutexLocker lock(&mMutex);
-  for (bool f = zip.goToFirstFile(); f; f = zip.goToNextFile()) {
-    const QString fileName = file.getActualFileName();
+  QWriteLocker lock(&mStateLock);
+  for (bool f = zip->goToFirstFile(); f; f = zip->goToNextFile()) {
+    const QString fileName = zip->getCurrentFileName();
     if ((!fileName.endsWith("/")) && (!fileName.endsWith("\\"))) {
-      file.open(QIODevice::ReadOnly);
-      write(fileName, file.readAll());
-      file.close();
+      const QString cleanedPath = cleanPath(fileName);
+      removeModifiedFile(cleanedPath);
+      mModifiedFiles.insert(cleanedPath, QByteArray());
+      mZipFiles.insert(cleanedPath, std::make_pair(zip, fileName));
+      mRemovedFiles.remove(cleanedPath);
     }
   }
-  zip.close();
 }
 
 QByteArray TransactionalFileSystem::exportToZip(FilterFunction filter) const {
-  FilePath fp = FilePath::getRandomTempPath();
   QBuffer buffer;
-  QuaZip zip(&buffer);
-  if (!zip.open(QuaZip::mdCreate)) {
-    throw RuntimeError(__FILE__, __LINE__, tr("Failed to create ZIP file."));
-  }
-  try {
-    QuaZipFile file(&zip);
-    QMutexLocker lock(&mMutex);
-    exportDirToZip(file, fp, "", filter);
-    zip.close();
-  } catch (const Exception& e) {
-    // Remove ZIP file because it is not complete
-    QFile(fp.toStr()).remove();
-    zip.close();
-    throw;
+  {
+    ZipWriter zip(buffer);  // can throw
+    QReadLocker lock(&mStateLock);
+    exportDirToZip(zip, FilePath(), "", filter);  // can throw
+    zip.finish();  // can throw
   }
   return buffer.buffer();
 }
 
 void TransactionalFileSystem::exportToZip(const FilePath& fp,
                                           FilterFunction filter) const {
-  QuaZip zip(fp.toStr());
-  if (!zip.open(QuaZip::mdCreate)) {
-    throw RuntimeError(
-        __FILE__, __LINE__,
-        tr("Failed to create the ZIP file '%1'.").arg(fp.toNative()));
-  }
-  try {
-    QuaZipFile file(&zip);
-    QMutexLocker lock(&mMutex);
-    exportDirToZip(file, fp, "", filter);
-    zip.close();
-  } catch (const Exception& e) {
-    // Remove ZIP file because it is not complete
-    QFile(fp.toStr()).remove();
-    zip.close();
-    throw;
-  }
+  // Note: The ZIP file is removed by the writer if it is not complete.
+  ZipWriter zip(fp);  // can throw
+  QReadLocker lock(&mStateLock);
+  exportDirToZip(zip, fp, "", filter);  // can throw
+  zip.finish();  // can throw
 }
 
 void TransactionalFileSystem::discardChanges() noexcept {
-  QMutexLocker lock(&mMutex);
-  mModifiedFiles.clear();
+  QWriteLocker lock(&mStateLock);
+  clearModifiedFiles();
   mRemovedFiles.clear();
   mRemovedDirs.clear();
 }
 
 QStringList TransactionalFileSystem::checkForModifications() const {
-  QMutexLocker lock(&mMutex);
+  QReadLocker lock(&mStateLock);
   QStringList modifications;
 
   // removed directories
@@ -343,10 +340,7 @@ QStringList TransactionalFileSystem::checkForModifications() const {
 
   // new or modified files
   foreach (const QString& filepath, mModifiedFiles.keys()) {
-    FilePath fp = mFilePath.getPathTo(filepath);
-    QByteArray content = mModifiedFiles.value(filepath);
-    if ((!fp.isExistingFile()) ||
-        (FileUtils::readFile(fp) != content)) {  // can throw
+    if (!isDiskFileEqual(filepath, getModifiedFile(filepath))) {  // can throw
       modifications.append(filepath);
     }
   }
@@ -355,12 +349,12 @@ QStringList TransactionalFileSystem::checkForModifications() const {
 }
 
 void TransactionalFileSystem::autosave() {
-  QMutexLocker lock(&mMutex);
+  QWriteLocker lock(&mStateLock);
   saveDiff("autosave");  // can throw
 }
 
 void TransactionalFileSystem::save() {
-  QMutexLocker lock(&mMutex);
+  QWriteLocker lock(&mStateLock);
 
   // save to backup directory
   saveDiff("backup");  // can throw
@@ -391,8 +385,9 @@ void TransactionalFileSystem::save() {
 
   // save new or modified files
   foreach (const QString& filepath, mModifiedFiles.keys()) {
-    FileUtils::writeFile(mFilePath.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+    const QByteArray content = getModifiedFile(filepath);  // can throw
+    FileUtils::writeFile(mFilePath.getPathTo(filepath), content);  // can throw
+    recordDiskFile(filepath, content);
   }
 
   // remove backup
@@ -437,7 +432,119 @@ bool TransactionalFileSystem::isRemoved(const QString& path) const noexcept {
   return false;
 }
 
-void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
+void TransactionalFileSystem::recordDiskFile(
+    const QString& path, const QByteArray& content) const noexcept {
+  const QFileInfo info(mFilePath.getPathTo(path).toStr());
+  QMutexLocker lock(&mDiskFilesMutex);
+  mDiskFiles.insert(
+      path,
+      DiskFileInfo{info.size(), info.lastModified(),
+                   QDateTime::currentDateTimeUtc(),
+                   QCryptographicHash::hash(content, QCryptographicHash::Md5)});
+}
+
+bool TransactionalFileSystem::isDiskFileEqual(
+    const QString& path, const QByteArray& content) const {
+  const FilePath fp = mFilePath.getPathTo(path);
+  const QFileInfo info(fp.toStr());
+  if ((!info.isFile()) || (info.size() != content.size())) {
+    return false;  // No need to read the file.
+  }
+
+  // If the file on disk is still the one from the manifest, compare hashes.
+  // Files modified less than a second before they were recorded are not
+  // trusted since a subsequent modification might not change the timestamp.
+  QMutexLocker lock(&mDiskFilesMutex);
+  const auto it = mDiskFiles.constFind(path);
+  if ((it != mDiskFiles.constEnd()) && (it->size == info.size()) &&
+      (it->lastModified == info.lastModified()) &&
+      (it->lastModified.msecsTo(it->recorded) > 1000)) {
+    return it->hash ==
+        QCryptographicHash::hash(content, QCryptographicHash::Md5);
+  }
+  lock.unlock();
+
+  // Otherwise fall back to comparing the content.
+  const QByteArray diskContent = FileUtils::readFile(fp);  // can throw
+  recordDiskFile(path, diskContent);
+  return diskContent == content;
+}
+
+QByteArray TransactionalFileSystem::getModifiedFile(
+    const QString& path) const {
+  const auto it = mSpilledFiles.constFind(path);
+  if (it != mSpilledFiles.constEnd()) {
+    return FileUtils::readFile(*it);  // can throw
+  }
+  const auto zipIt = mZipFiles.constFind(path);
+  if (zipIt != mZipFiles.constEnd()) {
+    // The ZIP file has a "current file" state, so only one thread may
+    // extract files at a time.
+    QMutexLocker lock(&mZipMutex);
+    QuaZip& zip = *zipIt->first;
+    QuaZipFile file(&zip);
+    if ((!zip.setCurrentFile(zipIt->second)) ||
+        (!file.open(QIODevice::ReadOnly))) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("Failed to read file '%1' from '%2'.")
+                             .arg(zipIt->second, zip.getZipName()));
+    }
+    const QByteArray content = file.readAll();
+    file.close();
+    if (file.getZipError() != UNZ_OK) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("Failed to read file '%1' from '%2'.")
+                             .arg(zipIt->second, zip.getZipName()));
+    }
+    return content;
+  }
+  return mModifiedFiles.value(path);
+}
+
+void TransactionalFileSystem::setModifiedFile(const QString& path,
+                                              const QByteArray& content) {
+  removeModifiedFile(path);
+  if (content.size() >= sSpillThreshold) {
+    // Keep large files out of memory until they get saved. If spilling fails
+    // for any reason, just keep them in memory.
+    try {
+      if (!mSpillDir.isValid()) {
+        mSpillDir = FilePath::getRandomTempPath();
+      }
+      const FilePath fp = mSpillDir.getPathTo(QString::number(mSpillCounter++));
+      FileUtils::writeFile(fp, content);  // can throw
+      mModifiedFiles.insert(path, QByteArray());
+      mSpilledFiles.insert(path, fp);
+      return;
+    } catch (const Exception& e) {
+      qWarning() << "Failed to spill modified file to disk:" << e.getMsg();
+    }
+  }
+  mModifiedFiles.insert(path, content);
+}
+
+void TransactionalFileSystem::removeModifiedFile(const QString& path) noexcept {
+  mModifiedFiles.remove(path);
+  mZipFiles.remove(path);
+  mAutosavedFiles.remove(path);
+  const FilePath fp = mSpilledFiles.take(path);
+  if (fp.isValid()) {
+    QFile(fp.toStr()).remove();
+  }
+}
+
+void TransactionalFileSystem::clearModifiedFiles() noexcept {
+  mModifiedFiles.clear();
+  mZipFiles.clear();
+  mAutosavedFiles.clear();
+  mSpilledFiles.clear();
+  if (mSpillDir.isValid()) {
+    QDir(mSpillDir.toStr()).removeRecursively();
+    mSpillDir = FilePath();
+  }
+}
+
+void TransactionalFileSystem::exportDirToZip(ZipWriter& zip,
                                              const FilePath& zipFp,
                                              const QString& dir,
                                              FilterFunction filter) const {
@@ -447,13 +554,13 @@ void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
   foreach (const QString& dirname, getDirs(dir)) {
     // skip dotdirs, e.g. ".git", ".svn", ".autosave", ".backup"
     if (dirname.startsWith('.')) continue;
-    exportDirToZip(file, zipFp, path % dirname, filter);
+    exportDirToZip(zip, zipFp, path % dirname, filter);
   }
 
   // export files
   foreach (const QString& filename, getFiles(dir)) {
     QString filepath = path % filename;
-    if (filepath == zipFp.toRelative(mFilePath)) {
+    if (zipFp.isValid() && (filepath == zipFp.toRelative(mFilePath))) {
       // In case the exported ZIP file is located inside this file system,
       // we have to skip it. Otherwise we would get a ZIP inside the ZIP file.
       continue;
@@ -462,29 +569,22 @@ void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
     if (filename == ".lock") continue;
     // apply custom filter
     if (filter && (!filter(filepath))) continue;
-    // read file content and add it to the ZIP archive
-    const QByteArray& content = read(filepath);  // can throw
-    QuaZipNewInfo newFileInfo(filepath);
-    newFileInfo.setPermissions(QFileDevice::ReadOwner | QFileDevice::ReadGroup |
-                               QFileDevice::ReadOther |
-                               QFileDevice::WriteOwner);
-    if (!file.open(QIODevice::WriteOnly, newFileInfo)) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    qint64 bytesWritten = file.write(content);
-    file.close();
-    if (bytesWritten != content.length()) {
-      throw RuntimeError(__FILE__, __LINE__,
-                         tr("Failed to write file '%1' to '%2'.")
-                             .arg(filepath, zipFp.toNative()));
-    }
+    // read file content and add it to the ZIP archive (compressed in
+    // background threads)
+    zip.addFile(filepath, read(filepath));  // can throw
   }
 }
 
-void TransactionalFileSystem::saveDiff(const QString& type) const {
+void TransactionalFileSystem::saveDiff(const QString& type) {
   QDateTime dt = QDateTime::currentDateTime();
   FilePath dir = mFilePath.getPathTo("." % type);
-  FilePath filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
+  const QString filesDirName = dt.toString("yyyy-MM-dd_hh-mm-ss-zzz");
+  FilePath filesDir = dir.getPathTo(filesDirName);
+
+  // The autosave is written incrementally: Files not modified since the last
+  // autosave are not written again, but referenced from the subdirectory they
+  // were written to by a previous autosave.
+  const bool incremental = (type == "autosave");
 
   if (!mIsWritable) {
     throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
@@ -494,12 +594,25 @@ void TransactionalFileSystem::saveDiff(const QString& type) const {
   root.ensureLineBreak();
   root.appendChild("created", dt);
   root.ensureLineBreak();
-  root.appendChild("modified_files_directory", filesDir.getFilename());
+  root.appendChild("modified_files_directory", filesDirName);
+  QHash<QString, QString> fileDirs;
   foreach (const QString& filepath, Toolbox::sorted(mModifiedFiles.keys())) {
+    QString fileDir = incremental ? mAutosavedFiles.value(filepath) : QString();
+    if (fileDir.isEmpty() ||
+        (!dir.getPathTo(fileDir).getPathTo(filepath).isExistingFile())) {
+      fileDir = filesDirName;
+      FileUtils::writeFile(filesDir.getPathTo(filepath),
+                           getModifiedFile(filepath));  // can throw
+    }
+    fileDirs.insert(filepath, fileDir);
     root.ensureLineBreak();
-    root.appendChild("modified_file", filepath);
-    FileUtils::writeFile(filesDir.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+    if (fileDir == filesDirName) {
+      root.appendChild("modified_file", filepath);
+    } else {
+      SExpression& node = root.appendList("modified_file");
+      node.appendChild(filepath);
+      node.appendChild(fileDir);
+    }
   }
   foreach (const QString& filepath, Toolbox::sorted(mRemovedFiles.values())) {
     root.ensureLineBreak();
@@ -515,6 +628,26 @@ void TransactionalFileSystem::saveDiff(const QString& type) const {
   // complete!
   FileUtils::writeFile(dir.getPathTo(type % ".lp"),
                        root.toByteArray());  // can throw
+
+  if (incremental) {
+    mAutosavedFiles = fileDirs;
+    removeUnreferencedDiffDirs(dir, Toolbox::toSet(fileDirs.values()));
+  }
+}
+
+void TransactionalFileSystem::removeUnreferencedDiffDirs(
+    const FilePath& dir, const QSet<QString>& referenced) noexcept {
+  const QStringList dirNames =
+      QDir(dir.toStr()).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+  foreach (const QString& dirName, dirNames) {
+    if (!referenced.contains(dirName)) {
+      try {
+        FileUtils::removeDirRecursively(dir.getPathTo(dirName));  // can throw
+      } catch (const Exception& e) {
+        qWarning() << "Failed to remove obsolete directory:" << e.getMsg();
+      }
+    }
+  }
 }
 
 void TransactionalFileSystem::loadDiff(const FilePath& fp) {
@@ -527,8 +660,13 @@ void TransactionalFileSystem::loadDiff(const FilePath& fp) {
   FilePath modifiedFilesDir = fp.getParentDir().getPathTo(modifiedFilesDirName);
   foreach (const SExpression* node, root.getChildren("modified_file")) {
     QString relPath = node->getChild("@0").getValue();
-    FilePath absPath = modifiedFilesDir.getPathTo(relPath);
-    mModifiedFiles.insert(relPath, FileUtils::readFile(absPath));  // can throw
+    // Incremental autosaves may reference files from another subdirectory.
+    const SExpression* dirNode = node->tryGetChild("@1");
+    const FilePath filesDir = dirNode
+        ? fp.getParentDir().getPathTo(dirNode->getValue())
+        : modifiedFilesDir;
+    FilePath absPath = filesDir.getPathTo(relPath);
+    setModifiedFile(relPath, FileUtils::readFile(absPath));  // can throw
   }
   foreach (const SExpression* node, root.getChildren("removed_file")) {
     QString relPath = node->getChild("@0").getValue();
@@ -551,6 +689,9 @@ void TransactionalFileSystem::removeDiff(const QString& type) {
 
   // then remove the whole directory
   FileUtils::removeDirRecursively(dir);  // can throw
+  if (type == "autosave") {
+    mAutosavedFiles.clear();
+  }
 }
 
 /*******************************************************************************
@@ -35,10 +35,12 @@
  *  Namespace / Forward Declarations
  ******************************************************************************/
 
-class QuaZipFile;
+class QuaZip;
 
 namespace librepcb {
 
+class ZipWriter;
+
 /*******************************************************************************
  *  Class TransactionalFileSystem
  ******************************************************************************/
@@ -58,7 +60,8 @@ namespace librepcb {
  *  - Supports periodic saving to allow restoring the last autosave backup after
  *    an application crash (see @ref doc_project_autosave).
  *  - Holds all file modifications in memory and allows to write those in an
- *    atomic way to the disk (see @ref doc_project_save).
+ *    atomic way to the disk (see @ref doc_project_save). Large modified files
+ *    are spilled to a temporary directory to keep the memory usage bounded.
  *  - Allows to export the whole file system to a ZIP file.
  *
  * In addition, all public methods of this class are thread-safe, i.e.
@@ -66,7 +69,8 @@ namespace librepcb {
  * However, be careful anyway as thread-safety does not mean you cannot
  * generate an inconsisntent content of the file system. Generally it's
  * recommended to make write operations only from one thread, and only
- * read operations from all other threads.
+ * read operations from all other threads. Read operations don't block each
+ * other, so files can be loaded in parallel.
  */
 class TransactionalFileSystem final : public FileSystem {
   Q_OBJECT
@@ -206,11 +210,29 @@ public:
   }
   static QString cleanPath(QString path) noexcept;
 
+private:  // Types
+  /// Manifest entry of a file on the disk
+  struct DiskFileInfo {
+    qint64 size;
+    QDateTime lastModified;
+    QDateTime recorded;  ///< When the entry was recorded
+    QByteArray hash;  ///< Hash of the content
+  };
+
 private:  // Methods
   bool isRemoved(const QString& path) const noexcept;
-  void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
+  void recordDiskFile(const QString& path,
+                      const QByteArray& content) const noexcept;
+  bool isDiskFileEqual(const QString& path, const QByteArray& content) const;
+  QByteArray getModifiedFile(const QString& path) const;
+  void setModifiedFile(const QString& path, const QByteArray& content);
+  void removeModifiedFile(const QString& path) noexcept;
+  void clearModifiedFiles() noexcept;
+  void exportDirToZip(ZipWriter& zip, const FilePath& zipFp,
                       const QString& dir, FilterFunction filter) const;
-  void saveDiff(const QString& type) const;
+  void saveDiff(const QString& type);
+  void removeUnreferencedDiffDirs(const FilePath& dir,
+                                  const QSet<QString>& referenced) noexcept;
   void loadDiff(const FilePath& fp);
   void removeDiff(const QString& type);
 
@@ -219,12 +241,35 @@ private:  // Data
   bool mIsWritable;
   DirectoryLock mLock;
   bool mRestoredFromAutosave;
-  mutable QMutex mMutex;
+
+  /// Protects the file system state. Read operations only need a shared lock,
+  /// so concurrent reads don't block each other.
+  ///
+  /// @note Write operations must not call methods taking a shared lock, as
+  ///       the lock doesn't allow to lock for reading while locked for writing.
+  mutable QReadWriteLock mStateLock;
+  mutable QMutex mDiskFilesMutex;  ///< Protects #mDiskFiles
+  mutable QMutex mZipMutex;  ///< Serializes extracting files from ZIP files
 
   // File system modifications
-  QHash<QString, QByteArray> mModifiedFiles;
+  QHash<QString, QByteArray> mModifiedFiles;  ///< Empty if stored elsewhere
+  QHash<QString, FilePath> mSpilledFiles;  ///< Temporary files of large ones
+
+  /// Files loaded from a ZIP file, but not extracted yet. Value is the opened
+  /// ZIP file and the name of the file within the ZIP.
+  QHash<QString, std::pair<std::shared_ptr<QuaZip>, QString>> mZipFiles;
+  FilePath mSpillDir;  ///< Lazily created temporary directory
+  int mSpillCounter;
+
+  /// Modified files contained in the last autosave, and the name of the
+  /// autosave subdirectory containing their current content
+  QHash<QString, QString> mAutosavedFiles;
   QSet<QString> mRemovedFiles;
   QSet<QString> mRemovedDirs;
+
+  /// Manifest of files read from or written to the disk, allowing to detect
+  /// modifications without reading the files again
+  mutable QHash<QString, DiskFileInfo> mDiskFiles;
 };
 
 /*******************************************************************************
@@ -0,0 +1,167 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "zipwriter.h"
+
+#include "../exceptions.h"
+#include "../utils/concurrency.h"
+#include "../utils/scopeguard.h"
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+#include <zlib.h>
+
+#include <QtConcurrent>
+#include <QtCore>
+
+#include <cstring>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ZipWriter::ZipWriter(const FilePath& fp)
+  : mFilePath(fp), mZip(new QuaZip(fp.toStr())), mFinished(false) {
+  Concurrency::apply(mThreadPool);
+  open();  // can throw
+}
+
+ZipWriter::ZipWriter(QIODevice& device)
+  : mFilePath(), mZip(new QuaZip(&device)), mFinished(false) {
+  Concurrency::apply(mThreadPool);
+  open();  // can throw
+}
+
+ZipWriter::~ZipWriter() noexcept {
+  mThreadPool.waitForDone();
+  if (!mFinished) {
+    mZip->close();
+    if (mFilePath.isValid()) {
+      // Remove ZIP file because it is not complete.
+      QFile(mFilePath.toStr()).remove();
+    }
+  }
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void ZipWriter::addFile(const QString& path, const QByteArray& content) {
+  Q_ASSERT(!mFinished);
+  mPendingFiles.enqueue(std::make_pair(
+      path, QtConcurrent::run(&mThreadPool, &ZipWriter::compress, content)));
+
+  // Limit the number of compressed files kept in memory.
+  while (mPendingFiles.count() > (mThreadPool.maxThreadCount() * 2)) {
+    writeNextFile();  // can throw
+  }
+}
+
+void ZipWriter::finish() {
+  while (!mPendingFiles.isEmpty()) {
+    writeNextFile();  // can throw
+  }
+  mZip->close();
+  if (mZip->getZipError() != ZIP_OK) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to write the ZIP file '%1'.")
+                           .arg(mFilePath.toNative()));
+  }
+  mFinished = true;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ZipWriter::open() {
+  if (!mZip->open(QuaZip::mdCreate)) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        tr("Failed to create the ZIP file '%1'.").arg(mFilePath.toNative()));
+  }
+}
+
+void ZipWriter::writeNextFile() {
+  const auto pending = mPendingFiles.dequeue();
+  const CompressedFile file = pending.second.result();  // can throw
+
+  // Write the already compressed data in raw mode.
+  QuaZipNewInfo newFileInfo(pending.first);
+  newFileInfo.setPermissions(QFileDevice::ReadOwner | QFileDevice::ReadGroup |
+                             QFileDevice::ReadOther | QFileDevice::WriteOwner);
+  newFileInfo.uncompressedSize = file.uncompressedSize;
+  QuaZipFile zipFile(mZip.get());
+  if (!zipFile.open(QIODevice::WriteOnly, newFileInfo, nullptr, file.crc,
+                    Z_DEFLATED, Z_DEFAULT_COMPRESSION, true)) {
+    throw RuntimeError(__FILE__, __LINE__);
+  }
+  qint64 bytesWritten = zipFile.write(file.data);
+  zipFile.close();
+  if ((bytesWritten != file.data.length()) ||
+      (zipFile.getZipError() != ZIP_OK)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to write file '%1' to '%2'.")
+                           .arg(pending.first, mFilePath.toNative()));
+  }
+}
+
+ZipWriter::CompressedFile ZipWriter::compress(const QByteArray& content) {
+  // Raw deflate stream (negative window bits) as stored in ZIP files.
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       "Failed to initialize the ZIP compression.");
+  }
+  auto streamGuard = scopeGuard([&stream]() { deflateEnd(&stream); });
+
+  const Bytef* input = reinterpret_cast<const Bytef*>(content.constData());
+  const uInt inputSize = static_cast<uInt>(content.size());
+  CompressedFile file;
+  file.data.resize(static_cast<int>(deflateBound(&stream, inputSize)));
+  stream.next_in = const_cast<Bytef*>(input);
+  stream.avail_in = inputSize;
+  stream.next_out = reinterpret_cast<Bytef*>(file.data.data());
+  stream.avail_out = static_cast<uInt>(file.data.size());
+  if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+    throw RuntimeError(__FILE__, __LINE__, "Failed to compress ZIP entry.");
+  }
+  file.data.resize(static_cast<int>(stream.total_out));
+  file.crc =
+      static_cast<quint32>(crc32(crc32(0L, Z_NULL, 0), input, inputSize));
+  file.uncompressedSize = content.size();
+  return file;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
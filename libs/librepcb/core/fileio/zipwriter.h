@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_ZIPWRITER_H
+#define LIBREPCB_CORE_ZIPWRITER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "filepath.h"
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+class QuaZip;
+
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class ZipWriter
+ ******************************************************************************/
+
+/**
+ * @brief Streaming ZIP archive writer with parallel compression
+ *
+ * Files added with #addFile() are compressed on a thread pool while the
+ * caller continues adding more files. The compressed entries are written to
+ * the destination in the order they were added, from the calling thread. To
+ * keep the memory usage bounded, #addFile() blocks if too many entries are
+ * pending.
+ *
+ * If #finish() was not called successfully (e.g. due to an exception), an
+ * incomplete ZIP file is removed in the destructor.
+ */
+class ZipWriter final {
+  Q_DECLARE_TR_FUNCTIONS(ZipWriter)
+
+public:
+  // Constructors / Destructor
+  ZipWriter() = delete;
+  ZipWriter(const ZipWriter& other) = delete;
+
+  /**
+   * @brief Constructor to write a ZIP file
+   *
+   * @param fp    The ZIP file to create (will be overwritten if existing).
+   *
+   * @throw Exception if the file could not be created.
+   */
+  explicit ZipWriter(const FilePath& fp);
+
+  /**
+   * @brief Constructor to write into an I/O device
+   *
+   * @param device  The device to write into. Must be valid until the writer
+   *                is destroyed.
+   *
+   * @throw Exception if the device could not be opened.
+   */
+  explicit ZipWriter(QIODevice& device);
+
+  ~ZipWriter() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Add a file to the archive
+   *
+   * @param path      Relative path of the file within the archive.
+   * @param content   File content.
+   *
+   * @throw Exception if a previously added file could not be written.
+   */
+  void addFile(const QString& path, const QByteArray& content);
+
+  /**
+   * @brief Write all pending files and close the archive
+   *
+   * @throw Exception if any file could not be written.
+   */
+  void finish();
+
+  // Operator Overloadings
+  ZipWriter& operator=(const ZipWriter& rhs) = delete;
+
+private:  // Types
+  struct CompressedFile {
+    QByteArray data;
+    quint32 crc;
+    qint64 uncompressedSize;
+  };
+
+private:  // Methods
+  void open();
+  void writeNextFile();
+  static CompressedFile compress(const QByteArray& content);
+
+private:  // Data
+  FilePath mFilePath;  ///< Invalid if writing into a device
+  std::unique_ptr<QuaZip> mZip;
+  QThreadPool mThreadPool;
+  QQueue<std::pair<QString, QFuture<CompressedFile>>> mPendingFiles;
+  bool mFinished;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
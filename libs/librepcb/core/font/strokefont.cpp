@@ -22,12 +22,20 @@
  ******************************************************************************/
 #include "strokefont.h"
 
+#include "../application.h"
+#include "../exceptions.h"
+#include "../fileio/fileutils.h"
+#include "../utils/cachekeybuilder.h"
+
 #include <fontobene-qt5/font.h>
 #include <fontobene-qt5/glyphlistaccessor.h>
 
 #include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <cstring>
+#include <type_traits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -35,21 +43,48 @@ namespace librepcb {
 
 namespace fb = fontobene;
 
+/// Maximum number of stroked texts kept in the cache of each font
+static const int sStrokeCacheSize = 20000;
+
+/// Format identifier of the glyph cache files
+static const char* sGlyphCacheFormat = "librepcb-strokefont-1";
+
+/// U+FFFD REPLACEMENT CHARACTER, used for glyphs not contained in the font
+static const uint sReplacementGlyph = 0xFFFD;
+
+// The vertices are stored as raw bytes in the cache files.
+static_assert(std::is_trivially_copyable<fb::Vertex>::value,
+              "fontobene::Vertex must be trivially copyable");
+
+/*******************************************************************************
+ *  Struct GlyphTable
+ ******************************************************************************/
+
+struct StrokeFont::GlyphTable {
+  struct Glyph {
+    qreal spacing;
+    QVector<QVector<fb::Vertex>> polylines;
+  };
+
+  qreal letterSpacing = 0;  ///< Normalized to the font height
+  qreal lineSpacing = 0;  ///< Normalized to the font height
+  QHash<uint, Glyph> glyphs;  ///< Key: Unicode code point
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 StrokeFont::StrokeFont(const FilePath& fontFilePath,
                        const QByteArray& content) noexcept
-  : QObject(nullptr), mFilePath(fontFilePath) {
+  : QObject(nullptr), mFilePath(fontFilePath), mStrokeCache(sStrokeCacheSize) {
   // load the font in another thread because it takes some time to load it
   qDebug() << "Start loading stroke font " << mFilePath.toNative()
            << "in worker thread...";
-  mFuture = QtConcurrent::run([content]() {
-    QTextStream s(content);
-    return fb::Font(s);
+  mFuture = QtConcurrent::run([fontFilePath, content]() {
+    return loadGlyphTable(fontFilePath, content);
   });
-  connect(&mWatcher, &QFutureWatcher<fb::Font>::finished, this,
+  connect(&mWatcher, &QFutureWatcher<GlyphTable>::finished, this,
           &StrokeFont::fontLoaded);
   mWatcher.setFuture(mFuture);
 }
@@ -62,13 +97,13 @@ StrokeFont::~StrokeFont() noexcept {
  ******************************************************************************/
 
 Ratio StrokeFont::getLetterSpacing() const noexcept {
-  accessor();  // block until the font is loaded.
-  return Ratio::fromNormalized(mFont->header.letterSpacing / 9);
+  QMutexLocker lock(&mMutex);
+  return Ratio::fromNormalized(table().letterSpacing);
 }
 
 Ratio StrokeFont::getLineSpacing() const noexcept {
-  accessor();  // block until the font is loaded.
-  return Ratio::fromNormalized(mFont->header.lineSpacing / 9);
+  QMutexLocker lock(&mMutex);
+  return Ratio::fromNormalized(table().lineSpacing);
 }
 
 /*******************************************************************************
@@ -81,8 +116,19 @@ QVector<Path> StrokeFont::stroke(const QString& text,
                                  const Length& lineSpacing,
                                  const Alignment& align, Point& bottomLeft,
                                  Point& topRight) const noexcept {
-  accessor();  // block until the font is loaded. TODO: abort instead of
-               // waiting?
+  const StrokeKey key{text, height->toNm(), letterSpacing.toNm(),
+                      lineSpacing.toNm(), static_cast<int>(align.toQtAlign())};
+  {
+    QMutexLocker lock(&mMutex);
+    table();  // block until the font is loaded. TODO: abort instead of
+              // waiting?
+    if (const StrokedText* cached = mStrokeCache.object(key)) {
+      bottomLeft = cached->bottomLeft;
+      topRight = cached->topRight;
+      return cached->paths;
+    }
+  }
+
   QVector<Path> paths;
   Length totalWidth;
   QVector<QPair<QVector<Path>, Length>> lines =
@@ -131,6 +177,8 @@ QVector<Path> StrokeFont::stroke(const QString& text,
     topRight.setY(totalHeight / 2);
   }
 
+  QMutexLocker lock(&mMutex);
+  mStrokeCache.insert(key, new StrokedText{paths, bottomLeft, topRight});
   return paths;
 }
 
@@ -180,18 +228,36 @@ QVector<Path> StrokeFont::strokeLine(const QString& text,
 QVector<Path> StrokeFont::strokeGlyph(const QChar& glyph,
                                       const PositiveLength& height,
                                       Length& spacing) const noexcept {
-  try {
-    qreal glyphSpacing = 0;
-    QVector<fb::Polyline> polylines =
-        accessor().getAllPolylinesOfGlyph(glyph.unicode(),
-                                          &glyphSpacing);  // can throw
-    spacing = convertLength(height, glyphSpacing);
-    return polylines2paths(polylines, height);
-  } catch (const fb::Exception& e) {
+  QMutexLocker lock(&mMutex);
+  const GlyphTable& t = table();
+  auto it = t.glyphs.find(glyph.unicode());
+  if (it == t.glyphs.end()) {
+    it = t.glyphs.find(sReplacementGlyph);
+  }
+  lock.unlock();  // The glyph table is immutable once loaded.
+  if (it == t.glyphs.end()) {
     qWarning().nospace() << "Failed to load stroke font glyph " << glyph << ".";
     spacing = 0;
     return QVector<Path>();
   }
+  spacing = convertLength(height, it->spacing);
+  return polylines2paths(it->polylines, height);
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+FilePath StrokeFont::getGlyphCacheFilePath(const QByteArray& content) noexcept {
+  // The application version is part of the key since the resolved glyphs
+  // depend on the parser and the glyph replacements, not only on the font.
+  CacheKeyBuilder builder(QCryptographicHash::Sha256);
+  builder.addType(sGlyphCacheFormat);
+  builder.addString(Application::getVersion());
+  builder.addValue(content.size());
+  builder.addData(content);
+  return Application::getCacheDir().getPathTo(
+      "fonts/" % builder.getResult().toHex() % ".glyphs");
 }
 
 /*******************************************************************************
@@ -199,46 +265,160 @@ QVector<Path> StrokeFont::strokeGlyph(const QChar& glyph,
  ******************************************************************************/
 
 void StrokeFont::fontLoaded() noexcept {
-  accessor();  // trigger the message about loading succeeded or failed
+  QMutexLocker lock(&mMutex);
+  table();  // take over the loaded glyphs
+}
+
+const StrokeFont::GlyphTable& StrokeFont::table() const noexcept {
+  if (!mTable) {
+    mTable.reset(new GlyphTable(mFuture.result()));
+  }
+  return *mTable;
 }
 
-const fb::GlyphListAccessor& StrokeFont::accessor() const noexcept {
-  if (!mFont) {
+StrokeFont::GlyphTable StrokeFont::loadGlyphTable(
+    const FilePath& fontFilePath, const QByteArray& content) noexcept {
+  // Note: This method is called from a worker thread!
+  const FilePath cacheFp = getGlyphCacheFilePath(content);
+  GlyphTable table;
+  if (loadGlyphTableFromCache(cacheFp, table)) {
+    qDebug() << "Loaded stroke font" << fontFilePath.toNative()
+             << "from cache with" << table.glyphs.count() << "glyphs.";
+  } else {
+    table = parseGlyphTable(fontFilePath, content);
+    saveGlyphTableToCache(cacheFp, table);
+  }
+  return table;
+}
+
+StrokeFont::GlyphTable StrokeFont::parseGlyphTable(
+    const FilePath& fontFilePath, const QByteArray& content) noexcept {
+  std::unique_ptr<fb::Font> font;
+  try {
+    QTextStream s(content);
+    font.reset(new fb::Font(s));  // can throw
+    qDebug() << "Successfully loaded stroke font" << fontFilePath.toNative()
+             << "with" << font->glyphs.count() << "glyphs.";
+  } catch (const fb::Exception& e) {
+    font.reset(new fb::Font());
+    qCritical().nospace() << "Failed to load stroke font "
+                          << fontFilePath.toNative() << ": " << e.msg();
+  }
+
+  // Resolve all glyphs (including references to other glyphs) of the basic
+  // multilingual plane, which covers all characters representable by QChar.
+  // The replacement glyph is not resolved here since it's applied on lookup.
+  fb::GlyphListCache cache(font->glyphs);
+  cache.addReplacements(
+      {0x00B5, 0x03BC});  // MICRO SIGN <-> GREEK SMALL LETTER MU
+  cache.addReplacements(
+      {0x2126, 0x03A9});  // OHM SIGN <-> GREEK CAPITAL LETTER OMEGA
+  fb::GlyphListAccessor accessor(cache);
+  GlyphTable table;
+  table.letterSpacing = font->header.letterSpacing / 9;
+  table.lineSpacing = font->header.lineSpacing / 9;
+  for (uint codepoint = 0; codepoint <= 0xFFFF; ++codepoint) {
     try {
-      mFont.reset(new fb::Font(mFuture.result()));  // can throw
-      qDebug() << "Successfully loaded stroke font" << mFilePath.toNative()
-               << "with" << mFont->glyphs.count() << "glyphs.";
-    } catch (const fb::Exception& e) {
-      mFont.reset(new fb::Font());
-      qCritical().nospace() << "Failed to load stroke font "
-                            << mFilePath.toNative() << ": " << e.msg();
+      qreal spacing = 0;
+      const QVector<fb::Polyline> polylines =
+          accessor.getAllPolylinesOfGlyph(codepoint, &spacing);  // can throw
+      GlyphTable::Glyph glyph{spacing, {}};
+      foreach (const fb::Polyline& p, polylines) {
+        QVector<fb::Vertex> vertices;
+        foreach (const fb::Vertex& v, p) {
+          vertices.append(v);
+        }
+        glyph.polylines.append(vertices);
+      }
+      table.glyphs.insert(codepoint, glyph);
+    } catch (const fb::Exception&) {
+      // Glyph not contained in the font.
     }
+  }
+  return table;
+}
 
-    mGlyphListCache.reset(new fb::GlyphListCache(mFont->glyphs));
-    mGlyphListCache->setReplacementGlyph(
-        0xFFFD);  // U+FFFD REPLACEMENT CHARACTER
-    mGlyphListCache->addReplacements(
-        {0x00B5, 0x03BC});  // MICRO SIGN <-> GREEK SMALL LETTER MU
-    mGlyphListCache->addReplacements(
-        {0x2126, 0x03A9});  // OHM SIGN <-> GREEK CAPITAL LETTER OMEGA
+bool StrokeFont::loadGlyphTableFromCache(const FilePath& fp,
+                                         GlyphTable& table) noexcept {
+  if (!fp.isExistingFile()) {
+    return false;
+  }
+
+  try {
+    const QByteArray content = FileUtils::readFile(fp);  // can throw
+    QDataStream stream(content);
+    stream.setVersion(QDataStream::Qt_5_5);
+    QByteArray format;
+    quint32 vertexSize = 0;
+    quint32 glyphCount = 0;
+    stream >> format >> vertexSize;
+    if ((format != sGlyphCacheFormat) || (vertexSize != sizeof(fb::Vertex))) {
+      return false;  // Created by another application version.
+    }
+    stream >> table.letterSpacing >> table.lineSpacing >> glyphCount;
+    for (quint32 i = 0; i < glyphCount; ++i) {
+      quint32 codepoint = 0;
+      GlyphTable::Glyph glyph{0, {}};
+      quint32 polylineCount = 0;
+      stream >> codepoint >> glyph.spacing >> polylineCount;
+      for (quint32 k = 0; k < polylineCount; ++k) {
+        QByteArray raw;
+        stream >> raw;
+        if ((raw.size() % sizeof(fb::Vertex)) != 0) {
+          throw RuntimeError(__FILE__, __LINE__, "Corrupt glyph cache file.");
+        }
+        QVector<fb::Vertex> vertices(raw.size() / sizeof(fb::Vertex));
+        std::memcpy(vertices.data(), raw.constData(), raw.size());
+        glyph.polylines.append(vertices);
+      }
+      table.glyphs.insert(codepoint, glyph);
+    }
+    if ((stream.status() != QDataStream::Ok) || (!stream.atEnd())) {
+      throw RuntimeError(__FILE__, __LINE__, "Corrupt glyph cache file.");
+    }
+    return true;
+  } catch (const Exception& e) {
+    qWarning() << "Failed to load cached stroke font:" << e.getMsg();
+    table = GlyphTable();
+    return false;
+  }
+}
 
-    mGlyphListAccessor.reset(new fb::GlyphListAccessor(*mGlyphListCache));
+void StrokeFont::saveGlyphTableToCache(const FilePath& fp,
+                                       const GlyphTable& table) noexcept {
+  try {
+    QByteArray content;
+    QDataStream stream(&content, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_5);
+    stream << QByteArray(sGlyphCacheFormat)
+           << static_cast<quint32>(sizeof(fb::Vertex)) << table.letterSpacing
+           << table.lineSpacing << static_cast<quint32>(table.glyphs.count());
+    for (auto it = table.glyphs.begin(); it != table.glyphs.end(); it++) {
+      stream << static_cast<quint32>(it.key()) << it->spacing
+             << static_cast<quint32>(it->polylines.count());
+      foreach (const QVector<fb::Vertex>& vertices, it->polylines) {
+        const char* data = reinterpret_cast<const char*>(vertices.constData());
+        stream << QByteArray(data, vertices.count() * sizeof(fb::Vertex));
+      }
+    }
+    FileUtils::writeFile(fp, content);  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to cache stroke font:" << e.getMsg();
   }
-  return *mGlyphListAccessor;
 }
 
 QVector<Path> StrokeFont::polylines2paths(
-    const QVector<fb::Polyline>& polylines,
+    const QVector<QVector<fb::Vertex>>& polylines,
     const PositiveLength& height) noexcept {
   QVector<Path> paths;
-  foreach (const fb::Polyline& p, polylines) {
+  foreach (const QVector<fb::Vertex>& p, polylines) {
     if (p.isEmpty()) continue;
     paths.append(polyline2path(p, height));
   }
   return paths;
 }
 
-Path StrokeFont::polyline2path(const fb::Polyline& p,
+Path StrokeFont::polyline2path(const QVector<fb::Vertex>& p,
                                const PositiveLength& height) noexcept {
   Path path;
   foreach (const fb::Vertex& v, p) {
@@ -35,10 +35,6 @@
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace fontobene {
-class GlyphListAccessor;
-class GlyphListCache;
-struct Font;
-struct Polyline;
 struct Vertex;
 }  // namespace fontobene
 
@@ -50,6 +46,17 @@ namespace librepcb {
 
 /**
  * @brief The StrokeFont class
+ *
+ * All methods are thread-safe. Results of #stroke() are cached, so stroking
+ * the same text multiple times (e.g. when loading, exporting and checking a
+ * board) is cheap.
+ *
+ * Parsing a FontoBene font takes some time, therefore the glyphs are loaded
+ * in a worker thread and stored in a binary cache file in
+ * ::librepcb::Application::getCacheDir() (keyed by the hash of the font file
+ * content and the application version). Subsequent application starts load
+ * the glyphs from there, which is much faster than parsing the font file
+ * again.
  */
 class StrokeFont final : public QObject {
   Q_OBJECT
@@ -78,16 +85,63 @@ public:
   QVector<Path> strokeGlyph(const QChar& glyph, const PositiveLength& height,
                             Length& spacing) const noexcept;
 
+  // Static Methods
+
+  /**
+   * @brief Get the filepath of the glyph cache file of a font
+   *
+   * @param content   The font file content.
+   *
+   * @return The cache file path (might not exist).
+   */
+  static FilePath getGlyphCacheFilePath(const QByteArray& content) noexcept;
+
   // Operator Overloadings
   StrokeFont& operator=(const StrokeFont& rhs) = delete;
 
-private:
+private:  // Types
+  struct StrokeKey {
+    QString text;
+    qint64 height;
+    qint64 letterSpacing;
+    qint64 lineSpacing;
+    int align;
+
+    bool operator==(const StrokeKey& rhs) const noexcept {
+      return (text == rhs.text) && (height == rhs.height) &&
+          (letterSpacing == rhs.letterSpacing) &&
+          (lineSpacing == rhs.lineSpacing) && (align == rhs.align);
+    }
+    friend uint qHash(const StrokeKey& key, uint seed) noexcept {
+      seed = ::qHash(qMakePair(key.text, key.align), seed);
+      seed = ::qHash(qMakePair(key.letterSpacing, key.lineSpacing), seed);
+      return ::qHash(key.height, seed);
+    }
+  };
+  struct StrokedText {
+    QVector<Path> paths;
+    Point bottomLeft;
+    Point topRight;
+  };
+
+  struct GlyphTable;  ///< Defined in the source file
+
+private:  // Methods
   void fontLoaded() noexcept;
-  const fontobene::GlyphListAccessor& accessor() const noexcept;
+  // Note: The caller must hold mMutex.
+  const GlyphTable& table() const noexcept;
+  static GlyphTable loadGlyphTable(const FilePath& fontFilePath,
+                                   const QByteArray& content) noexcept;
+  static GlyphTable parseGlyphTable(const FilePath& fontFilePath,
+                                    const QByteArray& content) noexcept;
+  static bool loadGlyphTableFromCache(const FilePath& fp,
+                                      GlyphTable& table) noexcept;
+  static void saveGlyphTableToCache(const FilePath& fp,
+                                    const GlyphTable& table) noexcept;
   static QVector<Path> polylines2paths(
-      const QVector<fontobene::Polyline>& polylines,
+      const QVector<QVector<fontobene::Vertex>>& polylines,
       const PositiveLength& height) noexcept;
-  static Path polyline2path(const fontobene::Polyline& p,
+  static Path polyline2path(const QVector<fontobene::Vertex>& p,
                             const PositiveLength& height) noexcept;
   static Vertex convertVertex(const fontobene::Vertex& v,
                               const PositiveLength& height) noexcept;
@@ -98,11 +152,11 @@ private:
 
 private:  // Data
   FilePath mFilePath;
-  QFuture<fontobene::Font> mFuture;
-  QFutureWatcher<fontobene::Font> mWatcher;
-  mutable QScopedPointer<fontobene::Font> mFont;
-  mutable QScopedPointer<fontobene::GlyphListCache> mGlyphListCache;
-  mutable QScopedPointer<fontobene::GlyphListAccessor> mGlyphListAccessor;
+  QFuture<GlyphTable> mFuture;
+  QFutureWatcher<GlyphTable> mWatcher;
+  mutable QScopedPointer<GlyphTable> mTable;
+  mutable QCache<StrokeKey, StrokedText> mStrokeCache;
+  mutable QMutex mMutex;  ///< Protects all mutable members
 };
 
 /*******************************************************************************
@@ -42,7 +42,8 @@ PadGeometry::PadGeometry(const PadGeometry& other) noexcept
     mRadius(other.mRadius),
     mPath(other.mPath),
     mOffset(other.mOffset),
-    mHoles(other.mHoles) {
+    mHoles(other.mHoles),
+    mOutlines(other.getCachedOutlines()) {
 }
 
 PadGeometry::PadGeometry(Shape shape, const Length& width, const Length& height,
@@ -77,70 +78,11 @@ UnsignedLength PadGeometry::getCornerRadius() const noexcept {
  ******************************************************************************/
 
 QVector<Path> PadGeometry::toOutlines() const {
-  const Length w = getWidth();
-  const Length h = getHeight();
-  const UnsignedLength r = getCornerRadius();
-
-  QVector<Path> result;
-  switch (mShape) {
-    case Shape::RoundedRect: {
-      if ((w > 0) && (h > 0)) {
-        result.append(
-            Path::centeredRect(PositiveLength(w), PositiveLength(h), r));
-      }
-      break;
-    }
-    case Shape::RoundedOctagon: {
-      if ((w > 0) && (h > 0)) {
-        result.append(Path::octagon(PositiveLength(w), PositiveLength(h), r));
-      }
-      break;
-    }
-    case Shape::Stroke: {
-      if (w > 0) {
-        result = mPath.toOutlineStrokes(PositiveLength(w));
-        // Unite all outlines to get only a single, non-intersecting outline.
-        // Not needed if there's only one straight line segment since it
-        // cannot be self-intersecting.
-        if ((result.count() > 1) ||
-            ((result.count() == 1) &&
-             (mPath.getVertices().first().getAngle() != Angle::deg0()))) {
-          ClipperLib::Paths paths =
-              ClipperHelpers::convert(result, maxArcTolerance());
-          std::unique_ptr<ClipperLib::PolyTree> tree =
-              ClipperHelpers::uniteToTree(paths,
-                                          ClipperLib::pftNonZero);  // can throw
-          paths = ClipperHelpers::flattenTree(*tree);  // can throw
-          result = ClipperHelpers::convert(paths);
-        }
-      }
-      break;
-    }
-    case Shape::Custom: {
-      const Path outline = mPath.toClosedPath();
-      if (outline.getVertices().count() >= 3) {
-        // Note: If mOffset is zero, the offset operation sounds superfluous.
-        // However, this operation ensures that invalid outlines (e.g.
-        // overlaps or intersections) will be cleaned before any further
-        // processing of the pad shape (e.g. Gerber export).
-        ClipperLib::Paths paths{
-            ClipperHelpers::convert(outline, maxArcTolerance())};
-        std::unique_ptr<ClipperLib::PolyTree> tree =
-            ClipperHelpers::offsetToTree(paths, mOffset,
-                                         maxArcTolerance());  // can throw
-        paths = ClipperHelpers::flattenTree(*tree);  // can throw
-        result = ClipperHelpers::convert(paths);
-      }
-      break;
-    }
-    default: {
-      qCritical() << "Unhandled switch-case in PadGeometry::toOutlines():"
-                  << static_cast<int>(mShape);
-      Q_ASSERT(false);
-      break;
-    }
+  QMutexLocker lock(&mOutlinesMutex);
+  if (!mOutlines) {
+    mOutlines = buildOutlines();  // can throw
   }
-  return result;
+  return *mOutlines;
 }
 
 QPainterPath PadGeometry::toQPainterPathPx() const noexcept {
@@ -186,8 +128,11 @@ PadGeometry PadGeometry::withOffset(const Length& offset) const noexcept {
 }
 
 PadGeometry PadGeometry::withoutHoles() const noexcept {
-  return PadGeometry(mShape, mBaseWidth, mBaseHeight, mRadius, mPath, mOffset,
-                     PadHoleList{});
+  PadGeometry geometry(mShape, mBaseWidth, mBaseHeight, mRadius, mPath,
+                       mOffset, PadHoleList{});
+  // Holes have no influence on the outlines, so keep them.
+  geometry.mOutlines = getCachedOutlines();
+  return geometry;
 }
 
 /*******************************************************************************
@@ -252,9 +197,88 @@ PadGeometry& PadGeometry::operator=(const PadGeometry& rhs) noexcept {
   mPath = rhs.mPath;
   mOffset = rhs.mOffset;
   mHoles = rhs.mHoles;
+  const tl::optional<QVector<Path>> outlines = rhs.getCachedOutlines();
+  QMutexLocker lock(&mOutlinesMutex);
+  mOutlines = outlines;
   return *this;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+tl::optional<QVector<Path>> PadGeometry::getCachedOutlines() const noexcept {
+  QMutexLocker lock(&mOutlinesMutex);
+  return mOutlines;
+}
+
+QVector<Path> PadGeometry::buildOutlines() const {
+  const Length w = getWidth();
+  const Length h = getHeight();
+  const UnsignedLength r = getCornerRadius();
+
+  QVector<Path> result;
+  switch (mShape) {
+    case Shape::RoundedRect: {
+      if ((w > 0) && (h > 0)) {
+        result.append(
+            Path::centeredRect(PositiveLength(w), PositiveLength(h), r));
+      }
+      break;
+    }
+    case Shape::RoundedOctagon: {
+      if ((w > 0) && (h > 0)) {
+        result.append(Path::octagon(PositiveLength(w), PositiveLength(h), r));
+      }
+      break;
+    }
+    case Shape::Stroke: {
+      if (w > 0) {
+        result = mPath.toOutlineStrokes(PositiveLength(w));
+        // Unite all outlines to get only a single, non-intersecting outline.
+        // Not needed if there's only one straight line segment since it
+        // cannot be self-intersecting.
+        if ((result.count() > 1) ||
+            ((result.count() == 1) &&
+             (mPath.getVertices().first().getAngle() != Angle::deg0()))) {
+          ClipperLib::Paths paths =
+              ClipperHelpers::convert(result, maxArcTolerance());
+          std::unique_ptr<ClipperLib::PolyTree> tree =
+              ClipperHelpers::uniteToTree(paths,
+                                          ClipperLib::pftNonZero);  // can throw
+          paths = ClipperHelpers::flattenTree(*tree);  // can throw
+          result = ClipperHelpers::convert(paths);
+        }
+      }
+      break;
+    }
+    case Shape::Custom: {
+      const Path outline = mPath.toClosedPath();
+      if (outline.getVertices().count() >= 3) {
+        // Note: If mOffset is zero, the offset operation sounds superfluous.
+        // However, this operation ensures that invalid outlines (e.g.
+        // overlaps or intersections) will be cleaned before any further
+        // processing of the pad shape (e.g. Gerber export).
+        ClipperLib::Paths paths{
+            ClipperHelpers::convert(outline, maxArcTolerance())};
+        std::unique_ptr<ClipperLib::PolyTree> tree =
+            ClipperHelpers::offsetToTree(paths, mOffset,
+                                         maxArcTolerance());  // can throw
+        paths = ClipperHelpers::flattenTree(*tree);  // can throw
+        result = ClipperHelpers::convert(paths);
+      }
+      break;
+    }
+    default: {
+      qCritical() << "Unhandled switch-case in PadGeometry::toOutlines():"
+                  << static_cast<int>(mShape);
+      Q_ASSERT(false);
+      break;
+    }
+  }
+  return result;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
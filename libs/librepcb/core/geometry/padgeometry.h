@@ -69,6 +69,18 @@ public:
   const PadHoleList& getHoles() const noexcept { return mHoles; }
 
   // General Methods
+
+  /**
+   * @brief Get the outline(s) of the pad (without holes)
+   *
+   * The result is cached, so repeated calls (e.g. from the graphics items,
+   * the DRC and the Gerber export) compute the outlines only once. Copies
+   * of this object share the already computed outlines.
+   *
+   * @return Outlines
+   *
+   * @throw Exception if the outlines could not be built.
+   */
   QVector<Path> toOutlines() const;
   QPainterPath toQPainterPathPx() const noexcept;
   QPainterPath toFilledQPainterPathPx() const noexcept;
@@ -99,6 +111,8 @@ public:
   PadGeometry& operator=(const PadGeometry& rhs) noexcept;
 
 private:  // Methods
+  tl::optional<QVector<Path>> getCachedOutlines() const noexcept;
+  QVector<Path> buildOutlines() const;
   PadGeometry(Shape shape, const Length& width, const Length& height,
               const UnsignedLimitedRatio& radius, const Path& path,
               const Length& offset, const PadHoleList& holes) noexcept;
@@ -120,6 +134,8 @@ private:  // Data
   Path mPath;
   Length mOffset;
   PadHoleList mHoles;
+  mutable tl::optional<QVector<Path>> mOutlines;  // cache for #toOutlines()
+  mutable QMutex mOutlinesMutex;  // allows concurrent #toOutlines()
 };
 
 /*******************************************************************************
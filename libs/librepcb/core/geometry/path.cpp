@@ -38,8 +38,14 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-Path::Path(const Path& other) noexcept
-  : mVertices(other.mVertices), mPainterPathPx(other.mPainterPathPx) {
+Path::Path(const Path& other) noexcept : mVertices(other.mVertices) {
+  QMutexLocker lock(&other.mPainterPathMutex);
+  mPainterPathPx = other.mPainterPathPx;
+}
+
+Path::Path(Path&& other) noexcept
+  : mVertices(std::move(other.mVertices)), mPainterPathPx() {
+  mPainterPathPx.swap(other.mPainterPathPx);
 }
 
 Path::Path(const SExpression& node) {
@@ -154,6 +160,9 @@ QVector<Path> Path::toOutlineStrokes(
 }
 
 const QPainterPath& Path::toQPainterPathPx() const noexcept {
+  // Note: The path might be read concurrently by several threads (e.g. by
+  // output jobs), thus the lazily filled cache needs to be protected.
+  QMutexLocker lock(&mPainterPathMutex);
   if (mPainterPathPx.isEmpty()) {
     for (int i = 0; i < mVertices.count(); ++i) {
       const Vertex& v = mVertices.at(i);
@@ -196,10 +205,14 @@ Path& Path::translate(const Point& offset) noexcept {
   return *this;
 }
 
-Path Path::translated(const Point& offset) const noexcept {
+Path Path::translated(const Point& offset) const& noexcept {
   return Path(*this).translate(offset);
 }
 
+Path Path::translated(const Point& offset) && noexcept {
+  return std::move(translate(offset));
+}
+
 Path& Path::mapToGrid(const PositiveLength& gridInterval) noexcept {
   for (Vertex& vertex : mVertices) {
     vertex.setPos(vertex.getPos().mappedToGrid(gridInterval));
@@ -208,10 +221,14 @@ Path& Path::mapToGrid(const PositiveLength& gridInterval) noexcept {
   return *this;
 }
 
-Path Path::mappedToGrid(const PositiveLength& gridInterval) const noexcept {
+Path Path::mappedToGrid(const PositiveLength& gridInterval) const& noexcept {
   return Path(*this).mapToGrid(gridInterval);
 }
 
+Path Path::mappedToGrid(const PositiveLength& gridInterval) && noexcept {
+  return std::move(mapToGrid(gridInterval));
+}
+
 Path& Path::rotate(const Angle& angle, const Point& center) noexcept {
   for (Vertex& vertex : mVertices) {
     vertex.setPos(vertex.getPos().rotated(angle, center));
@@ -220,10 +237,14 @@ Path& Path::rotate(const Angle& angle, const Point& center) noexcept {
   return *this;
 }
 
-Path Path::rotated(const Angle& angle, const Point& center) const noexcept {
+Path Path::rotated(const Angle& angle, const Point& center) const& noexcept {
   return Path(*this).rotate(angle, center);
 }
 
+Path Path::rotated(const Angle& angle, const Point& center) && noexcept {
+  return std::move(rotate(angle, center));
+}
+
 Path& Path::mirror(Qt::Orientation orientation, const Point& center) noexcept {
   for (Vertex& vertex : mVertices) {
     vertex.setPos(vertex.getPos().mirrored(orientation, center));
@@ -234,10 +255,15 @@ Path& Path::mirror(Qt::Orientation orientation, const Point& center) noexcept {
 }
 
 Path Path::mirrored(Qt::Orientation orientation,
-                    const Point& center) const noexcept {
+                    const Point& center) const& noexcept {
   return Path(*this).mirror(orientation, center);
 }
 
+Path Path::mirrored(Qt::Orientation orientation, const Point& center) &&
+    noexcept {
+  return std::move(mirror(orientation, center));
+}
+
 Path& Path::reverse() noexcept {
   QVector<Vertex> vertices;
   vertices.reserve(mVertices.count());
@@ -250,10 +276,14 @@ Path& Path::reverse() noexcept {
   return *this;
 }
 
-Path Path::reversed() const noexcept {
+Path Path::reversed() const& noexcept {
   return Path(*this).reverse();
 }
 
+Path Path::reversed() && noexcept {
+  return std::move(reverse());
+}
+
 Path& Path::flattenArcs(const PositiveLength& maxTolerance) noexcept {
   if (!mVertices.isEmpty()) {
     mVertices.last().setAngle(Angle::deg0());
@@ -274,10 +304,14 @@ Path& Path::flattenArcs(const PositiveLength& maxTolerance) noexcept {
   return *this;
 }
 
-Path Path::flattenedArcs(const PositiveLength& maxTolerance) const noexcept {
+Path Path::flattenedArcs(const PositiveLength& maxTolerance) const& noexcept {
   return Path(*this).flattenArcs(maxTolerance);
 }
 
+Path Path::flattenedArcs(const PositiveLength& maxTolerance) && noexcept {
+  return std::move(flattenArcs(maxTolerance));
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -346,8 +380,18 @@ void Path::serialize(SExpression& root) const {
  ******************************************************************************/
 
 Path& Path::operator=(const Path& rhs) noexcept {
-  mVertices = rhs.mVertices;
-  mPainterPathPx = rhs.mPainterPathPx;
+  if (&rhs != this) {
+    mVertices = rhs.mVertices;
+    QMutexLocker lock(&rhs.mPainterPathMutex);
+    mPainterPathPx = rhs.mPainterPathPx;
+  }
+  return *this;
+}
+
+Path& Path::operator=(Path&& rhs) noexcept {
+  mVertices = std::move(rhs.mVertices);
+  mPainterPathPx.swap(rhs.mPainterPathPx);
+  rhs.invalidatePainterPath();
   return *this;
 }
 
@@ -376,6 +420,7 @@ Path Path::circle(const PositiveLength& diameter) noexcept {
 Path Path::obround(const PositiveLength& width,
                    const PositiveLength& height) noexcept {
   Path p;
+  p.mVertices.reserve(5);
   Length rx = width / 2;
   Length ry = height / 2;
   if (width > height) {
@@ -431,6 +476,7 @@ Path Path::arcObround(const Point& p1, const Point& p2, const Angle& angle,
       center + Point(outerRadius, 0).rotated(Angle::fromRad(angle2Rad));
 
   Path p;
+  p.mVertices.reserve(5);
   p.addVertex(p1Inner, angle);
   p.addVertex(p2Inner, angle < 0 ? Angle::deg180() : -Angle::deg180());
   p.addVertex(p2Outer, -angle);
@@ -441,6 +487,7 @@ Path Path::arcObround(const Point& p1, const Point& p2, const Angle& angle,
 
 Path Path::rect(const Point& p1, const Point& p2) noexcept {
   Path p;
+  p.mVertices.reserve(5);
   p.addVertex(Point(p1.getX(), p1.getY()));
   p.addVertex(Point(p2.getX(), p1.getY()));
   p.addVertex(Point(p2.getX(), p2.getY()));
@@ -453,6 +500,7 @@ Path Path::centeredRect(const PositiveLength& width,
                         const PositiveLength& height,
                         const UnsignedLength& cornerRadius) noexcept {
   Path p;
+  p.mVertices.reserve(9);  // Including the closing vertex.
   const Length rx = width / 2;
   const Length ry = height / 2;
   if (cornerRadius == 0) {
@@ -482,6 +530,7 @@ Path Path::centeredRect(const PositiveLength& width,
 Path Path::octagon(const PositiveLength& width, const PositiveLength& height,
                    const UnsignedLength& cornerRadius) noexcept {
   Path p;
+  p.mVertices.reserve(17);  // Including the closing vertex.
   const Length rx = width / 2;
   const Length ry = height / 2;
   const Length innerChamfer =
@@ -553,6 +602,7 @@ Path Path::flatArc(const Point& p1, const Point& p2, const Angle& angle,
 
   // create line segments
   Path p;
+  p.mVertices.reserve(steps + 1);
   p.addVertex(p1);
   for (int i = 1; i < steps; ++i) {
     p.addVertex(p1.rotated(Angle(angleDelta * i), center));
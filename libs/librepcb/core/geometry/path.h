@@ -61,8 +61,11 @@ public:
   // Constructors / Destructor
   Path() noexcept : mVertices(), mPainterPathPx() {}
   Path(const Path& other) noexcept;
+  Path(Path&& other) noexcept;
   explicit Path(const QVector<Vertex>& vertices) noexcept
     : mVertices(vertices) {}
+  explicit Path(QVector<Vertex>&& vertices) noexcept
+    : mVertices(std::move(vertices)) {}
   explicit Path(const SExpression& node);
   ~Path() noexcept {}
 
@@ -84,21 +87,32 @@ public:
   const QPainterPath& toQPainterPathPx() const noexcept;
 
   // Transformations
+  //
+  // The "-ed" variants return a transformed copy. If called on a temporary,
+  // they transform the temporary in place to avoid copying the vertices.
   Path& translate(const Point& offset) noexcept;
-  Path translated(const Point& offset) const noexcept;
+  Path translated(const Point& offset) const& noexcept;
+  Path translated(const Point& offset) && noexcept;
   Path& mapToGrid(const PositiveLength& gridInterval) noexcept;
-  Path mappedToGrid(const PositiveLength& gridInterval) const noexcept;
+  Path mappedToGrid(const PositiveLength& gridInterval) const& noexcept;
+  Path mappedToGrid(const PositiveLength& gridInterval) && noexcept;
   Path& rotate(const Angle& angle, const Point& center = Point(0, 0)) noexcept;
   Path rotated(const Angle& angle,
-               const Point& center = Point(0, 0)) const noexcept;
+               const Point& center = Point(0, 0)) const& noexcept;
+  Path rotated(const Angle& angle, const Point& center = Point(0, 0)) &&
+      noexcept;
   Path& mirror(Qt::Orientation orientation,
                const Point& center = Point(0, 0)) noexcept;
   Path mirrored(Qt::Orientation orientation,
-                const Point& center = Point(0, 0)) const noexcept;
+                const Point& center = Point(0, 0)) const& noexcept;
+  Path mirrored(Qt::Orientation orientation,
+                const Point& center = Point(0, 0)) && noexcept;
   Path& reverse() noexcept;
-  Path reversed() const noexcept;
+  Path reversed() const& noexcept;
+  Path reversed() && noexcept;
   Path& flattenArcs(const PositiveLength& maxTolerance) noexcept;
-  Path flattenedArcs(const PositiveLength& maxTolerance) const noexcept;
+  Path flattenedArcs(const PositiveLength& maxTolerance) const& noexcept;
+  Path flattenedArcs(const PositiveLength& maxTolerance) && noexcept;
 
   // General Methods
   void addVertex(const Vertex& vertex) noexcept;
@@ -119,6 +133,7 @@ public:
 
   // Operator Overloadings
   Path& operator=(const Path& rhs) noexcept;
+  Path& operator=(Path&& rhs) noexcept;
   bool operator==(const Path& rhs) const noexcept {
     return mVertices == rhs.mVertices;
   }
@@ -177,6 +192,7 @@ private:  // Methods
 private:  // Data
   QVector<Vertex> mVertices;
   mutable QPainterPath mPainterPathPx;  // cached path for #toQPainterPathPx()
+  mutable QMutex mPainterPathMutex;  // allows concurrent #toQPainterPathPx()
 };
 
 /*******************************************************************************
@@ -273,4 +289,7 @@ inline uint qHash(const StraightAreaPath& key, uint seed = 0) noexcept {
 
 Q_DECLARE_METATYPE(librepcb::Path)
 
+// Allow containers to relocate paths with memcpy() instead of copying.
+Q_DECLARE_TYPEINFO(librepcb::Path, Q_MOVABLE_TYPE);
+
 #endif
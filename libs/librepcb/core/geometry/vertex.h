@@ -107,4 +107,7 @@ inline uint qHash(const Vertex& key, uint seed = 0) noexcept {
 
 }  // namespace librepcb
 
+// Allow containers to relocate vertices with memcpy() instead of copying.
+Q_DECLARE_TYPEINFO(librepcb::Vertex, Q_MOVABLE_TYPE);
+
 #endif
@@ -27,6 +27,8 @@
 #include <dl_creationadapter.h>
 #include <dl_dxf.h>
 
+#include <fstream>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -48,9 +50,13 @@ namespace librepcb {
  */
 class DxfReaderImpl : public DL_CreationAdapter {
 public:
-  DxfReaderImpl(DxfReader& reader)
+  DxfReaderImpl(DxfReader& reader, std::istream& stream, qint64 fileSize)
     : mReader(reader),
+      mStream(stream),
+      mFileSize(fileSize),
+      mEntityCount(0),
       mScaleToMm(1),
+      mPolylineSkipped(false),
       mPolylineClosed(false),
       mPolylineVertices(0),
       mPolylinePath() {}
@@ -58,15 +64,18 @@ public:
   virtual ~DxfReaderImpl() {}
 
   virtual void addPoint(const DL_PointData& data) override {
+    if (skipEntity()) return;
     mReader.mPoints.append(point(data.x, data.y));
   }
 
   virtual void addLine(const DL_LineData& data) override {
+    if (skipEntity()) return;
     mReader.mPolygons.append(
         Path::line(point(data.x1, data.y1), point(data.x2, data.y2)));
   }
 
   virtual void addArc(const DL_ArcData& data) override {
+    if (skipEntity()) return;
     Point center = point(data.cx, data.cy);
     Length radius = length(data.radius);
     Angle angle1 = angle(data.angle1);
@@ -82,6 +91,7 @@ public:
   }
 
   virtual void addCircle(const DL_CircleData& data) override {
+    if (skipEntity()) return;
     Length diameter = length(data.radius * 2);
     if (diameter > 0) {
       mReader.mCircles.append(
@@ -94,16 +104,19 @@ public:
 
   virtual void addEllipse(const DL_EllipseData& data) override {
     Q_UNUSED(data);
+    if (skipEntity()) return;
     qWarning() << "Ellipse in DXF file ignored since it is not supported yet.";
   }
 
   virtual void addPolyline(const DL_PolylineData& data) override {
+    mPolylineSkipped = skipEntity();
     mPolylineClosed = (data.flags & DL_CLOSED_PLINE) != 0;
     mPolylineVertices = data.number;
     mPolylinePath = Path();
   }
 
   virtual void addVertex(const DL_VertexData& data) override {
+    if (mPolylineSkipped) return;
     mPolylinePath.addVertex(point(data.x, data.y), bulgeToAngle(data.bulge));
     if (mPolylinePath.getVertices().count() == mPolylineVertices) {
       endSequence();
@@ -111,7 +124,7 @@ public:
   }
 
   virtual void endSequence() override {
-    if (mPolylinePath.getVertices().count() >= 2) {
+    if ((!mPolylineSkipped) && (mPolylinePath.getVertices().count() >= 2)) {
       if (mPolylineClosed && (mPolylinePath.getVertices().count() >= 3)) {
         mPolylinePath.close();
       }
@@ -144,6 +157,26 @@ public:
   }
 
 private:  // Methods
+  /**
+   * Reports the progress and returns whether the current entity is skipped
+   * due to the layer filter.
+   */
+  bool skipEntity() {
+    if (mReader.mProgressCallback && ((++mEntityCount % 1000) == 0)) {
+      const qint64 pos = static_cast<qint64>(mStream.tellg());
+      const int percent =
+          (mFileSize > 0) ? qBound(0, int((pos * 100) / mFileSize), 100) : 0;
+      if (!mReader.mProgressCallback(percent)) {
+        throw UserCanceled(__FILE__, __LINE__);
+      }
+    }
+    if (mReader.mLayerFilter.isEmpty()) {
+      return false;
+    }
+    const QString layer =
+        QString::fromStdString(getAttributes().getLayer()).toLower();
+    return !mReader.mLayerFilter.contains(layer);
+  }
   Angle angle(double angle) const { return Angle::fromDeg(angle); }
   Angle bulgeToAngle(double bulge) const {
     // Round to 0.001° to avoid odd numbers like 179.999999°.
@@ -159,9 +192,13 @@ private:  // Methods
 
 private:  // Data
   DxfReader& mReader;
+  std::istream& mStream;
+  qint64 mFileSize;
+  int mEntityCount;
   qreal mScaleToMm;
 
   // Current polygon state
+  bool mPolylineSkipped;
   bool mPolylineClosed;
   int mPolylineVertices;
   Path mPolylinePath;
@@ -177,18 +214,36 @@ DxfReader::DxfReader() noexcept : mScaleFactor(1) {
 DxfReader::~DxfReader() noexcept {
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void DxfReader::setLayerFilter(const QSet<QString>& layers) noexcept {
+  mLayerFilter.clear();
+  foreach (const QString& layer, layers) {
+    mLayerFilter.insert(layer.toLower());
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
 void DxfReader::parse(const FilePath& dxfFile) {
   try {
+    std::ifstream stream(dxfFile.toNative().toStdString());
+    if (!stream.is_open()) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("File does not exist or is not readable."));
+    }
     DL_Dxf dxf;
-    DxfReaderImpl helper(*this);
-    if (!dxf.in(dxfFile.toNative().toStdString(), &helper)) {
+    DxfReaderImpl helper(*this, stream, QFileInfo(dxfFile.toStr()).size());
+    if (!dxf.in(stream, &helper)) {
       throw RuntimeError(__FILE__, __LINE__,
                          tr("File does not exist or is not readable."));
     }
+  } catch (const UserCanceled&) {
+    throw;
   } catch (const std::exception& e) {
     // Since a third party library was used, catch std::exception and convert
     // it to our own exception type.
@@ -27,6 +27,8 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -56,6 +58,11 @@ class FilePath;
  * Note that this class tries to read and apply the length unit defined in the
  * DXF file. However, a DXF file is not required to specify the unit. If it is
  * missing, the unit millimeters is assumed.
+ *
+ * The file is parsed as a stream, i.e. only the objects which are actually
+ * imported are kept in memory. Objects on layers not passing the layer filter
+ * are skipped while parsing. Since the reader does not depend on any GUI
+ * object, it can be used in a worker thread.
  */
 class DxfReader {
   Q_DECLARE_TR_FUNCTIONS(DxfReader)
@@ -66,6 +73,12 @@ public:
     PositiveLength diameter;
   };
 
+  /**
+   * Called regularly during parsing with the progress (0..100). If it
+   * returns `false`, parsing is aborted.
+   */
+  typedef std::function<bool(int percent)> ProgressCallback;
+
   // Constructors / Destructor
 
   /**
@@ -93,6 +106,24 @@ public:
     mScaleFactor = scaleFactor;
   }
 
+  /**
+   * @brief Only import objects on particular DXF layers
+   *
+   * @param layers  Names of the DXF layers to import (case insensitive).
+   *                If empty (the default), all layers are imported.
+   */
+  void setLayerFilter(const QSet<QString>& layers) noexcept;
+
+  /**
+   * @brief Set a callback to report progress and allow aborting
+   *
+   * @param callback  The callback to be called while parsing (from the
+   *                  thread calling #parse()).
+   */
+  void setProgressCallback(const ProgressCallback& callback) noexcept {
+    mProgressCallback = callback;
+  }
+
   // Getters
 
   /**
@@ -123,6 +154,7 @@ public:
    *
    * @param dxfFile   File path to the DXF to import.
    *
+   * @throw UserCanceled if aborted by the progress callback.
    * @throw Exception if anything went wrong (e.g. file does not exist).
    */
   void parse(const FilePath& dxfFile);
@@ -132,6 +164,8 @@ public:
 
 private:
   qreal mScaleFactor;
+  QSet<QString> mLayerFilter;  ///< Lowercase layer names, empty means all
+  ProgressCallback mProgressCallback;
 
   QList<Point> mPoints;
   QList<Circle> mCircles;
@@ -95,10 +95,10 @@ QString Library::getElementsDirectoryName() const noexcept {
 }
 
 // explicit template instantiations
-template QString Library::getElementsDirectoryName<ComponentCategory>()
-    const noexcept;
-template QString Library::getElementsDirectoryName<PackageCategory>()
-    const noexcept;
+template QString Library::getElementsDirectoryName<ComponentCategory>(
+    bool) const noexcept;
+template QString Library::getElementsDirectoryName<PackageCategory>(
+    bool) const noexcept;
 template QString Library::getElementsDirectoryName<Symbol>() const noexcept;
 template QString Library::getElementsDirectoryName<Package>() const noexcept;
 template QString Library::getElementsDirectoryName<Component>() const noexcept;
@@ -139,12 +139,13 @@ void Library::moveTo(TransactionalDirectory& dest) {
 }
 
 template <typename ElementType>
-QStringList Library::searchForElements() const noexcept {
+QStringList Library::searchForElements(bool validate) const noexcept {
   QStringList list;
   QString subdir = getElementsDirectoryName<ElementType>();
   foreach (const QString& dirname, mDirectory->getDirs(subdir)) {
     QString dirPath = subdir % "/" % dirname;
-    if (isValidElementDirectory<ElementType>(*mDirectory, dirPath)) {
+    if ((!validate) ||
+        isValidElementDirectory<ElementType>(*mDirectory, dirPath)) {
       list.append(dirPath);
     } else if (!mDirectory->getFiles(dirPath).isEmpty()) {
       // Note: Do not warn about empty directories since this happens often
@@ -157,14 +158,14 @@ QStringList Library::searchForElements() const noexcept {
 }
 
 // explicit template instantiations
-template QStringList Library::searchForElements<ComponentCategory>()
-    const noexcept;
-template QStringList Library::searchForElements<PackageCategory>()
-    const noexcept;
-template QStringList Library::searchForElements<Symbol>() const noexcept;
-template QStringList Library::searchForElements<Package>() const noexcept;
-template QStringList Library::searchForElements<Component>() const noexcept;
-template QStringList Library::searchForElements<Device>() const noexcept;
+template QStringList Library::searchForElements<ComponentCategory>(
+    bool) const noexcept;
+template QStringList Library::searchForElements<PackageCategory>(
+    bool) const noexcept;
+template QStringList Library::searchForElements<Symbol>(bool) const noexcept;
+template QStringList Library::searchForElements<Package>(bool) const noexcept;
+template QStringList Library::searchForElements<Component>(bool) const noexcept;
+template QStringList Library::searchForElements<Device>(bool) const noexcept;
 
 std::unique_ptr<Library> Library::open(
     std::unique_ptr<TransactionalDirectory> directory,
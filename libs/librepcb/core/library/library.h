@@ -77,8 +77,20 @@ public:
   // General Methods
   virtual void save() override;
   virtual void moveTo(TransactionalDirectory& dest) override;
+
+  /**
+   * @brief Search for all elements of a specific type in this library
+   *
+   * @param validate  If `true`, only directories containing the version file
+   *                  of the element type are returned. If `false`, all
+   *                  subdirectories are returned and the caller has to check
+   *                  them on its own. This allows to do the (potentially slow)
+   *                  file system accesses in parallel.
+   *
+   * @return Relative paths to the element directories.
+   */
   template <typename ElementType>
-  QStringList searchForElements() const noexcept;
+  QStringList searchForElements(bool validate = true) const noexcept;
 
   // Operator Overloadings
   Library& operator=(const Library& rhs) = delete;
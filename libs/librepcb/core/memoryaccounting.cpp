@@ -0,0 +1,69 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "memoryaccounting.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void MemoryAccounting::add(const char* category, qint64 objects,
+                           qint64 bytes) noexcept {
+  QMutexLocker lock(&mMutex);
+  Usage& usage = mUsage[QString(category)];
+  usage.objects += objects;
+  usage.bytes += bytes;
+}
+
+QMap<QString, MemoryAccounting::Usage> MemoryAccounting::getUsage()
+    const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mUsage;
+}
+
+QStringList MemoryAccounting::getReport() const noexcept {
+  QStringList lines;
+  const QMap<QString, Usage> usage = getUsage();
+  for (auto it = usage.begin(); it != usage.end(); ++it) {
+    QString line = QString("%1 %2 objects")
+                       .arg(it.key() % ":", -20)
+                       .arg(it->objects, 8);
+    if (it->bytes > 0) {
+      line += QString(", %1 MiB").arg(it->bytes / 1048576.0, 0, 'f', 1);
+    }
+    lines.append(line);
+  }
+  return lines;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
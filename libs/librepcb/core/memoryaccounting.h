@@ -0,0 +1,168 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_MEMORYACCOUNTING_H
+#define LIBREPCB_CORE_MEMORYACCOUNTING_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class MemoryAccounting
+ ******************************************************************************/
+
+/**
+ * @brief Rough accounting of the memory used by the biggest containers
+ *
+ * Helps to find out which subsystem is responsible for a high memory usage
+ * (e.g. undo history, plane fragments or 3D models). The owners of such
+ * containers keep a #MemoryAccounting::Counter which they update whenever
+ * the content changes, and the sum of all counters of each category is shown
+ * in the diagnostics report (about dialog, `librepcb-cli --verbose`).
+ *
+ * @note The sizes are estimations of the payload only, they don't include
+ *       allocator overhead and might not be known for all categories. In
+ *       that case only the number of objects is accounted.
+ */
+class MemoryAccounting final {
+public:
+  // Types
+  struct Usage {
+    qint64 objects;
+    qint64 bytes;
+  };
+
+  /**
+   * @brief Contribution of a single container to a category
+   *
+   * The contribution is removed automatically on destruction.
+   */
+  class Counter final {
+  public:
+    Counter() = delete;
+    Counter(const Counter& other) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param category  Category name, e.g. the subsystem. Must point to a
+     *                  string literal.
+     */
+    explicit Counter(const char* category) noexcept
+      : mCategory(category), mObjects(0), mBytes(0) {}
+
+    ~Counter() noexcept { set(0, 0); }
+
+    /**
+     * @brief Replace the accounted size of the container
+     *
+     * @param objects   Number of objects in the container.
+     * @param bytes     Estimated memory used by the objects (0 if unknown).
+     */
+    void set(qint64 objects, qint64 bytes) noexcept {
+      if ((objects != mObjects) || (bytes != mBytes)) {
+        instance().add(mCategory, objects - mObjects, bytes - mBytes);
+        mObjects = objects;
+        mBytes = bytes;
+      }
+    }
+
+    /**
+     * @brief Add objects to the accounted size of the container
+     *
+     * @param objects   Number of added objects.
+     * @param bytes     Estimated memory used by the added objects.
+     */
+    void add(qint64 objects, qint64 bytes) noexcept {
+      set(mObjects + objects, mBytes + bytes);
+    }
+
+    Counter& operator=(const Counter& rhs) = delete;
+
+  private:
+    const char* mCategory;
+    qint64 mObjects;
+    qint64 mBytes;
+  };
+
+  // Constructors / Destructor
+  MemoryAccounting(const MemoryAccounting& other) = delete;
+
+  // General Methods
+
+  /**
+   * @brief Add (or remove, if negative) objects to a category
+   *
+   * @param category  Category name.
+   * @param objects   Number of added objects.
+   * @param bytes     Estimated memory used by the added objects.
+   */
+  void add(const char* category, qint64 objects, qint64 bytes) noexcept;
+
+  /**
+   * @brief Get the current usage of all categories
+   *
+   * @return Usage by category name.
+   */
+  QMap<QString, Usage> getUsage() const noexcept;
+
+  /**
+   * @brief Get a human readable report of the current usage
+   *
+   * @return One line per category.
+   */
+  QStringList getReport() const noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Get the singleton instance
+   *
+   * @return The memory accounting instance.
+   */
+  static MemoryAccounting& instance() noexcept {
+    static MemoryAccounting accounting;
+    return accounting;
+  }
+
+  // Operator Overloadings
+  MemoryAccounting& operator=(const MemoryAccounting& rhs) = delete;
+
+private:  // Methods
+  MemoryAccounting() noexcept {}
+
+private:  // Data
+  mutable QMutex mMutex;  ///< Protects #mUsage
+  QMap<QString, Usage> mUsage;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
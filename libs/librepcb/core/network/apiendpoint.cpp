@@ -23,6 +23,8 @@
 #include "apiendpoint.h"
 
 #include "../application.h"
+#include "../exceptions.h"
+#include "../fileio/fileutils.h"
 #include "../types/version.h"
 #include "network/networkrequest.h"
 
@@ -48,17 +50,27 @@ ApiEndpoint::~ApiEndpoint() noexcept {
  *  General Methods
  ******************************************************************************/
 
-void ApiEndpoint::requestLibraryList() const noexcept {
+void ApiEndpoint::requestLibraryList() noexcept {
   QString path =
       "/api/v1/libraries/v" % Application::getFileFormatVersion().toStr();
-  requestLibraryList(QUrl(mUrl.toString() % path));
+  const QUrl url(mUrl.toString() % path);
+  const QByteArray hash = QCryptographicHash::hash(url.toString().toUtf8(),
+                                                   QCryptographicHash::Md5);
+  mCacheFp = Application::getCacheDir().getPathTo("api/" % hash.toHex() %
+                                                  ".libraries.json");
+  mCachedLibraries = loadLibraryListFromCache(mCacheFp);
+  mReceivedLibraries = QJsonArray();
+  if (!mCachedLibraries.isEmpty()) {
+    emit libraryListReceived(mCachedLibraries);
+  }
+  requestLibraryList(url);
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void ApiEndpoint::requestLibraryList(const QUrl& url) const noexcept {
+void ApiEndpoint::requestLibraryList(const QUrl& url) noexcept {
   NetworkRequest* request = new NetworkRequest(url);
   request->setHeaderField("Accept", "application/json;charset=UTF-8");
   request->setHeaderField("Accept-Charset", "UTF-8");
@@ -76,6 +88,16 @@ void ApiEndpoint::requestedDataReceived(const QByteArray& data) noexcept {
         tr("Received JSON object is not valid."));
     return;
   }
+  QJsonValue reposVal = doc.object().value("results");
+  if ((reposVal.isNull()) || (!reposVal.isArray())) {
+    emit errorWhileFetchingLibraryList(
+        tr("Received JSON object does not contain "
+           "any results."));
+    return;
+  }
+  foreach (const QJsonValue& libVal, reposVal.toArray()) {
+    mReceivedLibraries.append(libVal);
+  }
   QJsonValue nextResultsLink = doc.object().value("next");
   if (nextResultsLink.isString()) {
     QUrl url = QUrl(nextResultsLink.toString());
@@ -83,19 +105,50 @@ void ApiEndpoint::requestedDataReceived(const QByteArray& data) noexcept {
       qDebug().nospace() << "Request more results from API endpoint "
                          << url.toString() << "...";
       requestLibraryList(url);
+      return;
     } else {
       qWarning() << "Invalid URL in received JSON object:"
                  << nextResultsLink.toString();
     }
   }
-  QJsonValue reposVal = doc.object().value("results");
-  if ((reposVal.isNull()) || (!reposVal.isArray())) {
-    emit errorWhileFetchingLibraryList(
-        tr("Received JSON object does not contain "
-           "any results."));
+  libraryListCompleted();
+}
+
+void ApiEndpoint::libraryListCompleted() noexcept {
+  // Note: If nothing was cached, the list is emitted even if it is empty.
+  if ((!mCachedLibraries.isEmpty()) &&
+      (mReceivedLibraries == mCachedLibraries)) {
+    qDebug() << "Library list of API endpoint" << mUrl.toString()
+             << "is unchanged.";
     return;
   }
-  emit libraryListReceived(reposVal.toArray());
+  saveLibraryListToCache(mCacheFp, mReceivedLibraries);
+  mCachedLibraries = mReceivedLibraries;
+  emit libraryListReceived(mReceivedLibraries);
+}
+
+QJsonArray ApiEndpoint::loadLibraryListFromCache(const FilePath& fp) noexcept {
+  if (!fp.isExistingFile()) {
+    return QJsonArray();
+  }
+  try {
+    const QJsonDocument doc =
+        QJsonDocument::fromJson(FileUtils::readFile(fp));  // can throw
+    return doc.array();  // Empty if the file is invalid.
+  } catch (const Exception& e) {
+    qWarning() << "Failed to load cached library list:" << e.getMsg();
+    return QJsonArray();
+  }
+}
+
+void ApiEndpoint::saveLibraryListToCache(const FilePath& fp,
+                                         const QJsonArray& libs) noexcept {
+  try {
+    FileUtils::writeFile(
+        fp, QJsonDocument(libs).toJson(QJsonDocument::Compact));  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to cache library list:" << e.getMsg();
+  }
 }
 
 /*******************************************************************************
@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../fileio/filepath.h"
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -37,6 +39,14 @@ namespace librepcb {
 /**
  * @brief Access to a LibrePCB API endpoint
  *
+ * The received library list is stored in the cache directory of the
+ * application. When requesting the list the next time, the cached list is
+ * emitted immediately and the server is queried in the background. Only if the
+ * server returns a different list, it is emitted again. The HTTP requests
+ * themselves go through the disk cache of ::librepcb::NetworkAccessManager,
+ * which revalidates expired responses with conditional requests (ETag and
+ * Last-Modified), so an unchanged list is not transferred again.
+ *
  * @see @ref doc_server_api
  */
 class ApiEndpoint final : public QObject {
@@ -53,7 +63,16 @@ public:
   const QUrl& getUrl() const noexcept { return mUrl; }
 
   // General Methods
-  void requestLibraryList() const noexcept;
+
+  /**
+   * @brief Request the list of libraries
+   *
+   * Emits #libraryListReceived() with the cached list (if any) before this
+   * method returns, and later again with the list received from the server
+   * if it differs from the cached one. Each emission contains the complete
+   * list, so it replaces any previously received list.
+   */
+  void requestLibraryList() noexcept;
 
   // Operators
   ApiEndpoint& operator=(const ApiEndpoint& rhs) = delete;
@@ -63,11 +82,18 @@ signals:
   void errorWhileFetchingLibraryList(const QString& errorMsg);
 
 private:  // Methods
-  void requestLibraryList(const QUrl& url) const noexcept;
+  void requestLibraryList(const QUrl& url) noexcept;
   void requestedDataReceived(const QByteArray& data) noexcept;
+  void libraryListCompleted() noexcept;
+  static QJsonArray loadLibraryListFromCache(const FilePath& fp) noexcept;
+  static void saveLibraryListToCache(const FilePath& fp,
+                                     const QJsonArray& libs) noexcept;
 
 private:  // Data
   QUrl mUrl;
+  FilePath mCacheFp;  ///< Cache file of the current library list request
+  QJsonArray mCachedLibraries;  ///< Library list loaded from the cache
+  QJsonArray mReceivedLibraries;  ///< Libraries received from the server
 };
 
 /*******************************************************************************
@@ -109,7 +109,18 @@ void FileDownload::finalizeRequest() {
                        tr("Error while writing file \"%1\": %2")
                            .arg(mDestination.toNative(), mFile->errorString()));
   }
+}
+
+std::function<void()> FileDownload::createPostProcessingJob() noexcept {
+  // Verifying the checksum and extracting the ZIP might take a while, so do
+  // it in a worker thread.
+  if (mExpectedChecksum.isEmpty() && (!mExtractZipToDir.isValid())) {
+    return nullptr;
+  }
+  return [this]() { postProcess(); };
+}
 
+void FileDownload::postProcess() {
   // if an error occurs below this line, remove the downloaded file
   auto sg = scopeGuard([this]() { QFile::remove(mDestination.toStr()); });
 
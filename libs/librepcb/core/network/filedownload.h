@@ -116,6 +116,8 @@ signals:
 private:  // Methods
   void prepareRequest() override;
   void finalizeRequest() override;
+  std::function<void()> createPostProcessingJob() noexcept override;
+  void postProcess();
   void emitSuccessfullyFinishedSignals() noexcept override;
   void fetchNewData() noexcept override;
 
@@ -27,6 +27,7 @@
 #include "../types/version.h"
 #include "networkaccessmanager.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -281,17 +282,41 @@ void NetworkRequestBase::replyFinishedSlot() noexcept {
   }
 
   // finalize download
+  std::function<void()> job;
   try {
     finalizeRequest();  // can throw
+    job = createPostProcessingJob();
   } catch (const Exception& e) {
     finalize(e.getMsg());
     return;
   }
 
+  // run post-processing in a worker thread to not block other requests
+  if (job) {
+    mPostProcessing.reset(new QFutureWatcher<QString>());
+    connect(mPostProcessing.data(), &QFutureWatcher<QString>::finished, this,
+            &NetworkRequestBase::postProcessingFinishedSlot);
+    mPostProcessing->setFuture(QtConcurrent::run([job]() {
+      try {
+        job();  // can throw
+        return QString();
+      } catch (const Exception& e) {
+        return e.getMsg();
+      }
+    }));
+    return;
+  }
+
   // download successfully finished!
   finalize();
 }
 
+void NetworkRequestBase::postProcessingFinishedSlot() noexcept {
+  Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
+  Q_ASSERT(mPostProcessing);
+  finalize(mPostProcessing->result());
+}
+
 void NetworkRequestBase::finalize(const QString& errorMsg) noexcept {
   Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
 
@@ -26,6 +26,8 @@
 #include <QtCore>
 #include <QtNetwork>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -185,6 +187,21 @@ signals:
 public:  // Methods
   virtual void prepareRequest() = 0;
   virtual void finalizeRequest() = 0;
+
+  /**
+   * @brief Create a job for time consuming post-processing of the reply
+   *
+   * If a job is returned, it is executed in a worker thread after
+   * #finalizeRequest() instead of the network access manager thread, so it
+   * does not block other requests meanwhile. If the job throws an exception,
+   * the request fails with its message.
+   *
+   * @return The job to run, or `nullptr` if no post-processing is needed.
+   */
+  virtual std::function<void()> createPostProcessingJob() noexcept {
+    return nullptr;
+  }
+
   virtual void emitSuccessfullyFinishedSignals() noexcept = 0;
   virtual void fetchNewData() noexcept = 0;
 
@@ -197,6 +214,7 @@ private:  // Methods
   void replyErrorSlot(QNetworkReply::NetworkError code) noexcept;
   void replySslErrorsSlot(const QList<QSslError>& errors) noexcept;
   void replyFinishedSlot() noexcept;
+  void postProcessingFinishedSlot() noexcept;
   void finalize(const QString& errorMsg = QString()) noexcept;
   static QString formatFileSize(qint64 bytes) noexcept;
   static QString getUserAgent() noexcept;
@@ -212,6 +230,7 @@ protected:  // Data
   QList<QUrl> mRedirectedUrls;
   QNetworkRequest mRequest;
   QScopedPointer<QNetworkReply> mReply;
+  QScopedPointer<QFutureWatcher<QString>> mPostProcessing;
   bool mStarted;
   bool mAborted;
   bool mErrored;
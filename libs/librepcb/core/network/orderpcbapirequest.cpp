@@ -90,11 +90,24 @@ void OrderPcbApiRequest::startUpload(const QByteArray& lppz,
     return;
   }
 
-  // Build JSON object to be uploaded.
+  // Build JSON object to be uploaded. The project is appended manually
+  // in chunks since converting it to a QString for QJsonObject would require
+  // several temporary copies (up to 6 times the size of the *.lppz), which is
+  // a lot for projects containing many 3D models.
   QJsonObject obj;
-  obj.insert("project", QString(lppz.toBase64()));
   obj.insert("board", boardPath.isEmpty() ? nullptr : boardPath);
-  QByteArray postData = QJsonDocument(obj).toJson();
+  const QByteArray head = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+  const QByteArray projectKey = ",\"project\":\"";
+  const int chunkSize = 3 * 65536;  // Multiple of 3 to avoid base64 padding.
+  QByteArray postData;
+  postData.reserve(head.size() + projectKey.size() +
+                   (((lppz.size() + 2) / 3) * 4) + 2);
+  postData.append(head.constData(), head.size() - 1);  // Without '}'.
+  postData.append(projectKey);
+  for (int i = 0; i < lppz.size(); i += chunkSize) {
+    postData.append(lppz.mid(i, chunkSize).toBase64());
+  }
+  postData.append("\"}");
 
   // Upload data to API server.
   NetworkRequest* request = new NetworkRequest(mUploadUrl, postData);
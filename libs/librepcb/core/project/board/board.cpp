@@ -31,6 +31,7 @@
 #include "../../library/pkg/footprint.h"
 #include "../../library/pkg/package.h"
 #include "../../library/pkg/packagemodel.h"
+#include "../../rulecheck/rulecheckmessage.h"
 #include "../../serialization/sexpression.h"
 #include "../../types/lengthunit.h"
 #include "../../types/pcbcolor.h"
@@ -57,6 +58,7 @@
 #include "items/bi_via.h"
 #include "items/bi_zone.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 #include <algorithm>
@@ -96,6 +98,7 @@ Board::Board(Project& project,
     mSilkscreenLayersBot({&Layer::botLegend(), &Layer::botNames()}),
     mDrcMessageApprovalsVersion(Application::getFileFormatVersion()),
     mDrcMessageApprovals(),
+    mDrcMessageApprovalsByKey(),
     mSupportedDrcMessageApprovals() {
   if (mDirectoryName.isEmpty()) {
     throw LogicError(__FILE__, __LINE__);
@@ -146,6 +149,9 @@ bool Board::isEmpty() const noexcept {
 
 QList<BI_Base*> Board::getAllItems() const noexcept {
   QList<BI_Base*> items;
+  items.reserve(mDeviceInstances.count() + mNetSegments.count() +
+                mPlanes.count() + mZones.count() + mPolygons.count() +
+                mStrokeTexts.count() + mHoles.count() + mAirWires.count());
   foreach (BI_Device* device, mDeviceInstances) items.append(device);
   foreach (BI_NetSegment* netsegment, mNetSegments) items.append(netsegment);
   foreach (BI_Plane* plane, mPlanes) items.append(plane);
@@ -307,11 +313,18 @@ void Board::loadDrcMessageApprovals(
     const Version& version, const QSet<SExpression>& approvals) noexcept {
   mDrcMessageApprovalsVersion = version;
   mDrcMessageApprovals = approvals;
+  mDrcMessageApprovalsByKey.clear();
+  foreach (const SExpression& approval, approvals) {
+    mDrcMessageApprovalsByKey.insert(
+        RuleCheckMessage::calcApprovalKey(approval), approval);
+  }
 }
 
-bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
+bool Board::updateDrcMessageApprovals(const QSet<QByteArray>& approvalKeys,
                                       bool partialRun) noexcept {
-  mSupportedDrcMessageApprovals |= approvals;
+  // Note: Matching is done by the approval keys only, since hashing and
+  // comparing the whole S-Expressions is expensive with many approvals.
+  mSupportedDrcMessageApprovals |= approvalKeys;
 
   // Don't remove obsolete approvals after a partial DRC run because we would
   // loose all approvals which don't occur during the partial run!
@@ -321,31 +334,36 @@ bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
 
   // When running the DRC the first time after a file format upgrade, remove
   // all approvals not occurring anymore to clean up obsolete approvals from
-  // the board file.
-  if (mDrcMessageApprovalsVersion < Application::getFileFormatVersion()) {
-    mDrcMessageApprovalsVersion = Application::getFileFormatVersion();
-    mDrcMessageApprovals &= approvals;
-    return true;
-  }
-
-  // Remove only approvals which disappeared during this session to avoid
-  // removing approvals added by newer minor application versions.
-  approvals =
-      mDrcMessageApprovals - (mSupportedDrcMessageApprovals - approvals);
-  if (approvals != mDrcMessageApprovals) {
-    mDrcMessageApprovals = approvals;
-    return true;
+  // the board file. Otherwise remove only approvals which disappeared during
+  // this session to avoid removing approvals added by newer minor application
+  // versions.
+  const bool upgraded =
+      (mDrcMessageApprovalsVersion < Application::getFileFormatVersion());
+  mDrcMessageApprovalsVersion = Application::getFileFormatVersion();
+  bool modified = false;
+  for (auto it = mDrcMessageApprovalsByKey.begin();
+       it != mDrcMessageApprovalsByKey.end();) {
+    if ((!approvalKeys.contains(it.key())) &&
+        (upgraded || mSupportedDrcMessageApprovals.contains(it.key()))) {
+      mDrcMessageApprovals.remove(it.value());
+      it = mDrcMessageApprovalsByKey.erase(it);
+      modified = true;
+    } else {
+      ++it;
+    }
   }
-
-  return false;
+  return modified || upgraded;
 }
 
 void Board::setDrcMessageApproved(const SExpression& approval,
                                   bool approved) noexcept {
+  const QByteArray key = RuleCheckMessage::calcApprovalKey(approval);
   if (approved) {
     mDrcMessageApprovals.insert(approval);
+    mDrcMessageApprovalsByKey.insert(key, approval);
   } else {
     mDrcMessageApprovals.remove(approval);
+    mDrcMessageApprovalsByKey.remove(key);
   }
 }
 
@@ -359,7 +377,8 @@ BI_Device* Board::getDeviceInstanceByComponentUuid(
 }
 
 void Board::addDeviceInstance(BI_Device& instance) {
-  if ((mDeviceInstances.values().contains(&instance)) ||
+  if ((mDeviceInstances.value(instance.getComponentInstanceUuid()) ==
+       &instance) ||
       (&instance.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -393,7 +412,7 @@ void Board::removeDeviceInstance(BI_Device& instance) {
  ******************************************************************************/
 
 void Board::addNetSegment(BI_NetSegment& netsegment) {
-  if ((mNetSegments.values().contains(&netsegment)) ||
+  if ((mNetSegments.value(netsegment.getUuid()) == &netsegment) ||
       (&netsegment.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -426,7 +445,8 @@ void Board::removeNetSegment(BI_NetSegment& netsegment) {
  ******************************************************************************/
 
 void Board::addPlane(BI_Plane& plane) {
-  if ((mPlanes.values().contains(&plane)) || (&plane.getBoard() != this)) {
+  if ((mPlanes.value(plane.getUuid()) == &plane) ||
+      (&plane.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
   if (mPlanes.contains(plane.getUuid())) {
@@ -482,7 +502,8 @@ QSet<const Layer*> Board::takeScheduledLayersForPlanesRebuild(
  ******************************************************************************/
 
 void Board::addZone(BI_Zone& zone) {
-  if ((mZones.values().contains(&zone)) || (&zone.getBoard() != this)) {
+  if ((mZones.value(zone.getData().getUuid()) == &zone) ||
+      (&zone.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
   if (mZones.contains(zone.getData().getUuid())) {
@@ -513,7 +534,7 @@ void Board::removeZone(BI_Zone& zone) {
  ******************************************************************************/
 
 void Board::addPolygon(BI_Polygon& polygon) {
-  if ((mPolygons.values().contains(&polygon)) ||
+  if ((mPolygons.value(polygon.getData().getUuid()) == &polygon) ||
       (&polygon.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -546,7 +567,8 @@ void Board::removePolygon(BI_Polygon& polygon) {
  ******************************************************************************/
 
 void Board::addStrokeText(BI_StrokeText& text) {
-  if ((mStrokeTexts.values().contains(&text)) || (&text.getBoard() != this)) {
+  if ((mStrokeTexts.value(text.getData().getUuid()) == &text) ||
+      (&text.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
   if (mStrokeTexts.contains(text.getData().getUuid())) {
@@ -578,7 +600,8 @@ void Board::removeStrokeText(BI_StrokeText& text) {
  ******************************************************************************/
 
 void Board::addHole(BI_Hole& hole) {
-  if ((mHoles.values().contains(&hole)) || (&hole.getBoard() != this)) {
+  if ((mHoles.value(hole.getData().getUuid()) == &hole) ||
+      (&hole.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
   if (mHoles.contains(hole.getData().getUuid())) {
@@ -609,47 +632,14 @@ void Board::removeHole(BI_Hole& hole) {
  ******************************************************************************/
 
 void Board::triggerAirWiresRebuild() noexcept {
-  if (!mIsAddedToProject) {
-    return;
-  }
-
-  try {
-    foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
-      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
-        airWire->removeFromBoard();  // can throw
-        emit airWireRemoved(*airWire);
-        delete airWire;
-      }
-
-      if (netsignal && netsignal->isAddedToCircuit()) {
-        // calculate new airwires
-        BoardAirWiresBuilder builder(*this, *netsignal);
-        QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
-            airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, *points.first, *points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.data());
-          emit airWireAdded(*airWire.take());
-        }
-      }
-    }
-    mScheduledNetSignalsForAirWireRebuild.clear();
-  } catch (const std::exception&
-               e) {  // std::exception because of the many std containers...
-    qCritical() << "Failed to build airwires:" << e.what();
-  }
+  rebuildScheduledAirWires(true);
 }
 
 void Board::forceAirWiresRebuild() noexcept {
   mScheduledNetSignalsForAirWireRebuild.unite(
       Toolbox::toSet(mProject.getCircuit().getNetSignals().values()));
   mScheduledNetSignalsForAirWireRebuild.unite(Toolbox::toSet(mAirWires.keys()));
-  triggerAirWiresRebuild();
+  rebuildScheduledAirWires(false);
 }
 
 /*******************************************************************************
@@ -856,7 +846,10 @@ void Board::addToProject() {
   }
 
   mIsAddedToProject = true;
-  forceAirWiresRebuild();
+  // Airwires are not needed by most users of a board (e.g. exports), so they
+  // are built lazily on demand instead of blocking the project loading.
+  mScheduledNetSignalsForAirWireRebuild.unite(
+      Toolbox::toSet(mProject.getCircuit().getNetSignals().values()));
   sgl.dismiss();
 }
 
@@ -997,6 +990,144 @@ void Board::save() {
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void Board::rebuildScheduledAirWires(bool async) noexcept {
+  if (!mIsAddedToProject) {
+    return;
+  }
+
+  try {
+    foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
+      if (netsignal && netsignal->isAddedToCircuit()) {
+        // take a snapshot of the net signal
+        std::shared_ptr<const BoardAirWiresBuilder> builder =
+            std::make_shared<BoardAirWiresBuilder>(*this, *netsignal);
+
+        if (async) {
+          // Keep the old airwires until the new ones are calculated to avoid
+          // flickering, but only if all their anchors still exist.
+          foreach (const BI_AirWire* airWire, mAirWires.values(netsignal)) {
+            if ((!builder->containsAnchor(&airWire->getP1())) ||
+                (!builder->containsAnchor(&airWire->getP2()))) {
+              removeAirWires(netsignal);  // can throw
+              break;
+            }
+          }
+
+          // Start the calculation, or just replace the snapshot to be
+          // calculated next if there is already one in progress.
+          AirWiresRebuildJob& job = mAirWiresRebuildJobs[netsignal->getUuid()];
+          job.latest = builder;
+          if (!job.running) {
+            startAirWiresRebuild(netsignal->getUuid());
+          }
+        } else {
+          // calculate new airwires and discard any pending rebuild
+          const BoardAirWiresBuilder::AirWires airWires =
+              builder->buildAirWires();  // can throw
+          auto it = mAirWiresRebuildJobs.find(netsignal->getUuid());
+          if (it != mAirWiresRebuildJobs.end()) {
+            it->latest.reset();
+          }
+          removeAirWires(netsignal);  // can throw
+          addAirWires(*netsignal, airWires);  // can throw
+        }
+      } else {
+        if (netsignal) {
+          auto it = mAirWiresRebuildJobs.find(netsignal->getUuid());
+          if (it != mAirWiresRebuildJobs.end()) {
+            it->latest.reset();
+          }
+        }
+        removeAirWires(netsignal);  // can throw
+      }
+    }
+    mScheduledNetSignalsForAirWireRebuild.clear();
+  } catch (const std::exception&
+               e) {  // std::exception because of the many std containers...
+    qCritical() << "Failed to build airwires:" << e.what();
+  }
+}
+
+void Board::startAirWiresRebuild(const Uuid& netSignal) noexcept {
+  typedef tl::optional<BoardAirWiresBuilder::AirWires> Result;
+
+  AirWiresRebuildJob& job = mAirWiresRebuildJobs[netSignal];
+  Q_ASSERT(job.latest && (!job.running));
+  std::shared_ptr<const BoardAirWiresBuilder> builder = job.latest;
+  job.running = builder;
+
+  QFutureWatcher<Result>* watcher = new QFutureWatcher<Result>(this);
+  auto onFinished = [this, watcher, netSignal, builder]() {
+    const Result result = watcher->result();
+    watcher->deleteLater();
+
+    auto it = mAirWiresRebuildJobs.find(netSignal);
+    if (it == mAirWiresRebuildJobs.end()) {
+      return;
+    }
+    if (it->latest != builder) {
+      // The result is outdated, calculate the latest state (if any) instead.
+      it->running.reset();
+      if (it->latest) {
+        startAirWiresRebuild(netSignal);
+      } else {
+        mAirWiresRebuildJobs.erase(it);
+      }
+      return;
+    }
+    mAirWiresRebuildJobs.erase(it);
+
+    // Don't apply the result if the net signal has been modified again in
+    // the meantime since the anchors might not exist anymore.
+    NetSignal* netsignal =
+        mProject.getCircuit().getNetSignals().value(netSignal);
+    if (result && mIsAddedToProject && netsignal &&
+        netsignal->isAddedToCircuit() &&
+        (!mScheduledNetSignalsForAirWireRebuild.contains(netsignal))) {
+      try {
+        removeAirWires(netsignal);  // can throw
+        addAirWires(*netsignal, *result);  // can throw
+      } catch (const std::exception& e) {
+        qCritical() << "Failed to add airwires:" << e.what();
+      }
+    }
+  };
+  connect(watcher, &QFutureWatcherBase::finished, this, onFinished);
+  watcher->setFuture(QtConcurrent::run([builder]() -> Result {
+    try {
+      return builder->buildAirWires();  // can throw
+    } catch (const std::exception& e) {
+      qCritical() << "Failed to build airwires:" << e.what();
+      return tl::nullopt;
+    }
+  }));
+}
+
+void Board::removeAirWires(NetSignal* netsignal) {
+  while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
+    airWire->removeFromBoard();  // can throw
+    emit airWireRemoved(*airWire);
+    delete airWire;
+  }
+}
+
+void Board::addAirWires(
+    NetSignal& netsignal,
+    const QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>&
+        airWires) {
+  foreach (const auto& points, airWires) {
+    QScopedPointer<BI_AirWire> airWire(
+        new BI_AirWire(*this, netsignal, *points.first, *points.second));
+    airWire->addToBoard();  // can throw
+    mAirWires.insertMulti(&netsignal, airWire.data());
+    emit airWireAdded(*airWire.take());
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
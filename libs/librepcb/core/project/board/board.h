@@ -46,6 +46,7 @@ class BI_Device;
 class BI_FootprintPad;
 class BI_Hole;
 class BI_NetLine;
+class BI_NetLineAnchor;
 class BI_NetPoint;
 class BI_NetSegment;
 class BI_Plane;
@@ -53,6 +54,7 @@ class BI_Polygon;
 class BI_StrokeText;
 class BI_Via;
 class BI_Zone;
+class BoardAirWiresBuilder;
 class BoardDesignRuleCheckSettings;
 class BoardDesignRules;
 class BoardFabricationOutputSettings;
@@ -172,7 +174,7 @@ public:
   }
   void loadDrcMessageApprovals(const Version& version,
                                const QSet<SExpression>& approvals) noexcept;
-  bool updateDrcMessageApprovals(QSet<SExpression> approvals,
+  bool updateDrcMessageApprovals(const QSet<QByteArray>& approvalKeys,
                                  bool partialRun) noexcept;
   void setDrcMessageApproved(const SExpression& approval,
                              bool approved) noexcept;
@@ -226,11 +228,34 @@ public:
   void removeHole(BI_Hole& hole);
 
   // AirWire Methods
-  QList<BI_AirWire*> getAirWires() const noexcept { return mAirWires.values(); }
+  const QMultiHash<NetSignal*, BI_AirWire*>& getAirWires() const noexcept {
+    return mAirWires;
+  }
+  QList<BI_AirWire*> getAirWires(const NetSignal& netsignal) const noexcept {
+    return mAirWires.values(const_cast<NetSignal*>(&netsignal));
+  }
   void scheduleAirWiresRebuild(NetSignal* netsignal) noexcept {
     mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
   }
+
+  /**
+   * @brief Rebuild the airwires of all scheduled net signals asynchronously
+   *
+   * The airwires are calculated in the thread pool and applied to the board
+   * once finished. Multiple rebuilds of the same net signal are coalesced,
+   * i.e. only the latest state of each net signal gets applied.
+   */
   void triggerAirWiresRebuild() noexcept;
+
+  /**
+   * @brief Rebuild the airwires of all net signals synchronously (blocking)
+   *
+   * Pending asynchronous rebuilds are discarded.
+   *
+   * @note  After adding the board to the project, no airwires exist until
+   *        either this method or #triggerAirWiresRebuild() is called. This
+   *        avoids building airwires if they are not needed at all.
+   */
   void forceAirWiresRebuild() noexcept;
 
   // General Methods
@@ -257,6 +282,7 @@ signals:
   void netSegmentRemoved(BI_NetSegment& netSegment);
   void planeAdded(BI_Plane& plane);
   void planeRemoved(BI_Plane& plane);
+  void planeFragmentsChanged(BI_Plane& plane);
   void zoneAdded(BI_Zone& zone);
   void zoneRemoved(BI_Zone& zone);
   void polygonAdded(BI_Polygon& polygon);
@@ -268,7 +294,21 @@ signals:
   void airWireAdded(BI_AirWire& airWire);
   void airWireRemoved(BI_AirWire& airWire);
 
-private:
+private:  // Methods
+  void rebuildScheduledAirWires(bool async) noexcept;
+  void startAirWiresRebuild(const Uuid& netSignal) noexcept;
+  void removeAirWires(NetSignal* netsignal);
+  void addAirWires(NetSignal& netsignal,
+                   const QVector<std::pair<const BI_NetLineAnchor*,
+                                           const BI_NetLineAnchor*>>& airWires);
+
+private:  // Data
+  /// Asynchronous airwire rebuild of a net signal
+  struct AirWiresRebuildJob {
+    std::shared_ptr<const BoardAirWiresBuilder> running;  ///< In progress
+    std::shared_ptr<const BoardAirWiresBuilder> latest;  ///< To be applied
+  };
+
   // General
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   const QString mDirectoryName;
@@ -279,6 +319,7 @@ private:
   QScopedPointer<BoardDesignRuleCheckSettings> mDrcSettings;
   QScopedPointer<BoardFabricationOutputSettings> mFabricationOutputSettings;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
+  QHash<Uuid, AirWiresRebuildJob> mAirWiresRebuildJobs;  ///< Only running
   QSet<const Layer*> mScheduledLayersForPlanesRebuild;
 
   // Attributes
@@ -302,8 +343,9 @@ private:
 
   // DRC
   Version mDrcMessageApprovalsVersion;
-  QSet<SExpression> mDrcMessageApprovals;
-  QSet<SExpression> mSupportedDrcMessageApprovals;
+  QSet<SExpression> mDrcMessageApprovals;  ///< Only for serialization
+  QHash<QByteArray, SExpression> mDrcMessageApprovalsByKey;
+  QSet<QByteArray> mSupportedDrcMessageApprovals;  ///< Approval keys
 
   // items
   QMap<Uuid, BI_Device*> mDeviceInstances;
@@ -25,6 +25,7 @@
 #include "../../algorithm/airwiresbuilder.h"
 #include "../../library/pkg/footprintpad.h"
 #include "../../types/layer.h"
+#include "../../utils/polygoncontainmentindex.h"
 #include "../circuit/circuit.h"
 #include "../circuit/componentsignalinstance.h"
 #include "../circuit/netsignal.h"
@@ -48,118 +49,124 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardAirWiresBuilder::BoardAirWiresBuilder(const Board& board,
-                                           const NetSignal& netsignal) noexcept
-  : mBoard(board), mNetSignal(netsignal) {
-}
-
-BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
-}
-
-/*******************************************************************************
- *  General Methods
- ******************************************************************************/
-
-QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
-    BoardAirWiresBuilder::buildAirWires() const {
-  AirWiresBuilder builder;
-
-  // Map from ID to (position, start layer number, end layer number)
-  QHash<int, std::tuple<Point, int, int>> pointLayerMap;
-
-  // Map from anchor to ID
-  QHash<const BI_NetLineAnchor*, int> anchorMap;
-
+BoardAirWiresBuilder::BoardAirWiresBuilder(
+    const Board& board, const NetSignal& netsignal) noexcept {
   // pads
-  foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
+  foreach (ComponentSignalInstance* cmpSig, netsignal.getComponentSignals()) {
     Q_ASSERT(cmpSig);
     foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
-      if (&pad->getBoard() != &mBoard) continue;
-      const Point& pos = pad->getPosition();
-      int id = builder.addPoint(pos);
+      if (&pad->getBoard() != &board) continue;
       if (pad->getLibPad().isTht()) {
-        pointLayerMap[id] =
-            std::make_tuple(pos, Layer::topCopper().getCopperNumber(),
-                            Layer::botCopper().getCopperNumber());
+        addPoint(*pad, pad->getPosition(), Layer::topCopper().getCopperNumber(),
+                 Layer::botCopper().getCopperNumber());
       } else {
-        pointLayerMap[id] =
-            std::make_tuple(pos, pad->getSmtLayer().getCopperNumber(),
-                            pad->getSmtLayer().getCopperNumber());
+        addPoint(*pad, pad->getPosition(), pad->getSmtLayer().getCopperNumber(),
+                 pad->getSmtLayer().getCopperNumber());
       }
-      anchorMap[pad] = id;
     }
   }
 
   // vias, netpoints, netlines
-  foreach (const BI_NetSegment* netsegment, mNetSignal.getBoardNetSegments()) {
+  foreach (const BI_NetSegment* netsegment, netsignal.getBoardNetSegments()) {
     Q_ASSERT(netsegment);
-    if (&netsegment->getBoard() != &mBoard) continue;
+    if (&netsegment->getBoard() != &board) continue;
     foreach (const BI_Via* via, netsegment->getVias()) {
       Q_ASSERT(via);
-      const Point& pos = via->getPosition();
-      int id = builder.addPoint(pos);
-      pointLayerMap[id] =
-          std::make_tuple(pos, via->getVia().getStartLayer().getCopperNumber(),
-                          via->getVia().getEndLayer().getCopperNumber());
-      anchorMap[via] = id;
+      addPoint(*via, via->getPosition(),
+               via->getVia().getStartLayer().getCopperNumber(),
+               via->getVia().getEndLayer().getCopperNumber());
     }
     foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
       Q_ASSERT(netpoint);
       if (const Layer* layer = netpoint->getLayerOfTraces()) {
-        Point pos = netpoint->getPosition();
-        int id = builder.addPoint(pos);
-        pointLayerMap[id] = std::make_tuple(pos, layer->getCopperNumber(),
-                                            layer->getCopperNumber());
-        anchorMap[netpoint] = id;
+        addPoint(*netpoint, netpoint->getPosition(), layer->getCopperNumber(),
+                 layer->getCopperNumber());
       }
     }
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       Q_ASSERT(netline);
-      Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
-      Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      builder.addEdge(anchorMap[&netline->getStartPoint()],
-                      anchorMap[&netline->getEndPoint()]);
+      Q_ASSERT(mAnchorIds.contains(&netline->getStartPoint()));
+      Q_ASSERT(mAnchorIds.contains(&netline->getEndPoint()));
+      mEdges.append(std::make_pair(mAnchorIds[&netline->getStartPoint()],
+                                   mAnchorIds[&netline->getEndPoint()]));
     }
   }
 
-  // determine connections made by planes
-  foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
+  // planes
+  foreach (const BI_Plane* plane, netsignal.getBoardPlanes()) {
     Q_ASSERT(plane);
-    if (&plane->getBoard() != &mBoard) continue;
+    if (&plane->getBoard() != &board) continue;
     const int planeLayer = plane->getLayer().getCopperNumber();
     foreach (const Path& fragment, plane->getFragments()) {
-      int lastId = -1;
-      for (auto it = pointLayerMap.begin(); it != pointLayerMap.end(); it++) {
-        const Point& pos = std::get<0>(it.value());
-        const int startLayer = std::get<1>(it.value());
-        const int endLayer = std::get<2>(it.value());
-        if ((planeLayer >= startLayer) && (planeLayer <= endLayer) &&
-            fragment.toQPainterPathPx().contains(pos.toPxQPointF())) {
-          if (lastId >= 0) {
-            builder.addEdge(lastId, it.key());
-          }
-          lastId = it.key();
+      mPlaneFragments.append(
+          PlaneFragmentData{planeLayer, fragment.getVertices()});
+    }
+  }
+}
+
+BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+BoardAirWiresBuilder::AirWires BoardAirWiresBuilder::buildAirWires() const {
+  AirWiresBuilder builder;
+  foreach (const PointData& point, mPoints) {
+    builder.addPoint(point.position);
+  }
+  foreach (const auto& edge, mEdges) {
+    builder.addEdge(edge.first, edge.second);
+  }
+
+  // determine connections made by planes
+  foreach (const PlaneFragmentData& fragment, mPlaneFragments) {
+    // Note: Fragments may have a huge number of vertices and nets like GND
+    // may have thousands of points, so build an index of the fragment once
+    // to test each point only against the few edges nearby.
+    const PolygonContainmentIndex fragmentIndex(fragment.vertices);
+    int lastId = -1;
+    for (int id = 0; id < mPoints.count(); ++id) {
+      const PointData& point = mPoints.at(id);
+      if ((fragment.layer >= point.startLayer) &&
+          (fragment.layer <= point.endLayer) &&
+          fragmentIndex.contains(point.position)) {
+        if (lastId >= 0) {
+          builder.addEdge(lastId, id);
         }
+        lastId = id;
       }
     }
   }
 
   // Calculate the airwires and convert them back to the result type.
   const AirWiresBuilder::AirWires airWireIds = builder.buildAirWires();
-  QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>> result;
+  AirWires result;
   result.reserve(airWireIds.size());
   foreach (const AirWiresBuilder::AirWire& airWire, airWireIds) {
-    const BI_NetLineAnchor* p1 = anchorMap.key(airWire.first, nullptr);
-    const BI_NetLineAnchor* p2 = anchorMap.key(airWire.second, nullptr);
-    if ((!p1) || (!p2)) {
+    if ((airWire.first < 0) || (airWire.first >= mPoints.count()) ||
+        (airWire.second < 0) || (airWire.second >= mPoints.count())) {
       throw LogicError(__FILE__, __LINE__, "Unknown air wire IDs received.");
     }
-    result.append(std::make_pair(p1, p2));
+    result.append(std::make_pair(mPoints.at(airWire.first).anchor,
+                                 mPoints.at(airWire.second).anchor));
   }
 
   return result;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardAirWiresBuilder::addPoint(const BI_NetLineAnchor& anchor,
+                                    const Point& pos, int startLayer,
+                                    int endLayer) noexcept {
+  mAnchorIds[&anchor] = mPoints.count();
+  mPoints.append(PointData{&anchor, pos, startLayer, endLayer});
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
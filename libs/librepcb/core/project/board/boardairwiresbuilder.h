@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../geometry/path.h"
 #include "../../types/point.h"
 
 #include <QtCore>
@@ -42,25 +43,57 @@ class NetSignal;
 
 /**
  * @brief The BoardAirWiresBuilder class
+ *
+ * The constructor takes a snapshot of all the data of a net signal needed to
+ * calculate its airwires. Afterwards the board is not accessed anymore, so
+ * #buildAirWires() can be called from any thread, e.g. to calculate the
+ * airwires in the background while the board is modified. The returned
+ * anchors are not dereferenced by this class.
  */
 class BoardAirWiresBuilder final {
 public:
+  // Types
+  typedef std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*> AirWire;
+  typedef QVector<AirWire> AirWires;
+
   // Constructors / Destructor
   BoardAirWiresBuilder() = delete;
   BoardAirWiresBuilder(const BoardAirWiresBuilder& other) = delete;
   BoardAirWiresBuilder(const Board& board, const NetSignal& netsignal) noexcept;
   ~BoardAirWiresBuilder() noexcept;
 
+  // Getters
+  bool containsAnchor(const BI_NetLineAnchor* anchor) const noexcept {
+    return mAnchorIds.contains(anchor);
+  }
+
   // General Methods
-  QVector<std::pair<const BI_NetLineAnchor*, const BI_NetLineAnchor*>>
-      buildAirWires() const;
+  AirWires buildAirWires() const;
 
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
 
+private:  // Methods
+  void addPoint(const BI_NetLineAnchor& anchor, const Point& pos,
+                int startLayer, int endLayer) noexcept;
+
 private:  // Data
-  const Board& mBoard;
-  const NetSignal& mNetSignal;
+  struct PointData {
+    const BI_NetLineAnchor* anchor;
+    Point position;
+    int startLayer;
+    int endLayer;
+  };
+
+  struct PlaneFragmentData {
+    int layer;
+    QVector<Vertex> vertices;  ///< Not a Path to avoid sharing its cache
+  };
+
+  QVector<PointData> mPoints;  ///< The index is the ID of the point
+  QHash<const BI_NetLineAnchor*, int> mAnchorIds;
+  QVector<std::pair<int, int>> mEdges;
+  QVector<PlaneFragmentData> mPlaneFragments;
 };
 
 /*******************************************************************************
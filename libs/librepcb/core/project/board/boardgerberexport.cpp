@@ -32,6 +32,7 @@
 #include "../../library/pkg/footprintpad.h"
 #include "../../library/pkg/package.h"
 #include "../../library/pkg/packagepad.h"
+#include "../../utils/concurrency.h"
 #include "../../utils/transform.h"
 #include "../circuit/componentinstance.h"
 #include "../circuit/componentsignalinstance.h"
@@ -51,6 +52,7 @@
 #include "items/bi_stroketext.h"
 #include "items/bi_via.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -65,6 +67,14 @@ static bool operator<(const BoardGerberExport::LayerPair& lhs,
       ((lhs.first == rhs.first) && (Layer::lessThan(lhs.second, rhs.second)));
 }
 
+// Drill files of several settings profiles have the same content if they only
+// differ in the file paths.
+static QString drillsContentKey(
+    const QString& name,
+    const BoardFabricationOutputSettings& settings) noexcept {
+  return name % (settings.getUseG85SlotCommand() ? "-g85" : "");
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -74,11 +84,13 @@ BoardGerberExport::BoardGerberExport(const Board& board) noexcept
     mBoard(board),
     mRemoveObsoleteFiles(true),
     mBeforeWriteCallback(),
+    mWriteCallback(),
     mCreationDateTime(QDateTime::currentDateTime()),
     mProjectName(*mProject.getName()),
     mCurrentInnerCopperLayer(0),
     mCurrentStartLayer(nullptr),
-    mCurrentEndLayer(nullptr) {
+    mCurrentEndLayer(nullptr),
+    mParallelExport(true) {
   // If the project contains multiple boards, add the board name to the
   // Gerber file metadata as well to distinguish between the different boards.
   if (mProject.getBoards().count() > 1) {
@@ -111,33 +123,238 @@ void BoardGerberExport::setBeforeWriteCallback(BeforeWriteCallback cb) {
   mBeforeWriteCallback = cb;
 }
 
+void BoardGerberExport::setWriteCallback(WriteCallback cb) {
+  mWriteCallback = cb;
+}
+
+void BoardGerberExport::setParallelExport(bool parallel) noexcept {
+  mParallelExport = parallel;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
 void BoardGerberExport::exportPcbLayers(
     const BoardFabricationOutputSettings& settings) const {
+  exportPcbLayers(QVector<BoardFabricationOutputSettings>{settings});
+}
+
+void BoardGerberExport::exportPcbLayers(
+    const QVector<BoardFabricationOutputSettings>& settings) const {
   mWrittenFiles.clear();
 
-  exportDrillsMerged(settings);
-  exportDrillsNpth(settings);
-  exportDrillsPth(settings);
-  exportDrillsBlindBuried(settings);
-  exportLayerBoardOutlines(settings);
-  exportLayerTopCopper(settings);
-  exportLayerInnerCopper(settings);
-  exportLayerBottomCopper(settings);
-  exportLayerTopSolderMask(settings);
-  exportLayerBottomSolderMask(settings);
-  exportLayerTopSilkscreen(settings);
-  exportLayerBottomSilkscreen(settings);
-  exportLayerTopSolderPaste(settings);
-  exportLayerBottomSolderPaste(settings);
+  // Determine all files to write or remove (in a deterministic order).
+  // The holes are collected only once for all drill files.
+  const DrillList drills = collectDrills();
+  QVector<OutputFile> files;
+  for (const BoardFabricationOutputSettings& s : settings) {
+    exportDrillsMerged(s, drills, files);  // can throw
+    exportDrillsNpth(s, drills, files);  // can throw
+    exportDrillsPth(s, drills, files);  // can throw
+    exportDrillsBlindBuried(s, drills, files);  // can throw
+    exportLayerBoardOutlines(s, files);  // can throw
+    exportLayerTopCopper(s, files);  // can throw
+    exportLayerInnerCopper(s, files);  // can throw
+    exportLayerBottomCopper(s, files);  // can throw
+    exportLayerTopSolderMask(s, files);  // can throw
+    exportLayerBottomSolderMask(s, files);  // can throw
+    exportLayerTopSilkscreen(s, files);  // can throw
+    exportLayerBottomSilkscreen(s, files);  // can throw
+    exportLayerTopSolderPaste(s, files);  // can throw
+    exportLayerBottomSolderPaste(s, files);  // can throw
+  }
+
+  // Files with the same content key (e.g. the copper layers of different
+  // settings profiles) are generated only once.
+  QVector<int> sources(files.count(), -1);  // Index of the generated file
+  QHash<QString, int> generatedKeys;
+  for (int i = 0; i < files.count(); ++i) {
+    if (files.at(i).generate) {
+      auto it = generatedKeys.find(files.at(i).contentKey);
+      if (it == generatedKeys.end()) {
+        it = generatedKeys.insert(files.at(i).contentKey, i);
+      }
+      sources[i] = *it;
+    }
+  }
+
+  // Generate the file contents. Since the generators only read from the
+  // board, they can run concurrently.
+  QVector<QByteArray> contents(files.count());
+  if (mParallelExport) {
+    // Make sure all workers have finished before leaving this scope since they
+    // access the contents and the board.
+    QVector<QFuture<void>> futures;
+    auto futuresGuard = Concurrency::waitOnScopeExit(futures);
+    for (int i = 0; i < files.count(); ++i) {
+      if (sources.at(i) == i) {
+        const std::function<QByteArray()> generate = files.at(i).generate;
+        QByteArray* content = &contents[i];
+        futures.append(QtConcurrent::run(
+            [generate, content]() { *content = generate(); }));
+      }
+    }
+    for (QFuture<void>& future : futures) {
+      future.waitForFinished();  // can throw
+    }
+  } else {
+    for (int i = 0; i < files.count(); ++i) {
+      if (sources.at(i) == i) {
+        contents[i] = files.at(i).generate();  // can throw
+      }
+    }
+  }
+
+  // Write the files in the same order as they were determined, thus the
+  // output is always the same, no matter in which order they were generated.
+  for (int i = 0; i < files.count(); ++i) {
+    const FilePath& fp = files.at(i).filePath;
+    if (files.at(i).generate) {
+      writeFile(fp, contents.at(sources.at(i)));  // can throw
+    } else if (fp.isExistingFile() && (!mWrittenFiles.contains(fp))) {
+      FileUtils::removeFile(fp);  // can throw
+    }
+  }
 }
 
 void BoardGerberExport::exportComponentLayer(BoardSide side,
                                              const Uuid& assemblyVariant,
                                              const FilePath& filePath) const {
+  exportComponentLayers({ComponentLayer{side, assemblyVariant, filePath}});
+}
+
+void BoardGerberExport::exportComponentLayers(
+    const QVector<ComponentLayer>& layers) const {
+  // The outlines and pins of the devices do not depend on the assembly
+  // variant, thus collect them only once for all files.
+  const QVector<ComponentData> components = collectComponents();
+
+  // Generate the file contents. Since the generators only read from the
+  // board, they can run concurrently.
+  QVector<QByteArray> contents(layers.count());
+  if (mParallelExport && (layers.count() > 1)) {
+    // Make sure all workers have finished before leaving this scope since they
+    // access the contents and the board.
+    QVector<QFuture<void>> futures;
+    auto futuresGuard = Concurrency::waitOnScopeExit(futures);
+    for (int i = 0; i < layers.count(); ++i) {
+      const ComponentLayer layer = layers.at(i);
+      QByteArray* content = &contents[i];
+      futures.append(QtConcurrent::run([this, layer, &components, content]() {
+        *content = generateComponentLayer(layer.side, layer.assemblyVariant,
+                                          components);
+      }));
+    }
+    for (QFuture<void>& future : futures) {
+      future.waitForFinished();  // can throw
+    }
+  } else {
+    for (int i = 0; i < layers.count(); ++i) {
+      contents[i] = generateComponentLayer(
+          layers.at(i).side, layers.at(i).assemblyVariant, components);
+    }
+  }
+
+  // Write the files in the given order, no matter in which order they were
+  // generated.
+  for (int i = 0; i < layers.count(); ++i) {
+    writeFile(layers.at(i).filePath, contents.at(i));  // can throw
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QVector<BoardGerberExport::ComponentData>
+    BoardGerberExport::collectComponents() const {
+  QVector<ComponentData> components;
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    ComponentData data;
+    data.device = device;
+    data.side = device->getMirrored() ? BoardSide::Bottom : BoardSide::Top;
+
+    // Determine assembly type.
+    const Package::AssemblyType assemblyType =
+        device->getLibPackage().getAssemblyType(true);
+    data.mountable = (assemblyType != Package::AssemblyType::None);
+    data.mountType = GerberGenerator::MountType::Other;
+    switch (assemblyType) {
+      case Package::AssemblyType::None:
+        break;
+      case Package::AssemblyType::Tht:
+      case Package::AssemblyType::Mixed:  // Does this make sense?!
+        data.mountType = GerberGenerator::MountType::Tht;
+        break;
+      case Package::AssemblyType::Smt:
+        data.mountType = GerberGenerator::MountType::Smt;
+        break;
+      case Package::AssemblyType::Other:
+        data.mountType = GerberGenerator::MountType::Other;
+        break;
+      default:
+        qWarning() << "Unknown assembly type:"
+                   << static_cast<int>(assemblyType);
+        break;
+    }
+
+    data.designator = *device->getComponentInstance().getName();
+    // Note: Always use english locale to make PnP files portable.
+    data.footprintName = *device->getLibPackage().getNames().getDefaultValue();
+
+    // Component body outlines.
+    const Layer& outlinesLayer = (data.side == BoardSide::Top)
+        ? Layer::topPackageOutlines()
+        : Layer::botPackageOutlines();
+    foreach (const Path& p, getComponentOutlines(*device, outlinesLayer)) {
+      data.outlines.append(std::make_pair(
+          GerberAttribute::ApertureFunction::ComponentOutlineBody, p));
+    }
+    if (data.outlines.isEmpty()) {
+      // Many packages probably don't have an explicit package outline, thus
+      // using the documentation layer as a fallback.
+      const Layer& documentationLayer = (data.side == BoardSide::Top)
+          ? Layer::topDocumentation()
+          : Layer::botDocumentation();
+      foreach (const Path& p,
+               getComponentOutlines(*device, documentationLayer)) {
+        data.outlines.append(std::make_pair(
+            GerberAttribute::ApertureFunction::ComponentOutlineBody, p));
+      }
+    }
+    const Layer& courtyardLayer = (data.side == BoardSide::Top)
+        ? Layer::topCourtyard()
+        : Layer::botCourtyard();
+    foreach (const Path& p, getComponentOutlines(*device, courtyardLayer)) {
+      data.outlines.append(std::make_pair(
+          GerberAttribute::ApertureFunction::ComponentOutlineCourtyard, p));
+    }
+
+    // Component pins.
+    foreach (const BI_FootprintPad* pad, device->getPads()) {
+      if (pad->getLibPad().getFunctionIsFiducial()) {
+        continue;
+      }
+      ComponentPin pin;
+      pin.position = pad->getPosition();
+      if (const PackagePad* pkgPad = pad->getLibPackagePad()) {
+        pin.name = *pkgPad->getName();
+      }
+      if (ComponentSignalInstance* cmpSig = pad->getComponentSignalInstance()) {
+        pin.signal = *cmpSig->getCompSignal().getName();
+      }
+      pin.isPin1 = (pin.name == "1");  // Very sophisticated algorithm ;-)
+      data.pins.append(pin);
+    }
+    components.append(data);
+  }
+  return components;
+}
+
+QByteArray BoardGerberExport::generateComponentLayer(
+    BoardSide side, const Uuid& assemblyVariant,
+    const QVector<ComponentData>& components) const {
   GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
                       *mProject.getVersion());
   if (side == BoardSide::Top) {
@@ -160,106 +377,43 @@ void BoardGerberExport::exportComponentLayer(BoardSide side,
   }
 
   // Export all components on the selected board side.
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    if (device->getMirrored() == (side == BoardSide::Bottom)) {
-      auto part = device->getParts(assemblyVariant).value(0);
-      if (!part) {
-        continue;  // Do not mount.
-      }
-
-      // Determine assembly type.
-      const Package::AssemblyType assemblyType =
-          device->getLibPackage().getAssemblyType(true);
-      GerberGenerator::MountType mountType = GerberGenerator::MountType::Other;
-      switch (assemblyType) {
-        case Package::AssemblyType::None:
-          qWarning()
-              << "Exported device with non-mountable package to Gerber X3:"
-              << *device->getComponentInstance().getName();
-          break;
-        case Package::AssemblyType::Tht:
-        case Package::AssemblyType::Mixed:  // Does this make sense?!
-          mountType = GerberGenerator::MountType::Tht;
-          break;
-        case Package::AssemblyType::Smt:
-          mountType = GerberGenerator::MountType::Smt;
-          break;
-        case Package::AssemblyType::Other:
-          mountType = GerberGenerator::MountType::Other;
-          break;
-        default:
-          qWarning() << "Unknown assembly type:"
-                     << static_cast<int>(assemblyType);
-          break;
-      }
+  for (const ComponentData& data : components) {
+    if (data.side != side) {
+      continue;
+    }
+    auto part = data.device->getPart(assemblyVariant);
+    if (!part) {
+      continue;  // Do not mount.
+    }
+    if (!data.mountable) {
+      qWarning() << "Exported device with non-mountable package to Gerber X3:"
+                 << data.designator;
+    }
 
-      // Export component center and attributes.
-      ProjectAttributeLookup lookup(*device, part);
-      const Angle rotation = device->getRotation();
-      const QString designator = *device->getComponentInstance().getName();
-      const QString value =
-          AttributeSubstitutor::substitute(lookup("VALUE"), lookup).trimmed();
-      const QString mpn = lookup("MPN").simplified();
-      const QString manufacturer = lookup("MANUFACTURER").simplified();
-
-      // Note: Always use english locale to make PnP files portable.
-      const QString footprintName =
-          *device->getLibPackage().getNames().getDefaultValue();
-      gen.flashComponent(device->getPosition(), rotation, designator, value,
-                         mountType, manufacturer, mpn, footprintName);
-
-      // Export component body outlines.
-      QVector<std::pair<GerberAttribute::ApertureFunction, Path>> outlines;
-      const Layer& outlinesLayer = (side == BoardSide::Top)
-          ? Layer::topPackageOutlines()
-          : Layer::botPackageOutlines();
-      foreach (const Path& p, getComponentOutlines(*device, outlinesLayer)) {
-        outlines.append(std::make_pair(
-            GerberAttribute::ApertureFunction::ComponentOutlineBody, p));
-      }
-      if (outlines.isEmpty()) {
-        // Many packages probably don't have an explicit package outline, thus
-        // using the documentation layer as a fallback.
-        const Layer& documentationLayer = (side == BoardSide::Top)
-            ? Layer::topDocumentation()
-            : Layer::botDocumentation();
-        foreach (const Path& p,
-                 getComponentOutlines(*device, documentationLayer)) {
-          outlines.append(std::make_pair(
-              GerberAttribute::ApertureFunction::ComponentOutlineBody, p));
-        }
-      }
-      const Layer& courtyardLayer = (side == BoardSide::Top)
-          ? Layer::topCourtyard()
-          : Layer::botCourtyard();
-      foreach (const Path& p, getComponentOutlines(*device, courtyardLayer)) {
-        outlines.append(std::make_pair(
-            GerberAttribute::ApertureFunction::ComponentOutlineCourtyard, p));
-      }
-      for (const auto& pair : outlines) {
-        gen.drawComponentOutline(pair.second, rotation, designator, value,
-                                 mountType, manufacturer, mpn, footprintName,
-                                 pair.first);
-      }
+    // Export component center and attributes.
+    ProjectAttributeLookup lookup(*data.device, part);
+    const Angle rotation = data.device->getRotation();
+    const QString value =
+        AttributeSubstitutor::substitute(lookup("VALUE"), lookup).trimmed();
+    const QString mpn = lookup("MPN").simplified();
+    const QString manufacturer = lookup("MANUFACTURER").simplified();
+    gen.flashComponent(data.device->getPosition(), rotation, data.designator,
+                       value, data.mountType, manufacturer, mpn,
+                       data.footprintName);
+
+    // Export component body outlines.
+    for (const auto& pair : data.outlines) {
+      gen.drawComponentOutline(pair.second, rotation, data.designator, value,
+                               data.mountType, manufacturer, mpn,
+                               data.footprintName, pair.first);
+    }
 
-      // Export component pins.
-      foreach (const BI_FootprintPad* pad, device->getPads()) {
-        if (pad->getLibPad().getFunctionIsFiducial()) {
-          continue;
-        }
-        QString pinName, pinSignal;
-        if (const PackagePad* pkgPad = pad->getLibPackagePad()) {
-          pinName = *pkgPad->getName();
-        }
-        if (ComponentSignalInstance* cmpSig =
-                pad->getComponentSignalInstance()) {
-          pinSignal = *cmpSig->getCompSignal().getName();
-        }
-        bool isPin1 = (pinName == "1");  // Very sophisticated algorithm ;-)
-        gen.flashComponentPin(pad->getPosition(), rotation, designator, value,
-                              mountType, manufacturer, mpn, footprintName,
-                              pinName, pinSignal, isPin1);
-      }
+    // Export component pins.
+    for (const ComponentPin& pin : data.pins) {
+      gen.flashComponentPin(pin.position, rotation, data.designator, value,
+                            data.mountType, manufacturer, mpn,
+                            data.footprintName, pin.name, pin.signal,
+                            pin.isPin1);
     }
   }
 
@@ -289,43 +443,36 @@ void BoardGerberExport::exportComponentLayer(BoardSide side,
   }
 
   gen.generate();
-  trackFileBeforeWrite(filePath);  // can throw
-  gen.saveToFile(filePath);
+  return gen.toByteArray();
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
-
 void BoardGerberExport::exportDrillsMerged(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings, const DrillList& drills,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrills());
   if (settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Mixed);
-    drawPthDrills(*gen);
-    drawNpthDrills(*gen);
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generate = [this, &settings, &drills]() {
+      std::unique_ptr<ExcellonGenerator> gen = createExcellonGenerator(
+          settings, ExcellonGenerator::Plating::Mixed);
+      drawDrills(*gen, drills.pth);
+      drawDrills(*gen, drills.npth);
+      gen->generate();
+      return gen->toByteArray();
+    };
+    files.append(
+        OutputFile{fp, drillsContentKey("drills", settings), generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
 }
 
 void BoardGerberExport::exportDrillsNpth(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings, const DrillList& drills,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrillsNpth());
   if (!settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::No);
-    drawNpthDrills(*gen);
-
     // Note that separate NPTH drill files could lead to issues with some PCB
     // manufacturers, even if it's empty in many cases. However, we generate the
     // NPTH file even if there are no NPTH drills since it could also lead to
@@ -333,270 +480,283 @@ void BoardGerberExport::exportDrillsNpth(
     // https://github.com/LibrePCB/LibrePCB/issues/998. If the PCB manufacturer
     // doesn't support a separate NPTH file, the user shall enable the
     // "merge PTH and NPTH drills"  option.
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generate = [this, &settings, &drills]() {
+      std::unique_ptr<ExcellonGenerator> gen =
+          createExcellonGenerator(settings, ExcellonGenerator::Plating::No);
+      drawDrills(*gen, drills.npth);
+      gen->generate();
+      return gen->toByteArray();
+    };
+    files.append(
+        OutputFile{fp, drillsContentKey("drills-npth", settings), generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
 }
 
 void BoardGerberExport::exportDrillsPth(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings, const DrillList& drills,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrillsPth());
   if (!settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Yes);
-    drawPthDrills(*gen);
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generate = [this, &settings, &drills]() {
+      std::unique_ptr<ExcellonGenerator> gen =
+          createExcellonGenerator(settings, ExcellonGenerator::Plating::Yes);
+      drawDrills(*gen, drills.pth);
+      gen->generate();
+      return gen->toByteArray();
+    };
+    files.append(
+        OutputFile{fp, drillsContentKey("drills-pth", settings), generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
 }
 
 void BoardGerberExport::exportDrillsBlindBuried(
-    const BoardFabricationOutputSettings& settings) const {
-  auto vias = getBlindBuriedVias();
-  for (auto it = vias.begin(); it != vias.end(); it++) {
+    const BoardFabricationOutputSettings& settings, const DrillList& drills,
+    QVector<OutputFile>& files) const {
+  for (auto it = drills.blindBuried.begin(); it != drills.blindBuried.end();
+       it++) {
     mCurrentStartLayer = it.key().first;
     mCurrentEndLayer = it.key().second;
     const FilePath fp = getOutputFilePath(
         settings.getOutputBasePath() % settings.getSuffixDrillsBlindBuried());
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Yes);
-    foreach (const BI_Via* via, it.value()) {
-      gen->drill(via->getPosition(), via->getDrillDiameter(), true,
-                 ExcellonGenerator::Function::ViaDrill);
-    }
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
+    const QVector<Drill>* layerPairDrills = &it.value();
+    auto generate = [this, &settings, layerPairDrills]() {
+      std::unique_ptr<ExcellonGenerator> gen =
+          createExcellonGenerator(settings, ExcellonGenerator::Plating::Yes);
+      drawDrills(*gen, *layerPairDrills);
+      gen->generate();
+      return gen->toByteArray();
+    };
+    const QString key = QString("drills-%1-%2")
+                            .arg(it.key().first->getId())
+                            .arg(it.key().second->getId());
+    files.append(OutputFile{fp, drillsContentKey(key, settings), generate});
   }
+  mCurrentStartLayer = nullptr;
+  mCurrentEndLayer = nullptr;
 }
 
 void BoardGerberExport::exportLayerBoardOutlines(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixOutlines());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionOutlines(false);
-  drawLayer(gen, Layer::boardOutlines());
-  drawLayer(gen, Layer::boardCutouts());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto generate = [this]() {
+    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                        *mProject.getVersion());
+    gen.setFileFunctionOutlines(false);
+    drawLayer(gen, Layer::boardOutlines());
+    drawLayer(gen, Layer::boardCutouts());
+    gen.generate();
+    return gen.toByteArray();
+  };
+  files.append(OutputFile{fp, "outlines", generate});
 }
 
 void BoardGerberExport::exportLayerTopCopper(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixCopperTop());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
-                            GerberGenerator::Polarity::Positive);
-  drawLayer(gen, Layer::topCopper());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto generate = [this]() {
+    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                        *mProject.getVersion());
+    gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
+                              GerberGenerator::Polarity::Positive);
+    drawLayer(gen, Layer::topCopper());
+    gen.generate();
+    return gen.toByteArray();
+  };
+  files.append(OutputFile{fp, "copper-top", generate});
 }
 
 void BoardGerberExport::exportLayerBottomCopper(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixCopperBot());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionCopper(mBoard.getInnerLayerCount() + 2,
-                            GerberGenerator::CopperSide::Bottom,
-                            GerberGenerator::Polarity::Positive);
-  drawLayer(gen, Layer::botCopper());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto generate = [this]() {
+    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                        *mProject.getVersion());
+    gen.setFileFunctionCopper(mBoard.getInnerLayerCount() + 2,
+                              GerberGenerator::CopperSide::Bottom,
+                              GerberGenerator::Polarity::Positive);
+    drawLayer(gen, Layer::botCopper());
+    gen.generate();
+    return gen.toByteArray();
+  };
+  files.append(OutputFile{fp, "copper-bot", generate});
 }
 
 void BoardGerberExport::exportLayerInnerCopper(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   for (int i = 1; i <= mBoard.getInnerLayerCount(); ++i) {
     mCurrentInnerCopperLayer = i;  // used for attribute provider
     FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                     settings.getSuffixCopperInner());
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionCopper(i + 1, GerberGenerator::CopperSide::Inner,
-                              GerberGenerator::Polarity::Positive);
-    if (const Layer* layer = Layer::innerCopper(i)) {
-      drawLayer(gen, *layer);
-    } else {
+    const Layer* layer = Layer::innerCopper(i);
+    if (!layer) {
       throw LogicError(__FILE__, __LINE__, "Unknown inner copper layer.");
     }
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
+    auto generate = [this, i, layer]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionCopper(i + 1, GerberGenerator::CopperSide::Inner,
+                                GerberGenerator::Polarity::Positive);
+      drawLayer(gen, *layer);
+      gen.generate();
+      return gen.toByteArray();
+    };
+    files.append(OutputFile{fp, QString("copper-in%1").arg(i), generate});
   }
   mCurrentInnerCopperLayer = 0;
 }
 
 void BoardGerberExport::exportLayerTopSolderMask(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderMaskTop());
   if (mBoard.getSolderResist()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
-                                  GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::topStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generate = [this]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
+                                    GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::topStopMask());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    files.append(OutputFile{fp, "mask-top", generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerBottomSolderMask(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderMaskBot());
   if (mBoard.getSolderResist()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
-                                  GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::botStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generate = [this]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
+                                    GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::botStopMask());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    files.append(OutputFile{fp, "mask-bot", generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerTopSilkscreen(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSilkscreenTop());
   const QVector<const Layer*>& layers = mBoard.getSilkscreenLayersTop();
   if (layers.count() > 0) {  // don't export silkscreen if no layers selected
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
-                              GerberGenerator::Polarity::Positive);
-    foreach (const Layer* layer, layers) {
-      drawLayer(gen, *layer);
-    }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::topStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generate = [this, layers]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
+                                GerberGenerator::Polarity::Positive);
+      foreach (const Layer* layer, layers) {
+        drawLayer(gen, *layer);
+      }
+      gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::topStopMask());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    files.append(OutputFile{fp, "silkscreen-top", generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerBottomSilkscreen(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSilkscreenBot());
   const QVector<const Layer*>& layers = mBoard.getSilkscreenLayersBot();
   if (layers.count() > 0) {  // don't export silkscreen if no layers selected
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
-                              GerberGenerator::Polarity::Positive);
-    foreach (const Layer* layer, layers) {
-      drawLayer(gen, *layer);
-    }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::botStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generate = [this, layers]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
+                                GerberGenerator::Polarity::Positive);
+      foreach (const Layer* layer, layers) {
+        drawLayer(gen, *layer);
+      }
+      gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::botStopMask());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    files.append(OutputFile{fp, "silkscreen-bot", generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerTopSolderPaste(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderPasteTop());
   if (settings.getEnableSolderPasteTop()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionPaste(GerberGenerator::BoardSide::Top,
-                             GerberGenerator::Polarity::Positive);
-    drawLayer(gen, Layer::topSolderPaste());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generate = [this]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionPaste(GerberGenerator::BoardSide::Top,
+                               GerberGenerator::Polarity::Positive);
+      drawLayer(gen, Layer::topSolderPaste());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    files.append(OutputFile{fp, "paste-top", generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerBottomSolderPaste(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QVector<OutputFile>& files) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderPasteBot());
   if (settings.getEnableSolderPasteBot()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
-                             GerberGenerator::Polarity::Positive);
-    drawLayer(gen, Layer::botSolderPaste());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
-  }
-}
-
-int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
-  int count = 0;
-
-  // footprint holes
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    const Transform transform(*device);
-    for (const Hole& hole : device->getLibFootprint().getHoles()) {
-      gen.drill(transform.map(hole.getPath()), hole.getDiameter(), false,
-                ExcellonGenerator::Function::MechanicalDrill);
-      ++count;
-    }
-  }
-
-  // board holes
-  foreach (const BI_Hole* hole, mBoard.getHoles()) {
-    gen.drill(hole->getData().getPath(), hole->getData().getDiameter(), false,
-              ExcellonGenerator::Function::MechanicalDrill);
-    ++count;
+    auto generate = [this]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
+                               GerberGenerator::Polarity::Positive);
+      drawLayer(gen, Layer::botSolderPaste());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    files.append(OutputFile{fp, "paste-bot", generate});
+  } else if (mRemoveObsoleteFiles) {
+    files.append(OutputFile{fp, QString(), nullptr});
   }
-
-  return count;
 }
 
-int BoardGerberExport::drawPthDrills(ExcellonGenerator& gen) const {
-  int count = 0;
+BoardGerberExport::DrillList BoardGerberExport::collectDrills() const {
+  DrillList drills;
 
-  // footprint pads
+  // Footprint pads and holes.
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
     foreach (const BI_FootprintPad* pad, device->getPads()) {
       const FootprintPad& libPad = pad->getLibPad();
@@ -606,40 +766,40 @@ int BoardGerberExport::drawPthDrills(ExcellonGenerator& gen) const {
           ? ExcellonGenerator::Function::ComponentDrillPressFit
           : ExcellonGenerator::Function::ComponentDrill;
       for (const PadHole& hole : libPad.getHoles()) {
-        gen.drill(transform.map(hole.getPath()), hole.getDiameter(), true,
-                  function);  // can throw
-        ++count;
+        drills.pth.append(Drill{transform.map(hole.getPath()),
+                                hole.getDiameter(), true, function});
       }
     }
-  }
-
-  // vias
-  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
-    foreach (const BI_Via* via, netsegment->getVias()) {
-      if (via->getVia().isThrough()) {
-        gen.drill(via->getPosition(), via->getDrillDiameter(), true,
-                  ExcellonGenerator::Function::ViaDrill);
-        ++count;
-      }
+    const Transform transform(*device);
+    for (const Hole& hole : device->getLibFootprint().getHoles()) {
+      drills.npth.append(Drill{transform.map(hole.getPath()),
+                               hole.getDiameter(), false,
+                               ExcellonGenerator::Function::MechanicalDrill});
     }
   }
 
-  return count;
-}
+  // Board holes.
+  foreach (const BI_Hole* hole, mBoard.getHoles()) {
+    drills.npth.append(Drill{hole->getData().getPath(),
+                             hole->getData().getDiameter(), false,
+                             ExcellonGenerator::Function::MechanicalDrill});
+  }
 
-QMap<BoardGerberExport::LayerPair, QList<const BI_Via*>>
-    BoardGerberExport::getBlindBuriedVias() const {
-  QMap<LayerPair, QList<const BI_Via*>> result;
+  // Vias.
   foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
     foreach (const BI_Via* via, netsegment->getVias()) {
-      if (via->getVia().isBlind() || via->getVia().isBuried()) {
-        if (auto span = via->getDrillLayerSpan()) {
-          result[*span].append(via);
-        }
+      const Drill drill{NonEmptyPath(Path({Vertex(via->getPosition())})),
+                        via->getDrillDiameter(), true,
+                        ExcellonGenerator::Function::ViaDrill};
+      if (via->getVia().isThrough()) {
+        drills.pth.append(drill);
+      } else if (auto span = via->getDrillLayerSpan()) {
+        drills.blindBuried[*span].append(drill);
       }
     }
   }
-  return result;
+
+  return drills;
 }
 
 void BoardGerberExport::drawLayer(GerberGenerator& gen,
@@ -1089,17 +1249,30 @@ QString BoardGerberExport::getAttributeValue(
   }
 }
 
-void BoardGerberExport::trackFileBeforeWrite(const FilePath& fp) const {
+void BoardGerberExport::writeFile(const FilePath& fp,
+                                  const QByteArray& content) const {
   if (mBeforeWriteCallback) {
     mBeforeWriteCallback(fp);  // can throw
   }
   mWrittenFiles.append(fp);
+  if (mWriteCallback) {
+    mWriteCallback(fp, content);  // can throw
+  } else {
+    FileUtils::writeFile(fp, content);  // can throw
+  }
 }
 
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
 
+void BoardGerberExport::drawDrills(ExcellonGenerator& gen,
+                                   const QVector<Drill>& drills) noexcept {
+  for (const Drill& drill : drills) {
+    gen.drill(drill.path, drill.diameter, drill.plated, drill.function);
+  }
+}
+
 UnsignedLength BoardGerberExport::calcWidthOfLayer(
     const UnsignedLength& width, const Layer& layer) noexcept {
   if ((layer.isBoardEdge()) && (width < UnsignedLength(1000))) {
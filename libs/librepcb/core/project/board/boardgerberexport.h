@@ -65,6 +65,15 @@ public:
   enum class BoardSide { Top, Bottom };
   typedef std::pair<const Layer*, const Layer*> LayerPair;
   typedef std::function<void(const FilePath&)> BeforeWriteCallback;
+  typedef std::function<void(const FilePath&, const QByteArray&)>
+      WriteCallback;
+
+  /// A component layer (Gerber X3) file to export
+  struct ComponentLayer {
+    BoardSide side;
+    Uuid assemblyVariant;
+    FilePath filePath;
+  };
 
   // Constructors / Destructor
   BoardGerberExport() = delete;
@@ -83,45 +92,148 @@ public:
   void setRemoveObsoleteFiles(bool remove);
   void setBeforeWriteCallback(BeforeWriteCallback cb);
 
+  /**
+   * @brief Set a custom function to write the output files
+   *
+   * By default, the files are written with ::librepcb::FileUtils. A custom
+   * function allows for example to skip writing files whose content did not
+   * change.
+   *
+   * @param cb  Function to write a file (called after the before write
+   *            callback), or an empty function to restore the default.
+   */
+  void setWriteCallback(WriteCallback cb);
+
+  /**
+   * @brief Enable or disable generating the PCB layer files concurrently
+   *
+   * Enabled by default. The written files are the same (and written in the
+   * same order) in both modes, so this is mainly useful for debugging.
+   *
+   * @param parallel  Whether the files shall be generated on the global
+   *                  thread pool.
+   */
+  void setParallelExport(bool parallel) noexcept;
+
   // General Methods
   void exportPcbLayers(const BoardFabricationOutputSettings& settings) const;
+
+  /**
+   * @brief Export the PCB layers for several settings profiles at once
+   *
+   * Files of different profiles which have the same content (i.e. which
+   * only differ in their file path) are generated only once, and all files
+   * are generated concurrently if parallel export is enabled. The files are
+   * written in the order of the passed profiles.
+   *
+   * @param settings  The fabrication output settings profiles.
+   */
+  void exportPcbLayers(
+      const QVector<BoardFabricationOutputSettings>& settings) const;
   void exportComponentLayer(BoardSide side, const Uuid& assemblyVariant,
                             const FilePath& filePath) const;
 
+  /**
+   * @brief Export several component layers at once
+   *
+   * Much faster than calling #exportComponentLayer() for each file since
+   * the outlines and pins of all devices are determined only once for all
+   * sides and assembly variants. In addition, the files are generated
+   * concurrently if parallel export is enabled. The files are written in
+   * the passed order.
+   *
+   * @param layers  The component layers to export.
+   */
+  void exportComponentLayers(const QVector<ComponentLayer>& layers) const;
+
   // Operator Overloadings
   BoardGerberExport& operator=(const BoardGerberExport& rhs) = delete;
 
 private:
+  /// A file to be written, or to be removed if obsolete (no generator)
+  struct OutputFile {
+    FilePath filePath;
+    QString contentKey;  ///< Files with the same key have the same content
+    std::function<QByteArray()> generate;
+  };
+
+  /// Pin of a device, as exported to component layers
+  struct ComponentPin {
+    Point position;
+    QString name;
+    QString signal;
+    bool isPin1;
+  };
+
+  /// Assembly variant independent data of a device for component layers
+  struct ComponentData {
+    const BI_Device* device;
+    BoardSide side;
+    bool mountable;  ///< Whether the package has a mountable assembly type
+    GerberGenerator::MountType mountType;
+    QString designator;
+    QString footprintName;
+    QVector<std::pair<GerberAttribute::ApertureFunction, Path>> outlines;
+    QVector<ComponentPin> pins;
+  };
+
+  /// A hole to be written to drill files
+  struct Drill {
+    NonEmptyPath path;
+    PositiveLength diameter;
+    bool plated;
+    ExcellonGenerator::Function function;
+  };
+
+  /// All holes of the board, collected once for all drill files
+  struct DrillList {
+    QVector<Drill> pth;  ///< Pad holes and through vias
+    QVector<Drill> npth;  ///< Footprint holes and board holes
+    QMap<LayerPair, QVector<Drill>> blindBuried;  ///< Vias by drill span
+  };
+
   // Private Methods
-  void exportDrillsMerged(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsNpth(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsPth(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsBlindBuried(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBoardOutlines(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerInnerCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSolderMask(
-      const BoardFabricationOutputSettings& settings) const;
+  QVector<ComponentData> collectComponents() const;
+  QByteArray generateComponentLayer(
+      BoardSide side, const Uuid& assemblyVariant,
+      const QVector<ComponentData>& components) const;
+  void exportDrillsMerged(const BoardFabricationOutputSettings& settings,
+                          const DrillList& drills,
+                          QVector<OutputFile>& files) const;
+  void exportDrillsNpth(const BoardFabricationOutputSettings& settings,
+                        const DrillList& drills,
+                        QVector<OutputFile>& files) const;
+  void exportDrillsPth(const BoardFabricationOutputSettings& settings,
+                       const DrillList& drills,
+                       QVector<OutputFile>& files) const;
+  void exportDrillsBlindBuried(const BoardFabricationOutputSettings& settings,
+                               const DrillList& drills,
+                               QVector<OutputFile>& files) const;
+  void exportLayerBoardOutlines(const BoardFabricationOutputSettings& settings,
+                                QVector<OutputFile>& files) const;
+  void exportLayerTopCopper(const BoardFabricationOutputSettings& settings,
+                            QVector<OutputFile>& files) const;
+  void exportLayerInnerCopper(const BoardFabricationOutputSettings& settings,
+                              QVector<OutputFile>& files) const;
+  void exportLayerBottomCopper(const BoardFabricationOutputSettings& settings,
+                               QVector<OutputFile>& files) const;
+  void exportLayerTopSolderMask(const BoardFabricationOutputSettings& settings,
+                                QVector<OutputFile>& files) const;
   void exportLayerBottomSolderMask(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSilkscreen(
-      const BoardFabricationOutputSettings& settings) const;
+      const BoardFabricationOutputSettings& settings,
+      QVector<OutputFile>& files) const;
+  void exportLayerTopSilkscreen(const BoardFabricationOutputSettings& settings,
+                                QVector<OutputFile>& files) const;
   void exportLayerBottomSilkscreen(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSolderPaste(
-      const BoardFabricationOutputSettings& settings) const;
+      const BoardFabricationOutputSettings& settings,
+      QVector<OutputFile>& files) const;
+  void exportLayerTopSolderPaste(const BoardFabricationOutputSettings& settings,
+                                 QVector<OutputFile>& files) const;
   void exportLayerBottomSolderPaste(
-      const BoardFabricationOutputSettings& settings) const;
+      const BoardFabricationOutputSettings& settings,
+      QVector<OutputFile>& files) const;
 
-  int drawNpthDrills(ExcellonGenerator& gen) const;
-  int drawPthDrills(ExcellonGenerator& gen) const;
-  QMap<LayerPair, QList<const BI_Via*> > getBlindBuriedVias() const;
+  DrillList collectDrills() const;
   void drawLayer(GerberGenerator& gen, const Layer& layer) const;
   void drawVia(GerberGenerator& gen, const BI_Via& via, const Layer& layer,
                const QString& netName) const;
@@ -142,9 +254,11 @@ private:
       ExcellonGenerator::Plating plating) const;
   FilePath getOutputFilePath(QString path) const noexcept;
   QString getAttributeValue(const QString& key) const noexcept;
-  void trackFileBeforeWrite(const FilePath& fp) const;
+  void writeFile(const FilePath& fp, const QByteArray& content) const;
 
   // Static Methods
+  static void drawDrills(ExcellonGenerator& gen,
+                         const QVector<Drill>& drills) noexcept;
   static UnsignedLength calcWidthOfLayer(const UnsignedLength& width,
                                          const Layer& layer) noexcept;
 
@@ -153,12 +267,14 @@ private:
   const Board& mBoard;
   bool mRemoveObsoleteFiles;
   BeforeWriteCallback mBeforeWriteCallback;
+  WriteCallback mWriteCallback;
   QDateTime mCreationDateTime;
   QString mProjectName;
   mutable int mCurrentInnerCopperLayer;
   mutable const Layer* mCurrentStartLayer;
   mutable const Layer* mCurrentEndLayer;
   mutable QVector<FilePath> mWrittenFiles;
+  bool mParallelExport;
 };
 
 /*******************************************************************************
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boardnetsegmentsplitter.h"
 
+#include "../../utils/disjointset.h"
 #include "../../utils/toolbox.h"
 
 #include <QtCore>
@@ -74,26 +75,65 @@ void BoardNetSegmentSplitter::addTrace(const Trace& trace) noexcept {
 
 QList<BoardNetSegmentSplitter::Segment>
     BoardNetSegmentSplitter::split() noexcept {
-  QList<Segment> segments;
+  // Group traces which share an anchor. Each anchor is mapped to the first
+  // trace connected to it, so every trace needs to be visited only once.
+  DisjointSet sets(mTraces.count());
+  QHash<TraceAnchor, int> anchorTraces;
+  anchorTraces.reserve(mTraces.count() * 2);
+  for (int i = 0; i < mTraces.count(); ++i) {
+    const Trace& trace = *mTraces.value(i);
+    for (const TraceAnchor& anchor :
+         {trace.getStartPoint(), trace.getEndPoint()}) {
+      auto it = anchorTraces.constFind(anchor);
+      if (it == anchorTraces.constEnd()) {
+        anchorTraces.insert(anchor, i);
+      } else {
+        sets.unite(i, *it);
+      }
+    }
+  }
 
-  // Split netsegment by anchors and lines
-  ViaList availableVias = mVias;
-  TraceList availableTraces = mTraces;
-  while (!availableTraces.isEmpty()) {
-    Segment segment;
-    findConnectedLinesAndPoints(availableTraces.first()->getStartPoint(),
-                                availableVias, availableTraces, segment);
-    segments.append(segment);
+  // Split netsegment by the groups of traces, ordered by their first trace
+  QList<Segment> segments;
+  QHash<int, int> segmentIndices;
+  QSet<Uuid> connectedVias;
+  for (int i = 0; i < mTraces.count(); ++i) {
+    std::shared_ptr<Trace> trace = mTraces.value(i);
+    const int root = sets.find(i);
+    auto it = segmentIndices.constFind(root);
+    if (it == segmentIndices.constEnd()) {
+      it = segmentIndices.insert(root, segments.count());
+      segments.append(Segment());
+    }
+    Segment& segment = segments[*it];
+    segment.traces.append(trace);
+    for (const TraceAnchor& anchor :
+         {trace->getStartPoint(), trace->getEndPoint()}) {
+      if (anchorTraces.remove(anchor) == 0) {
+        continue;  // Anchor already added by another trace.
+      }
+      if (tl::optional<Uuid> junctionUuid = anchor.tryGetJunction()) {
+        if (std::shared_ptr<Junction> junction =
+                mJunctions.find(*junctionUuid)) {
+          segment.junctions.append(junction);
+        }
+      } else if (tl::optional<Uuid> viaUuid = anchor.tryGetVia()) {
+        if (std::shared_ptr<Via> via = mVias.find(*viaUuid)) {
+          segment.vias.append(via);
+          connectedVias.insert(via->getUuid());
+        }
+      }
+    }
   }
-  Q_ASSERT(availableTraces.isEmpty());
 
   // Add remaining vias as separate segments
-  while (!availableVias.isEmpty()) {
-    Segment segment;
-    segment.vias.append(availableVias.take(0));
-    segments.append(segment);
+  for (const auto& via : mVias.values()) {
+    if (!connectedVias.contains(via->getUuid())) {
+      Segment segment;
+      segment.vias.append(via);
+      segments.append(segment);
+    }
   }
-  Q_ASSERT(availableVias.isEmpty());
 
   return segments;
 }
@@ -120,39 +160,6 @@ TraceAnchor BoardNetSegmentSplitter::replaceAnchor(
   }
 }
 
-void BoardNetSegmentSplitter::findConnectedLinesAndPoints(
-    const TraceAnchor& anchor, ViaList& availableVias,
-    TraceList& availableTraces, Segment& segment) noexcept {
-  if (tl::optional<Uuid> junctionUuid = anchor.tryGetJunction()) {
-    if (std::shared_ptr<Junction> junction = mJunctions.find(*junctionUuid)) {
-      if (!segment.junctions.contains(junction->getUuid())) {
-        segment.junctions.append(junction);
-      }
-    }
-  } else if (tl::optional<Uuid> viaUuid = anchor.tryGetVia()) {
-    if (std::shared_ptr<Via> via = mVias.find(*viaUuid)) {
-      if (availableVias.contains(via->getUuid())) {
-        segment.vias.append(via);
-        availableVias.remove(via->getUuid());
-      }
-    }
-  }
-  for (int i = 0; i < mTraces.count(); ++i) {
-    std::shared_ptr<Trace> trace = mTraces.value(i);
-    if (((trace->getStartPoint() == anchor) ||
-         (trace->getEndPoint() == anchor)) &&
-        availableTraces.contains(trace->getUuid()) &&
-        (!segment.traces.contains(trace->getUuid()))) {
-      segment.traces.append(trace);
-      availableTraces.remove(trace->getUuid());
-      findConnectedLinesAndPoints(trace->getStartPoint(), availableVias,
-                                  availableTraces, segment);
-      findConnectedLinesAndPoints(trace->getEndPoint(), availableVias,
-                                  availableTraces, segment);
-    }
-  }
-}
-
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
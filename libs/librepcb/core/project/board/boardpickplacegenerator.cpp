@@ -71,7 +71,7 @@ std::shared_ptr<PickPlaceData> BoardPickPlaceGenerator::generate() noexcept {
   const QStringList& locale = mBoard.getProject().getLocaleOrder();
 
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    auto part = device->getParts(mAssemblyVariant).value(0);
+    auto part = device->getPart(mAssemblyVariant);
     ProjectAttributeLookup lookup(*device, part);
     QList<PickPlaceDataItem> items;
     const QString designator = *device->getComponentInstance().getName();
@@ -22,9 +22,15 @@
  ******************************************************************************/
 #include "boardplanefragmentsbuilder.h"
 
+#include "../../application.h"
+#include "../../fileio/fileutils.h"
 #include "../../library/pkg/footprint.h"
 #include "../../library/pkg/footprintpad.h"
+#include "../../tracer.h"
+#include "../../utils/cachekeybuilder.h"
 #include "../../utils/clipperhelpers.h"
+#include "../../utils/concurrency.h"
+#include "../../utils/scopeguard.h"
 #include "../../utils/transform.h"
 #include "../circuit/netsignal.h"
 #include "board.h"
@@ -45,12 +51,20 @@
 #include <QtCore>
 
 #include <algorithm>
+#include <functional>
 
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/// Format identifier of the plane fragments cache files
+static const char* sFragmentsCacheFormat = "librepcb-planes-1";
+
+/// Version of the plane calculation algorithm, must be incremented whenever
+/// the calculated fragments change to invalidate existing cache files
+static const quint32 sFragmentsAlgorithmVersion = 1;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -59,9 +73,13 @@ BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(bool rebuildAirWires,
                                                        QObject* parent) noexcept
   : QObject(parent),
     mRebuildAirWires(rebuildAirWires),
+    mSimplifyTolerance(0),
+    mFileCacheDir(),
+    mFileCacheMaxSize(0),
     mFuture(),
     mWatcher(),
-    mAbort(false) {
+    mAbort(false),
+    mObstacleCaches() {
   connect(
       &mWatcher, &QFutureWatcherBase::finished, this,
       [this]() { applyToBoard(mFuture.result()); }, Qt::QueuedConnection);
@@ -86,6 +104,30 @@ void BoardPlaneFragmentsBuilder::runSynchronously(
   }
 }
 
+void BoardPlaneFragmentsBuilder::runSynchronously(
+    const QList<Board*>& boards, const FilePath& fileCacheDir) {
+  // The jobs have to be created in the calling thread since they access the
+  // boards, only the calculations are done in parallel. If any build fails,
+  // the destructors of the builders wait for the other builds to finish.
+  std::vector<std::unique_ptr<BoardPlaneFragmentsBuilder>> builders;
+  foreach (Board* board, boards) {
+    std::unique_ptr<BoardPlaneFragmentsBuilder> builder(
+        new BoardPlaneFragmentsBuilder());
+    builder->setFileCache(fileCacheDir);
+    if (auto data = builder->createJob(*board, nullptr)) {
+      builder->mFuture = QtConcurrent::run(
+          builder.get(), &BoardPlaneFragmentsBuilder::run, data, true);
+      builders.push_back(std::move(builder));
+    }
+  }
+  for (auto& builder : builders) {
+    if (!builder->applyToBoard(builder->mFuture.result())) {  // can throw
+      throw LogicError(__FILE__, __LINE__,
+                       "Building planes did not complete?!");
+    }
+  }
+}
+
 bool BoardPlaneFragmentsBuilder::startAsynchronously(
     Board& board, const QSet<const Layer*>* layers) noexcept {
   if (auto data = createJob(board, layers)) {
@@ -136,6 +178,7 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
 
   auto data = std::make_shared<JobData>();
   data->board = &board;
+  data->simplifyTolerance = mSimplifyTolerance;
   data->layers = layers;
   layers.insert(&Layer::boardOutlines());
   layers.insert(&Layer::boardCutouts());
@@ -247,6 +290,14 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
     }
   }
+
+  // Planes not affected by a quick rebuild keep their fragments, so only
+  // cache the results of complete rebuilds. Otherwise every small modification
+  // in the board editor would create a new cache file.
+  if (data->planes.count() == board.getPlanes().count()) {
+    data->fileCacheDir = mFileCacheDir;
+    data->fileCacheMaxSize = mFileCacheMaxSize;
+  }
   return data;
 }
 
@@ -256,12 +307,29 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
   // Note: This method is called from a different thread, thus be careful with
   //       calling other methods to only call thread-safe methods!
 
+  Tracer::Span span("board", "BoardPlaneFragmentsBuilder::run");
   QElapsedTimer timer;
   timer.start();
   qDebug() << "Start calculating areas of" << data->planes.count()
            << "plane(s) on" << data->layers.count() << "layer(s)...";
   emit started();
 
+  // If the planes have already been built with exactly the same input data
+  // (e.g. when opening a project again), restore the fragments from the cache.
+  // Note that the key must be calculated before preprocessing the data.
+  FilePath cacheFp;
+  if (data->fileCacheDir.isValid()) {
+    cacheFp = data->fileCacheDir.getPathTo(calcJobKey(*data).toHex() %
+                                           ".fragments");
+    if (loadFromFileCache(cacheFp, data->result)) {
+      data->finished = true;
+      qDebug() << "Restored plane areas from cache in" << timer.elapsed()
+               << "ms.";
+      emit finished();
+      return data;
+    }
+  }
+
   // Preprocess data.
   for (KeepoutZoneData& zone : data->keepoutZones) {
     if (zone.layers.testFlag(Zone::Layer::Top)) {
@@ -323,8 +391,110 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
               }
             });
 
-  // Build all planes.
-  for (auto it = data->planes.begin(); it != data->planes.end(); it++) {
+  // Build all planes. Planes on different layers do not depend on each other,
+  // thus each layer is processed in a separate worker thread. The planes of
+  // each layer still need to be built sequentially in their priority order.
+  QVector<const Layer*> planeLayers;
+  foreach (const PlaneData& plane, data->planes) {
+    if (!planeLayers.contains(plane.layer)) {
+      planeLayers.append(plane.layer);
+    }
+  }
+  QVector<ObstacleCache> oldCaches;
+  foreach (const Layer* layer, planeLayers) {
+    oldCaches.append(mObstacleCaches.value(layer));
+  }
+  QVector<ObstacleCache> newCaches(planeLayers.count());
+  auto cachesGuard = scopeGuard([&]() {
+    // If the job did not complete, keep the old cache entries as well since
+    // they might be needed in the next run.
+    for (int i = 0; i < planeLayers.count(); ++i) {
+      if (mAbort) {
+        const ObstacleCache& oldCache = oldCaches.at(i);
+        for (auto it = oldCache.begin(); it != oldCache.end(); it++) {
+          if (!newCaches.at(i).contains(it.key())) {
+            newCaches[i].insert(it.key(), it.value());
+          }
+        }
+      }
+      mObstacleCaches[planeLayers.at(i)] = newCaches.at(i);
+    }
+  });
+  if (planeLayers.count() == 1) {
+    data->result =
+        buildPlanesOnLayer(*data, *planeLayers.first(), boardArea,
+                           oldCaches.first(), newCaches.first(),
+                           exceptionOnError);  // can throw
+  } else {
+    // Make sure all workers have finished before leaving this scope since they
+    // access the job data.
+    QVector<QFuture<QHash<Uuid, QVector<Path>>>> futures;
+    auto futuresGuard = Concurrency::waitOnScopeExit(futures);
+    const JobData* job = data.get();
+    const ClipperLib::Paths* area = &boardArea;
+    for (int i = 0; i < planeLayers.count(); ++i) {
+      const Layer* layer = planeLayers.at(i);
+      const ObstacleCache* oldCache = &oldCaches.at(i);
+      ObstacleCache* newCache = &newCaches[i];
+      futures.append(QtConcurrent::run([this, job, layer, area, oldCache,
+                                        newCache, exceptionOnError]() {
+        return buildPlanesOnLayer(*job, *layer, *area, *oldCache, *newCache,
+                                  exceptionOnError);  // can throw
+      }));
+    }
+    for (auto& future : futures) {
+      const QHash<Uuid, QVector<Path>> result = future.result();  // can throw
+      for (auto it = result.begin(); it != result.end(); it++) {
+        data->result.insert(it.key(), it.value());
+      }
+    }
+  }
+
+  if (mAbort) {
+    qDebug() << "Aborted calculating plane areas after" << timer.elapsed()
+             << "ms.";
+  } else {
+    data->finished = true;
+    qDebug() << "Calculated plane areas in" << timer.elapsed() << "ms.";
+    // Do not cache results of planes which failed to build.
+    if (cacheFp.isValid() && (data->result.count() == data->planes.count())) {
+      saveToFileCache(cacheFp, data->result);
+      pruneFileCache(data->fileCacheDir, cacheFp, data->fileCacheMaxSize);
+    }
+  }
+
+  emit finished();
+  return data;
+}
+
+QHash<Uuid, QVector<Path>> BoardPlaneFragmentsBuilder::buildPlanesOnLayer(
+    const JobData& data, const Layer& layer, const ClipperLib::Paths& boardArea,
+    const ObstacleCache& oldCache, ObstacleCache& newCache,
+    bool exceptionOnError) {
+  // Note: This method is called from a different thread, thus be careful with
+  //       calling other methods to only call thread-safe methods!
+
+  // Obstacles which did not change since the last run are taken from the
+  // cache. Only obstacles used in this run are kept in the new cache, thus
+  // modified or removed items are dropped from the cache automatically.
+  auto addObstacle = [&oldCache, &newCache](
+                         ClipperLib::Paths& target, const QByteArray& key,
+                         const std::function<ClipperLib::Paths()>& generate) {
+    auto it = newCache.find(key);
+    if (it == newCache.end()) {
+      auto oldIt = oldCache.find(key);
+      it = newCache.insert(key, (oldIt != oldCache.end())
+                               ? oldIt.value()
+                               : generate());  // can throw
+    }
+    target.insert(target.end(), it->begin(), it->end());
+  };
+
+  QHash<Uuid, QVector<Path>> result;
+  for (auto it = data.planes.begin(); it != data.planes.end(); it++) {
+    if (it->layer != &layer) {
+      continue;
+    }
     try {
       ClipperLib::Paths removedAreas;
       ClipperLib::Paths connectedNetSignalAreas;
@@ -349,13 +519,13 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
 
       // Collect other planes.
-      for (auto otherIt = data->planes.begin(); otherIt != it; otherIt++) {
+      for (auto otherIt = data.planes.begin(); otherIt != it; otherIt++) {
         if ((otherIt->layer == it->layer) &&
             (otherIt->netSignal != it->netSignal)) {
           const UnsignedLength clearance =
               std::max(it->minClearance, otherIt->minClearance);
           ClipperLib::Paths clipperPaths = ClipperHelpers::convert(
-              data->result.value(otherIt->uuid), maxArcTolerance());
+              result.value(otherIt->uuid), maxArcTolerance());
           ClipperHelpers::offset(clipperPaths, *clearance,
                                  maxArcTolerance());  // can throw
           removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
@@ -367,7 +537,7 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
 
       // Collect keepout zones.
-      foreach (const KeepoutZoneData& zone, data->keepoutZones) {
+      foreach (const KeepoutZoneData& zone, data.keepoutZones) {
         if (zone.boardLayers.contains(it->layer)) {
           const ClipperLib::Path clipperPath =
               ClipperHelpers::convert(zone.outline, maxArcTolerance());
@@ -376,22 +546,24 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
 
       // Collect holes.
-      foreach (const auto& tuple, data->holes) {
+      foreach (const auto& tuple, data.holes) {
         const PositiveLength diameter(std::get<1>(tuple) +
                                       it->minClearance * 2);
-        const QVector<Path> paths =
-            std::get<2>(tuple)->toOutlineStrokes(diameter);
-        const ClipperLib::Paths clipperPaths =
-            ClipperHelpers::convert(paths, maxArcTolerance());
-        removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                            clipperPaths.end());
+        addObstacle(removedAreas,
+                    calcObstacleKey("hole", {*std::get<2>(tuple)},
+                                    {diameter->toNm()}),
+                    [&]() {
+                      return ClipperHelpers::convert(
+                          std::get<2>(tuple)->toOutlineStrokes(diameter),
+                          maxArcTolerance());
+                    });
       }
       if (mAbort) {
         break;
       }
 
       // Collect vias.
-      foreach (const ViaData& via, data->vias) {
+      foreach (const ViaData& via, data.vias) {
         if ((via.startLayer->getCopperNumber() >
              it->layer->getCopperNumber()) ||
             (via.endLayer->getCopperNumber() < it->layer->getCopperNumber())) {
@@ -408,12 +580,18 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
               ClipperHelpers::convert(path, maxArcTolerance()));
         } else {
           // Vias has different net than plane -> subtract with clearance.
-          const Path path =
-              Path::circle(PositiveLength(via.diameter + it->minClearance * 2))
-                  .translated(via.position);
-          const ClipperLib::Path clipperPath =
-              ClipperHelpers::convert(path, maxArcTolerance());
-          removedAreas.push_back(clipperPath);
+          const PositiveLength diameter(via.diameter + it->minClearance * 2);
+          addObstacle(removedAreas,
+                      calcObstacleKey("via", {},
+                                      {via.position.getX().toNm(),
+                                       via.position.getY().toNm(),
+                                       diameter->toNm()}),
+                      [&]() {
+                        const Path path =
+                            Path::circle(diameter).translated(via.position);
+                        return ClipperLib::Paths{
+                            ClipperHelpers::convert(path, maxArcTolerance())};
+                      });
         }
       }
       if (mAbort) {
@@ -421,49 +599,114 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
 
       // Collect traces & other strokes.
-      foreach (const PolygonData& polygon, data->polygons) {
+      foreach (const PolygonData& polygon, data.polygons) {
         if (polygon.layer == it->layer) {
           if (it->netSignal && (polygon.netSignal == it->netSignal)) {
             // Same net signal -> memorize as connected area.
-            if (polygon.filled) {
-              // Area.
-              const ClipperLib::Path clipperPath =
-                  ClipperHelpers::convert(polygon.path, maxArcTolerance());
-              connectedNetSignalAreas.push_back(clipperPath);
-            }
-            if ((!polygon.filled) || (polygon.width > 0)) {
-              // Outline strokes.
-              const QVector<Path> paths = polygon.path.toOutlineStrokes(
-                  PositiveLength(std::max(*polygon.width, Length(1))));
-              const ClipperLib::Paths clipperPaths =
-                  ClipperHelpers::convert(paths, maxArcTolerance());
-              connectedNetSignalAreas.insert(connectedNetSignalAreas.end(),
-                                             clipperPaths.begin(),
-                                             clipperPaths.end());
-            }
+            auto generate = [&]() {
+              ClipperLib::Paths clipperPaths;
+              if (polygon.filled) {
+                // Area.
+                clipperPaths.push_back(
+                    ClipperHelpers::convert(polygon.path, maxArcTolerance()));
+              }
+              if ((!polygon.filled) || (polygon.width > 0)) {
+                // Outline strokes.
+                const QVector<Path> paths = polygon.path.toOutlineStrokes(
+                    PositiveLength(std::max(*polygon.width, Length(1))));
+                const ClipperLib::Paths strokes =
+                    ClipperHelpers::convert(paths, maxArcTolerance());
+                clipperPaths.insert(clipperPaths.end(), strokes.begin(),
+                                    strokes.end());
+              }
+              return clipperPaths;
+            };
+            addObstacle(connectedNetSignalAreas,
+                        calcObstacleKey("connected", {polygon.path},
+                                        {polygon.width->toNm(),
+                                         polygon.filled}),
+                        generate);
           } else {
             // Different net signal -> subtract with clearance.
-            if (polygon.filled) {
-              // Area.
-              ClipperLib::Paths clipperPaths{
-                  ClipperHelpers::convert(polygon.path, maxArcTolerance())};
-              ClipperHelpers::offset(clipperPaths, *it->minClearance,
-                                     maxArcTolerance());  // can throw
-              removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                  clipperPaths.end());
-            }
-            if ((!polygon.filled) || (polygon.width > 0)) {
-              // Outline strokes.
-              const QVector<Path> paths =
-                  polygon.path.toOutlineStrokes(PositiveLength(std::max(
-                      *polygon.width + it->minClearance * 2, Length(1))));
-              const ClipperLib::Paths clipperPaths =
-                  ClipperHelpers::convert(paths, maxArcTolerance());
-              removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                  clipperPaths.end());
+            auto generate = [&]() {
+              ClipperLib::Paths clipperPaths;
+              if (polygon.filled) {
+                // Area.
+                clipperPaths.push_back(
+                    ClipperHelpers::convert(polygon.path, maxArcTolerance()));
+                ClipperHelpers::offset(clipperPaths, *it->minClearance,
+                                       maxArcTolerance());  // can throw
+              }
+              if ((!polygon.filled) || (polygon.width > 0)) {
+                // Outline strokes.
+                const QVector<Path> paths =
+                    polygon.path.toOutlineStrokes(PositiveLength(std::max(
+                        *polygon.width + it->minClearance * 2, Length(1))));
+                const ClipperLib::Paths strokes =
+                    ClipperHelpers::convert(paths, maxArcTolerance());
+                clipperPaths.insert(clipperPaths.end(), strokes.begin(),
+                                    strokes.end());
+              }
+              return clipperPaths;
+            };
+            addObstacle(removedAreas,
+                        calcObstacleKey("polygon", {polygon.path},
+                                        {polygon.width->toNm(), polygon.filled,
+                                         it->minClearance->toNm()}),
+                        generate);
+          }
+        }
+      }
+      if (mAbort) {
+        break;
+      }
+
+      // Determine the cut-outs of pads with the same net signal. They require
+      // several Clipper operations per pad (e.g. to subtract the thermal
+      // spokes), thus all cut-outs not cached yet are calculated in parallel.
+      // The cut-outs only depend on the pad and the plane settings, so pads
+      // with identical geometry and placement are calculated only once.
+      const PlaneData& plane = *it;
+      auto calcCutoutKey = [&plane](const PadData& pad,
+                                    const PadGeometry& geometry) {
+        return calcPadObstacleKey(
+            "cutout", pad.transform, geometry,
+            {std::max(*plane.thermalGap, *pad.clearance).toNm(),
+             static_cast<qint64>(plane.connectStyle),
+             plane.thermalSpokeWidth->toNm(), plane.minWidth->toNm()});
+      };
+      struct PendingCutout {
+        const PadData* pad;
+        const PadGeometry* geometry;
+        PadCutout cutout;
+      };
+      QVector<PendingCutout> pendingCutouts;
+      QHash<QByteArray, int> pendingCutoutIndices;
+      if (it->netSignal &&
+          (it->connectStyle != BI_Plane::ConnectStyle::Solid)) {
+        for (const PadData& pad : data.pads) {
+          auto geometriesIt = pad.geometries.find(it->layer);
+          if ((pad.netSignal != it->netSignal) ||
+              (geometriesIt == pad.geometries.end())) {
+            continue;
+          }
+          for (const PadGeometry& geometry : *geometriesIt) {
+            const QByteArray key = calcCutoutKey(pad, geometry);
+            if ((!newCache.contains(key + 'a')) &&
+                (!oldCache.contains(key + 'a')) &&
+                (!pendingCutoutIndices.contains(key))) {
+              pendingCutoutIndices.insert(key, pendingCutouts.count());
+              pendingCutouts.append(PendingCutout{&pad, &geometry, {}});
             }
           }
         }
+        QtConcurrent::blockingMap(
+            pendingCutouts, [this, &plane](PendingCutout& c) {
+              if (!mAbort) {
+                c.cutout =
+                    calcPadCutout(plane, *c.pad, *c.geometry);  // can throw
+              }
+            });
       }
       if (mAbort) {
         break;
@@ -473,10 +716,37 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       ClipperLib::Paths thermalPadAreas;
       ClipperLib::Paths thermalPadAreasShrinked;
       ClipperLib::Paths thermalPadClearanceAreas;
-      foreach (const PadData& pad, data->pads) {
+      foreach (const PadData& pad, data.pads) {
         const bool sameNet = it->netSignal && (pad.netSignal == it->netSignal);
         foreach (const PadGeometry& geometry, pad.geometries.value(it->layer)) {
-          if (sameNet) {
+          if (!sameNet) {
+            // Different net signal -> subtract with clearance. Also create
+            // cut-outs for each hole to ensure correct clearance even if the
+            // pad outline is too small or invalid.
+            const Length clearance =
+                std::max(*it->minClearance, *pad.clearance);
+            auto generate = [&]() {
+              const PadGeometry offsetGeometry = geometry.withOffset(clearance);
+              const QVector<Path> paths =
+                  pad.transform.map(offsetGeometry.toOutlines());
+              ClipperLib::Paths clipperPaths =
+                  ClipperHelpers::convert(paths, maxArcTolerance());
+              for (const PadHole& hole : geometry.getHoles()) {
+                const PositiveLength width(hole.getDiameter() +
+                                           (clearance * 2));
+                const ClipperLib::Paths holePaths = ClipperHelpers::convert(
+                    pad.transform.map(hole.getPath()->toOutlineStrokes(width)),
+                    maxArcTolerance());
+                clipperPaths.insert(clipperPaths.end(), holePaths.begin(),
+                                    holePaths.end());
+              }
+              return clipperPaths;
+            };
+            addObstacle(removedAreas,
+                        calcPadObstacleKey("pad", pad.transform, geometry,
+                                           {clearance.toNm()}),
+                        generate);
+          } else {
             // Same net signal -> memorize as connected area.
             const QVector<Path> paths =
                 pad.transform.map(geometry.toOutlines());
@@ -486,92 +756,53 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
                                            clipperPaths.begin(),
                                            clipperPaths.end());
           }
-          if ((!sameNet) ||
-              (it->connectStyle != BI_Plane::ConnectStyle::Solid)) {
-            // Determine required clearance. For connection style 'none' for
-            // pads of the same net, use the thermal gap clearance since usually
-            // it is smaller than the planes clearance, so it leads to a higher
-            // plane area.
-            const Length clearance = std::max(
-                sameNet ? *it->thermalGap : *it->minClearance, *pad.clearance);
-            QVector<Path> paths =
-                pad.transform.map(geometry.withOffset(clearance).toOutlines());
-            ClipperLib::Paths clipperPaths =
-                ClipperHelpers::convert(paths, maxArcTolerance());
+          if (sameNet && (it->connectStyle != BI_Plane::ConnectStyle::Solid)) {
+            // Always take all parts of the cut-out to keep them together in
+            // the cache.
+            const QByteArray key = calcCutoutKey(pad, geometry);
+            PadCutout cutout;
+            auto takeArea = [&](char part, ClipperLib::Paths PadCutout::*area) {
+              addObstacle(cutout.*area, key + part, [&]() {
+                int index = pendingCutoutIndices.value(key, -1);
+                if (index < 0) {
+                  // Not precalculated (e.g. only some parts were cached), so
+                  // calculate it now and remember it for the other parts.
+                  index = pendingCutouts.count();
+                  pendingCutoutIndices.insert(key, index);
+                  pendingCutouts.append(PendingCutout{
+                      &pad, &geometry,
+                      calcPadCutout(plane, pad, geometry)});  // can throw
+                }
+                return pendingCutouts.at(index).cutout.*area;
+              });
+            };
+            takeArea('a', &PadCutout::clearanceArea);
+            takeArea('b', &PadCutout::thermalArea);
+            takeArea('c', &PadCutout::copperArea);
+            takeArea('d', &PadCutout::copperAreaShrinked);
+            takeArea('e', &PadCutout::spokesClearanceArea);
 
-            // For thermal relief connection, subtract the spokes from the
-            // cutout.
-            if (sameNet &&
-                (it->connectStyle == BI_Plane::ConnectStyle::ThermalRelief) &&
-                ClipperHelpers::anyPointsInside(clipperPaths, planeOutline)) {
-              // Note: Make spokes *slightly* thicker to avoid them to be
-              // removed due to numerical inaccuary of minimum width procedure.
-              const PositiveLength spokeWidth(it->thermalSpokeWidth + 10);
-              const Length spokeLength(100000000);  // Maximum spoke length.
-              foreach (const auto& spokeConfig,
-                       determineThermalSpokes(geometry)) {
-                const Point p1 =
-                    spokeConfig.first.rotated(pad.transform.getRotation()) +
-                    pad.transform.getPosition();
-                const Point p2 =
-                    (Point(spokeLength, 0).rotated(spokeConfig.second) +
-                     spokeConfig.first)
-                        .rotated(pad.transform.getRotation()) +
-                    pad.transform.getPosition();
-                const ClipperLib::Paths spokePaths{ClipperHelpers::convert(
-                    Path::obround(p1, p2, spokeWidth), maxArcTolerance())};
-                ClipperHelpers::subtract(clipperPaths, spokePaths,
-                                         ClipperLib::pftEvenOdd,
-                                         ClipperLib::pftNonZero);  // can throw
-              }
-              // Memorize copper area for later removal of unconnected
-              // thermal spokes,
-              ClipperLib::Paths tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.toOutlines()), maxArcTolerance());
-              if (tmp.size() > 1) {
-                ClipperHelpers::unite(tmp,
-                                      ClipperLib::pftNonZero);  // can throw
-              }
-              thermalPadAreas.insert(thermalPadAreas.end(), tmp.begin(),
-                                     tmp.end());
-              // Memorize clearance area for later removal of unconnected
-              // thermal spokes,
-              Length offset = clearance + it->minWidth - maxArcTolerance() - 10;
-              tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.withOffset(offset).toOutlines()),
-                  maxArcTolerance());
-              if (tmp.size() > 1) {
-                ClipperHelpers::unite(tmp,
-                                      ClipperLib::pftNonZero);  // can throw
-              }
-              thermalPadClearanceAreas.insert(thermalPadClearanceAreas.end(),
-                                              tmp.begin(), tmp.end());
-              // Memorize slightly shrinked copper area for later removal of
-              // unconnected thermal spokes,
-              offset = -maxArcTolerance() - 10;
-              tmp = ClipperHelpers::convert(
-                  pad.transform.map(geometry.withOffset(offset).toOutlines()),
-                  maxArcTolerance());
+            // For thermal relief connection, the spokes are subtracted from
+            // the cutout and the pad areas are memorized for later removal of
+            // unconnected thermal spokes.
+            const ClipperLib::Paths* removedArea = &cutout.clearanceArea;
+            if ((it->connectStyle == BI_Plane::ConnectStyle::ThermalRelief) &&
+                ClipperHelpers::anyPointsInside(cutout.clearanceArea,
+                                                planeOutline)) {
+              removedArea = &cutout.thermalArea;
+              thermalPadAreas.insert(thermalPadAreas.end(),
+                                     cutout.copperArea.begin(),
+                                     cutout.copperArea.end());
+              thermalPadClearanceAreas.insert(
+                  thermalPadClearanceAreas.end(),
+                  cutout.spokesClearanceArea.begin(),
+                  cutout.spokesClearanceArea.end());
               thermalPadAreasShrinked.insert(thermalPadAreasShrinked.end(),
-                                             tmp.begin(), tmp.end());
-            }
-            removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                clipperPaths.end());
-
-            // Also create cut-outs for each hole to ensure correct clearance
-            // even if the pad outline is too small or invalid.
-            if (!sameNet) {
-              for (const PadHole& hole : geometry.getHoles()) {
-                const PositiveLength width(hole.getDiameter() +
-                                           (clearance * 2));
-                paths =
-                    pad.transform.map(hole.getPath()->toOutlineStrokes(width));
-                clipperPaths =
-                    ClipperHelpers::convert(paths, maxArcTolerance());
-                removedAreas.insert(removedAreas.end(), clipperPaths.begin(),
-                                    clipperPaths.end());
-              }
+                                             cutout.copperAreaShrinked.begin(),
+                                             cutout.copperAreaShrinked.end());
             }
+            removedAreas.insert(removedAreas.end(), removedArea->begin(),
+                                removedArea->end());
           }
         }
         if (mAbort) {
@@ -599,6 +830,14 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
         ClipperHelpers::offset(fragments, minWidthOffset,
                                maxArcTolerance());  // can throw
       }
+
+      // If enabled, remove insignificant vertices. This has to be done before
+      // flattening the areas since it could break cut-ins.
+      if (data.simplifyTolerance > 0) {
+        ClipperHelpers::simplify(
+            fragments,
+            PositiveLength(*data.simplifyTolerance));  // can throw
+      }
       if (mAbort) {
         break;
       }
@@ -692,7 +931,7 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
 
       // Memorize fragments for this plane.
-      data->result[it->uuid] = ClipperHelpers::convert(fragments);
+      result[it->uuid] = ClipperHelpers::convert(fragments);
     } catch (const Exception& e) {
       qCritical() << "Failed to calculate plane areas, leaving empty:"
                   << e.getMsg();
@@ -701,17 +940,314 @@ std::shared_ptr<BoardPlaneFragmentsBuilder::JobData>
       }
     }
   }
+  return result;
+}
 
-  if (mAbort) {
-    qDebug() << "Aborted calculating plane areas after" << timer.elapsed()
-             << "ms.";
-  } else {
-    data->finished = true;
-    qDebug() << "Calculated plane areas in" << timer.elapsed() << "ms.";
+QByteArray BoardPlaneFragmentsBuilder::calcJobKey(
+    const JobData& data) noexcept {
+  CacheKeyBuilder builder(QCryptographicHash::Sha256);
+  auto addValue = [&builder](qint64 value) { builder.addValue(value); };
+  auto addString = [&builder](const QString& str) { builder.addString(str); };
+  auto addPath = [&builder](const Path& path) { builder.addPath(path); };
+  auto addNetSignal = [&](const tl::optional<Uuid>& uuid) {
+    addString(uuid ? uuid->toStr() : QString());
+  };
+  auto addLayers = [&](const QSet<const Layer*>& layers) {
+    // Sorted by ID since the order of a QSet of pointers is not deterministic.
+    QStringList ids;
+    foreach (const Layer* layer, layers) {
+      ids.append(layer->getId());
+    }
+    std::sort(ids.begin(), ids.end());
+    addValue(ids.count());
+    foreach (const QString& id, ids) {
+      addString(id);
+    }
+  };
+  auto addTransform = [&](const Transform& transform) {
+    addValue(transform.getPosition().getX().toNm());
+    addValue(transform.getPosition().getY().toNm());
+    addValue(transform.getRotation().toMicroDeg());
+    addValue(transform.getMirrored());
+  };
+
+  builder.addType(sFragmentsCacheFormat);
+  addString(Application::getVersion());
+  addValue(sFragmentsAlgorithmVersion);
+  addValue(maxArcTolerance()->toNm());
+  addValue(data.simplifyTolerance->toNm());
+  addLayers(data.layers);
+  addValue(data.planes.count());
+  foreach (const PlaneData& plane, data.planes) {
+    addString(plane.uuid.toStr());
+    addString(plane.layer->getId());
+    addNetSignal(plane.netSignal);
+    addPath(plane.outline);
+    addValue(plane.minWidth->toNm());
+    addValue(plane.minClearance->toNm());
+    addValue(plane.keepIslands);
+    addValue(plane.priority);
+    addValue(static_cast<qint64>(plane.connectStyle));
+    addValue(plane.thermalGap->toNm());
+    addValue(plane.thermalSpokeWidth->toNm());
+  }
+  addValue(data.keepoutZones.count());
+  foreach (const KeepoutZoneData& zone, data.keepoutZones) {
+    addTransform(zone.transform);
+    addValue(static_cast<qint64>(zone.layers));
+    addLayers(zone.boardLayers);
+    addPath(zone.outline);
+  }
+  addValue(data.polygons.count());
+  foreach (const PolygonData& polygon, data.polygons) {
+    addTransform(polygon.transform);
+    addString(polygon.layer->getId());
+    addNetSignal(polygon.netSignal);
+    addPath(polygon.path);
+    addValue(polygon.width->toNm());
+    addValue(polygon.filled);
+  }
+  addValue(data.vias.count());
+  foreach (const ViaData& via, data.vias) {
+    addNetSignal(via.netSignal);
+    addValue(via.position.getX().toNm());
+    addValue(via.position.getY().toNm());
+    addValue(via.diameter->toNm());
+    addString(via.startLayer->getId());
+    addString(via.endLayer->getId());
   }
+  addValue(data.pads.count());
+  foreach (const PadData& pad, data.pads) {
+    addNetSignal(pad.netSignal);
+    QMap<QString, const Layer*> layers;  // Sorted by ID.
+    for (auto it = pad.geometries.begin(); it != pad.geometries.end(); it++) {
+      layers.insert(it.key()->getId(), it.key());
+    }
+    addValue(layers.count());
+    for (auto it = layers.begin(); it != layers.end(); it++) {
+      addString(it.key());
+      const QList<PadGeometry> geometries = pad.geometries.value(it.value());
+      addValue(geometries.count());
+      foreach (const PadGeometry& geometry, geometries) {
+        builder.addData(calcPadObstacleKey("pad", pad.transform, geometry,
+                                           {pad.clearance->toNm()}));
+      }
+    }
+  }
+  addValue(data.holes.count());
+  foreach (const auto& hole, data.holes) {
+    addTransform(std::get<0>(hole));
+    addValue(std::get<1>(hole)->toNm());
+    addPath(*std::get<2>(hole));
+  }
+  addValue(data.traces.count());
+  foreach (const TraceData& trace, data.traces) {
+    addString(trace.layer->getId());
+    addNetSignal(trace.netSignal);
+    addValue(trace.startPos.getX().toNm());
+    addValue(trace.startPos.getY().toNm());
+    addValue(trace.endPos.getX().toNm());
+    addValue(trace.endPos.getY().toNm());
+    addValue(trace.width->toNm());
+  }
+  return builder.getResult();
+}
 
-  emit finished();
-  return data;
+bool BoardPlaneFragmentsBuilder::loadFromFileCache(
+    const FilePath& fp, QHash<Uuid, QVector<Path>>& result) noexcept {
+  if (!fp.isExistingFile()) {
+    return false;
+  }
+
+  try {
+    const QByteArray content = FileUtils::readFile(fp);  // can throw
+    QDataStream stream(content);
+    stream.setVersion(QDataStream::Qt_5_5);
+    QByteArray format;
+    QString appVersion;
+    quint32 algorithmVersion = 0;
+    quint32 planeCount = 0;
+    stream >> format >> appVersion >> algorithmVersion;
+    if ((format != sFragmentsCacheFormat) ||
+        (appVersion != Application::getVersion()) ||
+        (algorithmVersion != sFragmentsAlgorithmVersion)) {
+      return false;  // Created by another application version.
+    }
+    stream >> planeCount;
+    for (quint32 i = 0; i < planeCount; ++i) {
+      QString uuid;
+      quint32 fragmentCount = 0;
+      stream >> uuid >> fragmentCount;
+      QVector<Path> fragments;
+      for (quint32 k = 0; k < fragmentCount; ++k) {
+        quint32 vertexCount = 0;
+        stream >> vertexCount;
+        QVector<Vertex> vertices;
+        for (quint32 v = 0; (v < vertexCount) && (!stream.atEnd()); ++v) {
+          qint64 x = 0, y = 0;
+          qint32 angle = 0;
+          stream >> x >> y >> angle;
+          vertices.append(Vertex(Point(x, y), Angle(angle)));
+        }
+        fragments.append(Path(std::move(vertices)));
+      }
+      result.insert(Uuid::fromString(uuid), fragments);  // can throw
+    }
+    if ((stream.status() != QDataStream::Ok) || (!stream.atEnd())) {
+      throw RuntimeError(__FILE__, __LINE__, "Corrupt plane cache file.");
+    }
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 10, 0))
+    // Mark the file as recently used to not prune it from the cache.
+    QFile file(fp.toStr());
+    if (file.open(QIODevice::Append)) {
+      file.setFileTime(QDateTime::currentDateTime(),
+                       QFileDevice::FileModificationTime);
+    }
+#endif
+    return true;
+  } catch (const Exception& e) {
+    qWarning() << "Failed to load cached plane areas:" << e.getMsg();
+    result.clear();
+    return false;
+  }
+}
+
+void BoardPlaneFragmentsBuilder::saveToFileCache(
+    const FilePath& fp, const QHash<Uuid, QVector<Path>>& result) noexcept {
+  try {
+    QByteArray content;
+    QDataStream stream(&content, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_5);
+    stream << QByteArray(sFragmentsCacheFormat) << Application::getVersion()
+           << sFragmentsAlgorithmVersion
+           << static_cast<quint32>(result.count());
+    for (auto it = result.begin(); it != result.end(); it++) {
+      stream << it.key().toStr() << static_cast<quint32>(it->count());
+      foreach (const Path& fragment, *it) {
+        stream << static_cast<quint32>(fragment.getVertices().count());
+        for (const Vertex& vertex : fragment.getVertices()) {
+          stream << static_cast<qint64>(vertex.getPos().getX().toNm())
+                 << static_cast<qint64>(vertex.getPos().getY().toNm())
+                 << static_cast<qint32>(vertex.getAngle().toMicroDeg());
+        }
+      }
+    }
+    FileUtils::writeFile(fp, content);  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to cache plane areas:" << e.getMsg();
+  }
+}
+
+void BoardPlaneFragmentsBuilder::pruneFileCache(const FilePath& dir,
+                                                const FilePath& keep,
+                                                qint64 maxSize) noexcept {
+  // Remove the least recently used files until the cache fits the limit.
+  const QFileInfoList files =
+      QDir(dir.toStr())
+          .entryInfoList({"*.fragments"}, QDir::Files, QDir::Time);
+  qint64 totalSize = 0;
+  foreach (const QFileInfo& info, files) {
+    totalSize += info.size();
+    if ((totalSize > maxSize) && (FilePath(info.absoluteFilePath()) != keep)) {
+      try {
+        FileUtils::removeFile(FilePath(info.absoluteFilePath()));  // can throw
+      } catch (const Exception& e) {
+        qWarning() << "Failed to prune plane cache:" << e.getMsg();
+      }
+    }
+  }
+}
+
+QByteArray BoardPlaneFragmentsBuilder::calcObstacleKey(
+    const char* type, const QVector<Path>& paths,
+    const QVector<qint64>& values) noexcept {
+  return CacheKeyBuilder::calcKey(type, paths, values);
+}
+
+QByteArray BoardPlaneFragmentsBuilder::calcPadObstacleKey(
+    const char* type, const Transform& transform, const PadGeometry& geometry,
+    const QVector<qint64>& values) noexcept {
+  QVector<Path> paths = {geometry.getPath()};
+  QVector<qint64> allValues = {
+      transform.getPosition().getX().toNm(),
+      transform.getPosition().getY().toNm(),
+      transform.getRotation().toMicroDeg(),
+      transform.getMirrored(),
+      static_cast<qint64>(geometry.getShape()),
+      geometry.getWidth().toNm(),
+      geometry.getHeight().toNm(),
+      geometry.getCornerRadius()->toNm(),
+  };
+  allValues += values;
+  for (const PadHole& hole : geometry.getHoles()) {
+    paths.append(*hole.getPath());
+    allValues.append(hole.getDiameter()->toNm());
+  }
+  return calcObstacleKey(type, paths, allValues);
+}
+
+BoardPlaneFragmentsBuilder::PadCutout BoardPlaneFragmentsBuilder::calcPadCutout(
+    const PlaneData& plane, const PadData& pad, const PadGeometry& geometry) {
+  // Note: This method is called from different threads, thus it must not
+  //       access any data other than the passed arguments!
+
+  // Determine required clearance. For connection style 'none' for pads of the
+  // same net, use the thermal gap clearance since usually it is smaller than
+  // the planes clearance, so it leads to a higher plane area.
+  const Length clearance = std::max(*plane.thermalGap, *pad.clearance);
+  PadCutout cutout;
+  cutout.clearanceArea = ClipperHelpers::convert(
+      pad.transform.map(geometry.withOffset(clearance).toOutlines()),
+      maxArcTolerance());
+  if (plane.connectStyle != BI_Plane::ConnectStyle::ThermalRelief) {
+    return cutout;
+  }
+
+  // Subtract the spokes from the cutout. Note: Make spokes *slightly* thicker
+  // to avoid them to be removed due to numerical inaccuary of minimum width
+  // procedure.
+  cutout.thermalArea = cutout.clearanceArea;
+  const PositiveLength spokeWidth(plane.thermalSpokeWidth + 10);
+  const Length spokeLength(100000000);  // Maximum spoke length.
+  foreach (const auto& spokeConfig, determineThermalSpokes(geometry)) {
+    const Point p1 = spokeConfig.first.rotated(pad.transform.getRotation()) +
+        pad.transform.getPosition();
+    const Point p2 =
+        (Point(spokeLength, 0).rotated(spokeConfig.second) + spokeConfig.first)
+            .rotated(pad.transform.getRotation()) +
+        pad.transform.getPosition();
+    const ClipperLib::Paths spokePaths{ClipperHelpers::convert(
+        Path::obround(p1, p2, spokeWidth), maxArcTolerance())};
+    ClipperHelpers::subtract(cutout.thermalArea, spokePaths,
+                             ClipperLib::pftEvenOdd,
+                             ClipperLib::pftNonZero);  // can throw
+  }
+
+  // Copper area for later removal of unconnected thermal spokes.
+  cutout.copperArea = ClipperHelpers::convert(
+      pad.transform.map(geometry.toOutlines()), maxArcTolerance());
+  if (cutout.copperArea.size() > 1) {
+    ClipperHelpers::unite(cutout.copperArea,
+                          ClipperLib::pftNonZero);  // can throw
+  }
+
+  // Clearance area for later removal of unconnected thermal spokes.
+  Length offset = clearance + plane.minWidth - maxArcTolerance() - 10;
+  cutout.spokesClearanceArea = ClipperHelpers::convert(
+      pad.transform.map(geometry.withOffset(offset).toOutlines()),
+      maxArcTolerance());
+  if (cutout.spokesClearanceArea.size() > 1) {
+    ClipperHelpers::unite(cutout.spokesClearanceArea,
+                          ClipperLib::pftNonZero);  // can throw
+  }
+
+  // Slightly shrinked copper area for later removal of unconnected thermal
+  // spokes.
+  offset = -maxArcTolerance() - 10;
+  cutout.copperAreaShrinked = ClipperHelpers::convert(
+      pad.transform.map(geometry.withOffset(offset).toOutlines()),
+      maxArcTolerance());
+  return cutout;
 }
 
 QVector<std::pair<Point, Angle>>
@@ -799,7 +1335,8 @@ bool BoardPlaneFragmentsBuilder::applyToBoard(
     }
     if (modified) {
       if (mRebuildAirWires) {
-        data->board->forceAirWiresRebuild();
+        // Only the net signals of modified planes have been scheduled.
+        data->board->triggerAirWiresRebuild();
       }
       emit boardPlanesModified();
     }
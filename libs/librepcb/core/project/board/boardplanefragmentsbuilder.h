@@ -23,12 +23,15 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../fileio/filepath.h"
 #include "../../geometry/path.h"
 #include "../../geometry/zone.h"
 #include "../../types/uuid.h"
 #include "../../utils/transform.h"
 #include "items/bi_plane.h"
 
+#include <polyclipping/clipper.hpp>
+
 #include <QtCore>
 
 #include <memory>
@@ -60,6 +63,45 @@ public:
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
   ~BoardPlaneFragmentsBuilder() noexcept;
 
+  // Setters
+
+  /**
+   * @brief Enable simplification of the calculated plane areas
+   *
+   * If enabled, vertices which deviate less than the given tolerance from
+   * the line between their neighbors are removed from the plane areas. This
+   * reduces the vertex count of the fragments, which speeds up the following
+   * operations and reduces memory usage. Disabled by default to keep the
+   * calculated fragments of existing boards unchanged.
+   *
+   * @param tolerance   Maximum deviation of the simplified fragments, must
+   *                    be well below #maxArcTolerance() since the DRC only
+   *                    tolerates inaccuracies up to this value. Zero
+   *                    (default) disables the simplification.
+   */
+  void setSimplifyTolerance(const UnsignedLength& tolerance) noexcept {
+    mSimplifyTolerance = tolerance;
+  }
+
+  /**
+   * @brief Enable the persistent cache of calculated fragments
+   *
+   * If enabled, the fragments of complete rebuilds are stored in the given
+   * directory and restored from there when building the same planes again
+   * (e.g. when opening a project again). Cache files of other application
+   * versions are ignored and the least recently used files are removed
+   * if the directory grows bigger than the given size. Disabled by default.
+   *
+   * @param dir       Directory to store the cache files in. An invalid path
+   *                  (default) disables the cache.
+   * @param maxSize   Maximum total size of the cache files in bytes.
+   */
+  void setFileCache(const FilePath& dir,
+                    qint64 maxSize = 64 * 1024 * 1024) noexcept {
+    mFileCacheDir = dir;
+    mFileCacheMaxSize = maxSize;
+  }
+
   // General Methods
 
   /**
@@ -76,6 +118,22 @@ public:
   void runSynchronously(Board& board,
                         const QSet<const Layer*>* layers = nullptr);
 
+  /**
+   * @brief Rebuild all planes of several boards in parallel (blocking)
+   *
+   * Equivalent to calling #runSynchronously() for each board, but the boards
+   * are processed concurrently on the global thread pool. Useful to prepare
+   * all boards of a project (e.g. its variants) for exports at once.
+   *
+   * @param boards        The boards to rebuild the planes of.
+   * @param fileCacheDir  See #setFileCache(). Invalid (default) to disable
+   *                      the persistent cache.
+   *
+   * @throws Exception if any error occurred.
+   */
+  static void runSynchronously(const QList<Board*>& boards,
+                               const FilePath& fileCacheDir = FilePath());
+
   /**
    * @brief Start building plane fragments asynchronously
    *
@@ -174,6 +232,7 @@ private:  // Methods
   struct JobData {
     QPointer<Board> board;
     QSet<const Layer*> layers;
+    UnsignedLength simplifyTolerance = UnsignedLength(0);
     QList<PlaneData> planes;
     QList<KeepoutZoneData> keepoutZones;
     QList<PolygonData> polygons;
@@ -182,13 +241,47 @@ private:  // Methods
     QList<std::tuple<Transform, PositiveLength, NonEmptyPath>> holes;
     QList<TraceData> traces;  // Converted to polygons after preprocessing.
     QHash<Uuid, QVector<Path>> result;
+    FilePath fileCacheDir;  ///< Invalid if the persistent cache is disabled
+    qint64 fileCacheMaxSize = 0;
     bool finished = false;
   };
 
+  /// Cut-out of a pad in a plane of the same net signal
+  struct PadCutout {
+    ClipperLib::Paths clearanceArea;  ///< Cut-out without thermal spokes
+    ClipperLib::Paths thermalArea;  ///< Cut-out with spokes subtracted
+    ClipperLib::Paths copperArea;
+    ClipperLib::Paths copperAreaShrinked;
+    ClipperLib::Paths spokesClearanceArea;
+  };
+
+  /// Clipper paths of plane obstacles, keyed by a hash of their geometry
+  typedef QHash<QByteArray, ClipperLib::Paths> ObstacleCache;
+
   std::shared_ptr<JobData> createJob(Board& board,
                                      const QSet<const Layer*>* filter) noexcept;
   std::shared_ptr<JobData> run(std::shared_ptr<JobData> data,
                                bool exceptionOnError);
+  QHash<Uuid, QVector<Path>> buildPlanesOnLayer(
+      const JobData& data, const Layer& layer,
+      const ClipperLib::Paths& boardArea, const ObstacleCache& oldCache,
+      ObstacleCache& newCache, bool exceptionOnError);
+  static QByteArray calcJobKey(const JobData& data) noexcept;
+  static bool loadFromFileCache(const FilePath& fp,
+                                QHash<Uuid, QVector<Path>>& result) noexcept;
+  static void saveToFileCache(
+      const FilePath& fp, const QHash<Uuid, QVector<Path>>& result) noexcept;
+  static void pruneFileCache(const FilePath& dir, const FilePath& keep,
+                             qint64 maxSize) noexcept;
+  static QByteArray calcObstacleKey(const char* type,
+                                    const QVector<Path>& paths,
+                                    const QVector<qint64>& values) noexcept;
+  static QByteArray calcPadObstacleKey(const char* type,
+                                       const Transform& transform,
+                                       const PadGeometry& geometry,
+                                       const QVector<qint64>& values) noexcept;
+  static PadCutout calcPadCutout(const PlaneData& plane, const PadData& pad,
+                                 const PadGeometry& geometry);
   static QVector<std::pair<Point, Angle>> determineThermalSpokes(
       const PadGeometry& geometry) noexcept;
   bool applyToBoard(std::shared_ptr<JobData> data) noexcept;
@@ -204,9 +297,15 @@ private:  // Methods
 
 private:  // Data
   const bool mRebuildAirWires;
+  UnsignedLength mSimplifyTolerance;
+  FilePath mFileCacheDir;
+  qint64 mFileCacheMaxSize;
   QFuture<std::shared_ptr<JobData>> mFuture;
   QFutureWatcher<std::shared_ptr<JobData>> mWatcher;
   bool mAbort;
+
+  /// Obstacles of the last run on each layer, only accessed by the job
+  QHash<const Layer*, ObstacleCache> mObstacleCaches;
 };
 
 /*******************************************************************************
@@ -0,0 +1,256 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardclearancechecker.h"
+
+#include "../../../geometry/stroketext.h"
+#include "../../../library/pkg/footprintpad.h"
+#include "../../../tracer.h"
+#include "../../../utils/clipperhelpers.h"
+#include "../../../utils/transform.h"
+#include "../board.h"
+#include "../items/bi_device.h"
+#include "../items/bi_footprintpad.h"
+#include "../items/bi_netline.h"
+#include "../items/bi_netsegment.h"
+#include "../items/bi_polygon.h"
+#include "../items/bi_stroketext.h"
+#include "../items/bi_via.h"
+#include "boardclipperpathgenerator.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardClearanceChecker::BoardClearanceChecker(Board& board,
+                                             const UnsignedLength& clearance)
+  : mBoard(board), mClearance(clearance), mMaxClearance(*clearance) {
+  Tracer::Span span("drc", "BoardClearanceChecker::BoardClearanceChecker");
+  const QSet<const Layer*> copperLayers = mBoard.getCopperLayers();
+  BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+  auto addObstacle = [this, &gen](const Layer* layer, const BI_Base* item,
+                                  const NetSignal* netSignal,
+                                  const Length& clearance,
+                                  const QVector<Capsule>& capsules) {
+    Obstacle obstacle{item, netSignal, clearance, {}, capsules};
+    gen.takePathsTo(obstacle.copperArea);
+    mLayers[layer].obstacles.append(obstacle);
+    mMaxClearance = std::max(mMaxClearance, clearance);
+  };
+
+  // Net segments.
+  foreach (const BI_NetSegment* netSegment, mBoard.getNetSegments()) {
+    const NetSignal* netSignal = netSegment->getNetSignal();
+    foreach (const BI_Via* via, netSegment->getVias()) {
+      foreach (const Layer* layer, copperLayers) {
+        if (via->getVia().isOnLayer(*layer)) {
+          gen.addVia(*via);  // can throw
+          addObstacle(layer, via, netSignal, *mClearance, getCapsules(*via));
+        }
+      }
+    }
+    foreach (const BI_NetLine* netLine, netSegment->getNetLines()) {
+      if (copperLayers.contains(&netLine->getLayer())) {
+        gen.addNetLine(*netLine);  // can throw
+        addObstacle(&netLine->getLayer(), netLine, netSignal, *mClearance,
+                    getCapsules(*netLine));
+      }
+    }
+  }
+
+  // Board polygons.
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    const BoardPolygonData& data = polygon->getData();
+    if (copperLayers.contains(&data.getLayer())) {
+      gen.addPolygon(data.getPath(), data.getLineWidth(),
+                     data.isFilled());  // can throw
+      addObstacle(&data.getLayer(), polygon, nullptr, *mClearance, {});
+    }
+  }
+
+  // Board stroke texts.
+  foreach (const BI_StrokeText* strokeText, mBoard.getStrokeTexts()) {
+    const Layer& layer = strokeText->getData().getLayer();
+    if (copperLayers.contains(&layer)) {
+      gen.addStrokeText(*strokeText);  // can throw
+      addObstacle(&layer, strokeText, nullptr, *mClearance, {});
+    }
+  }
+
+  // Pads.
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    foreach (const BI_FootprintPad* pad, device->getPads()) {
+      const UnsignedLength padClearance =
+          std::max(mClearance, pad->getLibPad().getCopperClearance());
+      const Transform transform(*pad);
+      foreach (const Layer* layer, copperLayers) {
+        if (pad->isOnLayer(*layer)) {
+          const tl::optional<QVector<Capsule>> capsules =
+              Capsule::fromPadGeometries(pad->getGeometries().value(layer),
+                                         transform);
+          gen.addPad(*pad, *layer);  // can throw
+          addObstacle(layer, pad, pad->getCompSigInstNetSignal(),
+                      *padClearance, capsules.value_or(QVector<Capsule>()));
+        }
+      }
+    }
+  }
+
+  // Build the spatial indices.
+  for (auto it = mLayers.begin(); it != mLayers.end(); ++it) {
+    QVector<ClipperLib::IntRect> bounds;
+    bounds.reserve(it->obstacles.count());
+    for (const Obstacle& obstacle : it->obstacles) {
+      bounds.append(ClipperHelpers::getBounds(obstacle.copperArea));
+    }
+    it->index = SpatialIndex(bounds);
+  }
+}
+
+BoardClearanceChecker::~BoardClearanceChecker() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QVector<Path> BoardClearanceChecker::checkNetLine(
+    const BI_NetLine& netLine) const {
+  QVector<Path> locations;
+  if (const NetSignal* netSignal = netLine.getNetSegment().getNetSignal()) {
+    check(netLine.getLayer(), netSignal, getCapsules(netLine),
+          [&netLine](BoardClipperPathGenerator& gen, const Length& offset) {
+            gen.addNetLine(netLine, offset);
+          },
+          locations);  // can throw
+  }
+  return locations;
+}
+
+QVector<Path> BoardClearanceChecker::checkVia(const BI_Via& via) const {
+  QVector<Path> locations;
+  if (const NetSignal* netSignal = via.getNetSegment().getNetSignal()) {
+    foreach (const Layer* layer, mBoard.getCopperLayers()) {
+      if (via.getVia().isOnLayer(*layer)) {
+        check(*layer, netSignal, getCapsules(via),
+              [&via](BoardClipperPathGenerator& gen, const Length& offset) {
+                gen.addVia(via, offset);
+              },
+              locations);  // can throw
+      }
+    }
+  }
+  return locations;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QVector<Capsule> BoardClearanceChecker::getCapsules(
+    const BI_NetLine& netLine) noexcept {
+  return {Capsule(netLine.getStartPoint().getPosition(),
+                  netLine.getEndPoint().getPosition(),
+                  positiveToUnsigned(netLine.getWidth()))};
+}
+
+QVector<Capsule> BoardClearanceChecker::getCapsules(
+    const BI_Via& via) noexcept {
+  return {Capsule(via.getPosition(), via.getPosition(),
+                  positiveToUnsigned(via.getSize()))};
+}
+
+void BoardClearanceChecker::check(const Layer& layer,
+                                  const NetSignal* netSignal,
+                                  const QVector<Capsule>& capsules,
+                                  const AreaGenerator& generator,
+                                  QVector<Path>& locations) const {
+  auto it = mLayers.find(&layer);
+  if (it == mLayers.end()) {
+    return;
+  }
+
+  // Subtract a tolerance to avoid false-positives due to inaccuracies.
+  const Length tolerance = maxArcTolerance() + Length(1);
+
+  // Only obstacles nearby are relevant. If available, the bounds are
+  // determined from the capsules to avoid flattening the copper area.
+  BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+  ClipperLib::IntRect bounds;
+  if (capsules.isEmpty()) {
+    generator(gen, Length(0));  // can throw
+    ClipperLib::Paths copperArea;
+    gen.takePathsTo(copperArea);
+    bounds = ClipperHelpers::getBounds(copperArea);
+  } else {
+    bounds = capsules.first().getBounds();
+    for (const Capsule& capsule : capsules) {
+      bounds = SpatialIndex::united(bounds, capsule.getBounds());
+    }
+  }
+  bounds = SpatialIndex::inflated(bounds, mMaxClearance.toNm());
+  const PositiveLength locationWidth(std::max(*mClearance, tolerance));
+
+  // The clearance area depends on the obstacle, so create it lazily for each
+  // clearance value (typically only one or two different values).
+  QHash<qint64, ClipperLib::Paths> clearanceAreas;
+  foreach (int index, it->index.query(bounds)) {
+    const Obstacle& obstacle = it->obstacles.at(index);
+    if (obstacle.netSignal == netSignal) {
+      continue;
+    }
+    Point p1, p2;
+    if (const tl::optional<Length> distance = Capsule::getDistance(
+            obstacle.capsules, capsules, &p1, &p2)) {
+      // Compare with the same tolerance as the Clipper check to get
+      // consistent results.
+      if (*distance < (obstacle.clearance - tolerance)) {
+        locations.append(Path::obround(p1, p2, locationWidth));
+      }
+      continue;
+    }
+    const qint64 key = obstacle.clearance.toNm();
+    if (!clearanceAreas.contains(key)) {
+      generator(gen, obstacle.clearance - tolerance);  // can throw
+      gen.takePathsTo(clearanceAreas[key]);
+    }
+    const std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersectToTree(
+            obstacle.copperArea, clearanceAreas.value(key),
+            ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);  // can throw
+    locations +=
+        ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections));
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_BOARDCLEARANCECHECKER_H
+#define LIBREPCB_CORE_BOARDCLEARANCECHECKER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../../geometry/path.h"
+#include "../../../types/length.h"
+#include "../../../utils/capsule.h"
+#include "../../../utils/spatialindex.h"
+
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class BI_Base;
+class BI_NetLine;
+class BI_Via;
+class Board;
+class BoardClipperPathGenerator;
+class Layer;
+class NetSignal;
+
+/*******************************************************************************
+ *  Class BoardClearanceChecker
+ ******************************************************************************/
+
+/**
+ * @brief Fast online check of copper clearances for single items
+ *
+ * In contrast to ::librepcb::BoardDesignRuleCheck, which checks the whole
+ * board at once, this class is intended for interactive tools like drawing
+ * traces. The copper areas of all existing net lines, vias, pads, polygons
+ * and stroke texts are determined once on construction and stored in a
+ * spatial index per copper layer. Afterwards, an item can be checked with a
+ * local query which only evaluates the obstacles nearby.
+ *
+ * Pairs of objects which are representable as ::librepcb::Capsule (vias,
+ * traces, round and obround pads) are checked analytically, only the other
+ * pairs are checked by intersecting their (flattened) areas with Clipper.
+ *
+ * Obstacles of the same net signal as the checked item are ignored, and items
+ * without net signal are not checked at all. Planes are ignored too since
+ * they are re-filled around new traces anyway.
+ *
+ * @note The obstacles are not updated when the board is modified, so a new
+ *       checker needs to be created after modifications of other nets.
+ */
+class BoardClearanceChecker final {
+public:
+  // Constructors / Destructor
+  BoardClearanceChecker() = delete;
+  BoardClearanceChecker(const BoardClearanceChecker& other) = delete;
+  BoardClearanceChecker(Board& board, const UnsignedLength& clearance);
+  ~BoardClearanceChecker() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Check a net line for clearance violations
+   *
+   * @param netLine   The net line to check.
+   *
+   * @return Locations of all violations (empty if there are none).
+   */
+  QVector<Path> checkNetLine(const BI_NetLine& netLine) const;
+
+  /**
+   * @brief Check a via for clearance violations
+   *
+   * @param via   The via to check.
+   *
+   * @return Locations of all violations (empty if there are none).
+   */
+  QVector<Path> checkVia(const BI_Via& via) const;
+
+  // Operator Overloadings
+  BoardClearanceChecker& operator=(const BoardClearanceChecker& rhs) = delete;
+
+private:  // Types
+  struct Obstacle {
+    const BI_Base* item;
+    const NetSignal* netSignal;  ///< `nullptr` if not connected to any net
+    Length clearance;  ///< Required clearance (at least the global one)
+    ClipperLib::Paths copperArea;
+    QVector<Capsule> capsules;  ///< Empty if not representable by capsules
+  };
+  struct LayerObstacles {
+    QVector<Obstacle> obstacles;
+    SpatialIndex index;
+  };
+  typedef std::function<void(BoardClipperPathGenerator& gen,
+                             const Length& offset)>
+      AreaGenerator;
+
+private:  // Methods
+  void check(const Layer& layer, const NetSignal* netSignal,
+             const QVector<Capsule>& capsules, const AreaGenerator& generator,
+             QVector<Path>& locations) const;
+  static QVector<Capsule> getCapsules(const BI_NetLine& netLine) noexcept;
+  static QVector<Capsule> getCapsules(const BI_Via& via) noexcept;
+
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs.
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
+
+private:  // Data
+  Board& mBoard;
+  const UnsignedLength mClearance;
+  Length mMaxClearance;  ///< Maximum clearance of all obstacles
+  QHash<const Layer*, LayerObstacles> mLayers;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
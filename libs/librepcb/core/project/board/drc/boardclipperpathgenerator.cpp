@@ -287,10 +287,11 @@ void BoardClipperPathGenerator::addPolygon(const Path& path,
   // Outline.
   const Length totalWidth = lineWidth + offset * 2;
   if ((lineWidth > 0) && (totalWidth > 0)) {
-    QVector<Path> paths = path.toOutlineStrokes(PositiveLength(totalWidth));
-    ClipperHelpers::unite(mPaths,
-                          ClipperHelpers::convert(paths, mMaxArcTolerance),
-                          ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+    ClipperHelpers::unite(
+        mPaths,
+        ClipperHelpers::convertStrokes(path, PositiveLength(totalWidth),
+                                       mMaxArcTolerance),
+        ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
   }
 
   // Area (only fill closed paths, for consistency with the appearance in
@@ -315,11 +316,11 @@ void BoardClipperPathGenerator::addCircle(const Circle& circle,
 
   // Outline.
   if (circle.getLineWidth() > 0) {
-    QVector<Path> paths =
-        path.toOutlineStrokes(PositiveLength(*circle.getLineWidth()));
-    ClipperHelpers::unite(mPaths,
-                          ClipperHelpers::convert(paths, mMaxArcTolerance),
-                          ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+    ClipperHelpers::unite(
+        mPaths,
+        ClipperHelpers::convertStrokes(
+            path, PositiveLength(*circle.getLineWidth()), mMaxArcTolerance),
+        ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
   }
 
   // Area.
@@ -335,11 +336,12 @@ void BoardClipperPathGenerator::addStrokeText(const BI_StrokeText& strokeText,
   const PositiveLength width(
       qMax(*strokeText.getData().getStrokeWidth() + (offset * 2), Length(1)));
   const Transform transform(strokeText.getData());
-  foreach (const Path path, transform.map(strokeText.getPaths())) {
-    QVector<Path> paths = path.toOutlineStrokes(width);
-    ClipperHelpers::unite(mPaths,
-                          ClipperHelpers::convert(paths, mMaxArcTolerance),
-                          ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+  foreach (const Path& path, strokeText.getPaths()) {
+    ClipperHelpers::unite(
+        mPaths,
+        ClipperHelpers::convertStrokes(transform.map(path), width,
+                                       mMaxArcTolerance),
+        ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
   }
 }
 
@@ -350,8 +352,8 @@ void BoardClipperPathGenerator::addHole(const PositiveLength& diameter,
   const PositiveLength width(std::max(*diameter + offset + offset, Length(1)));
   ClipperHelpers::unite(
       mPaths,
-      ClipperHelpers::convert(transform.map(*path).toOutlineStrokes(width),
-                              mMaxArcTolerance),
+      ClipperHelpers::convertStrokes(transform.map(*path), width,
+                                     mMaxArcTolerance),
       ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
 }
 
@@ -372,12 +374,11 @@ void BoardClipperPathGenerator::addPad(const BI_FootprintPad& pad,
     // Also add each hole to ensure correct copper areas even if
     // the pad outline is too small or invalid.
     for (const PadHole& hole : geometry.getHoles()) {
-      ClipperHelpers::unite(mPaths,
-                            ClipperHelpers::convert(
-                                transform.map(hole.getPath()->toOutlineStrokes(
-                                    hole.getDiameter())),
-                                mMaxArcTolerance),
-                            ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+      ClipperHelpers::unite(
+          mPaths,
+          ClipperHelpers::convertStrokes(transform.map(*hole.getPath()),
+                                         hole.getDiameter(), mMaxArcTolerance),
+          ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
     }
   }
 }
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boarddesignrulecheck.h"
 
+#include "../../../exceptions.h"
 #include "../../../geometry/hole.h"
 #include "../../../geometry/stroketext.h"
 #include "../../../library/cmp/component.h"
@@ -29,7 +30,13 @@
 #include "../../../library/pkg/footprint.h"
 #include "../../../library/pkg/footprintpad.h"
 #include "../../../library/pkg/packagepad.h"
+#include "../../../tracer.h"
+#include "../../../utils/cachekeybuilder.h"
+#include "../../../utils/capsule.h"
 #include "../../../utils/clipperhelpers.h"
+#include "../../../utils/concurrency.h"
+#include "../../../utils/scopeguard.h"
+#include "../../../utils/spatialindex.h"
 #include "../../../utils/toolbox.h"
 #include "../../../utils/transform.h"
 #include "../../circuit/circuit.h"
@@ -52,6 +59,7 @@
 #include "../items/bi_zone.h"
 #include "boardclipperpathgenerator.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -59,6 +67,9 @@
  ******************************************************************************/
 namespace librepcb {
 
+thread_local BoardDesignRuleCheck::CheckResult*
+    BoardDesignRuleCheck::sCurrentResult = nullptr;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -69,58 +80,141 @@ BoardDesignRuleCheck::BoardDesignRuleCheck(
   : QObject(parent),
     mBoard(board),
     mSettings(settings),
+    mParallelExecution(true),
+    mAbort(false),
+    mCache(),
+    mRegion(),
     mIgnorePlanes(false),
+    mMaxArcTolerance(BoardDesignRuleCheckSettings::getFullProfile()
+                         .maxArcTolerance),
     mProgressPercent(0),
     mProgressStatus(),
-    mMessages() {
+    mMessages(),
+    mTimings() {
 }
 
 BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void BoardDesignRuleCheck::setRegion(const QVector<Path>& region) noexcept {
+  // Items that close to the region may cause violations within the region.
+  const Length margin = std::max({
+      *mSettings.getMinCopperCopperClearance(),
+      *mSettings.getMinCopperBoardClearance(),
+      *mSettings.getMinCopperNpthClearance(),
+      *mSettings.getMinDrillDrillClearance(),
+      *mSettings.getMinDrillBoardClearance(),
+      *mSettings.getMinSilkscreenStopmaskClearance(),
+  });
+  mRegion.clear();
+  foreach (const Path& path, region) {
+    const ClipperLib::IntRect bounds = ClipperHelpers::getBounds(
+        ClipperHelpers::convert(path, maxArcTolerance()));
+    if (SpatialIndex::isValid(bounds)) {
+      mRegion.append(SpatialIndex::inflated(bounds, margin.toNm()));
+    }
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
 void BoardDesignRuleCheck::execute(bool quick) {
+  execute(quick
+              ? BoardDesignRuleCheckSettings::getQuickProfile()
+              : BoardDesignRuleCheckSettings::getFullProfile());  // can throw
+}
+
+void BoardDesignRuleCheck::execute(
+    const BoardDesignRuleCheckSettings::Profile& profile) {
+  Tracer::Span span("drc", "BoardDesignRuleCheck::execute",
+                    *mBoard.getName());
   emit started();
   emitProgress(2);
 
-  mIgnorePlanes = quick;
+  mAbort = false;
+  mIgnorePlanes = !profile.planes;
+  mMaxArcTolerance = profile.maxArcTolerance;
   mProgressStatus.clear();
   mMessages.clear();
+  mTimings.clear();
 
-  if (!quick) {
+  if (profile.planes) {
+    QElapsedTimer timer;
+    timer.start();
     rebuildPlanes(12);  // 10%
+    mTimings.append(CheckTiming{"rebuild_planes", timer.nsecsElapsed(), 0});
+    throwIfCanceled();  // can throw
   }
 
-  checkMinimumCopperWidth(14);  // 2%
-  checkCopperCopperClearances(24);  // 10%
-  checkCopperBoardClearances(34);  // 10%
-  checkCopperHoleClearances(44);  // 10%
-
-  if (!quick) {
-    checkDrillDrillClearances(48);  // 4%
-    checkDrillBoardClearances(52);  // 4%
-    checkSilkscreenStopmaskClearances(56);  // 4%
-    checkMinimumPthAnnularRing(59);  // 3%
-    checkMinimumNpthDrillDiameter(61);  // 2%
-    checkMinimumNpthSlotWidth(63);  // 2%
-    checkMinimumPthDrillDiameter(65);  // 2%
-    checkMinimumPthSlotWidth(67);  // 2%
-    checkMinimumSilkscreenWidth(68);  // 1%
-    checkMinimumSilkscreenTextHeight(69);  // 1%
-    checkZones(72);  // 3%
-    checkVias(74);  // 2%
-    checkAllowedNpthSlots(75);  // 1%
-    checkAllowedPthSlots(76);  // 1%
-    checkInvalidPadConnections(78);  // 2%
-    checkDeviceClearances(88);  // 10%
-    checkBoardOutline(91);  // 3%
-    checkForUnplacedComponents(93);  // 2%
-    checkForMissingConnections(95);  // 2%
-    checkForStaleObjects(97);  // 2%
-  }
+  QVector<Check> checks;
+  auto addCheck = [&checks, &profile](
+                      const char* name,
+                      void (BoardDesignRuleCheck::*function)(int),
+                      int progressEnd) {
+    if (profile.runsCheck(name)) {
+      checks.append(Check{name, function, progressEnd, true});
+    }
+  };
+  addCheck("minimum_copper_width",
+           &BoardDesignRuleCheck::checkMinimumCopperWidth, 14);  // 2%
+  addCheck("copper_copper_clearances",
+           &BoardDesignRuleCheck::checkCopperCopperClearances, 24);  // 10%
+  addCheck("copper_board_clearances",
+           &BoardDesignRuleCheck::checkCopperBoardClearances, 34);  // 10%
+  addCheck("copper_hole_clearances",
+           &BoardDesignRuleCheck::checkCopperHoleClearances, 44);  // 10%
+  addCheck("drill_drill_clearances",
+           &BoardDesignRuleCheck::checkDrillDrillClearances, 48);  // 4%
+  addCheck("drill_board_clearances",
+           &BoardDesignRuleCheck::checkDrillBoardClearances, 52);  // 4%
+  addCheck("silkscreen_stopmask_clearances",
+           &BoardDesignRuleCheck::checkSilkscreenStopmaskClearances,
+           56);  // 4%
+  addCheck("minimum_pth_annular_ring",
+           &BoardDesignRuleCheck::checkMinimumPthAnnularRing, 59);  // 3%
+  addCheck("minimum_npth_drill_diameter",
+           &BoardDesignRuleCheck::checkMinimumNpthDrillDiameter, 61);  // 2%
+  addCheck("minimum_npth_slot_width",
+           &BoardDesignRuleCheck::checkMinimumNpthSlotWidth, 63);  // 2%
+  addCheck("minimum_pth_drill_diameter",
+           &BoardDesignRuleCheck::checkMinimumPthDrillDiameter, 65);  // 2%
+  addCheck("minimum_pth_slot_width",
+           &BoardDesignRuleCheck::checkMinimumPthSlotWidth, 67);  // 2%
+  addCheck("minimum_silkscreen_width",
+           &BoardDesignRuleCheck::checkMinimumSilkscreenWidth, 68);  // 1%
+  addCheck("minimum_silkscreen_text_height",
+           &BoardDesignRuleCheck::checkMinimumSilkscreenTextHeight,
+           69);  // 1%
+  addCheck("zones", &BoardDesignRuleCheck::checkZones, 72);  // 3%
+  addCheck("vias", &BoardDesignRuleCheck::checkVias, 74);  // 2%
+  addCheck("allowed_npth_slots",
+           &BoardDesignRuleCheck::checkAllowedNpthSlots, 75);  // 1%
+  addCheck("allowed_pth_slots",
+           &BoardDesignRuleCheck::checkAllowedPthSlots, 76);  // 1%
+  addCheck("invalid_pad_connections",
+           &BoardDesignRuleCheck::checkInvalidPadConnections, 78);  // 2%
+  addCheck("device_clearances",
+           &BoardDesignRuleCheck::checkDeviceClearances, 88);  // 10%
+  addCheck("board_outline",
+           &BoardDesignRuleCheck::checkBoardOutline, 91);  // 3%
+  addCheck("unplaced_components",
+           &BoardDesignRuleCheck::checkForUnplacedComponents, 93);  // 2%
+  // Rebuilds airwires, thus must not run concurrently with other checks.
+  if (profile.runsCheck("missing_connections")) {
+    checks.append(Check{"missing_connections",
+                        &BoardDesignRuleCheck::checkForMissingConnections, 95,
+                        false});  // 2%
+  }
+  addCheck("stale_objects",
+           &BoardDesignRuleCheck::checkForStaleObjects, 97);  // 2%
+
+  runChecks(checks);  // can throw
 
   emitStatus(
       tr("Finished with %1 message(s)!", "Count of messages", mMessages.count())
@@ -133,9 +227,86 @@ void BoardDesignRuleCheck::execute(bool quick) {
  *  Private Methods
  ******************************************************************************/
 
+void BoardDesignRuleCheck::runChecks(const QVector<Check>& checks) {
+  if (!mParallelExecution) {
+    foreach (const Check& check, checks) {
+      throwIfCanceled();  // can throw
+      const int messageCount = mMessages.count();
+      QElapsedTimer timer;
+      timer.start();
+      (this->*check.function)(check.progressEnd);  // can throw
+      mTimings.append(CheckTiming{check.name, timer.nsecsElapsed(),
+                                  mMessages.count() - messageCount});
+    }
+    return;
+  }
+
+  // Make sure all workers have finished before leaving this scope since they
+  // access the results and the board.
+  QVector<CheckResult> results(checks.count());
+  QVector<QFuture<void>> futures(checks.count());
+  auto futuresGuard = Concurrency::waitOnScopeExit(futures);
+
+  // Checks which modify the board need to run before the concurrent checks
+  // are started. Their results are emitted in the original order anyway.
+  for (int i = 0; i < checks.count(); ++i) {
+    if (!checks.at(i).concurrent) {
+      throwIfCanceled();  // can throw
+      runCheck(checks.at(i), results[i]);  // can throw
+    }
+  }
+  for (int i = 0; i < checks.count(); ++i) {
+    if (checks.at(i).concurrent) {
+      const Check check = checks.at(i);
+      CheckResult* result = &results[i];
+      futures[i] = QtConcurrent::run([this, check, result]() {
+        if (!mAbort) {
+          runCheck(check, *result);
+        }
+      });
+    }
+  }
+
+  // Merge results in a deterministic order, independent of the order in which
+  // the checks have finished.
+  for (int i = 0; i < checks.count(); ++i) {
+    futures[i].waitForFinished();  // can throw
+    throwIfCanceled();  // can throw
+    foreach (const QString& status, results.at(i).status) {
+      emitStatus(status);
+    }
+    foreach (const auto& msg, results.at(i).messages) {
+      emitMessage(msg);
+    }
+    mTimings.append(CheckTiming{checks.at(i).name, results.at(i).durationNs,
+                                results.at(i).messages.count()});
+    emitProgress(checks.at(i).progressEnd);
+  }
+}
+
+void BoardDesignRuleCheck::runCheck(const Check& check, CheckResult& result) {
+  Q_ASSERT(!sCurrentResult);
+  sCurrentResult = &result;
+  auto sg = scopeGuard([]() { sCurrentResult = nullptr; });
+  Tracer::Span span("drc", "BoardDesignRuleCheck::runCheck", check.name);
+  QElapsedTimer timer;
+  timer.start();
+  (this->*check.function)(check.progressEnd);  // can throw
+  result.durationNs = timer.nsecsElapsed();
+}
+
+void BoardDesignRuleCheck::throwIfCanceled() const {
+  if (mAbort) {
+    throw UserCanceled(__FILE__, __LINE__);
+  }
+}
+
 void BoardDesignRuleCheck::rebuildPlanes(int progressEnd) {
   emitStatus(tr("Rebuild planes..."));
+  // Always calculate the planes instead of restoring them from the persistent
+  // cache, which also keeps benchmarks of the DRC meaningful.
   BoardPlaneFragmentsBuilder builder;
+  builder.setFileCache(FilePath());
   builder.runSynchronously(mBoard);  // can throw
   emitProgress(progressEnd);
 }
@@ -151,7 +322,8 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
   // Subtract a tolerance to avoid false-positives due to inaccuracies.
   const Length tolerance = maxArcTolerance() + Length(1);
 
-  // Determine the area of each copper object.
+  // Determine the area of each copper object. Areas of items which did not
+  // change since the last run are taken from the cache, if available.
   struct Item {
     const BI_Base* item;
     const Polygon* polygon;  // Only relevant if item is a BI_Device
@@ -160,50 +332,72 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
     const Layer* endLayer;
     const NetSignal* netSignal;  // nullptr = no net
     Length clearance;
+    QByteArray key;  // Fingerprint of the geometry, used for the cache
     ClipperLib::Paths copperArea;  // Exact copper outlines
     ClipperLib::Paths clearanceArea;  // Copper outlines + clearance - tolerance
+    QVector<Capsule> capsules;  // Exact copper area, empty if not available
   };
   typedef QVector<Item> Items;
   Items items;
+  BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+  auto addItem = [this, &items](Item item, const QByteArray& key,
+                                const std::function<void(Item&)>& generate) {
+    item.key = key;
+    if (mCache && mCache->itemAreas.contains(key)) {
+      const auto areas = mCache->itemAreas.value(key);
+      item.copperArea = areas.first;
+      item.clearanceArea = areas.second;
+    } else {
+      generate(item);  // can throw
+    }
+    items.append(item);
+  };
+  auto offsetCopperArea = [this, &clearance, &tolerance](Item& item) {
+    item.clearanceArea = item.copperArea;
+    ClipperHelpers::offset(item.clearanceArea, clearance - tolerance,
+                           maxArcTolerance());
+  };
 
   // Net segments.
-  BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
   foreach (const BI_NetSegment* netSegment, mBoard.getNetSegments()) {
     // vias.
     foreach (const BI_Via* via, netSegment->getVias()) {
-      auto it = items.insert(items.end(),
-                             Item{via,
-                                  nullptr,
-                                  nullptr,
-                                  &via->getVia().getStartLayer(),
-                                  &via->getVia().getEndLayer(),
-                                  via->getNetSegment().getNetSignal(),
-                                  *clearance,
-                                  {},
-                                  {}});
-      gen.addVia(*via);
-      gen.takePathsTo(it->copperArea);
-      gen.addVia(*via, clearance - tolerance);
-      gen.takePathsTo(it->clearanceArea);
+      const QVector<Capsule> capsules{Capsule(
+          via->getPosition(), via->getPosition(),
+          positiveToUnsigned(via->getSize()))};
+      addItem(Item{via, nullptr, nullptr, &via->getVia().getStartLayer(),
+                   &via->getVia().getEndLayer(),
+                   via->getNetSegment().getNetSignal(), *clearance, {}, {},
+                   {}, capsules},
+              calcCacheKey("via", {via->getVia().getSceneOutline()},
+                           {clearance->toNm()}),
+              [&](Item& item) {
+                gen.addVia(*via);
+                gen.takePathsTo(item.copperArea);
+                gen.addVia(*via, clearance - tolerance);
+                gen.takePathsTo(item.clearanceArea);
+              });
     }
 
     // Net lines.
     foreach (const BI_NetLine* netLine, netSegment->getNetLines()) {
       if (mBoard.getCopperLayers().contains(&netLine->getLayer())) {
-        auto it = items.insert(items.end(),
-                               Item{netLine,
-                                    nullptr,
-                                    nullptr,
-                                    &netLine->getLayer(),
-                                    &netLine->getLayer(),
-                                    netLine->getNetSegment().getNetSignal(),
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addNetLine(*netLine);
-        gen.takePathsTo(it->copperArea);
-        gen.addNetLine(*netLine, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
+        const QVector<Capsule> capsules{
+            Capsule(netLine->getStartPoint().getPosition(),
+                    netLine->getEndPoint().getPosition(),
+                    positiveToUnsigned(netLine->getWidth()))};
+        addItem(Item{netLine, nullptr, nullptr, &netLine->getLayer(),
+                     &netLine->getLayer(),
+                     netLine->getNetSegment().getNetSignal(), *clearance, {},
+                     {}, {}, capsules},
+                calcCacheKey("netline", {netLine->getSceneOutline()},
+                             {clearance->toNm()}),
+                [&](Item& item) {
+                  gen.addNetLine(*netLine);
+                  gen.takePathsTo(item.copperArea);
+                  gen.addNetLine(*netLine, clearance - tolerance);
+                  gen.takePathsTo(item.clearanceArea);
+                });
       }
     }
   }
@@ -212,65 +406,58 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
   if (!mIgnorePlanes) {
     foreach (const BI_Plane* plane, mBoard.getPlanes()) {
       if (mBoard.getCopperLayers().contains(&plane->getLayer())) {
-        auto it = items.insert(items.end(),
-                               Item{plane,
-                                    nullptr,
-                                    nullptr,
-                                    &plane->getLayer(),
-                                    &plane->getLayer(),
-                                    plane->getNetSignal(),
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addPlane(*plane);
-        gen.takePathsTo(it->copperArea);
-        it->clearanceArea = it->copperArea;
-        ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                               maxArcTolerance());
+        addItem(Item{plane, nullptr, nullptr, &plane->getLayer(),
+                     &plane->getLayer(), plane->getNetSignal(), *clearance, {},
+                     {}, {}, {}},
+                calcCacheKey("plane", plane->getFragments(),
+                             {clearance->toNm()}),
+                [&](Item& item) {
+                  gen.addPlane(*plane);
+                  gen.takePathsTo(item.copperArea);
+                  offsetCopperArea(item);
+                });
       }
     }
   }
 
   // Board polygons.
   foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
-    if (mBoard.getCopperLayers().contains(&polygon->getData().getLayer())) {
-      auto it = items.insert(items.end(),
-                             Item{polygon,
-                                  nullptr,
-                                  nullptr,
-                                  &polygon->getData().getLayer(),
-                                  &polygon->getData().getLayer(),
-                                  nullptr,
-                                  *clearance,
-                                  {},
-                                  {}});
-      gen.addPolygon(polygon->getData().getPath(),
-                     polygon->getData().getLineWidth(),
-                     polygon->getData().isFilled());
-      gen.takePathsTo(it->copperArea);
-      it->clearanceArea = it->copperArea;
-      ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                             maxArcTolerance());
+    const BoardPolygonData& data = polygon->getData();
+    if (mBoard.getCopperLayers().contains(&data.getLayer())) {
+      addItem(Item{polygon, nullptr, nullptr, &data.getLayer(),
+                   &data.getLayer(), nullptr, *clearance, {}, {}, {}, {}},
+              calcCacheKey("polygon", {data.getPath()},
+                           {data.getLineWidth()->toNm(), data.isFilled(),
+                            clearance->toNm()}),
+              [&](Item& item) {
+                gen.addPolygon(data.getPath(), data.getLineWidth(),
+                               data.isFilled());
+                gen.takePathsTo(item.copperArea);
+                offsetCopperArea(item);
+              });
     }
   }
 
+  // Stroke texts.
+  auto addStrokeText = [&](const BI_StrokeText* strokeText) {
+    const StrokeText& data = strokeText->getData();
+    addItem(Item{strokeText, nullptr, nullptr, &data.getLayer(),
+                 &data.getLayer(), nullptr, *clearance, {}, {}, {}, {}},
+            calcCacheKey("stroketext",
+                         Transform(data).map(strokeText->getPaths()),
+                         {data.getStrokeWidth()->toNm(), clearance->toNm()}),
+            [&](Item& item) {
+              gen.addStrokeText(*strokeText);
+              gen.takePathsTo(item.copperArea);
+              gen.addStrokeText(*strokeText, clearance - tolerance);
+              gen.takePathsTo(item.clearanceArea);
+            });
+  };
+
   // Board stroke texts.
   foreach (const BI_StrokeText* strokeText, mBoard.getStrokeTexts()) {
     if (mBoard.getCopperLayers().contains(&strokeText->getData().getLayer())) {
-      auto it = items.insert(items.end(),
-                             Item{strokeText,
-                                  nullptr,
-                                  nullptr,
-                                  &strokeText->getData().getLayer(),
-                                  &strokeText->getData().getLayer(),
-                                  nullptr,
-                                  *clearance,
-                                  {},
-                                  {}});
-      gen.addStrokeText(*strokeText);
-      gen.takePathsTo(it->copperArea);
-      gen.addStrokeText(*strokeText, clearance - tolerance);
-      gen.takePathsTo(it->clearanceArea);
+      addStrokeText(strokeText);
     }
   }
 
@@ -282,22 +469,33 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
     foreach (const BI_FootprintPad* pad, device->getPads()) {
       const UnsignedLength padClearance =
           std::max(clearance, pad->getLibPad().getCopperClearance());
+      const Transform padTransform(*pad);
       foreach (const Layer* layer, mBoard.getCopperLayers()) {
         if (pad->isOnLayer(*layer)) {
-          auto it = items.insert(items.end(),
-                                 Item{pad,
-                                      nullptr,
-                                      nullptr,
-                                      layer,
-                                      layer,
-                                      pad->getCompSigInstNetSignal(),
-                                      *padClearance,
-                                      {},
-                                      {}});
-          gen.addPad(*pad, *layer);
-          gen.takePathsTo(it->copperArea);
-          gen.addPad(*pad, *layer, padClearance - tolerance);
-          gen.takePathsTo(it->clearanceArea);
+          QVector<Path> keyPaths;
+          QVector<qint64> keyValues{padClearance->toNm()};
+          foreach (const PadGeometry& geometry,
+                   pad->getGeometries().value(layer)) {
+            keyPaths += padTransform.map(geometry.toOutlines());
+            keyValues.append(static_cast<qint64>(geometry.getShape()));
+            for (const PadHole& hole : geometry.getHoles()) {
+              keyPaths.append(padTransform.map(*hole.getPath()));
+              keyValues.append(hole.getDiameter()->toNm());
+            }
+          }
+          const tl::optional<QVector<Capsule>> capsules =
+              Capsule::fromPadGeometries(pad->getGeometries().value(layer),
+                                         padTransform);
+          addItem(Item{pad, nullptr, nullptr, layer, layer,
+                       pad->getCompSigInstNetSignal(), *padClearance, {}, {},
+                       {}, capsules.value_or(QVector<Capsule>())},
+                  calcCacheKey("pad", keyPaths, keyValues),
+                  [&](Item& item) {
+                    gen.addPad(*pad, *layer);
+                    gen.takePathsTo(item.copperArea);
+                    gen.addPad(*pad, *layer, padClearance - tolerance);
+                    gen.takePathsTo(item.clearanceArea);
+                  });
         }
       }
     }
@@ -306,22 +504,18 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
     for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
       if (mBoard.getCopperLayers().contains(
               &transform.map(polygon.getLayer()))) {
-        auto it = items.insert(items.end(),
-                               Item{device,
-                                    &polygon,
-                                    nullptr,
-                                    &polygon.getLayer(),
-                                    &polygon.getLayer(),
-                                    nullptr,
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addPolygon(transform.map(polygon.getPath()), polygon.getLineWidth(),
-                       polygon.isFilled());
-        gen.takePathsTo(it->copperArea);
-        it->clearanceArea = it->copperArea;
-        ClipperHelpers::offset(it->clearanceArea, clearance - tolerance,
-                               maxArcTolerance());
+        const Path path = transform.map(polygon.getPath());
+        addItem(Item{device, &polygon, nullptr, &polygon.getLayer(),
+                     &polygon.getLayer(), nullptr, *clearance, {}, {}, {}, {}},
+                calcCacheKey("polygon", {path},
+                             {polygon.getLineWidth()->toNm(),
+                              polygon.isFilled(), clearance->toNm()}),
+                [&](Item& item) {
+                  gen.addPolygon(path, polygon.getLineWidth(),
+                                 polygon.isFilled());
+                  gen.takePathsTo(item.copperArea);
+                  offsetCopperArea(item);
+                });
       }
     }
 
@@ -329,20 +523,20 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
     for (const Circle& circle : device->getLibFootprint().getCircles()) {
       if (mBoard.getCopperLayers().contains(
               &transform.map(circle.getLayer()))) {
-        auto it = items.insert(items.end(),
-                               Item{device,
-                                    nullptr,
-                                    &circle,
-                                    &circle.getLayer(),
-                                    &circle.getLayer(),
-                                    nullptr,
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addCircle(circle, transform);
-        gen.takePathsTo(it->copperArea);
-        gen.addCircle(circle, transform, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
+        const Point center = transform.map(circle.getCenter());
+        addItem(Item{device, nullptr, &circle, &circle.getLayer(),
+                     &circle.getLayer(), nullptr, *clearance, {}, {}, {}, {}},
+                calcCacheKey("circle", {},
+                             {center.getX().toNm(), center.getY().toNm(),
+                              circle.getDiameter()->toNm(),
+                              circle.getLineWidth()->toNm(), circle.isFilled(),
+                              clearance->toNm()}),
+                [&](Item& item) {
+                  gen.addCircle(circle, transform);
+                  gen.takePathsTo(item.copperArea);
+                  gen.addCircle(circle, transform, clearance - tolerance);
+                  gen.takePathsTo(item.clearanceArea);
+                });
       }
     }
 
@@ -351,33 +545,19 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
       // Layer does not need to be transformed!
       if (mBoard.getCopperLayers().contains(
               &strokeText->getData().getLayer())) {
-        auto it = items.insert(items.end(),
-                               Item{strokeText,
-                                    nullptr,
-                                    nullptr,
-                                    &strokeText->getData().getLayer(),
-                                    &strokeText->getData().getLayer(),
-                                    nullptr,
-                                    *clearance,
-                                    {},
-                                    {}});
-        gen.addStrokeText(*strokeText);
-        gen.takePathsTo(it->copperArea);
-        gen.addStrokeText(*strokeText, clearance - tolerance);
-        gen.takePathsTo(it->clearanceArea);
+        addStrokeText(strokeText);
       }
     }
   }
 
   // Now check for intersections.
-  QVector<const Layer*> overlappingLayers;
-  auto layersOverlap = [this, &overlappingLayers](
-                           const Layer* start1, const Layer* end1,
-                           const Layer* start2, const Layer* end2) {
+  auto layersOverlap = [this](const Item& item1, const Item& item2,
+                              QVector<const Layer*>& overlappingLayers) {
     overlappingLayers.clear();
-    const int first =
-        std::max(start1->getCopperNumber(), start2->getCopperNumber());
-    const int last = std::min(end1->getCopperNumber(), end2->getCopperNumber());
+    const int first = std::max(item1.startLayer->getCopperNumber(),
+                               item2.startLayer->getCopperNumber());
+    const int last = std::min(item1.endLayer->getCopperNumber(),
+                              item2.endLayer->getCopperNumber());
     for (int i = first; i <= last; ++i) {
       const Layer* layer = Layer::copper(i);
       if (mBoard.getCopperLayers().contains(layer) &&
@@ -387,39 +567,162 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
     }
     return !overlappingLayers.isEmpty();
   };
-  auto checkForIntersections = [](Items::Iterator& it1, Items::Iterator& it2,
+  auto checkForIntersections = [](const Item& item1, const Item& item2,
                                   QVector<Path>& locations) {
     const std::unique_ptr<ClipperLib::PolyTree> intersections =
-        ClipperHelpers::intersectToTree(it1->copperArea, it2->clearanceArea,
+        ClipperHelpers::intersectToTree(item1.copperArea, item2.clearanceArea,
                                         ClipperLib::pftEvenOdd,
                                         ClipperLib::pftEvenOdd);
     locations.append(
-        ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections)));
+        ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections));
   };
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      if (((it1->netSignal != it2->netSignal) || (!it1->netSignal) ||
-           (!it2->netSignal)) &&
-          layersOverlap(it1->startLayer, it1->endLayer, it2->startLayer,
-                        it2->endLayer)) {
+
+  // Only pairs of items with overlapping bounding rectangles on at least one
+  // layer can intersect, so determine them with a spatial index per layer.
+  // Each layer is an independent work item, and pairs spanning several layers
+  // are only checked on their lowest common layer.
+  QVector<ClipperLib::IntRect> bounds;
+  bounds.reserve(items.count());
+  for (const Item& item : items) {
+    bounds.append(
+        SpatialIndex::united(ClipperHelpers::getBounds(item.copperArea),
+                             ClipperHelpers::getBounds(item.clearanceArea)));
+  }
+  struct PairResult {
+    std::pair<int, int> items;
+    QVector<const Layer*> layers;
+    QVector<Path> locations;  // Empty if there is no violation
+  };
+  const BoardDesignRuleCheckCache* cache = mCache.get();
+  auto checkLayer = [this, &items, &bounds, &tolerance, &layersOverlap,
+                     &checkForIntersections, cache](const Layer* layer) {
+    QVector<int> layerItems;
+    QVector<ClipperLib::IntRect> layerBounds;
+    for (int i = 0; i < items.count(); ++i) {
+      // Violations are located within the bounds of both items, so pairs
+      // with any item outside the region can be skipped.
+      if ((items.at(i).startLayer->getCopperNumber() <=
+           layer->getCopperNumber()) &&
+          (items.at(i).endLayer->getCopperNumber() >=
+           layer->getCopperNumber()) &&
+          isInRegion(bounds.at(i))) {
+        layerItems.append(i);
+        layerBounds.append(bounds.at(i));
+      }
+    }
+    QVector<PairResult> results;
+    QVector<const Layer*> overlappingLayers;
+    const SpatialIndex index(layerBounds);
+    for (const auto& pair : index.findOverlappingPairs()) {
+      const Item& item1 = items.at(layerItems.at(pair.first));
+      const Item& item2 = items.at(layerItems.at(pair.second));
+      if (((item1.netSignal != item2.netSignal) || (!item1.netSignal) ||
+           (!item2.netSignal)) &&
+          layersOverlap(item1, item2, overlappingLayers) &&
+          (overlappingLayers.first() == layer)) {
+        // Pairs of unmodified items don't need to be checked again.
+        const QByteArray pairKey = item1.key + item2.key;
         QVector<Path> locations;
-        checkForIntersections(it1, it2, locations);
-        // Perform the check the other way around only if:
-        //  - Either the two items have individual clearances
-        //  - Or there are any intersections -> show both violations in UI
-        if ((it1->clearance != it2->clearance) || (!locations.isEmpty())) {
-          checkForIntersections(it2, it1, locations);
+        Point p1, p2;
+        if (cache && cache->intersections.contains(pairKey)) {
+          locations = cache->intersections.value(pairKey);
+        } else if (const tl::optional<Length> distance = Capsule::getDistance(
+                       item1.capsules, item2.capsules, &p1, &p2)) {
+          // Both items are round primitives, thus the clearance can be
+          // checked analytically instead of intersecting polygons. The same
+          // tolerance is used to get consistent results.
+          const Length required =
+              std::max(item1.clearance, item2.clearance) - tolerance;
+          if (*distance < required) {
+            locations.append(Path::obround(
+                p1, p2, PositiveLength(std::max(required, Length(1)))));
+          }
+        } else {
+          checkForIntersections(item1, item2, locations);
+          // Perform the check the other way around only if:
+          //  - Either the two items have individual clearances
+          //  - Or there are any intersections -> show both violations in UI
+          if ((item1.clearance != item2.clearance) || (!locations.isEmpty())) {
+            checkForIntersections(item2, item1, locations);
+          }
         }
-        if (!locations.isEmpty()) {
-          emitMessage(std::make_shared<DrcMsgCopperCopperClearanceViolation>(
-              it1->netSignal, *it1->item, it1->polygon, it1->circle,
-              it2->netSignal, *it2->item, it2->polygon, it2->circle,
-              overlappingLayers, std::max(it1->clearance, it2->clearance),
-              locations));
+        const auto indices = std::make_pair(layerItems.at(pair.first),
+                                            layerItems.at(pair.second));
+        results.append(PairResult{indices, overlappingLayers, locations});
+      }
+    }
+    return results;
+  };
+  QVector<PairResult> results;
+  const QList<const Layer*> layers = mBoard.getCopperLayers().values();
+  if (mParallelExecution) {
+    QVector<QFuture<QVector<PairResult>>> futures;
+    auto futuresGuard = Concurrency::waitOnScopeExit(futures);
+    foreach (const Layer* layer, layers) {
+      futures.append(QtConcurrent::run(
+          [&checkLayer, layer]() { return checkLayer(layer); }));
+    }
+    for (QFuture<QVector<PairResult>>& future : futures) {
+      results += future.result();  // can throw
+    }
+  } else {
+    foreach (const Layer* layer, layers) {
+      results += checkLayer(layer);  // can throw
+    }
+  }
+
+  // Emit messages in a deterministic order.
+  std::sort(results.begin(), results.end(),
+            [](const PairResult& a, const PairResult& b) {
+              return a.items < b.items;
+            });
+  foreach (const PairResult& result, results) {
+    if (result.locations.isEmpty()) {
+      continue;
+    }
+    const Item& item1 = items.at(result.items.first);
+    const Item& item2 = items.at(result.items.second);
+    emitMessage(std::make_shared<DrcMsgCopperCopperClearanceViolation>(
+        item1.netSignal, *item1.item, item1.polygon, item1.circle,
+        item2.netSignal, *item2.item, item2.polygon, item2.circle,
+        result.layers, std::max(item1.clearance, item2.clearance),
+        result.locations));
+  }
+
+  // Update the cache for the next run. Entries not used anymore are dropped
+  // to avoid growing the cache endlessly. If only a region was checked, the
+  // results of pairs outside the region are kept as long as both items still
+  // exist, since they are still valid.
+  if (mCache) {
+    if (mRegion.isEmpty()) {
+      mCache->intersections.clear();
+    } else {
+      QSet<QByteArray> keys;
+      for (const Item& item : items) {
+        keys.insert(item.key);
+      }
+      for (auto it = mCache->intersections.begin();
+           it != mCache->intersections.end();) {
+        const int size = it.key().size() / 2;  // Two concatenated item keys.
+        if (keys.contains(it.key().left(size)) &&
+            keys.contains(it.key().mid(size))) {
+          ++it;
+        } else {
+          it = mCache->intersections.erase(it);
         }
       }
     }
+    mCache->itemAreas.clear();
+    foreach (const PairResult& result, results) {
+      mCache->intersections.insert(items.at(result.items.first).key +
+                                       items.at(result.items.second).key,
+                                   result.locations);
+    }
+    for (Item& item : items) {
+      mCache->itemAreas.insert(item.key,
+                               std::make_pair(std::move(item.copperArea),
+                                              std::move(item.clearanceArea)));
+    }
   }
 
   emitProgress(progressEnd);
@@ -588,16 +891,36 @@ void BoardDesignRuleCheck::checkCopperHoleClearances(int progressEnd) {
                           ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
   }
 
+  // Index the copper areas to only intersect the holes with nearby copper.
+  // Since every path containing a point of the hole must overlap the hole's
+  // bounding rectangle, this gives exactly the same result with the even-odd
+  // fill rule.
+  QVector<ClipperLib::IntRect> copperBounds;
+  copperBounds.reserve(copperAreas.size());
+  for (const ClipperLib::Path& path : copperAreas) {
+    copperBounds.append(ClipperHelpers::getBounds(path));
+  }
+  const SpatialIndex copperIndex(copperBounds);
+
   // Helper for the actual check.
   QVector<Path> locations;
-  auto intersects = [this, &clearance, &copperAreas, &locations](
+  auto intersects = [this, &clearance, &copperAreas, &copperIndex, &locations](
                         const PositiveLength& diameter,
                         const NonEmptyPath& path, const Transform& transform) {
     BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
     gen.addHole(diameter, path, transform,
                 clearance - *maxArcTolerance() - Length(1));
+    ClipperLib::Paths nearbyCopper;
+    foreach (int index,
+             copperIndex.query(ClipperHelpers::getBounds(gen.getPaths()))) {
+      nearbyCopper.push_back(copperAreas.at(index));
+    }
+    if (nearbyCopper.empty()) {
+      locations.clear();
+      return false;
+    }
     std::unique_ptr<ClipperLib::PolyTree> intersections =
-        ClipperHelpers::intersectToTree(copperAreas, gen.getPaths(),
+        ClipperHelpers::intersectToTree(nearbyCopper, gen.getPaths(),
                                         ClipperLib::pftEvenOdd,
                                         ClipperLib::pftEvenOdd);
     locations =
@@ -649,7 +972,7 @@ void BoardDesignRuleCheck::checkDrillDrillClearances(int progressEnd) {
   QVector<Item> items;
 
   // Helper to add an item.
-  auto addItem = [&diameterExpansion, &items](
+  auto addItem = [this, &diameterExpansion, &items](
                      const BI_Base& item, const Uuid& hole,
                      const NonEmptyPath& path, const PositiveLength& diameter) {
     const QVector<Path> area =
@@ -693,23 +1016,28 @@ void BoardDesignRuleCheck::checkDrillDrillClearances(int progressEnd) {
     }
   }
 
-  // Now check for intersections.
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      const std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersectToTree(it1->areas, it2->areas,
-                                          ClipperLib::pftEvenOdd,
-                                          ClipperLib::pftEvenOdd);
-      const ClipperLib::Paths paths =
-          ClipperHelpers::flattenTree(*intersections);
-      if ((!paths.empty()) && it1->item && it1->hole && it2->item &&
-          it2->hole) {
-        const QVector<Path> locations = ClipperHelpers::convert(paths);
-        emitMessage(std::make_shared<DrcMsgDrillDrillClearanceViolation>(
-            *it1->item, *it1->hole, *it2->item, *it2->hole, clearance,
-            locations));
-      }
+  // Now check for intersections, but only of drills with overlapping bounding
+  // rectangles.
+  QVector<ClipperLib::IntRect> bounds;
+  bounds.reserve(items.count());
+  for (const Item& item : items) {
+    bounds.append(ClipperHelpers::getBounds(item.areas));
+  }
+  const SpatialIndex index(bounds);
+  for (const auto& pair : index.findOverlappingPairs()) {
+    const Item& item1 = items.at(pair.first);
+    const Item& item2 = items.at(pair.second);
+    const std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersectToTree(item1.areas, item2.areas,
+                                        ClipperLib::pftEvenOdd,
+                                        ClipperLib::pftEvenOdd);
+    const ClipperLib::Paths paths = ClipperHelpers::flattenTree(*intersections);
+    if ((!paths.empty()) && item1.item && item1.hole && item2.item &&
+        item2.hole) {
+      const QVector<Path> locations = ClipperHelpers::convert(paths);
+      emitMessage(std::make_shared<DrcMsgDrillDrillClearanceViolation>(
+          *item1.item, *item1.hole, *item2.item, *item2.hole, clearance,
+          locations));
     }
   }
 
@@ -729,7 +1057,7 @@ void BoardDesignRuleCheck::checkDrillBoardClearances(int progressEnd) {
 
   // Helper for the actual check.
   QVector<Path> locations;
-  auto intersects = [&restrictedArea, &locations](
+  auto intersects = [this, &restrictedArea, &locations](
                         const NonEmptyPath& path,
                         const PositiveLength& diameter) {
     const QVector<Path> area = path->toOutlineStrokes(diameter);
@@ -829,6 +1157,18 @@ void BoardDesignRuleCheck::checkSilkscreenStopmaskClearances(int progressEnd) {
     ClipperHelpers::intersect(clearanceArea, boardArea, ClipperLib::pftEvenOdd,
                               ClipperLib::pftEvenOdd);
 
+    // The openings area consists of many small paths spread over the whole
+    // board, but each text overlaps only very few of them. So index them by
+    // their bounds to intersect each text only with the paths nearby. With
+    // the even-odd fill rule, paths not overlapping the bounds of a text do
+    // not affect the result within these bounds.
+    QVector<ClipperLib::IntRect> clearanceBounds;
+    clearanceBounds.reserve(static_cast<int>(clearanceArea.size()));
+    for (const ClipperLib::Path& path : clearanceArea) {
+      clearanceBounds.append(ClipperHelpers::getBounds(path));
+    }
+    const SpatialIndex clearanceIndex(clearanceBounds);
+
     // Note: We check only stroke texts. For other objects like polygons,
     // usually there are dozens of clearance violations but most of the time
     // they are not relevant and cannot be avoided. So let's omit these
@@ -836,10 +1176,16 @@ void BoardDesignRuleCheck::checkSilkscreenStopmaskClearances(int progressEnd) {
 
     // Helper for the actual check.
     QVector<Path> locations;
-    auto intersects = [&clearanceArea,
+    ClipperLib::Paths nearbyClearanceArea;
+    auto intersects = [&clearanceArea, &clearanceIndex, &nearbyClearanceArea,
                        &locations](const ClipperLib::Paths& paths) {
+      nearbyClearanceArea.clear();
+      foreach (int index,
+               clearanceIndex.query(ClipperHelpers::getBounds(paths))) {
+        nearbyClearanceArea.push_back(clearanceArea.at(index));
+      }
       std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersectToTree(clearanceArea, paths,
+          ClipperHelpers::intersectToTree(nearbyClearanceArea, paths,
                                           ClipperLib::pftEvenOdd,
                                           ClipperLib::pftEvenOdd);
       locations =
@@ -885,8 +1231,9 @@ void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressEnd) {
   }
 
   emitStatus(tr("Check copper widths..."));
-  checkMinimumWidth(minWidth, [this](const Layer& layer) {
-    return mBoard.getCopperLayers().contains(&layer);
+  const QSet<const Layer*> layers = mBoard.getCopperLayers();
+  checkMinimumWidth(minWidth, [&layers](const Layer& layer) {
+    return layers.contains(&layer);
   });
   emitProgress(progressEnd);
 }
@@ -1173,6 +1520,93 @@ void BoardDesignRuleCheck::checkZones(int progressEnd) {
     }
   }
 
+  // Collect the bounding rectangles of all items which might violate a zone
+  // rule once, so each zone is only checked against the items nearby instead
+  // of all items of the board.
+  struct ZoneCandidate {
+    const BI_Device* device;  ///< Polygons and circles of the device
+    const BI_FootprintPad* pad;
+    const BI_Via* via;
+    const BI_NetLine* netLine;
+    const BI_Polygon* polygon;
+  };
+  QVector<ZoneCandidate> candidates;
+  QVector<ClipperLib::IntRect> candidateBounds;
+  const ClipperLib::IntRect noBounds =
+      ClipperHelpers::getBounds(ClipperLib::Path());  // Invalid rectangle.
+  auto getBounds = [this](const Path& path, const Length& margin) {
+    return SpatialIndex::inflated(
+        ClipperHelpers::getBounds(
+            ClipperHelpers::convert(path, maxArcTolerance())),
+        (margin + *maxArcTolerance()).toNm());
+  };
+  if (!zones.isEmpty()) {
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+      foreach (const BI_FootprintPad* pad, device->getPads()) {
+        const Transform transform(*pad);
+        ClipperLib::IntRect bounds = noBounds;
+        for (const QList<PadGeometry>& geometries : pad->getGeometries()) {
+          for (const PadGeometry& geometry : geometries) {
+            for (const Path& outline : transform.map(geometry.toOutlines())) {
+              bounds =
+                  SpatialIndex::united(bounds, getBounds(outline, Length(0)));
+            }
+          }
+        }
+        candidates.append(
+            ZoneCandidate{nullptr, pad, nullptr, nullptr, nullptr});
+        candidateBounds.append(bounds);
+      }
+      const Transform transform(*device);
+      ClipperLib::IntRect bounds = noBounds;
+      for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+        bounds = SpatialIndex::united(
+            bounds,
+            getBounds(transform.map(polygon.getPathForRendering()),
+                      *polygon.getLineWidth() / 2));
+      }
+      for (const Circle& circle : device->getLibFootprint().getCircles()) {
+        bounds = SpatialIndex::united(
+            bounds,
+            getBounds(transform.map(Path::circle(circle.getDiameter())
+                                        .translated(circle.getCenter())),
+                      *circle.getLineWidth() / 2));
+      }
+      candidates.append(
+          ZoneCandidate{device, nullptr, nullptr, nullptr, nullptr});
+      candidateBounds.append(bounds);
+    }
+    foreach (const BI_NetSegment* segment, mBoard.getNetSegments()) {
+      foreach (const BI_Via* via, segment->getVias()) {
+        PositiveLength diameter = via->getSize();
+        for (const auto& stopMask : {via->getStopMaskDiameterTop(),
+                                     via->getStopMaskDiameterBottom()}) {
+          if (stopMask && (*stopMask > diameter)) {
+            diameter = *stopMask;
+          }
+        }
+        candidates.append(
+            ZoneCandidate{nullptr, nullptr, via, nullptr, nullptr});
+        candidateBounds.append(getBounds(
+            Path::circle(diameter).translated(via->getPosition()), Length(0)));
+      }
+      foreach (const BI_NetLine* netLine, segment->getNetLines()) {
+        candidates.append(
+            ZoneCandidate{nullptr, nullptr, nullptr, netLine, nullptr});
+        candidateBounds.append(
+            getBounds(netLine->getSceneOutline(), Length(0)));
+      }
+    }
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+      candidates.append(
+          ZoneCandidate{nullptr, nullptr, nullptr, nullptr, polygon});
+      candidateBounds.append(
+          getBounds(polygon->getData().getPath(),
+                    *polygon->getData().getLineWidth() / 2));
+    }
+  }
+  const SpatialIndex candidateIndex(candidateBounds);
+
   // Check for violations.
   foreach (const ZoneItem& zone, zones) {
     // Determine some zone data.
@@ -1203,6 +1637,10 @@ void BoardDesignRuleCheck::checkZones(int progressEnd) {
         noDeviceLayers.insert(&Layer::botDocumentation());
       }
     }
+    if (noCopperLayers.isEmpty() && noStopMaskLayers.isEmpty() &&
+        noDeviceLayers.isEmpty()) {
+      continue;  // Nothing to check.
+    }
 
     // Helper function.
     QVector<Path> locations;
@@ -1239,18 +1677,19 @@ void BoardDesignRuleCheck::checkZones(int progressEnd) {
           zoneAreaPx.intersects(Path::toQPainterPathPx(locations, true));
     };
 
-    // Check devices.
-    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-      // Skip violations within a single device since this is actually a
-      // (minor) library issue and cannot be fixed in the board. It's
-      // even handy to use this behavior to simplify zone outlines in
-      // footprints.
-      if (device == zone.device) {
-        continue;
-      }
-
-      // Check pads.
-      foreach (const BI_FootprintPad* pad, device->getPads()) {
+    // Check all items nearby, in the order they were collected above.
+    // Note: Violations within a single device are skipped since this is
+    // actually a (minor) library issue and cannot be fixed in the board.
+    // It's even handy to use this behavior to simplify zone outlines in
+    // footprints.
+    const ClipperLib::IntRect zoneBounds = getBounds(zone.outline, Length(0));
+    foreach (int index, candidateIndex.query(zoneBounds)) {
+      const ZoneCandidate& candidate = candidates.at(index);
+      if (const BI_FootprintPad* pad = candidate.pad) {
+        // Check pads.
+        if (&pad->getDevice() == zone.device) {
+          continue;
+        }
         if (intersectsPad(*pad, noCopperLayers)) {
           emitMessage(std::make_shared<DrcMsgCopperInKeepoutZone>(
               zone.boardZone, zone.device, zone.deviceZone, *pad, locations));
@@ -1259,68 +1698,63 @@ void BoardDesignRuleCheck::checkZones(int progressEnd) {
           emitMessage(std::make_shared<DrcMsgExposureInKeepoutZone>(
               zone.boardZone, zone.device, zone.deviceZone, *pad, locations));
         }
-      }
-
-      // Check polygons.
-      const Transform transform(*device);
-      bool deviceInKeepoutZone = false;
-      for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
-        auto check = [&intersectsPolygon, &transform, &polygon]() {
-          return intersectsPolygon(
-              transform.map(polygon.getPathForRendering()),
-              polygon.getLineWidth(),
-              polygon.isFilled() ||
-                  polygon.getLayer().getPolygonsRepresentAreas());
-        };
-        const Layer& layer = transform.map(polygon.getLayer());
-        if ((noCopperLayers.contains(&layer)) && check()) {
-          emitMessage(std::make_shared<DrcMsgCopperInKeepoutZone>(
-              zone.boardZone, zone.device, zone.deviceZone, *device, polygon,
-              locations));
-        } else if ((noStopMaskLayers.contains(&layer)) && check()) {
-          emitMessage(std::make_shared<DrcMsgExposureInKeepoutZone>(
-              zone.boardZone, zone.device, zone.deviceZone, *device, polygon,
-              locations));
-        } else if ((noDeviceLayers.contains(&layer)) && check()) {
-          deviceInKeepoutZone = true;
+      } else if (const BI_Device* device = candidate.device) {
+        // Check polygons and circles of devices.
+        if (device == zone.device) {
+          continue;
         }
-      }
-
-      // Check circles.
-      for (const Circle& circle : device->getLibFootprint().getCircles()) {
-        auto check = [&intersectsPolygon, &transform, &circle]() {
-          return intersectsPolygon(
-              transform.map(Path::circle(circle.getDiameter())
-                                .translated(circle.getCenter())),
-              circle.getLineWidth(),
-              circle.isFilled() ||
-                  circle.getLayer().getPolygonsRepresentAreas());
-        };
-        const Layer& layer = transform.map(circle.getLayer());
-        if ((noCopperLayers.contains(&layer)) && check()) {
-          emitMessage(std::make_shared<DrcMsgCopperInKeepoutZone>(
-              zone.boardZone, zone.device, zone.deviceZone, *device, circle,
-              locations));
-        } else if ((noStopMaskLayers.contains(&layer)) && check()) {
-          emitMessage(std::make_shared<DrcMsgExposureInKeepoutZone>(
-              zone.boardZone, zone.device, zone.deviceZone, *device, circle,
-              locations));
-        } else if ((noDeviceLayers.contains(&layer)) && check()) {
-          deviceInKeepoutZone = true;
+        const Transform transform(*device);
+        bool deviceInKeepoutZone = false;
+        for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+          auto check = [&intersectsPolygon, &transform, &polygon]() {
+            return intersectsPolygon(
+                transform.map(polygon.getPathForRendering()),
+                polygon.getLineWidth(),
+                polygon.isFilled() ||
+                    polygon.getLayer().getPolygonsRepresentAreas());
+          };
+          const Layer& layer = transform.map(polygon.getLayer());
+          if ((noCopperLayers.contains(&layer)) && check()) {
+            emitMessage(std::make_shared<DrcMsgCopperInKeepoutZone>(
+                zone.boardZone, zone.device, zone.deviceZone, *device, polygon,
+                locations));
+          } else if ((noStopMaskLayers.contains(&layer)) && check()) {
+            emitMessage(std::make_shared<DrcMsgExposureInKeepoutZone>(
+                zone.boardZone, zone.device, zone.deviceZone, *device, polygon,
+                locations));
+          } else if ((noDeviceLayers.contains(&layer)) && check()) {
+            deviceInKeepoutZone = true;
+          }
         }
-      }
-
-      if (deviceInKeepoutZone) {
-        emitMessage(std::make_shared<DrcMsgDeviceInKeepoutZone>(
-            zone.boardZone, zone.device, zone.deviceZone, *device,
-            getDeviceLocation(*device)));
-      }
-    }
-
-    // Check net segments.
-    foreach (const BI_NetSegment* segment, mBoard.getNetSegments()) {
-      // Check vias.
-      foreach (const BI_Via* via, segment->getVias()) {
+        for (const Circle& circle : device->getLibFootprint().getCircles()) {
+          auto check = [&intersectsPolygon, &transform, &circle]() {
+            return intersectsPolygon(
+                transform.map(Path::circle(circle.getDiameter())
+                                  .translated(circle.getCenter())),
+                circle.getLineWidth(),
+                circle.isFilled() ||
+                    circle.getLayer().getPolygonsRepresentAreas());
+          };
+          const Layer& layer = transform.map(circle.getLayer());
+          if ((noCopperLayers.contains(&layer)) && check()) {
+            emitMessage(std::make_shared<DrcMsgCopperInKeepoutZone>(
+                zone.boardZone, zone.device, zone.deviceZone, *device, circle,
+                locations));
+          } else if ((noStopMaskLayers.contains(&layer)) && check()) {
+            emitMessage(std::make_shared<DrcMsgExposureInKeepoutZone>(
+                zone.boardZone, zone.device, zone.deviceZone, *device, circle,
+                locations));
+          } else if ((noDeviceLayers.contains(&layer)) && check()) {
+            deviceInKeepoutZone = true;
+          }
+        }
+        if (deviceInKeepoutZone) {
+          emitMessage(std::make_shared<DrcMsgDeviceInKeepoutZone>(
+              zone.boardZone, zone.device, zone.deviceZone, *device,
+              getDeviceLocation(*device)));
+        }
+      } else if (const BI_Via* via = candidate.via) {
+        // Check vias.
         if (via->getVia().isOnAnyLayer(noCopperLayers)) {
           QPainterPath areaPx;
           areaPx.addEllipse(via->getPosition().toPxQPointF(),
@@ -1350,10 +1784,8 @@ void BoardDesignRuleCheck::checkZones(int progressEnd) {
             }
           }
         }
-      }
-
-      // Check traces.
-      foreach (const BI_NetLine* netLine, segment->getNetLines()) {
+      } else if (const BI_NetLine* netLine = candidate.netLine) {
+        // Check traces.
         if (noCopperLayers.contains(&netLine->getLayer())) {
           const QPainterPath areaPx =
               netLine->getSceneOutline().toQPainterPathPx();
@@ -1363,23 +1795,23 @@ void BoardDesignRuleCheck::checkZones(int progressEnd) {
                 QVector<Path>{netLine->getSceneOutline()}));
           }
         }
-      }
-    }
-
-    // Check Polygons.
-    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
-      auto check = [&intersectsPolygon, polygon]() {
-        return intersectsPolygon(polygon->getData().getPath(),
-                                 polygon->getData().getLineWidth(),
-                                 polygon->getData().isFilled());
-      };
-      const Layer& layer = polygon->getData().getLayer();
-      if ((noCopperLayers.contains(&layer)) && check()) {
-        emitMessage(std::make_shared<DrcMsgCopperInKeepoutZone>(
-            zone.boardZone, zone.device, zone.deviceZone, *polygon, locations));
-      } else if ((noStopMaskLayers.contains(&layer)) && check()) {
-        emitMessage(std::make_shared<DrcMsgExposureInKeepoutZone>(
-            zone.boardZone, zone.device, zone.deviceZone, *polygon, locations));
+      } else if (const BI_Polygon* polygon = candidate.polygon) {
+        // Check polygons.
+        auto check = [&intersectsPolygon, polygon]() {
+          return intersectsPolygon(polygon->getData().getPath(),
+                                   polygon->getData().getLineWidth(),
+                                   polygon->getData().isFilled());
+        };
+        const Layer& layer = polygon->getData().getLayer();
+        if ((noCopperLayers.contains(&layer)) && check()) {
+          emitMessage(std::make_shared<DrcMsgCopperInKeepoutZone>(
+              zone.boardZone, zone.device, zone.deviceZone, *polygon,
+              locations));
+        } else if ((noStopMaskLayers.contains(&layer)) && check()) {
+          emitMessage(std::make_shared<DrcMsgExposureInKeepoutZone>(
+              zone.boardZone, zone.device, zone.deviceZone, *polygon,
+              locations));
+        }
       }
     }
   }
@@ -1539,15 +1971,23 @@ void BoardDesignRuleCheck::checkDeviceClearances(int progressEnd) {
       }
     };
 
-    // Check for overlaps.
-    for (int i = 0; i < deviceCourtyards.count(); ++i) {
-      const BI_Device* dev1 = deviceCourtyards.keys()[i];
+    // Check for overlaps, but only of devices with overlapping bounding
+    // rectangles.
+    const QList<const BI_Device*> devices = deviceCourtyards.keys();
+    QVector<ClipperLib::IntRect> bounds;
+    bounds.reserve(devices.count());
+    foreach (const BI_Device* device, devices) {
+      bounds.append(SpatialIndex::united(
+          ClipperHelpers::getBounds(deviceOutlines[device]),
+          ClipperHelpers::getBounds(deviceCourtyards[device])));
+    }
+    const SpatialIndex index(bounds);
+    for (const auto& pair : index.findOverlappingPairs()) {
+      const BI_Device* dev1 = devices.at(pair.first);
       Q_ASSERT(dev1);
-      for (int k = i + 1; k < deviceCourtyards.count(); ++k) {
-        const BI_Device* dev2 = deviceCourtyards.keys()[k];
-        Q_ASSERT(dev2);
-        check(dev1, dev2);
-      }
+      const BI_Device* dev2 = devices.at(pair.second);
+      Q_ASSERT(dev2);
+      check(dev1, dev2);
     }
   }
 
@@ -1881,6 +2321,8 @@ QVector<Path> BoardDesignRuleCheck::getBoardOutlines(
 
 const ClipperLib::Paths& BoardDesignRuleCheck::getCopperPaths(
     const Layer& layer, const QSet<const NetSignal*>& netsignals) {
+  // Note: References to QHash values stay valid when inserting other items.
+  QMutexLocker lock(&mCachedPathsMutex);
   const auto key = qMakePair(&layer, netsignals);
   if (!mCachedPaths.contains(key)) {
     BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
@@ -1986,12 +2428,55 @@ QVector<Path> BoardDesignRuleCheck::getHoleLocation(
   return transform.map(hole.getPath())->toOutlineStrokes(hole.getDiameter());
 }
 
+QByteArray BoardDesignRuleCheck::calcCacheKey(
+    const char* type, const QVector<Path>& paths,
+    const QVector<qint64>& values) const noexcept {
+  QVector<qint64> allValues = values;
+  allValues.append(mMaxArcTolerance->toNm());  // Affects the generated areas.
+  return CacheKeyBuilder::calcKey(type, paths, allValues);
+}
+
+bool BoardDesignRuleCheck::isInRegion(
+    const ClipperLib::IntRect& bounds) const noexcept {
+  if (mRegion.isEmpty()) {
+    return true;
+  }
+  foreach (const ClipperLib::IntRect& rect, mRegion) {
+    if (SpatialIndex::intersects(rect, bounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BoardDesignRuleCheck::isInRegion(
+    const QVector<Path>& locations) const noexcept {
+  if (mRegion.isEmpty() || locations.isEmpty()) {
+    return true;
+  }
+  foreach (const Path& path, locations) {
+    const ClipperLib::IntRect bounds = ClipperHelpers::getBounds(
+        ClipperHelpers::convert(path, maxArcTolerance()));
+    if (isInRegion(bounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void BoardDesignRuleCheck::emitProgress(int percent) noexcept {
+  if (sCurrentResult) {
+    return;  // Progress is reported by runChecks() instead.
+  }
   mProgressPercent = percent;
   emit progressPercent(percent);
 }
 
 void BoardDesignRuleCheck::emitStatus(const QString& status) noexcept {
+  if (sCurrentResult) {
+    sCurrentResult->status.append(status);
+    return;
+  }
   mProgressStatus.append(status);
   emit progressStatus(status);
   qApp->processEvents();
@@ -1999,6 +2484,13 @@ void BoardDesignRuleCheck::emitStatus(const QString& status) noexcept {
 
 void BoardDesignRuleCheck::emitMessage(
     const std::shared_ptr<const RuleCheckMessage>& msg) noexcept {
+  if (!isInRegion(msg->getLocations())) {
+    return;
+  }
+  if (sCurrentResult) {
+    sCurrentResult->messages.append(msg);
+    return;
+  }
   mMessages.append(msg);
   emit progressMessage(msg->getMessage());
 }
@@ -31,6 +31,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -41,6 +43,30 @@ class Board;
 class Hole;
 class NetSignal;
 
+/*******************************************************************************
+ *  Struct BoardDesignRuleCheckCache
+ ******************************************************************************/
+
+/**
+ * @brief Intermediate results of a ::librepcb::BoardDesignRuleCheck which can
+ *        be reused by subsequent runs on the same board
+ *
+ * Copper items are identified by a fingerprint of their geometry (and
+ * clearance), so unmodified items don't need to be converted to Clipper paths
+ * again, and pairs of unmodified items don't need to be checked for clearance
+ * violations again. Only pairs involving modified items are re-evaluated.
+ *
+ * Each run replaces the content by the data of the current board, so the cache
+ * does not grow over time.
+ */
+struct BoardDesignRuleCheckCache {
+  /// Copper area and clearance area by item fingerprint
+  QHash<QByteArray, std::pair<ClipperLib::Paths, ClipperLib::Paths>> itemAreas;
+
+  /// Copper clearance violation locations by concatenated item fingerprints
+  QHash<QByteArray, QVector<Path>> intersections;
+};
+
 /*******************************************************************************
  *  Class BoardDesignRuleCheck
  ******************************************************************************/
@@ -53,6 +79,17 @@ class BoardDesignRuleCheck final : public QObject {
   Q_OBJECT
 
 public:
+  // Types
+
+  /**
+   * @brief Statistics about one executed check
+   */
+  struct CheckTiming {
+    QString name;  ///< Stable identifier of the check, e.g. "vias"
+    qint64 durationNs;  ///< Wall time of the check
+    int messageCount;  ///< Number of messages emitted by the check
+  };
+
   // Constructors / Destructor
   explicit BoardDesignRuleCheck(Board& board,
                                 const BoardDesignRuleCheckSettings& settings,
@@ -64,10 +101,84 @@ public:
     return mProgressStatus;
   }
   const RuleCheckMessageList& getMessages() const noexcept { return mMessages; }
+  const QVector<CheckTiming>& getTimings() const noexcept { return mTimings; }
+
+  // Setters
+
+  /**
+   * @brief Enable or disable running independent checks concurrently
+   *
+   * Enabled by default. The resulting messages are the same (and in the same
+   * order) in both modes, so this is mainly useful for debugging.
+   *
+   * @param parallel  Whether the checks shall run on the global thread pool.
+   */
+  void setParallelExecution(bool parallel) noexcept {
+    mParallelExecution = parallel;
+  }
+
+  /**
+   * @brief Set a cache to speed up subsequent runs (incremental DRC)
+   *
+   * @param cache   The cache to read from and update, or `nullptr` to not
+   *                use any cache (the default). The same cache object must
+   *                only be used for one board and must not be used by several
+   *                checks at the same time.
+   */
+  void setCache(
+      const std::shared_ptr<BoardDesignRuleCheckCache>& cache) noexcept {
+    mCache = cache;
+  }
+
+  /**
+   * @brief Restrict the check to a region of the board
+   *
+   * Only messages with a location intersecting the region (expanded by the
+   * largest clearance of the settings) are reported, and the copper clearance
+   * check skips all items outside of it. Messages without location are always
+   * reported.
+   *
+   * @param region  Outlines of the region (e.g. a rectangle or the outlines of
+   *                selected items), or an empty list to check the whole board
+   *                (the default).
+   */
+  void setRegion(const QVector<Path>& region) noexcept;
 
   // General Methods
+
+  /**
+   * @brief Run either all checks or the quick checks
+   *
+   * @param quick   If true, the built-in profile
+   *                ::librepcb::BoardDesignRuleCheckSettings::getQuickProfile()
+   *                is used, otherwise
+   *                ::librepcb::BoardDesignRuleCheckSettings::getFullProfile().
+   */
   void execute(bool quick);
 
+  /**
+   * @brief Run the checks selected by a profile
+   *
+   * The calling thread is blocked until all checks are finished, no events
+   * are processed in the meantime. After each check, the signal
+   * #progressPercent() is emitted and #getMessages() contains the messages
+   * of all checks finished so far. Thus #cancel() can be called from a slot
+   * connected to this signal (e.g. a modal progress dialog).
+   *
+   * @param profile   The profile to use.
+   *
+   * @throws ::librepcb::UserCanceled if #cancel() was called.
+   */
+  void execute(const BoardDesignRuleCheckSettings::Profile& profile);
+
+  /**
+   * @brief Abort a running #execute() as soon as possible
+   *
+   * Checks already running in other threads are finished, the remaining
+   * checks are skipped.
+   */
+  void cancel() noexcept { mAbort = true; }
+
 signals:
   void started();
   void progressPercent(int percent);
@@ -75,7 +186,24 @@ signals:
   void progressMessage(const QString& msg);
   void finished();
 
+private:  // Types
+  struct Check {
+    const char* name;
+    void (BoardDesignRuleCheck::*function)(int progressEnd);
+    int progressEnd;
+    bool concurrent;  ///< False if the check modifies the board
+  };
+
+  struct CheckResult {
+    QStringList status;
+    RuleCheckMessageList messages;
+    qint64 durationNs = 0;
+  };
+
 private:  // Methods
+  void runChecks(const QVector<Check>& checks);
+  void runCheck(const Check& check, CheckResult& result);
+  void throwIfCanceled() const;
   void rebuildPlanes(int progressEnd);
   void checkCopperCopperClearances(int progressEnd);
   void checkCopperBoardClearances(int progressEnd);
@@ -116,10 +244,14 @@ private:  // Methods
                                           const Layer& layer);
   QVector<Path> getDeviceLocation(const BI_Device& device) const;
   QVector<Path> getViaLocation(const BI_Via& via) const noexcept;
+  QByteArray calcCacheKey(const char* type, const QVector<Path>& paths,
+                          const QVector<qint64>& values) const noexcept;
   template <typename THole>
   QVector<Path> getHoleLocation(
       const THole& hole,
       const Transform& transform = Transform()) const noexcept;
+  bool isInRegion(const ClipperLib::IntRect& bounds) const noexcept;
+  bool isInRegion(const QVector<Path>& locations) const noexcept;
   void emitProgress(int percent) noexcept;
   void emitStatus(const QString& status) noexcept;
   void emitMessage(const std::shared_ptr<const RuleCheckMessage>& msg) noexcept;
@@ -128,19 +260,30 @@ private:  // Methods
   /**
    * Returns the maximum allowed arc tolerance when flattening arcs.
    */
-  static PositiveLength maxArcTolerance() noexcept {
-    return PositiveLength(5000);
+  const PositiveLength& maxArcTolerance() const noexcept {
+    return mMaxArcTolerance;
   }
 
 private:  // Data
   Board& mBoard;
   const BoardDesignRuleCheckSettings& mSettings;
+  bool mParallelExecution;
+  volatile bool mAbort;
+  std::shared_ptr<BoardDesignRuleCheckCache> mCache;
+  QVector<ClipperLib::IntRect> mRegion;  ///< Empty means the whole board
   bool mIgnorePlanes;
+  PositiveLength mMaxArcTolerance;
   int mProgressPercent;
   QStringList mProgressStatus;
   RuleCheckMessageList mMessages;
+  QVector<CheckTiming> mTimings;
+  QMutex mCachedPathsMutex;
   QHash<QPair<const Layer*, QSet<const NetSignal*>>, ClipperLib::Paths>
       mCachedPaths;
+
+  /// Result of the check running in the current thread, or `nullptr` if
+  /// messages and status shall be emitted directly
+  static thread_local CheckResult* sCurrentResult;
 };
 
 /*******************************************************************************
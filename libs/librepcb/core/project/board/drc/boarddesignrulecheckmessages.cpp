@@ -468,13 +468,7 @@ DrcMsgCopperCopperClearanceViolation::DrcMsgCopperCopperClearanceViolation(
                  getObjectName(net1, item1, polygon1, circle1),
                  getObjectName(net2, item2, polygon2, circle2),
                  minClearance.toMmString(), "mm"),
-        tr("The clearance between two copper objects of different nets is "
-           "smaller than the minimum copper clearance configured in the DRC "
-           "settings.") %
-            " " % seriousTroublesTr() % "\n\n" %
-            tr("Check the DRC settings and move the objects to increase their "
-               "clearance if needed."),
-        "copper_clearance_violation", locations) {
+        &getDescription, "copper_clearance_violation", locations) {
   mApproval.ensureLineBreak();
   SExpression& node1 = mApproval.appendList("object");
   mApproval.ensureLineBreak();
@@ -489,6 +483,15 @@ DrcMsgCopperCopperClearanceViolation::DrcMsgCopperCopperClearanceViolation(
   }
 }
 
+QString DrcMsgCopperCopperClearanceViolation::getDescription() noexcept {
+  return tr("The clearance between two copper objects of different nets is "
+            "smaller than the minimum copper clearance configured in the DRC "
+            "settings.") %
+      " " % seriousTroublesTr() % "\n\n" %
+      tr("Check the DRC settings and move the objects to increase their "
+         "clearance if needed.");
+}
+
 QString DrcMsgCopperCopperClearanceViolation::getLayerName(
     const QVector<const Layer*>& layers) {
   if (layers.count() == 1) {
@@ -679,7 +682,7 @@ DrcMsgCopperBoardClearanceViolation::DrcMsgCopperBoardClearanceViolation(
     const BI_Polygon& polygon, const UnsignedLength& minClearance,
     const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Warning, getPolygonMessage(minClearance),
-                     getPolygonDescription(),
+                     &getPolygonDescription,
                      "copper_board_clearance_violation", locations) {
   mApproval.ensureLineBreak();
   mApproval.appendChild("polygon", polygon.getData().getUuid());
@@ -690,7 +693,7 @@ DrcMsgCopperBoardClearanceViolation::DrcMsgCopperBoardClearanceViolation(
     const BI_Device& device, const Polygon& polygon,
     const UnsignedLength& minClearance, const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Warning, getPolygonMessage(minClearance),
-                     getPolygonDescription(),
+                     &getPolygonDescription,
                      "copper_board_clearance_violation", locations) {
   mApproval.ensureLineBreak();
   mApproval.appendChild("device", device.getComponentInstanceUuid());
@@ -768,7 +771,7 @@ DrcMsgCopperHoleClearanceViolation::DrcMsgCopperHoleClearanceViolation(
     const BI_Hole& hole, const UnsignedLength& minClearance,
     const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Error, getMessage(minClearance),
-                     getDescription(), "copper_hole_clearance_violation",
+                     &getDescription, "copper_hole_clearance_violation",
                      locations) {
   mApproval.ensureLineBreak();
   mApproval.appendChild("hole", hole.getData().getUuid());
@@ -779,7 +782,7 @@ DrcMsgCopperHoleClearanceViolation::DrcMsgCopperHoleClearanceViolation(
     const BI_Device& device, const Hole& hole,
     const UnsignedLength& minClearance, const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Error, getMessage(minClearance),
-                     getDescription(), "copper_hole_clearance_violation",
+                     &getDescription, "copper_hole_clearance_violation",
                      locations) {
   mApproval.ensureLineBreak();
   mApproval.appendChild("device", device.getComponentInstanceUuid());
@@ -815,7 +818,7 @@ DrcMsgCopperInKeepoutZone::DrcMsgCopperInKeepoutZone(
         Severity::Error,
         tr("Pad in copper keepout zone: '%1'", "Placeholder is pad name")
             .arg(pad.getText()),
-        getDescription(), "copper_in_keepout_zone", locations) {
+        &getDescription, "copper_in_keepout_zone", locations) {
   mApproval.appendChild("device", pad.getDevice().getComponentInstanceUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("pad", pad.getLibPadUuid());
@@ -832,7 +835,7 @@ DrcMsgCopperInKeepoutZone::DrcMsgCopperInKeepoutZone(
         Severity::Error,
         tr("Via in copper keepout zone: '%1'", "Placeholder is net name")
             .arg(via.getNetSegment().getNetNameToDisplay(true)),
-        getDescription(), "copper_in_keepout_zone", locations) {
+        &getDescription, "copper_in_keepout_zone", locations) {
   mApproval.appendChild("netsegment", via.getNetSegment().getUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("via", via.getUuid());
@@ -849,7 +852,7 @@ DrcMsgCopperInKeepoutZone::DrcMsgCopperInKeepoutZone(
         Severity::Error,
         tr("Trace in copper keepout zone: '%1'", "Placeholder is net name")
             .arg(netLine.getNetSegment().getNetNameToDisplay(true)),
-        getDescription(), "copper_in_keepout_zone", locations) {
+        &getDescription, "copper_in_keepout_zone", locations) {
   mApproval.appendChild("netsegment", netLine.getNetSegment().getUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("trace", netLine.getUuid());
@@ -863,7 +866,7 @@ DrcMsgCopperInKeepoutZone::DrcMsgCopperInKeepoutZone(
     const Zone* deviceZone, const BI_Polygon& polygon,
     const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Error, tr("Polygon in copper keepout zone"),
-                     getDescription(), "copper_in_keepout_zone", locations) {
+                     &getDescription, "copper_in_keepout_zone", locations) {
   mApproval.appendChild("polygon", polygon.getData().getUuid());
   mApproval.ensureLineBreak();
   addZoneApprovalNodes(boardZone, zoneDevice, deviceZone);
@@ -878,7 +881,7 @@ DrcMsgCopperInKeepoutZone::DrcMsgCopperInKeepoutZone(
         Severity::Error,
         tr("Polygon in copper keepout zone: '%1'", "Placeholder is device name")
             .arg(*device.getComponentInstance().getName()),
-        getDescription(), "copper_in_keepout_zone", locations) {
+        &getDescription, "copper_in_keepout_zone", locations) {
   mApproval.appendChild("device", device.getComponentInstanceUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("polygon", polygon.getUuid());
@@ -895,7 +898,7 @@ DrcMsgCopperInKeepoutZone::DrcMsgCopperInKeepoutZone(
         Severity::Error,
         tr("Circle in copper keepout zone: '%1'", "Placeholder is device name")
             .arg(*device.getComponentInstance().getName()),
-        getDescription(), "copper_in_keepout_zone", locations) {
+        &getDescription, "copper_in_keepout_zone", locations) {
   mApproval.appendChild("device", device.getComponentInstanceUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("circle", circle.getUuid());
@@ -998,7 +1001,7 @@ DrcMsgDrillBoardClearanceViolation::DrcMsgDrillBoardClearanceViolation(
     const BI_Via& via, const UnsignedLength& minClearance,
     const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Error, getMessage(minClearance),
-                     getDescription(), "drill_board_clearance_violation",
+                     &getDescription, "drill_board_clearance_violation",
                      locations) {
   mApproval.ensureLineBreak();
   mApproval.appendChild("netsegment", via.getNetSegment().getUuid());
@@ -1011,7 +1014,7 @@ DrcMsgDrillBoardClearanceViolation::DrcMsgDrillBoardClearanceViolation(
     const BI_FootprintPad& pad, const PadHole& hole,
     const UnsignedLength& minClearance, const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Error, getMessage(minClearance),
-                     getDescription(), "drill_board_clearance_violation",
+                     &getDescription, "drill_board_clearance_violation",
                      locations) {
   mApproval.ensureLineBreak();
   mApproval.appendChild("device", pad.getDevice().getComponentInstanceUuid());
@@ -1026,7 +1029,7 @@ DrcMsgDrillBoardClearanceViolation::DrcMsgDrillBoardClearanceViolation(
     const BI_Hole& hole, const UnsignedLength& minClearance,
     const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Error, getMessage(minClearance),
-                     getDescription(), "drill_board_clearance_violation",
+                     &getDescription, "drill_board_clearance_violation",
                      locations) {
   mApproval.ensureLineBreak();
   mApproval.appendChild("hole", hole.getData().getUuid());
@@ -1037,7 +1040,7 @@ DrcMsgDrillBoardClearanceViolation::DrcMsgDrillBoardClearanceViolation(
     const BI_Device& device, const Hole& hole,
     const UnsignedLength& minClearance, const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Error, getMessage(minClearance),
-                     getDescription(), "drill_board_clearance_violation",
+                     &getDescription, "drill_board_clearance_violation",
                      locations) {
   mApproval.ensureLineBreak();
   mApproval.appendChild("device", device.getComponentInstanceUuid());
@@ -1139,7 +1142,7 @@ DrcMsgDeviceInKeepoutZone::DrcMsgDeviceInKeepoutZone(
         Severity::Error,
         tr("Device in keepout zone: '%1'", "Placeholder is device name")
             .arg(*device.getComponentInstance().getName()),
-        getDescription(), "device_in_keepout_zone", locations) {
+        &getDescription, "device_in_keepout_zone", locations) {
   mApproval.appendChild("device", device.getComponentInstanceUuid());
   mApproval.ensureLineBreak();
   addZoneApprovalNodes(boardZone, zoneDevice, deviceZone);
@@ -1181,7 +1184,7 @@ DrcMsgExposureInKeepoutZone::DrcMsgExposureInKeepoutZone(
         Severity::Error,
         tr("Pad in exposure keepout zone: '%1'", "Placeholder is pad name")
             .arg(pad.getText()),
-        getDescription(), "exposure_in_keepout_zone", locations) {
+        &getDescription, "exposure_in_keepout_zone", locations) {
   mApproval.appendChild("device", pad.getDevice().getComponentInstanceUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("pad", pad.getLibPadUuid());
@@ -1198,7 +1201,7 @@ DrcMsgExposureInKeepoutZone::DrcMsgExposureInKeepoutZone(
         Severity::Error,
         tr("Via in exposure keepout zone: '%1'", "Placeholder is net name")
             .arg(via.getNetSegment().getNetNameToDisplay(true)),
-        getDescription(), "exposure_in_keepout_zone", locations) {
+        &getDescription, "exposure_in_keepout_zone", locations) {
   mApproval.appendChild("netsegment", via.getNetSegment().getUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("via", via.getUuid());
@@ -1212,7 +1215,7 @@ DrcMsgExposureInKeepoutZone::DrcMsgExposureInKeepoutZone(
     const Zone* deviceZone, const BI_Polygon& polygon,
     const QVector<Path>& locations) noexcept
   : RuleCheckMessage(Severity::Error, tr("Polygon in exposure keepout zone"),
-                     getDescription(), "exposure_in_keepout_zone", locations) {
+                     &getDescription, "exposure_in_keepout_zone", locations) {
   mApproval.appendChild("polygon", polygon.getData().getUuid());
   mApproval.ensureLineBreak();
   addZoneApprovalNodes(boardZone, zoneDevice, deviceZone);
@@ -1227,7 +1230,7 @@ DrcMsgExposureInKeepoutZone::DrcMsgExposureInKeepoutZone(
                      tr("Polygon in exposure keepout zone: '%1'",
                         "Placeholder is device name")
                          .arg(*device.getComponentInstance().getName()),
-                     getDescription(), "exposure_in_keepout_zone", locations) {
+                     &getDescription, "exposure_in_keepout_zone", locations) {
   mApproval.appendChild("device", device.getComponentInstanceUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("polygon", polygon.getUuid());
@@ -1244,7 +1247,7 @@ DrcMsgExposureInKeepoutZone::DrcMsgExposureInKeepoutZone(
                      tr("Circle in exposure keepout zone: '%1'",
                         "Placeholder is device name")
                          .arg(*device.getComponentInstance().getName()),
-                     getDescription(), "exposure_in_keepout_zone", locations) {
+                     &getDescription, "exposure_in_keepout_zone", locations) {
   mApproval.appendChild("device", device.getComponentInstanceUuid());
   mApproval.ensureLineBreak();
   mApproval.appendChild("circle", circle.getUuid());
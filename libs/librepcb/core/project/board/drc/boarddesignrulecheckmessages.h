@@ -304,6 +304,7 @@ public:
   virtual ~DrcMsgCopperCopperClearanceViolation() noexcept {}
 
 private:
+  static QString getDescription() noexcept;
   static QString getLayerName(const QVector<const Layer*>& layers);
   static QString getObjectName(const NetSignal* net, const BI_Base& item,
                                const Polygon* polygon, const Circle* circle);
@@ -69,6 +69,36 @@ inline BoardDesignRuleCheckSettings::AllowedSlots deserialize(
   }
 }
 
+/*******************************************************************************
+ *  Struct Profile
+ ******************************************************************************/
+
+BoardDesignRuleCheckSettings::Profile::Profile(const SExpression& node)
+  : name(node.getChild("@0").getValue()),
+    checks(),
+    planes(deserialize<bool>(node.getChild("planes/@0"))),
+    maxArcTolerance(
+        deserialize<PositiveLength>(node.getChild("arc_tolerance/@0"))) {
+  foreach (const SExpression* child, node.getChildren("check")) {
+    checks.insert(child->getChild("@0").getValue());
+  }
+}
+
+void BoardDesignRuleCheckSettings::Profile::serialize(
+    SExpression& root) const {
+  root.appendChild(name);
+  root.ensureLineBreak();
+  root.appendChild("planes", planes);
+  root.appendChild("arc_tolerance", maxArcTolerance);
+  QStringList sortedChecks = checks.values();
+  std::sort(sortedChecks.begin(), sortedChecks.end());
+  foreach (const QString& check, sortedChecks) {
+    root.ensureLineBreak();
+    root.appendChild("check", SExpression::createToken(check));
+  }
+  root.ensureLineBreak();
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -92,7 +122,8 @@ BoardDesignRuleCheckSettings::BoardDesignRuleCheckSettings() noexcept
     mBlindViasAllowed(false),  // Just to be on the safe side
     mBuriedViasAllowed(false),  // Just to be on the safe side
     mAllowedNpthSlots(AllowedSlots::SingleSegmentStraight),
-    mAllowedPthSlots(AllowedSlots::SingleSegmentStraight) {
+    mAllowedPthSlots(AllowedSlots::SingleSegmentStraight),
+    mProfiles() {
 }
 
 BoardDesignRuleCheckSettings::BoardDesignRuleCheckSettings(
@@ -141,12 +172,38 @@ BoardDesignRuleCheckSettings::BoardDesignRuleCheckSettings(
     mAllowedNpthSlots(
         deserialize<AllowedSlots>(node.getChild("allowed_npth_slots/@0"))),
     mAllowedPthSlots(
-        deserialize<AllowedSlots>(node.getChild("allowed_pth_slots/@0"))) {
+        deserialize<AllowedSlots>(node.getChild("allowed_pth_slots/@0"))),
+    mProfiles() {
+  // Profiles are optional to keep settings without profiles unchanged.
+  foreach (const SExpression* child, node.getChildren("profile")) {
+    mProfiles.append(Profile(*child));  // can throw
+  }
 }
 
 BoardDesignRuleCheckSettings::~BoardDesignRuleCheckSettings() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+tl::optional<BoardDesignRuleCheckSettings::Profile>
+    BoardDesignRuleCheckSettings::findProfile(
+        const QString& name) const noexcept {
+  foreach (const Profile& profile, mProfiles) {
+    if (profile.name == name) {
+      return profile;
+    }
+  }
+  const QList<Profile> builtInProfiles = {getFullProfile(), getQuickProfile()};
+  foreach (const Profile& profile, builtInProfiles) {
+    if (profile.name == name) {
+      return profile;
+    }
+  }
+  return tl::nullopt;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -192,6 +249,27 @@ void BoardDesignRuleCheckSettings::serialize(SExpression& root) const {
   root.ensureLineBreak();
   root.appendChild("allowed_pth_slots", mAllowedPthSlots);
   root.ensureLineBreak();
+  foreach (const Profile& profile, mProfiles) {
+    profile.serialize(root.appendList("profile"));
+    root.ensureLineBreak();
+  }
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+BoardDesignRuleCheckSettings::Profile
+    BoardDesignRuleCheckSettings::getFullProfile() noexcept {
+  return Profile("full", {}, true, PositiveLength(5000));
+}
+
+BoardDesignRuleCheckSettings::Profile
+    BoardDesignRuleCheckSettings::getQuickProfile() noexcept {
+  return Profile("quick",
+                 {"minimum_copper_width", "copper_copper_clearances",
+                  "copper_board_clearances", "copper_hole_clearances"},
+                 false, PositiveLength(5000));
 }
 
 /*******************************************************************************
@@ -219,6 +297,7 @@ BoardDesignRuleCheckSettings& BoardDesignRuleCheckSettings::operator=(
   mBuriedViasAllowed = rhs.mBuriedViasAllowed;
   mAllowedNpthSlots = rhs.mAllowedNpthSlots;
   mAllowedPthSlots = rhs.mAllowedPthSlots;
+  mProfiles = rhs.mProfiles;
   return *this;
 }
 
@@ -244,6 +323,7 @@ bool BoardDesignRuleCheckSettings::operator==(
   if (mBuriedViasAllowed != rhs.mBuriedViasAllowed) return false;
   if (mAllowedNpthSlots != rhs.mAllowedNpthSlots) return false;
   if (mAllowedPthSlots != rhs.mAllowedPthSlots) return false;
+  if (mProfiles != rhs.mProfiles) return false;
   return true;
 }
 
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "../../../types/length.h"
 
+#include <optional/tl/optional.hpp>
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -51,6 +53,36 @@ public:
     Any = 3,  ///< Any kind of slot is allowed (including curves).
   };
 
+  /**
+   * @brief A named selection of checks to run, e.g. for quick in-loop runs
+   *
+   * The built-in profiles #getFullProfile() and #getQuickProfile() are always
+   * available, but can be overridden by custom profiles of the same name.
+   */
+  struct Profile {
+    QString name;  ///< Unique name to select the profile
+    QSet<QString> checks;  ///< Identifiers of checks to run (empty = all)
+    bool planes;  ///< Whether planes are rebuilt and taken into account
+    PositiveLength maxArcTolerance;  ///< Tolerance for flattening arcs
+
+    Profile(const QString& name, const QSet<QString>& checks, bool planes,
+            const PositiveLength& maxArcTolerance) noexcept
+      : name(name),
+        checks(checks),
+        planes(planes),
+        maxArcTolerance(maxArcTolerance) {}
+    explicit Profile(const SExpression& node);
+    void serialize(SExpression& root) const;
+    bool runsCheck(const QString& check) const noexcept {
+      return checks.isEmpty() || checks.contains(check);
+    }
+    bool isComplete() const noexcept { return checks.isEmpty() && planes; }
+    bool operator==(const Profile& rhs) const noexcept {
+      return (name == rhs.name) && (checks == rhs.checks) &&
+          (planes == rhs.planes) && (maxArcTolerance == rhs.maxArcTolerance);
+    }
+  };
+
   // Constructors / Destructor
   BoardDesignRuleCheckSettings() noexcept;
   BoardDesignRuleCheckSettings(
@@ -110,6 +142,17 @@ public:
     return mAllowedNpthSlots;
   }
   AllowedSlots getAllowedPthSlots() const noexcept { return mAllowedPthSlots; }
+  const QList<Profile>& getProfiles() const noexcept { return mProfiles; }
+
+  /**
+   * @brief Get a profile by name
+   *
+   * @param name  Name of a custom profile or a built-in profile.
+   *
+   * @return The custom profile of that name if there is one, otherwise the
+   *         built-in profile of that name, or `tl::nullopt` if not found.
+   */
+  tl::optional<Profile> findProfile(const QString& name) const noexcept;
 
   // Setters
   void setMinCopperCopperClearance(const UnsignedLength& value) noexcept {
@@ -165,6 +208,9 @@ public:
   void setAllowedNpthSlots(AllowedSlots value) noexcept {
     mAllowedPthSlots = value;
   }
+  void setProfiles(const QList<Profile>& profiles) noexcept {
+    mProfiles = profiles;
+  }
 
   // General Methods
 
@@ -175,6 +221,24 @@ public:
    */
   void serialize(SExpression& root) const;
 
+  // Static Methods
+
+  /**
+   * @brief Get the built-in profile "full" which runs all checks
+   *
+   * @return The profile.
+   */
+  static Profile getFullProfile() noexcept;
+
+  /**
+   * @brief Get the built-in profile "quick" which runs the copper checks only
+   *
+   * Planes are neither rebuilt nor checked.
+   *
+   * @return The profile.
+   */
+  static Profile getQuickProfile() noexcept;
+
   // Operator Overloadings
   BoardDesignRuleCheckSettings& operator=(
       const BoardDesignRuleCheckSettings& rhs) noexcept;
@@ -208,6 +272,9 @@ private:  // Data
   bool mBuriedViasAllowed;
   AllowedSlots mAllowedNpthSlots;
   AllowedSlots mAllowedPthSlots;
+
+  // Profiles
+  QList<Profile> mProfiles;  ///< Custom profiles
 };
 
 /*******************************************************************************
@@ -215,6 +215,24 @@ QVector<std::shared_ptr<const Part>> BI_Device::getParts(
   return parts;
 }
 
+std::shared_ptr<const Part> BI_Device::getPart(
+    const tl::optional<Uuid>& assemblyVariant) const noexcept {
+  // Same as getParts().value(0), but without collecting all parts.
+  for (const ComponentAssemblyOption& opt :
+       mCompInstance.getAssemblyOptions()) {
+    if ((opt.getDevice() == mLibDevice->getUuid()) &&
+        ((!assemblyVariant) ||
+         (opt.getAssemblyVariants().contains(*assemblyVariant)))) {
+      if (!opt.getParts().isEmpty()) {
+        return opt.getParts().first();
+      }
+      return std::make_shared<const Part>(SimpleString(""), SimpleString(""),
+                                          opt.getAttributes());
+    }
+  }
+  return nullptr;
+}
+
 bool BI_Device::isInAssemblyVariant(
     const Uuid& assemblyVariant) const noexcept {
   for (const ComponentAssemblyOption& opt :
@@ -259,7 +277,7 @@ StrokeTextList BI_Device::getDefaultStrokeTexts() const noexcept {
 }
 
 void BI_Device::addStrokeText(BI_StrokeText& text) {
-  if ((mStrokeTexts.values().contains(&text)) ||
+  if ((mStrokeTexts.value(text.getData().getUuid()) == &text) ||
       (&text.getBoard() != &mBoard)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -57,7 +57,8 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid, const Layer& layer,
     mThermalSpokeWidth(300000),
     mLocked(false),
     mIsVisible(true),
-    mFragments() {
+    mFragments(),
+    mFragmentsMemory("Plane fragments") {
 }
 
 BI_Plane::~BI_Plane() noexcept {
@@ -171,7 +172,13 @@ void BI_Plane::setVisible(bool visible) noexcept {
 void BI_Plane::setCalculatedFragments(const QVector<Path>& fragments) noexcept {
   if (fragments != mFragments) {
     mFragments = fragments;
+    qint64 bytes = 0;
+    foreach (const Path& fragment, mFragments) {
+      bytes += sizeof(Path) + fragment.getVertices().count() * sizeof(Vertex);
+    }
+    mFragmentsMemory.set(mFragments.count(), bytes);
     onEdited.notify(Event::FragmentsChanged);
+    emit mBoard.planeFragmentsChanged(*this);
     if (mNetSignal) {
       mBoard.scheduleAirWiresRebuild(mNetSignal);
     }
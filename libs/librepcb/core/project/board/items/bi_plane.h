@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include "../../../exceptions.h"
 #include "../../../geometry/path.h"
+#include "../../../memoryaccounting.h"
 #include "../../../types/uuid.h"
 #include "bi_base.h"
 
@@ -143,6 +144,7 @@ private:  // Data
   bool mIsVisible;  // volatile, not saved to file
 
   QVector<Path> mFragments;
+  MemoryAccounting::Counter mFragmentsMemory;
 };
 
 /*******************************************************************************
@@ -228,8 +228,7 @@ void BI_StrokeText::removeFromBoard() {
 void BI_StrokeText::updateText() noexcept {
   const QString text = AttributeSubstitutor::substitute(
       mData.getText(),
-      mDevice ? ProjectAttributeLookup(*mDevice,
-                                       mDevice->getParts(tl::nullopt).value(0))
+      mDevice ? ProjectAttributeLookup(*mDevice, mDevice->getPart(tl::nullopt))
               : ProjectAttributeLookup(mBoard, nullptr));
   if (text != mSubstitutedText) {
     mSubstitutedText = text;
@@ -139,7 +139,7 @@ NetClass* Circuit::getNetClassByName(const ElementName& name) const noexcept {
 }
 
 void Circuit::addNetClass(NetClass& netclass) {
-  if ((mNetClasses.values().contains(&netclass)) ||
+  if ((mNetClasses.value(netclass.getUuid()) == &netclass) ||
       (&netclass.getCircuit() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -188,21 +188,17 @@ void Circuit::setNetClassName(NetClass& netclass, const ElementName& newName) {
  ******************************************************************************/
 
 QString Circuit::generateAutoNetSignalName() const noexcept {
-  QString name;
-  int i = 1;
-  do {
-    name = QString("N%1").arg(i++);
-  } while (getNetSignalByName(name));
+  int& i = mNextAutoNetSignalNumbers["N"];
+  i = std::max(i, 1);
+  QString name = QString("N%1").arg(i);
+  while (getNetSignalByName(name)) {
+    name = QString("N%1").arg(++i);
+  }
   return name;
 }
 
 NetSignal* Circuit::getNetSignalByName(const QString& name) const noexcept {
-  foreach (NetSignal* netsignal, mNetSignals) {
-    if (netsignal->getName() == name) {
-      return netsignal;
-    }
-  }
-  return nullptr;
+  return mNetSignalsByName.value(name, nullptr);
 }
 
 NetSignal* Circuit::getNetSignalWithMostElements() const noexcept {
@@ -218,7 +214,7 @@ NetSignal* Circuit::getNetSignalWithMostElements() const noexcept {
 }
 
 void Circuit::addNetSignal(NetSignal& netsignal) {
-  if ((mNetSignals.values().contains(&netsignal)) ||
+  if ((mNetSignals.value(netsignal.getUuid()) == &netsignal) ||
       (&netsignal.getCircuit() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -235,6 +231,7 @@ void Circuit::addNetSignal(NetSignal& netsignal) {
   }
   netsignal.addToCircuit();  // can throw
   mNetSignals.insert(netsignal.getUuid(), &netsignal);
+  mNetSignalsByName.insert(*netsignal.getName(), &netsignal);
   emit netSignalAdded(netsignal);
 }
 
@@ -244,6 +241,8 @@ void Circuit::removeNetSignal(NetSignal& netsignal) {
   }
   netsignal.removeFromCircuit();  // can throw
   mNetSignals.remove(netsignal.getUuid());
+  mNetSignalsByName.remove(*netsignal.getName());
+  releaseAutoName(mNextAutoNetSignalNumbers, *netsignal.getName());
   emit netSignalRemoved(netsignal);
 }
 
@@ -261,7 +260,11 @@ void Circuit::setNetSignalName(NetSignal& netsignal,
                            .arg(*newName));
   }
   // apply the new name
+  const QString oldName = *netsignal.getName();
   netsignal.setName(newName, isAutoName);  // can throw
+  mNetSignalsByName.remove(oldName);
+  mNetSignalsByName.insert(*newName, &netsignal);
+  releaseAutoName(mNextAutoNetSignalNumbers, oldName);
 }
 
 /*******************************************************************************
@@ -270,12 +273,13 @@ void Circuit::setNetSignalName(NetSignal& netsignal,
 
 QString Circuit::generateAutoComponentInstanceName(
     const ComponentPrefix& cmpPrefix) const noexcept {
-  QString name;
-  int i = 1;
-  do {
-    name =
-        QString("%1%2").arg(cmpPrefix->isEmpty() ? "?" : *cmpPrefix).arg(i++);
-  } while (getComponentInstanceByName(name));
+  const QString prefix = cmpPrefix->isEmpty() ? "?" : *cmpPrefix;
+  int& i = mNextAutoComponentInstanceNumbers[prefix];
+  i = std::max(i, 1);
+  QString name = QString("%1%2").arg(prefix).arg(i);
+  while (getComponentInstanceByName(name)) {
+    name = QString("%1%2").arg(prefix).arg(++i);
+  }
   return name;
 }
 
@@ -286,10 +290,7 @@ ComponentInstance* Circuit::getComponentInstanceByUuid(
 
 ComponentInstance* Circuit::getComponentInstanceByName(
     const QString& name) const noexcept {
-  foreach (ComponentInstance* compInstance, mComponentInstances) {
-    if (compInstance->getName() == name) return compInstance;
-  }
-  return nullptr;
+  return mComponentInstancesByName.value(name, nullptr);
 }
 
 void Circuit::addComponentInstance(ComponentInstance& cmp) {
@@ -312,6 +313,7 @@ void Circuit::addComponentInstance(ComponentInstance& cmp) {
   // add to circuit
   cmp.addToCircuit();  // can throw
   mComponentInstances.insert(cmp.getUuid(), &cmp);
+  mComponentInstancesByName.insert(*cmp.getName(), &cmp);
   emit componentAdded(cmp);
 }
 
@@ -323,6 +325,8 @@ void Circuit::removeComponentInstance(ComponentInstance& cmp) {
   // remove from circuit
   cmp.removeFromCircuit();  // can throw
   mComponentInstances.remove(cmp.getUuid());
+  mComponentInstancesByName.remove(*cmp.getName());
+  releaseAutoName(mNextAutoComponentInstanceNumbers, *cmp.getName());
   emit componentRemoved(cmp);
 }
 
@@ -339,7 +343,11 @@ void Circuit::setComponentInstanceName(ComponentInstance& cmp,
         tr("There is already a component with the name \"%1\"!").arg(*newName));
   }
   // apply the new name
+  const QString oldName = *cmp.getName();
   cmp.setName(newName);  // can throw
+  mComponentInstancesByName.remove(oldName);
+  mComponentInstancesByName.insert(*newName, &cmp);
+  releaseAutoName(mNextAutoComponentInstanceNumbers, oldName);
 }
 
 /*******************************************************************************
@@ -365,6 +373,25 @@ void Circuit::serialize(SExpression& root) const {
   root.ensureLineBreak();
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void Circuit::releaseAutoName(QHash<QString, int>& nextNumbers,
+                              const QString& name) noexcept {
+  // If the name looks like an auto name, make its number available again.
+  int pos = name.length();
+  while ((pos > 0) && name.at(pos - 1).isDigit()) {
+    --pos;
+  }
+  bool ok = false;
+  const int number = name.mid(pos).toInt(&ok);
+  auto it = nextNumbers.find(name.left(pos));
+  if (ok && (it != nextNumbers.end()) && (number < it.value())) {
+    it.value() = number;
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -152,12 +152,24 @@ signals:
   void componentAdded(ComponentInstance& cmp);
   void componentRemoved(ComponentInstance& cmp);
 
-private:
+private:  // Methods
+  static void releaseAutoName(QHash<QString, int>& nextNumbers,
+                              const QString& name) noexcept;
+
+private:  // Data
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   AssemblyVariantList mAssemblyVariants;
   QMap<Uuid, NetClass*> mNetClasses;
   QMap<Uuid, NetSignal*> mNetSignals;
   QMap<Uuid, ComponentInstance*> mComponentInstances;
+
+  // Name indices to avoid linear searches, kept in sync by the setters.
+  QHash<QString, NetSignal*> mNetSignalsByName;
+  QHash<QString, ComponentInstance*> mComponentInstancesByName;
+
+  /// Per prefix, all auto names with a lower number are known to be in use
+  mutable QHash<QString, int> mNextAutoNetSignalNumbers;
+  mutable QHash<QString, int> mNextAutoComponentInstanceNumbers;
 };
 
 /*******************************************************************************
@@ -116,6 +116,22 @@ QVector<std::shared_ptr<const Part>> ComponentInstance::getParts(
   return parts;
 }
 
+std::shared_ptr<const Part> ComponentInstance::getPart(
+    const tl::optional<Uuid>& assemblyVariant) const noexcept {
+  // Same as getParts().value(0), but without collecting all parts.
+  for (const ComponentAssemblyOption& opt : mAssemblyOptions) {
+    if ((!assemblyVariant) ||
+        (opt.getAssemblyVariants().contains(*assemblyVariant))) {
+      if (!opt.getParts().isEmpty()) {
+        return opt.getParts().first();
+      }
+      return std::make_shared<const Part>(SimpleString(""), SimpleString(""),
+                                          opt.getAttributes());
+    }
+  }
+  return nullptr;
+}
+
 QSet<Uuid> ComponentInstance::getUsedDeviceUuids() const noexcept {
   QSet<Uuid> uuids;
   foreach (const BI_Device* device, mRegisteredDevices) {
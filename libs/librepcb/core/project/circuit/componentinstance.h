@@ -88,6 +88,8 @@ public:
   QSet<Uuid> getCompatibleDevices() const noexcept;
   QVector<std::shared_ptr<const Part>> getParts(
       const tl::optional<Uuid>& assemblyVariant) const noexcept;
+  std::shared_ptr<const Part> getPart(
+      const tl::optional<Uuid>& assemblyVariant) const noexcept;
   bool getLockAssembly() const noexcept { return mLockAssembly; }
 
   // Getters: General
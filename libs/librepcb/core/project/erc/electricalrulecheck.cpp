@@ -24,6 +24,8 @@
 
 #include "../../library/cmp/component.h"
 #include "../../library/cmp/componentsignal.h"
+#include "../../tracer.h"
+#include "../../utils/concurrency.h"
 #include "../circuit/circuit.h"
 #include "../circuit/componentinstance.h"
 #include "../circuit/componentsignalinstance.h"
@@ -37,6 +39,7 @@
 #include "../schematic/schematic.h"
 #include "electricalrulecheckmessages.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -49,7 +52,7 @@ namespace librepcb {
  ******************************************************************************/
 
 ElectricalRuleCheck::ElectricalRuleCheck(const Project& project) noexcept
-  : mProject(project) {
+  : QObject(nullptr), mProject(project), mIncremental(false) {
 }
 
 ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
@@ -59,14 +62,104 @@ ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
  *  General Methods
  ******************************************************************************/
 
-RuleCheckMessageList ElectricalRuleCheck::runChecks() const {
+void ElectricalRuleCheck::enableIncrementalChecks() noexcept {
+  if (mIncremental) {
+    return;
+  }
+  mIncremental = true;
+
+  // Track schematics and their items.
+  connect(&mProject, &Project::schematicAdded, this, [this](int index) {
+    if (const Schematic* schematic = mProject.getSchematicByIndex(index)) {
+      trackSchematic(*schematic);
+    }
+  });
+  connect(&mProject, &Project::schematicRemoved, this,
+          &ElectricalRuleCheck::invalidateAllSchematics);
+  foreach (const Schematic* schematic, mProject.getSchematics()) {
+    trackSchematic(*schematic);
+  }
+
+  // Circuit modifications might affect any schematic, e.g. net names or pin
+  // connections are checked in schematics.
+  const Circuit& circuit = mProject.getCircuit();
+  connect(&circuit, &Circuit::netSignalAdded, this, [this](NetSignal& ns) {
+    trackNetSignal(ns);
+    invalidateAllSchematics();
+  });
+  connect(&circuit, &Circuit::netSignalRemoved, this, [this](NetSignal& ns) {
+    disconnect(&ns, nullptr, this, nullptr);
+    invalidateAllSchematics();
+  });
+  connect(&circuit, &Circuit::componentAdded, this,
+          [this](ComponentInstance& cmp) {
+            trackComponent(cmp);
+            invalidateAllSchematics();
+          });
+  connect(&circuit, &Circuit::componentRemoved, this,
+          [this](ComponentInstance& cmp) {
+            untrackComponent(cmp);
+            invalidateAllSchematics();
+          });
+  foreach (const NetSignal* netSignal, circuit.getNetSignals()) {
+    trackNetSignal(*netSignal);
+  }
+  foreach (const ComponentInstance* cmp, circuit.getComponentInstances()) {
+    trackComponent(*cmp);
+  }
+}
+
+RuleCheckMessageList ElectricalRuleCheck::runChecks() {
+  Tracer::Span span("erc", "ElectricalRuleCheck::runChecks");
+  const QSet<const NetSignal*> previousOpenNetSignals = mOpenNetSignals;
   mOpenNetSignals.clear();
 
   RuleCheckMessageList msgs;
   checkNetClasses(msgs);
-  checkNetSignals(msgs);
-  checkComponents(msgs);
-  checkSchematics(msgs);
+  checkNetSignals(msgs);  // Determines open nets, required for schematics.
+
+  // The open wire check of net segments depends on the open nets.
+  if ((!mIncremental) || (mOpenNetSignals != previousOpenNetSignals)) {
+    mSchematicMessages.clear();
+  }
+
+  // The remaining checks only read from the project and are independent of
+  // each other, thus run them in parallel. The messages are merged in a fixed
+  // order to get deterministic results.
+  QThreadPool threadPool;  // Waits for all workers on destruction.
+  Concurrency::apply(threadPool);
+  QVector<QFuture<RuleCheckMessageList>> futures;
+  futures.append(QtConcurrent::run(&threadPool, [this]() {
+    RuleCheckMessageList cmpMsgs;
+    checkComponents(cmpMsgs);
+    return cmpMsgs;
+  }));
+  QHash<const Schematic*, QFuture<RuleCheckMessageList>> schematicFutures;
+  foreach (const Schematic* schematic, mProject.getSchematics()) {
+    if (!mSchematicMessages.contains(schematic)) {
+      schematicFutures.insert(
+          schematic, QtConcurrent::run(&threadPool, [this, schematic]() {
+            RuleCheckMessageList schematicMsgs;
+            checkSchematic(*schematic, schematicMsgs);
+            return schematicMsgs;
+          }));
+    }
+  }
+  foreach (const QFuture<RuleCheckMessageList>& future, futures) {
+    msgs += future.result();  // can throw
+  }
+  QHash<const Schematic*, RuleCheckMessageList> schematicMessages;
+  foreach (const Schematic* schematic, mProject.getSchematics()) {
+    const RuleCheckMessageList schematicMsgs =
+        schematicFutures.contains(schematic)
+        ? schematicFutures[schematic].result()  // can throw
+        : mSchematicMessages.value(schematic);
+    msgs += schematicMsgs;
+    if (mIncremental) {
+      schematicMessages.insert(schematic, schematicMsgs);
+    }
+  }
+  mSchematicMessages = schematicMessages;  // Drops removed schematics.
   return msgs;
 }
 
@@ -74,6 +167,75 @@ RuleCheckMessageList ElectricalRuleCheck::runChecks() const {
  *  Private Methods
  ******************************************************************************/
 
+void ElectricalRuleCheck::trackSchematic(const Schematic& schematic) noexcept {
+  // Removed objects might be added again by undo, avoid duplicate connections.
+  disconnect(&schematic, nullptr, this, nullptr);
+  auto invalidate = [this, &schematic]() { invalidateSchematic(schematic); };
+  connect(&schematic, &Schematic::attributesChanged, this, invalidate);
+  connect(&schematic, &Schematic::symbolAdded, this, invalidate);
+  connect(&schematic, &Schematic::symbolRemoved, this, invalidate);
+  connect(&schematic, &Schematic::netSegmentAdded, this,
+          [this, &schematic](SI_NetSegment& netSegment) {
+            trackNetSegment(netSegment);
+            invalidateSchematic(schematic);
+          });
+  connect(&schematic, &Schematic::netSegmentRemoved, this,
+          [this, &schematic](SI_NetSegment& netSegment) {
+            disconnect(&netSegment, nullptr, this, nullptr);
+            invalidateSchematic(schematic);
+          });
+  foreach (const SI_NetSegment* netSegment, schematic.getNetSegments()) {
+    trackNetSegment(*netSegment);
+  }
+}
+
+void ElectricalRuleCheck::trackNetSegment(
+    const SI_NetSegment& netSegment) noexcept {
+  disconnect(&netSegment, nullptr, this, nullptr);
+  const Schematic& schematic = netSegment.getSchematic();
+  auto invalidate = [this, &schematic]() { invalidateSchematic(schematic); };
+  connect(&netSegment, &SI_NetSegment::netPointsAndNetLinesAdded, this,
+          invalidate);
+  connect(&netSegment, &SI_NetSegment::netPointsAndNetLinesRemoved, this,
+          invalidate);
+  connect(&netSegment, &SI_NetSegment::netLabelAdded, this, invalidate);
+  connect(&netSegment, &SI_NetSegment::netLabelRemoved, this, invalidate);
+}
+
+void ElectricalRuleCheck::trackNetSignal(const NetSignal& netSignal) noexcept {
+  disconnect(&netSignal, nullptr, this, nullptr);
+  connect(&netSignal, &NetSignal::nameChanged, this,
+          &ElectricalRuleCheck::invalidateAllSchematics);
+}
+
+void ElectricalRuleCheck::trackComponent(
+    const ComponentInstance& cmp) noexcept {
+  untrackComponent(cmp);
+  connect(&cmp, &ComponentInstance::attributesChanged, this,
+          &ElectricalRuleCheck::invalidateAllSchematics);
+  foreach (const ComponentSignalInstance* sig, cmp.getSignals()) {
+    connect(sig, &ComponentSignalInstance::netSignalChanged, this,
+            &ElectricalRuleCheck::invalidateAllSchematics);
+  }
+}
+
+void ElectricalRuleCheck::untrackComponent(
+    const ComponentInstance& cmp) noexcept {
+  disconnect(&cmp, nullptr, this, nullptr);
+  foreach (const ComponentSignalInstance* sig, cmp.getSignals()) {
+    disconnect(sig, nullptr, this, nullptr);
+  }
+}
+
+void ElectricalRuleCheck::invalidateSchematic(
+    const Schematic& schematic) noexcept {
+  mSchematicMessages.remove(&schematic);
+}
+
+void ElectricalRuleCheck::invalidateAllSchematics() noexcept {
+  mSchematicMessages.clear();
+}
+
 void ElectricalRuleCheck::checkNetClasses(RuleCheckMessageList& msgs) const {
   // Don't warn if there's only one netclass, as we need one to be used as
   // default when adding a new wire.
@@ -144,11 +306,10 @@ void ElectricalRuleCheck::checkComponentSignals(
   }
 }
 
-void ElectricalRuleCheck::checkSchematics(RuleCheckMessageList& msgs) const {
-  foreach (const Schematic* schematic, mProject.getSchematics()) {
-    checkSymbols(*schematic, msgs);
-    checkNetSegments(*schematic, msgs);
-  }
+void ElectricalRuleCheck::checkSchematic(const Schematic& schematic,
+                                         RuleCheckMessageList& msgs) const {
+  checkSymbols(schematic, msgs);
+  checkNetSegments(schematic, msgs);
 }
 
 void ElectricalRuleCheck::checkSymbols(const Schematic& schematic,
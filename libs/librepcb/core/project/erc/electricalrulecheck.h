@@ -47,22 +47,48 @@ class Schematic;
  * @brief The ElectricalRuleCheck class checks a ::librepcb::Board for
  *        design rule violations
  */
-class ElectricalRuleCheck final {
+class ElectricalRuleCheck final : public QObject {
+  Q_OBJECT
+
 public:
   // Constructors / Destructor
+  ElectricalRuleCheck() = delete;
+  ElectricalRuleCheck(const ElectricalRuleCheck& other) = delete;
   explicit ElectricalRuleCheck(const Project& project) noexcept;
   ~ElectricalRuleCheck() noexcept;
 
   // General Methods
-  RuleCheckMessageList runChecks() const;
+
+  /**
+   * @brief Reuse the messages of unmodified schematics in subsequent runs
+   *
+   * Once enabled, modifications of the project are tracked and #runChecks()
+   * only re-checks schematics which have been modified since the last run,
+   * or which might be affected by modifications of the circuit. Useful if
+   * the object is kept alive to run the checks after every modification.
+   */
+  void enableIncrementalChecks() noexcept;
+
+  RuleCheckMessageList runChecks();
+
+  // Operator Overloadings
+  ElectricalRuleCheck& operator=(const ElectricalRuleCheck& rhs) = delete;
 
 private:  // Methods
+  void trackSchematic(const Schematic& schematic) noexcept;
+  void trackNetSegment(const SI_NetSegment& netSegment) noexcept;
+  void trackNetSignal(const NetSignal& netSignal) noexcept;
+  void trackComponent(const ComponentInstance& cmp) noexcept;
+  void untrackComponent(const ComponentInstance& cmp) noexcept;
+  void invalidateSchematic(const Schematic& schematic) noexcept;
+  void invalidateAllSchematics() noexcept;
   void checkNetClasses(RuleCheckMessageList& msgs) const;
   void checkNetSignals(RuleCheckMessageList& msgs) const;
   void checkComponents(RuleCheckMessageList& msgs) const;
   void checkComponentSignals(const ComponentInstance& cmp,
                              RuleCheckMessageList& msgs) const;
-  void checkSchematics(RuleCheckMessageList& msgs) const;
+  void checkSchematic(const Schematic& schematic,
+                      RuleCheckMessageList& msgs) const;
   void checkSymbols(const Schematic& schematic,
                     RuleCheckMessageList& msgs) const;
   void checkPins(const SI_Symbol& symbol, RuleCheckMessageList& msgs) const;
@@ -74,6 +100,12 @@ private:  // Methods
 private:  // Data
   const Project& mProject;
   mutable QSet<const NetSignal*> mOpenNetSignals;
+
+  /// Whether #mSchematicMessages is used and kept up to date
+  bool mIncremental;
+
+  /// Messages of schematics which have not been modified since the last run
+  QHash<const Schematic*, RuleCheckMessageList> mSchematicMessages;
 };
 
 /*******************************************************************************
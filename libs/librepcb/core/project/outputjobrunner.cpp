@@ -29,10 +29,12 @@
 #include "../export/graphicsexport.h"
 #include "../export/graphicsexportsettings.h"
 #include "../export/pickplacecsvwriter.h"
-#include "../fileio/csvfile.h"
+#include "../fileio/csvwriter.h"
 #include "../fileio/fileutils.h"
 #include "../fileio/outputdirectorywriter.h"
+#include "../fileio/transactionaldirectory.h"
 #include "../fileio/transactionalfilesystem.h"
+#include "../fileio/zipwriter.h"
 #include "../job/archiveoutputjob.h"
 #include "../job/board3doutputjob.h"
 #include "../job/bomoutputjob.h"
@@ -44,6 +46,10 @@
 #include "../job/netlistoutputjob.h"
 #include "../job/pickplaceoutputjob.h"
 #include "../job/projectjsonoutputjob.h"
+#include "../serialization/sexpression.h"
+#include "../tracer.h"
+#include "../utils/concurrency.h"
+#include "../utils/scopeguard.h"
 #include "board/board.h"
 #include "board/boardd356netlistexport.h"
 #include "board/boardfabricationoutputsettings.h"
@@ -57,8 +63,12 @@
 #include "projectjsonexport.h"
 #include "schematic/schematicpainter.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
+#include <algorithm>
+#include <atomic>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -69,7 +79,14 @@ namespace librepcb {
  ******************************************************************************/
 
 OutputJobRunner::OutputJobRunner(Project& project) noexcept
-  : QObject(nullptr), mProject(project), mWriter() {
+  : QObject(nullptr),
+    mProject(project),
+    mWriter(),
+    mParallelExecution(true),
+    mCacheEnabled(false),
+    mSkipUnchangedFiles(false),
+    mEventLogs(),
+    mEventLogsMutex() {
   setOutputDirectory(mProject.getCurrentOutputDir());
 }
 
@@ -89,16 +106,28 @@ const QMultiHash<Uuid, FilePath>& OutputJobRunner::getWrittenFiles()
   return mWriter->getWrittenFiles();
 }
 
+const QSet<FilePath>& OutputJobRunner::getUnchangedFiles() const noexcept {
+  return mWriter->getUnchangedFiles();
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
 
 void OutputJobRunner::setOutputDirectory(const FilePath& fp) noexcept {
   mWriter.reset(new OutputDirectoryWriter(fp));
-  connect(mWriter.data(), &OutputDirectoryWriter::aboutToWriteFile, this,
-          &OutputJobRunner::aboutToWriteFile);
-  connect(mWriter.data(), &OutputDirectoryWriter::aboutToRemoveFile, this,
-          &OutputJobRunner::aboutToRemoveFile);
+  connect(
+      mWriter.data(), &OutputDirectoryWriter::aboutToWriteFile, this,
+      [this](const FilePath& fp) {
+        notify([this, fp]() { emit aboutToWriteFile(fp); });
+      },
+      Qt::DirectConnection);
+  connect(
+      mWriter.data(), &OutputDirectoryWriter::aboutToRemoveFile, this,
+      [this](const FilePath& fp) {
+        notify([this, fp]() { emit aboutToRemoveFile(fp); });
+      },
+      Qt::DirectConnection);
 }
 
 /*******************************************************************************
@@ -107,10 +136,20 @@ void OutputJobRunner::setOutputDirectory(const FilePath& fp) noexcept {
 
 void OutputJobRunner::run(const QVector<std::shared_ptr<OutputJob>>& jobs) {
   mWriter->loadIndex();  // can throw
-  foreach (const auto& job, jobs) {
-    emit jobStarted(job);
-    run(*job);  // can throw
-    qApp->processEvents();  // Avoid freeze due to blocking loop.
+  mWriter->setSkipUnchangedFiles(mSkipUnchangedFiles);
+  if (mCacheEnabled) {
+    // Write the current state of the project to its file system (but not to
+    // the disk!) since the input hashes are calculated from the files.
+    mProject.save();  // can throw
+  }
+  if (mParallelExecution) {
+    runConcurrently(jobs);  // can throw
+  } else {
+    foreach (const auto& job, jobs) {
+      emit jobStarted(job);
+      run(*job);  // can throw
+      qApp->processEvents();  // Avoid freeze due to blocking loop.
+    }
   }
   mWriter->storeIndex();  // can throw
 }
@@ -182,10 +221,14 @@ GraphicsExport::Pages OutputJobRunner::buildPages(
       }
     } else if (content.type == GraphicsOutputJob::Content::Type::Board) {
       foreach (const Board* board, boards) {
+        // The content is the same for all assembly variants, so share the
+        // painter to collect the board content only once.
+        std::shared_ptr<GraphicsPagePainter> painter;
         foreach (auto av, assemblyVariants) {
           Q_UNUSED(av);  // TODO
-          std::shared_ptr<GraphicsPagePainter> painter =
-              std::make_shared<BoardPainter>(*board);
+          if (!painter) {
+            painter = std::make_shared<BoardPainter>(*board);
+          }
           pages.append(std::make_pair(painter, settings));
         }
       }
@@ -206,8 +249,93 @@ GraphicsExport::Pages OutputJobRunner::buildPages(
  *  Private Methods
  ******************************************************************************/
 
+void OutputJobRunner::runConcurrently(
+    const QVector<std::shared_ptr<OutputJob>>& jobs) {
+  // Jobs which only read the project are executed on a dedicated thread pool
+  // while the signals they emit are recorded and re-emitted from this thread
+  // in the order of the jobs. Jobs which depend on output files of other
+  // jobs or which modify the project are executed afterwards in this thread.
+  struct PendingJob {
+    std::shared_ptr<OutputJob> job;
+    std::shared_ptr<EventLog> log;
+    QFuture<void> future;
+  };
+  std::atomic<bool> abort(false);
+  QThreadPool threadPool;  // Waits for all workers on destruction.
+  Concurrency::apply(threadPool);
+  QVector<PendingJob> pendingJobs;
+  auto finishPendingJobs = [&]() {
+    for (PendingJob& pending : pendingJobs) {
+      emit jobStarted(pending.job);
+      auto replayGuard = scopeGuard([&pending]() {
+        foreach (const auto& event, *pending.log) {
+          event();
+        }
+      });
+      try {
+        pending.future.waitForFinished();  // can throw
+      } catch (...) {
+        abort = true;  // Do not start remaining jobs, like serial execution.
+        throw;
+      }
+    }
+    pendingJobs.clear();
+    qApp->processEvents();  // Avoid freeze due to blocking loop.
+  };
+
+  foreach (const auto& job, jobs) {
+    if (isExclusive(*job)) {
+      finishPendingJobs();  // can throw
+      emit jobStarted(job);
+      run(*job);  // can throw
+      qApp->processEvents();  // Avoid freeze due to blocking loop.
+    } else {
+      std::shared_ptr<EventLog> log = std::make_shared<EventLog>();
+      auto worker = [this, job, log, &abort]() {
+        if (abort) {
+          return;
+        }
+        {
+          QMutexLocker lock(&mEventLogsMutex);
+          mEventLogs.insert(QThread::currentThread(), log.get());
+        }
+        auto sg = scopeGuard([this]() {
+          QMutexLocker lock(&mEventLogsMutex);
+          mEventLogs.remove(QThread::currentThread());
+        });
+        run(*job);  // can throw
+      };
+      pendingJobs.append(
+          PendingJob{job, log, QtConcurrent::run(&threadPool, worker)});
+    }
+  }
+  finishPendingJobs();  // can throw
+}
+
+void OutputJobRunner::notify(const std::function<void()>& event) {
+  {
+    QMutexLocker lock(&mEventLogsMutex);
+    if (EventLog* log = mEventLogs.value(QThread::currentThread())) {
+      log->append(event);
+      return;
+    }
+  }
+  event();
+}
+
 void OutputJobRunner::run(const OutputJob& job) {
-  const int countBefore = mWriter->getWrittenFiles().count(job.getUuid());
+  Tracer::Span span("job", "OutputJobRunner::run", *job.getName());
+  // Reuse the output files of the last run if the inputs did not change.
+  QByteArray inputHash;
+  if (mCacheEnabled && (!isExclusive(job))) {
+    inputHash = calcInputHash(job);  // can throw
+    if (reuseCachedFiles(job, inputHash)) {  // can throw
+      return;
+    }
+  }
+  mWriter->setInputHash(job.getUuid(), QByteArray());  // Invalidate cache.
+
+  const int countBefore = mWriter->getWrittenFiles(job.getUuid()).count();
   if (auto ptr = dynamic_cast<const BomOutputJob*>(&job)) {
     runImpl(*ptr);
   } else if (auto ptr = dynamic_cast<const GraphicsOutputJob*>(&job)) {
@@ -236,12 +364,88 @@ void OutputJobRunner::run(const OutputJob& job) {
         tr("Unknown output job type '%1'.").arg(job.getType()) % " " %
             tr("You may need a more recent LibrePCB version to run this job."));
   }
-  const int countAfter = mWriter->getWrittenFiles().count(job.getUuid());
+  const int countAfter = mWriter->getWrittenFiles(job.getUuid()).count();
   mWriter->removeObsoleteFiles(job.getUuid());  // can throw
   if (countAfter <= countBefore) {
-    emit warning(
-        tr("No output files were generated, check the job configuration."));
+    const QString msg =
+        tr("No output files were generated, check the job configuration.");
+    notify([this, msg]() { emit warning(msg); });
+  } else {
+    mWriter->setInputHash(job.getUuid(), inputHash);
+  }
+}
+
+bool OutputJobRunner::reuseCachedFiles(const OutputJob& job,
+                                       const QByteArray& inputHash) {
+  if (mWriter->getInputHash(job.getUuid()) != inputHash) {
+    return false;
+  }
+  const QList<FilePath> files = mWriter->getIndexedFiles(job.getUuid());
+  if (files.isEmpty()) {
+    return false;
+  }
+  foreach (const FilePath& fp, files) {
+    if (!fp.isExistingFile()) {
+      return false;  // Deleted by the user, thus re-run the job.
+    }
+  }
+  qDebug().noquote() << "Reuse cached output files of job" << *job.getName();
+  foreach (const FilePath& fp, files) {
+    const QString relPath = fp.toRelative(mWriter->getDirectoryPath());
+    mWriter->beginWritingFile(job.getUuid(), relPath);  // can throw
+  }
+  return true;
+}
+
+QByteArray OutputJobRunner::calcInputHash(const OutputJob& job) const {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(Application::getVersion().toUtf8());
+  hash.addData(mWriter->getDirectoryPath().toStr().toUtf8());
+  SExpression root = SExpression::createList("librepcb_job");
+  job.serialize(root);  // can throw
+  hash.addData(root.toByteArray());
+
+  // Conservatively only derive which directories of the project a job
+  // depends on from its type. Only schematics are not read by board-related
+  // jobs.
+  QStringList dirs = {"project", "library", "circuit", "boards"};
+  if (dynamic_cast<const GraphicsOutputJob*>(&job) ||
+      dynamic_cast<const ProjectJsonOutputJob*>(&job)) {
+    dirs.append("schematics");
   }
+  foreach (const QString& dir, dirs) {
+    addDirToHash(hash, mProject.getDirectory(), dir);  // can throw
+  }
+  return hash.result();
+}
+
+void OutputJobRunner::addDirToHash(QCryptographicHash& hash,
+                                   const FileSystem& fs, const QString& dir) {
+  QStringList files = fs.getFiles(dir);
+  std::sort(files.begin(), files.end());
+  foreach (const QString& file, files) {
+    if (file.endsWith(".user.lp")) {
+      continue;  // User settings (e.g. view state) are not relevant.
+    }
+    const QString path = dir % "/" % file;
+    const QByteArray content = fs.read(path);  // can throw
+    hash.addData(path.toUtf8());
+    hash.addData(QByteArray::number(content.size()));
+    hash.addData(content);
+  }
+  QStringList subDirs = fs.getDirs(dir);
+  std::sort(subDirs.begin(), subDirs.end());
+  foreach (const QString& subDir, subDirs) {
+    addDirToHash(hash, fs, dir % "/" % subDir);  // can throw
+  }
+}
+
+bool OutputJobRunner::isExclusive(const OutputJob& job) noexcept {
+  // These jobs depend on output files of other jobs (archive, copy) or
+  // modify the project (LPPZ).
+  return dynamic_cast<const ArchiveOutputJob*>(&job) ||
+      dynamic_cast<const CopyOutputJob*>(&job) ||
+      dynamic_cast<const LppzOutputJob*>(&job);
 }
 
 void OutputJobRunner::runImpl(const GraphicsOutputJob& job) {
@@ -333,6 +537,10 @@ void OutputJobRunner::runImpl(const GerberExcellonOutputJob& job) {
       mWriter->beginWritingFile(job.getUuid(),
                                 fp.toRelative(mWriter->getDirectoryPath()));
     });
+    grbExport.setWriteCallback(
+        [this](const FilePath& fp, const QByteArray& content) {
+          mWriter->writeFile(fp, content);  // can throw
+        });
     grbExport.exportPcbLayers(settings);  // can throw
   }
 }
@@ -374,15 +582,21 @@ void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
     typeFilter.insert(PickPlaceDataItem::Type::Other);
   }
   if (typeFilter.isEmpty()) {
-    emit warning(
+    const QString msg =
         tr("No technologies selected, thus the output files won't "
-           "contain any entries."));
+           "contain any entries.");
+    notify([this, msg]() { emit warning(msg); });
   }
 
+  // The output files are determined sequentially, but the data of each
+  // board and assembly variant is generated in parallel since the generators
+  // only read the project.
+  QThreadPool threadPool;  // Waits for all workers on destruction.
+  Concurrency::apply(threadPool);
+  QVector<QFuture<void>> futures;
   foreach (const Board* board, boards) {
     foreach (const std::shared_ptr<AssemblyVariant>& av, assemblyVariants) {
-      BoardPickPlaceGenerator gen(*board, av->getUuid());
-      std::shared_ptr<PickPlaceData> data = gen.generate();
+      QVector<std::pair<PickPlaceCsvWriter::BoardSide, FilePath>> files;
       foreach (const auto& pair, sides) {
         const FilePath fp = mWriter->beginWritingFile(
             job.getUuid(),
@@ -392,22 +606,32 @@ void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
                   return FilePath::cleanFileName(
                       str, FilePath::ReplaceSpaces | FilePath::KeepCase);
                 }));  // can throw
-
-        if (fp.getSuffix().toLower() == "csv") {
-          PickPlaceCsvWriter writer(*data);
-          writer.setIncludeMetadataComment(job.getIncludeComment());
-          writer.setBoardSide(pair.first);
-          writer.setTypeFilter(typeFilter);
-          std::shared_ptr<CsvFile> csv = writer.generateCsv();  // can throw
-          csv->saveToFile(fp);  // can throw
-        } else {
+        if (fp.getSuffix().toLower() != "csv") {
           throw RuntimeError(__FILE__, __LINE__,
                              QString("Unsupported pick&place format: '%1'")
                                  .arg(fp.getSuffix()));
         }
+        files.append(std::make_pair(pair.first, fp));
       }
+      futures.append(QtConcurrent::run(&threadPool, [this, &job, &typeFilter,
+                                                     board, av, files]() {
+        BoardPickPlaceGenerator gen(*board, av->getUuid());
+        std::shared_ptr<PickPlaceData> data = gen.generate();
+        foreach (const auto& pair, files) {
+          PickPlaceCsvWriter writer(*data);
+          writer.setIncludeMetadataComment(job.getIncludeComment());
+          writer.setBoardSide(pair.first);
+          writer.setTypeFilter(typeFilter);
+          CsvWriter csv;
+          writer.writeCsv(csv);
+          mWriter->writeFile(pair.second, csv.getData());  // can throw
+        }
+      }));
     }
   }
+  for (QFuture<void>& future : futures) {
+    future.waitForFinished();  // can throw
+  }
 }
 
 void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
@@ -425,7 +649,11 @@ void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
                                 job.getOutputPathBottom()));
   }
 
+  // All sides and assembly variants of a board are exported at once, thus
+  // the device data is determined only once and the files are generated
+  // concurrently.
   foreach (const Board* board, boards) {
+    QVector<BoardGerberExport::ComponentLayer> layers;
     foreach (const std::shared_ptr<AssemblyVariant>& av, assemblyVariants) {
       foreach (const auto& pair, sides) {
         const FilePath fp = mWriter->beginWritingFile(
@@ -436,11 +664,17 @@ void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
                   return FilePath::cleanFileName(
                       str, FilePath::ReplaceSpaces | FilePath::KeepCase);
                 }));  // can throw
-
-        BoardGerberExport gen(*board);
-        gen.exportComponentLayer(pair.first, av->getUuid(), fp);  // can throw
+        layers.append(
+            BoardGerberExport::ComponentLayer{pair.first, av->getUuid(), fp});
       }
     }
+
+    BoardGerberExport gen(*board);
+    gen.setWriteCallback(
+        [this](const FilePath& filePath, const QByteArray& content) {
+          mWriter->writeFile(filePath, content);  // can throw
+        });
+    gen.exportComponentLayers(layers);  // can throw
   }
 }
 
@@ -458,7 +692,7 @@ void OutputJobRunner::runImpl(const NetlistOutputJob& job) {
 
     if (fp.getSuffix().toLower() == "d356") {
       BoardD356NetlistExport exp(*board);
-      FileUtils::writeFile(fp, exp.generate());  // can throw
+      mWriter->writeFile(fp, exp.generate());  // can throw
     } else {
       throw RuntimeError(
           __FILE__, __LINE__,
@@ -472,6 +706,12 @@ void OutputJobRunner::runImpl(const BomOutputJob& job) {
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
 
+  // The output files are determined sequentially, but the BOM of each board
+  // and assembly variant is generated in parallel since the generators only
+  // read the project.
+  QThreadPool threadPool;  // Waits for all workers on destruction.
+  Concurrency::apply(threadPool);
+  QVector<QFuture<void>> futures;
   foreach (const Board* board, boards) {
     foreach (const std::shared_ptr<AssemblyVariant>& av, assemblyVariants) {
       const ProjectAttributeLookup lookup = board
@@ -484,21 +724,27 @@ void OutputJobRunner::runImpl(const BomOutputJob& job) {
                 return FilePath::cleanFileName(
                     str, FilePath::ReplaceSpaces | FilePath::KeepCase);
               }));  // can throw
-
-      BomGenerator gen(mProject);
-      gen.setAdditionalAttributes(job.getCustomAttributes());
-      std::shared_ptr<Bom> bom = gen.generate(board, av->getUuid());
-      if (fp.getSuffix().toLower() == "csv") {
-        BomCsvWriter writer(*bom);
-        std::shared_ptr<CsvFile> csv = writer.generateCsv();
-        csv->saveToFile(fp);
-      } else {
+      if (fp.getSuffix().toLower() != "csv") {
         throw RuntimeError(
             __FILE__, __LINE__,
             QString("Unsupported BOM format: '%1'").arg(fp.getSuffix()));
       }
+
+      futures.append(
+          QtConcurrent::run(&threadPool, [this, &job, board, av, fp]() {
+            BomGenerator gen(mProject);
+            gen.setAdditionalAttributes(job.getCustomAttributes());
+            std::shared_ptr<Bom> bom = gen.generate(board, av->getUuid());
+            BomCsvWriter writer(*bom);
+            CsvWriter csv;
+            writer.writeCsv(csv);
+            mWriter->writeFile(fp, csv.getData());  // can throw
+          }));
     }
   }
+  for (QFuture<void>& future : futures) {
+    future.waitForFinished();  // can throw
+  }
 }
 
 void OutputJobRunner::runImpl(const Board3DOutputJob& job) {
@@ -550,7 +796,7 @@ void OutputJobRunner::runImpl(const ProjectJsonOutputJob& job) {
 
   // Export JSON.
   ProjectJsonExport jsonExport;
-  FileUtils::writeFile(fp, jsonExport.toUtf8(mProject));  // can throw
+  mWriter->writeFile(fp, jsonExport.toUtf8(mProject));  // can throw
 }
 
 void OutputJobRunner::runImpl(const LppzOutputJob& job) {
@@ -631,7 +877,7 @@ void OutputJobRunner::runImpl(const CopyOutputJob& job) {
       if (job.getSubstituteVariables()) {
         content = AttributeSubstitutor::substitute(content, lookup).toUtf8();
       }
-      FileUtils::writeFile(outputFp, content);  // can throw
+      mWriter->writeFile(outputFp, content);  // can throw
     }
   }
 }
@@ -647,9 +893,9 @@ void OutputJobRunner::runImpl(const ArchiveOutputJob& job) {
                 str, FilePath::ReplaceSpaces | FilePath::KeepCase);
           }));  // can throw
 
-  // Collect input files.
-  std::shared_ptr<TransactionalFileSystem> fs =
-      TransactionalFileSystem::openRW(FilePath::getRandomTempPath());
+  // Collect input files. If multiple files have the same destination path,
+  // the last one wins.
+  QMap<QString, FilePath> inputFiles;
   for (auto it = job.getInputJobs().begin(); it != job.getInputJobs().end();
        ++it) {
     if (!mWriter->getWrittenFiles().contains(it.key())) {
@@ -661,19 +907,27 @@ void OutputJobRunner::runImpl(const ArchiveOutputJob& job) {
     }
     foreach (const FilePath& inputFp,
              mWriter->getWrittenFiles().values(it.key())) {
-      fs->write(it.value() % "/" % inputFp.getFilename(),
-                FileUtils::readFile(inputFp));  // can throw
+      inputFiles.insert(TransactionalFileSystem::cleanPath(
+                            it.value() % "/" % inputFp.getFilename()),
+                        inputFp);
     }
   }
   if (job.getInputJobs().isEmpty()) {
-    emit warning(
+    const QString msg =
         tr("No input jobs selected, thus the resulting archive will "
-           "be empty."));
+           "be empty.");
+    notify([this, msg]() { emit warning(msg); });
   }
 
   // Export depending on file extension.
+  // Note: Files are read and compressed one after another to avoid loading
+  // all of them into memory at the same time.
   if (fp.getSuffix().toLower() == "zip") {
-    fs->exportToZip(fp);  // can throw
+    ZipWriter zip(fp);  // can throw
+    for (auto it = inputFiles.begin(); it != inputFiles.end(); ++it) {
+      zip.addFile(it.key(), FileUtils::readFile(it.value()));  // can throw
+    }
+    zip.finish();  // can throw
   } else {
     throw RuntimeError(
         __FILE__, __LINE__,
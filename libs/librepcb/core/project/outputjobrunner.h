@@ -29,6 +29,7 @@
 
 #include <QtCore>
 
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -42,6 +43,7 @@ class Board3DOutputJob;
 class Board;
 class BomOutputJob;
 class CopyOutputJob;
+class FileSystem;
 class GerberExcellonOutputJob;
 class GerberX3OutputJob;
 class GraphicsOutputJob;
@@ -59,6 +61,10 @@ class ProjectJsonOutputJob;
 
 /**
  * @brief The OutputJobRunner class
+ *
+ * By default, jobs are executed concurrently (see #setParallelExecution()).
+ * All signals are emitted from the thread calling #run() in the same order
+ * as with serial execution.
  */
 class OutputJobRunner final : public QObject {
   Q_OBJECT
@@ -73,10 +79,57 @@ public:
   // Getters
   const FilePath& getOutputDirectory() const noexcept;
   const QMultiHash<Uuid, FilePath>& getWrittenFiles() const noexcept;
+  const QSet<FilePath>& getUnchangedFiles() const noexcept;
 
   // Setters
   void setOutputDirectory(const FilePath& fp) noexcept;
 
+  /**
+   * @brief Enable or disable executing output jobs concurrently
+   *
+   * Enabled by default. Jobs which only read the project run concurrently,
+   * while jobs which depend on output files of other jobs (archive, copy) or
+   * which modify the project (LPPZ) wait for all previous jobs and are
+   * executed in the calling thread.
+   *
+   * @param parallel  Whether jobs shall be executed concurrently.
+   */
+  void setParallelExecution(bool parallel) noexcept {
+    mParallelExecution = parallel;
+  }
+
+  /**
+   * @brief Enable or disable reusing output files of unchanged jobs
+   *
+   * Disabled by default. If enabled, a hash of the job configuration and of
+   * the project files a job depends on is stored in the output directory.
+   * When running the job again with unchanged inputs, its existing output
+   * files are reused instead of being generated again. Jobs which depend on
+   * other jobs or which modify the project are always executed.
+   *
+   * @attention This saves the project to its (transactional) file system
+   *            before running the jobs to determine its current content.
+   *
+   * @param enabled   Whether unchanged jobs shall be skipped.
+   */
+  void setCacheEnabled(bool enabled) noexcept { mCacheEnabled = enabled; }
+
+  /**
+   * @brief Enable or disable skipping writes of unchanged output files
+   *
+   * Disabled by default. If enabled, generated files whose content is the
+   * same as the existing file (ignoring volatile metadata like creation
+   * dates) are not written again, thus keeping their modification time.
+   * The skipped files are reported by #getUnchangedFiles().
+   *
+   * @see ::librepcb::OutputDirectoryWriter::setSkipUnchangedFiles()
+   *
+   * @param skip    Whether unchanged files shall not be written again.
+   */
+  void setSkipUnchangedFiles(bool skip) noexcept {
+    mSkipUnchangedFiles = skip;
+  }
+
   // General Methods
   void run(const QVector<std::shared_ptr<OutputJob>>& jobs);
   QList<FilePath> findUnknownFiles(const QSet<Uuid>& knownJobs) const;
@@ -94,8 +147,18 @@ signals:
   void previewReady(int index, const QSize& pageSize, const QRectF margins,
                     std::shared_ptr<QPicture> picture);
 
+private:  // Types
+  typedef QVector<std::function<void()>> EventLog;
+
 private:  // Methods
+  void runConcurrently(const QVector<std::shared_ptr<OutputJob>>& jobs);
+  void notify(const std::function<void()>& event);
   void run(const OutputJob& job);
+  bool reuseCachedFiles(const OutputJob& job, const QByteArray& inputHash);
+  QByteArray calcInputHash(const OutputJob& job) const;
+  static void addDirToHash(QCryptographicHash& hash, const FileSystem& fs,
+                           const QString& dir);
+  static bool isExclusive(const OutputJob& job) noexcept;
   void runImpl(const GraphicsOutputJob& job);
   void runImpl(const GerberExcellonOutputJob& job);
   void runImpl(const PickPlaceOutputJob& job);
@@ -119,6 +182,13 @@ private:  // Methods
 private:  // Data
   Project& mProject;
   QScopedPointer<OutputDirectoryWriter> mWriter;
+  bool mParallelExecution;
+  bool mCacheEnabled;
+  bool mSkipUnchangedFiles;
+
+  /// Signals of jobs running in worker threads, recorded by #notify()
+  QHash<QThread*, EventLog*> mEventLogs;
+  QMutex mEventLogsMutex;
 };
 
 /*******************************************************************************
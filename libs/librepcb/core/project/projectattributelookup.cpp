@@ -47,11 +47,12 @@ namespace librepcb {
 
 ProjectAttributeLookup::ProjectAttributeLookup(
     const ProjectAttributeLookup& other) noexcept
-  : mFunction(other.mFunction) {
+  : mFunction(other.mFunction), mCache(other.mCache) {
 }
 
 ProjectAttributeLookup::ProjectAttributeLookup(
-    const Project& obj, std::shared_ptr<AssemblyVariant> av) noexcept {
+    const Project& obj, std::shared_ptr<AssemblyVariant> av) noexcept
+  : mCache(new Cache()) {
   QPointer<const Project> ptr(&obj);
   mFunction = [ptr, av](const QString& key) {
     QString value;
@@ -65,7 +66,8 @@ ProjectAttributeLookup::ProjectAttributeLookup(
 
 ProjectAttributeLookup::ProjectAttributeLookup(
     const ComponentInstance& obj, QPointer<const BI_Device> device,
-    std::shared_ptr<const Part> part) noexcept {
+    std::shared_ptr<const Part> part) noexcept
+  : mCache(new Cache()) {
   QPointer<const ComponentInstance> ptr(&obj);
   mFunction = [ptr, device, part](const QString& key) {
     QString value;
@@ -80,7 +82,8 @@ ProjectAttributeLookup::ProjectAttributeLookup(
 }
 
 ProjectAttributeLookup::ProjectAttributeLookup(
-    const Schematic& obj, std::shared_ptr<AssemblyVariant> av) noexcept {
+    const Schematic& obj, std::shared_ptr<AssemblyVariant> av) noexcept
+  : mCache(new Cache()) {
   QPointer<const Schematic> ptr(&obj);
   mFunction = [ptr, av](const QString& key) {
     QString value;
@@ -95,7 +98,8 @@ ProjectAttributeLookup::ProjectAttributeLookup(
 }
 
 ProjectAttributeLookup::ProjectAttributeLookup(
-    const Board& obj, std::shared_ptr<AssemblyVariant> av) noexcept {
+    const Board& obj, std::shared_ptr<AssemblyVariant> av) noexcept
+  : mCache(new Cache()) {
   QPointer<const Board> ptr(&obj);
   mFunction = [ptr, av](const QString& key) {
     QString value;
@@ -112,7 +116,8 @@ ProjectAttributeLookup::ProjectAttributeLookup(
 ProjectAttributeLookup::ProjectAttributeLookup(
     const SI_Symbol& obj, QPointer<const BI_Device> device,
     std::shared_ptr<const Part> part,
-    std::shared_ptr<AssemblyVariant> av) noexcept {
+    std::shared_ptr<AssemblyVariant> av) noexcept
+  : mCache(new Cache()) {
   QPointer<const SI_Symbol> ptr(&obj);
   mFunction = [ptr, device, part, av](const QString& key) {
     QString value;
@@ -130,7 +135,8 @@ ProjectAttributeLookup::ProjectAttributeLookup(
 }
 
 ProjectAttributeLookup::ProjectAttributeLookup(
-    const BI_Device& obj, std::shared_ptr<const Part> part) noexcept {
+    const BI_Device& obj, std::shared_ptr<const Part> part) noexcept
+  : mCache(new Cache()) {
   QPointer<const BI_Device> ptr(&obj);
   mFunction = [ptr, part](const QString& key) {
     QString value;
@@ -154,12 +160,23 @@ ProjectAttributeLookup::~ProjectAttributeLookup() noexcept {
 
 QString ProjectAttributeLookup::operator()(const QString& key) const noexcept {
   Q_ASSERT(mFunction);
-  return mFunction(key);
+  {
+    QMutexLocker lock(&mCache->mutex);
+    auto it = mCache->values.constFind(key);
+    if (it != mCache->values.constEnd()) {
+      return it.value();
+    }
+  }
+  const QString value = mFunction(key);
+  QMutexLocker lock(&mCache->mutex);
+  mCache->values.insert(key, value);
+  return value;
 }
 
 ProjectAttributeLookup& ProjectAttributeLookup::operator=(
     const ProjectAttributeLookup& rhs) noexcept {
   mFunction = rhs.mFunction;
+  mCache = rhs.mCache;
   return *this;
 }
 
@@ -61,6 +61,11 @@ class Schematic;
  *   1. Call the constructor with passing the object to query attributes from.
  *   2. Call #operator()() to get the value of a specific attribute key.
  *
+ * @note Looked up values are memoized for the lifetime of the object (and
+ *       its copies), thus it must not be kept longer than the queried
+ *       objects stay unmodified. Create a new lookup object after
+ *       modifications instead.
+ *
  * @see ::librepcb::AttributeSubstitutor
  * @see @ref doc_attributes_system
  */
@@ -119,8 +124,17 @@ private:  // Methods
   static bool query(const Part& part, const QString& key,
                     QString& value) noexcept;
 
+private:  // Types
+  /// Values already looked up, since the same keys are often queried many
+  /// times (e.g. for each text of a device, or nested attributes)
+  struct Cache {
+    QMutex mutex;
+    QHash<QString, QString> values;
+  };
+
 private:  // Data
   LookupFunction mFunction;
+  std::shared_ptr<Cache> mCache;  ///< Shared between copies
 };
 
 /*******************************************************************************
@@ -41,7 +41,8 @@ namespace librepcb {
 
 ProjectLibrary::ProjectLibrary(
     std::unique_ptr<TransactionalDirectory> directory)
-  : mDirectory(std::move(directory)) {
+  : mDirectory(std::move(directory)),
+    mAllElementsMemory("Project library elements") {
 }
 
 ProjectLibrary::~ProjectLibrary() noexcept {
@@ -125,6 +126,7 @@ void ProjectLibrary::addElement(ElementType& element,
 
   elementList.insert(element.getUuid(), &element);
   mAllElements.insert(&element);
+  mAllElementsMemory.set(mAllElements.count(), 0);
 }
 
 template <typename ElementType>
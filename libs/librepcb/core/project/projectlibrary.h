@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../fileio/transactionaldirectory.h"
+#include "../memoryaccounting.h"
 #include "../types/uuid.h"
 
 #include <QtCore>
@@ -119,6 +120,7 @@ private:
   QHash<Uuid, Device*> mDevices;
 
   QSet<LibraryBaseElement*> mAllElements;
+  MemoryAccounting::Counter mAllElementsMemory;
 };
 
 /*******************************************************************************
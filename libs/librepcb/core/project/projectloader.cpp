@@ -23,6 +23,7 @@
 #include "projectloader.h"
 
 #include "../application.h"
+#include "../exceptions.h"
 #include "../fileio/versionfile.h"
 #include "../library/cmp/component.h"
 #include "../library/dev/device.h"
@@ -30,7 +31,9 @@
 #include "../library/pkg/package.h"
 #include "../library/sym/symbol.h"
 #include "../serialization/fileformatmigration.h"
+#include "../tracer.h"
 #include "../types/pcbcolor.h"
+#include "../utils/scopeguard.h"
 #include "board/board.h"
 #include "board/boarddesignrules.h"
 #include "board/boardfabricationoutputsettings.h"
@@ -65,6 +68,7 @@
 #include "schematic/items/si_text.h"
 #include "schematic/schematic.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -77,7 +81,7 @@ namespace librepcb {
  ******************************************************************************/
 
 ProjectLoader::ProjectLoader(QObject* parent) noexcept
-  : QObject(parent), mAutoAssignDeviceModels(false) {
+  : QObject(parent), mAutoAssignDeviceModels(false), mAbort(false) {
 }
 
 ProjectLoader::~ProjectLoader() noexcept {
@@ -92,11 +96,13 @@ std::unique_ptr<Project> ProjectLoader::open(
     const QString& filename) {
   Q_ASSERT(directory);
   mUpgradeMessages = tl::nullopt;
+  mAbort = false;
 
   QElapsedTimer timer;
   timer.start();
   const FilePath fp = directory->getAbsPath(filename);
   qDebug().nospace() << "Open project " << fp.toNative() << "...";
+  Tracer::Span span("project", "ProjectLoader::open", fp.toNative());
 
   // Check if the project file exists.
   if (!directory->fileExists(filename)) {
@@ -127,6 +133,9 @@ std::unique_ptr<Project> ProjectLoader::open(
 
   // Upgrate file format, if needed.
   for (auto migration : FileFormatMigration::getMigrations(fileFormat)) {
+    reportProgress(tr("Upgrade file format to v%1...")
+                       .arg(migration->getToVersion().toStr()),
+                   0);  // can throw
     if (!mUpgradeMessages) {
       mUpgradeMessages = QList<FileFormatMigration::Message>();
     }
@@ -137,16 +146,33 @@ std::unique_ptr<Project> ProjectLoader::open(
     migration->upgradeProject(*directory, *mUpgradeMessages);
   }
 
-  // Load project.
+  // Load project. To speed up loading, all files are read and parsed in
+  // worker threads while the project is being built in this thread.
   std::unique_ptr<Project> p(new Project(std::move(directory), filename));
+  auto parsedFilesGuard = scopeGuard([this]() {
+    // The workers access the project directory, thus wait for them before
+    // the project gets destroyed (e.g. due to an exception).
+    for (QFuture<SExpression>& future : mParsedFiles) {
+      try {
+        future.waitForFinished();
+      } catch (...) {
+      }
+    }
+    mParsedFiles.clear();
+  });
+  startParsingFiles(*p);
+  reportProgress(tr("Load metadata..."), 5);  // can throw
   loadMetadata(*p);
   loadSettings(*p);
   loadOutputJobs(*p);
+  reportProgress(tr("Load library..."), 10);  // can throw
   loadLibrary(*p);
+  reportProgress(tr("Load circuit..."), 40);  // can throw
   loadCircuit(*p);
   loadErc(*p);
   loadSchematics(*p);
   loadBoards(*p);
+  reportProgress(tr("Finish..."), 95);  // can throw
 
   // If the file format was migrated, clean up obsolete ERC messages.
   if (mUpgradeMessages) {
@@ -172,11 +198,75 @@ std::unique_ptr<Project> ProjectLoader::open(
  *  Private Methods
  ******************************************************************************/
 
+void ProjectLoader::reportProgress(const QString& status, int percent) {
+  emit progressStatus(status);
+  emit progressPercent(percent);
+  if (mAbort) {
+    throw UserCanceled(__FILE__, __LINE__);
+  }
+}
+
+void ProjectLoader::startParsingFiles(Project& p) noexcept {
+  TransactionalDirectory* dir = &p.getDirectory();
+  auto startParsing = [this, dir](const QString& path) {
+    const QString key = dir->getAbsPath(path).toStr();
+    if (!mParsedFiles.contains(key)) {
+      mParsedFiles.insert(key, QtConcurrent::run([dir, path]() {
+        return SExpression::parse(dir->read(path),
+                                  dir->getAbsPath(path));  // can throw
+      }));
+    }
+    return mParsedFiles.value(key);
+  };
+
+  startParsing("project/metadata.lp");
+  startParsing("project/settings.lp");
+  startParsing("project/jobs.lp");
+  startParsing("circuit/circuit.lp");
+  startParsing("circuit/erc.lp");
+
+  // Note: Errors are ignored here, they will be raised again when loading
+  // the corresponding file.
+  try {
+    const SExpression root =
+        startParsing("schematics/schematics.lp").result();  // can throw
+    foreach (const SExpression* node, root.getChildren("schematic")) {
+      startParsing(node->getChild("@0").getValue());  // can throw
+    }
+  } catch (...) {
+  }
+  try {
+    const SExpression root =
+        startParsing("boards/boards.lp").result();  // can throw
+    foreach (const SExpression* node, root.getChildren("board")) {
+      const QString fp = node->getChild("@0").getValue();  // can throw
+      startParsing(fp);
+      startParsing(FilePath::fromRelative(p.getPath(), fp)
+                       .getParentDir()
+                       .getPathTo("settings.user.lp")
+                       .toRelative(p.getPath()));
+    }
+  } catch (...) {
+  }
+}
+
+SExpression ProjectLoader::parseFile(const TransactionalDirectory& dir,
+                                     const QString& path) {
+  const FilePath fp = dir.getAbsPath(path);
+  auto it = mParsedFiles.find(fp.toStr());
+  if (it != mParsedFiles.end()) {
+    const QFuture<SExpression> future = *it;
+    mParsedFiles.erase(it);  // Release memory as soon as possible.
+    return future.result();  // can throw
+  } else {
+    return SExpression::parse(dir.read(path), fp);  // can throw
+  }
+}
+
 void ProjectLoader::loadMetadata(Project& p) {
   qDebug() << "Load project metadata...";
   const QString fp = "project/metadata.lp";
-  SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                        p.getDirectory().getAbsPath(fp));
+  SExpression root = parseFile(p.getDirectory(), fp);  // can throw
 
   p.setUuid(deserialize<Uuid>(root.getChild("@0")));
   p.setName(deserialize<ElementName>(root.getChild("name/@0")));
@@ -191,8 +281,7 @@ void ProjectLoader::loadMetadata(Project& p) {
 void ProjectLoader::loadSettings(Project& p) {
   qDebug() << "Load project settings...";
   const QString fp = "project/settings.lp";
-  const SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                              p.getDirectory().getAbsPath(fp));
+  const SExpression root = parseFile(p.getDirectory(), fp);  // can throw
 
   {
     QStringList l;
@@ -230,8 +319,7 @@ void ProjectLoader::loadSettings(Project& p) {
 void ProjectLoader::loadOutputJobs(Project& p) {
   qDebug() << "Load output jobs...";
   const QString fp = "project/jobs.lp";
-  const SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                              p.getDirectory().getAbsPath(fp));
+  const SExpression root = parseFile(p.getDirectory(), fp);  // can throw
   p.getOutputJobs() = deserialize<OutputJobList>(root);
   qDebug() << "Successfully loaded output jobs.";
 }
@@ -239,22 +327,30 @@ void ProjectLoader::loadOutputJobs(Project& p) {
 void ProjectLoader::loadLibrary(Project& p) {
   qDebug() << "Load project library...";
 
-  loadLibraryElements<Symbol>(p, "sym", "symbols", &ProjectLibrary::addSymbol);
-  loadLibraryElements<Package>(p, "pkg", "packages",
-                               &ProjectLibrary::addPackage);
-  loadLibraryElements<Component>(p, "cmp", "components",
-                                 &ProjectLibrary::addComponent);
-  loadLibraryElements<Device>(p, "dev", "devices", &ProjectLibrary::addDevice);
+  // Start loading the elements of all types at once to keep the workers busy
+  // instead of waiting for the last element of each type.
+  LibraryElementJobs<Symbol> symbols;
+  LibraryElementJobs<Package> packages;
+  LibraryElementJobs<Component> components;
+  LibraryElementJobs<Device> devices;
+  startLoadingLibraryElements(p, "sym", symbols);
+  startLoadingLibraryElements(p, "pkg", packages);
+  startLoadingLibraryElements(p, "cmp", components);
+  startLoadingLibraryElements(p, "dev", devices);
+  addLibraryElements(p, symbols, "symbols", &ProjectLibrary::addSymbol);
+  addLibraryElements(p, packages, "packages", &ProjectLibrary::addPackage);
+  addLibraryElements(p, components, "components",
+                     &ProjectLibrary::addComponent);
+  addLibraryElements(p, devices, "devices", &ProjectLibrary::addDevice);
 
   qDebug() << "Successfully loaded project library.";
 }
 
 template <typename ElementType>
-void ProjectLoader::loadLibraryElements(
-    Project& p, const QString& dirname, const QString& type,
-    void (ProjectLibrary::*addFunction)(ElementType&)) {
+void ProjectLoader::startLoadingLibraryElements(
+    Project& p, const QString& dirname, LibraryElementJobs<ElementType>& jobs) {
   // Search all subdirectories which have a valid UUID as directory name.
-  int count = 0;
+  QThread* targetThread = thread();
   foreach (const QString& sub, p.getLibrary().getDirectory().getDirs(dirname)) {
     std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
         p.getLibrary().getDirectory(), dirname % "/" % sub));
@@ -266,22 +362,38 @@ void ProjectLoader::loadLibraryElements(
       continue;
     }
 
-    // Load the library element.
-    ElementType* element =
-        ElementType::open(std::move(dir)).release();  // can throw
+    // Load the library element in a worker thread since reading and parsing
+    // the files is independent of all other elements.
+    TransactionalDirectory* rawDir = dir.release();
+    jobs.futures.append(QtConcurrent::run([rawDir, targetThread]() {
+      std::unique_ptr<ElementType> element = ElementType::open(
+          std::unique_ptr<TransactionalDirectory>(rawDir));  // can throw
+      element->moveToThread(targetThread);
+      return element.release();
+    }));
+  }
+}
+
+template <typename ElementType>
+void ProjectLoader::addLibraryElements(
+    Project& p, LibraryElementJobs<ElementType>& jobs, const QString& type,
+    void (ProjectLibrary::*addFunction)(ElementType&)) {
+  // Add the elements in the same order as before, independent of the order
+  // in which they have been loaded.
+  while (jobs.added < jobs.futures.count()) {
+    ElementType* element = jobs.futures[jobs.added].result();  // can throw
+    ++jobs.added;
     (p.getLibrary().*addFunction)(*element);
-    ++count;
   }
 
   qDebug().nospace().noquote()
-      << "Successfully loaded " << count << " " << type << ".";
+      << "Successfully loaded " << jobs.added << " " << type << ".";
 }
 
 void ProjectLoader::loadCircuit(Project& p) {
   qDebug() << "Load circuit...";
   const QString fp = "circuit/circuit.lp";
-  SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                        p.getDirectory().getAbsPath(fp));
+  SExpression root = parseFile(p.getDirectory(), fp);  // can throw
 
   // Load assembly variants.
   foreach (const SExpression* node, root.getChildren("variant")) {
@@ -381,8 +493,7 @@ void ProjectLoader::loadCircuit(Project& p) {
 void ProjectLoader::loadErc(Project& p) {
   qDebug() << "Load ERC approvals...";
   const QString fp = "circuit/erc.lp";
-  const SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                              p.getDirectory().getAbsPath(fp));
+  const SExpression root = parseFile(p.getDirectory(), fp);  // can throw
 
   // Load approvals.
   QSet<SExpression> approvals;
@@ -397,10 +508,13 @@ void ProjectLoader::loadErc(Project& p) {
 void ProjectLoader::loadSchematics(Project& p) {
   qDebug() << "Load schematics...";
   const QString fp = "schematics/schematics.lp";
-  const SExpression indexRoot = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
-  foreach (const SExpression* indexNode, indexRoot.getChildren("schematic")) {
-    loadSchematic(p, indexNode->getChild("@0").getValue());
+  const SExpression indexRoot = parseFile(p.getDirectory(), fp);  // can throw
+  const QList<const SExpression*> nodes = indexRoot.getChildren("schematic");
+  for (int i = 0; i < nodes.count(); ++i) {
+    reportProgress(
+        tr("Load schematic %1 of %2...").arg(i + 1).arg(nodes.count()),
+        50 + (20 * i) / nodes.count());  // can throw
+    loadSchematic(p, nodes.at(i)->getChild("@0").getValue());
   }
   qDebug() << "Successfully loaded" << p.getSchematics().count()
            << "schematics.";
@@ -410,7 +524,7 @@ void ProjectLoader::loadSchematic(Project& p, const QString& relativeFilePath) {
   const FilePath fp = FilePath::fromRelative(p.getPath(), relativeFilePath);
   std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
       p.getDirectory(), fp.getParentDir().toRelative(p.getPath())));
-  const SExpression root = SExpression::parse(dir->read(fp.getFilename()), fp);
+  const SExpression root = parseFile(*dir, fp.getFilename());  // can throw
 
   Schematic* schematic =
       new Schematic(p, std::move(dir), fp.getParentDir().getFilename(),
@@ -543,10 +657,12 @@ void ProjectLoader::loadSchematicNetSegment(Schematic& s,
 void ProjectLoader::loadBoards(Project& p) {
   qDebug() << "Load boards...";
   const QString fp = "boards/boards.lp";
-  const SExpression indexRoot = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
-  foreach (const SExpression* node, indexRoot.getChildren("board")) {
-    loadBoard(p, node->getChild("@0").getValue());
+  const SExpression indexRoot = parseFile(p.getDirectory(), fp);  // can throw
+  const QList<const SExpression*> nodes = indexRoot.getChildren("board");
+  for (int i = 0; i < nodes.count(); ++i) {
+    reportProgress(tr("Load board %1 of %2...").arg(i + 1).arg(nodes.count()),
+                   70 + (25 * i) / nodes.count());  // can throw
+    loadBoard(p, nodes.at(i)->getChild("@0").getValue());
   }
   qDebug() << "Successfully loaded" << p.getBoards().count() << "boards.";
 }
@@ -555,7 +671,7 @@ void ProjectLoader::loadBoard(Project& p, const QString& relativeFilePath) {
   const FilePath fp = FilePath::fromRelative(p.getPath(), relativeFilePath);
   std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
       p.getDirectory(), fp.getParentDir().toRelative(p.getPath())));
-  const SExpression root = SExpression::parse(dir->read(fp.getFilename()), fp);
+  const SExpression root = parseFile(*dir, fp.getFilename());  // can throw
 
   Board* board = new Board(p, std::move(dir), fp.getParentDir().getFilename(),
                            deserialize<Uuid>(root.getChild("@0")),
@@ -802,8 +918,7 @@ void ProjectLoader::loadBoardPlane(Board& b, const SExpression& node) {
 void ProjectLoader::loadBoardUserSettings(Board& b) {
   try {
     const QString fp = "settings.user.lp";
-    const SExpression root = SExpression::parse(
-        b.getDirectory().read(fp), b.getDirectory().getAbsPath(fp));
+    const SExpression root = parseFile(b.getDirectory(), fp);  // can throw
 
     // Layers.
     QMap<QString, bool> layersVisibility;
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../serialization/fileformatmigration.h"
+#include "../serialization/sexpression.h"
 
 #include <optional/tl/optional.hpp>
 
@@ -39,7 +40,6 @@ namespace librepcb {
 class Board;
 class Project;
 class ProjectLibrary;
-class SExpression;
 class Schematic;
 class TransactionalDirectory;
 
@@ -65,6 +65,22 @@ public:
   }
 
   // General Methods
+
+  /**
+   * @brief Open a project
+   *
+   * The progress is reported with the signals #progressStatus() and
+   * #progressPercent(), which allows to process events in between (e.g. by a
+   * modal progress dialog), and thus calling #cancel().
+   *
+   * @param directory   The project directory.
+   * @param filename    Name of the *.lpp file within the directory.
+   *
+   * @return The opened project.
+   *
+   * @throw UserCanceled  If #cancel() was called while opening the project.
+   * @throw Exception     On errors.
+   */
   std::unique_ptr<Project> open(
       std::unique_ptr<TransactionalDirectory> directory,
       const QString& filename);
@@ -73,18 +89,54 @@ public:
     return mUpgradeMessages;
   }
 
+  /**
+   * @brief Cancel opening the project
+   *
+   * Opening is aborted at the next progress report.
+   */
+  void cancel() noexcept { mAbort = true; }
+
   // Operator Overloadings
   ProjectLoader& operator=(const ProjectLoader& rhs) = delete;
 
+signals:
+  void progressStatus(QString status);
+  void progressPercent(int percent);
+
+private:  // Types
+  /// Library elements being loaded in worker threads
+  template <typename ElementType>
+  struct LibraryElementJobs {
+    QVector<QFuture<ElementType*>> futures;
+    int added = 0;  ///< Count of elements already added to the library
+
+    ~LibraryElementJobs() noexcept {
+      // Clean up elements not added to the library (in case of an error).
+      for (int i = added; i < futures.count(); ++i) {
+        try {
+          delete futures[i].result();
+        } catch (...) {
+        }
+      }
+    }
+  };
+
 private:  // Methods
+  void reportProgress(const QString& status, int percent);
+  void startParsingFiles(Project& p) noexcept;
+  SExpression parseFile(const TransactionalDirectory& dir,
+                        const QString& path);
   void loadMetadata(Project& p);
   void loadSettings(Project& p);
   void loadOutputJobs(Project& p);
   void loadLibrary(Project& p);
   template <typename ElementType>
-  void loadLibraryElements(Project& p, const QString& dirname,
-                           const QString& type,
-                           void (ProjectLibrary::*addFunction)(ElementType&));
+  void startLoadingLibraryElements(Project& p, const QString& dirname,
+                                   LibraryElementJobs<ElementType>& jobs);
+  template <typename ElementType>
+  void addLibraryElements(Project& p, LibraryElementJobs<ElementType>& jobs,
+                          const QString& type,
+                          void (ProjectLibrary::*addFunction)(ElementType&));
   void loadCircuit(Project& p);
   void loadErc(Project& p);
   void loadSchematics(Project& p);
@@ -100,7 +152,11 @@ private:  // Methods
 
 private:  // Data
   bool mAutoAssignDeviceModels;
+  bool mAbort;
   tl::optional<QList<FileFormatMigration::Message>> mUpgradeMessages;
+
+  /// Files being parsed in worker threads (key: absolute file path)
+  QHash<QString, QFuture<SExpression>> mParsedFiles;
 };
 
 /*******************************************************************************
@@ -164,7 +164,7 @@ void SI_NetSegment::addNetPointsAndNetLines(
 
   ScopeGuardList sgl(netpoints.count() + netlines.count());
   foreach (SI_NetPoint* netpoint, netpoints) {
-    if ((mNetPoints.values().contains(netpoint)) ||
+    if ((mNetPoints.value(netpoint->getUuid()) == netpoint) ||
         (&netpoint->getNetSegment() != this)) {
       throw LogicError(__FILE__, __LINE__);
     }
@@ -182,7 +182,7 @@ void SI_NetSegment::addNetPointsAndNetLines(
     });
   }
   foreach (SI_NetLine* netline, netlines) {
-    if ((mNetLines.values().contains(netline)) ||
+    if ((mNetLines.value(netline->getUuid()) == netline) ||
         (&netline->getNetSegment() != this)) {
       throw LogicError(__FILE__, __LINE__);
     }
@@ -263,7 +263,8 @@ void SI_NetSegment::removeNetPointsAndNetLines(
  ******************************************************************************/
 
 void SI_NetSegment::addNetLabel(SI_NetLabel& netlabel) {
-  if ((!isAddedToSchematic()) || (mNetLabels.values().contains(&netlabel)) ||
+  if ((!isAddedToSchematic()) ||
+      (mNetLabels.value(netlabel.getUuid()) == &netlabel) ||
       (&netlabel.getNetSegment() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -168,7 +168,7 @@ TextList SI_Symbol::getDefaultTexts() const noexcept {
 }
 
 void SI_Symbol::addText(SI_Text& text) {
-  if ((mTexts.values().contains(&text)) ||
+  if ((mTexts.value(text.getUuid()) == &text) ||
       (&text.getSchematic() != &mSchematic)) {
     throw LogicError(__FILE__, __LINE__);
   }
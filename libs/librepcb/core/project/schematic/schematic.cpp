@@ -108,7 +108,7 @@ void Schematic::setName(const ElementName& name) noexcept {
  ******************************************************************************/
 
 void Schematic::addSymbol(SI_Symbol& symbol) {
-  if ((!mIsAddedToProject) || (mSymbols.values().contains(&symbol)) ||
+  if ((!mIsAddedToProject) || (mSymbols.value(symbol.getUuid()) == &symbol) ||
       (&symbol.getSchematic() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -137,7 +137,8 @@ void Schematic::removeSymbol(SI_Symbol& symbol) {
  ******************************************************************************/
 
 void Schematic::addNetSegment(SI_NetSegment& netsegment) {
-  if ((!mIsAddedToProject) || (mNetSegments.values().contains(&netsegment)) ||
+  if ((!mIsAddedToProject) ||
+      (mNetSegments.value(netsegment.getUuid()) == &netsegment) ||
       (&netsegment.getSchematic() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -167,7 +168,8 @@ void Schematic::removeNetSegment(SI_NetSegment& netsegment) {
  ******************************************************************************/
 
 void Schematic::addPolygon(SI_Polygon& polygon) {
-  if ((!mIsAddedToProject) || (mPolygons.values().contains(&polygon)) ||
+  if ((!mIsAddedToProject) ||
+      (mPolygons.value(polygon.getUuid()) == &polygon) ||
       (&polygon.getSchematic() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -197,7 +199,7 @@ void Schematic::removePolygon(SI_Polygon& polygon) {
  ******************************************************************************/
 
 void Schematic::addText(SI_Text& text) {
-  if ((!mIsAddedToProject) || (mTexts.values().contains(&text)) ||
+  if ((!mIsAddedToProject) || (mTexts.value(text.getUuid()) == &text) ||
       (&text.getSchematic() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "schematicnetsegmentsplitter.h"
 
+#include "../../utils/disjointset.h"
 #include "../../utils/toolbox.h"
 
 #include <QtCore>
@@ -82,15 +83,49 @@ QList<SchematicNetSegmentSplitter::Segment>
     SchematicNetSegmentSplitter::split() noexcept {
   QList<Segment> segments;
 
-  // Split netsegment by anchors and lines
-  NetLineList availableNetLines = mNetLines;
-  while (!availableNetLines.isEmpty()) {
-    Segment segment;
-    findConnectedLinesAndPoints(availableNetLines.first()->getStartPoint(),
-                                availableNetLines, segment);
-    segments.append(segment);
+  // Group net lines which share an anchor. Each anchor is mapped to the first
+  // net line connected to it, so every net line needs to be visited only once.
+  DisjointSet sets(mNetLines.count());
+  QHash<NetLineAnchor, int> anchorNetLines;
+  anchorNetLines.reserve(mNetLines.count() * 2);
+  for (int i = 0; i < mNetLines.count(); ++i) {
+    const NetLine& netline = *mNetLines.value(i);
+    for (const NetLineAnchor& anchor :
+         {netline.getStartPoint(), netline.getEndPoint()}) {
+      auto it = anchorNetLines.constFind(anchor);
+      if (it == anchorNetLines.constEnd()) {
+        anchorNetLines.insert(anchor, i);
+      } else {
+        sets.unite(i, *it);
+      }
+    }
+  }
+
+  // Split netsegment by the groups of net lines, ordered by their first line
+  QHash<int, int> segmentIndices;
+  for (int i = 0; i < mNetLines.count(); ++i) {
+    std::shared_ptr<NetLine> netline = mNetLines.value(i);
+    const int root = sets.find(i);
+    auto it = segmentIndices.constFind(root);
+    if (it == segmentIndices.constEnd()) {
+      it = segmentIndices.insert(root, segments.count());
+      segments.append(Segment());
+    }
+    Segment& segment = segments[*it];
+    segment.netlines.append(netline);
+    for (const NetLineAnchor& anchor :
+         {netline->getStartPoint(), netline->getEndPoint()}) {
+      if (anchorNetLines.remove(anchor) == 0) {
+        continue;  // Anchor already added by another net line.
+      }
+      if (tl::optional<Uuid> junctionUuid = anchor.tryGetJunction()) {
+        if (std::shared_ptr<Junction> junction =
+                mJunctions.find(*junctionUuid)) {
+          segment.junctions.append(junction);
+        }
+      }
+    }
   }
-  Q_ASSERT(availableNetLines.isEmpty());
 
   // Add netlabels to their nearest netsegment
   for (NetLabel& netlabel : mNetLabels) {
@@ -109,32 +144,6 @@ NetLineAnchor SchematicNetSegmentSplitter::replacePinAnchor(
   return mPinAnchorsToReplace.value(anchor, anchor);
 }
 
-void SchematicNetSegmentSplitter::findConnectedLinesAndPoints(
-    const NetLineAnchor& anchor, NetLineList& availableNetLines,
-    Segment& segment) noexcept {
-  if (tl::optional<Uuid> junctionUuid = anchor.tryGetJunction()) {
-    if (std::shared_ptr<Junction> junction = mJunctions.find(*junctionUuid)) {
-      if (!segment.junctions.contains(junction->getUuid())) {
-        segment.junctions.append(junction);
-      }
-    }
-  }
-  for (int i = 0; i < mNetLines.count(); ++i) {
-    std::shared_ptr<NetLine> netline = mNetLines.value(i);
-    if (((netline->getStartPoint() == anchor) ||
-         (netline->getEndPoint() == anchor)) &&
-        availableNetLines.contains(netline->getUuid()) &&
-        (!segment.netlines.contains(netline->getUuid()))) {
-      segment.netlines.append(netline);
-      availableNetLines.remove(netline->getUuid());
-      findConnectedLinesAndPoints(netline->getStartPoint(), availableNetLines,
-                                  segment);
-      findConnectedLinesAndPoints(netline->getEndPoint(), availableNetLines,
-                                  segment);
-    }
-  }
-}
-
 void SchematicNetSegmentSplitter::addNetLabelToNearestNetSegment(
     const NetLabel& netlabel, QList<Segment>& segments) const noexcept {
   int nearestIndex = -1;
@@ -55,9 +55,27 @@ SchematicPainter::SchematicPainter(const Schematic& schematic,
   : mDefaultFont(Application::getDefaultSansSerifFont()),
     mNetLabelFont(Application::getDefaultMonospaceFont()) {
   mNetLabelFont.setPixelSize(4);
+  // Usually many symbols are instances of the same library symbol (e.g.
+  // resistors), so copy the graphics of each library symbol only once.
+  QHash<const librepcb::Symbol*, std::shared_ptr<const SymbolGraphics>>
+      graphics;
   foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
     Symbol sym;
     sym.transform = Transform(*symbol);
+    std::shared_ptr<const SymbolGraphics>& symGraphics =
+        graphics[&symbol->getLibSymbol()];
+    if (!symGraphics) {
+      std::shared_ptr<SymbolGraphics> newGraphics =
+          std::make_shared<SymbolGraphics>();
+      for (const Polygon& polygon : symbol->getLibSymbol().getPolygons()) {
+        newGraphics->polygons.append(polygon);
+      }
+      for (const Circle& circle : symbol->getLibSymbol().getCircles()) {
+        newGraphics->circles.append(circle);
+      }
+      symGraphics = newGraphics;
+    }
+    sym.graphics = symGraphics;
     foreach (const SI_SymbolPin* pin, symbol->getPins()) {
       sym.pins.append(Pin{
           pin->getLibPin().getPosition(),
@@ -76,12 +94,6 @@ SchematicPainter::SchematicPainter(const Schematic& schematic,
         mJunctions.append(pin->getPosition());
       }
     }
-    for (const Polygon& polygon : symbol->getLibSymbol().getPolygons()) {
-      sym.polygons.append(polygon);
-    }
-    for (const Circle& circle : symbol->getLibSymbol().getCircles()) {
-      sym.circles.append(circle);
-    }
     if (!thumbnail) {
       for (const SI_Text* text : symbol->getTexts()) {
         Text copy(text->getTextObj());
@@ -141,7 +153,7 @@ void SchematicPainter::paint(
     // item. Otherwise they might completely cover (hide) other items.
     for (bool grabArea : {true, false}) {
       // Draw Symbol Polygons.
-      foreach (const Polygon& polygon, symbol.polygons) {
+      foreach (const Polygon& polygon, symbol.graphics->polygons) {
         if (polygon.isGrabArea() != grabArea) continue;
         const QString color = polygon.getLayer().getThemeColor();
         p.drawPolygon(symbol.transform.map(polygon.getPath()),
@@ -151,7 +163,7 @@ void SchematicPainter::paint(
       }
 
       // Draw Symbol Circles.
-      foreach (const Circle& circle, symbol.circles) {
+      foreach (const Circle& circle, symbol.graphics->circles) {
         if (circle.isGrabArea() != grabArea) continue;
         const QString color = circle.getLayer().getThemeColor();
         p.drawCircle(symbol.transform.map(circle.getCenter()),
@@ -31,6 +31,8 @@
 #include <QtCore>
 #include <QtGui>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -79,11 +81,16 @@ class SchematicPainter final : public GraphicsPagePainter {
     QString text;
   };
 
+  /// Graphics of a library symbol, shared by all its instances
+  struct SymbolGraphics {
+    QList<Polygon> polygons;
+    QList<Circle> circles;
+  };
+
   struct Symbol {
     Transform transform;
     QList<Pin> pins;
-    QList<Polygon> polygons;
-    QList<Circle> circles;
+    std::shared_ptr<const SymbolGraphics> graphics;
   };
 
 public:
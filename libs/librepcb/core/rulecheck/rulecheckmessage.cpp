@@ -22,6 +22,10 @@
  ******************************************************************************/
 #include "rulecheckmessage.h"
 
+#include <QtCore>
+
+#include <functional>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -34,9 +38,12 @@ namespace librepcb {
 RuleCheckMessage::RuleCheckMessage(const RuleCheckMessage& other) noexcept
   : mSeverity(other.mSeverity),
     mMessage(other.mMessage),
-    mDescription(other.mDescription),
+    mDescriptionGenerator(other.mDescriptionGenerator),
     mApproval(other.mApproval),
     mLocations(other.mLocations) {
+  QMutexLocker lock(&other.mLazyMutex);
+  mDescription = other.mDescription;
+  mApprovalKey = other.mApprovalKey;
 }
 
 RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
@@ -46,11 +53,26 @@ RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
   : mSeverity(severity),
     mMessage(msg),
     mDescription(description),
+    mDescriptionGenerator(nullptr),
     mApproval(SExpression::createList("approved")),
     mLocations(locations) {
   mApproval.appendChild(SExpression::createToken(approvalName));  // snake_case
 }
 
+RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
+                                   DescriptionGenerator description,
+                                   const QString& approvalName,
+                                   const QVector<Path>& locations) noexcept
+  : mSeverity(severity),
+    mMessage(msg),
+    mDescription(),
+    mDescriptionGenerator(description),
+    mApproval(SExpression::createList("approved")),
+    mLocations(locations) {
+  Q_ASSERT(mDescriptionGenerator);
+  mApproval.appendChild(SExpression::createToken(approvalName));  // snake_case
+}
+
 RuleCheckMessage::~RuleCheckMessage() noexcept {
 }
 
@@ -62,6 +84,22 @@ const QIcon& RuleCheckMessage::getSeverityIcon() const noexcept {
   return getSeverityIcon(mSeverity);
 }
 
+const QString& RuleCheckMessage::getDescription() const noexcept {
+  QMutexLocker lock(&mLazyMutex);
+  if (mDescriptionGenerator && mDescription.isNull()) {
+    mDescription = mDescriptionGenerator();
+  }
+  return mDescription;
+}
+
+const QByteArray& RuleCheckMessage::getApprovalKey() const noexcept {
+  QMutexLocker lock(&mLazyMutex);
+  if (mApprovalKey.isEmpty()) {
+    mApprovalKey = calcApprovalKey(mApproval);
+  }
+  return mApprovalKey;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -99,6 +137,44 @@ QSet<SExpression> RuleCheckMessage::getAllApprovals(
   return approvals;
 }
 
+QSet<QByteArray> RuleCheckMessage::getAllApprovalKeys(
+    const QVector<std::shared_ptr<const RuleCheckMessage>>& messages) noexcept {
+  QSet<QByteArray> keys;
+  keys.reserve(messages.count());
+  foreach (const auto& msg, messages) {
+    Q_ASSERT(msg);
+    keys.insert(msg->getApprovalKey());
+  }
+  return keys;
+}
+
+QByteArray RuleCheckMessage::calcApprovalKey(
+    const SExpression& approval) noexcept {
+  // Each node is written with its type, the length of its value and the
+  // number of children to make the encoding unambiguous.
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  std::function<void(const SExpression&)> addNode =
+      [&hash, &addNode](const SExpression& node) {
+        QByteArray value;
+        if (node.isList()) {
+          value = node.getName().toUtf8();
+        } else if (!node.isLineBreak()) {
+          value = node.getValue().toUtf8();
+        }
+        const QList<SExpression>& children = node.getChildren();
+        const qint32 header[3] = {static_cast<qint32>(node.getType()),
+                                  static_cast<qint32>(value.size()),
+                                  static_cast<qint32>(children.count())};
+        hash.addData(reinterpret_cast<const char*>(header), sizeof(header));
+        hash.addData(value);
+        for (const SExpression& child : children) {
+          addNode(child);
+        }
+      };
+  addNode(approval);
+  return hash.result();
+}
+
 /*******************************************************************************
  *  Operator Overloads
  ******************************************************************************/
@@ -106,7 +182,7 @@ QSet<SExpression> RuleCheckMessage::getAllApprovals(
 bool RuleCheckMessage::operator==(const RuleCheckMessage& rhs) const noexcept {
   if (mSeverity != rhs.mSeverity) return false;
   if (mMessage != rhs.mMessage) return false;
-  if (mDescription != rhs.mDescription) return false;
+  if (getDescription() != rhs.getDescription()) return false;
   if (mLocations != rhs.mLocations) return false;
   return true;
 }
@@ -61,8 +61,9 @@ public:
   QString getSeverityTr() const noexcept;
   const QIcon& getSeverityIcon() const noexcept;
   const QString& getMessage() const noexcept { return mMessage; }
-  const QString& getDescription() const noexcept { return mDescription; }
+  const QString& getDescription() const noexcept;
   const SExpression& getApproval() const noexcept { return mApproval; }
+  const QByteArray& getApprovalKey() const noexcept;
   const QVector<Path>& getLocations() const noexcept { return mLocations; }
 
   // General Methods
@@ -81,24 +82,69 @@ public:
   static QSet<SExpression> getAllApprovals(
       const QVector<std::shared_ptr<const RuleCheckMessage>>&
           messages) noexcept;
+  static QSet<QByteArray> getAllApprovalKeys(
+      const QVector<std::shared_ptr<const RuleCheckMessage>>&
+          messages) noexcept;
+
+  /**
+   * @brief Calculate the key of an approval
+   *
+   * The key is a 128-bit digest over the canonical content of the approval
+   * (types, values and structure of all nodes), i.e. two approvals have the
+   * same key exactly if they compare equal. Comparing and hashing the keys is
+   * much cheaper than for the whole S-Expression trees, so approvals should
+   * be matched by their keys. The S-Expression is only needed for
+   * serialization.
+   *
+   * @param approval  The approval to calculate the key of.
+   *
+   * @return The approval key (16 bytes).
+   */
+  static QByteArray calcApprovalKey(const SExpression& approval) noexcept;
 
   // Operator Overloads
   bool operator==(const RuleCheckMessage& rhs) const noexcept;
   bool operator!=(const RuleCheckMessage& rhs) const noexcept;
 
+protected:  // Types
+  /// Function returning a (translated) description
+  typedef QString (*DescriptionGenerator)();
+
 protected:  // Methods
   RuleCheckMessage(const RuleCheckMessage& other) noexcept;
   RuleCheckMessage(Severity severity, const QString& msg,
                    const QString& description, const QString& approvalName,
                    const QVector<Path>& locations = {}) noexcept;
+
+  /**
+   * @brief Constructor with a lazily generated description
+   *
+   * The description is often a long, constant text which is only displayed
+   * if the message is selected (if at all). For messages which are typically
+   * created in large numbers, pass a generator function instead to avoid
+   * translating and storing the text for each message.
+   */
+  RuleCheckMessage(Severity severity, const QString& msg,
+                   DescriptionGenerator description,
+                   const QString& approvalName,
+                   const QVector<Path>& locations = {}) noexcept;
   virtual ~RuleCheckMessage() noexcept;
 
 protected:  // Data
   Severity mSeverity;
   QString mMessage;
-  QString mDescription;
+  mutable QString mDescription;  ///< Invalid until generated, if lazy
+  DescriptionGenerator mDescriptionGenerator;  ///< `nullptr` if not lazy
   SExpression mApproval;
   QVector<Path> mLocations;
+
+  /// Lazily calculated from #mApproval since derived classes extend it in
+  /// their constructors
+  mutable QByteArray mApprovalKey;
+
+  /// Messages are shared between threads (e.g. the DRC and the UI), so the
+  /// lazily calculated members must only be accessed with this mutex locked
+  mutable QMutex mLazyMutex;
 };
 
 typedef QVector<std::shared_ptr<const RuleCheckMessage>> RuleCheckMessageList;
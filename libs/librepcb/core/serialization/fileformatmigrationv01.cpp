@@ -33,6 +33,7 @@
 #include "../types/uuid.h"
 #include "sexpression.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 #include <algorithm>
@@ -290,6 +291,33 @@ void FileFormatMigrationV01::upgradeProject(TransactionalDirectory& dir,
 
   ProjectContext context;
 
+  // Parse all schematics and boards in worker threads while the library
+  // elements are upgraded, as they are independent of each other. Only the
+  // upgrade itself is done sequentially since it collects information in the
+  // context.
+  typedef std::pair<QString, QFuture<SExpression>> ParsedFile;
+  auto parseFile = [&dir](const QString& fp) {
+    const QByteArray content = dir.read(fp);  // can throw
+    const FilePath absFp = dir.getAbsPath(fp);
+    return ParsedFile(fp, QtConcurrent::run([content, absFp]() {
+                        return SExpression::parse(content, absFp);
+                      }));
+  };
+  QVector<ParsedFile> schematics;
+  foreach (const QString& dirName, dir.getDirs("schematics")) {
+    const QString fp = "schematics/" % dirName % "/schematic.lp";
+    if (dir.fileExists(fp)) {
+      schematics.append(parseFile(fp));  // can throw
+    }
+  }
+  QVector<ParsedFile> boardFiles;
+  foreach (const QString& dirName, dir.getDirs("boards")) {
+    const QString fp = "boards/" % dirName % "/board.lp";
+    if (dir.fileExists(fp)) {
+      boardFiles.append(parseFile(fp));  // can throw
+    }
+  }
+
   // Version File.
   upgradeVersionFile(dir, ".librepcb-project");
 
@@ -390,16 +418,16 @@ void FileFormatMigrationV01::upgradeProject(TransactionalDirectory& dir,
   }
 
   // Scan boards.
-  foreach (const QString& dirName, dir.getDirs("boards")) {
-    QString fp = "boards/" % dirName % "/board.lp";
-    if (dir.fileExists(fp)) {
-      SExpression root = SExpression::parse(dir.read(fp), dir.getAbsPath(fp));
-      foreach (const SExpression* devNode, root.getChildren("device")) {
-        const Uuid cmpUuid = deserialize<Uuid>(devNode->getChild("@0"));
-        const Uuid libDevUuid =
-            deserialize<Uuid>(devNode->getChild("lib_device/@0"));
-        context.devicesUsedInBoards[cmpUuid].insert(libDevUuid);
-      }
+  QVector<std::pair<QString, SExpression>> boards;
+  for (ParsedFile& file : boardFiles) {
+    boards.append(
+        std::make_pair(file.first, file.second.result()));  // can throw
+    const SExpression& root = boards.last().second;
+    foreach (const SExpression* devNode, root.getChildren("device")) {
+      const Uuid cmpUuid = deserialize<Uuid>(devNode->getChild("@0"));
+      const Uuid libDevUuid =
+          deserialize<Uuid>(devNode->getChild("lib_device/@0"));
+      context.devicesUsedInBoards[cmpUuid].insert(libDevUuid);
     }
   }
 
@@ -450,27 +478,21 @@ void FileFormatMigrationV01::upgradeProject(TransactionalDirectory& dir,
   }
 
   // Schematics.
-  foreach (const QString& dirName, dir.getDirs("schematics")) {
-    const QString fp = "schematics/" % dirName % "/schematic.lp";
-    if (dir.fileExists(fp)) {
-      SExpression root = SExpression::parse(dir.read(fp), dir.getAbsPath(fp));
-      upgradeSchematic(root, context);
-      dir.write(fp, root.toByteArray());
-    }
+  for (ParsedFile& file : schematics) {
+    SExpression root = file.second.result();  // can throw
+    upgradeSchematic(root, context);
+    dir.write(file.first, root.toByteArray());
   }
 
   // Boards.
-  foreach (const QString& dirName, dir.getDirs("boards")) {
-    // Board content.
-    QString fp = "boards/" % dirName % "/board.lp";
-    if (dir.fileExists(fp)) {
-      SExpression root = SExpression::parse(dir.read(fp), dir.getAbsPath(fp));
-      upgradeBoard(root, context);
-      dir.write(fp, root.toByteArray());
-    }
+  for (auto& file : boards) {
+    upgradeBoard(file.second, context);
+    dir.write(file.first, file.second.toByteArray());
+  }
 
-    // User settings.
-    fp = "boards/" % dirName % "/settings.user.lp";
+  // Board user settings.
+  foreach (const QString& dirName, dir.getDirs("boards")) {
+    const QString fp = "boards/" % dirName % "/settings.user.lp";
     if (dir.fileExists(fp)) {
       SExpression root = SExpression::parse(dir.read(fp), dir.getAbsPath(fp));
       upgradeBoardUserSettings(root);
@@ -1089,30 +1111,20 @@ void FileFormatMigrationV01::upgradeHoles(SExpression& node, bool isBoardHole) {
 }
 
 void FileFormatMigrationV01::upgradeLayers(SExpression& node) {
-  // Rename "sch_scheet_frames" to "sch_frames".
-  node.replaceRecursive(SExpression::createToken("sch_scheet_frames"),
-                        SExpression::createToken("sch_frames"));
-
-  // Rename "brd_sheet_frames" to "brd_frames".
-  node.replaceRecursive(SExpression::createToken("brd_sheet_frames"),
-                        SExpression::createToken("brd_frames"));
-
-  // Rename "brd_milling_pth" to "brd_plated_cutouts".
-  node.replaceRecursive(SExpression::createToken("brd_milling_pth"),
-                        SExpression::createToken("brd_plated_cutouts"));
+  // Rename layers, all at once to traverse the tree only once.
+  static const QHash<QString, QString> replacements = {
+      {"sch_scheet_frames", "sch_frames"},
+      {"brd_sheet_frames", "brd_frames"},
+      {"brd_milling_pth", "brd_plated_cutouts"},
+      {"top_placement", "top_legend"},
+      {"bot_placement", "bot_legend"},
+  };
+  node.replaceTokensRecursive(replacements);
 
   // Remove nodes on never officially existing layer "brd_keepout".
   SExpression search = SExpression::createList("layer");
   search.appendChild(SExpression::createToken("brd_keepout"));
   node.removeChildrenWithNodeRecursive(search);
-
-  // Rename "top_placement" to "top_legend".
-  node.replaceRecursive(SExpression::createToken("top_placement"),
-                        SExpression::createToken("top_legend"));
-
-  // Rename "bot_placement" to "bot_legend".
-  node.replaceRecursive(SExpression::createToken("bot_placement"),
-                        SExpression::createToken("bot_legend"));
 }
 
 void FileFormatMigrationV01::upgradeInversionCharacters(
@@ -1150,7 +1162,9 @@ void FileFormatMigrationV01::replaceStrings(
     for (auto it = replacements.begin(); it != replacements.end(); it++) {
       s.replace(it.key(), it.value());
     }
-    child->setValue(s);
+    if (s != child->getValue()) {
+      child->setValue(s);
+    }
   }
 }
 
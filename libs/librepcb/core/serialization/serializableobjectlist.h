@@ -54,7 +54,8 @@ namespace librepcb {
  *   librepcb::SExpression.
  * - Iterators (for example to use in C++11 range based for loops).
  * - Methods to find elements by UUID and/or name (if supported by template type
- *   `T`).
+ *   `T`). Lookups by pointer and by UUID use a lazily built hash index, so
+ *   they don't need to scan the whole list.
  * - Method #sortedByUuid() to create a copy of the list with elements sorted by
  *   UUID.
  * - Signals to get notified about added, removed and modified elements.
@@ -217,20 +218,10 @@ public:
 
   // Element Query
   int indexOf(const T* obj) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i].get() == obj) {
-        return i;
-      }
-    }
-    return -1;
+    return lookup(mPointerIndex, obj, [](const T& o) { return &o; });
   }
   int indexOf(const Uuid& key) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i]->getUuid() == key) {
-        return i;
-      }
-    }
-    return -1;
+    return lookup(mUuidIndex, key, [](const T& o) { return o.getUuid(); });
   }
   int indexOf(const QString& name) const noexcept {
     for (int i = 0; i < count(); ++i) {
@@ -443,11 +434,15 @@ public:
 
 protected:  // Methods
   void insertElement(int index, const std::shared_ptr<T>& obj) noexcept {
+    mPointerIndex.invalidate(index);
+    mUuidIndex.invalidate(index);
     mObjects.insert(index, obj);
     obj->onEdited.attach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementAdded);
   }
   std::shared_ptr<T> takeElement(int index) noexcept {
+    mPointerIndex.invalidate(index);
+    mUuidIndex.invalidate(index);
     std::shared_ptr<T> obj = mObjects.takeAt(index);
     obj->onEdited.detach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementRemoved);
@@ -456,6 +451,7 @@ protected:  // Methods
   void elementEditedHandler(const T& obj, OnEditedArgs... args) noexcept {
     int index = indexOf(&obj);
     if (contains(index)) {
+      mUuidIndex.invalidate(index);  // The UUID might have been changed.
       onElementEdited.notify(index, at(index), args...);
       onEdited.notify(index, at(index), Event::ElementEdited);
     } else {
@@ -481,7 +477,45 @@ protected:  // Methods
             .arg(name));
   }
 
+private:  // Types
+  /**
+   * Hash index of the first #count elements, mapping a key to the index of
+   * the first element with this key. Appending elements does not invalidate
+   * it, the new elements are indexed lazily by the next lookup.
+   */
+  template <typename K>
+  struct Index {
+    QHash<K, int> indices;
+    int count = 0;
+
+    void invalidate(int index) noexcept {
+      if (index < count) {
+        indices.clear();
+        count = 0;
+      }
+    }
+  };
+
 private:  // Internal Helper Methods
+  template <typename K, typename F>
+  int lookup(Index<K>& index, const K& key, F getKey) const noexcept {
+    QMutexLocker lock(&mIndexMutex);  // Allow concurrent lookups.
+    auto it = index.indices.constFind(key);
+    if (it != index.indices.constEnd()) {
+      return it.value();
+    }
+    while (index.count < mObjects.count()) {
+      const int i = index.count++;
+      const K k = getKey(*mObjects.at(i));
+      if (!index.indices.contains(k)) {
+        index.indices.insert(k, i);
+        if (k == key) {
+          return i;
+        }
+      }
+    }
+    return -1;
+  }
   std::shared_ptr<T> copyObject(const T& other,
                                 std::true_type copyConstructable) noexcept {
     Q_UNUSED(copyConstructable);
@@ -496,6 +530,11 @@ private:  // Internal Helper Methods
 protected:  // Data
   QVector<std::shared_ptr<T>> mObjects;
   Slot<T, OnEditedArgs...> mOnEditedSlot;
+
+private:  // Data
+  mutable QMutex mIndexMutex;
+  mutable Index<const T*> mPointerIndex;
+  mutable Index<Uuid> mUuidIndex;
 };
 
 }  // namespace librepcb
@@ -34,6 +34,32 @@
  ******************************************************************************/
 namespace librepcb {
 
+constexpr int SExpression::sChildIndexThreshold;
+std::atomic<quint64> SExpression::sRenamedNodes(0);
+
+/*******************************************************************************
+ *  Struct SExpression::ParseContext
+ ******************************************************************************/
+
+/**
+ * @brief State of the S-Expression parser
+ *
+ * The parser works directly on the UTF-8 encoded file content, only string
+ * values get decoded. List names and tokens are interned, so all equal names
+ * share the same (implicitly shared) QString instead of allocating a new one
+ * for each node.
+ */
+struct SExpression::ParseContext {
+  const char* data;
+  int size;
+  int index;
+  const FilePath& filePath;
+  QHash<QByteArray, QString> tokens;
+
+  bool atEnd() const noexcept { return index >= size; }
+  char current() const noexcept { return data[index]; }
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -49,7 +75,8 @@ SExpression::SExpression(const SExpression& other) noexcept
   : mType(other.mType),
     mValue(other.mValue),
     mChildren(other.mChildren),
-    mFilePath(other.mFilePath) {
+    mFilePath(other.mFilePath),
+    mChildIndex(std::atomic_load(&other.mChildIndex)) {
 }
 
 SExpression::~SExpression() noexcept {
@@ -77,6 +104,7 @@ const QString& SExpression::getValue() const {
 }
 
 QList<SExpression*> SExpression::getChildren(Type type) noexcept {
+  invalidateChildIndex();  // Children might be modified through the pointers.
   QList<SExpression*> children;
   for (SExpression& child : mChildren) {
     if (child.getType() == type) {
@@ -97,6 +125,7 @@ QList<const SExpression*> SExpression::getChildren(Type type) const noexcept {
 }
 
 QList<SExpression*> SExpression::getChildren(const QString& name) noexcept {
+  invalidateChildIndex();  // Children might be modified through the pointers.
   QList<SExpression*> children;
   for (SExpression& child : mChildren) {
     if (child.isList() && (child.mValue == name)) {
@@ -109,9 +138,15 @@ QList<SExpression*> SExpression::getChildren(const QString& name) noexcept {
 QList<const SExpression*> SExpression::getChildren(
     const QString& name) const noexcept {
   QList<const SExpression*> children;
-  for (const SExpression& child : mChildren) {
-    if (child.isList() && (child.mValue == name)) {
-      children.append(&child);
+  if (std::shared_ptr<const ChildIndex> index = getChildIndex()) {
+    foreach (int i, index->lists.value(name)) {
+      children.append(&mChildren.at(i));
+    }
+  } else {
+    for (const SExpression& child : mChildren) {
+      if (child.isList() && (child.mValue == name)) {
+        children.append(&child);
+      }
     }
   }
   return children;
@@ -128,40 +163,48 @@ SExpression& SExpression::getChild(const QString& path) {
 }
 
 const SExpression& SExpression::getChild(const QString& path) const {
-  return const_cast<SExpression*>(this)->getChild(path);
+  const SExpression* child = tryGetChild(path);
+  if (child) {
+    return *child;
+  } else {
+    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+                         QString("Child not found: %1").arg(path));
+  }
 }
 
 SExpression* SExpression::tryGetChild(const QString& path) noexcept {
+  // Note: The returned child might be modified by the caller, which would
+  // make the child index of its parent outdated. Thus invalidate the index of
+  // every node along the path.
   SExpression* child = this;
-  foreach (const QString& name, path.split('/')) {
-    if (name.startsWith('@')) {
-      bool valid = false;
-      int index = name.mid(1).toInt(&valid);
-      if ((valid) && (index >= 0) && skipLineBreaks(child->mChildren, index)) {
-        child = &child->mChildren[index];
-      } else {
-        return nullptr;
-      }
-    } else {
-      bool found = false;
-      for (SExpression& childchild : child->mChildren) {
-        if (childchild.isList() && (childchild.mValue == name)) {
-          child = &childchild;
-          found = true;
-          break;
-        }
-      }
-      if (!found) {
-        return nullptr;
-      }
+  int start = 0;
+  while (child) {
+    const int end = path.indexOf('/', start);
+    child->invalidateChildIndex();
+    const int i = child->findChild(getPathSegment(path, start, end), false);
+    child = (i >= 0) ? &child->mChildren[i] : nullptr;
+    if (end < 0) {
+      break;
     }
+    start = end + 1;
   }
   return child;
 }
 
 const SExpression* SExpression::tryGetChild(
     const QString& path) const noexcept {
-  return const_cast<SExpression*>(this)->tryGetChild(path);
+  const SExpression* child = this;
+  int start = 0;
+  while (child) {
+    const int end = path.indexOf('/', start);
+    const int i = child->findChild(getPathSegment(path, start, end), true);
+    child = (i >= 0) ? &child->mChildren.at(i) : nullptr;
+    if (end < 0) {
+      break;
+    }
+    start = end + 1;
+  }
+  return child;
 }
 
 /*******************************************************************************
@@ -170,6 +213,7 @@ const SExpression* SExpression::tryGetChild(
 
 void SExpression::setName(const QString& name) {
   if (mType == Type::List) {
+    ++sRenamedNodes;  // Outdates the child index of the parent.
     mValue = name;
   } else {
     throw LogicError(__FILE__, __LINE__);
@@ -189,6 +233,7 @@ void SExpression::setValue(const QString& value) {
  ******************************************************************************/
 
 void SExpression::ensureLineBreak() {
+  invalidateChildIndex();
   if (mChildren.isEmpty() || (!mChildren.last().isLineBreak())) {
     mChildren.append(createLineBreak());
   }
@@ -200,6 +245,7 @@ SExpression& SExpression::appendList(const QString& name) {
 
 SExpression& SExpression::appendChild(const SExpression& child) {
   if (mType == Type::List) {
+    invalidateChildIndex();
     mChildren.append(child);
     return mChildren.last();
   } else {
@@ -208,6 +254,7 @@ SExpression& SExpression::appendChild(const SExpression& child) {
 }
 
 void SExpression::removeChild(const SExpression& child) {
+  invalidateChildIndex();
   for (int i = 0; i < mChildren.count(); ++i) {
     if (&mChildren.at(i) == &child) {
       mChildren.removeAt(i);
@@ -219,6 +266,7 @@ void SExpression::removeChild(const SExpression& child) {
 
 void SExpression::removeChildrenWithNodeRecursive(
     const SExpression& search) noexcept {
+  invalidateChildIndex();
   for (int i = mChildren.count() - 1; i >= 0; --i) {
     if (mChildren.at(i).mChildren.contains(search)) {
       mChildren.removeAt(i);
@@ -230,6 +278,7 @@ void SExpression::removeChildrenWithNodeRecursive(
 
 void SExpression::replaceRecursive(const SExpression& search,
                                    const SExpression& replace) noexcept {
+  invalidateChildIndex();
   for (SExpression& child : mChildren) {
     if (child == search) {
       child = replace;
@@ -239,12 +288,30 @@ void SExpression::replaceRecursive(const SExpression& search,
   }
 }
 
+void SExpression::replaceTokensRecursive(
+    const QHash<QString, QString>& replacements) noexcept {
+  invalidateChildIndex();
+  for (SExpression& child : mChildren) {
+    if (child.mType == Type::Token) {
+      auto it = replacements.find(child.mValue);
+      if (it != replacements.end()) {
+        child.mValue = *it;
+      }
+    } else if (child.mType == Type::List) {
+      child.replaceTokensRecursive(replacements);
+    }
+  }
+}
+
 QByteArray SExpression::toByteArray() const {
-  QString str = toString(0);  // can throw
-  if (!str.endsWith('\n')) {
-    str += '\n';  // newline at end of file
+  // Note: The whole tree is written as UTF-8 into a single buffer, without
+  // creating temporary strings for each node.
+  QByteArray output;
+  write(output, 0);  // can throw
+  if (!output.endsWith('\n')) {
+    output += '\n';  // newline at end of file
   }
-  return str.toUtf8();
+  return output;
 }
 
 /*******************************************************************************
@@ -278,6 +345,8 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
   mValue = rhs.mValue;
   mChildren = rhs.mChildren;
   mFilePath = rhs.mFilePath;
+  ++sRenamedNodes;  // Type or name changed -> outdates index of the parent.
+  std::atomic_store(&mChildIndex, std::atomic_load(&rhs.mChildIndex));
   return *this;
 }
 
@@ -285,27 +354,42 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
  *  Private Methods
  ******************************************************************************/
 
-QString SExpression::escapeString(const QString& string) noexcept {
-  static QHash<QChar, QString> replacements;
-  if (replacements.isEmpty()) {
-    replacements = {
-        {'"', "\\\""},  // Double quote *must* be escaped
-        {'\\', "\\\\"},  // Backslash *must* be escaped
-        {'\b', "\\b"},  // Escape backspace to increase readability
-        {'\f', "\\f"},  // Escape form feed to increase readability
-        {'\n', "\\n"},  // Escape line feed to increase readability
-        {'\r', "\\r"},  // Escape carriage return to increase readability
-        {'\t', "\\t"},  // Escape horizontal tab to increase readability
-        {'\v', "\\v"},  // Escape vertical tab to increase readability
-    };
-  }
-
-  QString escaped;
-  escaped.reserve(string.length() + (string.length() / 10));
-  foreach (const QChar& c, string) {
-    escaped += replacements.value(c, c);
+void SExpression::writeEscaped(QByteArray& output,
+                               const QString& string) noexcept {
+  // Note: All escaped characters are ASCII, they never occur within multi-byte
+  // UTF-8 sequences. Thus the string can be escaped byte by byte.
+  const QByteArray utf8 = string.toUtf8();
+  for (const char c : utf8) {
+    switch (c) {
+      case '"':  // Double quote *must* be escaped
+        output += "\\\"";
+        break;
+      case '\\':  // Backslash *must* be escaped
+        output += "\\\\";
+        break;
+      case '\b':  // Escape backspace to increase readability
+        output += "\\b";
+        break;
+      case '\f':  // Escape form feed to increase readability
+        output += "\\f";
+        break;
+      case '\n':  // Escape line feed to increase readability
+        output += "\\n";
+        break;
+      case '\r':  // Escape carriage return to increase readability
+        output += "\\r";
+        break;
+      case '\t':  // Escape horizontal tab to increase readability
+        output += "\\t";
+        break;
+      case '\v':  // Escape vertical tab to increase readability
+        output += "\\v";
+        break;
+      default:
+        output += c;
+        break;
+    }
   }
-  return escaped;
 }
 
 bool SExpression::isValidToken(const QString& token) noexcept {
@@ -321,25 +405,30 @@ bool SExpression::isValidToken(const QString& token) noexcept {
 }
 
 bool SExpression::isValidTokenChar(const QChar& c) noexcept {
-  static QSet<QChar> allowedSpecialChars = {'\\', '.', ':', '_', '-'};
+  return (c.unicode() < 0x80) && isValidTokenChar(c.toLatin1());
+}
+
+bool SExpression::isValidTokenChar(char c) noexcept {
   return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
-      ((c >= '0') && (c <= '9')) || allowedSpecialChars.contains(c);
+      ((c >= '0') && (c <= '9')) || (c == '\\') || (c == '.') || (c == ':') ||
+      (c == '_') || (c == '-');
 }
 
-QString SExpression::toString(int indent) const {
+void SExpression::write(QByteArray& output, int indent) const {
   if (mType == Type::List) {
     if (!isValidToken(mValue)) {
       throw LogicError(
           __FILE__, __LINE__,
           QString("Invalid S-Expression list name: %1").arg(mValue));
     }
-    QString str = '(' + mValue;
+    output += '(';
+    output += mValue.toLatin1();
     bool lastCharIsSpace = false;
     const int lastIndex = mChildren.count() - 1;
     for (int i = 0; i < mChildren.count(); ++i) {
       const SExpression& child = mChildren.at(i);
       if ((!lastCharIsSpace) && (!child.isLineBreak())) {
-        str += ' ';
+        output += ' ';
       }
       const bool nextChildIsLineBreak =
           (i < lastIndex) && mChildren.at(i + 1).isLineBreak();
@@ -349,19 +438,29 @@ QString SExpression::toString(int indent) const {
       if (lastCharIsSpace && (i == lastIndex)) {
         --currentIndent;
       }
-      str += child.toString(currentIndent);
+      child.write(output, currentIndent);  // can throw
     }
-    return str + ')';
+    output += ')';
   } else if (mType == Type::Token) {
     if (!isValidToken(mValue)) {
       throw LogicError(__FILE__, __LINE__,
                        QString("Invalid S-Expression token: %1").arg(mValue));
     }
-    return mValue;
+    // Tokens consist of ASCII characters only, so they can be copied
+    // directly into the output without a temporary byte array.
+    const int offset = output.size();
+    output.resize(offset + mValue.size());
+    char* data = output.data() + offset;
+    for (const QChar& c : mValue) {
+      *data++ = c.toLatin1();
+    }
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    output += '"';
+    writeEscaped(output, mValue);
+    output += '"';
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    output += '\n';
+    output += QByteArray(indent, ' ');
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -389,16 +488,15 @@ SExpression SExpression::createLineBreak() {
 
 SExpression SExpression::parse(const QByteArray& content,
                                const FilePath& filePath) {
-  int index = 0;
-  QString contentStr = QString::fromUtf8(content);
-  skipWhitespaceAndComments(contentStr, index, true);  // Skip newlines as well.
-  if (index >= contentStr.length()) {
+  ParseContext ctx{content.constData(), content.size(), 0, filePath, {}};
+  skipWhitespaceAndComments(ctx, true);  // Skip newlines as well.
+  if (ctx.atEnd()) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                          "No S-Expression node found.");
   }
-  SExpression root = parse(contentStr, index, filePath);
-  skipWhitespaceAndComments(contentStr, index, true);  // Skip newlines as well.
-  if (index < contentStr.length()) {
+  SExpression root = parse(ctx);
+  skipWhitespaceAndComments(ctx, true);  // Skip newlines as well.
+  if (!ctx.atEnd()) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                          "File contains more than one root node.");
   }
@@ -434,74 +532,155 @@ bool SExpression::skipLineBreaks(const QList<SExpression>& children,
   return false;
 }
 
-SExpression SExpression::parse(const QString& content, int& index,
-                               const FilePath& filePath) {
-  Q_ASSERT(index < content.length());
+int SExpression::findChild(const QString& name, bool useIndex) const noexcept {
+  std::shared_ptr<const ChildIndex> index =
+      useIndex ? getChildIndex() : nullptr;
+  if (name.startsWith('@')) {
+    bool valid = false;
+    int i = name.midRef(1).toInt(&valid);
+    if ((!valid) || (i < 0)) {
+      return -1;
+    } else if (index) {
+      return (i < index->items.count()) ? index->items.at(i) : -1;
+    } else {
+      return skipLineBreaks(mChildren, i) ? i : -1;
+    }
+  } else if (index) {
+    auto it = index->lists.constFind(name);
+    return (it != index->lists.constEnd()) ? it->first() : -1;
+  } else {
+    for (int i = 0; i < mChildren.count(); ++i) {
+      const SExpression& child = mChildren.at(i);
+      if (child.isList() && (child.mValue == name)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+}
+
+std::shared_ptr<const SExpression::ChildIndex> SExpression::getChildIndex()
+    const noexcept {
+  if (mChildren.count() < sChildIndexThreshold) {
+    return nullptr;  // Linear search is fast enough.
+  }
 
-  if (content.at(index) == '\n') {
-    ++index;  // consume the '\n'
-    skipWhitespaceAndComments(content, index);  // consume following spaces
+  // Note: Const methods must be thread-safe, thus the index is replaced
+  // atomically. If several threads build it at the same time, they all get
+  // the same content anyway.
+  // Insertions and removals of children reset the index of this node, but
+  // renamed children can't notify their parent. Thus an index is also
+  // outdated as soon as any node has been renamed since it was built.
+  const quint64 renamedNodes = sRenamedNodes;
+  std::shared_ptr<const ChildIndex> index = std::atomic_load(&mChildIndex);
+  if ((!index) || (index->renamedNodes != renamedNodes) ||
+      (index->count != mChildren.count())) {
+    auto newIndex = std::make_shared<ChildIndex>();
+    newIndex->renamedNodes = renamedNodes;
+    newIndex->count = mChildren.count();
+    for (int i = 0; i < mChildren.count(); ++i) {
+      const SExpression& child = mChildren.at(i);
+      if (!child.isLineBreak()) {
+        newIndex->items.append(i);
+      }
+      if (child.isList()) {
+        newIndex->lists[child.mValue].append(i);
+      }
+    }
+    index = newIndex;
+    std::atomic_store(&mChildIndex, index);
+  }
+  return index;
+}
+
+void SExpression::invalidateChildIndex() noexcept {
+  std::atomic_store(&mChildIndex, std::shared_ptr<const ChildIndex>());
+}
+
+QString SExpression::getPathSegment(const QString& path, int start,
+                                    int end) noexcept {
+  if ((start == 0) && (end < 0)) {
+    return path;  // Avoid a copy for the most common case.
+  } else {
+    return path.mid(start, (end < 0) ? -1 : (end - start));
+  }
+}
+
+SExpression SExpression::parse(ParseContext& ctx) {
+  Q_ASSERT(!ctx.atEnd());
+
+  if (ctx.current() == '\n') {
+    ++ctx.index;  // consume the '\n'
+    skipWhitespaceAndComments(ctx);  // consume following spaces
     return createLineBreak();
-  } else if (content.at(index) == '(') {
-    return parseList(content, index, filePath);
-  } else if (content.at(index) == '"') {
-    return createString(parseString(content, index, filePath));
+  } else if (ctx.current() == '(') {
+    return parseList(ctx);
+  } else if (ctx.current() == '"') {
+    return createString(parseString(ctx));
   } else {
-    return createToken(parseToken(content, index, filePath));
+    return createToken(parseToken(ctx));
   }
 }
 
-SExpression SExpression::parseList(const QString& content, int& index,
-                                   const FilePath& filePath) {
-  Q_ASSERT((index < content.length()) && (content.at(index) == '('));
+SExpression SExpression::parseList(ParseContext& ctx) {
+  Q_ASSERT((!ctx.atEnd()) && (ctx.current() == '('));
 
-  ++index;  // consume the '('
+  ++ctx.index;  // consume the '('
 
-  SExpression list = createList(parseToken(content, index, filePath));
+  SExpression list = createList(parseToken(ctx));
 
   while (true) {
-    if (index >= content.length()) {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
+    if (ctx.atEnd()) {
+      throw FileParseError(__FILE__, __LINE__, ctx.filePath, -1, -1, QString(),
                            "S-Expression node ended without closing ')'.");
     }
-    if (content.at(index) == ')') {
-      ++index;  // consume the ')'
-      skipWhitespaceAndComments(content, index);  // consume following spaces
+    if (ctx.current() == ')') {
+      ++ctx.index;  // consume the ')'
+      skipWhitespaceAndComments(ctx);  // consume following spaces
       break;
     } else {
-      list.appendChild(parse(content, index, filePath));
+      list.mChildren.append(parse(ctx));
     }
   }
 
   return list;
 }
 
-QString SExpression::parseToken(const QString& content, int& index,
-                                const FilePath& filePath) {
-  int oldIndex = index;
-  while ((index < content.length()) && (isValidTokenChar(content.at(index)))) {
-    ++index;
+QString SExpression::parseToken(ParseContext& ctx) {
+  const int oldIndex = ctx.index;
+  while ((!ctx.atEnd()) && isValidTokenChar(ctx.current())) {
+    ++ctx.index;
   }
-  QString token = content.mid(oldIndex, index - oldIndex);
-  if (token.isEmpty()) {
-    throw FileParseError(
-        __FILE__, __LINE__, filePath, -1, -1, QString(),
-        QString("Invalid token character detected: '%1'")
-            .arg(index < content.length() ? content.at(index) : QChar()));
+  const int length = ctx.index - oldIndex;
+  if (length == 0) {
+    // Decode the invalid character, it might be a multi-byte UTF-8 sequence.
+    const QString c = QString::fromUtf8(ctx.data + ctx.index,
+                                        std::min(ctx.size - ctx.index, 4));
+    throw FileParseError(__FILE__, __LINE__, ctx.filePath, -1, -1, QString(),
+                         QString("Invalid token character detected: '%1'")
+                             .arg(c.isEmpty() ? QChar() : c.at(0)));
+  }
+
+  // Tokens consist of ASCII characters only, so they can be looked up
+  // directly in the raw file content without any conversion or copy.
+  const QByteArray raw = QByteArray::fromRawData(ctx.data + oldIndex, length);
+  auto it = ctx.tokens.find(raw);
+  if (it == ctx.tokens.end()) {
+    const QByteArray key(ctx.data + oldIndex, length);
+    it = ctx.tokens.insert(key, QString::fromLatin1(key));
   }
-  skipWhitespaceAndComments(content, index);  // consume following spaces
-  return token;
+  skipWhitespaceAndComments(ctx);  // consume following spaces
+  return it.value();
 }
 
-QString SExpression::parseString(const QString& content, int& index,
-                                 const FilePath& filePath) {
-  ++index;  // consume the '"'
+QString SExpression::parseString(ParseContext& ctx) {
+  ++ctx.index;  // consume the '"'
 
   // Note: Until LibrePCB 0.1.5 we used the sexpresso library for escaping
   // strings. This library escaped more characters than we do now. To still
   // support reading the file format 0.1, we have to keep support for the
   // old escaping behavior.
-  static QHash<QChar, QChar> escapedChars = {
+  static QHash<char, char> escapedChars = {
       {'\'', '\''},  // Single quote
       {'"', '"'},  // Double quote
       {'?', '\?'},  // Question mark
@@ -515,52 +694,68 @@ QString SExpression::parseString(const QString& content, int& index,
       {'v', '\v'},  // Vertical tab
   };
 
-  QString string;
+  // Note: All special characters are ASCII, they never occur within multi-byte
+  // UTF-8 sequences. Thus the string can be unescaped byte by byte and needs
+  // to be decoded only once at the end. Strings without any escape sequence
+  // are decoded directly from the file content.
+  const int oldIndex = ctx.index;
+  QByteArray string;
+  bool hasEscapes = false;
   bool escaped = false;
   while (true) {
-    if (index >= content.length()) {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
+    if (ctx.atEnd()) {
+      throw FileParseError(__FILE__, __LINE__, ctx.filePath, -1, -1, QString(),
                            "String ended without quote.");
     }
-    const QChar& c = content.at(index);
+    const char c = ctx.current();
     if (escaped) {
-      if (escapedChars.contains(c)) {
-        string += escapedChars[c];
-        ++index;
+      auto it = escapedChars.constFind(c);
+      if (it != escapedChars.constEnd()) {
+        string += it.value();
+        ++ctx.index;
         escaped = false;
       } else {
-        throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                             QString("Illegal escape sequence: '\\%1'").arg(c));
+        throw FileParseError(
+            __FILE__, __LINE__, ctx.filePath, -1, -1, QString(),
+            QString("Illegal escape sequence: '\\%1'").arg(QChar(c)));
       }
     } else if (c == '"') {
-      ++index;  // consume the '"'
-      skipWhitespaceAndComments(content, index);  // consume following spaces
       break;
     } else if (c == '\\') {
+      if (!hasEscapes) {
+        string = QByteArray(ctx.data + oldIndex, ctx.index - oldIndex);
+        hasEscapes = true;
+      }
       escaped = true;
-      ++index;
+      ++ctx.index;
     } else {
-      string += c;
-      ++index;
+      if (hasEscapes) {
+        string += c;
+      }
+      ++ctx.index;
     }
   }
-  return string;
+  const QString result = hasEscapes
+      ? QString::fromUtf8(string)
+      : QString::fromUtf8(ctx.data + oldIndex, ctx.index - oldIndex);
+  ++ctx.index;  // consume the '"'
+  skipWhitespaceAndComments(ctx);  // consume following spaces
+  return result;
 }
 
-void SExpression::skipWhitespaceAndComments(const QString& content, int& index,
+void SExpression::skipWhitespaceAndComments(ParseContext& ctx,
                                             bool skipNewline) {
-  static QSet<QChar> spaces = {' ', '\f', '\r', '\t', '\v'};
-
   bool isComment = false;
-  while (index < content.length()) {
-    const QChar& c = content.at(index);
+  while (!ctx.atEnd()) {
+    const char c = ctx.current();
     if (c == ';') {  // Line-comment of the Lisp language
       isComment = true;
     } else if (c == '\n') {
       isComment = false;
     }
-    if (isComment || ((skipNewline) && (c == '\n')) || spaces.contains(c)) {
-      ++index;
+    if (isComment || ((skipNewline) && (c == '\n')) || (c == ' ') ||
+        (c == '\f') || (c == '\r') || (c == '\t') || (c == '\v')) {
+      ++ctx.index;
     } else {
       break;
     }
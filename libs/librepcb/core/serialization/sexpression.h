@@ -27,6 +27,9 @@
 
 #include <QtCore>
 
+#include <atomic>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -177,6 +180,17 @@ public:
   void removeChildrenWithNodeRecursive(const SExpression& search) noexcept;
   void replaceRecursive(const SExpression& search,
                         const SExpression& replace) noexcept;
+
+  /**
+   * @brief Rename tokens in the whole tree
+   *
+   * Same as calling #replaceRecursive() for each token, but all tokens are
+   * replaced during a single traversal of the tree.
+   *
+   * @param replacements  Old token values (keys) and their new values.
+   */
+  void replaceTokensRecursive(
+      const QHash<QString, QString>& replacements) noexcept;
   QByteArray toByteArray() const;
 
   // Operator Overloadings
@@ -194,32 +208,60 @@ public:
   static SExpression createLineBreak();
   static SExpression parse(const QByteArray& content, const FilePath& filePath);
 
+private:  // Types
+  struct ParseContext;
+
+  /**
+   * @brief Lookup table for the children of a list
+   *
+   * Built lazily on the first lookup by const methods. All non-const methods
+   * which may modify the children (including the ones returning non-const
+   * pointers to children) invalidate it. Since renamed children can't
+   * invalidate the index of their parent, it is also considered outdated
+   * as soon as any node was renamed after it has been built.
+   */
+  struct ChildIndex {
+    quint64 renamedNodes;  ///< Value of #sRenamedNodes when built
+    int count;  ///< Number of children when built
+    QVector<int> items;  ///< Indices of all children except line breaks
+    QHash<QString, QVector<int>> lists;  ///< Indices of child lists by name
+  };
+
 private:  // Methods
   SExpression(Type type, const QString& value);
 
   bool isMultiLine() const noexcept;
   static bool skipLineBreaks(const QList<SExpression>& children,
                              int& index) noexcept;
-  static SExpression parse(const QString& content, int& index,
-                           const FilePath& filePath);
-  static SExpression parseList(const QString& content, int& index,
-                               const FilePath& filePath);
-  static QString parseToken(const QString& content, int& index,
-                            const FilePath& filePath);
-  static QString parseString(const QString& content, int& index,
-                             const FilePath& filePath);
-  static void skipWhitespaceAndComments(const QString& content, int& index,
+  int findChild(const QString& name, bool useIndex) const noexcept;
+  std::shared_ptr<const ChildIndex> getChildIndex() const noexcept;
+  void invalidateChildIndex() noexcept;
+  static QString getPathSegment(const QString& path, int start,
+                                int end) noexcept;
+  static SExpression parse(ParseContext& ctx);
+  static SExpression parseList(ParseContext& ctx);
+  static QString parseToken(ParseContext& ctx);
+  static QString parseString(ParseContext& ctx);
+  static void skipWhitespaceAndComments(ParseContext& ctx,
                                         bool skipNewline = false);
-  static QString escapeString(const QString& string) noexcept;
+  static void writeEscaped(QByteArray& output, const QString& string) noexcept;
   static bool isValidToken(const QString& token) noexcept;
   static bool isValidTokenChar(const QChar& c) noexcept;
-  QString toString(int indent) const;
+  static bool isValidTokenChar(char c) noexcept;
+  void write(QByteArray& output, int indent) const;
 
 private:  // Data
   Type mType;
   QString mValue;  ///< either a list name, a token or a string
   QList<SExpression> mChildren;
   FilePath mFilePath;
+
+  /// Only built for lists with at least this number of children
+  static constexpr int sChildIndexThreshold = 8;
+  mutable std::shared_ptr<const ChildIndex> mChildIndex;  ///< May be nullptr
+
+  /// Number of #setName() and assignment calls, for child index validation
+  static std::atomic<quint64> sRenamedNodes;
 };
 
 /*******************************************************************************
@@ -60,7 +60,8 @@ SQLiteDatabase::TransactionScopeGuard::~TransactionScopeGuard() noexcept {
  *  Constructors / Destructor
  ******************************************************************************/
 
-SQLiteDatabase::SQLiteDatabase(const FilePath& filepath, QObject* parent)
+SQLiteDatabase::SQLiteDatabase(const FilePath& filepath, Mode mode,
+                               QObject* parent)
   : QObject(parent) {
   // create database (use random UUID as connection name)
   mDb = QSqlDatabase::addDatabase("QSQLITE", Uuid::createRandom().toStr());
@@ -83,6 +84,12 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath, QObject* parent)
   // set SQLite options
   exec("PRAGMA foreign_keys = ON");  // can throw
   enableSqliteWriteAheadLogging();  // can throw
+  if (mode == Mode::ReadOnly) {
+    // Reading through memory mapped I/O avoids copying pages into the page
+    // cache of every connection. Writes are rejected by SQLite.
+    exec("PRAGMA mmap_size = 268435456");  // can throw
+    exec("PRAGMA query_only = ON");  // can throw
+  }
 
   // check if all required features are available
   Q_ASSERT(mDb.driver() && mDb.driver()->hasFeature(QSqlDriver::Transactions));
@@ -93,6 +100,7 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath, QObject* parent)
 }
 
 SQLiteDatabase::~SQLiteDatabase() noexcept {
+  mCachedQueries.clear();  // Finalize statements before closing.
   mDb.close();
 }
 
@@ -152,6 +160,19 @@ QSqlQuery SQLiteDatabase::prepareQuery(QString query,
   return q;
 }
 
+QSqlQuery SQLiteDatabase::prepareCachedQuery(
+    QString query, const Replacements& replacements) const {
+  for (auto it = replacements.begin(); it != replacements.end(); it++) {
+    query.replace(it->first, it->second);
+  }
+
+  auto it = mCachedQueries.find(query);
+  if (it == mCachedQueries.end()) {
+    it = mCachedQueries.insert(query, prepareQuery(query));  // can throw
+  }
+  return *it;
+}
+
 int SQLiteDatabase::count(QSqlQuery& query) {
   exec(query);  // can throw
 
@@ -46,6 +46,13 @@ class SQLiteDatabase final : public QObject {
 public:
   // Types
   typedef QVector<std::pair<QString, QString>> Replacements;
+
+  /// How the database connection is going to be used
+  enum class Mode {
+    ReadWrite,  ///< Normal connection
+    ReadOnly,  ///< Only queries, with memory mapped I/O (e.g. worker threads)
+  };
+
   class TransactionScopeGuard final {
   public:
     TransactionScopeGuard() = delete;
@@ -63,7 +70,8 @@ public:
   // Constructors / Destructor
   SQLiteDatabase() = delete;
   SQLiteDatabase(const SQLiteDatabase& other) = delete;
-  SQLiteDatabase(const FilePath& filepath, QObject* parent = nullptr);
+  SQLiteDatabase(const FilePath& filepath, Mode mode = Mode::ReadWrite,
+                 QObject* parent = nullptr);
   ~SQLiteDatabase() noexcept;
 
   // SQL Commands
@@ -75,6 +83,26 @@ public:
   // General Methods
   QSqlQuery prepareQuery(QString query,
                          const Replacements& replacements = {}) const;
+
+  /**
+   * @brief Prepare a query and keep it for later reuse
+   *
+   * Same as #prepareQuery(), but the prepared statement is cached, so
+   * subsequent calls with the same query don't need to parse the SQL again.
+   * This is useful for frequently executed statements like inserts.
+   *
+   * @attention The returned object shares its state with all other objects
+   *            returned for the same query (see QSqlQuery copy semantics).
+   *            So don't use it for nested queries, and don't keep it after
+   *            executing the statement.
+   *
+   * @param query         SQL query.
+   * @param replacements  Replacements to apply on the query.
+   * @return The prepared query.
+   */
+  QSqlQuery prepareCachedQuery(QString query,
+                               const Replacements& replacements = {}) const;
+
   int count(QSqlQuery& query);
   int insert(QSqlQuery& query);
   void exec(QSqlQuery& query);
@@ -106,6 +134,7 @@ private:  // Methods
 
 private:  // Data
   QSqlDatabase mDb;
+  mutable QHash<QString, QSqlQuery> mCachedQueries;
 };
 
 /*******************************************************************************
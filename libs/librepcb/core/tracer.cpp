@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "tracer.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/// Counter to assign short, stable IDs to threads (nicer than native IDs)
+static std::atomic<int> sNextThreadId(1);
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+Tracer::Tracer() noexcept : mEnabled(false) {
+  mClock.start();
+  const QString fp = qgetenv("LIBREPCB_TRACE_FILE");
+  if (!fp.isEmpty()) {
+    setOutputFile(FilePath(QFileInfo(fp).absoluteFilePath()));
+  }
+}
+
+Tracer::~Tracer() noexcept {
+  save();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void Tracer::setOutputFile(const FilePath& fp) noexcept {
+  QMutexLocker lock(&mMutex);
+  mOutputFile = fp;
+  mEnabled = fp.isValid();
+}
+
+void Tracer::addSpan(const char* category, const char* name,
+                     const QString& detail, qint64 startNs) noexcept {
+  static thread_local const int threadId = sNextThreadId++;
+  const qint64 endNs = getTimestampNs();
+  QMutexLocker lock(&mMutex);
+  mEvents.append(
+      Event{category, name, detail, startNs, endNs - startNs, threadId});
+}
+
+void Tracer::save() noexcept {
+  QMutexLocker lock(&mMutex);
+  if ((!mOutputFile.isValid()) || mEvents.isEmpty()) {
+    return;
+  }
+
+  // Chrome trace event format with "complete" events, timestamps in µs.
+  // Nesting is derived from the timestamps of the events of each thread.
+  QJsonArray events;
+  foreach (const Event& event, mEvents) {
+    QJsonObject obj;
+    obj["name"] = QString(event.name);
+    obj["cat"] = QString(event.category);
+    obj["ph"] = "X";
+    obj["ts"] = event.startNs / 1000.0;
+    obj["dur"] = event.durationNs / 1000.0;
+    obj["pid"] = static_cast<qint64>(QCoreApplication::applicationPid());
+    obj["tid"] = event.threadId;
+    if (!event.detail.isEmpty()) {
+      obj["args"] = QJsonObject{{"detail", event.detail}};
+    }
+    events.append(obj);
+  }
+  QJsonObject root;
+  root["traceEvents"] = events;
+  root["displayTimeUnit"] = "ms";
+
+  QFile file(mOutputFile.toStr());
+  const QByteArray content = QJsonDocument(root).toJson(QJsonDocument::Compact);
+  if (file.open(QIODevice::WriteOnly) &&
+      (file.write(content) == content.size())) {
+    qInfo().noquote() << "Wrote trace with" << mEvents.count() << "spans to"
+                      << mOutputFile.toNative();
+  } else {
+    qCritical().noquote() << "Failed to write trace to"
+                          << mOutputFile.toNative();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
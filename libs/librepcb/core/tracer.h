@@ -0,0 +1,195 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_TRACER_H
+#define LIBREPCB_CORE_TRACER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "fileio/filepath.h"
+
+#include <QtCore>
+
+#include <atomic>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class Tracer
+ ******************************************************************************/
+
+/**
+ * @brief Lightweight recorder for timing traces of expensive operations
+ *
+ * Operations are measured with the RAII type #Tracer::Span, which records
+ * the start time, the duration and the calling thread. Spans created within
+ * other spans show up as nested zones. The recorded spans can be written as
+ * Chrome trace JSON file, which can be opened with `chrome://tracing` or
+ * the Perfetto UI.
+ *
+ * Tracing is disabled by default, in which case a span costs just a check of
+ * an atomic flag. It is enabled either by the environment variable
+ * `LIBREPCB_TRACE_FILE` (containing the path of the output file) or by
+ * calling #setOutputFile(). The trace is written when the application exits.
+ */
+class Tracer final {
+public:
+  // Types
+
+  /**
+   * @brief Measures the lifetime of the object as a span in the trace
+   */
+  class Span final {
+  public:
+    Span() = delete;
+    Span(const Span& other) = delete;
+
+    /**
+     * @brief Start a span
+     *
+     * @param category  Category of the span, e.g. the subsystem. Must point to
+     *                  a string literal.
+     * @param name      Name of the span. Must point to a string literal.
+     * @param detail    Optional detail (e.g. a file name) shown as argument of
+     *                  the span.
+     */
+    Span(const char* category, const char* name,
+         const QString& detail = QString()) noexcept
+      : mCategory(category),
+        mName(name),
+        mDetail(detail),
+        mStartNs(instance().isEnabled() ? instance().getTimestampNs() : -1) {}
+
+    ~Span() noexcept {
+      if (mStartNs >= 0) {
+        instance().addSpan(mCategory, mName, mDetail, mStartNs);
+      }
+    }
+
+    /**
+     * @brief Set or replace the detail of the span
+     *
+     * @param detail  The new detail.
+     */
+    void setDetail(const QString& detail) noexcept { mDetail = detail; }
+
+    Span& operator=(const Span& rhs) = delete;
+
+  private:
+    const char* mCategory;
+    const char* mName;
+    QString mDetail;
+    qint64 mStartNs;  ///< -1 if tracing was disabled when created
+  };
+
+  // Constructors / Destructor
+  Tracer(const Tracer& other) = delete;
+
+  // Getters
+
+  /**
+   * @brief Check whether spans are recorded
+   *
+   * @return True if tracing is enabled.
+   */
+  bool isEnabled() const noexcept { return mEnabled; }
+
+  /**
+   * @brief Get the current timestamp of the trace clock
+   *
+   * @return Nanoseconds since the tracer has been created.
+   */
+  qint64 getTimestampNs() const noexcept { return mClock.nsecsElapsed(); }
+
+  // General Methods
+
+  /**
+   * @brief Enable tracing and set the file to write the trace into
+   *
+   * @param fp  The output file. If invalid, tracing is disabled.
+   */
+  void setOutputFile(const FilePath& fp) noexcept;
+
+  /**
+   * @brief Record a finished span
+   *
+   * @param category  Category of the span.
+   * @param name      Name of the span.
+   * @param detail    Detail of the span (may be empty).
+   * @param startNs   Start timestamp as returned by #getTimestampNs().
+   */
+  void addSpan(const char* category, const char* name, const QString& detail,
+               qint64 startNs) noexcept;
+
+  /**
+   * @brief Write all recorded spans into the output file
+   *
+   * Called automatically on destruction, but may be called earlier to get
+   * the trace even if the application is terminated abnormally.
+   */
+  void save() noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Get the singleton instance
+   *
+   * @return The tracer instance.
+   */
+  static Tracer& instance() noexcept {
+    static Tracer tracer;
+    return tracer;
+  }
+
+  // Operator Overloadings
+  Tracer& operator=(const Tracer& rhs) = delete;
+
+private:  // Types
+  struct Event {
+    const char* category;
+    const char* name;
+    QString detail;
+    qint64 startNs;
+    qint64 durationNs;
+    int threadId;
+  };
+
+private:  // Methods
+  Tracer() noexcept;
+  ~Tracer() noexcept;
+
+private:  // Data
+  std::atomic<bool> mEnabled;
+  QElapsedTimer mClock;
+  QMutex mMutex;  ///< Protects #mOutputFile and #mEvents
+  FilePath mOutputFile;
+  QVector<Event> mEvents;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
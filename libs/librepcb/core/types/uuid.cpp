@@ -34,73 +34,44 @@
 namespace librepcb {
 
 /*******************************************************************************
- *  Static Methods
+ *  Getters
  ******************************************************************************/
 
-bool Uuid::isValid(const QString& str) noexcept {
-  // Note: This used to be done using a RegEx, but when profiling and
-  // optimizing the library rescan code we found that a manually unrolled
-  // comparison loop performs much better than the previous RegEx.
-  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
-  if (str.length() != 36) return false;
-
-  // Helper function
-  auto isLowerHex = [](const QChar& chr) {
-    return (chr >= QChar('0') && chr <= QChar('9')) ||
-        (chr >= QChar('a') && chr <= QChar('f'));
-  };
+QString Uuid::toStr() const noexcept {
+  static const char digits[] = "0123456789abcdef";
+  QString str(36, QChar('-'));
+  QChar* data = str.data();
+  int pos = 0;
+  for (int i = 0; i < 32; ++i) {
+    if ((pos == 8) || (pos == 13) || (pos == 18) || (pos == 23)) {
+      ++pos;  // Skip hyphen.
+    }
+    const quint64 value = (i < 16) ? mHigh : mLow;
+    const int shift = 60 - ((i % 16) * 4);
+    data[pos++] = QLatin1Char(digits[(value >> shift) & 0xF]);
+  }
+  return str;
+}
 
-  if (!isLowerHex(str[0])) return false;
-  if (!isLowerHex(str[1])) return false;
-  if (!isLowerHex(str[2])) return false;
-  if (!isLowerHex(str[3])) return false;
-  if (!isLowerHex(str[4])) return false;
-  if (!isLowerHex(str[5])) return false;
-  if (!isLowerHex(str[6])) return false;
-  if (!isLowerHex(str[7])) return false;
-  if (str[8] != QChar('-')) return false;
-  if (!isLowerHex(str[9])) return false;
-  if (!isLowerHex(str[10])) return false;
-  if (!isLowerHex(str[11])) return false;
-  if (!isLowerHex(str[12])) return false;
-  if (str[13] != QChar('-')) return false;
-  if (!isLowerHex(str[14])) return false;
-  if (!isLowerHex(str[15])) return false;
-  if (!isLowerHex(str[16])) return false;
-  if (!isLowerHex(str[17])) return false;
-  if (str[18] != QChar('-')) return false;
-  if (!isLowerHex(str[19])) return false;
-  if (!isLowerHex(str[20])) return false;
-  if (!isLowerHex(str[21])) return false;
-  if (!isLowerHex(str[22])) return false;
-  if (str[23] != QChar('-')) return false;
-  if (!isLowerHex(str[24])) return false;
-  if (!isLowerHex(str[25])) return false;
-  if (!isLowerHex(str[26])) return false;
-  if (!isLowerHex(str[27])) return false;
-  if (!isLowerHex(str[28])) return false;
-  if (!isLowerHex(str[29])) return false;
-  if (!isLowerHex(str[30])) return false;
-  if (!isLowerHex(str[31])) return false;
-  if (!isLowerHex(str[32])) return false;
-  if (!isLowerHex(str[33])) return false;
-  if (!isLowerHex(str[34])) return false;
-  if (!isLowerHex(str[35])) return false;
-
-  // check type of uuid
-  QUuid quuid(str);
-  if (quuid.isNull()) return false;
-  if (quuid.variant() != QUuid::DCE) return false;
-  if (quuid.version() != QUuid::Random) return false;
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
 
-  return true;
+bool Uuid::isValid(const QString& str) noexcept {
+  quint64 high, low;
+  return parse(str, high, low);
 }
 
 Uuid Uuid::createRandom() noexcept {
-  QString str =
-      QUuid::createUuid().toString().remove("{").remove("}").toLower();
-  if (isValid(str)) {
-    return Uuid(str);
+  const QUuid quuid = QUuid::createUuid();
+  const quint64 high = (quint64(quuid.data1) << 32) |
+      (quint64(quuid.data2) << 16) | quint64(quuid.data3);
+  quint64 low = 0;
+  for (int i = 0; i < 8; ++i) {
+    low = (low << 8) | quint64(quuid.data4[i]);
+  }
+  if (isValid(high, low)) {
+    return Uuid(high, low);
   } else {
     // Calls abort()!
     qFatal("Not able to generate valid random UUID, terminating application!");
@@ -108,8 +79,9 @@ Uuid Uuid::createRandom() noexcept {
 }
 
 Uuid Uuid::fromString(const QString& str) {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("String is not a valid UUID: \"%1\"").arg(str));
@@ -117,13 +89,77 @@ Uuid Uuid::fromString(const QString& str) {
 }
 
 tl::optional<Uuid> Uuid::tryFromString(const QString& str) noexcept {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 high, low;
+  if (parse(str, high, low)) {
+    return Uuid(high, low);
   } else {
     return tl::nullopt;
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool Uuid::parse(const QString& str, quint64& high, quint64& low) noexcept {
+  // Note: This used to be done using a RegEx, but when profiling and
+  // optimizing the library rescan code we found that a manually unrolled
+  // comparison loop performs much better than the previous RegEx.
+  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
+  // Since UUIDs are the most common tokens in all files, the hex digits are
+  // now validated and converted in blocks of 4 characters at once (SWAR).
+  if (str.length() != 36) return false;
+
+  const QChar* data = str.constData();
+  if (data[8] != QChar('-')) return false;
+  if (data[13] != QChar('-')) return false;
+  if (data[18] != QChar('-')) return false;
+  if (data[23] != QChar('-')) return false;
+
+  // All groups of hex digits have a length which is a multiple of 4.
+  quint64 b0, b1, b2, b3, b4, b5, b6, b7;
+  const bool valid = parseHexBlock(data, b0) && parseHexBlock(data + 4, b1) &&
+      parseHexBlock(data + 9, b2) && parseHexBlock(data + 14, b3) &&
+      parseHexBlock(data + 19, b4) && parseHexBlock(data + 24, b5) &&
+      parseHexBlock(data + 28, b6) && parseHexBlock(data + 32, b7);
+  if (!valid) return false;
+  high = (b0 << 48) | (b1 << 32) | (b2 << 16) | b3;
+  low = (b4 << 48) | (b5 << 32) | (b6 << 16) | b7;
+  return isValid(high, low);
+}
+
+bool Uuid::parseHexBlock(const QChar* data, quint64& value) noexcept {
+  // Pack the 4 UTF-16 code units into 16 bit lanes of one 64 bit integer.
+  const quint64 x = (quint64(data[0].unicode()) << 48) |
+      (quint64(data[1].unicode()) << 32) | (quint64(data[2].unicode()) << 16) |
+      quint64(data[3].unicode());
+
+  // Only Latin-1 characters can be hex digits. Then each lane is below 256,
+  // so adding a constant below 0x8000 sets bit 15 of the lane (without
+  // carrying into the next lane) exactly if the character is >= a threshold.
+  if (x & 0xFF00FF00FF00FF00ULL) return false;
+  const quint64 msb = 0x8000800080008000ULL;
+  auto ge = [x, msb](quint64 chr) {
+    return (x + (0x0001000100010001ULL * (0x8000 - chr))) & msb;
+  };
+  const quint64 isDigit = ge('0') & ~ge('9' + 1);
+  const quint64 isLower = ge('a') & ~ge('f' + 1);  // Only lowercase allowed.
+  if ((isDigit | isLower) != msb) return false;
+
+  // The lower nibble is the value of digits, letters need an offset of 9.
+  const quint64 nibbles = (x & 0x000F000F000F000FULL) + ((isLower >> 15) * 9);
+  value = ((nibbles >> 36) & 0xF000) | ((nibbles >> 24) & 0x0F00) |
+      ((nibbles >> 12) & 0x00F0) | (nibbles & 0x000F);
+  return true;
+}
+
+bool Uuid::isValid(quint64 high, quint64 low) noexcept {
+  // Only DCE variant (bits "10") and version 4 (random) are supported.
+  const bool isDce = ((low >> 62) == 0x2);
+  const bool isVersion4 = (((high >> 12) & 0xF) == 0x4);
+  return isDce && isVersion4;
+}
+
 /*******************************************************************************
  *  Non-Member Functions
  ******************************************************************************/
@@ -149,7 +185,7 @@ Uuid deserialize(const SExpression& node) {
 
 template <>
 tl::optional<Uuid> deserialize(const SExpression& node) {
-  if (node.getValue() == "none") {
+  if (node.getValue() == QLatin1String("none")) {
     return tl::nullopt;
   } else {
     return deserialize<Uuid>(node);  // can throw
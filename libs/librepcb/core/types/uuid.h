@@ -69,7 +69,7 @@ public:
    *
    * @param other     Another ::librepcb::Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept : mHigh(other.mHigh), mLow(other.mLow) {}
 
   /**
    * @brief Destructor
@@ -83,7 +83,7 @@ public:
    *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -91,18 +91,24 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs, which is the same as comparing
+   *         them as strings
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow = rhs.mLow;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
   // Static Methods
@@ -148,14 +154,50 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its binary value
+   *
+   * @param high      The upper 64 bits of the UUID
+   * @param low       The lower 64 bits of the UUID
+   */
+  Uuid(quint64 high, quint64 low) noexcept : mHigh(high), mLow(low) {}
+
+  /**
+   * @brief Parse a UUID string into its binary value
+   *
+   * @param str       The string to parse
+   * @param high      The upper 64 bits of the UUID are written here
+   * @param low       The lower 64 bits of the UUID are written here
+   *
+   * @retval true     If str is a valid UUID
+   * @retval false    If str is not a valid UUID
+   */
+  static bool parse(const QString& str, quint64& high, quint64& low) noexcept;
+
+  /**
+   * @brief Parse 4 lowercase hex digits into their binary value
+   *
+   * @param data      Pointer to the 4 characters to parse
+   * @param value     The parsed 16 bit value is written here
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @retval true     If all 4 characters are lowercase hex digits
+   * @retval false    If any character is not a lowercase hex digit
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  static bool parseHexBlock(const QChar* data, quint64& value) noexcept;
+
+  /**
+   * @brief Check if a binary value is a valid version 4 DCE UUID
+   */
+  static bool isValid(quint64 high, quint64 low) noexcept;
+
+  friend uint qHash(const Uuid& key, uint seed) noexcept;
 
 private:  // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  // The UUID is stored as a 128 bit big-endian number to make copying,
+  // comparing and hashing cheap. Comparing the numbers gives the same order
+  // as comparing the strings since the hex digits are lowercase and the
+  // hyphens are always at the same positions.
+  quint64 mHigh;  ///< Upper 64 bits, guaranteed to form a valid UUID
+  quint64 mLow;  ///< Lower 64 bits, guaranteed to form a valid UUID
 };
 
 /*******************************************************************************
@@ -173,14 +215,14 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  return ::qHash(qMakePair(key.mHigh, key.mLow), seed);
 }
 
 }  // namespace librepcb
 
 namespace tl {
 inline uint qHash(const optional<librepcb::Uuid>& key, uint seed) noexcept {
-  return ::qHash(key ? key->toStr() : QString(), seed);
+  return key ? librepcb::qHash(*key, seed) : ::qHash(QString(), seed);
 }
 }  // namespace tl
 
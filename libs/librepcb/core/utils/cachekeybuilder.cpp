@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "cachekeybuilder.h"
+
+#include "../geometry/path.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+CacheKeyBuilder::CacheKeyBuilder(
+    QCryptographicHash::Algorithm algorithm) noexcept
+  : mHash(algorithm) {
+}
+
+CacheKeyBuilder::~CacheKeyBuilder() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void CacheKeyBuilder::addType(const char* type) noexcept {
+  mHash.addData(type, static_cast<int>(qstrlen(type)) + 1);
+}
+
+void CacheKeyBuilder::addValue(qint64 value) noexcept {
+  mHash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CacheKeyBuilder::addReal(qreal value) noexcept {
+  mHash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void CacheKeyBuilder::addString(const QString& str) noexcept {
+  const QByteArray utf8 = str.toUtf8();
+  addValue(utf8.size());
+  mHash.addData(utf8);
+}
+
+void CacheKeyBuilder::addPath(const Path& path) noexcept {
+  addValue(path.getVertices().count());
+  for (const Vertex& vertex : path.getVertices()) {
+    addValue(vertex.getPos().getX().toNm());
+    addValue(vertex.getPos().getY().toNm());
+    addValue(vertex.getAngle().toMicroDeg());
+  }
+}
+
+void CacheKeyBuilder::addPaths(const QVector<Path>& paths) noexcept {
+  addValue(paths.count());
+  foreach (const Path& path, paths) {
+    addPath(path);
+  }
+}
+
+void CacheKeyBuilder::addPaths(const ClipperLib::Paths& paths) noexcept {
+  addValue(static_cast<qint64>(paths.size()));
+  for (const ClipperLib::Path& path : paths) {
+    addValue(static_cast<qint64>(path.size()));
+    mHash.addData(reinterpret_cast<const char*>(path.data()),
+                  static_cast<int>(path.size() * sizeof(ClipperLib::IntPoint)));
+  }
+}
+
+void CacheKeyBuilder::addData(const QByteArray& data) noexcept {
+  mHash.addData(data);
+}
+
+QByteArray CacheKeyBuilder::getResult() const noexcept {
+  return mHash.result();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QByteArray CacheKeyBuilder::calcKey(const char* type,
+                                    const QVector<Path>& paths,
+                                    const QVector<qint64>& values) noexcept {
+  CacheKeyBuilder builder;
+  builder.addType(type);
+  builder.addPaths(paths);
+  foreach (qint64 value, values) {
+    builder.addValue(value);
+  }
+  return builder.getResult();
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_CACHEKEYBUILDER_H
+#define LIBREPCB_CORE_CACHEKEYBUILDER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Path;
+
+/*******************************************************************************
+ *  Class CacheKeyBuilder
+ ******************************************************************************/
+
+/**
+ * @brief Helper to calculate hash keys for caching expensive results
+ *
+ * The added data is hashed in a well-defined binary format, thus the key of
+ * the same input data is always the same, even across application runs
+ * (e.g. for file caches). Variable-length data like strings and paths are
+ * prefixed by their length to avoid ambiguous keys.
+ */
+class CacheKeyBuilder final {
+public:
+  // Constructors / Destructor
+  CacheKeyBuilder(const CacheKeyBuilder& other) = delete;
+  explicit CacheKeyBuilder(QCryptographicHash::Algorithm algorithm =
+                               QCryptographicHash::Md5) noexcept;
+  ~CacheKeyBuilder() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Add a type identifier, including its terminating null character
+   *
+   * @param type    The type identifier.
+   */
+  void addType(const char* type) noexcept;
+  void addValue(qint64 value) noexcept;
+  void addReal(qreal value) noexcept;
+  void addString(const QString& str) noexcept;
+  void addPath(const Path& path) noexcept;
+  void addPaths(const QVector<Path>& paths) noexcept;
+  void addPaths(const ClipperLib::Paths& paths) noexcept;
+
+  /**
+   * @brief Add raw data without length prefix (e.g. another key)
+   *
+   * @param data    The data to add.
+   */
+  void addData(const QByteArray& data) noexcept;
+
+  /**
+   * @brief Get the key of all the data added so far
+   *
+   * @return The hash of the added data.
+   */
+  QByteArray getResult() const noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Calculate the key of a typed object consisting of paths and values
+   *
+   * @param type    The object type identifier.
+   * @param paths   The paths of the object.
+   * @param values  Any other values affecting the cached result.
+   *
+   * @return The key, calculated with the default algorithm.
+   */
+  static QByteArray calcKey(const char* type, const QVector<Path>& paths,
+                            const QVector<qint64>& values) noexcept;
+
+  // Operator Overloadings
+  CacheKeyBuilder& operator=(const CacheKeyBuilder& rhs) = delete;
+
+private:  // Data
+  QCryptographicHash mHash;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
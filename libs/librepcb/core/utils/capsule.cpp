@@ -0,0 +1,238 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "capsule.h"
+
+#include "../geometry/padgeometry.h"
+#include "../geometry/path.h"
+#include "toolbox.h"
+#include "transform.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+ClipperLib::IntRect Capsule::getBounds() const noexcept {
+  const qint64 radius = (mDiameter->toNm() + 1) / 2;
+  return ClipperLib::IntRect{
+      std::min(mP1.getX(), mP2.getX()).toNm() - radius,
+      std::min(mP1.getY(), mP2.getY()).toNm() - radius,
+      std::max(mP1.getX(), mP2.getX()).toNm() + radius,
+      std::max(mP1.getY(), mP2.getY()).toNm() + radius,
+  };
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+Length Capsule::getDistance(const Capsule& other, Point* p1,
+                            Point* p2) const noexcept {
+  Point pa, pb;
+  const Length centerDistance =
+      getSegmentDistance(mP1, mP2, other.mP1, other.mP2, pa, pb);
+  const Length r1 = *mDiameter / 2;
+  const Length r2 = *other.mDiameter / 2;
+  if (p1 || p2) {
+    // Move the nearest points of the segments onto the outlines.
+    const Point diff = pb - pa;
+    const qreal length = centerDistance.toNm();
+    if (length > 0) {
+      const qreal dx = diff.getX().toNm() / length;
+      const qreal dy = diff.getY().toNm() / length;
+      pa += Point(qRound64(dx * r1.toNm()), qRound64(dy * r1.toNm()));
+      pb -= Point(qRound64(dx * r2.toNm()), qRound64(dy * r2.toNm()));
+    }
+    if (p1) *p1 = pa;
+    if (p2) *p2 = pb;
+  }
+  return centerDistance - r1 - r2;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+tl::optional<Length> Capsule::getDistance(const QVector<Capsule>& a,
+                                          const QVector<Capsule>& b, Point* p1,
+                                          Point* p2) noexcept {
+  tl::optional<Length> result;
+  Point pa, pb;
+  for (const Capsule& ca : a) {
+    for (const Capsule& cb : b) {
+      const Length distance = ca.getDistance(cb, &pa, &pb);
+      if ((!result) || (distance < *result)) {
+        result = distance;
+        if (p1) *p1 = pa;
+        if (p2) *p2 = pb;
+      }
+    }
+  }
+  return result;
+}
+
+tl::optional<QVector<Capsule>> Capsule::fromPath(
+    const Path& path, const UnsignedLength& diameter,
+    const Transform& transform) noexcept {
+  const QVector<Vertex>& vertices = path.getVertices();
+  QVector<Capsule> capsules;
+  capsules.reserve(std::max(vertices.count() - 1, 1));
+  if (vertices.count() == 1) {
+    const Point pos = transform.map(vertices.first().getPos());
+    capsules.append(Capsule(pos, pos, diameter));
+  }
+  for (int i = 1; i < vertices.count(); ++i) {
+    if (vertices.at(i - 1).getAngle() != Angle::deg0()) {
+      return tl::nullopt;
+    }
+    capsules.append(Capsule(transform.map(vertices.at(i - 1).getPos()),
+                            transform.map(vertices.at(i).getPos()), diameter));
+  }
+  return capsules;
+}
+
+tl::optional<QVector<Capsule>> Capsule::fromPadGeometry(
+    const PadGeometry& geometry, const Transform& transform) noexcept {
+  QVector<Capsule> capsules;
+  const Length width = geometry.getWidth();
+  const Length height = geometry.getHeight();
+  switch (geometry.getShape()) {
+    case PadGeometry::Shape::RoundedRect: {
+      if ((width > 0) && (height > 0)) {
+        const Length size = std::min(width, height);
+        if (*geometry.getCornerRadius() < (size / 2)) {
+          return tl::nullopt;  // Not an obround.
+        }
+        const Length offset = (std::max(width, height) - size) / 2;
+        const Point delta =
+            (width > height) ? Point(offset, 0) : Point(0, offset);
+        capsules.append(Capsule(transform.map(-delta), transform.map(delta),
+                                UnsignedLength(size)));
+      }
+      break;
+    }
+    case PadGeometry::Shape::Stroke: {
+      if (width > 0) {
+        if (auto strokes = fromPath(geometry.getPath(), UnsignedLength(width),
+                                    transform)) {
+          capsules += *strokes;
+        } else {
+          return tl::nullopt;
+        }
+      }
+      break;
+    }
+    default: {
+      return tl::nullopt;
+    }
+  }
+  for (const PadHole& hole : geometry.getHoles()) {
+    if (auto holeCapsules =
+            fromPath(*hole.getPath(), positiveToUnsigned(hole.getDiameter()),
+                     transform)) {
+      capsules += *holeCapsules;
+    } else {
+      return tl::nullopt;
+    }
+  }
+  return capsules;
+}
+
+tl::optional<QVector<Capsule>> Capsule::fromPadGeometries(
+    const QList<PadGeometry>& geometries,
+    const Transform& transform) noexcept {
+  QVector<Capsule> capsules;
+  foreach (const PadGeometry& geometry, geometries) {
+    if (auto geometryCapsules = fromPadGeometry(geometry, transform)) {
+      capsules += *geometryCapsules;
+    } else {
+      return tl::nullopt;
+    }
+  }
+  return capsules;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+Length Capsule::getSegmentDistance(const Point& a1, const Point& a2,
+                                   const Point& b1, const Point& b2, Point& pa,
+                                   Point& pb) noexcept {
+  // If the segments properly cross each other, the distance is zero. The
+  // orientation tests are done with floating point numbers since the cross
+  // products of nanometer coordinates could overflow 64 bit integers. Nearly
+  // collinear cases are covered by the point-to-segment distances below.
+  auto cross = [](const Point& o, const Point& p, const Point& q) {
+    return (qreal(p.getX().toNm() - o.getX().toNm()) *
+            qreal(q.getY().toNm() - o.getY().toNm())) -
+        (qreal(p.getY().toNm() - o.getY().toNm()) *
+         qreal(q.getX().toNm() - o.getX().toNm()));
+  };
+  const qreal d1 = cross(b1, b2, a1);
+  const qreal d2 = cross(b1, b2, a2);
+  const qreal d3 = cross(a1, a2, b1);
+  const qreal d4 = cross(a1, a2, b2);
+  if ((((d1 > 0) && (d2 < 0)) || ((d1 < 0) && (d2 > 0))) &&
+      (((d3 > 0) && (d4 < 0)) || ((d3 < 0) && (d4 > 0)))) {
+    const qreal t = d1 / (d1 - d2);
+    pa = a1 +
+        Point(qRound64((a2.getX() - a1.getX()).toNm() * t),
+              qRound64((a2.getY() - a1.getY()).toNm() * t));
+    pb = pa;
+    return Length(0);
+  }
+
+  // Otherwise the nearest points are located on one of the end points.
+  Point nearest;
+  Length distance =
+      *Toolbox::shortestDistanceBetweenPointAndLine(a1, b1, b2, &nearest);
+  pa = a1;
+  pb = nearest;
+  auto update = [&](const Point& p, const Point& l1, const Point& l2,
+                    bool pointOnA) {
+    const Length d =
+        *Toolbox::shortestDistanceBetweenPointAndLine(p, l1, l2, &nearest);
+    if (d < distance) {
+      distance = d;
+      pa = pointOnA ? p : nearest;
+      pb = pointOnA ? nearest : p;
+    }
+  };
+  update(a2, b1, b2, true);
+  update(b1, a1, a2, false);
+  update(b2, a1, a2, false);
+  return distance;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
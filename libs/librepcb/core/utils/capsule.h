@@ -0,0 +1,190 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_CAPSULE_H
+#define LIBREPCB_CORE_CAPSULE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../types/length.h"
+#include "../types/point.h"
+
+#include <optional/tl/optional.hpp>
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class PadGeometry;
+class Path;
+class Transform;
+
+/*******************************************************************************
+ *  Class Capsule
+ ******************************************************************************/
+
+/**
+ * @brief Exact, arc-preserving representation of a round copper primitive
+ *
+ * A capsule is the area covered by a circle of a given diameter moving along
+ * a straight line segment. This covers the most common copper objects
+ * exactly: vias and round pads are capsules with a zero-length segment,
+ * traces and obround pads are capsules with a non-zero length.
+ *
+ * In contrast to the polygons passed to Clipper, no arcs need to be
+ * flattened, and the distance between two capsules can be calculated in
+ * closed form as the distance between their segments minus their radii.
+ * This is much faster and more accurate than intersecting the flattened
+ * polygons, so geometry checks should use capsules whenever all involved
+ * objects can be represented by them.
+ */
+class Capsule final {
+public:
+  // Constructors / Destructor
+  Capsule() = delete;
+  Capsule(const Capsule& other) noexcept
+    : mP1(other.mP1), mP2(other.mP2), mDiameter(other.mDiameter) {}
+  Capsule(const Point& p1, const Point& p2,
+          const UnsignedLength& diameter) noexcept
+    : mP1(p1), mP2(p2), mDiameter(diameter) {}
+  ~Capsule() noexcept {}
+
+  // Getters
+  const Point& getP1() const noexcept { return mP1; }
+  const Point& getP2() const noexcept { return mP2; }
+  const UnsignedLength& getDiameter() const noexcept { return mDiameter; }
+
+  /**
+   * @brief Get the bounding rectangle of the capsule
+   *
+   * @return The bounding rectangle (rounded outwards).
+   */
+  ClipperLib::IntRect getBounds() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Calculate the distance between the outlines of two capsules
+   *
+   * @param other   The other capsule.
+   * @param p1      If not `nullptr`, the point on the outline of this capsule
+   *                which is nearest to the other capsule is returned here.
+   * @param p2      If not `nullptr`, the point on the outline of the other
+   *                capsule which is nearest to this capsule is returned here.
+   *
+   * @return The distance between the outlines. Negative if the capsules
+   *         overlap (then it is the negative penetration depth).
+   */
+  Length getDistance(const Capsule& other, Point* p1 = nullptr,
+                     Point* p2 = nullptr) const noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Calculate the minimum distance between two sets of capsules
+   *
+   * @param a       The first set of capsules.
+   * @param b       The second set of capsules.
+   * @param p1      If not `nullptr`, the nearest point of `a` is returned here.
+   * @param p2      If not `nullptr`, the nearest point of `b` is returned here.
+   *
+   * @return The minimum distance as returned by #getDistance(), or
+   *         `tl::nullopt` if any of the sets is empty.
+   */
+  static tl::optional<Length> getDistance(const QVector<Capsule>& a,
+                                          const QVector<Capsule>& b,
+                                          Point* p1 = nullptr,
+                                          Point* p2 = nullptr) noexcept;
+
+  /**
+   * @brief Convert the strokes of a path into capsules
+   *
+   * @param path        The path to convert.
+   * @param diameter    The stroke width.
+   * @param transform   Transformation to apply to the path.
+   *
+   * @return One capsule per line segment, or `tl::nullopt` if the path
+   *         contains arcs.
+   */
+  static tl::optional<QVector<Capsule>> fromPath(
+      const Path& path, const UnsignedLength& diameter,
+      const Transform& transform) noexcept;
+
+  /**
+   * @brief Convert the copper area of a pad geometry into capsules
+   *
+   * Supported are obround (including round) pads and stroke pads with
+   * straight segments. The holes are added as capsules too, as they are
+   * covered by copper (usually they are within the outline anyway).
+   *
+   * @param geometry    The pad geometry.
+   * @param transform   Transformation of the pad.
+   *
+   * @return The capsules, or `tl::nullopt` if the geometry cannot be
+   *         represented by capsules.
+   */
+  static tl::optional<QVector<Capsule>> fromPadGeometry(
+      const PadGeometry& geometry, const Transform& transform) noexcept;
+
+  /**
+   * @brief Convert the copper area of several pad geometries into capsules
+   *
+   * @param geometries  The pad geometries (e.g. of a pad on a specific layer).
+   * @param transform   Transformation of the pad.
+   *
+   * @return The capsules of all geometries, or `tl::nullopt` if any of the
+   *         geometries cannot be represented by capsules.
+   *
+   * @see #fromPadGeometry()
+   */
+  static tl::optional<QVector<Capsule>> fromPadGeometries(
+      const QList<PadGeometry>& geometries,
+      const Transform& transform) noexcept;
+
+  // Operator Overloadings
+  Capsule& operator=(const Capsule& rhs) noexcept {
+    mP1 = rhs.mP1;
+    mP2 = rhs.mP2;
+    mDiameter = rhs.mDiameter;
+    return *this;
+  }
+
+private:  // Methods
+  static Length getSegmentDistance(const Point& a1, const Point& a2,
+                                   const Point& b1, const Point& b2, Point& pa,
+                                   Point& pb) noexcept;
+
+private:  // Data
+  Point mP1;
+  Point mP2;
+  UnsignedLength mDiameter;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
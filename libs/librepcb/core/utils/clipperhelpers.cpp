@@ -22,8 +22,14 @@
  ******************************************************************************/
 #include "clipperhelpers.h"
 
+#include "scopeguard.h"
+
 #include <QtCore>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -86,9 +92,10 @@ bool ClipperHelpers::anyPointsInside(const ClipperLib::Paths& points,
 void ClipperHelpers::unite(ClipperLib::Paths& paths,
                            ClipperLib::PolyFillType fillType) {
   try {
-    ClipperLib::Clipper c;
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     c.AddPaths(paths, ClipperLib::ptSubject, true);
-    c.Execute(ClipperLib::ctUnion, paths, fillType, ClipperLib::pftEvenOdd);
+    execute(c, ClipperLib::ctUnion, paths, fillType, ClipperLib::pftEvenOdd);
   } catch (const std::exception& e) {
     throw LogicError(__FILE__, __LINE__,
                      QString("Failed to unite paths: %1").arg(e.what()));
@@ -100,10 +107,11 @@ void ClipperHelpers::unite(ClipperLib::Paths& subject,
                            ClipperLib::PolyFillType subjectFillType,
                            ClipperLib::PolyFillType clipFillType) {
   try {
-    ClipperLib::Clipper c;
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     c.AddPaths(subject, ClipperLib::ptSubject, true);
     c.AddPaths(clip, ClipperLib::ptClip, true);
-    c.Execute(ClipperLib::ctUnion, subject, subjectFillType, clipFillType);
+    execute(c, ClipperLib::ctUnion, subject, subjectFillType, clipFillType);
   } catch (const std::exception& e) {
     throw LogicError(__FILE__, __LINE__,
                      QString("Failed to unite paths: %1").arg(e.what()));
@@ -116,9 +124,11 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::uniteToTree(
     // Wrap the PolyTree object in a smart pointer since PolyTree cannot
     // safely be copied (i.e. returned by value), it would lead to a crash!!!
     std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
-    ClipperLib::Clipper c;
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     c.AddPaths(paths, ClipperLib::ptSubject, true);
-    c.Execute(ClipperLib::ctUnion, *result, fillType, ClipperLib::pftEvenOdd);
+    execute(c, ClipperLib::ctUnion, *result, fillType,
+            ClipperLib::pftEvenOdd);
     return result;
   } catch (const std::exception& e) {
     throw LogicError(__FILE__, __LINE__,
@@ -134,10 +144,11 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::uniteToTree(
     // Wrap the PolyTree object in a smart pointer since PolyTree cannot
     // safely be copied (i.e. returned by value), it would lead to a crash!!!
     std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
-    ClipperLib::Clipper c;
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     c.AddPaths(paths, ClipperLib::ptSubject, true);
     c.AddPaths(clip, ClipperLib::ptClip, true);
-    c.Execute(ClipperLib::ctUnion, *result, subjectFillType, clipFillType);
+    execute(c, ClipperLib::ctUnion, *result, subjectFillType, clipFillType);
     return result;
   } catch (const std::exception& e) {
     throw LogicError(__FILE__, __LINE__,
@@ -149,12 +160,17 @@ void ClipperHelpers::intersect(ClipperLib::Paths& subject,
                                const ClipperLib::Paths& clip,
                                ClipperLib::PolyFillType subjectFillType,
                                ClipperLib::PolyFillType clipFillType) {
+  if (!boundsOverlap(subject, clip)) {
+    subject.clear();
+    return;
+  }
   try {
-    ClipperLib::Clipper c;
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     c.AddPaths(subject, ClipperLib::ptSubject, true);
     c.AddPaths(clip, ClipperLib::ptClip, true);
-    c.Execute(ClipperLib::ctIntersection, subject, subjectFillType,
-              clipFillType);
+    execute(c, ClipperLib::ctIntersection, subject, subjectFillType,
+            clipFillType);
   } catch (const std::exception& e) {
     throw LogicError(__FILE__, __LINE__,
                      QString("Failed to intersect paths: %1").arg(e.what()));
@@ -169,11 +185,15 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::intersectToTree(
     // Wrap the PolyTree object in a smart pointer since PolyTree cannot
     // safely be copied (i.e. returned by value), it would lead to a crash!!!
     std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
-    ClipperLib::Clipper c;
+    if (!boundsOverlap(subject, clip)) {
+      return result;
+    }
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     c.AddPaths(subject, ClipperLib::ptSubject, closed);
     c.AddPaths(clip, ClipperLib::ptClip, true);
-    c.Execute(ClipperLib::ctIntersection, *result, subjectFillType,
-              clipFillType);
+    execute(c, ClipperLib::ctIntersection, *result, subjectFillType,
+            clipFillType);
     return result;
   } catch (const std::exception& e) {
     throw LogicError(__FILE__, __LINE__,
@@ -193,7 +213,8 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::intersectToTree(
     // Wrap the PolyTree object in a smart pointer since PolyTree cannot
     // safely be copied (i.e. returned by value), it would lead to a crash!!!
     std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
-    ClipperLib::Clipper c;
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     ClipperLib::Paths intermediateSubject;
     for (int i = 1; i < paths.count(); ++i) {
       c.Clear();
@@ -204,8 +225,8 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::intersectToTree(
         c.AddPaths(intermediateSubject, ClipperLib::ptSubject, true);
       }
       c.AddPaths(paths.at(i), ClipperLib::ptClip, true);
-      c.Execute(ClipperLib::ctIntersection, *result, ClipperLib::pftEvenOdd,
-                ClipperLib::pftEvenOdd);
+      execute(c, ClipperLib::ctIntersection, *result, ClipperLib::pftEvenOdd,
+              ClipperLib::pftEvenOdd);
     }
     return result;
   } catch (const std::exception& e) {
@@ -219,10 +240,12 @@ void ClipperHelpers::subtract(ClipperLib::Paths& subject,
                               ClipperLib::PolyFillType subjectFillType,
                               ClipperLib::PolyFillType clipFillType) {
   try {
-    ClipperLib::Clipper c;
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     c.AddPaths(subject, ClipperLib::ptSubject, true);
     c.AddPaths(clip, ClipperLib::ptClip, true);
-    c.Execute(ClipperLib::ctDifference, subject, subjectFillType, clipFillType);
+    execute(c, ClipperLib::ctDifference, subject, subjectFillType,
+            clipFillType);
   } catch (const std::exception& e) {
     throw LogicError(__FILE__, __LINE__,
                      QString("Failed to subtract paths: %1").arg(e.what()));
@@ -237,10 +260,12 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::subtractToTree(
     // Wrap the PolyTree object in a smart pointer since PolyTree cannot
     // safely be copied (i.e. returned by value), it would lead to a crash!!!
     std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
-    ClipperLib::Clipper c;
+    ClipperLib::Clipper& c = clipper();
+    auto cGuard = scopeGuard([&c]() { c.Clear(); });
     c.AddPaths(subject, ClipperLib::ptSubject, closed);
     c.AddPaths(clip, ClipperLib::ptClip, true);
-    c.Execute(ClipperLib::ctDifference, *result, subjectFillType, clipFillType);
+    execute(c, ClipperLib::ctDifference, *result, subjectFillType,
+            clipFillType);
     return result;
   } catch (const std::exception& e) {
     throw LogicError(__FILE__, __LINE__,
@@ -252,7 +277,8 @@ void ClipperHelpers::offset(ClipperLib::Paths& paths, const Length& offset,
                             const PositiveLength& maxArcTolerance,
                             ClipperLib::JoinType joinType) {
   try {
-    ClipperLib::ClipperOffset o(2.0, maxArcTolerance->toNm());
+    ClipperLib::ClipperOffset& o = clipperOffset(maxArcTolerance);
+    auto oGuard = scopeGuard([&o]() { o.Clear(); });
     o.AddPaths(paths, joinType, ClipperLib::etClosedPolygon);
     o.Execute(paths, offset.toNm());
   } catch (const std::exception& e) {
@@ -268,7 +294,8 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::offsetToTree(
     // Wrap the PolyTree object in a smart pointer since PolyTree cannot
     // safely be copied (i.e. returned by value), it would lead to a crash!!!
     std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
-    ClipperLib::ClipperOffset o(2.0, maxArcTolerance->toNm());
+    ClipperLib::ClipperOffset& o = clipperOffset(maxArcTolerance);
+    auto oGuard = scopeGuard([&o]() { o.Clear(); });
     o.AddPaths(paths, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
     o.Execute(*result, offset.toNm());
     return result;
@@ -278,6 +305,26 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::offsetToTree(
   }
 }
 
+void ClipperHelpers::simplify(ClipperLib::Paths& paths,
+                              const PositiveLength& tolerance) {
+  try {
+    // Note: Clipper's CleanPolygons() is not used since its deviation
+    // accumulates when removing many consecutive vertices (e.g. of a
+    // flattened arc), i.e. it is not bounded by the tolerance.
+    for (ClipperLib::Path& path : paths) {
+      simplify(path, static_cast<qreal>(tolerance->toNm()));
+    }
+    paths.erase(std::remove_if(paths.begin(), paths.end(),
+                               [](const ClipperLib::Path& path) {
+                                 return path.size() < 3;
+                               }),
+                paths.end());
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString("Failed to simplify paths: %1").arg(e.what()));
+  }
+}
+
 ClipperLib::Paths ClipperHelpers::treeToPaths(
     const ClipperLib::PolyTree& tree) {
   try {
@@ -294,23 +341,41 @@ ClipperLib::Paths ClipperHelpers::treeToPaths(
 ClipperLib::Paths ClipperHelpers::flattenTree(
     const ClipperLib::PolyNode& node) {
   ClipperLib::Paths paths;
-  for (const ClipperLib::PolyNode* outlineChild : node.Childs) {
-    Q_ASSERT(outlineChild);
-    if (outlineChild->IsHole()) throw LogicError(__FILE__, __LINE__);
-    ClipperLib::Paths holes;
-    for (ClipperLib::PolyNode* holeChild : outlineChild->Childs) {
-      Q_ASSERT(holeChild);
-      if (!holeChild->IsHole()) throw LogicError(__FILE__, __LINE__);
-      holes.push_back(holeChild->Contour);
-      ClipperLib::Paths subpaths = flattenTree(*holeChild);  // can throw
-      paths.insert(paths.end(), subpaths.begin(), subpaths.end());
-    }
-    paths.push_back(
-        convertHolesToCutIns(outlineChild->Contour, holes));  // can throw
-  }
+  flattenTree(node, paths);  // can throw
   return paths;
 }
 
+ClipperLib::IntRect ClipperHelpers::getBounds(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect rect{std::numeric_limits<ClipperLib::cInt>::max(),
+                           std::numeric_limits<ClipperLib::cInt>::max(),
+                           std::numeric_limits<ClipperLib::cInt>::min(),
+                           std::numeric_limits<ClipperLib::cInt>::min()};
+  for (const ClipperLib::Path& path : paths) {
+    const ClipperLib::IntRect pathRect = getBounds(path);
+    rect.left = std::min(rect.left, pathRect.left);
+    rect.top = std::min(rect.top, pathRect.top);
+    rect.right = std::max(rect.right, pathRect.right);
+    rect.bottom = std::max(rect.bottom, pathRect.bottom);
+  }
+  return rect;
+}
+
+ClipperLib::IntRect ClipperHelpers::getBounds(
+    const ClipperLib::Path& path) noexcept {
+  ClipperLib::IntRect rect{std::numeric_limits<ClipperLib::cInt>::max(),
+                           std::numeric_limits<ClipperLib::cInt>::max(),
+                           std::numeric_limits<ClipperLib::cInt>::min(),
+                           std::numeric_limits<ClipperLib::cInt>::min()};
+  for (const ClipperLib::IntPoint& p : path) {
+    rect.left = std::min(rect.left, p.X);
+    rect.top = std::min(rect.top, p.Y);
+    rect.right = std::max(rect.right, p.X);
+    rect.bottom = std::max(rect.bottom, p.Y);
+  }
+  return rect;
+}
+
 /*******************************************************************************
  *  Conversion Methods
  ******************************************************************************/
@@ -340,10 +405,9 @@ Point ClipperHelpers::convert(const ClipperLib::IntPoint& point) noexcept {
 ClipperLib::Paths ClipperHelpers::convert(
     const QVector<Path>& paths,
     const PositiveLength& maxArcTolerance) noexcept {
-  ClipperLib::Paths p;
-  p.reserve(paths.size());
-  foreach (const Path& path, paths) {
-    p.push_back(convert(path, maxArcTolerance));
+  ClipperLib::Paths p(paths.size());
+  for (int i = 0; i < paths.count(); ++i) {
+    convert(paths.at(i), maxArcTolerance, p.at(i));
   }
   return p;
 }
@@ -351,13 +415,58 @@ ClipperLib::Paths ClipperHelpers::convert(
 ClipperLib::Path ClipperHelpers::convert(
     const Path& path, const PositiveLength& maxArcTolerance) noexcept {
   ClipperLib::Path p;
-  foreach (const Vertex& v, path.flattenedArcs(maxArcTolerance).getVertices()) {
-    p.push_back(convert(v.getPos()));
+  convert(path, maxArcTolerance, p);
+  return p;
+}
+
+void ClipperHelpers::convert(const Path& path,
+                             const PositiveLength& maxArcTolerance,
+                             ClipperLib::Path& out) noexcept {
+  const QVector<Vertex>& vertices = path.getVertices();
+  out.clear();
+  out.reserve(vertices.count());
+  for (int i = 0; i < vertices.count(); ++i) {
+    const Point& pos = vertices.at(i).getPos();
+    const Angle angle = (i > 0) ? vertices.at(i - 1).getAngle() : Angle(0);
+    if (angle != 0) {
+      // Flatten the arc from the previous vertex, without its start point.
+      const Path arc = Path::flatArc(vertices.at(i - 1).getPos(), pos, angle,
+                                     maxArcTolerance);
+      for (int k = 1; k < arc.getVertices().count(); ++k) {
+        out.push_back(convert(arc.getVertices().at(k).getPos()));
+      }
+    } else {
+      out.push_back(convert(pos));
+    }
   }
   // make sure all paths have the same orientation, otherwise we get strange
   // results
-  if (!ClipperLib::Orientation(p)) {
-    ClipperLib::ReversePath(p);
+  if (!ClipperLib::Orientation(out)) {
+    ClipperLib::ReversePath(out);
+  }
+}
+
+ClipperLib::Paths ClipperHelpers::convertStrokes(
+    const Path& path, const PositiveLength& width,
+    const PositiveLength& maxArcTolerance) noexcept {
+  const QVector<Vertex>& vertices = path.getVertices();
+  ClipperLib::Paths p;
+  if (vertices.count() == 1) {
+    p.emplace_back();
+    convert(Path::circle(width).translated(vertices.first().getPos()),
+            maxArcTolerance, p.back());
+  }
+  for (int i = 1; i < vertices.count(); ++i) {  // skip first vertex!
+    const Vertex& v0 = vertices.at(i - 1);
+    const Vertex& v = vertices.at(i);
+    p.emplace_back();
+    if (v0.getAngle() == 0) {
+      convert(Path::obround(v0.getPos(), v.getPos(), width), maxArcTolerance,
+              p.back());
+    } else {
+      convert(Path::arcObround(v0.getPos(), v.getPos(), v0.getAngle(), width),
+              maxArcTolerance, p.back());
+    }
   }
   return p;
 }
@@ -370,6 +479,125 @@ ClipperLib::IntPoint ClipperHelpers::convert(const Point& point) noexcept {
  *  Internal Helper Methods
  ******************************************************************************/
 
+ClipperLib::Clipper& ClipperHelpers::clipper() noexcept {
+  static thread_local ClipperLib::Clipper c;
+  c.Clear();
+  return c;
+}
+
+void ClipperHelpers::simplify(ClipperLib::Path& path, qreal tolerance) {
+  // Ramer-Douglas-Peucker algorithm on the closed path, split into two open
+  // paths at the vertex farthest from the first vertex. Each removed vertex
+  // is within the tolerance of the segment replacing it, thus the whole
+  // original outline is within the tolerance of the simplified outline.
+  const std::size_t count = path.size();
+  if (count < 3) {
+    return;
+  }
+  std::size_t farthest = 0;
+  qreal maxDistance = -1;
+  for (std::size_t i = 1; i < count; ++i) {
+    const qreal distance = std::hypot(
+        static_cast<qreal>(path[i].X - path[0].X),
+        static_cast<qreal>(path[i].Y - path[0].Y));
+    if (distance > maxDistance) {
+      farthest = i;
+      maxDistance = distance;
+    }
+  }
+  std::vector<bool> keep(count, false);
+  keep[0] = true;
+  keep[farthest] = true;
+  // Index `count` is the first vertex again, closing the path.
+  std::vector<std::pair<std::size_t, std::size_t>> ranges = {
+      {0, farthest},
+      {farthest, count},
+  };
+  while (!ranges.empty()) {
+    const std::size_t first = ranges.back().first;
+    const std::size_t last = ranges.back().second;
+    ranges.pop_back();
+    const ClipperLib::IntPoint& p1 = path[first];
+    const ClipperLib::IntPoint& p2 = path[last % count];
+    std::size_t index = first;
+    maxDistance = tolerance;
+    for (std::size_t i = first + 1; i < last; ++i) {
+      const qreal distance = getDistanceToSegment(path[i], p1, p2);
+      if (distance > maxDistance) {
+        index = i;
+        maxDistance = distance;
+      }
+    }
+    if (index != first) {
+      keep[index] = true;
+      ranges.push_back(std::make_pair(first, index));
+      ranges.push_back(std::make_pair(index, last));
+    }
+  }
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (keep[i]) {
+      path[kept++] = path[i];
+    }
+  }
+  path.resize(kept);
+}
+
+qreal ClipperHelpers::getDistanceToSegment(
+    const ClipperLib::IntPoint& p, const ClipperLib::IntPoint& p1,
+    const ClipperLib::IntPoint& p2) noexcept {
+  const qreal dx = static_cast<qreal>(p2.X - p1.X);
+  const qreal dy = static_cast<qreal>(p2.Y - p1.Y);
+  const qreal px = static_cast<qreal>(p.X - p1.X);
+  const qreal py = static_cast<qreal>(p.Y - p1.Y);
+  const qreal lengthSquared = (dx * dx) + (dy * dy);
+  const qreal t = (lengthSquared > 0)
+      ? qBound(qreal(0), ((px * dx) + (py * dy)) / lengthSquared, qreal(1))
+      : qreal(0);
+  return std::hypot(px - (t * dx), py - (t * dy));
+}
+
+template <typename T>
+void ClipperHelpers::execute(ClipperLib::Clipper& c, ClipperLib::ClipType type,
+                             T& solution,
+                             ClipperLib::PolyFillType subjectFillType,
+                             ClipperLib::PolyFillType clipFillType) {
+  if (!c.Execute(type, solution, subjectFillType, clipFillType)) {
+    throw LogicError(__FILE__, __LINE__, "Clipper operation failed.");
+  }
+}
+
+ClipperLib::ClipperOffset& ClipperHelpers::clipperOffset(
+    const PositiveLength& maxArcTolerance) noexcept {
+  static thread_local ClipperLib::ClipperOffset o;
+  o.Clear();
+  o.MiterLimit = 2.0;
+  o.ArcTolerance = maxArcTolerance->toNm();
+  return o;
+}
+
+void ClipperHelpers::flattenTree(const ClipperLib::PolyNode& node,
+                                 ClipperLib::Paths& paths) {
+  // Append all results directly to the output instead of concatenating the
+  // results of the recursive calls, and reuse the holes container for all
+  // outlines. This is called for every pair of items in the DRC, thus
+  // avoiding temporary allocations is worth it.
+  ClipperLib::Paths holes;
+  for (const ClipperLib::PolyNode* outlineChild : node.Childs) {
+    Q_ASSERT(outlineChild);
+    if (outlineChild->IsHole()) throw LogicError(__FILE__, __LINE__);
+    holes.clear();
+    for (ClipperLib::PolyNode* holeChild : outlineChild->Childs) {
+      Q_ASSERT(holeChild);
+      if (!holeChild->IsHole()) throw LogicError(__FILE__, __LINE__);
+      holes.push_back(holeChild->Contour);
+      flattenTree(*holeChild, paths);  // can throw
+    }
+    paths.push_back(
+        convertHolesToCutIns(outlineChild->Contour, holes));  // can throw
+  }
+}
+
 ClipperLib::Path ClipperHelpers::convertHolesToCutIns(
     const ClipperLib::Path& outline, const ClipperLib::Paths& holes) {
   ClipperLib::Path path = outline;
@@ -454,6 +682,16 @@ int ClipperHelpers::insertConnectionPointToPath(ClipperLib::Path& path,
   }
 }
 
+bool ClipperHelpers::boundsOverlap(const ClipperLib::Paths& a,
+                                   const ClipperLib::Paths& b) noexcept {
+  // Note: Touching rectangles are considered as overlapping to keep the exact
+  // behavior of Clipper for edge cases like open paths on a boundary.
+  const ClipperLib::IntRect ra = getBounds(a);
+  const ClipperLib::IntRect rb = getBounds(b);
+  return (ra.left <= rb.right) && (rb.left <= ra.right) &&
+      (ra.top <= rb.bottom) && (rb.top <= ra.bottom);
+}
+
 bool ClipperHelpers::calcIntersectionPos(const ClipperLib::IntPoint& p1,
                                          const ClipperLib::IntPoint& p2,
                                          const ClipperLib::cInt& x,
@@ -93,9 +93,34 @@ public:
   static std::unique_ptr<ClipperLib::PolyTree> offsetToTree(
       const ClipperLib::Paths& paths, const Length& offset,
       const PositiveLength& maxArcTolerance);
+
+  /**
+   * @brief Remove vertices which do not contribute to the shape significantly
+   *
+   * Removes as many vertices as possible while keeping every point of the
+   * original outlines within the given tolerance of the simplified outlines
+   * (and vice versa). Paths which become degenerated by this (i.e. which are
+   * completely within the tolerance of a single line segment) are removed.
+   *
+   * @param paths       The paths to simplify. Must not contain cut-ins.
+   * @param tolerance   Maximum deviation of the simplified outlines.
+   */
+  static void simplify(ClipperLib::Paths& paths,
+                       const PositiveLength& tolerance);
   static ClipperLib::Paths treeToPaths(const ClipperLib::PolyTree& tree);
   static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
 
+  /**
+   * @brief Get the bounding rectangle of some paths
+   *
+   * @param paths   The paths to get the bounds from.
+   *
+   * @return The bounding rectangle. If there are no points at all, an
+   *         invalid rectangle (left > right) is returned.
+   */
+  static ClipperLib::IntRect getBounds(const ClipperLib::Paths& paths) noexcept;
+  static ClipperLib::IntRect getBounds(const ClipperLib::Path& path) noexcept;
+
   // Type Conversions
   static QVector<Path> convert(const ClipperLib::Paths& paths) noexcept;
   static Path convert(const ClipperLib::Path& path) noexcept;
@@ -105,9 +130,61 @@ public:
       const PositiveLength& maxArcTolerance) noexcept;
   static ClipperLib::Path convert(
       const Path& path, const PositiveLength& maxArcTolerance) noexcept;
+
+  /**
+   * @brief Convert a path into an existing Clipper path
+   *
+   * Arcs are flattened while converting, without creating a flattened copy
+   * of the whole path. The output is cleared first, thus its memory can be
+   * reused for converting many paths.
+   *
+   * @param path              The path to convert.
+   * @param maxArcTolerance   Maximum tolerance when flattening arcs.
+   * @param out               The converted path is written to here.
+   */
+  static void convert(const Path& path, const PositiveLength& maxArcTolerance,
+                      ClipperLib::Path& out) noexcept;
+
+  /**
+   * @brief Convert the outline strokes of a path to Clipper paths
+   *
+   * Same as converting the result of ::librepcb::Path::toOutlineStrokes(),
+   * but without creating the intermediate list of paths.
+   *
+   * @param path              The stroked path (e.g. a trace).
+   * @param width             The stroke width.
+   * @param maxArcTolerance   Maximum tolerance when flattening arcs.
+   *
+   * @return One area per stroke segment (to be united with pftNonZero).
+   */
+  static ClipperLib::Paths convertStrokes(
+      const Path& path, const PositiveLength& width,
+      const PositiveLength& maxArcTolerance) noexcept;
   static ClipperLib::IntPoint convert(const Point& point) noexcept;
 
 private:  // Internal Helper Methods
+  /**
+   * @brief Get the cleared Clipper engine of the current thread
+   *
+   * The engines are reused for all operations of a thread to avoid
+   * constructing them for each of the many small operations (e.g. in the
+   * DRC). Each operation must be completed before the next one acquires the
+   * engine, and the caller shall clear it with a scope guard after use to
+   * not keep stale paths in it if an exception is thrown.
+   */
+  static ClipperLib::Clipper& clipper() noexcept;
+  static ClipperLib::ClipperOffset& clipperOffset(
+      const PositiveLength& maxArcTolerance) noexcept;
+  static void simplify(ClipperLib::Path& path, qreal tolerance);
+  static qreal getDistanceToSegment(const ClipperLib::IntPoint& p,
+                                    const ClipperLib::IntPoint& p1,
+                                    const ClipperLib::IntPoint& p2) noexcept;
+  template <typename T>
+  static void execute(ClipperLib::Clipper& c, ClipperLib::ClipType type,
+                      T& solution, ClipperLib::PolyFillType subjectFillType,
+                      ClipperLib::PolyFillType clipFillType);
+  static void flattenTree(const ClipperLib::PolyNode& node,
+                          ClipperLib::Paths& paths);
   static ClipperLib::Path convertHolesToCutIns(const ClipperLib::Path& outline,
                                                const ClipperLib::Paths& holes);
   static ClipperLib::Paths prepareHoles(
@@ -118,6 +195,15 @@ private:  // Internal Helper Methods
                              const ClipperLib::Path& hole);
   static int insertConnectionPointToPath(ClipperLib::Path& path,
                                          const ClipperLib::IntPoint& p);
+
+  /**
+   * @brief Check whether the bounding rectangles of two areas overlap
+   *
+   * Used to skip expensive boolean operations which cannot have any result.
+   * Empty areas never overlap anything.
+   */
+  static bool boundsOverlap(const ClipperLib::Paths& a,
+                            const ClipperLib::Paths& b) noexcept;
   static bool calcIntersectionPos(const ClipperLib::IntPoint& p1,
                                   const ClipperLib::IntPoint& p2,
                                   const ClipperLib::cInt& x,
@@ -0,0 +1,58 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "concurrency.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+QAtomicInt Concurrency::sMaxThreadCount(0);
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+int Concurrency::getMaxThreadCount() noexcept {
+  const int count = sMaxThreadCount.loadAcquire();
+  return (count > 0) ? count : std::max(QThread::idealThreadCount(), 1);
+}
+
+void Concurrency::setMaxThreadCount(int count) noexcept {
+  sMaxThreadCount.storeRelease(std::max(count, 0));
+  apply(*QThreadPool::globalInstance());
+}
+
+void Concurrency::apply(QThreadPool& pool) noexcept {
+  pool.setMaxThreadCount(getMaxThreadCount());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
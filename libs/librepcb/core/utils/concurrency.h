@@ -0,0 +1,146 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_CONCURRENCY_H
+#define LIBREPCB_CORE_CONCURRENCY_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "scopeguard.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class Concurrency
+ ******************************************************************************/
+
+/**
+ * @brief Application-wide limit of worker threads per thread pool
+ *
+ * Background work is either executed in the global thread pool
+ * (`QtConcurrent::run()` without explicit pool) or in local thread pools
+ * which wait for their workers on destruction. Each of these pools would
+ * create as many threads as there are CPU cores, so this class provides a
+ * single, application-wide thread limit which is applied to the global pool
+ * by #setMaxThreadCount() and to local pools by #apply().
+ *
+ * @note The limit applies to each pool separately, it is not a limit of the
+ *       total number of threads. Operations which run their own local pool
+ *       from within workers of another pool (e.g. a STEP export started by an
+ *       output job) may use up to the product of both limits. The workers of
+ *       such an outer pool are blocked while waiting for the inner pool, thus
+ *       they do not compete for the CPU. A single shared pool is not used
+ *       since waiting for nested work in the same pool could deadlock.
+ *
+ * The limit is set from the `--jobs` option of the command line interface
+ * and from the workspace settings of the GUI application.
+ */
+class Concurrency final {
+public:
+  // Types
+
+  /**
+   * @brief Functor waiting for all futures of a container
+   *
+   * See #waitOnScopeExit().
+   */
+  template <typename T>
+  struct FuturesWaiter {
+    T* futures;
+
+    void operator()() const noexcept {
+      for (auto& future : *futures) {
+        try {
+          future.waitForFinished();
+        } catch (...) {
+        }
+      }
+    }
+  };
+
+  // Constructors / Destructor
+  Concurrency() = delete;
+  Concurrency(const Concurrency& other) = delete;
+  ~Concurrency() = delete;
+
+  // Static Methods
+
+  /**
+   * @brief Get the current thread limit
+   *
+   * @return Maximum number of worker threads per thread pool (at least 1).
+   */
+  static int getMaxThreadCount() noexcept;
+
+  /**
+   * @brief Set the thread limit
+   *
+   * Also applies the limit to the global thread pool immediately.
+   *
+   * @param count   Maximum number of worker threads, or 0 to use the number
+   *                of CPU cores (the default).
+   */
+  static void setMaxThreadCount(int count) noexcept;
+
+  /**
+   * @brief Apply the thread limit to a local thread pool
+   *
+   * @param pool    The thread pool to limit.
+   */
+  static void apply(QThreadPool& pool) noexcept;
+
+  /**
+   * @brief Create a scope guard waiting for futures when leaving the scope
+   *
+   * Workers usually access variables of the scope which started them, so
+   * this scope must not be left before all of them have finished, even if an
+   * exception is thrown. Exceptions of the workers are ignored by the guard,
+   * they have to be handled by evaluating the futures.
+   *
+   * @param futures   Container of futures (e.g. `QVector<QFuture<void>>`) to
+   *                  wait for. Futures added after creating the guard are
+   *                  taken into account too.
+   *
+   * @return The scope guard, to be kept until the end of the scope.
+   */
+  template <typename T>
+  static ScopeGuard<FuturesWaiter<T>> waitOnScopeExit(T& futures) noexcept {
+    return scopeGuard(FuturesWaiter<T>{&futures});
+  }
+
+  // Operator Overloadings
+  Concurrency& operator=(const Concurrency& rhs) = delete;
+
+private:  // Data
+  static QAtomicInt sMaxThreadCount;  ///< 0 = number of CPU cores
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_DISJOINTSET_H
+#define LIBREPCB_CORE_DISJOINTSET_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class DisjointSet
+ ******************************************************************************/
+
+/**
+ * @brief Union-find data structure to group items into connected sets
+ *
+ * Items are identified by an index in the range [0, count). Initially, every
+ * item is in its own set. With path halving and union by size, any sequence
+ * of #unite() and #find() calls runs in nearly linear time (O(n α(n))).
+ */
+class DisjointSet final {
+public:
+  // Constructors / Destructor
+  DisjointSet() = delete;
+  explicit DisjointSet(int count) noexcept : mParents(count), mSizes(count, 1) {
+    for (int i = 0; i < count; ++i) {
+      mParents[i] = i;
+    }
+  }
+  DisjointSet(const DisjointSet& other) = default;
+  ~DisjointSet() noexcept {}
+
+  // General Methods
+
+  /**
+   * @brief Get the representative item of the set containing an item
+   *
+   * @param index   Index of the item.
+   *
+   * @return Index of the representative, which is the same for all items of
+   *         the same set.
+   */
+  int find(int index) noexcept {
+    while (mParents.at(index) != index) {
+      mParents[index] = mParents.at(mParents.at(index));
+      index = mParents.at(index);
+    }
+    return index;
+  }
+
+  /**
+   * @brief Merge the sets containing two items
+   *
+   * @param a       Index of the first item.
+   * @param b       Index of the second item.
+   */
+  void unite(int a, int b) noexcept {
+    a = find(a);
+    b = find(b);
+    if (a != b) {
+      if (mSizes.at(a) < mSizes.at(b)) {
+        std::swap(a, b);
+      }
+      mParents[b] = a;
+      mSizes[a] += mSizes.at(b);
+    }
+  }
+
+  // Operator Overloadings
+  DisjointSet& operator=(const DisjointSet& rhs) = default;
+
+private:  // Data
+  QVector<int> mParents;
+  QVector<int> mSizes;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -58,8 +58,12 @@ QString MessageLogger::Message::toRichText(bool colored,
  *  Constructors / Destructor
  ******************************************************************************/
 
-MessageLogger::MessageLogger(bool record, QObject* parent) noexcept
-  : QObject(parent), mMutex(QMutex::Recursive), mParent(), mRecord(record) {
+MessageLogger::MessageLogger(bool record, QObject* parent, bool print) noexcept
+  : QObject(parent),
+    mMutex(QMutex::Recursive),
+    mParent(),
+    mRecord(record),
+    mPrint(print) {
 }
 
 MessageLogger::MessageLogger(MessageLogger* parentLogger, const QString& group,
@@ -67,7 +71,8 @@ MessageLogger::MessageLogger(MessageLogger* parentLogger, const QString& group,
   : QObject(parent),
     mMutex(QMutex::Recursive),
     mParent(parentLogger),
-    mRecord(record) {
+    mRecord(record),
+    mPrint(true) {
   if (!group.isEmpty()) {
     mPrefix = "[" % group % "] ";
   }
@@ -123,7 +128,7 @@ void MessageLogger::log(QtMsgType type, const QString& msg) noexcept {
   QMutexLocker lock(&mMutex);
   if (mParent) {
     mParent->log(type, mPrefix % msg);
-  } else {
+  } else if (mPrint) {
     qt_message_output(type, QMessageLogContext(), msg);
   }
   const Message obj{type, msg};
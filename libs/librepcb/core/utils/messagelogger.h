@@ -56,8 +56,16 @@ public:
 
   /**
    * @brief (Default) construdtor creating a top-level logger
+   *
+   * @param record  Whether messages shall be recorded or not.
+   * @param parent  Parent QObject.
+   * @param print   Whether messages shall be passed to the Qt message handler
+   *                or not. Disable it for loggers which only collect messages
+   *                to be passed to another logger later (e.g. in worker
+   *                threads), otherwise these messages would be printed twice.
    */
-  MessageLogger(bool record = true, QObject* parent = nullptr) noexcept;
+  MessageLogger(bool record = true, QObject* parent = nullptr,
+                bool print = true) noexcept;
 
   /**
    * @brief Constructor for a (conditionally) child logger
@@ -102,6 +110,7 @@ private:  // Data
   QPointer<MessageLogger> mParent;
   QString mPrefix;
   bool mRecord;
+  bool mPrint;
   QList<Message> mMessages;
 };
 
@@ -0,0 +1,153 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "polygoncontainmentindex.h"
+
+#include "../geometry/path.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+PolygonContainmentIndex::PolygonContainmentIndex(
+    const QVector<Vertex>& vertices) noexcept
+  : mBounds{1, 1, 0, 0},
+    mBandHeight(1),
+    mEdges(),
+    mBandOffsets(),
+    mBandEdges() {
+  // Arcs are not supported, thus flatten them if there are any (usually
+  // there are none since the polygons are created by Clipper).
+  QVector<Point> points;
+  points.reserve(vertices.count());
+  const Path path(vertices);
+  if (path.isCurved()) {
+    for (const Vertex& v :
+         path.flattenedArcs(PositiveLength(5000)).getVertices()) {
+      points.append(v.getPos());
+    }
+  } else {
+    for (const Vertex& v : vertices) {
+      points.append(v.getPos());
+    }
+  }
+  if (points.isEmpty()) {
+    return;
+  }
+
+  // Determine the bounding rectangle and the non-horizontal edges.
+  const Point& first = points.first();
+  mBounds = ClipperLib::IntRect{first.getX().toNm(), first.getY().toNm(),
+                                first.getX().toNm(), first.getY().toNm()};
+  mEdges.reserve(points.count());
+  for (int i = 0; i < points.count(); ++i) {
+    const Point& p1 = points.at(i);
+    const Point& p2 = points.at((i + 1) % points.count());
+    mBounds.left = std::min(mBounds.left, p1.getX().toNm());
+    mBounds.top = std::min(mBounds.top, p1.getY().toNm());
+    mBounds.right = std::max(mBounds.right, p1.getX().toNm());
+    mBounds.bottom = std::max(mBounds.bottom, p1.getY().toNm());
+    if (p1.getY() != p2.getY()) {
+      mEdges.append(Edge{p1.getX().toNm(), p1.getY().toNm(), p2.getX().toNm(),
+                         p2.getY().toNm()});
+    }
+  }
+
+  // Sort the edges into bands. About sqrt(n) bands give a good tradeoff
+  // between the memory required and the number of edges per band.
+  const int bandCount = qBound(
+      1, static_cast<int>(std::sqrt(static_cast<qreal>(mEdges.count()))), 4096);
+  mBandHeight = std::max((mBounds.bottom - mBounds.top) / bandCount + 1,
+                         static_cast<qint64>(1));
+  auto bandRange = [this](const Edge& edge) {
+    return std::make_pair(
+        (std::min(edge.y1, edge.y2) - mBounds.top) / mBandHeight,
+        (std::max(edge.y1, edge.y2) - mBounds.top) / mBandHeight);
+  };
+  mBandOffsets.fill(0, bandCount + 1);
+  for (const Edge& edge : mEdges) {
+    const auto range = bandRange(edge);
+    for (qint64 band = range.first; band <= range.second; ++band) {
+      ++mBandOffsets[band + 1];
+    }
+  }
+  for (int i = 1; i < mBandOffsets.count(); ++i) {
+    mBandOffsets[i] += mBandOffsets[i - 1];
+  }
+  mBandEdges.resize(mBandOffsets.last());
+  QVector<int> fill = mBandOffsets;
+  for (int i = 0; i < mEdges.count(); ++i) {
+    const auto range = bandRange(mEdges.at(i));
+    for (qint64 band = range.first; band <= range.second; ++band) {
+      mBandEdges[fill[band]++] = i;
+    }
+  }
+}
+
+PolygonContainmentIndex::~PolygonContainmentIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool PolygonContainmentIndex::contains(const Point& point) const noexcept {
+  const qint64 x = point.getX().toNm();
+  const qint64 y = point.getY().toNm();
+  if ((x < mBounds.left) || (x > mBounds.right) || (y < mBounds.top) ||
+      (y > mBounds.bottom)) {
+    return false;
+  }
+
+  // Crossing number test with a ray in positive x direction. Each edge is
+  // treated as half-open in y direction to count shared vertices only once.
+  const int band = (y - mBounds.top) / mBandHeight;
+  bool inside = false;
+  for (int i = mBandOffsets.at(band); i < mBandOffsets.at(band + 1); ++i) {
+    const Edge& edge = mEdges.at(mBandEdges.at(i));
+    if ((edge.y1 > y) != (edge.y2 > y)) {
+      const qreal crossingX = edge.x1 +
+          static_cast<qreal>(y - edge.y1) * (edge.x2 - edge.x1) /
+              (edge.y2 - edge.y1);
+      if (x < crossingX) {
+        inside = !inside;
+      }
+    }
+  }
+  return inside;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
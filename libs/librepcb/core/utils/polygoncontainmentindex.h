@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_POLYGONCONTAINMENTINDEX_H
+#define LIBREPCB_CORE_POLYGONCONTAINMENTINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../geometry/vertex.h"
+#include "../types/point.h"
+
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class PolygonContainmentIndex
+ ******************************************************************************/
+
+/**
+ * @brief Fast point-in-polygon tests for large polygons
+ *
+ * The edges of the polygon are sorted into horizontal bands once on
+ * construction, so a containment test only needs to evaluate the few edges
+ * within the band of the tested point instead of all edges of the polygon.
+ * This is intended for huge polygons like plane fragments which are tested
+ * against many points (e.g. when determining the airwires of a net).
+ *
+ * The polygon is implicitly closed and the even-odd rule is applied, i.e. the
+ * result is the same as for `QPainterPath::contains()`, except for points
+ * exactly on the outline.
+ */
+class PolygonContainmentIndex final {
+public:
+  // Constructors / Destructor
+  PolygonContainmentIndex() = delete;
+  PolygonContainmentIndex(const PolygonContainmentIndex& other) = default;
+  explicit PolygonContainmentIndex(const QVector<Vertex>& vertices) noexcept;
+  ~PolygonContainmentIndex() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Get the bounding rectangle of the polygon
+   *
+   * @return The bounding rectangle (invalid if there are no vertices).
+   */
+  const ClipperLib::IntRect& getBounds() const noexcept { return mBounds; }
+
+  // General Methods
+
+  /**
+   * @brief Check if a point is located inside the polygon
+   *
+   * @param point   The point to check.
+   *
+   * @return Whether the point is inside or not.
+   */
+  bool contains(const Point& point) const noexcept;
+
+  // Operator Overloadings
+  PolygonContainmentIndex& operator=(const PolygonContainmentIndex& rhs) =
+      default;
+
+private:  // Types
+  struct Edge {
+    qint64 x1;
+    qint64 y1;
+    qint64 x2;
+    qint64 y2;
+  };
+
+private:  // Data
+  ClipperLib::IntRect mBounds;
+  qint64 mBandHeight;
+  QVector<Edge> mEdges;  ///< Without horizontal edges
+  QVector<int> mBandOffsets;  ///< Start of each band in #mBandEdges
+  QVector<int> mBandEdges;  ///< Edge indices, sorted by band
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -26,6 +26,9 @@
 #include <QtCore>
 
 #include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -55,6 +58,11 @@ class Slot;
  *   - Always synchronous, no queued connections are possible
  *   - No endless loop detection
  *
+ * For bulk modifications, notifications can be deferred with
+ * ::librepcb::Signal::Deferrer to avoid calling all slots once per modified
+ * property. Deferred notifications with identical arguments are emitted only
+ * once.
+ *
  * @see ::librepcb::Slot
  *
  * @tparam Tsender  Type of the sender object
@@ -66,6 +74,38 @@ class Signal {
   friend class Slot<Tsender, Args...>;
 
 public:
+  /**
+   * @brief Scope guard to defer notifications of a signal
+   *
+   * As long as at least one deferrer of a signal exists, notifications are
+   * not emitted immediately but recorded. When the last deferrer is
+   * destroyed, all recorded notifications are emitted in their original
+   * order, but notifications with the same arguments as an earlier one are
+   * emitted only once.
+   *
+   * @warning Slots are called after the modifications are done, i.e. with the
+   *          state of the sender at the end of the scope. So this must only
+   *          be used for signals whose slots don't depend on the state at the
+   *          time of the original notification (e.g. list indices).
+   */
+  class Deferrer final {
+  public:
+    Deferrer() = delete;
+    Deferrer(const Deferrer& other) = delete;
+    explicit Deferrer(Signal& signal) noexcept : mSignal(signal) {
+      ++mSignal.mDeferCount;
+    }
+    ~Deferrer() noexcept {
+      if (--mSignal.mDeferCount == 0) {
+        mSignal.emitDeferred();
+      }
+    }
+    Deferrer& operator=(const Deferrer& rhs) = delete;
+
+  private:
+    Signal& mSignal;
+  };
+
   // Constructors / Destructor
   Signal() = delete;
   Signal(const Signal& other) = delete;
@@ -75,7 +115,8 @@ public:
    *
    * @param sender  Reference to the sender object of the signal
    */
-  explicit Signal(const Tsender& sender) noexcept : mSender(sender) {}
+  explicit Signal(const Tsender& sender) noexcept
+    : mSender(sender), mDeferCount(0), mDeferred() {}
 
   /**
    * @brief Destructor
@@ -121,6 +162,20 @@ public:
    * @param args  Arguments passed to the slots
    */
   void notify(Args... args) noexcept {
+    if (mDeferCount > 0) {
+      const ArgsTuple tuple = std::make_tuple(args...);
+      for (const auto& deferred : mDeferred) {
+        if (deferred.first == tuple) {
+          return;  // Already recorded.
+        }
+      }
+      mDeferred.append(
+          std::make_pair(tuple, std::function<void()>([this, args...]() {
+                           notify(args...);
+                         })));
+      return;
+    }
+
     // Note: A "foreach" loop with a Qt container first creates an implicitly
     // shared copy of the container (see
     // https://doc.qt.io/qt-5/containers.html#foreach). This is very important
@@ -140,8 +195,25 @@ public:
   Signal& operator=(Signal const& other) = delete;
 
 private:
+  typedef std::tuple<typename std::decay<Args>::type...> ArgsTuple;
+
+  void emitDeferred() noexcept {
+    // Note: Take the recorded notifications first since slots might trigger
+    // new notifications.
+    const QVector<std::pair<ArgsTuple, std::function<void()>>> deferred =
+        std::move(mDeferred);
+    mDeferred.clear();
+    for (const auto& pair : deferred) {
+      pair.second();
+    }
+  }
+
   const Tsender& mSender;  ///< Reference to the sender object
   mutable QSet<Slot<Tsender, Args...>*> mSlots;  ///< All attached slots
+  int mDeferCount;  ///< Number of active ::librepcb::Signal::Deferrer objects
+
+  /// Recorded notifications while deferred
+  QVector<std::pair<ArgsTuple, std::function<void()>>> mDeferred;
 };
 
 /*******************************************************************************
@@ -0,0 +1,188 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "spatialindex.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+constexpr int SpatialIndex::sNodeCapacity;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+SpatialIndex::SpatialIndex() noexcept
+  : mRects(), mNodes(), mChildren(), mRoot(-1) {
+}
+
+SpatialIndex::SpatialIndex(const QVector<ClipperLib::IntRect>& rects) noexcept
+  : mRects(rects), mNodes(), mChildren(), mRoot(-1) {
+  QVector<Entry> entries;
+  entries.reserve(mRects.count());
+  for (int i = 0; i < mRects.count(); ++i) {
+    if (isValid(mRects.at(i))) {
+      entries.append(Entry{mRects.at(i), i});
+    }
+  }
+
+  // Build the tree bottom-up until only the root node is left.
+  bool leaf = true;
+  while (!entries.isEmpty()) {
+    entries = pack(entries, leaf);
+    leaf = false;
+    if (entries.count() == 1) {
+      mRoot = entries.first().index;
+      break;
+    }
+  }
+}
+
+SpatialIndex::~SpatialIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QVector<int> SpatialIndex::query(
+    const ClipperLib::IntRect& rect) const noexcept {
+  QVector<int> result;
+  if ((mRoot < 0) || (!isValid(rect))) {
+    return result;
+  }
+
+  QVarLengthArray<int, 64> stack;
+  stack.append(mRoot);
+  while (!stack.isEmpty()) {
+    const Node& node = mNodes.at(stack.last());
+    stack.removeLast();
+    for (int i = node.firstChild; i < (node.firstChild + node.childCount);
+         ++i) {
+      const int child = mChildren.at(i);
+      if (node.leaf) {
+        if (intersects(mRects.at(child), rect)) {
+          result.append(child);
+        }
+      } else if (intersects(mNodes.at(child).bounds, rect)) {
+        stack.append(child);
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+QVector<std::pair<int, int>> SpatialIndex::findOverlappingPairs()
+    const noexcept {
+  QVector<std::pair<int, int>> pairs;
+  for (int i = 0; i < mRects.count(); ++i) {
+    foreach (int k, query(mRects.at(i))) {
+      if (k > i) {
+        pairs.append(std::make_pair(i, k));
+      }
+    }
+  }
+  return pairs;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+ClipperLib::IntRect SpatialIndex::united(
+    const ClipperLib::IntRect& a, const ClipperLib::IntRect& b) noexcept {
+  if (!isValid(a)) {
+    return b;
+  } else if (!isValid(b)) {
+    return a;
+  } else {
+    return ClipperLib::IntRect{
+        std::min(a.left, b.left), std::min(a.top, b.top),
+        std::max(a.right, b.right), std::max(a.bottom, b.bottom)};
+  }
+}
+
+ClipperLib::IntRect SpatialIndex::inflated(const ClipperLib::IntRect& rect,
+                                           ClipperLib::cInt offset) noexcept {
+  if (!isValid(rect)) {
+    return rect;
+  }
+  return ClipperLib::IntRect{rect.left - offset, rect.top - offset,
+                             rect.right + offset, rect.bottom + offset};
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QVector<SpatialIndex::Entry> SpatialIndex::pack(QVector<Entry> entries,
+                                                bool leaf) noexcept {
+  // Sort-Tile-Recursive: Sort by X, split into vertical slices, sort each
+  // slice by Y and group consecutive entries into nodes.
+  const int count = entries.count();
+  const int nodeCount = (count + sNodeCapacity - 1) / sNodeCapacity;
+  const int sliceCount = std::max(
+      static_cast<int>(std::ceil(std::sqrt(static_cast<qreal>(nodeCount)))),
+      1);
+  const int sliceSize = sliceCount * sNodeCapacity;
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return (a.rect.left + a.rect.right) <
+                  (b.rect.left + b.rect.right);
+            });
+
+  QVector<Entry> parents;
+  parents.reserve(nodeCount);
+  for (int sliceBegin = 0; sliceBegin < count; sliceBegin += sliceSize) {
+    const int sliceEnd = std::min(sliceBegin + sliceSize, count);
+    std::sort(entries.begin() + sliceBegin, entries.begin() + sliceEnd,
+              [](const Entry& a, const Entry& b) {
+                return (a.rect.top + a.rect.bottom) <
+                    (b.rect.top + b.rect.bottom);
+              });
+    for (int i = sliceBegin; i < sliceEnd; i += sNodeCapacity) {
+      const int end = std::min(i + sNodeCapacity, sliceEnd);
+      Node node{entries.at(i).rect, mChildren.count(), end - i, leaf};
+      for (int k = i; k < end; ++k) {
+        node.bounds = united(node.bounds, entries.at(k).rect);
+        mChildren.append(entries.at(k).index);
+      }
+      parents.append(Entry{node.bounds, mNodes.count()});
+      mNodes.append(node);
+    }
+  }
+  return parents;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
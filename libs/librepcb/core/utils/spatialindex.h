@@ -0,0 +1,137 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_SPATIALINDEX_H
+#define LIBREPCB_CORE_SPATIALINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+#include <utility>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class SpatialIndex
+ ******************************************************************************/
+
+/**
+ * @brief Static R-tree to quickly find overlapping bounding rectangles
+ *
+ * The tree is bulk-loaded once with the Sort-Tile-Recursive (STR) algorithm
+ * and cannot be modified afterwards. Items are identified by their index in
+ * the list of rectangles passed to the constructor. Invalid rectangles (left >
+ * right or top > bottom, e.g. from empty paths) are never reported as
+ * overlapping anything.
+ *
+ * This allows to reduce all-pairs checks (e.g. in the DRC) from O(n²) to
+ * roughly O(n log n) since only items with overlapping bounding rectangles
+ * need to be passed to the (expensive) exact geometry checks.
+ *
+ * @note Edges are inclusive, i.e. rectangles which only touch each other are
+ *       considered as overlapping.
+ */
+class SpatialIndex final {
+public:
+  // Constructors / Destructor
+  SpatialIndex() noexcept;
+  explicit SpatialIndex(const QVector<ClipperLib::IntRect>& rects) noexcept;
+  SpatialIndex(const SpatialIndex& other) = default;
+  ~SpatialIndex() noexcept;
+
+  // Getters
+  int getCount() const noexcept { return mRects.count(); }
+  const ClipperLib::IntRect& getRect(int index) const noexcept {
+    return mRects.at(index);
+  }
+
+  // General Methods
+
+  /**
+   * @brief Find all items overlapping a given rectangle
+   *
+   * @param rect    The rectangle to search for.
+   *
+   * @return Indices of all overlapping items, in ascending order.
+   */
+  QVector<int> query(const ClipperLib::IntRect& rect) const noexcept;
+
+  /**
+   * @brief Find all pairs of items which overlap each other
+   *
+   * @return All overlapping pairs (first < second), sorted in ascending order
+   *         to get deterministic results independent of the tree layout.
+   */
+  QVector<std::pair<int, int>> findOverlappingPairs() const noexcept;
+
+  // Static Methods
+  static bool isValid(const ClipperLib::IntRect& rect) noexcept {
+    return (rect.left <= rect.right) && (rect.top <= rect.bottom);
+  }
+  static bool intersects(const ClipperLib::IntRect& a,
+                         const ClipperLib::IntRect& b) noexcept {
+    return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+        (b.top <= a.bottom);
+  }
+  static ClipperLib::IntRect united(const ClipperLib::IntRect& a,
+                                    const ClipperLib::IntRect& b) noexcept;
+  static ClipperLib::IntRect inflated(const ClipperLib::IntRect& rect,
+                                      ClipperLib::cInt offset) noexcept;
+
+  // Operator Overloadings
+  SpatialIndex& operator=(const SpatialIndex& rhs) = default;
+
+private:  // Types
+  struct Node {
+    ClipperLib::IntRect bounds;
+    int firstChild;  ///< Index into #mChildren
+    int childCount;
+    bool leaf;  ///< If true, children are item indices, otherwise node indices
+  };
+  struct Entry {
+    ClipperLib::IntRect rect;
+    int index;
+  };
+
+private:  // Methods
+  QVector<Entry> pack(QVector<Entry> entries, bool leaf) noexcept;
+
+private:  // Data
+  static constexpr int sNodeCapacity = 16;
+
+  QVector<ClipperLib::IntRect> mRects;
+  QVector<Node> mNodes;
+  QVector<int> mChildren;
+  int mRoot;  ///< -1 if the tree is empty
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
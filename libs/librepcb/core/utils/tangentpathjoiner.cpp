@@ -117,12 +117,173 @@ QVector<Path> TangentPathJoiner::join(QVector<Path> paths, qint64 timeoutMs,
     }
   }
 
-  // Find all paths and sort by relevance.
-  QVector<Result> found;
+  // Build a graph with the path end points as nodes and the paths as edges,
+  // i.e. a hash map containing all paths starting at each point.
+  Graph graph;
+  for (int i = 0; i < paths.count(); ++i) {
+    graph[paths.at(i).getVertices().first().getPos()].append(
+        Segment{i, false});
+    graph[paths.at(i).getVertices().last().getPos()].append(Segment{i, true});
+  }
+
+  // Take the best closed paths until there are no more closed paths, then
+  // the best open paths until all paths are consumed.
+  QVector<bool> consumed(paths.count(), false);
+  int remaining = paths.count();
+  bool closed = true;
   QElapsedTimer timer;
   timer.start();
-  findAllPaths(found, paths, timer, timeoutMs, Result(), timedOut);
-  std::sort(found.begin(), found.end(),
+  while (remaining > 0) {
+    if ((timeoutMs >= 0) && (timer.elapsed() > timeoutMs)) {
+      qWarning() << "Tangent path joining algorithm aborted due to timeout.";
+      if (timedOut) *timedOut = true;
+      break;
+    }
+    QVector<Result> candidates = closed
+        ? findClosedPaths(paths, graph, consumed)
+        : findOpenPaths(paths, graph, consumed);
+    if (!candidates.isEmpty()) {
+      remaining -= takeBestPaths(result, candidates, paths, consumed);
+    } else if (closed) {
+      closed = false;
+    } else {
+      break;
+    }
+  }
+
+  // Return any remaining paths as-is (only in case of a timeout).
+  for (int i = 0; i < paths.count(); ++i) {
+    if (!consumed.at(i)) {
+      result.append(paths.at(i));
+    }
+  }
+
+  return result;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QVector<TangentPathJoiner::Result> TangentPathJoiner::findClosedPaths(
+    const QVector<Path>& paths, const Graph& graph,
+    const QVector<bool>& consumed) noexcept {
+  // For each pair of adjacent paths, search the shortest way back to the
+  // start point. If there is any closed path, at least one is found this way.
+  QVector<Result> result;
+  for (int i = 0; i < paths.count(); ++i) {
+    if (consumed.at(i)) {
+      continue;
+    }
+    for (bool reverse : {false, true}) {
+      Result first;
+      const Segment segment{i, reverse};
+      first.append(segment, getStartPos(paths, segment),
+                   getEndPos(paths, segment));
+      foreach (const Segment& next, graph.value(first.endPos)) {
+        if (consumed.at(next.index) || (next.index == i)) {
+          continue;
+        }
+        Result prefix = first;
+        prefix.append(next, first.endPos, getEndPos(paths, next));
+        if (tl::optional<Result> r =
+                closePath(paths, graph, consumed, prefix)) {
+          result.append(*r);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+tl::optional<TangentPathJoiner::Result> TangentPathJoiner::closePath(
+    const QVector<Path>& paths, const Graph& graph,
+    const QVector<bool>& consumed, const Result& prefix) noexcept {
+  if (prefix.isClosed()) {
+    return prefix;
+  }
+
+  // Breadth-first search, without passing any junction of the prefix.
+  QHash<Point, Segment> predecessors;
+  QSet<Point> visited = prefix.junctions;
+  QQueue<Point> queue;
+  queue.enqueue(prefix.endPos);
+  while (!queue.isEmpty()) {
+    const Point pos = queue.dequeue();
+    foreach (const Segment& segment, graph.value(pos)) {
+      if (consumed.at(segment.index) ||
+          prefix.indices.contains(segment.index)) {
+        continue;
+      }
+      const Point& end = getEndPos(paths, segment);
+      if (end == prefix.startPos) {
+        // Found the way back, collect the segments in reverse order.
+        QVector<Segment> segments = {segment};
+        for (Point p = pos; p != prefix.endPos;) {
+          const Segment s = predecessors.value(p);
+          segments.prepend(s);
+          p = getStartPos(paths, s);
+        }
+        Result r = prefix;
+        foreach (const Segment& s, segments) {
+          r.append(s, getStartPos(paths, s), getEndPos(paths, s));
+        }
+        return r;
+      } else if (!visited.contains(end)) {
+        visited.insert(end);
+        predecessors.insert(end, segment);
+        queue.enqueue(end);
+      }
+    }
+  }
+  return tl::nullopt;
+}
+
+QVector<TangentPathJoiner::Result> TangentPathJoiner::findOpenPaths(
+    const QVector<Path>& paths, const Graph& graph,
+    const QVector<bool>& consumed) noexcept {
+  QVector<qreal> lengths;
+  lengths.reserve(paths.count());
+  foreach (const Path& path, paths) {
+    lengths.append(path.getTotalStraightLength()->toMm());
+  }
+
+  // Starting from each path, follow the longest continuation at each junction.
+  QVector<Result> result;
+  for (int i = 0; i < paths.count(); ++i) {
+    if (consumed.at(i)) {
+      continue;
+    }
+    for (bool reverse : {false, true}) {
+      Result r;
+      Segment segment{i, reverse};
+      while (true) {
+        r.append(segment, getStartPos(paths, segment),
+                 getEndPos(paths, segment));
+        qreal nextLength = -1;
+        foreach (const Segment& next, graph.value(r.endPos)) {
+          if ((!consumed.at(next.index)) && (!r.indices.contains(next.index)) &&
+              (!r.junctions.contains(getEndPos(paths, next))) &&
+              (lengths.at(next.index) > nextLength)) {
+            segment = next;
+            nextLength = lengths.at(next.index);
+          }
+        }
+        if (nextLength < 0) {
+          break;
+        }
+      }
+      result.append(r);
+    }
+  }
+  return result;
+}
+
+int TangentPathJoiner::takeBestPaths(QVector<Path>& result,
+                                     QVector<Result>& candidates,
+                                     const QVector<Path>& paths,
+                                     QVector<bool>& consumed) noexcept {
+  std::sort(candidates.begin(), candidates.end(),
             [&paths](const Result& r1, const Result& r2) {
               // Prio 1: Closed paths
               if (r1.isClosed() != r2.isClosed()) {
@@ -154,60 +315,36 @@ QVector<Path> TangentPathJoiner::join(QVector<Path> paths, qint64 timeoutMs,
               return false;
             });
 
-  // Add found paths to result.
-  QSet<int> consumedIndices;
-  foreach (const auto& f, found) {
-    if ((f.indices & consumedIndices).isEmpty()) {
-      result.append(f.buildPath(paths));
-      consumedIndices.unite(f.indices);
-    }
-  }
-
-  return result;
-}
-
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
-
-void TangentPathJoiner::findAllPaths(QVector<Result>& result,
-                                     const QVector<Path>& paths,
-                                     const QElapsedTimer& timer,
-                                     qint64 timeoutMs, const Result& prefix,
-                                     bool* timedOut) noexcept {
-  for (int i = 0; i < paths.count(); ++i) {
-    if ((timeoutMs >= 0) && (timer.elapsed() > timeoutMs)) {
-      qWarning() << "Tangent path joining algorithm aborted due to timeout.";
-      if (timedOut) *timedOut = true;
-      break;
+  // Add all non-overlapping candidates to the result.
+  int count = 0;
+  foreach (const Result& candidate, candidates) {
+    bool overlapping = false;
+    foreach (int index, candidate.indices) {
+      overlapping = overlapping || consumed.at(index);
     }
-    if (!prefix.indices.contains(i)) {
-      for (bool reverse : {false, true}) {
-        if (tl::optional<Result> r = join(paths, prefix, i, reverse)) {
-          result.append(*r);
-          if (!r->isClosed()) {
-            findAllPaths(result, paths, timer, timeoutMs, *r);
-          }
-        }
+    if (!overlapping) {
+      result.append(candidate.buildPath(paths));
+      foreach (int index, candidate.indices) {
+        consumed[index] = true;
       }
+      count += candidate.indices.count();
     }
   }
+  return count;
 }
 
-tl::optional<TangentPathJoiner::Result> TangentPathJoiner::join(
-    const QVector<Path>& paths, const Result& prefix, int index,
-    bool reverse) noexcept {
-  const Path& path = paths.at(index);
-  const Point& start = reverse ? path.getVertices().last().getPos()
-                               : path.getVertices().first().getPos();
-  const Point& end = reverse ? path.getVertices().first().getPos()
-                             : path.getVertices().last().getPos();
-  if ((prefix.segments.isEmpty() || (start == prefix.endPos)) &&
-      (!prefix.junctions.contains(end))) {
-    return prefix.sub(index, reverse, start, end);
-  } else {
-    return tl::nullopt;
-  }
+const Point& TangentPathJoiner::getStartPos(const QVector<Path>& paths,
+                                            const Segment& segment) noexcept {
+  const Path& path = paths.at(segment.index);
+  return segment.reverse ? path.getVertices().last().getPos()
+                         : path.getVertices().first().getPos();
+}
+
+const Point& TangentPathJoiner::getEndPos(const QVector<Path>& paths,
+                                          const Segment& segment) noexcept {
+  const Path& path = paths.at(segment.index);
+  return segment.reverse ? path.getVertices().first().getPos()
+                         : path.getVertices().last().getPos();
 }
 
 /*******************************************************************************
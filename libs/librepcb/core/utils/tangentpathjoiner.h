@@ -45,14 +45,20 @@ namespace librepcb {
  *
  *   - Invalid paths (less than 2 vertices) are removed.
  *   - Any already closed path is returned as-is.
- *   - Any joined, closed paths are searched, starting with the longest path.
- *   - Then joined, open paths are searched, starting with the longest path.
+ *   - Any joined, closed paths are searched, preferring large areas.
+ *   - Then joined, open paths are searched, preferring long paths.
  *   - Any remaining (non tangent) paths are returned as-is.
  *
- * @note If there are many possible solutions (many paths located at the same
- *       coordinate), finding the solution can take a lot of time. Therefore
- *       a timeout can be specified to abort a too long operation, then a non-
- *       optimal (but still valid) result is returned.
+ * The paths are treated as edges of a graph whose nodes are the path end
+ * points. Closed paths are found with a breadth-first search from each pair
+ * of adjacent edges back to the start point, open paths by greedily
+ * following the longest continuation at each node. The best candidates of
+ * each step are taken, so the runtime is polynomial and no exhaustive search
+ * over all combinations is needed.
+ *
+ * @note The timeout is only a safety net for huge, strongly interconnected
+ *       inputs. If it expires, the already joined paths and all remaining
+ *       paths as-is are returned, which is still a valid result.
  */
 class TangentPathJoiner {
   Q_DECLARE_TR_FUNCTIONS(TangentPathJoiner)
@@ -106,17 +112,15 @@ private:
       return lengthAreaCache;
     }
 
-    Result sub(int index, bool reverse, const Point& start,
-               const Point& end) const {
-      Result r(*this);
-      r.segments.append(Segment{index, reverse});
-      r.indices.insert(index);
-      r.junctions.insert(end);
-      if (segments.isEmpty()) {
-        r.startPos = start;
+    void append(const Segment& segment, const Point& start,
+                const Point& end) {
+      segments.append(segment);
+      indices.insert(segment.index);
+      junctions.insert(end);
+      if (segments.count() == 1) {
+        startPos = start;
       }
-      r.endPos = end;
-      return r;
+      endPos = end;
     }
 
     Path buildPath(const QVector<Path>& paths) const {
@@ -135,14 +139,25 @@ private:
     }
   };
 
-  static void findAllPaths(QVector<Result>& result, const QVector<Path>& paths,
-                           const QElapsedTimer& timer, qint64 timeoutMs,
-                           const Result& prefix = Result(),
-                           bool* timedOut = nullptr) noexcept;
-
-  static tl::optional<Result> join(const QVector<Path>& paths,
-                                   const Result& prefix, int index,
-                                   bool reverse) noexcept;
+  typedef QHash<Point, QVector<Segment>> Graph;
+
+  static QVector<Result> findClosedPaths(
+      const QVector<Path>& paths, const Graph& graph,
+      const QVector<bool>& consumed) noexcept;
+  static tl::optional<Result> closePath(const QVector<Path>& paths,
+                                        const Graph& graph,
+                                        const QVector<bool>& consumed,
+                                        const Result& prefix) noexcept;
+  static QVector<Result> findOpenPaths(const QVector<Path>& paths,
+                                       const Graph& graph,
+                                       const QVector<bool>& consumed) noexcept;
+  static int takeBestPaths(QVector<Path>& result, QVector<Result>& candidates,
+                           const QVector<Path>& paths,
+                           QVector<bool>& consumed) noexcept;
+  static const Point& getStartPos(const QVector<Path>& paths,
+                                  const Segment& segment) noexcept;
+  static const Point& getEndPos(const QVector<Path>& paths,
+                                const Segment& segment) noexcept;
 };
 
 /*******************************************************************************
@@ -267,10 +267,65 @@ QString Toolbox::prettyPrintLocale(const QString& code) noexcept {
   return str;
 }
 
+void Toolbox::appendInteger(QByteArray& output, qint64 value) noexcept {
+  char buffer[24];  // Enough for 20 digits plus sign.
+  char* const end = buffer + sizeof(buffer);
+  char* p = end;
+  quint64 valueAbs = (value < 0) ? (quint64(0) - static_cast<quint64>(value))
+                                 : static_cast<quint64>(value);
+  do {
+    *--p = static_cast<char>('0' + (valueAbs % 10));
+    valueAbs /= 10;
+  } while (valueAbs != 0);
+  if (value < 0) {
+    *--p = '-';
+  }
+  output.append(p, static_cast<int>(end - p));
+}
+
+void Toolbox::appendDecimalFixedPoint(QByteArray& output, qint64 value,
+                                      int pointPos) noexcept {
+  char buffer[sDecimalFixedPointBufferSize];
+  int length = 0;
+  const char* str =
+      formatDecimalFixedPoint(buffer + sizeof(buffer), value, pointPos, length);
+  output.append(str, length);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+const char* Toolbox::formatDecimalFixedPoint(char* end, qint64 value,
+                                             int pointPos,
+                                             int& length) noexcept {
+  Q_ASSERT((pointPos > 0) && (pointPos <= 20));
+  char* p = end;
+  quint64 valueAbs = (value < 0) ? (quint64(0) - static_cast<quint64>(value))
+                                 : static_cast<quint64>(value);
+  for (int i = 0; i < pointPos; ++i) {
+    *--p = static_cast<char>('0' + (valueAbs % 10));
+    valueAbs /= 10;
+  }
+  char* const point = --p;
+  *point = '.';
+  do {
+    *--p = static_cast<char>('0' + (valueAbs % 10));
+    valueAbs /= 10;
+  } while (valueAbs != 0);
+  if (value < 0) {
+    *--p = '-';
+  }
+
+  // Remove trailing zeros, but keep at least one decimal digit.
+  const char* last = end;
+  while (((last - point) > 2) && (*(last - 1) == '0')) {
+    --last;
+  }
+  length = static_cast<int>(last - p);
+  return p;
+}
+
 QStringList Toolbox::expandRangesInString(
     const QString& input,
     const QVector<std::tuple<int, int, QStringList>>& replacements) noexcept {
@@ -335,34 +335,14 @@ public:
    */
   template <typename T>
   static QString decimalFixedPointToString(T value, qint32 pointPos) noexcept {
-    using UnsignedT = typename std::make_unsigned<T>::type;
-
-    if (value == 0) {
-      // special case
-      return "0.0";
-    }
-
-    UnsignedT valueAbs;
-    if (value < 0) {
-      valueAbs = -static_cast<UnsignedT>(value);
-    } else {
-      valueAbs = static_cast<UnsignedT>(value);
-    }
-
-    QString str = QString::number(valueAbs);
-    if (str.length() > pointPos) {
-      // pointPos must be > 0 for this to work correctly
-      str.insert(str.length() - pointPos, '.');
-    } else {
-      for (qint32 i = pointPos - str.length(); i != 0; i--) str.insert(0, '0');
-      str.insert(0, "0.");
-    }
-
-    while (str.endsWith('0') && !str.endsWith(".0")) str.chop(1);
-
-    if (value < 0) str.insert(0, '-');
-
-    return str;
+    static_assert(std::is_signed<T>::value && (sizeof(T) <= sizeof(qint64)),
+                  "Only signed integers up to 64 bits are supported.");
+    // Formatted on the stack to allocate only the returned string.
+    char buffer[sDecimalFixedPointBufferSize];
+    int length = 0;
+    const char* str = formatDecimalFixedPoint(
+        buffer + sizeof(buffer), static_cast<qint64>(value), pointPos, length);
+    return QString::fromLatin1(str, length);
   }
 
   /**
@@ -629,7 +609,53 @@ public:
     return result;
   }
 
+  /**
+   * @brief Append an integer in decimal representation to a byte array
+   *
+   * Same output as QString::number(), but without any temporary string
+   * objects. Intended for hot code paths like the Gerber export.
+   *
+   * @param output   Byte array to append the number to.
+   * @param value    Value to append.
+   */
+  static void appendInteger(QByteArray& output, qint64 value) noexcept;
+
+  /**
+   * @brief Append a fixed point decimal number to a byte array
+   *
+   * Same output as #decimalFixedPointToString(), but without any temporary
+   * string objects. Intended for hot code paths like the Excellon export.
+   *
+   * @param output   Byte array to append the number to.
+   * @param value    Value to append.
+   * @param pointPos Number of fixed point decimal positions (1..20).
+   */
+  static void appendDecimalFixedPoint(QByteArray& output, qint64 value,
+                                      int pointPos) noexcept;
+
 private:
+  /**
+   * @brief Format a fixed point decimal number into a character buffer
+   *
+   * Internal helper for #decimalFixedPointToString() and
+   * #appendDecimalFixedPoint(). The number is written backwards, i.e. it
+   * ends at `end`, and is not null-terminated.
+   *
+   * @param end      End of the buffer, which must have a size of at least
+   *                 #sDecimalFixedPointBufferSize.
+   * @param value    Value to format.
+   * @param pointPos Number of fixed point decimal positions (1..20).
+   * @param length   Returns the length of the formatted number.
+   *
+   * @return Begin of the formatted number.
+   */
+  static const char* formatDecimalFixedPoint(char* end, qint64 value,
+                                             int pointPos,
+                                             int& length) noexcept;
+
+  /// Enough for 20 integer digits, 20 decimal digits, sign and point
+  static constexpr int sDecimalFixedPointBufferSize = 48;
+
   /**
    * @brief Internal helper function for #expandRangesInString(const QString&)
    */
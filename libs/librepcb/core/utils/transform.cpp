@@ -57,17 +57,20 @@ Point Transform::map(const Point& point) const noexcept {
 }
 
 Path Transform::map(const Path& path) const noexcept {
-  Path p = path;
-  if (mMirrored) {
-    p.mirror(Qt::Horizontal);
-  }
-  if (mRotation) {
-    p.rotate(mRotation);
-  }
-  if (!mPosition.isOrigin()) {
-    p.translate(mPosition);
+  return map(Path(path));
+}
+
+Path Transform::map(Path&& path) const noexcept {
+  // Transform all vertices in a single pass.
+  if (mMirrored || mRotation || (!mPosition.isOrigin())) {
+    for (Vertex& vertex : path.getVertices()) {
+      vertex.setPos(map(vertex.getPos()));
+      if (mMirrored) {
+        vertex.setAngle(-vertex.getAngle());
+      }
+    }
   }
-  return p;
+  return std::move(path);
 }
 
 NonEmptyPath Transform::map(const NonEmptyPath& path) const noexcept {
@@ -165,6 +165,17 @@ public:
    */
   Path map(const Path& path) const noexcept;
 
+  /**
+   * @brief Map a given path to the transformed coordinate system in place
+   *
+   * Same as #map(const Path&) const, but reuses the vertices of the passed
+   * temporary path instead of copying them.
+   *
+   * @param path  The path to map.
+   * @return The mapped path.
+   */
+  Path map(Path&& path) const noexcept;
+
   /**
    * @brief Map a given path to the transformed coordinate system
    *
@@ -197,7 +208,7 @@ public:
   T map(const T& container) const noexcept {
     T copy = container;
     for (auto& item : copy) {
-      item = map(item);
+      item = map(std::move(item));
     }
     return copy;
   }
@@ -132,6 +132,17 @@ Workspace::Workspace(const FilePath& wsPath, const QString& dataDirName,
 Workspace::~Workspace() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+FilePath Workspace::getProjectThumbnailFilePath(
+    const FilePath& projectDir) const {
+  const QByteArray hash = QCryptographicHash::hash(
+      projectDir.toStr().toUtf8(), QCryptographicHash::Md5);
+  return mDataPath.getPathTo("thumbnails/" % hash.toHex() % ".png");
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -116,6 +116,19 @@ public:
     return mLibrariesPath.getPathTo("remote");
   }
 
+  /**
+   * @brief Get the filepath to the thumbnail image of a project
+   *
+   * Thumbnails are rendered when closing a saved project and stored in the
+   * "data/thumbnails" directory to allow showing previews without opening
+   * the project. Note that the file does not exist if no thumbnail was saved.
+   *
+   * @param projectDir  Directory of the project.
+   *
+   * @return The filepath to the PNG file (might not exist).
+   */
+  FilePath getProjectThumbnailFilePath(const FilePath& projectDir) const;
+
   /**
    * @brief Get the workspace settings
    */
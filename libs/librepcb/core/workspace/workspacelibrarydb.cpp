@@ -27,6 +27,7 @@
 #include "../attribute/attributeunit.h"
 #include "../exceptions.h"
 #include "../fileio/filepath.h"
+#include "../fileio/fileutils.h"
 #include "../library/cat/componentcategory.h"
 #include "../library/cat/packagecategory.h"
 #include "../library/cmp/component.h"
@@ -60,7 +61,8 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
   : QObject(nullptr),
     mLibrariesPath(librariesPath),
     mFilePath(mLibrariesPath.getPathTo(
-        QString("cache_v%1.sqlite").arg(sCurrentDbVersion))) {
+        QString("cache_v%1.sqlite").arg(sCurrentDbVersion))),
+    mHasSearchIndex(false) {
   qDebug("Load workspace library database...");
 
   // open SQLite database
@@ -81,6 +83,21 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
     writer.addInternalData("version", sCurrentDbVersion);  // can throw
   }
 
+  // The full-text search index is created only if supported by SQLite.
+  {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT name FROM sqlite_master "
+        "WHERE type = 'table' AND name = 'symbols_tr_fts'");
+    mDb->exec(query);  // can throw
+    mHasSearchIndex = query.next();
+  }
+
+  // Clear cached query results as soon as a scan has modified the database.
+  // Note: This must be the first connection to this signal to make sure all
+  // other receivers already get the new data.
+  connect(this, &WorkspaceLibraryDb::scanSucceeded, this,
+          &WorkspaceLibraryDb::clearCache);
+
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mLibrariesPath, mFilePath));
   connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanStarted, this,
@@ -97,10 +114,24 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
   connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanFinished, this,
           &WorkspaceLibraryDb::scanFinished, Qt::QueuedConnection);
 
+  // Rescan libraries shortly after the last modification reported by the
+  // file system watcher (if enabled), and update the watched directories
+  // after each scan since libraries might have been added.
+  mRescanTimer.setSingleShot(true);
+  mRescanTimer.setInterval(500);
+  connect(&mRescanTimer, &QTimer::timeout, this,
+          &WorkspaceLibraryDb::startLibraryRescan);
+  connect(this, &WorkspaceLibraryDb::scanFinished, this,
+          &WorkspaceLibraryDb::updateWatchedDirectories);
+
   qDebug("Successfully loaded workspace library database.");
 }
 
 WorkspaceLibraryDb::~WorkspaceLibraryDb() noexcept {
+  // Note: Queries of other threads must not be running anymore at this point.
+  QMutexLocker lock(&mReadConnectionsMutex);
+  qDeleteAll(mReadConnections);
+  mReadConnections.clear();
 }
 
 /*******************************************************************************
@@ -114,21 +145,21 @@ int WorkspaceLibraryDb::getScanProgressPercent() const noexcept {
 template <>
 QList<Uuid> WorkspaceLibraryDb::find<Package>(const QString& keyword) const {
   // ATTENTION: Keep SQL in sync with the generig find() method below!
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT packages.uuid FROM packages "
       "LEFT JOIN packages_tr "
       "ON packages.id = packages_tr.element_id "
       "LEFT JOIN packages_alt "
       "ON packages.id = packages_alt.package_id "
-      "WHERE packages_tr.name LIKE :escapedKeyword "
-      "OR packages_tr.keywords LIKE :escapedKeyword "
-      "OR packages_alt.name LIKE :escapedKeyword "
-      "OR packages.uuid = :keyword "
+      "WHERE " %
+      getSearchCondition("packages_tr", {"name", "keywords"}, keyword) %
+      " OR " % getSearchCondition("packages_alt", {"name"}, keyword) %
+      " OR packages.uuid = :keyword "
       "GROUP BY packages.uuid "
       "ORDER BY packages_tr.name ASC");
   query.bindValue(":keyword", keyword);
-  query.bindValue(":escapedKeyword", "%" + keyword + "%");
-  mDb->exec(query);
+  bindSearchKeyword(query, keyword);
+  getDb().exec(query);
 
   QList<Uuid> uuids;
   while (query.next()) {
@@ -139,18 +170,18 @@ QList<Uuid> WorkspaceLibraryDb::find<Package>(const QString& keyword) const {
 
 QList<Uuid> WorkspaceLibraryDb::findDevicesOfParts(
     const QString& keyword) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT devices.uuid FROM devices "
       "LEFT JOIN parts "
       "ON devices.id = parts.device_id "
       "LEFT JOIN devices_tr "
       "ON devices.id = devices_tr.element_id "
-      "WHERE parts.manufacturer LIKE :keyword "
-      "OR parts.mpn LIKE :keyword "
-      "GROUP BY devices.uuid "
+      "WHERE " %
+      getSearchCondition("parts", {"manufacturer", "mpn"}, keyword) %
+      " GROUP BY devices.uuid "
       "ORDER BY devices_tr.name ASC");
-  query.bindValue(":keyword", "%" + keyword + "%");
-  mDb->exec(query);
+  bindSearchKeyword(query, keyword);
+  getDb().exec(query);
 
   QList<Uuid> uuids;
   while (query.next()) {
@@ -161,9 +192,10 @@ QList<Uuid> WorkspaceLibraryDb::findDevicesOfParts(
 
 QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::findPartsOfDevice(
     const Uuid& device, const QString& keyword) const {
-  SQLiteDatabase::TransactionScopeGuard sg(*mDb);  // Atomic attributes query!
+  // Atomic attributes query!
+  SQLiteDatabase::TransactionScopeGuard sg(getDb());
 
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT parts.id, mpn, manufacturer FROM parts "
       "LEFT JOIN devices "
       "ON devices.id = parts.device_id "
@@ -171,7 +203,7 @@ QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::findPartsOfDevice(
       "AND (parts.mpn LIKE :keyword OR parts.manufacturer LIKE :keyword)");
   query.bindValue(":device", device.toStr());
   query.bindValue(":keyword", "%" + keyword + "%");
-  mDb->exec(query);
+  getDb().exec(query);
 
   QSet<Part> parts;
   while (query.next()) {
@@ -184,12 +216,12 @@ QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::findPartsOfDevice(
 bool WorkspaceLibraryDb::getLibraryMetadata(const FilePath libDir,
                                             QPixmap* icon,
                                             QString* manufacturer) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT icon_png, manufacturer FROM libraries "
       "WHERE filepath = :filepath "
       "LIMIT 1");
   query.bindValue(":filepath", libDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (!query.next()) {
     qWarning() << "Library not found in database:" << libDir.toStr();
@@ -207,12 +239,12 @@ bool WorkspaceLibraryDb::getLibraryMetadata(const FilePath libDir,
 
 bool WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir,
                                            Uuid* cmpUuid, Uuid* pkgUuid) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT component_uuid, package_uuid FROM devices "
       "WHERE filepath = :filepath "
       "LIMIT 1");
   query.bindValue(":filepath", devDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (!query.next()) {
     qWarning() << "Device not found in database:" << devDir.toStr();
@@ -234,25 +266,26 @@ bool WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir,
 
 QSet<Uuid> WorkspaceLibraryDb::getComponentDevices(
     const Uuid& component) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT uuid FROM devices "
       "WHERE component_uuid = :uuid "
       "GROUP BY uuid");
   query.bindValue(":uuid", component.toStr());
-  mDb->exec(query);
+  getDb().exec(query);
   return getUuidSet(query);
 }
 
 QList<WorkspaceLibraryDb::Part> WorkspaceLibraryDb::getDeviceParts(
     const Uuid& device) const {
-  SQLiteDatabase::TransactionScopeGuard sg(*mDb);  // Atomic attributes query!
+  // Atomic attributes query!
+  SQLiteDatabase::TransactionScopeGuard sg(getDb());
 
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT parts.id, mpn, manufacturer FROM parts "
       "LEFT JOIN devices ON devices.id = parts.device_id "
       "WHERE devices.uuid = :device");
   query.bindValue(":device", device.toStr());
-  mDb->exec(query);
+  getDb().exec(query);
 
   QSet<Part> parts;
   while (query.next()) {
@@ -270,10 +303,103 @@ void WorkspaceLibraryDb::startLibraryRescan() noexcept {
   mLibraryScanner->startScan();
 }
 
+void WorkspaceLibraryDb::setWatchingEnabled(bool enabled) noexcept {
+  if (enabled && (!mWatcher)) {
+    mWatcher.reset(new QFileSystemWatcher());
+    connect(mWatcher.data(), &QFileSystemWatcher::directoryChanged, this,
+            &WorkspaceLibraryDb::watchedDirectoryChanged);
+    updateWatchedDirectories();
+  } else if ((!enabled) && mWatcher) {
+    mWatcher.reset();
+    mWatchedEntries.clear();
+    mRescanTimer.stop();
+  }
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+void WorkspaceLibraryDb::updateWatchedDirectories() noexcept {
+  if (!mWatcher) {
+    return;
+  }
+
+  const QStringList elementDirNames = {
+      ComponentCategory::getShortElementName(),
+      PackageCategory::getShortElementName(),
+      Symbol::getShortElementName(),
+      Package::getShortElementName(),
+      Component::getShortElementName(),
+      Device::getShortElementName(),
+  };
+  QSet<QString> dirs;
+  for (const QString& root : {QString("local"), QString("remote")}) {
+    const FilePath rootDir = mLibrariesPath.getPathTo(root);
+    if (!rootDir.isExistingDir()) {
+      continue;
+    }
+    dirs.insert(rootDir.toStr());
+    foreach (const FilePath& libDir, FileUtils::findDirectories(rootDir)) {
+      dirs.insert(libDir.toStr());
+      foreach (const QString& elementDirName, elementDirNames) {
+        const FilePath elementsDir = libDir.getPathTo(elementDirName);
+        if (!elementsDir.isExistingDir()) {
+          continue;
+        }
+        dirs.insert(elementsDir.toStr());
+      }
+    }
+  }
+
+  // Only add or remove the paths which have changed since the last update
+  // to not discard pending modifications of still watched directories.
+  const QSet<QString> watchedDirs = mWatcher->directories().toSet();
+  const QStringList removedDirs = (watchedDirs - dirs).toList();
+  const QStringList addedDirs = (dirs - watchedDirs).toList();
+  if (!removedDirs.isEmpty()) {
+    mWatcher->removePaths(removedDirs);
+    foreach (const QString& dir, removedDirs) {
+      mWatchedEntries.remove(dir);
+    }
+  }
+  if (!addedDirs.isEmpty()) {
+    foreach (const QString& dir, addedDirs) {
+      mWatchedEntries.insert(dir, getWatchedEntries(dir));
+    }
+    const QStringList failedDirs = mWatcher->addPaths(addedDirs);
+    if (!failedDirs.isEmpty()) {
+      qWarning() << "Failed to watch" << failedDirs.count()
+                 << "library directories for modifications.";
+    }
+  }
+}
+
+void WorkspaceLibraryDb::watchedDirectoryChanged(const QString& dir) noexcept {
+  // The watcher also reports modifications which are irrelevant for the
+  // library scan (e.g. lock files or autosave backups created by the library
+  // editor), so only start a rescan if the relevant entries have changed.
+  const QStringList entries = getWatchedEntries(dir);
+  auto it = mWatchedEntries.find(dir);
+  if ((it == mWatchedEntries.end()) || (*it != entries)) {
+    mWatchedEntries.insert(dir, entries);
+    mRescanTimer.start();
+  }
+}
+
+QStringList WorkspaceLibraryDb::getWatchedEntries(const QString& dir) noexcept {
+  QStringList entries;
+  foreach (const QString& name,
+           QDir(dir).entryList(
+               QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot,
+               QDir::Name)) {
+    if (!name.startsWith(".")) {
+      entries.append(name);
+    }
+  }
+  return entries;
+}
+
 QMultiMap<Version, FilePath> WorkspaceLibraryDb::getAll(
     const QString& elementsTable, const tl::optional<Uuid>& uuid,
     const FilePath& lib) const {
@@ -299,14 +425,14 @@ QMultiMap<Version, FilePath> WorkspaceLibraryDb::getAll(
     sql += "WHERE " % conditions.join(" AND ") % " ";
   }
 
-  QSqlQuery query = mDb->prepareQuery(sql, {{"%elements", elementsTable}});
+  QSqlQuery query = getDb().prepareQuery(sql, {{"%elements", elementsTable}});
   if (uuid) {
     query.bindValue(":uuid", uuid->toStr());
   }
   if (lib.isValid()) {
     query.bindValue(":filepath", lib.toRelative(mLibrariesPath));
   }
-  mDb->exec(query);
+  getDb().exec(query);
 
   QMultiMap<Version, FilePath> elements;
   while (query.next()) {
@@ -334,21 +460,22 @@ FilePath WorkspaceLibraryDb::getLatestVersionFilePath(
 QList<Uuid> WorkspaceLibraryDb::find(const QString& elementsTable,
                                      const QString& keyword) const {
   // ATTENTION: Keep SQL in sync with the find<Package>() method above!
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT %elements.uuid FROM %elements "
       "LEFT JOIN %elements_tr "
       "ON %elements.id = %elements_tr.element_id "
-      "WHERE %elements_tr.name LIKE :escapedKeyword "
-      "OR %elements_tr.keywords LIKE :escapedKeyword "
-      "OR %elements.uuid = :keyword "
-      "GROUP BY %elements.uuid "
-      "ORDER BY %elements_tr.name ASC",
+      "WHERE " %
+          getSearchCondition(elementsTable % "_tr", {"name", "keywords"},
+                             keyword) %
+          " OR %elements.uuid = :keyword "
+          "GROUP BY %elements.uuid "
+          "ORDER BY %elements_tr.name ASC",
       {
           {"%elements", elementsTable},
       });
   query.bindValue(":keyword", keyword);
-  query.bindValue(":escapedKeyword", "%" + keyword + "%");
-  mDb->exec(query);
+  bindSearchKeyword(query, keyword);
+  getDb().exec(query);
 
   QList<Uuid> uuids;
   while (query.next()) {
@@ -362,74 +489,159 @@ bool WorkspaceLibraryDb::getTranslations(const QString& elementsTable,
                                          const QStringList& localeOrder,
                                          QString* name, QString* description,
                                          QString* keywords) const {
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT locale, name, description, keywords FROM %elements_tr "
-      "INNER JOIN %elements "
-      "ON %elements.id = %elements_tr.element_id "
-      "WHERE %elements.filepath = :filepath",
-      {
-          {"%elements", elementsTable},
-      });
-  query.bindValue(":filepath", elemDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  const QString elemPath = elemDir.toRelative(mLibrariesPath);
+  const QString cacheKey = elementsTable % "|" % elemPath;
+  QMutexLocker cacheLock(&mCacheMutex);
+  auto it = mCachedTranslations.find(cacheKey);
+  if (it == mCachedTranslations.end()) {
+    cacheLock.unlock();
+    QSqlQuery query = getDb().prepareQuery(
+        "SELECT locale, name, description, keywords FROM %elements_tr "
+        "INNER JOIN %elements "
+        "ON %elements.id = %elements_tr.element_id "
+        "WHERE %elements.filepath = :filepath",
+        {
+            {"%elements", elementsTable},
+        });
+    query.bindValue(":filepath", elemPath);
+    getDb().exec(query);
+
+    QVector<CachedTranslation> translations;
+    while (query.next()) {
+      translations.append(CachedTranslation{
+          query.value(0).toString(), query.value(1).toString(),
+          query.value(2).toString(), query.value(3).toString()});
+    }
+    cacheLock.relock();
+    it = mCachedTranslations.insert(cacheKey, translations);
+  }
+  const QVector<CachedTranslation> translations = *it;
+  cacheLock.unlock();
 
   // Using LocalizedDescriptionMap for all values since it allows empty strings
   // (in contrast to LocalizedNameMap, which is more restrictive).
   LocalizedDescriptionMap nameMap(QString{});
   LocalizedDescriptionMap descriptionMap(QString{});
   LocalizedDescriptionMap keywordsMap(QString{});
-  bool elementFound = false;
-  while (query.next()) {
-    elementFound = true;
-    QString locale = query.value(0).toString();
-    QString name = query.value(1).toString();
-    QString description = query.value(2).toString();
-    QString keywords = query.value(3).toString();
-    if (!name.isNull()) nameMap.insert(locale, name);
-    if (!description.isNull()) descriptionMap.insert(locale, description);
-    if (!keywords.isNull()) keywordsMap.insert(locale, keywords);
+  foreach (const CachedTranslation& tr, translations) {
+    if (!tr.name.isNull()) nameMap.insert(tr.locale, tr.name);
+    if (!tr.description.isNull()) {
+      descriptionMap.insert(tr.locale, tr.description);
+    }
+    if (!tr.keywords.isNull()) keywordsMap.insert(tr.locale, tr.keywords);
   }
 
   if (name) *name = nameMap.value(localeOrder);
   if (description) *description = descriptionMap.value(localeOrder);
   if (keywords) *keywords = keywordsMap.value(localeOrder);
-  return elementFound;
+  return !translations.isEmpty();
 }
 
 bool WorkspaceLibraryDb::getMetadata(const QString& elementsTable,
                                      const FilePath elemDir, Uuid* uuid,
                                      Version* version, bool* deprecated) const {
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT uuid, version, deprecated FROM %elements "
-      "WHERE filepath = :filepath "
-      "LIMIT 1",
-      {
-          {"%elements", elementsTable},
-      });
-  query.bindValue(":filepath", elemDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  const QString elemPath = elemDir.toRelative(mLibrariesPath);
+  const QString cacheKey = elementsTable % "|" % elemPath;
+  QMutexLocker cacheLock(&mCacheMutex);
+  auto it = mCachedMetadata.find(cacheKey);
+  if (it == mCachedMetadata.end()) {
+    cacheLock.unlock();
+    QSqlQuery query = getDb().prepareQuery(
+        "SELECT uuid, version, deprecated FROM %elements "
+        "WHERE filepath = :filepath "
+        "LIMIT 1",
+        {
+            {"%elements", elementsTable},
+        });
+    query.bindValue(":filepath", elemPath);
+    getDb().exec(query);
+
+    CachedMetadata metadata{false, QString(), QString(), false};
+    if (query.next()) {
+      metadata.found = true;
+      metadata.uuid = query.value(0).toString();
+      metadata.version = query.value(1).toString();
+      metadata.deprecated = query.value(2).toBool();
+    }
+    cacheLock.relock();
+    it = mCachedMetadata.insert(cacheKey, metadata);
+  }
+  const CachedMetadata metadata = *it;
+  cacheLock.unlock();
 
-  if (!query.next()) {
+  if (!metadata.found) {
     qWarning() << "Element not found in database:" << elemDir.toStr();
     return false;
   }
 
   if (uuid) {
-    *uuid = Uuid::fromString(query.value(0).toString());  // can throw
+    *uuid = Uuid::fromString(metadata.uuid);  // can throw
   }
   if (version) {
-    *version = Version::fromString(query.value(1).toString());  // can throw
+    *version = Version::fromString(metadata.version);  // can throw
   }
   if (deprecated) {
-    *deprecated = query.value(2).toBool();
+    *deprecated = metadata.deprecated;
   }
   return true;
 }
 
+void WorkspaceLibraryDb::preloadMetadata(const QString& elementsTable,
+                                         const FilePath& lib) const {
+  const QString libPath = lib.toRelative(mLibrariesPath);
+  QHash<QString, CachedMetadata> metadata;
+  QHash<QString, QVector<CachedTranslation>> translations;
+
+  QSqlQuery query = getDb().prepareQuery(
+      "SELECT %elements.filepath, %elements.uuid, %elements.version, "
+      "%elements.deprecated FROM %elements "
+      "INNER JOIN libraries ON %elements.library_id = libraries.id "
+      "WHERE libraries.filepath = :filepath",
+      {
+          {"%elements", elementsTable},
+      });
+  query.bindValue(":filepath", libPath);
+  getDb().exec(query);
+  while (query.next()) {
+    const QString cacheKey = elementsTable % "|" % query.value(0).toString();
+    metadata.insert(cacheKey,
+                    CachedMetadata{true, query.value(1).toString(),
+                                   query.value(2).toString(),
+                                   query.value(3).toBool()});
+    translations.insert(cacheKey, {});  // Elements might have no translation.
+  }
+
+  query = getDb().prepareQuery(
+      "SELECT %elements.filepath, %elements_tr.locale, %elements_tr.name, "
+      "%elements_tr.description, %elements_tr.keywords FROM %elements_tr "
+      "INNER JOIN %elements ON %elements.id = %elements_tr.element_id "
+      "INNER JOIN libraries ON %elements.library_id = libraries.id "
+      "WHERE libraries.filepath = :filepath",
+      {
+          {"%elements", elementsTable},
+      });
+  query.bindValue(":filepath", libPath);
+  getDb().exec(query);
+  while (query.next()) {
+    const QString cacheKey = elementsTable % "|" % query.value(0).toString();
+    translations[cacheKey].append(CachedTranslation{
+        query.value(1).toString(), query.value(2).toString(),
+        query.value(3).toString(), query.value(4).toString()});
+  }
+
+  QMutexLocker cacheLock(&mCacheMutex);
+  for (auto it = metadata.begin(); it != metadata.end(); ++it) {
+    mCachedMetadata.insert(it.key(), it.value());
+  }
+  for (auto it = translations.begin(); it != translations.end(); ++it) {
+    mCachedTranslations.insert(it.key(), it.value());
+  }
+}
+
 bool WorkspaceLibraryDb::getCategoryMetadata(const QString& categoriesTable,
                                              const FilePath catDir,
                                              tl::optional<Uuid>* parent) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT parent_uuid FROM %categories "
       "WHERE filepath = :filepath "
       "LIMIT 1",
@@ -437,7 +649,7 @@ bool WorkspaceLibraryDb::getCategoryMetadata(const QString& categoriesTable,
           {"%categories", categoriesTable},
       });
   query.bindValue(":filepath", catDir.toRelative(mLibrariesPath));
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (!query.next()) {
     qWarning() << "Category not found in database:" << catDir.toStr();
@@ -450,12 +662,36 @@ bool WorkspaceLibraryDb::getCategoryMetadata(const QString& categoriesTable,
   return true;
 }
 
+QList<WorkspaceLibraryDb::CheckMessage> WorkspaceLibraryDb::getCheckMessages(
+    const QString& elementsTable, const FilePath& elemDir) const {
+  QSqlQuery query = getDb().prepareQuery(
+      "SELECT %elements_msg.severity, %elements_msg.message "
+      "FROM %elements_msg "
+      "INNER JOIN %elements ON %elements.id = %elements_msg.element_id "
+      "WHERE %elements.filepath = :filepath "
+      "ORDER BY %elements_msg.severity DESC, %elements_msg.id ASC",
+      {
+          {"%elements", elementsTable},
+      });
+  query.bindValue(":filepath", elemDir.toRelative(mLibrariesPath));
+  getDb().exec(query);
+
+  QList<CheckMessage> messages;
+  while (query.next()) {
+    messages.append(CheckMessage{
+        static_cast<RuleCheckMessage::Severity>(query.value(0).toInt()),
+        query.value(1).toString(),
+    });
+  }
+  return messages;
+}
+
 AttributeList WorkspaceLibraryDb::getPartAttributes(int partId) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT key, type, value, unit FROM parts_attr "
       "WHERE part_id = :part_id");
   query.bindValue(":part_id", partId);
-  mDb->exec(query);
+  getDb().exec(query);
 
   AttributeList attributes;
   while (query.next()) {
@@ -473,19 +709,29 @@ AttributeList WorkspaceLibraryDb::getPartAttributes(int partId) const {
 QSet<Uuid> WorkspaceLibraryDb::getChilds(
     const QString& categoriesTable,
     const tl::optional<Uuid>& categoryUuid) const {
+  const QString cacheKey = categoriesTable % "|" %
+      (categoryUuid ? categoryUuid->toStr() : QString());
+  {
+    QMutexLocker cacheLock(&mCacheMutex);
+    auto it = mCachedChilds.constFind(cacheKey);
+    if (it != mCachedChilds.constEnd()) {
+      return *it;
+    }
+  }
+
   QSqlQuery query;
   SQLiteDatabase::Replacements replacements = {
       {"%categories", categoriesTable},
   };
   if (categoryUuid) {
-    query = mDb->prepareQuery(
+    query = getDb().prepareQuery(
         "SELECT uuid FROM %categories "
         "WHERE parent_uuid = :category_uuid "
         "GROUP BY uuid",
         replacements);
     query.bindValue(":category_uuid", categoryUuid->toStr());
   } else {
-    query = mDb->prepareQuery(
+    query = getDb().prepareQuery(
         "SELECT children.uuid FROM %categories AS children "
         "LEFT JOIN %categories AS parents "
         "ON children.parent_uuid = parents.uuid "
@@ -493,14 +739,27 @@ QSet<Uuid> WorkspaceLibraryDb::getChilds(
         "GROUP BY children.uuid",
         replacements);
   }
-  mDb->exec(query);
-  return getUuidSet(query);
+  getDb().exec(query);
+  const QSet<Uuid> uuids = getUuidSet(query);  // can throw
+  QMutexLocker cacheLock(&mCacheMutex);
+  mCachedChilds.insert(cacheKey, uuids);
+  return uuids;
 }
 
 QSet<Uuid> WorkspaceLibraryDb::getByCategory(const QString& elementsTable,
                                              const QString& categoryTable,
                                              const tl::optional<Uuid>& category,
                                              int limit) const {
+  const QString cacheKey = elementsTable % "|" %
+      (category ? category->toStr() : QString()) % "|" % QString::number(limit);
+  {
+    QMutexLocker cacheLock(&mCacheMutex);
+    auto it = mCachedByCategory.constFind(cacheKey);
+    if (it != mCachedByCategory.constEnd()) {
+      return *it;
+    }
+  }
+
   QSqlQuery query;
   SQLiteDatabase::Replacements replacements = {
       {"%elements", elementsTable},
@@ -508,7 +767,7 @@ QSet<Uuid> WorkspaceLibraryDb::getByCategory(const QString& elementsTable,
   };
   if (category) {
     // Find all elements assigned to the specified category.
-    query = mDb->prepareQuery(
+    query = getDb().prepareQuery(
         "SELECT %elements.uuid FROM %elements "
         "INNER JOIN %elements_cat "
         "ON %elements.id = %elements_cat.element_id "
@@ -519,7 +778,7 @@ QSet<Uuid> WorkspaceLibraryDb::getByCategory(const QString& elementsTable,
     query.bindValue(":uuid", category->toStr());
   } else {
     // Find all elements with no (existent) category.
-    query = mDb->prepareQuery(
+    query = getDb().prepareQuery(
         "SELECT %elements.uuid FROM %elements "
         "LEFT JOIN %elements_cat "
         "ON %elements.id = %elements_cat.element_id "
@@ -531,8 +790,44 @@ QSet<Uuid> WorkspaceLibraryDb::getByCategory(const QString& elementsTable,
         replacements);
   }
   query.bindValue(":limit", limit);
-  mDb->exec(query);
-  return getUuidSet(query);
+  getDb().exec(query);
+  const QSet<Uuid> uuids = getUuidSet(query);  // can throw
+  QMutexLocker cacheLock(&mCacheMutex);
+  mCachedByCategory.insert(cacheKey, uuids);
+  return uuids;
+}
+
+void WorkspaceLibraryDb::clearCache() noexcept {
+  QMutexLocker cacheLock(&mCacheMutex);
+  mCachedTranslations.clear();
+  mCachedMetadata.clear();
+  mCachedChilds.clear();
+  mCachedByCategory.clear();
+}
+
+SQLiteDatabase& WorkspaceLibraryDb::getDb() const {
+  QThread* thread = QThread::currentThread();
+  if (thread == this->thread()) {
+    return *mDb;
+  }
+
+  // The connections must only be used (and closed) within their own thread,
+  // thus they are removed as soon as the thread finishes.
+  QMutexLocker lock(&mReadConnectionsMutex);
+  SQLiteDatabase* db = mReadConnections.value(thread, nullptr);
+  if (!db) {
+    db = new SQLiteDatabase(mFilePath,
+                            SQLiteDatabase::Mode::ReadOnly);  // can throw
+    mReadConnections.insert(thread, db);
+    connect(
+        thread, &QThread::finished, this,
+        [this, thread]() {
+          QMutexLocker lock(&mReadConnectionsMutex);
+          delete mReadConnections.take(thread);
+        },
+        Qt::DirectConnection);
+  }
+  return *db;
 }
 
 QSet<Uuid> WorkspaceLibraryDb::getUuidSet(QSqlQuery& query) {
@@ -543,6 +838,40 @@ QSet<Uuid> WorkspaceLibraryDb::getUuidSet(QSqlQuery& query) {
   return uuids;
 }
 
+bool WorkspaceLibraryDb::useSearchIndex(const QString& keyword) const noexcept {
+  // The trigram tokenizer can't match keywords shorter than 3 characters.
+  return mHasSearchIndex && (keyword.toUcs4().count() >= 3);
+}
+
+QString WorkspaceLibraryDb::getSearchCondition(
+    const QString& table, const QStringList& columns,
+    const QString& keyword) const noexcept {
+  if (useSearchIndex(keyword)) {
+    return QString(
+               "%1.id IN (SELECT rowid FROM %1_fts "
+               "WHERE %1_fts MATCH :searchPhrase)")
+        .arg(table);
+  } else {
+    QStringList conditions;
+    foreach (const QString& column, columns) {
+      conditions.append(table % "." % column % " LIKE :escapedKeyword");
+    }
+    return "(" % conditions.join(" OR ") % ")";
+  }
+}
+
+void WorkspaceLibraryDb::bindSearchKeyword(
+    QSqlQuery& query, const QString& keyword) const noexcept {
+  if (useSearchIndex(keyword)) {
+    // Search the keyword as a single phrase in all indexed columns.
+    QString phrase = keyword;
+    phrase.replace("\"", "\"\"");
+    query.bindValue(":searchPhrase", "\"" % phrase % "\"");
+  } else {
+    query.bindValue(":escapedKeyword", "%" + keyword + "%");
+  }
+}
+
 int WorkspaceLibraryDb::getDbVersion() const noexcept {
   try {
     QSqlQuery query = mDb->prepareQuery(
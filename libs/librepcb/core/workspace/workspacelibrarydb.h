@@ -26,6 +26,7 @@
 #include "../attribute/attribute.h"
 #include "../attribute/attributetype.h"
 #include "../fileio/filepath.h"
+#include "../rulecheck/rulecheckmessage.h"
 #include "../types/uuid.h"
 #include "../types/version.h"
 
@@ -41,6 +42,7 @@ namespace librepcb {
 class Component;
 class ComponentCategory;
 class Device;
+class Library;
 class Package;
 class PackageCategory;
 class SQLiteDatabase;
@@ -53,6 +55,11 @@ class WorkspaceLibraryScanner;
 
 /**
  * @brief The WorkspaceLibraryDb class
+ *
+ * All getters are thread-safe. Queries from the thread which created the
+ * object use the main database connection, queries from other threads (e.g.
+ * background searches) use a read-only connection per thread which is
+ * opened on first use and closed when the thread finishes.
  */
 class WorkspaceLibraryDb final : public QObject {
   Q_OBJECT
@@ -101,6 +108,12 @@ public:
     }
   };
 
+  /// Non-approved message of the checks of a library element
+  struct CheckMessage {
+    RuleCheckMessage::Severity severity;
+    QString message;
+  };
+
   // Constructors / Destructor
   WorkspaceLibraryDb() = delete;
   WorkspaceLibraryDb(const WorkspaceLibraryDb& other) = delete;
@@ -263,6 +276,23 @@ public:
                        deprecated);
   }
 
+  /**
+   * @brief Load metadata and translations of all elements of a library
+   *
+   * Fetches the data returned by #getMetadata() and #getTranslations() for
+   * all elements of the given type within a library with only two queries
+   * and stores it in the cache. This avoids several queries per element when
+   * calling these methods for all elements of a (large) library afterwards.
+   *
+   * @tparam ElementType  Type of the library elements.
+   *
+   * @param lib           Library directory.
+   */
+  template <typename ElementType>
+  void preloadMetadata(const FilePath& lib) const {
+    preloadMetadata(getTable<ElementType>(), lib);
+  }
+
   /**
    * @brief Get additional metadata of a specific library
    *
@@ -315,6 +345,31 @@ public:
   bool getDeviceMetadata(const FilePath& devDir, Uuid* cmpUuid = nullptr,
                          Uuid* pkgUuid = nullptr) const;
 
+  /**
+   * @brief Get the check messages of a specific element
+   *
+   * The checks of the library elements are run by the library scanner each
+   * time an element was added or modified, so the results are available
+   * without opening the element. Approved messages are not included.
+   *
+   * The messages are translated into the application language of the last
+   * scan. After changing the language, all elements are checked again with
+   * the next scan.
+   *
+   * @tparam ElementType  Type of the library element (not Library).
+   *
+   * @param elemDir       Library element directory.
+   *
+   * @return All non-approved messages, sorted by severity (highest first).
+   *         Empty if there are no messages or the element was not found.
+   */
+  template <typename ElementType>
+  QList<CheckMessage> getCheckMessages(const FilePath& elemDir) const {
+    static_assert(!std::is_same<ElementType, Library>::value,
+                  "Unsupported ElementType");
+    return getCheckMessages(getTable<ElementType>(), elemDir);
+  }
+
   /**
    * @brief Get children categories of a specific category
    *
@@ -390,6 +445,25 @@ public:
    */
   void startLibraryRescan() noexcept;
 
+  /**
+   * @brief Enable or disable watching the library directories
+   *
+   * If enabled, adding or removing libraries and library elements (e.g. by
+   * git or scripts) automatically triggers a rescan shortly after the last
+   * modification. Since the scanner only re-reads modified elements, such a
+   * rescan is cheap.
+   *
+   * Only the libraries directories and the element type directories of each
+   * library are watched, thus only added, removed or renamed entries are
+   * detected. Modified files of existing elements are not detected since
+   * watching every element would exceed the limits of some operating
+   * systems, a rescan has to be started manually for them. Hidden entries
+   * like lock files or autosave backups are ignored.
+   *
+   * @param enabled   Whether the directories should be watched or not.
+   */
+  void setWatchingEnabled(bool enabled) noexcept;
+
   // Operator Overloadings
   WorkspaceLibraryDb& operator=(const WorkspaceLibraryDb& rhs) = delete;
 
@@ -402,6 +476,20 @@ signals:
   void scanFinished();
 
 private:
+  // Types
+  struct CachedTranslation {
+    QString locale;
+    QString name;
+    QString description;
+    QString keywords;
+  };
+  struct CachedMetadata {
+    bool found;
+    QString uuid;
+    QString version;
+    bool deprecated;
+  };
+
   // Private Methods
   QMultiMap<Version, FilePath> getAll(const QString& elementsTable,
                                       const tl::optional<Uuid>& uuid,
@@ -414,16 +502,34 @@ private:
                        QString* description, QString* keywords) const;
   bool getMetadata(const QString& elementsTable, const FilePath elemDir,
                    Uuid* uuid, Version* version, bool* deprecated) const;
+  void preloadMetadata(const QString& elementsTable,
+                       const FilePath& lib) const;
   bool getCategoryMetadata(const QString& categoriesTable,
                            const FilePath catDir,
                            tl::optional<Uuid>* parent) const;
+  QList<CheckMessage> getCheckMessages(const QString& elementsTable,
+                                       const FilePath& elemDir) const;
   AttributeList getPartAttributes(int partId) const;
   QSet<Uuid> getChilds(const QString& categoriesTable,
                        const tl::optional<Uuid>& categoryUuid) const;
   QSet<Uuid> getByCategory(const QString& elementsTable,
                            const QString& categoryTable,
                            const tl::optional<Uuid>& category, int limit) const;
+  void clearCache() noexcept;
+  void updateWatchedDirectories() noexcept;
+  void watchedDirectoryChanged(const QString& dir) noexcept;
+  static QStringList getWatchedEntries(const QString& dir) noexcept;
+
+  /**
+   * Returns the database connection to be used by the calling thread.
+   */
+  SQLiteDatabase& getDb() const;
   static QSet<Uuid> getUuidSet(QSqlQuery& query);
+  bool useSearchIndex(const QString& keyword) const noexcept;
+  QString getSearchCondition(const QString& table, const QStringList& columns,
+                             const QString& keyword) const noexcept;
+  void bindSearchKeyword(QSqlQuery& query,
+                         const QString& keyword) const noexcept;
   int getDbVersion() const noexcept;
   template <typename ElementType>
   static QString getTable() noexcept;
@@ -434,10 +540,23 @@ private:
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
   const FilePath mFilePath;  ///< Path to the SQLite database file.
   QScopedPointer<SQLiteDatabase> mDb;  ///< The SQLite database.
+  mutable QMutex mReadConnectionsMutex;
+  mutable QHash<QThread*, SQLiteDatabase*> mReadConnections;  ///< Per thread
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+  bool mHasSearchIndex;  ///< Whether the full-text search index exists.
+  QScopedPointer<QFileSystemWatcher> mWatcher;  ///< `nullptr` if disabled
+  QTimer mRescanTimer;  ///< Debounces modifications reported by #mWatcher
+  QHash<QString, QStringList> mWatchedEntries;  ///< Key: Watched directory
+
+  // Cached query results, cleared after each successful library scan.
+  mutable QMutex mCacheMutex;
+  mutable QHash<QString, QVector<CachedTranslation>> mCachedTranslations;
+  mutable QHash<QString, CachedMetadata> mCachedMetadata;
+  mutable QHash<QString, QSet<Uuid>> mCachedChilds;
+  mutable QHash<QString, QSet<Uuid>> mCachedByCategory;
 
   // Constants
-  static const int sCurrentDbVersion = 5;
+  static const int sCurrentDbVersion = 8;
 };
 
 /*******************************************************************************
@@ -106,7 +106,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
-      "`parent_uuid` TEXT"
+      "`parent_uuid` TEXT, "
+      "`files_modified` INTEGER, "
+      "`files_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS component_categories_tr ("
@@ -129,7 +131,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
-      "`parent_uuid` TEXT"
+      "`parent_uuid` TEXT, "
+      "`files_modified` INTEGER, "
+      "`files_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS package_categories_tr ("
@@ -151,7 +155,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
-      "`deprecated` BOOLEAN NOT NULL"
+      "`deprecated` BOOLEAN NOT NULL, "
+      "`files_modified` INTEGER, "
+      "`files_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS symbols_tr ("
@@ -181,7 +187,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
-      "`deprecated` BOOLEAN NOT NULL"
+      "`deprecated` BOOLEAN NOT NULL, "
+      "`files_modified` INTEGER, "
+      "`files_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS packages_tr ("
@@ -219,7 +227,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
-      "`deprecated` BOOLEAN NOT NULL"
+      "`deprecated` BOOLEAN NOT NULL, "
+      "`files_modified` INTEGER, "
+      "`files_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS components_tr ("
@@ -251,7 +261,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
       "`component_uuid` TEXT NOT NULL, "
-      "`package_uuid` TEXT NOT NULL"
+      "`package_uuid` TEXT NOT NULL, "
+      "`files_modified` INTEGER, "
+      "`files_hash` BLOB"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS devices_tr ("
@@ -291,6 +303,48 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`unit` TEXT"
       ")");
 
+  // library element check messages
+  const QStringList checkedTables = {
+      getElementTable<ComponentCategory>(),  //
+      getElementTable<PackageCategory>(),  //
+      getElementTable<Symbol>(),  //
+      getElementTable<Package>(),  //
+      getElementTable<Component>(),  //
+      getElementTable<Device>(),  //
+  };
+  foreach (const QString& table, checkedTables) {
+    queries << QString(
+                   "CREATE TABLE IF NOT EXISTS %1_msg ("
+                   "`id` INTEGER PRIMARY KEY NOT NULL, "
+                   "`element_id` INTEGER "
+                   "REFERENCES %1(id) ON DELETE CASCADE NOT NULL, "
+                   "`severity` INTEGER NOT NULL, "
+                   "`message` TEXT NOT NULL"
+                   ")")
+                   .arg(table);
+  }
+
+  // full-text search indices
+  if (isSearchIndexSupported()) {
+    const QStringList elementTables = {
+        getElementTable<Library>(),  //
+        getElementTable<ComponentCategory>(),  //
+        getElementTable<PackageCategory>(),  //
+        getElementTable<Symbol>(),  //
+        getElementTable<Package>(),  //
+        getElementTable<Component>(),  //
+        getElementTable<Device>(),  //
+    };
+    foreach (const QString& table, elementTables) {
+      queries << getSearchIndexQueries(table % "_tr", {"name", "keywords"});
+    }
+    queries << getSearchIndexQueries("packages_alt", {"name"});
+    queries << getSearchIndexQueries("parts", {"mpn", "manufacturer"});
+  } else {
+    qWarning() << "SQLite FTS5 trigram tokenizer not available, library "
+                  "search will be slow.";
+  }
+
   // execute queries
   foreach (const QString& string, queries) {
     QSqlQuery query = mDb.prepareQuery(string);
@@ -307,12 +361,22 @@ void WorkspaceLibraryDbWriter::addInternalData(const QString& key, int value) {
   mDb.insert(query);
 }
 
+void WorkspaceLibraryDbWriter::setInternalData(const QString& key,
+                                               const QString& value) {
+  QSqlQuery query = mDb.prepareQuery(
+      "INSERT OR REPLACE INTO internal (key, value_text) "
+      "VALUES (:key, :value)");
+  query.bindValue(":key", key);
+  query.bindValue(":value", value);
+  mDb.exec(query);
+}
+
 int WorkspaceLibraryDbWriter::addLibrary(const FilePath& fp, const Uuid& uuid,
                                          const Version& version,
                                          bool deprecated,
                                          const QByteArray& iconPng,
                                          const QString& manufacturer) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO libraries "
       "(filepath, uuid, version, deprecated, icon_png, manufacturer) VALUES "
       "(:filepath, :uuid, :version, :deprecated, :icon_png, :manufacturer)");
@@ -328,7 +392,7 @@ int WorkspaceLibraryDbWriter::addLibrary(const FilePath& fp, const Uuid& uuid,
 void WorkspaceLibraryDbWriter::updateLibrary(
     const FilePath& fp, const Uuid& uuid, const Version& version,
     bool deprecated, const QByteArray& iconPng, const QString& manufacturer) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "UPDATE libraries "
       "SET uuid = :uuid, version = :version, deprecated = :deprecated, "
       "icon_png = :icon_png, manufacturer = :manufacturer "
@@ -347,7 +411,7 @@ int WorkspaceLibraryDbWriter::addDevice(int libId, const FilePath& fp,
                                         const Version& version, bool deprecated,
                                         const Uuid& component,
                                         const Uuid& package) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO devices "
       "(library_id, filepath, uuid, version, deprecated, component_uuid, "
       "package_uuid) VALUES "
@@ -365,7 +429,7 @@ int WorkspaceLibraryDbWriter::addDevice(int libId, const FilePath& fp,
 
 int WorkspaceLibraryDbWriter::addPart(int devId, const QString& mpn,
                                       const QString& manufacturer) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO parts "
       "(device_id, mpn, manufacturer) VALUES "
       "(:device_id, :mpn, :manufacturer)");
@@ -377,7 +441,7 @@ int WorkspaceLibraryDbWriter::addPart(int devId, const QString& mpn,
 
 int WorkspaceLibraryDbWriter::addPartAttribute(int partId,
                                                const Attribute& attribute) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO parts_attr "
       "(part_id, key, type, value, unit) VALUES "
       "(:part_id, :key, :type, :value, :unit)");
@@ -393,7 +457,7 @@ int WorkspaceLibraryDbWriter::addPartAttribute(int partId,
 
 int WorkspaceLibraryDbWriter::addAlternativeName(
     int pkgId, const ElementName& name, const SimpleString& reference) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO packages_alt "
       "(package_id, name, reference) VALUES "
       "(:package_id, :name, :reference)");
@@ -472,7 +536,7 @@ int WorkspaceLibraryDbWriter::addElement(const QString& elementsTable,
                                          const Uuid& uuid,
                                          const Version& version,
                                          bool deprecated) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO %elements "
       "(library_id, filepath, uuid, version, deprecated) VALUES "
       "(:library_id, :filepath, :uuid, :version, :deprecated)",
@@ -493,7 +557,7 @@ int WorkspaceLibraryDbWriter::addCategory(const QString& categoriesTable,
                                           const Version& version,
                                           bool deprecated,
                                           const tl::optional<Uuid>& parent) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO %categories "
       "(library_id, filepath, uuid, version, deprecated, parent_uuid) VALUES "
       "(:library_id, :filepath, :uuid, :version, :deprecated, :parent_uuid)",
@@ -512,7 +576,7 @@ int WorkspaceLibraryDbWriter::addCategory(const QString& categoriesTable,
 
 void WorkspaceLibraryDbWriter::removeElement(const QString& elementsTable,
                                              const FilePath& fp) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "DELETE FROM %elements "
       "WHERE filepath = :filepath",
       {
@@ -522,6 +586,38 @@ void WorkspaceLibraryDbWriter::removeElement(const QString& elementsTable,
   mDb.exec(query);
 }
 
+void WorkspaceLibraryDbWriter::setFilesFingerprint(
+    const QString& elementsTable, int elementId, qint64 modified,
+    const QByteArray& hash) {
+  QSqlQuery query = mDb.prepareCachedQuery(
+      "UPDATE %elements "
+      "SET files_modified = :files_modified, files_hash = :files_hash "
+      "WHERE id = :id",
+      {
+          {"%elements", elementsTable},
+      });
+  query.bindValue(":id", elementId);
+  query.bindValue(":files_modified", modified);
+  query.bindValue(":files_hash", hash);
+  mDb.exec(query);
+}
+
+int WorkspaceLibraryDbWriter::addCheckMessage(
+    const QString& elementsTable, int elementId,
+    RuleCheckMessage::Severity severity, const QString& message) {
+  QSqlQuery query = mDb.prepareCachedQuery(
+      "INSERT INTO %elements_msg "
+      "(element_id, severity, message) VALUES "
+      "(:element_id, :severity, :message)",
+      {
+          {"%elements", elementsTable},
+      });
+  query.bindValue(":element_id", elementId);
+  query.bindValue(":severity", static_cast<int>(severity));
+  query.bindValue(":message", message);
+  return mDb.insert(query);
+}
+
 void WorkspaceLibraryDbWriter::removeAllElements(const QString& elementsTable) {
   mDb.clearTable(elementsTable);
 }
@@ -531,7 +627,7 @@ int WorkspaceLibraryDbWriter::addTranslation(
     const tl::optional<ElementName>& name,
     const tl::optional<QString>& description,
     const tl::optional<QString>& keywords) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO %elements_tr "
       "(element_id, locale, name, description, keywords) VALUES "
       "(:element_id, :locale, :name, :description, :keywords)",
@@ -556,7 +652,7 @@ void WorkspaceLibraryDbWriter::removeAllTranslations(
 int WorkspaceLibraryDbWriter::addToCategory(const QString& elementsTable,
                                             int elementId,
                                             const Uuid& category) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery query = mDb.prepareCachedQuery(
       "INSERT INTO %elements_cat "
       "(element_id, category_uuid) VALUES "
       "(:element_id, :category_uuid)",
@@ -568,6 +664,56 @@ int WorkspaceLibraryDbWriter::addToCategory(const QString& elementsTable,
   return mDb.insert(query);
 }
 
+bool WorkspaceLibraryDbWriter::isSearchIndexSupported() noexcept {
+  try {
+    QSqlQuery query = mDb.prepareQuery(
+        "CREATE VIRTUAL TABLE temp.fts_probe "
+        "USING fts5(value, tokenize = 'trigram')");
+    mDb.exec(query);  // can throw
+    query = mDb.prepareQuery("DROP TABLE temp.fts_probe");
+    mDb.exec(query);  // can throw
+    return true;
+  } catch (const Exception& e) {
+    return false;
+  }
+}
+
+QStringList WorkspaceLibraryDbWriter::getSearchIndexQueries(
+    const QString& table, const QStringList& columns) noexcept {
+  // The trigram tokenizer allows substring matches, i.e. the index gives the
+  // same results as "LIKE '%keyword%'" queries on the indexed table.
+  const QString cols = columns.join(", ");
+  const QString newCols = "new." % columns.join(", new.");
+  const QString oldCols = "old." % columns.join(", old.");
+  const QString insert = QString(
+                             "INSERT INTO %1_fts (rowid, %2) "
+                             "VALUES (new.id, %3); ")
+                             .arg(table, cols, newCols);
+  const QString remove = QString(
+                             "INSERT INTO %1_fts (%1_fts, rowid, %2) "
+                             "VALUES ('delete', old.id, %3); ")
+                             .arg(table, cols, oldCols);
+  QStringList queries;
+  queries << QString(
+                 "CREATE VIRTUAL TABLE IF NOT EXISTS %1_fts "
+                 "USING fts5(%2, content = '%1', content_rowid = 'id', "
+                 "tokenize = 'trigram')")
+                 .arg(table, cols);
+  queries << QString(
+                 "CREATE TRIGGER IF NOT EXISTS %1_fts_insert "
+                 "AFTER INSERT ON %1 BEGIN %2END")
+                 .arg(table, insert);
+  queries << QString(
+                 "CREATE TRIGGER IF NOT EXISTS %1_fts_delete "
+                 "AFTER DELETE ON %1 BEGIN %2END")
+                 .arg(table, remove);
+  queries << QString(
+                 "CREATE TRIGGER IF NOT EXISTS %1_fts_update "
+                 "AFTER UPDATE ON %1 BEGIN %2%3END")
+                 .arg(table, remove, insert);
+  return queries;
+}
+
 QString WorkspaceLibraryDbWriter::filePathToString(
     const FilePath& fp) const noexcept {
   return fp.toRelative(mLibrariesRoot);
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../fileio/filepath.h"
+#include "../rulecheck/rulecheckmessage.h"
 #include "../types/elementname.h"
 #include "../types/simplestring.h"
 
@@ -68,6 +69,11 @@ public:
    * @brief Create all tables to initialize the database
    *
    * This has to be done only once, after creating a new database.
+   *
+   * @note  If supported by the SQLite library, this also creates full-text
+   *        search indices for translations, alternative package names and
+   *        parts. These are kept in sync by triggers, so all the add/remove
+   *        methods of this class update them automatically.
    */
   void createAllTables();
 
@@ -79,6 +85,14 @@ public:
    */
   void addInternalData(const QString& key, int value);
 
+  /**
+   * @brief Add or replace a text value in the "internal" table
+   *
+   * @param key     The key to add or replace.
+   * @param value   The new value.
+   */
+  void setInternalData(const QString& key, const QString& value);
+
   /**
    * @brief Add a library
    *
@@ -202,6 +216,47 @@ public:
     removeElement(getElementTable<ElementType>(), fp);
   }
 
+  /**
+   * @brief Set the fingerprint of the files of a library element
+   *
+   * The fingerprint is used by the library scanner to detect whether an
+   * element has been modified since it was added to the database.
+   *
+   * @tparam ElementType  Type of the element.
+   * @param elementId     ID of the element.
+   * @param modified      Latest modification time of the element directory
+   *                      and its content, in milliseconds since epoch.
+   * @param hash          Hash of the element's file contents.
+   */
+  template <typename ElementType>
+  void setFilesFingerprint(int elementId, qint64 modified,
+                           const QByteArray& hash) {
+    setFilesFingerprint(getElementTable<ElementType>(), elementId, modified,
+                        hash);
+  }
+
+  /**
+   * @brief Add a non-approved message of the checks of a library element
+   *
+   * The messages are removed together with the element, thus they are
+   * always up to date with the files fingerprint of the element.
+   *
+   * @tparam ElementType  Type of the element.
+   * @param elementId     ID of the element.
+   * @param severity      Severity of the message.
+   * @param message       The message, translated into the language of the
+   *                      "check_messages_locale" entry of the "internal"
+   *                      table.
+   *
+   * @return ID of the added message.
+   */
+  template <typename ElementType>
+  int addCheckMessage(int elementId, RuleCheckMessage::Severity severity,
+                      const QString& message) {
+    return addCheckMessage(getElementTable<ElementType>(), elementId, severity,
+                           message);
+  }
+
   /**
    * @brief Remove all library elements of a specific type
    *
@@ -306,6 +361,11 @@ private:  // Methods
                   const Uuid& uuid, const Version& version, bool deprecated,
                   const tl::optional<Uuid>& parent);
   void removeElement(const QString& elementsTable, const FilePath& fp);
+  void setFilesFingerprint(const QString& elementsTable, int elementId,
+                           qint64 modified, const QByteArray& hash);
+  int addCheckMessage(const QString& elementsTable, int elementId,
+                      RuleCheckMessage::Severity severity,
+                      const QString& message);
   void removeAllElements(const QString& elementsTable);
   int addTranslation(const QString& elementsTable, int elementId,
                      const QString& locale,
@@ -315,6 +375,9 @@ private:  // Methods
   void removeAllTranslations(const QString& elementsTable);
   int addToCategory(const QString& elementsTable, int elementId,
                     const Uuid& category);
+  bool isSearchIndexSupported() noexcept;
+  static QStringList getSearchIndexQueries(const QString& table,
+                                           const QStringList& columns) noexcept;
   QString filePathToString(const FilePath& fp) const noexcept;
   static QString nonNull(const QString& s) noexcept;
 
@@ -32,11 +32,16 @@
 #include "../library/pkg/package.h"
 #include "../library/sym/symbol.h"
 #include "../sqlitedatabase.h"
+#include "../tracer.h"
+#include "../utils/scopeguard.h"
 #include "../utils/toolbox.h"
 #include "workspacelibrarydbwriter.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -103,6 +108,7 @@ void WorkspaceLibraryScanner::run() noexcept {
 
 void WorkspaceLibraryScanner::scan() noexcept {
   try {
+    Tracer::Span span("library", "WorkspaceLibraryScanner::scan");
     QElapsedTimer timer;
     timer.start();
     emit scanStarted();
@@ -113,6 +119,13 @@ void WorkspaceLibraryScanner::scan() noexcept {
     SQLiteDatabase db(mDbFilePath);  // can throw
     WorkspaceLibraryDbWriter writer(mLibrariesPath, db);
 
+    // Tune this connection for bulk writes. With Write-Ahead Logging, a
+    // reduced synchronization level is still safe against corruption, and
+    // the database is only a cache anyway.
+    db.exec("PRAGMA synchronous = NORMAL");  // can throw
+    db.exec("PRAGMA cache_size = -32768");  // 32 MiB; can throw
+    db.exec("PRAGMA temp_store = MEMORY");  // can throw
+
     // update list of libraries
     QList<std::shared_ptr<Library>> libraries;
     getLibrariesOfDirectory("local", libraries);
@@ -127,13 +140,36 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    writer.removeAllElements<ComponentCategory>();
-    writer.removeAllElements<PackageCategory>();
-    writer.removeAllElements<Symbol>();
-    writer.removeAllElements<Package>();
-    writer.removeAllElements<Component>();
-    writer.removeAllElements<Device>();
+    // Get all elements currently stored in the database. Elements which are
+    // found during the scan get removed from these lists, so at the end they
+    // contain only elements which no longer exist.
+    QHash<FilePath, DbElement> cmpCats =
+        getElementsFromDb<ComponentCategory>(db);  // can throw
+    QHash<FilePath, DbElement> pkgCats =
+        getElementsFromDb<PackageCategory>(db);  // can throw
+    QHash<FilePath, DbElement> symbols =
+        getElementsFromDb<Symbol>(db);  // can throw
+    QHash<FilePath, DbElement> packages =
+        getElementsFromDb<Package>(db);  // can throw
+    QHash<FilePath, DbElement> components =
+        getElementsFromDb<Component>(db);  // can throw
+    QHash<FilePath, DbElement> devices =
+        getElementsFromDb<Device>(db);  // can throw
+
+    // The check messages are stored translated, so all elements need to be
+    // checked again if the application language has changed since the last
+    // scan. Discarding their fingerprints enforces re-parsing them.
+    const QString locale = QLocale().name();
+    if (getInternalText(db, "check_messages_locale") != locale) {
+      for (auto elements : {&cmpCats, &pkgCats, &symbols, &packages,
+                            &components, &devices}) {
+        for (DbElement& element : *elements) {
+          element.filesModified = -1;
+          element.filesHash.clear();
+        }
+      }
+      writer.setInternalData("check_messages_locale", locale);  // can throw
+    }
 
     // scan all libraries
     int count = 0;
@@ -144,32 +180,41 @@ void WorkspaceLibraryScanner::scan() noexcept {
       int libId = libIds[fp];
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<ComponentCategory>(
-          writer, fp, lib->searchForElements<ComponentCategory>(), libId);
+          writer, fp, lib->searchForElements<ComponentCategory>(false), libId,
+          cmpCats);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<PackageCategory>(
-          writer, fp, lib->searchForElements<PackageCategory>(), libId);
+          writer, fp, lib->searchForElements<PackageCategory>(false), libId,
+          pkgCats);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Symbol>(writer, fp,
-                                       lib->searchForElements<Symbol>(), libId);
+      count += addElementsToDb<Symbol>(
+          writer, fp, lib->searchForElements<Symbol>(false), libId, symbols);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<Package>(
-          writer, fp, lib->searchForElements<Package>(), libId);
+          writer, fp, lib->searchForElements<Package>(false), libId, packages);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<Component>(
-          writer, fp, lib->searchForElements<Component>(), libId);
+          writer, fp, lib->searchForElements<Component>(false), libId,
+          components);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Device>(writer, fp,
-                                       lib->searchForElements<Device>(), libId);
+      count += addElementsToDb<Device>(
+          writer, fp, lib->searchForElements<Device>(false), libId, devices);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
-    // commit transaction
+    // remove no longer existing elements and commit transaction
     if ((!mAbort) && (mSemaphore.available() == 0)) {
+      removeElementsFromDb<ComponentCategory>(writer, cmpCats);  // can throw
+      removeElementsFromDb<PackageCategory>(writer, pkgCats);  // can throw
+      removeElementsFromDb<Symbol>(writer, symbols);  // can throw
+      removeElementsFromDb<Package>(writer, packages);  // can throw
+      removeElementsFromDb<Component>(writer, components);  // can throw
+      removeElementsFromDb<Device>(writer, devices);  // can throw
       transactionGuard.commit();  // can throw
       qDebug() << "Workspace library scan succeeded:" << count << "elements in"
                << timer.elapsed() << "ms.";
@@ -264,29 +309,189 @@ QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
   return dbLibIds;
 }
 
+QString WorkspaceLibraryScanner::getInternalText(SQLiteDatabase& db,
+                                                 const QString& key) {
+  QSqlQuery query =
+      db.prepareQuery("SELECT value_text FROM internal WHERE key = :key");
+  query.bindValue(":key", key);
+  db.exec(query);  // can throw
+  return query.next() ? query.value(0).toString() : QString();
+}
+
 template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(WorkspaceLibraryDbWriter& writer,
-                                             const FilePath& libPath,
-                                             const QStringList& dirs,
-                                             int libId) {
-  int count = 0;
+QHash<FilePath, WorkspaceLibraryScanner::DbElement>
+    WorkspaceLibraryScanner::getElementsFromDb(SQLiteDatabase& db) {
+  QHash<FilePath, DbElement> elements;
+  const QString table =
+      WorkspaceLibraryDbWriter::getElementTable<ElementType>();
+  QSqlQuery query = db.prepareQuery(
+      "SELECT id, library_id, filepath, files_modified, files_hash "
+      "FROM %elements",
+      {
+          {"%elements", table},
+      });
+  db.exec(query);
+  while (query.next()) {
+    const FilePath fp = mLibrariesPath.getPathTo(query.value(2).toString());
+    if (!fp.isValid()) throw LogicError(__FILE__, __LINE__);
+    DbElement element;
+    element.id = query.value(0).toInt();
+    element.libId = query.value(1).toInt();
+    element.filesModified = query.value(3).toLongLong();
+    element.filesHash = query.value(4).toByteArray();
+    elements.insert(fp, element);
+  }
+  return elements;
+}
+
+template <typename ElementType>
+void WorkspaceLibraryScanner::removeElementsFromDb(
+    WorkspaceLibraryDbWriter& writer,
+    const QHash<FilePath, DbElement>& elements) {
+  foreach (const FilePath& fp, elements.keys()) {
+    writer.removeElement<ElementType>(fp);
+  }
+}
+
+template <typename ElementType>
+int WorkspaceLibraryScanner::addElementsToDb(
+    WorkspaceLibraryDbWriter& writer, const FilePath& libPath,
+    const QStringList& dirs, int libId,
+    QHash<FilePath, DbElement>& dbElements) {
+  // Check and open the elements in worker threads since this is independent
+  // of all other elements. Only the database accesses are done in this
+  // thread, while the workers are still busy with the next elements.
+  struct Job {
+    FilePath fp;
+    tl::optional<DbElement> dbElement;
+    QFuture<ScannedElement> future;
+  };
+  QVector<Job> jobs;
+  auto jobsGuard = scopeGuard([&jobs]() {
+    // The workers access this object, thus wait for them in any case.
+    for (Job& job : jobs) {
+      job.future.waitForFinished();
+    }
+  });
   foreach (const QString& dirpath, dirs) {
+    Job job;
+    job.fp = libPath.getPathTo(dirpath);
+    if (dbElements.contains(job.fp)) {
+      job.dbElement = dbElements.take(job.fp);
+    }
+    const tl::optional<DbElement> dbElement =
+        (job.dbElement && (job.dbElement->libId == libId)) ? job.dbElement
+                                                             : tl::nullopt;
+    const FilePath fp = job.fp;
+    job.future = QtConcurrent::run([this, fp, dbElement]() {
+      return scanElement<ElementType>(fp, dbElement);
+    });
+    jobs.append(job);
+  }
+
+  // Update the database in the same order as the elements were found.
+  int count = 0;
+  for (Job& job : jobs) {
     if (mAbort || (mSemaphore.available() > 0)) break;
-    const FilePath fp = libPath.getPathTo(dirpath);
-    try {
-      std::unique_ptr<ElementType> element =
-          openAndMigrate<ElementType>(fp);  // can throw
+    const ScannedElement scanned = job.future.result();
+    if (scanned.unchanged) {
+      Q_ASSERT(job.dbElement);
+      if (scanned.filesModified != job.dbElement->filesModified) {
+        writer.setFilesFingerprint<ElementType>(
+            job.dbElement->id, scanned.filesModified, scanned.filesHash);
+      }
+      count++;
+      continue;
+    }
+    if (job.dbElement) {
+      writer.removeElement<ElementType>(job.fp);
+    }
+    if (const ElementType* element =
+            static_cast<const ElementType*>(scanned.element.get())) {
       int id = addElementToDb(writer, libId, *element);
       addTranslationsToDb(writer, id, *element);
+      for (const auto& msg : scanned.checkMessages) {
+        writer.addCheckMessage<ElementType>(id, msg->getSeverity(),
+                                            msg->getMessage());
+      }
+      writer.setFilesFingerprint<ElementType>(id, scanned.filesModified,
+                                              scanned.filesHash);
       count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element during scan:"
-                 << fp.toNative();
     }
   }
   return count;
 }
 
+template <typename ElementType>
+WorkspaceLibraryScanner::ScannedElement WorkspaceLibraryScanner::scanElement(
+    const FilePath& fp, const tl::optional<DbElement>& dbElement) noexcept {
+  ScannedElement result;
+  result.unchanged = false;
+  result.filesModified = 0;
+  if (mAbort || (mSemaphore.available() > 0)) {
+    return result;
+  }
+
+  // Check the directory here instead of in Library::searchForElements() to
+  // access the file system in parallel, which matters on network drives.
+  if (!LibraryBaseElement::isValidElementDirectory<ElementType>(fp)) {
+    // Note: Do not warn about empty directories since this happens often
+    // when switching branches, leading to annoying warnings.
+    if (!QDir(fp.toStr()).entryList(QDir::Files | QDir::Hidden).isEmpty()) {
+      qWarning() << "Directory is not a valid library element, ignoring it:"
+                 << fp.toNative();
+    }
+    return result;
+  }
+
+  // Skip the element if it has not been modified since the last scan.
+  // If only the modification time has changed (e.g. after a Git checkout),
+  // compare the file contents to avoid re-parsing the element.
+  result.filesModified = getLastModified(fp);
+  if (dbElement) {
+    if (result.filesModified == dbElement->filesModified) {
+      result.unchanged = true;
+      return result;
+    }
+    result.filesHash = calcFilesHash(fp);
+    if ((!result.filesHash.isEmpty()) &&
+        (result.filesHash == dbElement->filesHash)) {
+      result.unchanged = true;
+      return result;
+    }
+  }
+
+  try {
+    std::unique_ptr<ElementType> element =
+        openAndMigrate<ElementType>(fp);  // can throw
+    // Run the checks here as well to make their results available without
+    // opening the element. Since they are stored together with the files
+    // fingerprint, they are only re-run when the element was modified.
+    try {
+      const QSet<SExpression>& approvals = element->getMessageApprovals();
+      foreach (const auto& msg, element->runChecks()) {  // can throw
+        if (!approvals.contains(msg->getApproval())) {
+          result.checkMessages.append(msg);
+        }
+      }
+    } catch (const Exception& e) {
+      qWarning() << "Failed to run checks of library element during scan:"
+                 << fp.toNative() << e.getMsg();
+    }
+    // The element is destroyed in the scanner thread.
+    element->moveToThread(this);
+    result.element.reset(element.release());
+    // Note: Determine the fingerprint only after opening the element since
+    // a file format migration might have modified its files.
+    result.filesModified = getLastModified(fp);
+    result.filesHash = calcFilesHash(fp);
+  } catch (const Exception& e) {
+    qWarning() << "Failed to open library element during scan:"
+               << fp.toNative();
+  }
+  return result;
+}
+
 template <typename ElementType>
 int WorkspaceLibraryScanner::addElementToDb(WorkspaceLibraryDbWriter& writer,
                                             int libId,
@@ -395,6 +600,45 @@ std::unique_ptr<ElementType> WorkspaceLibraryScanner::openAndMigrate(
   return element;
 }
 
+qint64 WorkspaceLibraryScanner::getLastModified(const FilePath& dir) noexcept {
+  // Note: Also take directories into account since their modification time
+  // changes when files are added, removed or renamed.
+  qint64 modified = QFileInfo(dir.toStr()).lastModified().toMSecsSinceEpoch();
+  QDirIterator it(dir.toStr(),
+                  QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    modified =
+        std::max(modified, it.fileInfo().lastModified().toMSecsSinceEpoch());
+  }
+  return modified;
+}
+
+QByteArray WorkspaceLibraryScanner::calcFilesHash(
+    const FilePath& dir) noexcept {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  try {
+    // Note: Hidden files are ignored since they are not part of the library
+    // element (e.g. the lock file of an opened element).
+    QList<FilePath> files =
+        FileUtils::getFilesInDirectory(dir, {}, true, true);  // can throw
+    std::sort(files.begin(), files.end());
+    foreach (const FilePath& fp, files) {
+      hash.addData(fp.toRelative(dir).toUtf8());
+      hash.addData("\0", 1);
+      hash.addData(FileUtils::readFile(fp));  // can throw
+      hash.addData("\0", 1);
+    }
+  } catch (const Exception& e) {
+    // Return an empty hash to enforce re-parsing the element.
+    qWarning() << "Failed to calculate hash of library element:"
+               << dir.toNative();
+    return QByteArray();
+  }
+  return hash.result();
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -24,6 +24,9 @@
  *  Includes
  ******************************************************************************/
 #include "../fileio/filepath.h"
+#include "../rulecheck/rulecheckmessage.h"
+
+#include <optional/tl/optional.hpp>
 
 #include <QtCore>
 
@@ -35,6 +38,7 @@
 namespace librepcb {
 
 class Library;
+class LibraryBaseElement;
 class SQLiteDatabase;
 class WorkspaceLibraryDbWriter;
 
@@ -77,6 +81,24 @@ signals:
   void scanFailed(QString errorMsg);
   void scanFinished();
 
+private:  // Types
+  /// Library element as currently stored in the database
+  struct DbElement {
+    int id;
+    int libId;
+    qint64 filesModified;
+    QByteArray filesHash;
+  };
+
+  /// Result of checking and opening a library element directory
+  struct ScannedElement {
+    bool unchanged;  ///< Whether the element is up to date in the database
+    qint64 filesModified;
+    QByteArray filesHash;
+    std::shared_ptr<LibraryBaseElement> element;  ///< nullptr on failure
+    RuleCheckMessageList checkMessages;  ///< Non-approved messages only
+  };
+
 private:  // Methods
   void run() noexcept override;
   void scan() noexcept;
@@ -86,9 +108,19 @@ private:  // Methods
   QHash<FilePath, int> updateLibraries(
       SQLiteDatabase& db, WorkspaceLibraryDbWriter& writer,
       const QList<std::shared_ptr<Library>>& libs);
+  static QString getInternalText(SQLiteDatabase& db, const QString& key);
+  template <typename ElementType>
+  QHash<FilePath, DbElement> getElementsFromDb(SQLiteDatabase& db);
+  template <typename ElementType>
+  void removeElementsFromDb(WorkspaceLibraryDbWriter& writer,
+                            const QHash<FilePath, DbElement>& elements);
   template <typename ElementType>
   int addElementsToDb(WorkspaceLibraryDbWriter& writer, const FilePath& libPath,
-                      const QStringList& dirs, int libId);
+                      const QStringList& dirs, int libId,
+                      QHash<FilePath, DbElement>& dbElements);
+  template <typename ElementType>
+  ScannedElement scanElement(const FilePath& fp,
+                             const tl::optional<DbElement>& dbElement) noexcept;
   template <typename ElementType>
   int addElementToDb(WorkspaceLibraryDbWriter& writer, int libId,
                      const ElementType& element);
@@ -100,6 +132,8 @@ private:  // Methods
                        const ElementType& element);
   template <typename ElementType>
   std::unique_ptr<ElementType> openAndMigrate(const FilePath& fp);
+  static qint64 getLastModified(const FilePath& dir) noexcept;
+  static QByteArray calcFilesHash(const FilePath& dir) noexcept;
 
 private:  // Data
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
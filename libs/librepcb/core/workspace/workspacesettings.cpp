@@ -48,7 +48,10 @@ WorkspaceSettings::WorkspaceSettings(QObject* parent)
     applicationLocale("application_locale", "", this),
     defaultLengthUnit("default_length_unit", LengthUnit::millimeters(), this),
     projectAutosaveIntervalSeconds("project_autosave_interval", 600U, this),
+    undoLimit("undo_limit", 0U, this),
+    workerThreads("worker_threads", 0U, this),
     useOpenGl("use_opengl", false, this),
+    showRenderStatistics("show_render_statistics", false, this),
     libraryLocaleOrder("library_locale_order", "locale", QStringList(), this),
     libraryNormOrder("library_norm_order", "norm", QStringList(), this),
     apiEndpoints("api_endpoints", "url",
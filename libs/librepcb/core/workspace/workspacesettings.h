@@ -169,6 +169,24 @@ public:
    */
   WorkspaceSettingsItem_GenericValue<uint> projectAutosaveIntervalSeconds;
 
+  /**
+   * @brief Maximum number of undo steps (0 = unlimited)
+   *
+   * Older steps are discarded to limit the memory usage in long sessions.
+   *
+   * Default: 0
+   */
+  WorkspaceSettingsItem_GenericValue<uint> undoLimit;
+
+  /**
+   * @brief Maximum number of threads per thread pool (0 = CPU cores)
+   *
+   * @see ::librepcb::Concurrency
+   *
+   * Default: 0
+   */
+  WorkspaceSettingsItem_GenericValue<uint> workerThreads;
+
   /**
    * @brief Use OpenGL hardware acceleration
    *
@@ -176,6 +194,15 @@ public:
    */
   WorkspaceSettingsItem_GenericValue<bool> useOpenGl;
 
+  /**
+   * @brief Show render statistics (e.g. frame time) in graphics views
+   *
+   * Useful to investigate performance issues of the editors.
+   *
+   * Default: False
+   */
+  WorkspaceSettingsItem_GenericValue<bool> showRenderStatistics;
+
   /**
    * @brief Preferred library locales (like "de_CH") in the right order
    *
@@ -31,9 +31,11 @@
 #include <librepcb/core/library/dev/device.h>
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/utils/concurrency.h>
 #include <librepcb/core/utils/messagelogger.h>
 #include <parseagle/library.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -42,6 +44,9 @@
 namespace librepcb {
 namespace eagleimport {
 
+/// Maximum number of converted elements kept in memory while saving them
+static const int sSaveBatchSize = 256;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -325,6 +330,38 @@ void EagleLibraryImport::run() noexcept {
   int totalCount = getCheckedElementsCount();
   int count = 0;
 
+  // The conversion depends on previously converted elements (e.g. devices
+  // refer to components and packages), thus it is done sequentially. But
+  // serializing and writing the converted elements is independent, so it is
+  // done in parallel, in batches to limit the memory usage. Note that the
+  // elements are released in this thread since they are QObjects.
+  QThreadPool threadPool;  // Waits for all workers on destruction.
+  Concurrency::apply(threadPool);
+  QVector<std::shared_ptr<const LibraryBaseElement>> pendingElements;
+  auto save = [&](std::unique_ptr<LibraryBaseElement> element,
+                  const QString& shortElementName, const QString& displayName,
+                  const QString& errorMsg) {
+    const FilePath fp = mDestinationLibraryFp.getPathTo(shortElementName)
+                            .getPathTo(element->getUuid().toStr());
+    std::shared_ptr<LibraryBaseElement> obj(std::move(element));
+    pendingElements.append(obj);
+    QtConcurrent::run(&threadPool, [globalLog, obj, fp, displayName,
+                                    errorMsg]() {
+      MessageLogger log(globalLog.get(), displayName);
+      try {
+        TransactionalDirectory dir(TransactionalFileSystem::openRW(fp));
+        obj->saveTo(dir);
+        dir.getFileSystem()->save();
+      } catch (const Exception& e) {
+        log.critical(errorMsg.arg(e.getMsg()));
+      }
+    });
+    if (pendingElements.count() >= sSaveBatchSize) {
+      threadPool.waitForDone();
+      pendingElements.clear();
+    }
+  };
+
   foreach (const Symbol& sym, mSymbols) {
     if (mAbort) {
       break;
@@ -337,12 +374,8 @@ void EagleLibraryImport::run() noexcept {
       emit progressStatus(sym.displayName);
       auto symbol =
           converter.createSymbol(QString(), *sym.symbol, log);  // can throw
-      TransactionalDirectory dir(TransactionalFileSystem::openRW(
-          mDestinationLibraryFp
-              .getPathTo(librepcb::Symbol::getShortElementName())
-              .getPathTo(symbol->getUuid().toStr())));
-      symbol->saveTo(dir);
-      dir.getFileSystem()->save();
+      save(std::move(symbol), librepcb::Symbol::getShortElementName(),
+           sym.displayName, tr("Skipped symbol due to error: %1"));
     } catch (const Exception& e) {
       log.critical(tr("Skipped symbol due to error: %1").arg(e.getMsg()));
     }
@@ -362,12 +395,8 @@ void EagleLibraryImport::run() noexcept {
       emit progressStatus(pkg.displayName);
       auto package =
           converter.createPackage(QString(), *pkg.package, log);  // can throw
-      TransactionalDirectory dir(TransactionalFileSystem::openRW(
-          mDestinationLibraryFp
-              .getPathTo(librepcb::Package::getShortElementName())
-              .getPathTo(package->getUuid().toStr())));
-      package->saveTo(dir);
-      dir.getFileSystem()->save();
+      save(std::move(package), librepcb::Package::getShortElementName(),
+           pkg.displayName, tr("Skipped package due to error: %1"));
     } catch (const Exception& e) {
       log.critical(tr("Skipped package due to error: %1").arg(e.getMsg()));
     }
@@ -387,12 +416,8 @@ void EagleLibraryImport::run() noexcept {
       emit progressStatus(cmp.displayName);
       auto component = converter.createComponent(QString(), *cmp.deviceSet,
                                                  log);  // can throw
-      TransactionalDirectory dir(TransactionalFileSystem::openRW(
-          mDestinationLibraryFp
-              .getPathTo(librepcb::Component::getShortElementName())
-              .getPathTo(component->getUuid().toStr())));
-      component->saveTo(dir);
-      dir.getFileSystem()->save();
+      save(std::move(component), librepcb::Component::getShortElementName(),
+           cmp.displayName, tr("Skipped component due to error: %1"));
     } catch (const Exception& e) {
       log.critical(tr("Skipped component due to error: %1").arg(e.getMsg()));
     }
@@ -412,12 +437,8 @@ void EagleLibraryImport::run() noexcept {
       emit progressStatus(dev.displayName);
       auto device = converter.createDevice(QString(), *dev.deviceSet,
                                            *dev.device, log);  // can throw
-      TransactionalDirectory dir(TransactionalFileSystem::openRW(
-          mDestinationLibraryFp
-              .getPathTo(librepcb::Device::getShortElementName())
-              .getPathTo(device->getUuid().toStr())));
-      device->saveTo(dir);
-      dir.getFileSystem()->save();
+      save(std::move(device), librepcb::Device::getShortElementName(),
+           dev.displayName, tr("Skipped device due to error: %1"));
     } catch (const Exception& e) {
       log.critical(tr("Skipped device due to error: %1").arg(e.getMsg()));
     }
@@ -425,6 +446,8 @@ void EagleLibraryImport::run() noexcept {
     emit progressPercent((100 * count) / std::max(totalCount, 1));
   }
 
+  threadPool.waitForDone();
+  pendingElements.clear();
   emit progressPercent(100);
   emit progressStatus(tr("Finished: %1 of %2 element(s) imported",
                          "Placeholders are numbers", totalCount)
@@ -62,11 +62,13 @@
 #include <librepcb/core/project/schematic/items/si_text.h>
 #include <librepcb/core/project/schematic/schematic.h>
 #include <librepcb/core/project/schematic/schematicnetsegmentsplitter.h>
+#include <librepcb/core/utils/concurrency.h>
 #include <librepcb/core/utils/messagelogger.h>
 #include <librepcb/core/utils/transform.h>
 #include <parseagle/board/board.h>
 #include <parseagle/schematic/schematic.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -77,6 +79,22 @@ namespace eagleimport {
 
 using C = EagleTypeConverter;
 
+/*******************************************************************************
+ *  Struct EagleProjectImport::JoinedWires
+ ******************************************************************************/
+
+/**
+ * @brief Wires of a sheet or board joined to polygons, with their messages
+ *
+ * The messages are recorded instead of logged directly since the wires are
+ * joined in worker threads. They are logged when the geometries get imported
+ * to keep the log in a deterministic order.
+ */
+struct EagleProjectImport::JoinedWires {
+  QList<C::Geometry> geometries;
+  std::shared_ptr<MessageLogger> log;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -175,6 +193,25 @@ void EagleProjectImport::import(Project& project) {
 
     EagleLibraryConverter converter(settings, this);
 
+    // Joining tangent wires to polygons is the most expensive part of the
+    // conversion and doesn't depend on anything else, so start it already in
+    // parallel for all sheets and the board. The results are merged in the
+    // original order below.
+    QThreadPool threadPool;  // Waits for all workers on destruction.
+    Concurrency::apply(threadPool);
+    QList<QFuture<JoinedWires>> sheetWires;
+    foreach (const parseagle::Sheet& sheet, mSchematic->getSheets()) {
+      const QList<parseagle::Wire> wires = sheet.getWires();
+      sheetWires.append(QtConcurrent::run(
+          &threadPool, [wires]() { return joinWires(wires); }));
+    }
+    QFuture<JoinedWires> boardWires;
+    if (mBoard) {
+      const QList<parseagle::Wire> wires = mBoard->getWires();
+      boardWires = QtConcurrent::run(&threadPool,
+                                     [wires]() { return joinWires(wires); });
+    }
+
     // Add components.
     foreach (const parseagle::Part& part, mSchematic->getParts()) {
       MessageLogger log(mLogger.get(), part.getName());
@@ -228,13 +265,14 @@ void EagleProjectImport::import(Project& project) {
     }
 
     // Import schematics.
-    foreach (const parseagle::Sheet& sheet, mSchematic->getSheets()) {
-      importSchematic(project, converter, sheet);
+    for (int i = 0; i < mSchematic->getSheets().count(); ++i) {
+      importSchematic(project, converter, mSchematic->getSheets().at(i),
+                      sheetWires[i].result());
     }
 
     // Import board, if given.
     if (mBoard) {
-      importBoard(project, converter);
+      importBoard(project, converter, boardWires.result());
     }
 
     // Status messages.
@@ -364,7 +402,8 @@ const Device& EagleProjectImport::importLibraryDevice(
 
 void EagleProjectImport::importSchematic(Project& project,
                                          EagleLibraryConverter& converter,
-                                         const parseagle::Sheet& sheet) {
+                                         const parseagle::Sheet& sheet,
+                                         const JoinedWires& wires) {
   // Determine directory name.
   QString dirName = FilePath::cleanFileName(
       sheet.getDescription(), FilePath::ReplaceSpaces | FilePath::ToLowerCase);
@@ -460,11 +499,9 @@ void EagleProjectImport::importSchematic(Project& project,
   }
 
   // Geometry
-  QList<C::Geometry> geometries;
-  try {
-    geometries += C::convertAndJoinWires(sheet.getWires(), true, log);
-  } catch (const Exception& e) {
-    log.warning(QString("Failed to join wires: %1").arg(e.getMsg()));
+  QList<C::Geometry> geometries = wires.geometries;
+  foreach (const MessageLogger::Message& msg, wires.log->getMessages()) {
+    log.log(msg.type, msg.message);
   }
   foreach (const parseagle::Rectangle& eagleObj, sheet.getRectangles()) {
     geometries.append(C::convertRectangle(eagleObj, true));
@@ -689,7 +726,8 @@ NetSignal& EagleProjectImport::importNet(Project& project,
 }
 
 void EagleProjectImport::importBoard(Project& project,
-                                     EagleLibraryConverter& converter) {
+                                     EagleLibraryConverter& converter,
+                                     const JoinedWires& wires) {
   // Create board.
   MessageLogger log(mLogger.get(), "BOARD");
   Board* board = new librepcb::Board(
@@ -896,11 +934,9 @@ void EagleProjectImport::importBoard(Project& project,
   }
 
   // Geometry
-  QList<C::Geometry> geometries;
-  try {
-    geometries += C::convertAndJoinWires(mBoard->getWires(), true, log);
-  } catch (const Exception& e) {
-    log.warning(QString("Failed to join wires: %1").arg(e.getMsg()));
+  QList<C::Geometry> geometries = wires.geometries;
+  foreach (const MessageLogger::Message& msg, wires.log->getMessages()) {
+    log.log(msg.type, msg.message);
   }
   foreach (const parseagle::Rectangle& eagleObj, mBoard->getRectangles()) {
     geometries.append(C::convertRectangle(eagleObj, true));
@@ -1237,6 +1273,19 @@ void EagleProjectImport::importBoard(Project& project,
   }
 }
 
+EagleProjectImport::JoinedWires EagleProjectImport::joinWires(
+    const QList<parseagle::Wire>& wires) noexcept {
+  // Record messages without printing them, they are printed when passing
+  // them to the import logger in the main thread.
+  JoinedWires result{{}, std::make_shared<MessageLogger>(true, nullptr, false)};
+  try {
+    result.geometries = C::convertAndJoinWires(wires, true, *result.log);
+  } catch (const Exception& e) {
+    result.log->warning(QString("Failed to join wires: %1").arg(e.getMsg()));
+  }
+  return result;
+}
+
 bool EagleProjectImport::hasBuses(
     const parseagle::Schematic& schematic) const noexcept {
   int buses = 0;
@@ -46,6 +46,7 @@ class Schematic;
 class Sheet;
 class Symbol;
 class Technology;
+class Wire;
 }  // namespace parseagle
 
 namespace librepcb {
@@ -97,6 +98,9 @@ public:
   // Operator Overloadings
   EagleProjectImport& operator=(const EagleProjectImport& rhs) = delete;
 
+private:  // Types
+  struct JoinedWires;
+
 private:  // Methods
   const Symbol& importLibrarySymbol(EagleLibraryConverter& converter,
                                     ProjectLibrary& library,
@@ -121,8 +125,10 @@ private:  // Methods
                                     const QString& devName);
   NetSignal& importNet(Project& project, const parseagle::Net& net);
   void importSchematic(Project& project, EagleLibraryConverter& converter,
-                       const parseagle::Sheet& sheet);
-  void importBoard(Project& project, EagleLibraryConverter& converter);
+                       const parseagle::Sheet& sheet, const JoinedWires& wires);
+  void importBoard(Project& project, EagleLibraryConverter& converter,
+                   const JoinedWires& wires);
+  static JoinedWires joinWires(const QList<parseagle::Wire>& wires) noexcept;
   bool hasBuses(const parseagle::Schematic& schematic) const noexcept;
   tl::optional<BoundedUnsignedRatio> tryGetDrcRatio(const QString& nr,
                                                     const QString& nmin,
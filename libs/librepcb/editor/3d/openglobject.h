@@ -48,8 +48,22 @@ public:
   virtual ~OpenGlObject() noexcept = default;
 
   // General Methods
-  virtual void draw(QOpenGLFunctions& gl,
-                    QOpenGLShaderProgram& program) noexcept = 0;
+
+  /**
+   * @brief Draw the object (must be called from the OpenGL thread)
+   *
+   * @param gl              OpenGL functions.
+   * @param program         The shader program.
+   * @param viewProjection  The view-projection matrix (without the model
+   *                        matrix of this object), used for culling.
+   * @param viewportSize    Size of the viewport in pixels.
+   *
+   * @retval true   If the object was drawn.
+   * @retval false  If the object was skipped since it is not visible.
+   */
+  virtual bool draw(QOpenGLFunctions& gl, QOpenGLShaderProgram& program,
+                    const QMatrix4x4& viewProjection,
+                    const QSizeF& viewportSize) noexcept = 0;
 };
 
 /*******************************************************************************
@@ -25,12 +25,15 @@
 #include "opengltriangleobject.h"
 
 #include <librepcb/core/3d/occmodel.h>
+#include <librepcb/core/application.h>
 #include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/filesystem.h>
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/types/layer.h>
 #include <librepcb/core/types/pcbcolor.h>
+#include <librepcb/core/utils/cachekeybuilder.h>
 #include <librepcb/core/utils/clipperhelpers.h>
+#include <librepcb/core/utils/concurrency.h>
 #include <librepcb/core/utils/scopeguard.h>
 #include <librepcb_build_env.h>
 
@@ -53,13 +56,22 @@ Q_DECLARE_METATYPE(std::shared_ptr<librepcb::editor::OpenGlObject>)
 namespace librepcb {
 namespace editor {
 
+// Identifier of the on-disk cache file format, to be changed when the content
+// of cached models changes (e.g. different tesselation parameters).
+static const char* sStepModelCacheFormat = "librepcb-mesh-1";
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 OpenGlSceneBuilder::OpenGlSceneBuilder(QObject* parent) noexcept
-  : QObject(parent), mMaxArcTolerance(5000), mFuture(), mAbort(false) {
+  : QObject(parent),
+    mMaxArcTolerance(5000),
+    mFuture(),
+    mAbort(false),
+    mStepModelsMemory("3D models") {
   qRegisterMetaType<std::shared_ptr<OpenGlObject>>();
+  Concurrency::apply(mThreadPool);
 }
 
 OpenGlSceneBuilder::~OpenGlSceneBuilder() noexcept {
@@ -147,41 +159,60 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
                           ClipperLib::pftNonZero);
     if (mAbort) return;
 
+    // Note: To make small modifications (e.g. moving a trace) fast, the
+    // expensive Clipper operations and extrusions are skipped for every
+    // object whose input data has not changed since the last build.
+
     // Board body.
     QStringList layers = {Layer::boardOutlines().getId()};
     const ClipperLib::Paths boardOutlines = getPaths(data, layers);
-    std::unique_ptr<ClipperLib::PolyTree> tree = ClipperHelpers::subtractToTree(
-        boardOutlines, allHoles, ClipperLib::pftNonZero,
-        ClipperLib::pftNonZero);
-    const ClipperLib::Paths boardArea = ClipperHelpers::flattenTree(*tree);
-    tree = ClipperHelpers::subtractToTree(boardOutlines, allHoles,
-                                          ClipperLib::pftNonZero,
-                                          ClipperLib::pftNonZero, false);
-    const ClipperLib::Paths boardEdges = ClipperHelpers::treeToPaths(*tree);
-    publishTriangleData(
-        Layer::boardOutlines().getId(), QColor(70, 80, 70),
-        extrude(boardArea, -d, 2 * d, scaleFactor, true, false) +
-            extrude(boardEdges, -d, 2 * d, scaleFactor, false, true, false));
+    const QByteArray boardHash =
+        calcHash({&boardOutlines, &allHoles}, {d, scaleFactor});
+    if (needsRebuild(layers.first(), boardHash)) {
+      std::unique_ptr<ClipperLib::PolyTree> tree =
+          ClipperHelpers::subtractToTree(boardOutlines, allHoles,
+                                         ClipperLib::pftNonZero,
+                                         ClipperLib::pftNonZero);
+      mCachedPaths["board_area"] = ClipperHelpers::flattenTree(*tree);
+      tree = ClipperHelpers::subtractToTree(boardOutlines, allHoles,
+                                            ClipperLib::pftNonZero,
+                                            ClipperLib::pftNonZero, false);
+      const ClipperLib::Paths boardEdges = ClipperHelpers::treeToPaths(*tree);
+      publishTriangleData(
+          layers.first(), QColor(70, 80, 70),
+          extrude(mCachedPaths["board_area"], -d, 2 * d, scaleFactor, true,
+                  false) +
+              extrude(boardEdges, -d, 2 * d, scaleFactor, false, true, false));
+    }
+    const ClipperLib::Paths boardArea = mCachedPaths.value("board_area");
     if (mAbort) return;
 
     // Plated holes.
-    tree = ClipperHelpers::intersectToTree(platedHoles, boardOutlines,
-                                           ClipperLib::pftNonZero,
-                                           ClipperLib::pftNonZero, false);
-    platedHoles = ClipperHelpers::treeToPaths(*tree);
-    publishTriangleData(
-        "pth", QColor(124, 104, 71),
-        extrude(platedHoles, -d, 2 * d, scaleFactor, false, true, false));
+    if (needsRebuild("pth", calcHash({&platedHoles, &boardOutlines},
+                                     {d, scaleFactor}))) {
+      std::unique_ptr<ClipperLib::PolyTree> tree =
+          ClipperHelpers::intersectToTree(platedHoles, boardOutlines,
+                                          ClipperLib::pftNonZero,
+                                          ClipperLib::pftNonZero, false);
+      platedHoles = ClipperHelpers::treeToPaths(*tree);
+      publishTriangleData(
+          "pth", QColor(124, 104, 71),
+          extrude(platedHoles, -d, 2 * d, scaleFactor, false, true, false));
+    }
     if (mAbort) return;
 
     // Non-plated holes.
-    tree = ClipperHelpers::intersectToTree(nonPlatedHoles, boardOutlines,
-                                           ClipperLib::pftNonZero,
-                                           ClipperLib::pftNonZero, false);
-    nonPlatedHoles = ClipperHelpers::treeToPaths(*tree);
-    publishTriangleData(
-        "npth", QColor(50, 50, 50),
-        extrude(nonPlatedHoles, -d, 2 * d, scaleFactor, false, true, false));
+    if (needsRebuild("npth", calcHash({&nonPlatedHoles, &boardOutlines},
+                                      {d, scaleFactor}))) {
+      std::unique_ptr<ClipperLib::PolyTree> tree =
+          ClipperHelpers::intersectToTree(nonPlatedHoles, boardOutlines,
+                                          ClipperLib::pftNonZero,
+                                          ClipperLib::pftNonZero, false);
+      nonPlatedHoles = ClipperHelpers::treeToPaths(*tree);
+      publishTriangleData(
+          "npth", QColor(50, 50, 50),
+          extrude(nonPlatedHoles, -d, 2 * d, scaleFactor, false, true, false));
+    }
     if (mAbort) return;
 
     for (bool top : {false, true}) {
@@ -190,55 +221,79 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
 
       // Copper.
       layers = QStringList{transform.map(Layer::topCopper()).getId()};
-      ClipperLib::Paths copperArea = boardArea;
-      if (copperHoles.contains(layers.first())) {
-        ClipperHelpers::subtract(copperArea, copperHoles[layers.first()],
-                                 ClipperLib::pftEvenOdd,
-                                 ClipperLib::pftNonZero);
+      ClipperLib::Paths paths = getPaths(data, layers);
+      const ClipperLib::Paths holes = copperHoles.value(layers.first());
+      if (needsRebuild(layers.first(),
+                       calcHash({&boardArea, &holes, &paths},
+                                {d, side, scaleFactor}))) {
+        ClipperLib::Paths copperArea = boardArea;
+        if (!holes.empty()) {
+          ClipperHelpers::subtract(copperArea, holes, ClipperLib::pftEvenOdd,
+                                   ClipperLib::pftNonZero);
+        }
+        std::unique_ptr<ClipperLib::PolyTree> tree =
+            ClipperHelpers::intersectToTree(copperArea, paths,
+                                            ClipperLib::pftEvenOdd,
+                                            ClipperLib::pftNonZero);
+        paths = ClipperHelpers::flattenTree(*tree);
+        publishTriangleData(
+            layers.first(), QColor(188, 156, 105),
+            extrude(paths, (d - 0.001) * side, 0.035 * side, scaleFactor));
       }
-      tree = ClipperHelpers::intersectToTree(copperArea, getPaths(data, layers),
-                                             ClipperLib::pftEvenOdd,
-                                             ClipperLib::pftNonZero);
-      ClipperLib::Paths paths = ClipperHelpers::flattenTree(*tree);
-      publishTriangleData(
-          layers.first(), QColor(188, 156, 105),
-          extrude(paths, (d - 0.001) * side, 0.035 * side, scaleFactor));
       if (mAbort) return;
 
       // Solder resist.
       layers = QStringList{transform.map(Layer::topStopMask()).getId(),
                            Layer::boardCutouts().getId(),
                            Layer::boardPlatedCutouts().getId()};
-      ClipperLib::Paths solderResist;
-      if (const PcbColor* color = data->getSolderResist()) {
-        solderResist = boardOutlines;
-        ClipperHelpers::subtract(solderResist, getPaths(data, layers),
-                                 ClipperLib::pftEvenOdd,
-                                 ClipperLib::pftNonZero);
-        // Shrink the solder resist very slightly to give copper the higher
-        // priority if copper edges and solder resist edges are exactly
-        // overlapping (also avoids ugly rendering due to faces within the same
-        // 3D plane).
-        tree = ClipperHelpers::offsetToTree(solderResist, Length(-50),
-                                            mMaxArcTolerance);
-        solderResist = ClipperHelpers::flattenTree(*tree);
-        publishTriangleData(layers.first(), color->toSolderResistColor(),
-                            extrude(solderResist, (d + 0.001) * side,
-                                    0.05 * side, scaleFactor));
-      } else {
-        publishTriangleData(layers.first(), Qt::transparent, {});
+      const PcbColor* solderResistColor = data->getSolderResist();
+      paths = getPaths(data, layers);
+      if (needsRebuild(layers.first(),
+                       calcHash({&boardOutlines, &paths},
+                                {d, side, scaleFactor},
+                                solderResistColor
+                                    ? solderResistColor->getId()
+                                    : QString()))) {
+        ClipperLib::Paths& solderResist = mCachedPaths[layers.first()];
+        if (solderResistColor) {
+          solderResist = boardOutlines;
+          ClipperHelpers::subtract(solderResist, paths, ClipperLib::pftEvenOdd,
+                                   ClipperLib::pftNonZero);
+          // Shrink the solder resist very slightly to give copper the higher
+          // priority if copper edges and solder resist edges are exactly
+          // overlapping (also avoids ugly rendering due to faces within the
+          // same 3D plane).
+          std::unique_ptr<ClipperLib::PolyTree> tree =
+              ClipperHelpers::offsetToTree(solderResist, Length(-50),
+                                           mMaxArcTolerance);
+          solderResist = ClipperHelpers::flattenTree(*tree);
+          publishTriangleData(layers.first(),
+                              solderResistColor->toSolderResistColor(),
+                              extrude(solderResist, (d + 0.001) * side,
+                                      0.05 * side, scaleFactor));
+        } else {
+          solderResist.clear();
+          publishTriangleData(layers.first(), Qt::transparent, {});
+        }
       }
+      const ClipperLib::Paths solderResist =
+          mCachedPaths.value(layers.first());
       if (mAbort) return;
 
       // Solder paste.
       layers = QStringList{transform.map(Layer::topSolderPaste()).getId()};
-      tree = ClipperHelpers::intersectToTree(boardArea, getPaths(data, layers),
-                                             ClipperLib::pftEvenOdd,
-                                             ClipperLib::pftNonZero);
-      paths = ClipperHelpers::flattenTree(*tree);
-      publishTriangleData(
-          layers.first(), Qt::darkGray,
-          extrude(paths, (d + 0.036) * side, 0.03 * side, scaleFactor));
+      paths = getPaths(data, layers);
+      if (needsRebuild(layers.first(), calcHash({&boardArea, &paths},
+                                                {d, side, scaleFactor}))) {
+        std::unique_ptr<ClipperLib::PolyTree> tree =
+            ClipperHelpers::intersectToTree(boardArea, paths,
+                                            ClipperLib::pftEvenOdd,
+                                            ClipperLib::pftNonZero);
+        paths = ClipperHelpers::flattenTree(*tree);
+        publishTriangleData(
+            layers.first(), Qt::darkGray,
+            extrude(paths, (d + 0.036) * side, 0.03 * side, scaleFactor));
+      }
       if (mAbort) return;
 
       // Silkscreen.
@@ -248,30 +303,108 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
                    : data->getSilkscreenLayersBot()) {
         layers.append(layer->getId());
       }
-      if (const PcbColor* color = data->getSilkscreen()) {
-        tree = ClipperHelpers::intersectToTree(
-            solderResist, getPaths(data, layers), ClipperLib::pftEvenOdd,
-            ClipperLib::pftNonZero);
-        paths = ClipperHelpers::flattenTree(*tree);
-        publishTriangleData(
-            transform.map(Layer::topLegend()).getId(),
-            color->toSilkscreenColor(),
-            extrude(paths, (d + 0.052) * side, 0.01 * side, scaleFactor));
-      } else {
-        publishTriangleData(transform.map(Layer::topLegend()).getId(),
-                            Qt::transparent, {});
+      const QString silkscreenId = transform.map(Layer::topLegend()).getId();
+      const PcbColor* silkscreenColor = data->getSilkscreen();
+      paths = getPaths(data, layers);
+      if (needsRebuild(silkscreenId,
+                       calcHash({&solderResist, &paths}, {d, side, scaleFactor},
+                                silkscreenColor ? silkscreenColor->getId()
+                                                : QString()))) {
+        if (silkscreenColor) {
+          std::unique_ptr<ClipperLib::PolyTree> tree =
+              ClipperHelpers::intersectToTree(solderResist, paths,
+                                              ClipperLib::pftEvenOdd,
+                                              ClipperLib::pftNonZero);
+          paths = ClipperHelpers::flattenTree(*tree);
+          publishTriangleData(
+              silkscreenId, silkscreenColor->toSilkscreenColor(),
+              extrude(paths, (d + 0.052) * side, 0.01 * side, scaleFactor));
+        } else {
+          publishTriangleData(silkscreenId, Qt::transparent, {});
+        }
       }
       if (mAbort) return;
     }
 
-    // Add/update devices.
+    // Add/update devices. Loading and tesselating the STEP models is slow,
+    // thus all (not yet cached) models are processed concurrently and every
+    // device is published as soon as its model is ready. Note that reading
+    // the STEP files is serialized by OccModel::loadStep().
     QSet<Uuid> deviceUuids;
     if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
+      QMutex mutex;
+      QWaitCondition modelLoaded;
+      QHash<QByteArray, StepModel> loadedModels;  // Protected by mutex.
+
+      // Make sure all workers have finished before leaving this scope since
+      // they access the local variables.
+      QVector<QFuture<void>> futures;
+      auto futuresGuard = Concurrency::waitOnScopeExit(futures);
+
+      // Note: Models are identified by the hash of their content to avoid
+      // keeping the (potentially large) STEP files in memory.
+      QList<std::pair<const SceneData3D::DeviceData*, QByteArray>> pending;
+      QSet<QByteArray> loadingModels;
+      QHash<QString, QByteArray> fileHashes;  // Read each file only once.
       for (const auto& obj : data->getDevices()) {
+        if (fileHashes.contains(obj.stepFile)) {
+          pending.append(std::make_pair(&obj, fileHashes.value(obj.stepFile)));
+          deviceUuids.insert(obj.uuid);
+          continue;
+        }
         const QByteArray content = fs->readIfExists(obj.stepFile);
-        publishDevice(obj, content, d + 0.067, scaleFactor,
-                      data->getStepAlphaValue());
+        const QByteArray hash =
+            QCryptographicHash::hash(content, QCryptographicHash::Sha256);
+        fileHashes.insert(obj.stepFile, hash);
+        if ((!mStepModels.contains(hash)) && (!loadingModels.contains(hash))) {
+          const QString name = obj.name;
+          futures.append(
+              QtConcurrent::run(&mThreadPool, [&, content, hash, name]() {
+                const StepModel model = mAbort
+                    ? StepModel()
+                    : loadStepModel(content, hash, name);
+                QMutexLocker lock(&mutex);
+                loadedModels.insert(hash, model);
+                modelLoaded.wakeAll();
+              }));
+          loadingModels.insert(hash);
+        }
+        pending.append(std::make_pair(&obj, hash));
         deviceUuids.insert(obj.uuid);
+      }
+
+      while (!pending.isEmpty()) {
+        {
+          QMutexLocker lock(&mutex);
+          for (auto it = loadedModels.begin(); it != loadedModels.end(); it++) {
+            StepMeshes meshes;
+            qint64 bytes = 0;
+            for (auto m = it.value().begin(); m != it.value().end(); m++) {
+              // Many devices are small on screen, so provide a low detail
+              // mesh for them too.
+              meshes.insert(m.key(), std::make_shared<OpenGlTriangleMesh>(
+                                         m.value(), true));
+              bytes += m.value().count() * sizeof(QVector3D);
+            }
+            mStepModels.insert(it.key(), meshes);
+            mStepModelsMemory.add(1, bytes);
+          }
+          loadedModels.clear();
+        }
+        for (auto it = pending.begin(); it != pending.end();) {
+          if (mStepModels.contains(it->second)) {
+            publishDevice(*it->first, it->second, d + 0.067, scaleFactor,
+                          data->getStepAlphaValue());
+            it = pending.erase(it);
+          } else {
+            ++it;
+          }
+          if (mAbort) return;
+        }
+        QMutexLocker lock(&mutex);
+        if ((!pending.isEmpty()) && loadedModels.isEmpty()) {
+          modelLoaded.wait(&mutex, 100);  // Timeout to check mAbort.
+        }
         if (mAbort) return;
       }
     }
@@ -281,12 +414,14 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
       foreach (auto obj, mDevices.take(uuid)) {
         emit objectRemoved(obj);
       }
+      mInputHashes.remove("device:" % uuid.toStr());
     }
 
     qDebug() << "Successfully built 3D scene in" << timer.elapsed() << "ms.";
   } catch (const Exception& e) {
     qCritical().noquote() << "Failed to build 3D scene after" << timer.elapsed()
                           << "ms:" << e.getMsg();
+    mInputHashes.clear();  // Some objects might not have been published.
     errorMsg = QStringList{errorMsg, e.getMsg()}.join("\n\n");
   }
 }
@@ -411,24 +546,8 @@ void OpenGlSceneBuilder::publishTriangleData(
 }
 
 void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
-                                       const QByteArray& stepContent, qreal z,
+                                       const QByteArray& modelHash, qreal z,
                                        qreal scaleFactor, qreal alpha) {
-  StepModel model;
-  if (mStepModels.contains(stepContent)) {
-    model = mStepModels.value(stepContent);
-  } else {
-    if (stepContent.size()) {
-      try {
-        std::unique_ptr<OccModel> occModel = OccModel::loadStep(stepContent);
-        model = occModel->tesselate();
-      } catch (const Exception& e) {
-        qCritical().nospace()
-            << "Failed to draw 3D model of " << obj.name << ": " << e.getMsg();
-      }
-    }
-    mStepModels.insert(stepContent, model);
-  }
-
   QMatrix4x4 m;
   m.scale(scaleFactor);
   m.translate(obj.transform.getPosition().getX().toMm(),
@@ -445,18 +564,26 @@ void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
   m.rotate(std::get<1>(obj.stepRotation).toDeg(), 0, 1, 0);
   m.rotate(std::get<0>(obj.stepRotation).toDeg(), 1, 0, 0);
 
+  // Skip the device if neither its model nor its placement has changed.
+  const QByteArray inputHash = modelHash %
+      QByteArray(reinterpret_cast<const char*>(m.constData()),
+                 16 * sizeof(float)) %
+      QByteArray::number(alpha);
+  if (!needsRebuild("device:" % obj.uuid.toStr(), inputHash)) {
+    return;
+  }
+
+  const StepMeshes meshes = mStepModels.value(modelHash);
   QMap<Color, std::shared_ptr<OpenGlTriangleObject>>& items =
       mDevices[obj.uuid];
   foreach (const Color& color, items.keys()) {
-    if (!model.contains(color)) {
+    if (!meshes.contains(color)) {
       emit objectRemoved(items.take(color));
     }
   }
-  for (auto it = model.begin(); it != model.end(); it++) {
-    QVector<QVector3D> vertices = it.value();
-    for (auto& vertex : vertices) {
-      vertex = m.map(vertex);
-    }
+  for (auto it = meshes.begin(); it != meshes.end(); it++) {
+    // Note: The mesh is shared by all devices using the same model, the
+    // device placement is applied by the GPU.
     std::shared_ptr<OpenGlTriangleObject> obj = items.value(it.key());
     QColor color = QColor::fromRgbF(
         std::get<0>(it.key()), std::get<1>(it.key()), std::get<2>(it.key()));
@@ -464,17 +591,124 @@ void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
       color.setAlphaF(alpha);
     }
     if (obj) {
-      obj->setData(color, vertices);
+      obj->setData(color, it.value(), m);
       emit objectUpdated(obj);
     } else {
       obj = std::make_shared<OpenGlTriangleObject>();
-      obj->setData(color, vertices);
+      obj->setData(color, it.value(), m);
       items[it.key()] = obj;
       emit objectAdded(obj);
     }
   }
 }
 
+bool OpenGlSceneBuilder::needsRebuild(const QString& id,
+                                      const QByteArray& inputHash) noexcept {
+  auto it = mInputHashes.find(id);
+  if ((it != mInputHashes.end()) && (it.value() == inputHash)) {
+    return false;
+  }
+  mInputHashes[id] = inputHash;
+  return true;
+}
+
+QByteArray OpenGlSceneBuilder::calcHash(
+    const QVector<const ClipperLib::Paths*>& paths,
+    const QVector<qreal>& values, const QString& str) noexcept {
+  CacheKeyBuilder builder(QCryptographicHash::Sha256);
+  foreach (const ClipperLib::Paths* p, paths) {
+    builder.addPaths(*p);
+  }
+  foreach (qreal value, values) {
+    builder.addReal(value);
+  }
+  builder.addString(str);
+  return builder.getResult();
+}
+
+OpenGlSceneBuilder::StepModel OpenGlSceneBuilder::loadStepModel(
+    const QByteArray& stepContent, const QByteArray& hash,
+    const QString& name) noexcept {
+  // Loading and tesselating STEP models is very slow, thus the result is
+  // cached on disk to speed up opening the 3D view in later sessions.
+  StepModel model;
+  if (stepContent.size()) {
+    const FilePath cacheFp = getStepModelCacheFilePath(hash);
+    if (tl::optional<StepModel> cached = loadStepModelFromCache(cacheFp)) {
+      model = *cached;
+    } else {
+      try {
+        std::unique_ptr<OccModel> occModel = OccModel::loadStep(stepContent);
+        model = occModel->tesselate();
+        saveStepModelToCache(cacheFp, model);
+      } catch (const Exception& e) {
+        qCritical().nospace()
+            << "Failed to draw 3D model of " << name << ": " << e.getMsg();
+      }
+    }
+  }
+  return model;
+}
+
+FilePath OpenGlSceneBuilder::getStepModelCacheFilePath(
+    const QByteArray& hash) noexcept {
+  return Application::getCacheDir().getPathTo("3d/" % hash.toHex() % ".mesh");
+}
+
+tl::optional<OpenGlSceneBuilder::StepModel>
+    OpenGlSceneBuilder::loadStepModelFromCache(const FilePath& fp) noexcept {
+  if (!fp.isExistingFile()) {
+    return tl::nullopt;
+  }
+
+  try {
+    const QByteArray content = FileUtils::readFile(fp);  // can throw
+    QDataStream stream(content);
+    stream.setVersion(QDataStream::Qt_5_5);
+    QByteArray format;
+    QString occVersion;
+    quint32 count = 0;
+    stream >> format >> occVersion >> count;
+    if ((format != sStepModelCacheFormat) ||
+        (occVersion != OccModel::getOccVersionString())) {
+      return tl::nullopt;  // Created by another application version.
+    }
+    StepModel model;
+    for (quint32 i = 0; i < count; ++i) {
+      qreal r, g, b;
+      QVector<QVector3D> vertices;
+      stream >> r >> g >> b >> vertices;
+      model.insert(std::make_tuple(r, g, b), vertices);
+    }
+    if ((stream.status() != QDataStream::Ok) || (!stream.atEnd())) {
+      throw RuntimeError(__FILE__, __LINE__, "Corrupt 3D model cache file.");
+    }
+    return model;
+  } catch (const Exception& e) {
+    qWarning() << "Failed to load cached 3D model:" << e.getMsg();
+    return tl::nullopt;
+  }
+}
+
+void OpenGlSceneBuilder::saveStepModelToCache(const FilePath& fp,
+                                              const StepModel& model) noexcept {
+  try {
+    QByteArray content;
+    QDataStream stream(&content, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_5);
+    stream << QByteArray(sStepModelCacheFormat)
+           << OccModel::getOccVersionString()
+           << static_cast<quint32>(model.count());
+    for (auto it = model.begin(); it != model.end(); it++) {
+      stream << std::get<0>(it.key()) << std::get<1>(it.key())
+             << std::get<2>(it.key()) << it.value();
+    }
+    FileUtils::writeFile(fp, content);  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to cache 3D model:" << e.getMsg();
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -24,6 +24,8 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/core/3d/scenedata3d.h>
+#include <librepcb/core/fileio/filepath.h>
+#include <librepcb/core/memoryaccounting.h>
 #include <polyclipping/clipper.hpp>
 
 #include <QtCore>
@@ -37,6 +39,7 @@ namespace librepcb {
 namespace editor {
 
 class OpenGlObject;
+class OpenGlTriangleMesh;
 class OpenGlTriangleObject;
 
 /*******************************************************************************
@@ -53,6 +56,7 @@ public:
   // Types
   typedef std::tuple<qreal, qreal, qreal> Color;
   typedef QMap<Color, QVector<QVector3D>> StepModel;
+  typedef QMap<Color, std::shared_ptr<OpenGlTriangleMesh>> StepMeshes;
 
   // Constructors / Destructor
   OpenGlSceneBuilder(QObject* parent = nullptr) noexcept;
@@ -106,18 +110,34 @@ private:  // Methods
   void publishTriangleData(const QString& id, const QColor& color,
                            const QVector<QVector3D>& triangles);
   void publishDevice(const SceneData3D::DeviceData& obj,
-                     const QByteArray& stepContent, qreal z, qreal scaleFactor,
+                     const QByteArray& modelHash, qreal z, qreal scaleFactor,
                      qreal alpha);
+  bool needsRebuild(const QString& id, const QByteArray& inputHash) noexcept;
+  static QByteArray calcHash(const QVector<const ClipperLib::Paths*>& paths,
+                             const QVector<qreal>& values,
+                             const QString& str = QString()) noexcept;
+  static StepModel loadStepModel(const QByteArray& stepContent,
+                                 const QByteArray& hash,
+                                 const QString& name) noexcept;
+  static FilePath getStepModelCacheFilePath(const QByteArray& hash) noexcept;
+  static tl::optional<StepModel> loadStepModelFromCache(
+      const FilePath& fp) noexcept;
+  static void saveStepModelToCache(const FilePath& fp,
+                                   const StepModel& model) noexcept;
 
 private:  // Data
   const PositiveLength mMaxArcTolerance;
   QFuture<void> mFuture;
   bool mAbort;
+  QThreadPool mThreadPool;  ///< For loading STEP models
 
   // Thread data.
   QHash<QString, std::shared_ptr<OpenGlTriangleObject>> mBoardObjects;
   QHash<Uuid, QMap<Color, std::shared_ptr<OpenGlTriangleObject>>> mDevices;
-  QHash<QByteArray, StepModel> mStepModels;  ///< Cache
+  QHash<QByteArray, StepMeshes> mStepModels;  ///< Cache (key: SHA-256)
+  MemoryAccounting::Counter mStepModelsMemory;
+  QHash<QString, QByteArray> mInputHashes;  ///< Key: Object ID
+  QHash<QString, ClipperLib::Paths> mCachedPaths;  ///< Intermediate results
 };
 
 /*******************************************************************************
@@ -25,6 +25,9 @@
 #include <QtCore>
 #include <QtOpenGL>
 
+#include <limits>
+#include <map>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -32,56 +35,192 @@ namespace librepcb {
 namespace editor {
 
 /*******************************************************************************
- *  Constructors / Destructor
+ *  Class OpenGlTriangleMesh
  ******************************************************************************/
 
-OpenGlTriangleObject::OpenGlTriangleObject() noexcept
+OpenGlTriangleMesh::OpenGlTriangleMesh(const QVector<QVector3D>& triangles,
+                                       bool createLowDetailMesh) noexcept
   : mBuffer(QOpenGLBuffer::VertexBuffer),
     mCount(0),
+    mMinimum(),
+    mMaximum(),
+    mLowDetailMesh(),
     mMutex(),
-    mColor(Qt::black),
-    mNewTriangles() {
+    mNewTriangles(triangles) {
+  if (!triangles.isEmpty()) {
+    mMinimum = mMaximum = triangles.first();
+    for (const QVector3D& v : triangles) {
+      mMinimum = QVector3D(std::min(mMinimum.x(), v.x()),
+                           std::min(mMinimum.y(), v.y()),
+                           std::min(mMinimum.z(), v.z()));
+      mMaximum = QVector3D(std::max(mMaximum.x(), v.x()),
+                           std::max(mMaximum.y(), v.y()),
+                           std::max(mMaximum.z(), v.z()));
+    }
+  }
+
+  // Only worth the memory if the simplification removes a lot of triangles.
+  if (createLowDetailMesh && (triangles.count() > 3000)) {
+    const QVector3D size = mMaximum - mMinimum;
+    const qreal extent = std::max({size.x(), size.y(), size.z()});
+    const QVector<QVector3D> simplified = simplify(triangles, extent / 24);
+    if ((!simplified.isEmpty()) &&
+        (simplified.count() < (triangles.count() / 2))) {
+      mLowDetailMesh = std::make_shared<OpenGlTriangleMesh>(simplified);
+    }
+  }
 }
 
-OpenGlTriangleObject::~OpenGlTriangleObject() noexcept {
+OpenGlTriangleMesh::~OpenGlTriangleMesh() noexcept {
   mBuffer.destroy();
 }
 
+int OpenGlTriangleMesh::bind() noexcept {
+  QMutexLocker lock(&mMutex);
+  if (!mBuffer.isCreated()) {
+    mBuffer.create();
+  }
+  mBuffer.bind();
+  if (mNewTriangles) {
+    mBuffer.allocate(mNewTriangles->data(),
+                     mNewTriangles->count() * sizeof(QVector3D));
+    mCount = mNewTriangles->count();
+    mNewTriangles = tl::nullopt;
+  }
+  return mCount;
+}
+
+QVector<QVector3D> OpenGlTriangleMesh::simplify(
+    const QVector<QVector3D>& triangles, qreal cellSize) noexcept {
+  QVector<QVector3D> result;
+  if (triangles.isEmpty() || (!(cellSize > 0))) {
+    return result;
+  }
+
+  // Every vertex is replaced by the first vertex found in its grid cell.
+  std::map<std::tuple<int, int, int>, QVector3D> clusters;
+  auto snap = [&](const QVector3D& v) {
+    const std::tuple<int, int, int> key =
+        std::make_tuple(qFloor(v.x() / cellSize), qFloor(v.y() / cellSize),
+                        qFloor(v.z() / cellSize));
+    return clusters.insert(std::make_pair(key, v)).first->second;
+  };
+  result.reserve(triangles.count() / 2);
+  for (int i = 2; i < triangles.count(); i += 3) {
+    const QVector3D p1 = snap(triangles.at(i - 2));
+    const QVector3D p2 = snap(triangles.at(i - 1));
+    const QVector3D p3 = snap(triangles.at(i));
+    if ((p1 != p2) && (p2 != p3) && (p3 != p1)) {
+      result.append(p1);
+      result.append(p2);
+      result.append(p3);
+    }
+  }
+  return result;
+}
+
 /*******************************************************************************
- *  General Methods
+ *  Class OpenGlTriangleObject
  ******************************************************************************/
 
+OpenGlTriangleObject::OpenGlTriangleObject() noexcept
+  : mMesh(), mMutex(), mColor(Qt::black), mTransform(), mNewMesh() {
+}
+
+OpenGlTriangleObject::~OpenGlTriangleObject() noexcept {
+}
+
 void OpenGlTriangleObject::setData(const QColor& color,
                                    const QVector<QVector3D>& data) noexcept {
+  setData(color, std::make_shared<OpenGlTriangleMesh>(data), QMatrix4x4());
+}
+
+void OpenGlTriangleObject::setData(const QColor& color,
+                                   std::shared_ptr<OpenGlTriangleMesh> mesh,
+                                   const QMatrix4x4& transform) noexcept {
   QMutexLocker lock(&mMutex);
   mColor = color;
-  mNewTriangles = data;
+  mTransform = transform;
+  mNewMesh = mesh;
 }
 
-void OpenGlTriangleObject::draw(QOpenGLFunctions& gl,
-                                QOpenGLShaderProgram& program) noexcept {
-  // Update buffer, if needed.
+bool OpenGlTriangleObject::draw(QOpenGLFunctions& gl,
+                                QOpenGLShaderProgram& program,
+                                const QMatrix4x4& viewProjection,
+                                const QSizeF& viewportSize) noexcept {
+  QColor color;
+  QMatrix4x4 transform;
   {
     QMutexLocker lock(&mMutex);
-    if (!mBuffer.isCreated()) {
-      mBuffer.create();
+    if (mNewMesh) {
+      // Note: Release the old mesh here since its buffer has to be destroyed
+      // in the OpenGL thread.
+      mMesh = mNewMesh;
+      mNewMesh.reset();
     }
-    mBuffer.bind();
-    if (mNewTriangles) {
-      mBuffer.allocate(mNewTriangles->data(),
-                       mNewTriangles->count() * sizeof(QVector3D));
-      mCount = mNewTriangles->count();
-      mNewTriangles = tl::nullopt;
+    color = mColor;
+    transform = mTransform;
+  }
+  if (!mMesh) {
+    return false;
+  }
+
+  // Skip the object if its bounding box is completely outside of any clipping
+  // plane of the view frustum or if it is too small to be visible. Small
+  // objects are drawn with the low detail mesh, if available.
+  const QMatrix4x4 mvp = viewProjection * transform;
+  const QVector3D& min = mMesh->getMinimum();
+  const QVector3D& max = mMesh->getMaximum();
+  int outside[6] = {0, 0, 0, 0, 0, 0};
+  bool allInFront = true;
+  qreal left = std::numeric_limits<qreal>::max(), right = -left;
+  qreal bottom = left, top = -left;
+  for (int i = 0; i < 8; ++i) {
+    const QVector4D p = mvp *
+        QVector4D((i & 1) ? max.x() : min.x(), (i & 2) ? max.y() : min.y(),
+                  (i & 4) ? max.z() : min.z(), 1);
+    if (p.x() < -p.w()) ++outside[0];
+    if (p.x() > p.w()) ++outside[1];
+    if (p.y() < -p.w()) ++outside[2];
+    if (p.y() > p.w()) ++outside[3];
+    if (p.z() < -p.w()) ++outside[4];
+    if (p.z() > p.w()) ++outside[5];
+    if (p.w() > 0) {
+      left = std::min(left, qreal(p.x() / p.w()));
+      right = std::max(right, qreal(p.x() / p.w()));
+      bottom = std::min(bottom, qreal(p.y() / p.w()));
+      top = std::max(top, qreal(p.y() / p.w()));
+    } else {
+      allInFront = false;
+    }
+  }
+  for (int count : outside) {
+    if (count == 8) {
+      return false;
+    }
+  }
+  OpenGlTriangleMesh* mesh = mMesh.get();
+  if (allInFront) {
+    // Note: Normalized device coordinates range from -1 to 1.
+    const qreal sizePx = std::max((right - left) * viewportSize.width(),
+                                  (top - bottom) * viewportSize.height()) /
+        2;
+    if (sizePx < sMinVisibleSizePx) {
+      return false;
+    } else if ((sizePx < sLowDetailSizePx) && mesh->getLowDetailMesh()) {
+      mesh = mesh->getLowDetailMesh().get();
     }
   }
 
-  program.setAttributeValue("a_color", mColor);
+  program.setAttributeValue("a_color", color);
+  program.setUniformValue("model_matrix", transform);
 
-  mBuffer.bind();
+  const int count = mesh->bind();
   int vertexLocation = program.attributeLocation("a_position");
   program.enableAttributeArray(vertexLocation);
   program.setAttributeBuffer(vertexLocation, GL_FLOAT, 0, 3, sizeof(QVector3D));
-  gl.glDrawArrays(GL_TRIANGLES, 0, mCount);
+  gl.glDrawArrays(GL_TRIANGLES, 0, count);
+  return true;
 }
 
 /*******************************************************************************
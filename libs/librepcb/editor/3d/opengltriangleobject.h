@@ -30,12 +30,85 @@
 #include <QtCore>
 #include <QtOpenGL>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 namespace editor {
 
+/*******************************************************************************
+ *  Class OpenGlTriangleMesh
+ ******************************************************************************/
+
+/**
+ * @brief Immutable triangle vertex buffer which can be shared by objects
+ *
+ * Allows drawing the same 3D model several times (e.g. many devices with the
+ * same package) while uploading its vertices to the GPU only once.
+ */
+class OpenGlTriangleMesh final {
+public:
+  // Constructors / Destructor
+  OpenGlTriangleMesh() = delete;
+  OpenGlTriangleMesh(const OpenGlTriangleMesh& other) = delete;
+  explicit OpenGlTriangleMesh(const QVector<QVector3D>& triangles,
+                              bool createLowDetailMesh = false) noexcept;
+  ~OpenGlTriangleMesh() noexcept;
+
+  // Getters
+  const QVector3D& getMinimum() const noexcept { return mMinimum; }
+  const QVector3D& getMaximum() const noexcept { return mMaximum; }
+
+  /**
+   * @brief Get the simplified mesh to be drawn if the object is small
+   *
+   * @return The low detail mesh, or `nullptr` if there is none.
+   */
+  const std::shared_ptr<OpenGlTriangleMesh>& getLowDetailMesh() const noexcept {
+    return mLowDetailMesh;
+  }
+
+  // General Methods
+
+  /**
+   * @brief Bind the vertex buffer (must be called from the OpenGL thread)
+   *
+   * @return Number of vertices in the buffer.
+   */
+  int bind() noexcept;
+
+  // Operator Overloadings
+  OpenGlTriangleMesh& operator=(const OpenGlTriangleMesh& rhs) = delete;
+
+  // Static Methods
+
+  /**
+   * @brief Simplify triangles by clustering vertices on a grid
+   *
+   * All vertices within the same grid cell are merged into one, and
+   * triangles which became degenerated are removed.
+   *
+   * @param triangles   The triangles to simplify.
+   * @param cellSize    Grid size (in the same unit as the vertices).
+   *
+   * @return The simplified triangles.
+   */
+  static QVector<QVector3D> simplify(const QVector<QVector3D>& triangles,
+                                     qreal cellSize) noexcept;
+
+private:  // Data
+  QOpenGLBuffer mBuffer;
+  int mCount;
+  QVector3D mMinimum;  ///< Minimum corner of the bounding box
+  QVector3D mMaximum;  ///< Maximum corner of the bounding box
+  std::shared_ptr<OpenGlTriangleMesh> mLowDetailMesh;
+
+  QMutex mMutex;
+  tl::optional<QVector<QVector3D>> mNewTriangles;
+};
+
 /*******************************************************************************
  *  Class OpenGlTriangleObject
  ******************************************************************************/
@@ -52,19 +125,26 @@ public:
 
   // General Methods
   void setData(const QColor& color, const QVector<QVector3D>& data) noexcept;
-  virtual void draw(QOpenGLFunctions& gl,
-                    QOpenGLShaderProgram& program) noexcept override;
+  void setData(const QColor& color, std::shared_ptr<OpenGlTriangleMesh> mesh,
+               const QMatrix4x4& transform) noexcept;
+  virtual bool draw(QOpenGLFunctions& gl, QOpenGLShaderProgram& program,
+                    const QMatrix4x4& viewProjection,
+                    const QSizeF& viewportSize) noexcept override;
 
   // Operator Overloadings
   OpenGlTriangleObject& operator=(const OpenGlTriangleObject& rhs) = delete;
 
 private:  // Data
-  QOpenGLBuffer mBuffer;
-  int mCount;
+  std::shared_ptr<OpenGlTriangleMesh> mMesh;
 
   QMutex mMutex;
   QColor mColor;
-  tl::optional<QVector<QVector3D>> mNewTriangles;
+  QMatrix4x4 mTransform;
+  std::shared_ptr<OpenGlTriangleMesh> mNewMesh;
+
+  // Static Variables
+  static constexpr qreal sMinVisibleSizePx = 1;  ///< Smaller ones are culled
+  static constexpr qreal sLowDetailSizePx = 48;  ///< Below, use low detail
 };
 
 /*******************************************************************************
@@ -27,6 +27,7 @@
 
 #include <librepcb/core/3d/occmodel.h>
 #include <librepcb/core/application.h>
+#include <librepcb/core/memoryaccounting.h>
 #include <librepcb/core/systeminfo.h>
 
 #include <QtCore>
@@ -191,6 +192,13 @@ AboutDialog::AboutDialog(const WorkspaceSettings& settings,
   if (!SystemInfo::detectRuntime().isEmpty()) {
     details << "Runtime:          " + SystemInfo::detectRuntime();
   }
+  const QStringList memoryUsage = MemoryAccounting::instance().getReport();
+  if (!memoryUsage.isEmpty()) {
+    details << "" << "Memory Usage:";
+    foreach (const QString& line, memoryUsage) {
+      details << "  " + line;
+    }
+  }
   mUi->txtDetails->setPlainText(details.join("\n"));
 }
 
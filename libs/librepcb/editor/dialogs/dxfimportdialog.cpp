@@ -27,7 +27,9 @@
 #include "ui_dxfimportdialog.h"
 
 #include <librepcb/core/types/layer.h>
+#include <librepcb/core/utils/tangentpathjoiner.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -80,6 +82,8 @@ DxfImportDialog::DxfImportDialog(const QSet<const Layer*>& layers,
         clientSettings.value(settingsPrefix % "/pos_x", "0").toString()));
     mUi->edtPosY->setValue(Length::fromMm(
         clientSettings.value(settingsPrefix % "/pos_y", "0").toString()));
+    mUi->edtDxfLayers->setText(
+        clientSettings.value(settingsPrefix % "/dxf_layers").toString());
     mUi->cbxJoinTangentPolylines->setChecked(
         clientSettings.value(settingsPrefix % "/join_tangent_polylines", true)
             .toBool());
@@ -109,6 +113,8 @@ DxfImportDialog::~DxfImportDialog() noexcept {
                           mUi->edtPosX->getValue().toMmString());
   clientSettings.setValue(mSettingsPrefix % "/pos_y",
                           mUi->edtPosY->getValue().toMmString());
+  clientSettings.setValue(mSettingsPrefix % "/dxf_layers",
+                          mUi->edtDxfLayers->text());
   clientSettings.setValue(mSettingsPrefix % "/join_tangent_polylines",
                           mUi->cbxJoinTangentPolylines->isChecked());
   clientSettings.setValue(mSettingsPrefix % "/circles_as_drills",
@@ -144,6 +150,16 @@ tl::optional<Point> DxfImportDialog::getPlacementPosition() const noexcept {
   }
 }
 
+QSet<QString> DxfImportDialog::getDxfLayers() const noexcept {
+  QSet<QString> layers;
+  foreach (const QString& layer, mUi->edtDxfLayers->text().split(',')) {
+    if (!layer.trimmed().isEmpty()) {
+      layers.insert(layer.trimmed());
+    }
+  }
+  return layers;
+}
+
 bool DxfImportDialog::getJoinTangentPolylines() const noexcept {
   return mUi->cbxJoinTangentPolylines->isChecked();
 }
@@ -168,6 +184,57 @@ FilePath DxfImportDialog::chooseFile() const noexcept {
   return fp;
 }
 
+DxfImportDialog::Result DxfImportDialog::readFile(const FilePath& fp) const {
+  const qreal scaleFactor = getScaleFactor();
+  const QSet<QString> layers = getDxfLayers();
+  const bool joinTangentPolylines = getJoinTangentPolylines();
+  volatile int percent = 0;
+  volatile bool abort = false;
+  auto read = [&]() {
+    DxfReader reader;
+    reader.setScaleFactor(scaleFactor);
+    reader.setLayerFilter(layers);
+    reader.setProgressCallback([&](int p) {
+      percent = p;
+      return !abort;
+    });
+    reader.parse(fp);  // can throw
+    Result result{reader.getPolygons().toVector(), reader.getCircles()};
+    if (joinTangentPolylines) {
+      result.paths = TangentPathJoiner::join(result.paths, 2000);
+    }
+    return result;
+  };
+
+  // Run the import in a worker thread. Most files are read quickly, so wait
+  // a moment before showing the modal progress dialog. It is closed
+  // by the watcher once the worker has finished.
+  QFuture<Result> future = QtConcurrent::run(read);
+  QElapsedTimer elapsed;
+  elapsed.start();
+  while ((!future.isFinished()) && (elapsed.elapsed() < 500)) {
+    QThread::msleep(10);
+  }
+  if (!future.isFinished()) {
+    QProgressDialog progress(tr("Import DXF..."), tr("Cancel"), 0, 100,
+                             parentWidget());
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(0);
+    connect(&progress, &QProgressDialog::canceled,
+            [&abort]() { abort = true; });
+    QTimer timer;
+    connect(&timer, &QTimer::timeout, &progress,
+            [&progress, &percent]() { progress.setValue(percent); });
+    timer.start(100);
+    QFutureWatcher<Result> watcher;
+    connect(&watcher, &QFutureWatcher<Result>::finished, &progress,
+            &QProgressDialog::reset);
+    watcher.setFuture(future);
+    progress.exec();
+  }
+  return future.result();  // can throw
+}
+
 void DxfImportDialog::throwNoObjectsImportedError() {
   throw RuntimeError(
       __FILE__, __LINE__,
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/core/fileio/filepath.h>
+#include <librepcb/core/import/dxfreader.h>
 #include <librepcb/core/types/length.h>
 #include <librepcb/core/types/point.h>
 
@@ -57,6 +58,12 @@ class DxfImportDialog final : public QDialog {
   Q_OBJECT
 
 public:
+  // Types
+  struct Result {
+    QVector<Path> paths;
+    QList<DxfReader::Circle> circles;
+  };
+
   // Constructors / Destructor
   DxfImportDialog() = delete;
   DxfImportDialog(const DxfImportDialog& other) = delete;
@@ -72,11 +79,29 @@ public:
   UnsignedLength getLineWidth() const noexcept;
   qreal getScaleFactor() const noexcept;
   tl::optional<Point> getPlacementPosition() const noexcept;
+  QSet<QString> getDxfLayers() const noexcept;
   bool getJoinTangentPolylines() const noexcept;
   bool getImportCirclesAsDrills() const noexcept;
 
   // General Methods
   FilePath chooseFile() const noexcept;
+
+  /**
+   * @brief Read a DXF file with the chosen import options
+   *
+   * Parsing the file and joining tangent paths is done in a worker thread.
+   * If it takes some time, a window modal progress dialog is shown meanwhile,
+   * which also allows to cancel it.
+   *
+   * @param fp    The DXF file to read.
+   *
+   * @return The imported paths and circles.
+   *
+   * @throw UserCanceled if canceled by the user.
+   * @throw Exception if the file could not be read.
+   */
+  Result readFile(const FilePath& fp) const;
+
   static void throwNoObjectsImportedError();
 
   // Operator Overloadings
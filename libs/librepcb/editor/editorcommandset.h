@@ -297,6 +297,16 @@ public:
       {QKeySequence(Qt::Key_F8)},
       &categoryEditor,
   };
+  EditorCommand runDesignRuleCheckForSelection{
+      "run_design_rule_check_for_selection",  // clang-format break
+      QT_TR_NOOP("Check Selection"),
+      QT_TR_NOOP("Run the design rule check (DRC) only for the selected items, "
+                 "or for the visible area if nothing is selected"),
+      QIcon(":/img/actions/drc.png"),
+      EditorCommand::Flags(),
+      {QKeySequence(Qt::CTRL + Qt::Key_F8)},
+      &categoryEditor,
+  };
   EditorCommand projectLibraryUpdate{
       "project_library_update",  // clang-format break
       QT_TR_NOOP("Update Project Library"),
@@ -38,12 +38,26 @@ namespace editor {
  ******************************************************************************/
 
 GraphicsScene::GraphicsScene(QObject* parent) noexcept
-  : QGraphicsScene(parent), mSelectionRectItem(nullptr) {
+  : QGraphicsScene(parent),
+    mSelectionRectItem(nullptr),
+    mItemsMemory("Graphics items") {
   mSelectionRectItem = new QGraphicsRectItem();
   mSelectionRectItem->setPen(QPen(QColor(120, 170, 255, 255), 0));
   mSelectionRectItem->setBrush(QColor(150, 200, 255, 80));
   mSelectionRectItem->setZValue(1000);
   QGraphicsScene::addItem(mSelectionRectItem);
+
+  // Counting the items is not free, and items might also be removed by
+  // deleting them directly, thus the number of items is determined from the
+  // scene delayed after any change.
+  mItemsMemoryTimer.setSingleShot(true);
+  mItemsMemoryTimer.setInterval(1000);
+  connect(&mItemsMemoryTimer, &QTimer::timeout, this, [this]() {
+    // Don't count the selection rect item.
+    mItemsMemory.set(items().count() - 1, 0);
+  });
+  connect(this, &GraphicsScene::changed, this,
+          &GraphicsScene::scheduleItemsMemoryUpdate);
 }
 
 GraphicsScene::~GraphicsScene() noexcept {
@@ -59,11 +73,13 @@ GraphicsScene::~GraphicsScene() noexcept {
 void GraphicsScene::addItem(QGraphicsItem& item) noexcept {
   Q_ASSERT(!items().contains(&item));
   QGraphicsScene::addItem(&item);
+  scheduleItemsMemoryUpdate();
 }
 
 void GraphicsScene::removeItem(QGraphicsItem& item) noexcept {
   Q_ASSERT(items().contains(&item));
   QGraphicsScene::removeItem(&item);
+  scheduleItemsMemoryUpdate();
 }
 
 void GraphicsScene::setSelectionRectColors(const QColor& line,
@@ -101,6 +117,16 @@ QPixmap GraphicsScene::toPixmap(const QSize& size,
   return pixmap;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void GraphicsScene::scheduleItemsMemoryUpdate() noexcept {
+  if (!mItemsMemoryTimer.isActive()) {
+    mItemsMemoryTimer.start();
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/core/memoryaccounting.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -61,8 +63,13 @@ public:
   QPixmap toPixmap(const QSize& size,
                    const QColor& background = Qt::transparent) noexcept;
 
-private:
+private:  // Methods
+  void scheduleItemsMemoryUpdate() noexcept;
+
+private:  // Data
   QGraphicsRectItem* mSelectionRectItem;
+  MemoryAccounting::Counter mItemsMemory;
+  QTimer mItemsMemoryTimer;  ///< Delays updating #mItemsMemory
 };
 
 /*******************************************************************************
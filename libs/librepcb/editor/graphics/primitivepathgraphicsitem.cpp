@@ -33,6 +33,12 @@
 namespace librepcb {
 namespace editor {
 
+/// On-screen size [px] below which the path is not drawn at all
+static const qreal sMinVisibleSizePx = 0.5;
+
+/// On-screen size [px] below which only the bounding box is drawn
+static const qreal sMinDetailSizePx = 3;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -46,6 +52,7 @@ PrimitivePathGraphicsItem::PrimitivePathGraphicsItem(
     mLighterColors(false),
     mShapeMode(ShapeMode::StrokeAndAreaByLayer),
     mBoundingRectMarginPx(0),
+    mShapeValid(false),
     mOnLayerEditedSlot(*this, &PrimitivePathGraphicsItem::layerEdited) {
   setFlag(QGraphicsItem::ItemIsSelectable, true);
 
@@ -135,10 +142,21 @@ void PrimitivePathGraphicsItem::setShapeMode(ShapeMode mode) noexcept {
  ******************************************************************************/
 
 QPainterPath PrimitivePathGraphicsItem::shape() const noexcept {
-  return ((mLineLayer && mLineLayer->isVisible()) ||
-          (mFillLayer && mFillLayer->isVisible()))
-      ? mShape
-      : QPainterPath();
+  if (!((mLineLayer && mLineLayer->isVisible()) ||
+        (mFillLayer && mFillLayer->isVisible()))) {
+    return QPainterPath();
+  }
+  if (!mShapeValid) {
+    if (mShapeMode == ShapeMode::FilledOutline) {
+      mShape = mPainterPath;
+    } else if (mShapeMode == ShapeMode::StrokeAndAreaByLayer) {
+      mShape = Toolbox::shapeFromPath(mPainterPath, mPen, mBrush);
+    } else {
+      mShape = QPainterPath();
+    }
+    mShapeValid = true;
+  }
+  return mShape;
 }
 
 void PrimitivePathGraphicsItem::paint(QPainter* painter,
@@ -147,13 +165,31 @@ void PrimitivePathGraphicsItem::paint(QPainter* painter,
   Q_UNUSED(widget);
 
   const bool isSelected = option->state.testFlag(QStyle::State_Selected);
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  const qreal sizePx =
+      std::max(mBoundingRect.width(), mBoundingRect.height()) * lod;
+  if (sizePx < sMinVisibleSizePx) {
+    return;
+  }
 
   if (mMirror) {
     painter->scale(-1, 1);
   }
 
-  painter->setPen(isSelected ? mPenHighlighted : mPen);
-  painter->setBrush(isSelected ? mBrushHighlighted : mBrush);
+  const QPen& pen = isSelected ? mPenHighlighted : mPen;
+  const QBrush& brush = isSelected ? mBrushHighlighted : mBrush;
+  if (sizePx < sMinDetailSizePx) {
+    // Too small to see any details, so just draw the bounding box which is
+    // much faster than drawing the path (e.g. text glyphs or pad outlines).
+    painter->fillRect(mBoundingRect,
+                      (brush.style() != Qt::NoBrush) ? brush.color()
+                                                     : pen.color());
+    return;
+  }
+
+  painter->setPen(pen);
+  painter->setBrush(brush);
   painter->drawPath(mPainterPath);
 }
 
@@ -165,10 +201,17 @@ void PrimitivePathGraphicsItem::layerEdited(
     const GraphicsLayer& layer, GraphicsLayer::Event event) noexcept {
   Q_UNUSED(layer);
   switch (event) {
-    case GraphicsLayer::Event::ColorChanged:
-    case GraphicsLayer::Event::HighlightColorChanged:
     case GraphicsLayer::Event::VisibleChanged:
     case GraphicsLayer::Event::EnabledChanged:
+      // Toggling layers notifies lots of items, so avoid any per-item work
+      // if the colors do not depend on the visibility.
+      if (hasSingleLayer()) {
+        updateVisibility();
+        break;
+      }
+      // fallthrough
+    case GraphicsLayer::Event::ColorChanged:
+    case GraphicsLayer::Event::HighlightColorChanged:
       updateColors();
       updateVisibility();
       break;
@@ -181,7 +224,10 @@ void PrimitivePathGraphicsItem::layerEdited(
 }
 
 void PrimitivePathGraphicsItem::updateColors() noexcept {
-  if (mLineLayer && mLineLayer->isVisible()) {
+  // With only one layer, the whole item is hidden if the layer is invisible,
+  // thus the pen and brush styles do not need to reflect the visibility.
+  const bool singleLayer = hasSingleLayer();
+  if (mLineLayer && (singleLayer || mLineLayer->isVisible())) {
     mPen.setStyle(Qt::SolidLine);
     mPenHighlighted.setStyle(Qt::SolidLine);
     mPen.setColor(convertColor(mLineLayer->getColor(false)));
@@ -191,7 +237,7 @@ void PrimitivePathGraphicsItem::updateColors() noexcept {
     mPenHighlighted.setStyle(Qt::NoPen);
   }
 
-  if (mFillLayer && mFillLayer->isVisible()) {
+  if (mFillLayer && (singleLayer || mFillLayer->isVisible())) {
     mBrush.setStyle(Qt::SolidPattern);
     mBrushHighlighted.setStyle(Qt::SolidPattern);
     mBrush.setColor(convertColor(mFillLayer->getColor(false)));
@@ -205,20 +251,22 @@ void PrimitivePathGraphicsItem::updateColors() noexcept {
 
 void PrimitivePathGraphicsItem::updateBoundingRectAndShape() noexcept {
   prepareGeometryChange();
-  if (mShapeMode == ShapeMode::FilledOutline) {
-    mShape = mPainterPath;
-  } else if (mShapeMode == ShapeMode::StrokeAndAreaByLayer) {
-    mShape = Toolbox::shapeFromPath(mPainterPath, mPen, mBrush);
-  } else {
-    mShape = QPainterPath();
-  }
+  // The shape is expensive to calculate and often not needed at all (e.g. for
+  // items never hovered), so it is only calculated on demand.
+  mShapeValid = false;
+  mShape = QPainterPath();
   mBoundingRect = mPainterPath.boundingRect() +
       QMarginsF(mPen.widthF(), mPen.widthF(), mPen.widthF(), mPen.widthF());
   update();
 }
 
 void PrimitivePathGraphicsItem::updateVisibility() noexcept {
-  setVisible((mPen.style() != Qt::NoPen) || (mBrush.style() != Qt::NoBrush));
+  setVisible((mLineLayer && mLineLayer->isVisible()) ||
+             (mFillLayer && mFillLayer->isVisible()));
+}
+
+bool PrimitivePathGraphicsItem::hasSingleLayer() const noexcept {
+  return (!mLineLayer) || (!mFillLayer) || (mLineLayer == mFillLayer);
 }
 
 QColor PrimitivePathGraphicsItem::convertColor(
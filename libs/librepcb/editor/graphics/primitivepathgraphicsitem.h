@@ -101,6 +101,7 @@ private:  // Methods
   void updateColors() noexcept;
   void updateBoundingRectAndShape() noexcept;
   void updateVisibility() noexcept;
+  bool hasSingleLayer() const noexcept;
   QColor convertColor(const QColor& color) const noexcept;
 
 protected:  // Data
@@ -116,7 +117,8 @@ protected:  // Data
   QPainterPath mPainterPath;
   QRectF mBoundingRect;
   qreal mBoundingRectMarginPx;
-  QPainterPath mShape;
+  mutable QPainterPath mShape;  ///< Lazily calculated by shape()
+  mutable bool mShapeValid;
 
   // Slots
   GraphicsLayer::OnEditedSlot mOnLayerEditedSlot;
@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "primitivetextgraphicsitem.h"
 
+#include "textlayoutcache.h"
+
 #include <librepcb/core/application.h>
 #include <librepcb/core/types/angle.h>
 #include <librepcb/core/types/point.h>
@@ -37,6 +39,9 @@
 namespace librepcb {
 namespace editor {
 
+/// On-screen text height [px] below which the text is not drawn at all
+static const qreal sMinVisibleHeightPx = 3;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -156,13 +161,24 @@ void PrimitiveTextGraphicsItem::paint(QPainter* painter,
                                       const QStyleOptionGraphicsItem* option,
                                       QWidget* widget) noexcept {
   Q_UNUSED(widget);
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  if ((mBoundingRect.height() * lod) < sMinVisibleHeightPx) {
+    return;  // Unreadable anyway, and drawing text is expensive.
+  }
+
   painter->setFont(mFont);
   if (option->state.testFlag(QStyle::State_Selected)) {
     painter->setPen(mPenHighlighted);
   } else {
     painter->setPen(mPen);
   }
-  painter->drawText(QRectF(), mTextFlags, mDisplayText);
+  if (!mStaticText.text().isEmpty()) {
+    // Glyphs are already laid out, much faster than QPainter::drawText().
+    painter->drawStaticText(mBoundingRect.topLeft(), mStaticText);
+  } else {
+    painter->drawText(QRectF(), mTextFlags, mDisplayText);
+  }
   painter->drawLines(mOverlines);
 }
 
@@ -203,19 +219,16 @@ void PrimitiveTextGraphicsItem::updateBoundingRectAndShape() noexcept {
   }
   mFont.setPixelSize(qCeil(mHeight->toPx()));
 
-  const QFontMetricsF fm(mFont);
-  if (mParseOverlines) {
-    OverlineMarkupParser::process(mText, fm, mTextFlags, mDisplayText,
-                                  mOverlines, mBoundingRect);
-  } else {
-    mDisplayText = mText;
-    mOverlines.clear();
-    mBoundingRect = fm.boundingRect(QRectF(), mTextFlags, mText);
-  }
+  const TextLayoutCache::Layout& layout =
+      TextLayoutCache::get(mText, mFont, mTextFlags, mParseOverlines);
+  mDisplayText = layout.displayText;
+  mStaticText = layout.staticText;
+  mOverlines = layout.overlines;
+  mBoundingRect = layout.boundingRect;
 
   mShape = QPainterPath();
   mShape.addRect(mBoundingRect);
-  setScale(mHeight->toPx() / fm.height());
+  setScale(mHeight->toPx() / layout.fontHeight);
   update();
 }
 
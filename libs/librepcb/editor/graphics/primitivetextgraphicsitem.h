@@ -89,6 +89,7 @@ private:  // Data
   std::shared_ptr<GraphicsLayer> mLayer;
   QString mText;
   QString mDisplayText;
+  QStaticText mStaticText;  ///< Empty for multi-line texts
   bool mParseOverlines;
   QVector<QLineF> mOverlines;
   PositiveLength mHeight;
@@ -0,0 +1,97 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "textlayoutcache.h"
+
+#include <librepcb/core/utils/overlinemarkupparser.h>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+/// Maximum number of cached layouts
+static const int sMaxCachedLayouts = 20000;
+
+namespace {
+
+struct Key {
+  QString text;
+  QFont font;
+  int flags;
+  bool parseOverlines;
+
+  bool operator==(const Key& rhs) const noexcept {
+    return (flags == rhs.flags) && (parseOverlines == rhs.parseOverlines) &&
+        (text == rhs.text) && (font == rhs.font);
+  }
+};
+
+uint qHash(const Key& key, uint seed = 0) noexcept {
+  return ::qHash(key.text, seed) ^ ::qHash(key.font, seed) ^
+      ::qHash(qMakePair(key.flags, key.parseOverlines), seed);
+}
+
+}  // namespace
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+const TextLayoutCache::Layout& TextLayoutCache::get(
+    const QString& text, const QFont& font, int flags,
+    bool parseOverlines) noexcept {
+  static QCache<Key, Layout> cache(sMaxCachedLayouts);
+  const Key key{text, font, flags, parseOverlines};
+  if (const Layout* layout = cache.object(key)) {
+    return *layout;
+  }
+
+  Layout* layout = new Layout();
+  const QFontMetricsF fm(font);
+  if (parseOverlines) {
+    OverlineMarkupParser::process(text, fm, flags, layout->displayText,
+                                  layout->overlines, layout->boundingRect);
+  } else {
+    layout->displayText = text;
+    layout->boundingRect = fm.boundingRect(QRectF(), flags, text);
+  }
+  layout->fontHeight = fm.height();
+  if (!layout->displayText.contains('\n')) {
+    layout->staticText.setTextFormat(Qt::PlainText);
+    layout->staticText.setText(layout->displayText);
+    layout->staticText.prepare(QTransform(), font);
+  }
+  cache.insert(key, layout);  // Takes ownership.
+  return *layout;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
@@ -0,0 +1,98 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_EDITOR_TEXTLAYOUTCACHE_H
+#define LIBREPCB_EDITOR_TEXTLAYOUTCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+/*******************************************************************************
+ *  Class TextLayoutCache
+ ******************************************************************************/
+
+/**
+ * @brief Cache for the layout of texts displayed in graphics items
+ *
+ * Laying out a text (font metrics, overline markup and glyph positions) is
+ * expensive, but schematics contain the same texts many times, e.g. the pin
+ * names and numbers of every symbol or the names of net labels. Thus the
+ * layouts are cached by text, font and flags, and are shared among all
+ * graphics items.
+ *
+ * @warning This class is not thread-safe, it must only be used from the
+ *          GUI thread.
+ */
+class TextLayoutCache final {
+public:
+  // Types
+  struct Layout {
+    QString displayText;  ///< Text without overline markup
+    QVector<QLineF> overlines;  ///< Relative to the text origin
+    QRectF boundingRect;  ///< Relative to the text origin
+    qreal fontHeight;  ///< Height according to the font metrics
+
+    /// Laid out text, only available for single-line texts (otherwise
+    /// `QStaticText::text()` is empty). To be drawn at `boundingRect`'s
+    /// top left corner.
+    QStaticText staticText;
+  };
+
+  // Constructors / Destructor
+  TextLayoutCache() = delete;
+  TextLayoutCache(const TextLayoutCache& other) = delete;
+  ~TextLayoutCache() = delete;
+
+  // Static Methods
+
+  /**
+   * @brief Get the (possibly cached) layout of a text
+   *
+   * @param text            The text to lay out.
+   * @param font            The font to use (including its pixel size).
+   * @param flags           Alignment flags (`Qt::AlignmentFlag`).
+   * @param parseOverlines  Whether to process overline markup.
+   *
+   * @return The layout. The reference is only valid until the next call, so
+   *         copy what is needed.
+   */
+  static const Layout& get(const QString& text, const QFont& font, int flags,
+                           bool parseOverlines) noexcept;
+
+  // Operator Overloadings
+  TextLayoutCache& operator=(const TextLayoutCache& rhs) = delete;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
+
+#endif
@@ -37,6 +37,8 @@
 #include "../pkg/footprintpadgraphicsitem.h"
 #include "cmdfootprintpadedit.h"
 
+#include <librepcb/core/library/pkg/footprint.h>
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -200,6 +202,9 @@ void CmdDragSelectedFootprintItems::setDeltaToStartPos(
 
 void CmdDragSelectedFootprintItems::translate(const Point& deltaPos) noexcept {
   if (!deltaPos.isOrigin()) {
+    // Avoid handling the footprint modification once per moved item.
+    Signal<Footprint, Footprint::Event>::Deferrer deferrer(
+        mContext.currentFootprint->onEdited);
     foreach (CmdFootprintPadEdit* cmd, mPadEditCmds) {
       cmd->translate(deltaPos, true);
     }
@@ -224,6 +229,8 @@ void CmdDragSelectedFootprintItems::translate(const Point& deltaPos) noexcept {
 }
 
 void CmdDragSelectedFootprintItems::rotate(const Angle& angle) noexcept {
+  Signal<Footprint, Footprint::Event>::Deferrer deferrer(
+      mContext.currentFootprint->onEdited);
   foreach (CmdFootprintPadEdit* cmd, mPadEditCmds) {
     cmd->rotate(angle, mCenterPos, true);
   }
@@ -247,6 +254,8 @@ void CmdDragSelectedFootprintItems::rotate(const Angle& angle) noexcept {
 
 void CmdDragSelectedFootprintItems::mirrorGeometry(
     Qt::Orientation orientation) noexcept {
+  Signal<Footprint, Footprint::Event>::Deferrer deferrer(
+      mContext.currentFootprint->onEdited);
   foreach (CmdFootprintPadEdit* cmd, mPadEditCmds) {
     cmd->mirrorGeometry(orientation, mCenterPos, true);
   }
@@ -269,6 +278,8 @@ void CmdDragSelectedFootprintItems::mirrorGeometry(
 }
 
 void CmdDragSelectedFootprintItems::mirrorLayer() noexcept {
+  Signal<Footprint, Footprint::Event>::Deferrer deferrer(
+      mContext.currentFootprint->onEdited);
   foreach (CmdFootprintPadEdit* cmd, mPadEditCmds) {
     cmd->mirrorLayer(true);
   }
@@ -61,9 +61,15 @@ EditorWidgetBase::EditorWidgetBase(const Context& context, const FilePath& fp,
     mManualModificationsMade(false),
     mIsInterfaceBroken(false),
     mStatusBarMessage(),
+    mCheckTimer(),
     mSupportedApprovals(),
     mDisappearedApprovals() {
+  mCheckTimer.setSingleShot(true);
+  connect(&mCheckTimer, &QTimer::timeout, this,
+          &EditorWidgetBase::updateCheckMessages);
+
   mUndoStack.reset(new UndoStack());
+  mUndoStack->setUndoLimit(mContext.workspace.getSettings().undoLimit.get());
   connect(mUndoStack.data(), &UndoStack::cleanChanged, this,
           &EditorWidgetBase::undoStackCleanChanged);
   connect(mUndoStack.data(), &UndoStack::stateModified, this,
@@ -280,8 +286,10 @@ void EditorWidgetBase::scheduleLibraryElementChecks() noexcept {
   // change is not done yet. In that case, running checks would lead to wrong
   // results. Instead, just delay checks for some time to get more stable
   // messages. But also don't wait too long, otherwise it would feel like a
-  // lagging user interface.
-  QTimer::singleShot(50, this, &EditorWidgetBase::updateCheckMessages);
+  // lagging user interface. The timer is restarted with every modification,
+  // so bulk operations (e.g. on thousands of pads) which modify the element
+  // very often run the checks only once after the last modification.
+  mCheckTimer.start(50);
 }
 
 void EditorWidgetBase::updateCheckMessages() noexcept {
@@ -257,6 +257,7 @@ protected:  // Data
   bool mManualModificationsMade;  ///< Modifications bypassing the undo stack.
   bool mIsInterfaceBroken;
   QString mStatusBarMessage;
+  QTimer mCheckTimer;  ///< To run checks only once after many modifications
 
   // Memorized message approvals
   QSet<SExpression> mSupportedApprovals;
@@ -412,6 +412,10 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
         mContext.workspace.getLibraryDb().getAll<ElementType>(
             tl::nullopt,
             mLibrary->getDirectory().getAbsPath());  // can throw
+    // Fetch the data of all elements at once instead of querying each
+    // element separately, which is very slow for large libraries.
+    mContext.workspace.getLibraryDb().preloadMetadata<ElementType>(
+        mLibrary->getDirectory().getAbsPath());  // can throw
     foreach (const FilePath& filepath, dbElements) {
       Element element;
       mContext.workspace.getLibraryDb().getMetadata<ElementType>(
@@ -431,6 +435,11 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
     return;
   }
 
+  // Disable sorting during the update since otherwise the list would be
+  // sorted again after every modified item.
+  const bool sortingEnabled = listWidget.isSortingEnabled();
+  listWidget.setSortingEnabled(false);
+
   // update/remove existing list widget items
   for (int i = listWidget.count() - 1; i >= 0; --i) {
     QListWidgetItem* item = listWidget.item(i);
@@ -438,8 +447,14 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
     FilePath filePath(item->data(Qt::UserRole).toString());
     if (elements.contains(filePath)) {
       const Element element = elements.take(filePath);
-      item->setText(element.name);
-      item->setForeground(element.deprecated ? QBrush(Qt::red) : QBrush());
+      if (item->text() != element.name) {
+        item->setText(element.name);
+        item->setToolTip(element.name);
+      }
+      const QBrush foreground = element.deprecated ? QBrush(Qt::red) : QBrush();
+      if (item->foreground() != foreground) {
+        item->setForeground(foreground);
+      }
     } else {
       delete item;
     }
@@ -455,6 +470,7 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
     item->setData(Qt::UserRole, fp.toStr());
     item->setIcon(icon);
   }
+  listWidget.setSortingEnabled(sortingEnabled);
 
   // apply filter
   updateElementListFilter(listWidget);
@@ -480,8 +496,11 @@ void LibraryOverviewWidget::updateElementListFilter(
   for (int i = 0; i < listWidget.count(); ++i) {
     QListWidgetItem* item = listWidget.item(i);
     Q_ASSERT(item);
-    item->setHidden((!mCurrentFilter.isEmpty()) &&
-                    (!item->text().toLower().contains(mCurrentFilter)));
+    const bool hidden = (!mCurrentFilter.isEmpty()) &&
+        (!item->text().contains(mCurrentFilter, Qt::CaseInsensitive));
+    if (item->isHidden() != hidden) {
+      item->setHidden(hidden);
+    }
   }
 }
 
@@ -47,9 +47,12 @@ namespace editor {
 
 LibraryElementCache::LibraryElementCache(const WorkspaceLibraryDb& db) noexcept
   : mDb(&db) {
+  mScanSucceededConnection = QObject::connect(
+      &db, &WorkspaceLibraryDb::scanSucceeded, [this]() { clear(); });
 }
 
 LibraryElementCache::~LibraryElementCache() noexcept {
+  QObject::disconnect(mScanSucceededConnection);
 }
 
 /*******************************************************************************
@@ -86,6 +89,30 @@ std::shared_ptr<const Device> LibraryElementCache::getDevice(
   return getElement(mDev, uuid);
 }
 
+std::shared_ptr<const Component> LibraryElementCache::getComponent(
+    const FilePath& fp) const noexcept {
+  return getElement<Component>(fp);
+}
+
+std::shared_ptr<const Device> LibraryElementCache::getDevice(
+    const FilePath& fp) const noexcept {
+  return getElement<Device>(fp);
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void LibraryElementCache::clear() noexcept {
+  mCmpCat.clear();
+  mPkgCat.clear();
+  mSym.clear();
+  mPkg.clear();
+  mCmp.clear();
+  mDev.clear();
+  mByPath.clear();
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -97,12 +124,29 @@ std::shared_ptr<const T> LibraryElementCache::getElement(
   std::shared_ptr<const T> element = container.value(uuid);
   if ((!element) && mDb) {
     try {
-      FilePath fp = mDb->getLatest<T>(uuid);
+      element = getElement<T>(mDb->getLatest<T>(uuid));  // can throw
+      if (element) {
+        container.insert(uuid, element);
+      }
+    } catch (const Exception& e) {
+      qWarning() << "Failed to open library element:" << e.getMsg();
+    }
+  }
+  return element;
+}
+
+template <typename T>
+std::shared_ptr<const T> LibraryElementCache::getElement(
+    const FilePath& fp) const noexcept {
+  std::shared_ptr<const T> element =
+      std::dynamic_pointer_cast<const T>(mByPath.value(fp));
+  if ((!element) && fp.isValid()) {
+    try {
       element.reset(T::open(std::unique_ptr<TransactionalDirectory>(
                                 new TransactionalDirectory(
                                     TransactionalFileSystem::openRO(fp))))
-                        .release());
-      container.insert(uuid, element);
+                        .release());  // can throw
+      mByPath.insert(fp, element);
     } catch (const Exception& e) {
       qWarning() << "Failed to open library element:" << e.getMsg();
     }
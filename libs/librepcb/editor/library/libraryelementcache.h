@@ -38,6 +38,7 @@ namespace librepcb {
 class Component;
 class ComponentCategory;
 class Device;
+class LibraryBaseElement;
 class Package;
 class PackageCategory;
 class Symbol;
@@ -51,6 +52,12 @@ namespace editor {
 
 /**
  * @brief Cache for fast access to library elements
+ *
+ * Elements are opened read-only from the workspace libraries on first access
+ * and then shared as immutable objects. Each element is opened only once, no
+ * matter whether it is requested by UUID or by file path. The cache is cleared
+ * automatically after each successful library rescan since the elements might
+ * have been modified or removed.
  */
 class LibraryElementCache final {
   Q_DECLARE_TR_FUNCTIONS(LibraryElementCache)
@@ -72,6 +79,12 @@ public:
   std::shared_ptr<const Component> getComponent(
       const Uuid& uuid) const noexcept;
   std::shared_ptr<const Device> getDevice(const Uuid& uuid) const noexcept;
+  std::shared_ptr<const Component> getComponent(
+      const FilePath& fp) const noexcept;
+  std::shared_ptr<const Device> getDevice(const FilePath& fp) const noexcept;
+
+  // General Methods
+  void clear() noexcept;
 
   // Operator Overloadings
   LibraryElementCache& operator=(const LibraryElementCache& rhs) = delete;
@@ -81,9 +94,13 @@ private:  // Methods
   std::shared_ptr<const T> getElement(
       QHash<Uuid, std::shared_ptr<const T>>& container,
       const Uuid& uuid) const noexcept;
+  template <typename T>
+  std::shared_ptr<const T> getElement(const FilePath& fp) const noexcept;
 
 private:  // Data
   QPointer<const WorkspaceLibraryDb> mDb;
+  QMetaObject::Connection mScanSucceededConnection;
+  mutable QHash<FilePath, std::shared_ptr<const LibraryBaseElement>> mByPath;
   mutable QHash<Uuid, std::shared_ptr<const ComponentCategory>> mCmpCat;
   mutable QHash<Uuid, std::shared_ptr<const PackageCategory>> mPkgCat;
   mutable QHash<Uuid, std::shared_ptr<const Symbol>> mSym;
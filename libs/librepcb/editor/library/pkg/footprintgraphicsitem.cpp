@@ -58,7 +58,8 @@ FootprintGraphicsItem::FootprintGraphicsItem(
     mPackagePadList(packagePadList),
     mComponent(component),
     mLocaleOrder(localeOrder),
-    mOnEditedSlot(*this, &FootprintGraphicsItem::footprintEdited) {
+    mOnEditedSlot(*this, &FootprintGraphicsItem::footprintEdited),
+    mOnPadsEditedSlot(*this, &FootprintGraphicsItem::padsEdited) {
   Q_ASSERT(mFootprint);
 
   syncPads();
@@ -70,6 +71,10 @@ FootprintGraphicsItem::FootprintGraphicsItem(
 
   // Register to the footprint to get notified about any modifications.
   mFootprint->onEdited.attach(mOnEditedSlot);
+
+  // Pads are updated incrementally since footprints can contain thousands of
+  // them, thus a full synchronization on every modification would be slow.
+  mFootprint->getPads().onEdited.attach(mOnPadsEditedSlot);
 }
 
 FootprintGraphicsItem::~FootprintGraphicsItem() noexcept {
@@ -473,7 +478,7 @@ void FootprintGraphicsItem::footprintEdited(const Footprint& footprint,
   Q_UNUSED(footprint);
   switch (event) {
     case Footprint::Event::PadsEdited:
-      syncPads();
+      // Handled by padsEdited().
       break;
     case Footprint::Event::CirclesEdited:
       syncCircles();
@@ -495,6 +500,37 @@ void FootprintGraphicsItem::footprintEdited(const Footprint& footprint,
   }
 }
 
+void FootprintGraphicsItem::padsEdited(
+    const FootprintPadList& list, int index,
+    const std::shared_ptr<const FootprintPad>& pad,
+    FootprintPadList::Event event) noexcept {
+  Q_UNUSED(list);
+  switch (event) {
+    case FootprintPadList::Event::ElementAdded: {
+      std::shared_ptr<FootprintPad> ptr = mFootprint->getPads().value(index);
+      if (ptr && (!mPadGraphicsItems.contains(ptr))) {
+        auto i = std::make_shared<FootprintPadGraphicsItem>(
+            ptr, mLayerProvider, mPackagePadList, this);
+        mPadGraphicsItems.insert(ptr, i);
+      }
+      break;
+    }
+    case FootprintPadList::Event::ElementRemoved: {
+      auto it =
+          mPadGraphicsItems.find(std::const_pointer_cast<FootprintPad>(pad));
+      if (it != mPadGraphicsItems.end()) {
+        Q_ASSERT(it.value());
+        it.value()->setParentItem(nullptr);
+        mPadGraphicsItems.erase(it);
+      }
+      break;
+    }
+    default:
+      // Modifications of pads are handled by the pad graphics items.
+      break;
+  }
+}
+
 void FootprintGraphicsItem::substituteText(
     StrokeTextGraphicsItem& text) noexcept {
   if (mComponent) {
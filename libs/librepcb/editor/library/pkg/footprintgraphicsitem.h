@@ -147,6 +147,9 @@ private:  // Methods
   void syncHoles() noexcept;
   void footprintEdited(const Footprint& footprint,
                        Footprint::Event event) noexcept;
+  void padsEdited(const FootprintPadList& list, int index,
+                  const std::shared_ptr<const FootprintPad>& pad,
+                  FootprintPadList::Event event) noexcept;
   void substituteText(StrokeTextGraphicsItem& text) noexcept;
 
 private:  // Data
@@ -171,6 +174,7 @@ private:  // Data
 
   // Slots
   Footprint::OnEditedSlot mOnEditedSlot;
+  FootprintPadList::OnEditedSlot mOnPadsEditedSlot;
 };
 
 }  // namespace editor
@@ -152,9 +152,13 @@ void FootprintPadGraphicsItem::packagePadListEdited(
     PackagePadList::Event event) noexcept {
   Q_UNUSED(list);
   Q_UNUSED(index);
-  Q_UNUSED(pad);
   Q_UNUSED(event);
-  updateText();
+  // Only modifications of the connected package pad are relevant. This is
+  // important for performance since every footprint pad is notified about
+  // every change of the package pads.
+  if (pad && (pad->getUuid() == mPad->getPackagePadUuid())) {
+    updateText();
+  }
 }
 
 void FootprintPadGraphicsItem::updateLayer() noexcept {
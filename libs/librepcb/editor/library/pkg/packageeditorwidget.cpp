@@ -103,6 +103,8 @@ PackageEditorWidget::PackageEditorWidget(const Context& context,
   mUi->graphicsView->setGridStyle(theme.getSchematicGridStyle());
   mUi->graphicsView->setUseOpenGl(
       mContext.workspace.getSettings().useOpenGl.get());
+  mUi->graphicsView->setShowRenderStatistics(
+      mContext.workspace.getSettings().showRenderStatistics.get());
   mUi->graphicsView->setScene(mGraphicsScene.data());
   mUi->graphicsView->setEnabled(false);  // no footprint selected
   mUi->graphicsView->addAction(
@@ -125,6 +127,8 @@ PackageEditorWidget::PackageEditorWidget(const Context& context,
   mUi->modelListEditorWidget->hide();
   connect(mUndoStack.data(), &UndoStack::stateModified, this,
           &PackageEditorWidget::scheduleOpenGlSceneUpdate);
+  connect(mUndoStack.data(), &UndoStack::stateModified, this,
+          [this]() { mGraphicsExportPainters.clear(); });
   QTimer* openGlBuilderTimer = new QTimer(this);
   connect(openGlBuilderTimer, &QTimer::timeout, this,
           &PackageEditorWidget::updateOpenGlScene);
@@ -1030,10 +1034,16 @@ bool PackageEditorWidget::execGraphicsExportDialog(
     FilePath defaultFilePath(QDir::homePath() % "/" % packageName %
                              "_Footprint");
 
-    // Copy package items to allow processing them in worker threads.
+    // Copy package items to allow processing them in worker threads. The
+    // painter is reused as long as the package is not modified.
     QList<std::shared_ptr<GraphicsPagePainter>> pages;
     if (footprint) {
-      pages.append(std::make_shared<FootprintPainter>(*footprint));
+      std::shared_ptr<FootprintPainter>& painter =
+          mGraphicsExportPainters[footprint->getUuid()];
+      if (!painter) {
+        painter = std::make_shared<FootprintPainter>(*footprint);
+      }
+      pages.append(painter);
     }
 
     // Show dialog, which will do all the work.
@@ -1075,6 +1085,8 @@ void PackageEditorWidget::toggle3DMode(bool enable) noexcept {
     mUi->modelListEditorWidget->show();
     mUi->btnToggle3d->setArrowType(Qt::RightArrow);
     mOpenGlView.reset(new OpenGlView(this));
+    mOpenGlView->setShowRenderStatistics(
+        mContext.workspace.getSettings().showRenderStatistics.get());
     mUi->mainLayout->insertWidget(0, mOpenGlView.data(), 2);
     mOpenGlSceneBuilder.reset(new OpenGlSceneBuilder());
     connect(mOpenGlSceneBuilder.data(), &OpenGlSceneBuilder::started,
@@ -41,6 +41,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class FootprintPainter;
 class Package;
 class PackageModel;
 
@@ -155,6 +156,9 @@ private:  // Data
   std::shared_ptr<Footprint> mCurrentFootprint;
   std::shared_ptr<PackageModel> mCurrentModel;
 
+  /// Graphics export painters (UUID=Footprint), cleared on modifications
+  QHash<Uuid, std::shared_ptr<FootprintPainter>> mGraphicsExportPainters;
+
   // broken interface detection
   QSet<Uuid> mOriginalPadUuids;
   FootprintList mOriginalFootprints;
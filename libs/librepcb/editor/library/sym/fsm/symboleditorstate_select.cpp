@@ -44,10 +44,8 @@
 #include "../symbolpingraphicsitem.h"
 #include "../symbolpinpropertiesdialog.h"
 
-#include <librepcb/core/import/dxfreader.h>
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/utils/scopeguard.h>
-#include <librepcb/core/utils/tangentpathjoiner.h>
 
 #include <QtCore>
 
@@ -534,27 +532,19 @@ bool SymbolEditorState_Select::processImportDxf() noexcept {
     auto cursorScopeGuard =
         scopeGuard([this]() { mContext.editorWidget.unsetCursor(); });
 
-    // Read DXF file.
-    DxfReader import;
-    import.setScaleFactor(dialog.getScaleFactor());
-    import.parse(fp);  // can throw
-
-    // If enabled, join tangent paths.
-    QVector<Path> paths = import.getPolygons().toVector();
-    if (dialog.getJoinTangentPolylines()) {
-      paths = TangentPathJoiner::join(paths, 2000);
-    }
+    // Read DXF file and, if enabled, join tangent paths.
+    const DxfImportDialog::Result import = dialog.readFile(fp);  // can throw
 
     // Build elements to import. ALthough this has nothing to do with the
     // clipboard, we use SymbolClipboardData since it works very well :-)
     std::unique_ptr<SymbolClipboardData> data(
         new SymbolClipboardData(mContext.symbol.getUuid(), Point(0, 0)));
-    foreach (const auto& path, paths) {
+    foreach (const auto& path, import.paths) {
       data->getPolygons().append(
           std::make_shared<Polygon>(Uuid::createRandom(), dialog.getLayer(),
                                     dialog.getLineWidth(), false, false, path));
     }
-    for (const auto& circle : import.getCircles()) {
+    for (const auto& circle : import.circles) {
       data->getPolygons().append(std::make_shared<Polygon>(
           Uuid::createRandom(), dialog.getLayer(), dialog.getLineWidth(), false,
           false, Path::circle(circle.diameter).translated(circle.position)));
@@ -576,6 +566,10 @@ bool SymbolEditorState_Select::processImportDxf() noexcept {
     // Start the paste tool.
     return startPaste(std::move(data),
                       dialog.getPlacementPosition());  // can throw
+  } catch (const UserCanceled& e) {
+    Q_UNUSED(e);
+    processAbortCommand();
+    return false;
   } catch (const Exception& e) {
     QMessageBox::critical(&mContext.editorWidget, tr("Error"), e.getMsg());
     processAbortCommand();
@@ -90,6 +90,8 @@ SymbolEditorWidget::SymbolEditorWidget(const Context& context,
   mUi->graphicsView->setGridStyle(theme.getBoardGridStyle());
   mUi->graphicsView->setUseOpenGl(
       mContext.workspace.getSettings().useOpenGl.get());
+  mUi->graphicsView->setShowRenderStatistics(
+      mContext.workspace.getSettings().showRenderStatistics.get());
   mUi->graphicsView->setScene(mGraphicsScene.data());
   mUi->graphicsView->addAction(
       EditorCommandSet::instance().commandToolBarFocus.createAction(
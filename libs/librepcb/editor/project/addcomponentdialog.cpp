@@ -25,6 +25,7 @@
 #include "../editorcommandset.h"
 #include "../graphics/defaultgraphicslayerprovider.h"
 #include "../graphics/graphicsscene.h"
+#include "../library/libraryelementcache.h"
 #include "../library/pkg/footprintgraphicsitem.h"
 #include "../library/sym/symbolgraphicsitem.h"
 #include "../widgets/graphicsview.h"
@@ -62,6 +63,7 @@ AddComponentDialog::AddComponentDialog(const WorkspaceLibraryDb& db,
                                        const Theme& theme, QWidget* parent)
   : QDialog(parent),
     mDb(db),
+    mElementCache(new LibraryElementCache(db)),
     mLocaleOrder(localeOrder),
     mNormOrder(normOrder),
     mUi(new Ui::AddComponentDialog),
@@ -88,6 +90,17 @@ AddComponentDialog::AddComponentDialog(const WorkspaceLibraryDb& db,
   mUi->cbxSymbVar->hide();
   connect(mUi->edtSearch, &QLineEdit::textChanged, this,
           &AddComponentDialog::searchEditTextChanged);
+  // Searching is expensive, so don't search again on every keystroke while
+  // the user is still typing.
+  mSearchTimer.setSingleShot(true);
+  mSearchTimer.setInterval(200);
+  connect(&mSearchTimer, &QTimer::timeout, this, [this]() {
+    try {
+      searchComponents(mUi->edtSearch->text().trimmed());
+    } catch (const Exception& e) {
+      mUi->lblErrorMsg->setText(e.getMsg());
+    }
+  });
   connect(mUi->treeComponents, &QTreeWidget::currentItemChanged, this,
           &AddComponentDialog::treeComponents_currentItemChanged);
   connect(mUi->treeComponents, &QTreeWidget::itemDoubleClicked, this,
@@ -204,6 +217,7 @@ bool AddComponentDialog::getAutoOpenAgain() const noexcept {
 
 void AddComponentDialog::selectComponentByKeyword(
     const QString keyword, const tl::optional<Uuid>& selectedDevice) noexcept {
+  mSearchTimer.stop();
   try {
     searchComponents(keyword, selectedDevice, true);
   } catch (const Exception& e) {
@@ -218,6 +232,7 @@ void AddComponentDialog::selectComponentByKeyword(
 
 void AddComponentDialog::searchEditTextChanged(const QString& text) noexcept {
   mUi->lblErrorMsg->clear();
+  mSearchTimer.stop();
   try {
     QModelIndex catIndex = mUi->treeCategories->currentIndex();
     if (text.trimmed().isEmpty() && catIndex.isValid()) {
@@ -228,7 +243,7 @@ void AddComponentDialog::searchEditTextChanged(const QString& text) noexcept {
     } else {
       // Change tab order: https://github.com/LibrePCB/LibrePCB/issues/1059
       setTabOrder(mUi->treeCategories, mUi->edtSearch);
-      searchComponents(text.trimmed());
+      mSearchTimer.start();
     }
   } catch (const Exception& e) {
     mUi->lblErrorMsg->setText(e.getMsg());
@@ -266,22 +281,26 @@ void AddComponentDialog::treeComponents_currentItemChanged(
       FilePath cmpFp = FilePath(cmpItem->data(0, Qt::UserRole).toString());
       if ((!mSelectedComponent) ||
           (mSelectedComponent->getDirectory().getAbsPath() != cmpFp)) {
-        std::shared_ptr<Component> component(
-            Component::open(std::unique_ptr<TransactionalDirectory>(
-                                new TransactionalDirectory(
-                                    TransactionalFileSystem::openRO(cmpFp))))
-                .release());
+        std::shared_ptr<const Component> component =
+            mElementCache->getComponent(cmpFp);
+        if (!component) {
+          throw RuntimeError(
+              __FILE__, __LINE__,
+              tr("Failed to open component \"%1\".").arg(cmpFp.toNative()));
+        }
         setSelectedComponent(component);
       }
       if (devItem) {
         FilePath devFp = FilePath(devItem->data(0, Qt::UserRole).toString());
         if ((!mSelectedDevice) ||
             (mSelectedDevice->getDirectory().getAbsPath() != devFp)) {
-          std::shared_ptr<Device> device(
-              Device::open(std::unique_ptr<TransactionalDirectory>(
-                               new TransactionalDirectory(
-                                   TransactionalFileSystem::openRO(devFp))))
-                  .release());
+          std::shared_ptr<const Device> device =
+              mElementCache->getDevice(devFp);
+          if (!device) {
+            throw RuntimeError(
+                __FILE__, __LINE__,
+                tr("Failed to open device \"%1\".").arg(devFp.toNative()));
+          }
           setSelectedDevice(device);
         }
         setSelectedPart(
@@ -335,10 +354,12 @@ void AddComponentDialog::searchComponents(
   mUi->treeComponents->clear();
 
   QTreeWidgetItem* selectedDeviceItem = nullptr;
+  bool resultTruncated = false;
 
   // min. 2 chars to avoid freeze on entering first character due to huge result
   if (input.length() > 1) {
     SearchResult result = search(input);
+    resultTruncated = result.truncated;
     const bool expandAllDevices =
         (result.partsCount <= 15) || (result.deviceCount <= 1);
     const bool expandAllComponents =
@@ -382,6 +403,16 @@ void AddComponentDialog::searchComponents(
 
   mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
 
+  // Hint about omitted matches, added after sorting to keep it at the end.
+  if (resultTruncated) {
+    QTreeWidgetItem* item = new QTreeWidgetItem(mUi->treeComponents);
+    item->setText(0, tr("More results available, refine the search term..."));
+    item->setFlags(Qt::NoItemFlags);
+    QFont font = item->font(0);
+    font.setItalic(true);
+    item->setFont(0, font);
+  }
+
   if (selectedDeviceItem) {
     mUi->treeComponents->setCurrentItem(selectedDeviceItem);
     while (selectedDeviceItem->parent()) {
@@ -422,10 +453,13 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
   const QList<Uuid> matchingDevices = mDb.find<Device>(input);  // can throw
   const QList<Uuid> matchingPartDevices =
       mDb.findDevicesOfParts(input);  // can throw
+  result.truncated = (matchingComponents.count() > sMaxMatches) ||
+      (matchingDevices.count() > sMaxMatches) ||
+      (matchingPartDevices.count() > sMaxMatches);
 
   // Add matching components and all their devices and parts.
   QSet<Uuid> fullyAddedDevices;
-  foreach (const Uuid& cmpUuid, matchingComponents) {
+  foreach (const Uuid& cmpUuid, matchingComponents.mid(0, sMaxMatches)) {
     FilePath cmpFp = mDb.getLatest<Component>(cmpUuid);  // can throw
     if (!cmpFp.isValid()) continue;
     QSet<Uuid> devices = mDb.getComponentDevices(cmpUuid);  // can throw
@@ -455,8 +489,8 @@ AddComponentDialog::SearchResult AddComponentDialog::search(
   }
 
   // Add matching devices + parts and their corresponding components.
-  QList<Uuid> devices = matchingPartDevices;
-  foreach (const Uuid& uuid, matchingDevices) {
+  QList<Uuid> devices = matchingPartDevices.mid(0, sMaxMatches);
+  foreach (const Uuid& uuid, matchingDevices.mid(0, sMaxMatches)) {
     if (!devices.contains(uuid)) {
       devices.append(uuid);
     }
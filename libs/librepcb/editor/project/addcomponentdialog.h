@@ -54,6 +54,7 @@ namespace editor {
 class DefaultGraphicsLayerProvider;
 class FootprintGraphicsItem;
 class GraphicsScene;
+class LibraryElementCache;
 class SymbolGraphicsItem;
 
 namespace Ui {
@@ -92,6 +93,7 @@ class AddComponentDialog final : public QDialog {
     QHash<FilePath, SearchResultComponent> components;
     int deviceCount = 0;
     int partsCount = 0;
+    bool truncated = false;  ///< Some matches omitted due to #sMaxMatches
   };
 
 public:
@@ -165,8 +167,14 @@ private:
   void addPartItem(std::shared_ptr<Part> part, QTreeWidgetItem* parent);
   void accept() noexcept;
 
+  /// Maximum number of matching components, devices and parts each to list.
+  /// More matches are omitted to keep searching responsive with huge
+  /// libraries, the user has to refine the search term to find them.
+  static const int sMaxMatches = 100;
+
   // General
   const WorkspaceLibraryDb& mDb;
+  QScopedPointer<LibraryElementCache> mElementCache;
   QStringList mLocaleOrder;
   QStringList mNormOrder;
   QScopedPointer<Ui::AddComponentDialog> mUi;
@@ -175,6 +183,7 @@ private:
   QScopedPointer<DefaultGraphicsLayerProvider> mGraphicsLayerProvider;
   QScopedPointer<CategoryTreeModel> mCategoryTreeModel;
   QString mCurrentSearchTerm;
+  QTimer mSearchTimer;  ///< Delays the search until typing was paused
 
   // Attributes
   tl::optional<Uuid> mSelectedCategoryUuid;
@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "boardclipboarddata.h"
 
+#include "../../utils/clipboardmimedata.h"
+
 #include <librepcb/core/application.h>
 #include <librepcb/core/fileio/transactionaldirectory.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
@@ -42,7 +44,13 @@ namespace editor {
 
 BoardClipboardData::BoardClipboardData(const Uuid& boardUuid,
                                        const Point& cursorPos) noexcept
-  : mFileSystem(TransactionalFileSystem::openRW(FilePath::getRandomTempPath())),
+  : BoardClipboardData(createClipboardFileSystem(), boardUuid, cursorPos) {
+}
+
+BoardClipboardData::BoardClipboardData(
+    const std::shared_ptr<TransactionalFileSystem>& fs, const Uuid& boardUuid,
+    const Point& cursorPos) noexcept
+  : mFileSystem(fs),
     mBoardUuid(boardUuid),
     mCursorPos(cursorPos),
     mDevices(),
@@ -92,11 +100,8 @@ BoardClipboardData::BoardClipboardData(const QByteArray& mimeData)
 }
 
 BoardClipboardData::~BoardClipboardData() noexcept {
-  // Clean up the temporary directory, but destroy the TransactionalFileSystem
-  // object first since it has a lock on the directory.
-  FilePath fp = mFileSystem->getAbsPath();
-  mFileSystem.reset();
-  QDir(fp.toStr()).removeRecursively();
+  // Note: The temporary directory is removed by the file system once the
+  // last copy of it has been released, see createClipboardFileSystem().
 }
 
 /*******************************************************************************
@@ -119,7 +124,32 @@ std::unique_ptr<TransactionalDirectory> BoardClipboardData::getDirectory(
  *  General Methods
  ******************************************************************************/
 
-std::unique_ptr<QMimeData> BoardClipboardData::toMimeData() const {
+std::unique_ptr<QMimeData> BoardClipboardData::toMimeData() noexcept {
+  // Only a shallow copy is stored in the MIME data, serialization is done
+  // lazily when the content is requested from the clipboard.
+  return std::unique_ptr<QMimeData>(new ClipboardMimeData<BoardClipboardData>(
+      std::shared_ptr<BoardClipboardData>(shallowCopy().release()),
+      getMimeType()));
+}
+
+std::unique_ptr<BoardClipboardData> BoardClipboardData::fromMimeData(
+    const QMimeData* mime) {
+  // Fast path for data copied within this application instance.
+  typedef ClipboardMimeData<BoardClipboardData> OwnMimeData;
+  if (const OwnMimeData* own = dynamic_cast<const OwnMimeData*>(mime)) {
+    return own->getData()->shallowCopy();
+  }
+
+  QByteArray content = mime ? mime->data(getMimeType()) : QByteArray();
+  if (!content.isNull()) {
+    return std::unique_ptr<BoardClipboardData>(
+        new BoardClipboardData(content));  // can throw
+  } else {
+    return nullptr;
+  }
+}
+
+QByteArray BoardClipboardData::serializeToZip(QByteArray& content) const {
   SExpression root = SExpression::createList("librepcb_clipboard_board");
   root.ensureLineBreak();
   mCursorPos.serialize(root.appendList("cursor_position"));
@@ -161,35 +191,35 @@ std::unique_ptr<QMimeData> BoardClipboardData::toMimeData() const {
   }
   root.ensureLineBreak();
 
-  const QByteArray sexpr = root.toByteArray();
-  mFileSystem->write("board.lp", sexpr);
-  const QByteArray zip = mFileSystem->exportToZip();
-
-  std::unique_ptr<QMimeData> data(new QMimeData());
-  data->setData(getMimeType(), zip);
-  data->setData("application/zip", zip);
-  // Note: At least on one system the clipboard didn't work if no text was
-  // set, so let's also copy the SExpression as text as a workaround. This
-  // might be useful anyway, e.g. for debugging purposes.
-  data->setText(QString::fromUtf8(sexpr));
-  return data;
-}
-
-std::unique_ptr<BoardClipboardData> BoardClipboardData::fromMimeData(
-    const QMimeData* mime) {
-  QByteArray content = mime ? mime->data(getMimeType()) : QByteArray();
-  if (!content.isNull()) {
-    return std::unique_ptr<BoardClipboardData>(
-        new BoardClipboardData(content));  // can throw
-  } else {
-    return nullptr;
-  }
+  content = root.toByteArray();
+  mFileSystem->write("board.lp", content);
+  return mFileSystem->exportToZip();  // can throw
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+std::unique_ptr<BoardClipboardData> BoardClipboardData::shallowCopy() noexcept {
+  std::unique_ptr<BoardClipboardData> copy(
+      new BoardClipboardData(mFileSystem, mBoardUuid, mCursorPos));
+  foreach (const auto& obj, mDevices.values()) {
+    copy->mDevices.append(obj);
+  }
+  foreach (const auto& obj, mNetSegments.values()) {
+    copy->mNetSegments.append(obj);
+  }
+  foreach (const auto& obj, mPlanes.values()) {
+    copy->mPlanes.append(obj);
+  }
+  copy->mZones = mZones;
+  copy->mPolygons = mPolygons;
+  copy->mStrokeTexts = mStrokeTexts;
+  copy->mHoles = mHoles;
+  copy->mPadPositions = mPadPositions;
+  return copy;
+}
+
 QString BoardClipboardData::getMimeType() noexcept {
   return QString("application/x-librepcb-clipboard.board; version=%1")
       .arg(Application::getVersion());
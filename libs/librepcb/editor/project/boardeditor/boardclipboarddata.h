@@ -60,6 +60,11 @@ namespace editor {
 
 /**
  * @brief The BoardClipboardData class
+ *
+ * Within the same application instance, the clipboard contains the data
+ * object itself (see ::librepcb::editor::ClipboardMimeData), so copy & paste
+ * does not need to serialize and parse the items and library elements. The
+ * serialized Zip file is only generated when requested by another process.
  */
 class BoardClipboardData final {
 public:
@@ -296,14 +301,34 @@ public:
   }
 
   // General Methods
-  std::unique_ptr<QMimeData> toMimeData() const;
+  std::unique_ptr<QMimeData> toMimeData() noexcept;
   static std::unique_ptr<BoardClipboardData> fromMimeData(
       const QMimeData* mime);
 
+  /**
+   * @brief Serialize the data into a Zip file
+   *
+   * @param content   The content of the main file (S-Expression) is
+   *                  returned here.
+   *
+   * @return The Zip file containing the data and library elements.
+   */
+  QByteArray serializeToZip(QByteArray& content) const;
+
   // Operator Overloadings
   BoardClipboardData& operator=(const BoardClipboardData& rhs) = delete;
 
 private:  // Methods
+  BoardClipboardData(const std::shared_ptr<TransactionalFileSystem>& fs,
+                     const Uuid& boardUuid, const Point& cursorPos) noexcept;
+
+  /**
+   * @brief Create a copy which shares the items and the file system
+   *
+   * @note  The items are not copied, so they must not be modified.
+   */
+  std::unique_ptr<BoardClipboardData> shallowCopy() noexcept;
+
   static QString getMimeType() noexcept;
 
 private:  // Data
@@ -120,6 +120,8 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
   mUi->setupUi(this);
   mUi->tabBar->setDocumentMode(true);  // For MacOS
   mUi->lblUnplacedComponentsNote->hide();
+  mPlaneFragmentsBuilder->setFileCache(
+      Application::getCacheDir().getPathTo("planes"));
 
   // Setup graphics view.
   const Theme& theme =
@@ -136,6 +138,8 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
   mUi->graphicsView->setGridStyle(theme.getBoardGridStyle());
   mUi->graphicsView->setUseOpenGl(
       mProjectEditor.getWorkspace().getSettings().useOpenGl.get());
+  mUi->graphicsView->setShowRenderStatistics(
+      mProjectEditor.getWorkspace().getSettings().showRenderStatistics.get());
   mUi->graphicsView->setEventHandlerObject(this);
   connect(mUi->graphicsView, &GraphicsView::cursorScenePositionChanged,
           mUi->statusbar, &StatusBar::setAbsoluteCursorPosition);
@@ -155,6 +159,12 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
           &BoardPlaneFragmentsBuilder::boardPlanesModified, this,
           &BoardEditor::scheduleOpenGlSceneUpdate);
 
+  // Keep graphics export painters only as long as the boards are unmodified.
+  // Note that plane fragments are also modified without undo command, e.g.
+  // by the DRC, see boardAdded().
+  connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified, this,
+          [this]() { mGraphicsExportPainters.clear(); });
+
   // Setup status bar.
   mUi->statusbar->setFields(StatusBar::AbsolutePosition |
                             StatusBar::ProgressBar);
@@ -345,6 +355,13 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept {
                                        : tl::nullopt);
     mDockDrc->setApprovals(mActiveBoard ? mActiveBoard->getDrcMessageApprovals()
                                         : QSet<SExpression>());
+    QStringList drcProfiles;
+    if (mActiveBoard) {
+      for (const auto& profile : mActiveBoard->getDrcSettings().getProfiles()) {
+        drcProfiles.append(profile.name);
+      }
+    }
+    mDockDrc->setProfiles(drcProfiles);
 
     // update toolbars
     mActionGridProperties->setEnabled(mActiveBoard != nullptr);
@@ -401,6 +418,12 @@ void BoardEditor::boardAdded(int newIndex) {
 
   mUi->tabBar->insertTab(newIndex, *board->getName());
 
+  // Plane fragments are modified by every plane rebuild (e.g. by the DRC),
+  // so the graphics export painter of the board must be created again.
+  connect(board, &Board::planeFragmentsChanged, this, [this, board]() {
+    mGraphicsExportPainters.remove(board->getUuid());
+  });
+
   // To avoid wasting space, only show the tab bar if there are multiple boards.
   mUi->tabBar->setVisible(mUi->tabBar->count() > 1);
 }
@@ -580,6 +603,9 @@ void BoardEditor::createActions() noexcept {
       cmd.runQuickCheck.createAction(this, this, [this]() { runDrc(true); }));
   mActionRunDesignRuleCheck.reset(cmd.runDesignRuleCheck.createAction(
       this, this, [this]() { runDrc(false); }));
+  mActionRunDesignRuleCheckForSelection.reset(
+      cmd.runDesignRuleCheckForSelection.createAction(
+          this, this, &BoardEditor::runDrcForSelection));
   mActionImportDxf.reset(cmd.importDxf.createAction(
       this, mFsm.data(), &BoardEditorFsm::processImportDxf));
   mActionExportLppz.reset(cmd.exportLppz.createAction(
@@ -992,6 +1018,8 @@ void BoardEditor::createDockWidgets() noexcept {
           [this]() { runDrc(false); });
   connect(mDockDrc.data(), &RuleCheckDock::runQuickCheckRequested, this,
           [this]() { runDrc(true); });
+  connect(mDockDrc.data(), &RuleCheckDock::runProfileRequested, this,
+          [this](const QString& name) { runDrcProfile(name); });
   connect(mDockDrc.data(), &RuleCheckDock::messageSelected, this,
           &BoardEditor::highlightDrcMessage);
   connect(mDockDrc.data(), &RuleCheckDock::messageApprovalRequested, this,
@@ -1111,6 +1139,7 @@ void BoardEditor::createMenus() noexcept {
   mb.addAction(mActionRebuildPlanes);
   mb.addAction(mActionRunQuickCheck);
   mb.addAction(mActionRunDesignRuleCheck);
+  mb.addAction(mActionRunDesignRuleCheckForSelection);
   mb.addSeparator();
   mb.addAction(mActionNewBoard);
   mb.addAction(mActionCopyBoard);
@@ -1307,10 +1336,24 @@ void BoardEditor::unplacedComponentsCountChanged(int count) noexcept {
 }
 
 void BoardEditor::runDrc(bool quick) noexcept {
+  runDrcProfile(quick ? BoardDesignRuleCheckSettings::getQuickProfile().name
+                      : BoardDesignRuleCheckSettings::getFullProfile().name);
+}
+
+void BoardEditor::runDrcProfile(const QString& name,
+                                const QVector<Path>& region) noexcept {
   try {
     Board* board = getActiveBoard();
     if (!board) return;
 
+    // Custom profiles may override the built-in profiles.
+    const tl::optional<BoardDesignRuleCheckSettings::Profile> profile =
+        board->getDrcSettings().findProfile(name);
+    if (!profile) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("Unknown DRC profile: '%1'").arg(name));
+    }
+
     // Make sure the DRC dock is visible because of the progress bar.
     mDockDrc->show();
     mDockDrc->raise();
@@ -1327,11 +1370,45 @@ void BoardEditor::runDrc(bool quick) noexcept {
     QElapsedTimer timer;
     timer.start();
     BoardDesignRuleCheck drc(*board, board->getDrcSettings());
+    std::shared_ptr<BoardDesignRuleCheckCache>& cache =
+        mDrcCaches[board->getUuid()];
+    if (!cache) {
+      cache = std::make_shared<BoardDesignRuleCheckCache>();
+    }
+    drc.setCache(cache);
+    drc.setRegion(region);
     connect(&drc, &BoardDesignRuleCheck::progressPercent, mDockDrc.data(),
             &RuleCheckDock::setProgressPercent);
     connect(&drc, &BoardDesignRuleCheck::progressStatus, mDockDrc.data(),
             &RuleCheckDock::setProgressStatus);
-    drc.execute(quick);  // can throw
+
+    // Show the messages of the finished checks while the other checks are
+    // still running. The DRC blocks while the checks are running, only the
+    // modal progress dialog processes events when its value is updated after
+    // each check (i.e. canceling takes effect after the current check). It
+    // is application modal since the project must not be modified meanwhile.
+    connect(&drc, &BoardDesignRuleCheck::progressPercent, mDockDrc.data(),
+            [this, &drc]() {
+              mDockDrc->setIntermediateMessages(drc.getMessages());
+            });
+    QProgressDialog progress(tr("Run design rule check..."), tr("Cancel"), 0,
+                             100, this);
+    progress.setWindowModality(Qt::ApplicationModal);
+    progress.show();
+    connect(&drc, &BoardDesignRuleCheck::progressStatus, &progress,
+            &QProgressDialog::setLabelText);
+    connect(&drc, &BoardDesignRuleCheck::progressPercent, &progress,
+            &QProgressDialog::setValue);
+    connect(&progress, &QProgressDialog::canceled, &drc,
+            &BoardDesignRuleCheck::cancel);
+    try {
+      drc.execute(*profile);  // can throw
+    } catch (const UserCanceled& e) {
+      Q_UNUSED(e);
+      mDockDrc->setMessages(mDrcMessages.value(board->getUuid()));
+      return;
+    }
+    progress.close();
 
     // Update DRC messages.
     clearDrcMarker();
@@ -1339,21 +1416,50 @@ void BoardEditor::runDrc(bool quick) noexcept {
     mDockDrc->setMessages(drc.getMessages());
 
     // Detect & remove disappeared messages.
-    const QSet<SExpression> approvals =
-        RuleCheckMessage::getAllApprovals(drc.getMessages());
-    if (board->updateDrcMessageApprovals(approvals, quick)) {
+    const QSet<QByteArray> approvalKeys =
+        RuleCheckMessage::getAllApprovalKeys(drc.getMessages());
+    const bool partialRun = (!profile->isComplete()) || (!region.isEmpty());
+    if (board->updateDrcMessageApprovals(approvalKeys, partialRun)) {
       mDockDrc->setApprovals(board->getDrcMessageApprovals());
       mProjectEditor.setManualModificationsMade();
     }
 
-    // Print how long it took.
-    qDebug() << (quick ? "Quick check" : "DRC") << "succeeded after"
-             << timer.elapsed() << "ms.";
+    // Print how long it took, in total and per check.
+    qDebug().nospace() << "DRC with profile '" << profile->name
+                       << "' succeeded after " << timer.elapsed() << "ms.";
+    QStringList report;
+    report.append(tr("Duration of the last run:"));
+    foreach (const auto& timing, drc.getTimings()) {
+      const QString messages =
+          tr("%n message(s)", nullptr, timing.messageCount);
+      report.append(QString("%1: %2 ms (%3)")
+                        .arg(timing.name)
+                        .arg(timing.durationNs / 1000000)
+                        .arg(messages));
+    }
+    mDockDrc->setTimingReport(report.join("\n"));
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Error"), e.getMsg());
   }
 }
 
+void BoardEditor::runDrcForSelection() noexcept {
+  QVector<Path> region;
+  if (QGraphicsScene* scene = mUi->graphicsView->scene()) {
+    foreach (const QGraphicsItem* item, scene->selectedItems()) {
+      const QRectF rect = item->sceneBoundingRect();
+      region.append(Path::rect(Point::fromPx(rect.topLeft()),
+                               Point::fromPx(rect.bottomRight())));
+    }
+  }
+  if (region.isEmpty()) {
+    const QRectF rect = mUi->graphicsView->getVisibleSceneRect();
+    region.append(Path::rect(Point::fromPx(rect.topLeft()),
+                             Point::fromPx(rect.bottomRight())));
+  }
+  runDrcProfile(BoardDesignRuleCheckSettings::getFullProfile().name, region);
+}
+
 void BoardEditor::highlightDrcMessage(const RuleCheckMessage& msg,
                                       bool zoomTo) noexcept {
   if (msg.getLocations().isEmpty()) {
@@ -1470,6 +1576,19 @@ void BoardEditor::performScheduledTasks() noexcept {
     startPlaneRebuild(false);
   }
 
+  // During longer quiet periods, also rebuild modified planes on hidden
+  // layers in the background. Thus they are already up to date when the
+  // layers are shown again or exported, instead of being rebuilt while the
+  // user is waiting. If nothing was modified, no job is started at all.
+  const bool userInputLongIdle = (mUi->graphicsView->getIdleTimeMs() >= 3000);
+  Board* board = getActiveBoard();
+  if (board && mPlaneFragmentsBuilder && (!mPlaneFragmentsBuilder->isBusy()) &&
+      (!commandActive) && userInputLongIdle && (planeBuildPauseMs >= 1000) &&
+      isActiveTopLevelWindow()) {
+    const QSet<const Layer*> layers = board->getCopperLayers();
+    mPlaneFragmentsBuilder->startAsynchronously(*board, &layers);
+  }
+
   // Update 3D scene, if needed.
   const bool planesRebuilding =
       mPlaneFragmentsBuilder && mPlaneFragmentsBuilder->isBusy();
@@ -1480,7 +1599,7 @@ void BoardEditor::performScheduledTasks() noexcept {
       updateAllowedInCurrentState && (openGlBuildPauseMs >= 1000) &&
       isActiveTopLevelWindow()) {
     std::shared_ptr<SceneData3D> data;
-    if (Board* board = getActiveBoard()) {
+    if (board) {
       auto av = mProject.getCircuit().getAssemblyVariants().value(0);
       data = board->buildScene3D(av ? tl::make_optional(av->getUuid())
                                     : tl::nullopt);
@@ -1660,18 +1779,25 @@ void BoardEditor::execGraphicsExportDialog(
         QString("output/%1/%2_Board").arg(projectVersion, projectName);
     FilePath defaultFilePath = mProject.getPath().getPathTo(relativePath);
 
-    // Copy board to allow processing it in worker threads.
+    // Copy board to allow processing it in worker threads. The painter is
+    // reused as long as the board is not modified, so its painting content
+    // doesn't need to be collected again for every export.
     QList<std::shared_ptr<GraphicsPagePainter>> pages;
     if (mActiveBoard) {
-      QProgressDialog progress(tr("Preparing board..."), tr("Cancel"), 0, 1,
-                               this);
-      progress.setWindowModality(Qt::WindowModal);
-      progress.setMinimumDuration(100);
-      pages.append(std::make_shared<BoardPainter>(*mActiveBoard));
-      progress.setValue(1);
-      if (progress.wasCanceled()) {
-        return;
+      std::shared_ptr<BoardPainter>& painter =
+          mGraphicsExportPainters[mActiveBoard->getUuid()];
+      if (!painter) {
+        QProgressDialog progress(tr("Preparing board..."), tr("Cancel"), 0, 1,
+                                 this);
+        progress.setWindowModality(Qt::WindowModal);
+        progress.setMinimumDuration(100);
+        painter = std::make_shared<BoardPainter>(*mActiveBoard);
+        progress.setValue(1);
+        if (progress.wasCanceled()) {
+          return;
+        }
       }
+      pages.append(painter);
     }
 
     // Show dialog, which will do all the work.
@@ -1768,6 +1894,8 @@ void BoardEditor::execD356NetlistExportDialog() noexcept {
 bool BoardEditor::show3DView() noexcept {
   if (!mOpenGlView) {
     mOpenGlView.reset(new OpenGlView(this));
+    mOpenGlView->setShowRenderStatistics(
+        mProjectEditor.getWorkspace().getSettings().showRenderStatistics.get());
     mUi->mainLayout->insertWidget(2, mOpenGlView.data(), 1);
     mOpenGlSceneBuilder.reset(new OpenGlSceneBuilder());
     connect(mOpenGlSceneBuilder.data(), &OpenGlSceneBuilder::started,
@@ -40,6 +40,8 @@
  ******************************************************************************/
 namespace librepcb {
 
+struct BoardDesignRuleCheckCache;
+class BoardPainter;
 class BoardPlaneFragmentsBuilder;
 class ComponentInstance;
 class Project;
@@ -149,6 +151,9 @@ private:
   void toolRequested(const QVariant& newTool) noexcept;
   void unplacedComponentsCountChanged(int count) noexcept;
   void runDrc(bool quick) noexcept;
+  void runDrcProfile(const QString& name,
+                     const QVector<Path>& region = QVector<Path>()) noexcept;
+  void runDrcForSelection() noexcept;
   void highlightDrcMessage(const RuleCheckMessage& msg, bool zoomTo) noexcept;
   void setDrcMessageApproved(const RuleCheckMessage& msg,
                              bool approved) noexcept;
@@ -198,8 +203,14 @@ private:
 
   // DRC
   QHash<Uuid, tl::optional<RuleCheckMessageList>> mDrcMessages;  ///< UUID=Board
+  QHash<Uuid, std::shared_ptr<BoardDesignRuleCheckCache>>
+      mDrcCaches;  ///< UUID=Board
   QScopedPointer<QGraphicsPathItem> mDrcLocationGraphicsItem;
 
+  // Graphics Export
+  QHash<Uuid, std::shared_ptr<BoardPainter>>
+      mGraphicsExportPainters;  ///< UUID=Board, cleared on modifications
+
   // Actions
   QScopedPointer<QAction> mActionAboutLibrePcb;
   QScopedPointer<QAction> mActionAboutQt;
@@ -218,6 +229,7 @@ private:
   QScopedPointer<QAction> mActionBoardSetup;
   QScopedPointer<QAction> mActionRunQuickCheck;
   QScopedPointer<QAction> mActionRunDesignRuleCheck;
+  QScopedPointer<QAction> mActionRunDesignRuleCheckForSelection;
   QScopedPointer<QAction> mActionImportDxf;
   QScopedPointer<QAction> mActionExportLppz;
   QScopedPointer<QAction> mActionExportImage;
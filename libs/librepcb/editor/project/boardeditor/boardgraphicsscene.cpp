@@ -47,6 +47,9 @@
 #include <librepcb/core/project/board/items/bi_stroketext.h>
 #include <librepcb/core/project/board/items/bi_via.h>
 #include <librepcb/core/project/board/items/bi_zone.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/componentsignalinstance.h>
+#include <librepcb/core/project/circuit/netsignal.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/types/layer.h>
 
@@ -70,7 +73,13 @@ BoardGraphicsScene::BoardGraphicsScene(
   : GraphicsScene(parent),
     mBoard(board),
     mLayerProvider(lp),
-    mHighlightedNetSignals(highlightedNetSignals) {
+    mHighlightedNetSignals(highlightedNetSignals),
+    mLastHighlightedNetSignals(*highlightedNetSignals) {
+  // Disable the item index while adding all the items, to build it only once
+  // at the end instead of updating it after each added item.
+  const ItemIndexMethod indexMethod = itemIndexMethod();
+  setItemIndexMethod(QGraphicsScene::NoIndex);
+
   foreach (BI_Device* obj, mBoard.getDeviceInstances()) {
     addDevice(*obj);
   }
@@ -96,6 +105,8 @@ BoardGraphicsScene::BoardGraphicsScene(
     addAirWire(*obj);
   }
 
+  setItemIndexMethod(indexMethod);
+
   connect(&mBoard, &Board::deviceAdded, this, &BoardGraphicsScene::addDevice);
   connect(&mBoard, &Board::deviceRemoved, this,
           &BoardGraphicsScene::removeDevice);
@@ -201,9 +212,24 @@ void BoardGraphicsScene::selectItemsInRect(const Point& p1,
                                            const Point& p2) noexcept {
   GraphicsScene::setSelectionRect(p1, p2);
   const QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+  auto intersects = [&rectPx](const QGraphicsItem& item) {
+    // Check the bounding rect first, since mapping and intersecting the
+    // shape is expensive.
+    const QRectF boundingRect = item.sceneBoundingRect();
+    if (!boundingRect.intersects(rectPx)) {
+      return false;
+    }
+    const QPainterPath shape = item.shape();
+    if (shape.isEmpty()) {
+      return false;  // Item is not selectable (e.g. hidden layer).
+    } else if (rectPx.contains(boundingRect)) {
+      return true;
+    } else {
+      return item.mapToScene(shape).intersects(rectPx);
+    }
+  };
   foreach (auto item, mDevices) {
-    const bool selectSymbol =
-        item->mapToScene(item->shape()).intersects(rectPx);
+    const bool selectSymbol = intersects(*item);
     item->setSelected(selectSymbol);
   }
   foreach (auto item, mFootprintPads) {
@@ -211,36 +237,35 @@ void BoardGraphicsScene::selectItemsInRect(const Point& p1,
     if (auto device = item->getDeviceGraphicsItem().lock()) {
       deviceSelected = device->isSelected();
     }
-    item->setSelected(deviceSelected ||
-                      item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(deviceSelected || intersects(*item));
   }
   foreach (auto item, mVias) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mNetPoints) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mNetLines) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mPlanes) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mZones) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mPolygons) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mStrokeTexts) {
     if (auto device = item->getDeviceGraphicsItem().lock()) {
       item->setSelected(device->isSelected());
     } else {
-      item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+      item->setSelected(intersects(*item));
     }
   }
   foreach (auto item, mHoles) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
 }
 
@@ -296,6 +321,31 @@ void BoardGraphicsScene::clearSelection() noexcept {
 }
 
 void BoardGraphicsScene::updateHighlightedNetSignals() noexcept {
+  // Usually only the highlighting of a few nets changes, so only update the
+  // items of these nets by using the items registered in the net signals.
+  // Items without net are not tracked, thus they need a full update.
+  const QSet<const NetSignal*>& current = *mHighlightedNetSignals;
+  const QSet<const NetSignal*> changed =
+      (current | mLastHighlightedNetSignals) -
+      (current & mLastHighlightedNetSignals);
+  mLastHighlightedNetSignals = current;
+
+  // The net signals of the last update might have been removed in the
+  // meantime, thus they must only be compared, never dereferenced. Items of
+  // removed nets might have been moved to other nets, so if any of the
+  // changed nets no longer exists, a full update is needed as well.
+  QSet<const NetSignal*> existing;
+  foreach (const NetSignal* netSignal,
+           mBoard.getProject().getCircuit().getNetSignals()) {
+    existing.insert(netSignal);
+  }
+  if ((!changed.contains(nullptr)) && (changed - existing).isEmpty()) {
+    foreach (const NetSignal* netSignal, changed) {
+      updateItemsOfNetSignal(*netSignal);
+    }
+    return;
+  }
+
   foreach (auto item, mFootprintPads) {
     item->updateHighlightedNetSignals();
   }
@@ -593,6 +643,43 @@ void BoardGraphicsScene::removeAirWire(BI_AirWire& airWire) noexcept {
   }
 }
 
+void BoardGraphicsScene::updateItemsOfNetSignal(
+    const NetSignal& netSignal) noexcept {
+  // Items of other boards are not contained in the hashes, so they are
+  // skipped by the lookups (net segments of other boards even earlier).
+  foreach (const ComponentSignalInstance* cmpSig,
+           netSignal.getComponentSignals()) {
+    foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
+      if (auto item = mFootprintPads.value(pad)) {
+        item->updateHighlightedNetSignals();
+      }
+    }
+  }
+  foreach (const BI_NetSegment* netSegment, netSignal.getBoardNetSegments()) {
+    if (&netSegment->getBoard() != &mBoard) continue;
+    foreach (BI_Via* via, netSegment->getVias()) {
+      if (auto item = mVias.value(via)) {
+        item->update();
+      }
+    }
+    foreach (BI_NetLine* netLine, netSegment->getNetLines()) {
+      if (auto item = mNetLines.value(netLine)) {
+        item->update();
+      }
+    }
+  }
+  foreach (BI_Plane* plane, netSignal.getBoardPlanes()) {
+    if (auto item = mPlanes.value(plane)) {
+      item->update();
+    }
+  }
+  foreach (BI_AirWire* airWire, mBoard.getAirWires(netSignal)) {
+    if (auto item = mAirWires.value(airWire)) {
+      item->update();
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
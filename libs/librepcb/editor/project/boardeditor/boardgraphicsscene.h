@@ -206,11 +206,13 @@ private:  // Methods
   void removeHole(BI_Hole& hole) noexcept;
   void addAirWire(BI_AirWire& airWire) noexcept;
   void removeAirWire(BI_AirWire& airWire) noexcept;
+  void updateItemsOfNetSignal(const NetSignal& netSignal) noexcept;
 
 private:  // Data
   Board& mBoard;
   const IF_GraphicsLayerProvider& mLayerProvider;
   std::shared_ptr<const QSet<const NetSignal*>> mHighlightedNetSignals;
+  QSet<const NetSignal*> mLastHighlightedNetSignals;
   QHash<BI_Device*, std::shared_ptr<BGI_Device>> mDevices;
   QHash<BI_FootprintPad*, std::shared_ptr<BGI_FootprintPad>> mFootprintPads;
   QHash<BI_Via*, std::shared_ptr<BGI_Via>> mVias;
@@ -29,6 +29,7 @@
 #include <librepcb/core/export/pickplacecsvwriter.h>
 #include <librepcb/core/export/pickplacedata.h>
 #include <librepcb/core/fileio/csvfile.h>
+#include <librepcb/core/fileio/csvwriter.h>
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/board/boardgerberexport.h>
 #include <librepcb/core/project/board/boardpickplacegenerator.h>
@@ -160,12 +161,16 @@ void BoardPickPlaceGeneratorDialog::btnGenerateClicked() noexcept {
           mUi->rbtnFormatCsvWithMetadata->isChecked());
       if (mUi->cbxTopDevices->isChecked()) {
         writer.setBoardSide(PickPlaceCsvWriter::BoardSide::Top);
-        writer.generateCsv()->saveToFile(
+        CsvWriter csv;
+        writer.writeCsv(csv);
+        csv.saveToFile(
             getOutputFilePath(mUi->edtTopFilePath->text()));  // can throw
       }
       if (mUi->cbxBottomDevices->isChecked()) {
         writer.setBoardSide(PickPlaceCsvWriter::BoardSide::Bottom);
-        writer.generateCsv()->saveToFile(
+        CsvWriter csv;
+        writer.writeCsv(csv);
+        csv.saveToFile(
             getOutputFilePath(mUi->edtBottomFilePath->text()));  // can throw
       }
     }
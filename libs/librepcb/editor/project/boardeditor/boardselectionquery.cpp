@@ -99,97 +99,84 @@ int BoardSelectionQuery::getResultCount() const noexcept {
  ******************************************************************************/
 
 void BoardSelectionQuery::addDeviceInstancesOfSelectedFootprints() noexcept {
-  for (auto it = mScene.getDevices().begin(); it != mScene.getDevices().end();
-       it++) {
-    if (it.value()->isSelected() &&
-        ((!it.key()->isLocked()) || mIncludeLockedItems)) {
-      mResultDeviceInstances.insert(it.key());
+  foreach (BGI_Device* item, getSelectedItems<BGI_Device>()) {
+    BI_Device& device = item->getDevice();
+    if ((!device.isLocked()) || mIncludeLockedItems) {
+      mResultDeviceInstances.insert(&device);
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedVias() noexcept {
-  for (auto it = mScene.getVias().begin(); it != mScene.getVias().end(); it++) {
-    if (it.value()->isSelected()) {
-      mResultVias.insert(it.key());
-    }
+  foreach (BGI_Via* item, getSelectedItems<BGI_Via>()) {
+    mResultVias.insert(&item->getVia());
   }
 }
 
 void BoardSelectionQuery::addSelectedNetPoints() noexcept {
-  for (auto it = mScene.getNetPoints().begin();
-       it != mScene.getNetPoints().end(); it++) {
-    if (it.value()->isSelected()) {
-      mResultNetPoints.insert(it.key());
-    }
+  foreach (BGI_NetPoint* item, getSelectedItems<BGI_NetPoint>()) {
+    mResultNetPoints.insert(&item->getNetPoint());
   }
 }
 
 void BoardSelectionQuery::addSelectedNetLines() noexcept {
-  for (auto it = mScene.getNetLines().begin(); it != mScene.getNetLines().end();
-       it++) {
-    if (it.value()->isSelected()) {
-      mResultNetLines.insert(it.key());
-    }
+  foreach (BGI_NetLine* item, getSelectedItems<BGI_NetLine>()) {
+    mResultNetLines.insert(&item->getNetLine());
   }
 }
 
 void BoardSelectionQuery::addSelectedPlanes() noexcept {
-  for (auto it = mScene.getPlanes().begin(); it != mScene.getPlanes().end();
-       it++) {
-    if (it.value()->isSelected() &&
-        ((!it.key()->isLocked()) || mIncludeLockedItems)) {
-      mResultPlanes.insert(it.key());
+  foreach (BGI_Plane* item, getSelectedItems<BGI_Plane>()) {
+    BI_Plane& plane = item->getPlane();
+    if ((!plane.isLocked()) || mIncludeLockedItems) {
+      mResultPlanes.insert(&plane);
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedZones() noexcept {
-  for (auto it = mScene.getZones().begin(); it != mScene.getZones().end();
-       it++) {
-    if (it.value()->isSelected() &&
-        ((!it.key()->getData().isLocked()) || mIncludeLockedItems)) {
-      mResultZones.insert(it.key());
+  foreach (BGI_Zone* item, getSelectedItems<BGI_Zone>()) {
+    BI_Zone& zone = item->getZone();
+    if ((!zone.getData().isLocked()) || mIncludeLockedItems) {
+      mResultZones.insert(&zone);
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedPolygons() noexcept {
-  for (auto it = mScene.getPolygons().begin(); it != mScene.getPolygons().end();
-       it++) {
-    if (it.value()->isSelected() &&
-        ((!it.key()->getData().isLocked()) || mIncludeLockedItems)) {
-      mResultPolygons.insert(it.key());
+  foreach (BGI_Polygon* item, getSelectedItems<BGI_Polygon>()) {
+    BI_Polygon& polygon = item->getPolygon();
+    if ((!polygon.getData().isLocked()) || mIncludeLockedItems) {
+      mResultPolygons.insert(&polygon);
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedBoardStrokeTexts() noexcept {
-  for (auto it = mScene.getStrokeTexts().begin();
-       it != mScene.getStrokeTexts().end(); it++) {
-    if ((!it.key()->getDevice()) && it.value()->isSelected() &&
-        ((!it.key()->getData().isLocked()) || mIncludeLockedItems)) {
-      mResultStrokeTexts.insert(it.key());
+  foreach (BGI_StrokeText* item, getSelectedItems<BGI_StrokeText>()) {
+    BI_StrokeText& text = item->getStrokeText();
+    if ((!text.getDevice()) &&
+        ((!text.getData().isLocked()) || mIncludeLockedItems)) {
+      mResultStrokeTexts.insert(&text);
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedFootprintStrokeTexts() noexcept {
-  for (auto it = mScene.getStrokeTexts().begin();
-       it != mScene.getStrokeTexts().end(); it++) {
-    if (it.key()->getDevice() && it.value()->isSelected() &&
-        ((!it.key()->getData().isLocked()) || mIncludeLockedItems)) {
-      mResultStrokeTexts.insert(it.key());
+  foreach (BGI_StrokeText* item, getSelectedItems<BGI_StrokeText>()) {
+    BI_StrokeText& text = item->getStrokeText();
+    if (text.getDevice() &&
+        ((!text.getData().isLocked()) || mIncludeLockedItems)) {
+      mResultStrokeTexts.insert(&text);
     }
   }
 }
 
 void BoardSelectionQuery::addSelectedHoles() noexcept {
-  for (auto it = mScene.getHoles().begin(); it != mScene.getHoles().end();
-       it++) {
-    if (it.value()->isSelected() &&
-        ((!it.key()->getData().isLocked()) || mIncludeLockedItems)) {
-      mResultHoles.insert(it.key());
+  foreach (BGI_Hole* item, getSelectedItems<BGI_Hole>()) {
+    BI_Hole& hole = item->getHole();
+    if ((!hole.getData().isLocked()) || mIncludeLockedItems) {
+      mResultHoles.insert(&hole);
     }
   }
 }
@@ -212,6 +199,21 @@ void BoardSelectionQuery::addNetPointsOfNetLines(
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+template <typename T>
+QList<T*> BoardSelectionQuery::getSelectedItems() const noexcept {
+  QList<T*> items;
+  foreach (QGraphicsItem* item, mScene.selectedItems()) {
+    if (T* obj = dynamic_cast<T*>(item)) {
+      items.append(obj);
+    }
+  }
+  return items;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
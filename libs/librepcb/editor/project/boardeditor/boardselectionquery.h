@@ -132,6 +132,18 @@ public:
   // Operator Overloadings
   BoardSelectionQuery& operator=(const BoardSelectionQuery& rhs) = delete;
 
+private:  // Methods
+  /**
+   * @brief Get all selected graphics items of a specific type
+   *
+   * Much faster than checking the selection state of every item in the
+   * scene, since the scene keeps track of the selected items anyway.
+   *
+   * @return Selected items of type T
+   */
+  template <typename T>
+  QList<T*> getSelectedItems() const noexcept;
+
 private:  // Data
   BoardGraphicsScene& mScene;
   const bool mIncludeLockedItems;
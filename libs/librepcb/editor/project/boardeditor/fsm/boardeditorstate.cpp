@@ -177,6 +177,15 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   const QPainterPath posAreaLarge =
       mContext.editorGraphicsView.calcPosWithTolerance(pos, 1.5);
 
+  // To avoid calculating the exact grab area and the nearest point of every
+  // single item in the scene, skip all items whose bounding rect (maintained
+  // by the graphics scene anyway) is not close to the cursor.
+  const QRectF searchArea = posAreaLarge.boundingRect();
+  auto isNearPos = [&searchArea, &posOnGrid](const QGraphicsItem& item) {
+    const QRectF rect = item.sceneBoundingRect();
+    return rect.intersects(searchArea) || rect.contains(posOnGrid);
+  };
+
   // Note: The order of adding the items is very important (the top most item
   // must appear as the first item in the list)! For that, we work with
   // priorities (0 = highest priority):
@@ -290,6 +299,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Holes)) {
     for (auto it = scene->getHoles().begin(); it != scene->getHoles().end();
          it++) {
+      if (!isNearPos(*it.value())) continue;
       processItem(it.value(),
                   it.key()->getData().getPath()->getVertices().first().getPos(),
                   5, false);
@@ -299,6 +309,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Vias)) {
     for (auto it = scene->getVias().begin(); it != scene->getVias().end();
          it++) {
+      if (!isNearPos(*it.value())) continue;
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
         if ((!cuLayer) || (it.key()->getVia().isOnLayer(*cuLayer))) {
@@ -311,6 +322,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::NetPoints)) {
     for (auto it = scene->getNetPoints().begin();
          it != scene->getNetPoints().end(); it++) {
+      if (!isNearPos(*it.value())) continue;
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
         const Layer* layer = it.key()->getLayerOfTraces();
@@ -325,6 +337,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::NetLines)) {
     for (auto it = scene->getNetLines().begin();
          it != scene->getNetLines().end(); it++) {
+      if (!isNearPos(*it.value())) continue;
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getNetSegment().getNetSignal())) {
         const Layer& layer = it.key()->getLayer();
@@ -343,6 +356,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Planes)) {
     for (auto it = scene->getPlanes().begin(); it != scene->getPlanes().end();
          it++) {
+      if (!isNearPos(*it.value())) continue;
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getNetSignal())) {
         if ((!cuLayer) || (*cuLayer == it.key()->getLayer())) {
@@ -359,6 +373,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Zones)) {
     for (auto it = scene->getZones().begin(); it != scene->getZones().end();
          it++) {
+      if (!isNearPos(*it.value())) continue;
       if ((!cuLayer) || (it.key()->getData().getLayers().contains(&*cuLayer))) {
         QList<const Layer*> layers = it.key()->getData().getLayers().toList();
         std::sort(layers.begin(), layers.end(), &Layer::lessThan);
@@ -379,6 +394,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Devices)) {
     for (auto it = scene->getDevices().begin(); it != scene->getDevices().end();
          it++) {
+      if (!isNearPos(*it.value())) continue;
       processItem(it.value(), it.key()->getPosition(),
                   40 + (it.key()->getMirrored() ? 300 : 100), false);
     }
@@ -387,6 +403,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::FootprintPads)) {
     for (auto it = scene->getFootprintPads().begin();
          it != scene->getFootprintPads().end(); it++) {
+      if (!isNearPos(*it.value())) continue;
       if (netsignals.isEmpty() ||
           netsignals.contains(it.key()->getCompSigInstNetSignal())) {
         if ((!cuLayer) || (it.key()->isOnLayer(*cuLayer))) {
@@ -404,6 +421,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::Polygons)) {
     for (auto it = scene->getPolygons().begin();
          it != scene->getPolygons().end(); it++) {
+      if (!isNearPos(*it.value())) continue;
       processItem(
           it.value(),
           it.key()->getData().getPath().calcNearestPointBetweenVertices(pos),
@@ -415,6 +433,7 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   if (flags.testFlag(FindFlag::StrokeTexts)) {
     for (auto it = scene->getStrokeTexts().begin();
          it != scene->getStrokeTexts().end(); it++) {
+      if (!isNearPos(*it.value())) continue;
       processItem(it.value(), it.key()->getData().getPosition(),
                   60 + priorityFromLayer(it.key()->getData().getLayer()),
                   false);
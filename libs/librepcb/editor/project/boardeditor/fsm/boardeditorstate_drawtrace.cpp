@@ -44,6 +44,7 @@
 
 #include <librepcb/core/library/pkg/footprintpad.h>
 #include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/drc/boardclearancechecker.h>
 #include <librepcb/core/project/board/items/bi_footprintpad.h>
 #include <librepcb/core/project/board/items/bi_netline.h>
 #include <librepcb/core/project/board/items/bi_netpoint.h>
@@ -52,6 +53,8 @@
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/types/layer.h>
 #include <librepcb/core/utils/toolbox.h>
+#include <librepcb/core/workspace/workspace.h>
+#include <librepcb/core/workspace/workspacesettings.h>
 
 #include <QtCore>
 
@@ -92,10 +95,13 @@ BoardEditorState_DrawTrace::BoardEditorState_DrawTrace(
     mPositioningNetLine1(nullptr),
     mPositioningNetPoint1(nullptr),
     mPositioningNetLine2(nullptr),
-    mPositioningNetPoint2(nullptr) {
+    mPositioningNetPoint2(nullptr),
+    mClearanceChecker(),
+    mClearanceViolationGraphicsItem() {
 }
 
 BoardEditorState_DrawTrace::~BoardEditorState_DrawTrace() noexcept {
+  clearClearanceViolations();
 }
 
 /*******************************************************************************
@@ -522,10 +528,16 @@ bool BoardEditorState_DrawTrace::startPositioning(
     Q_ASSERT(mPositioningNetLine2);
     mContext.undoStack.appendToCmdGroup(cmd.take());  // can throw
 
+    // Prepare the online clearance check. Other nets are not modified while
+    // drawing the trace, so the obstacles need to be determined only once.
+    mClearanceChecker.reset(new BoardClearanceChecker(
+        board,
+        board.getDrcSettings().getMinCopperCopperClearance()));  // can throw
+
     mSubState = SubState_PositioningNetPoint;
 
     // properly place the new netpoints/netlines according the current wire mode
-    updateNetpointPositions();
+    updateNetpointPositions(true);
 
     // Highlight all elements of the current netsignal.
     mContext.projectEditor.setHighlightedNetSignals(
@@ -731,6 +743,8 @@ bool BoardEditorState_DrawTrace::addNextNetPoint(
 bool BoardEditorState_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept {
   try {
     mContext.projectEditor.clearHighlightedNetSignals();
+    clearClearanceViolations();
+    mClearanceChecker.reset();
     mFixedStartAnchor = nullptr;
     mCurrentNetSegment = nullptr;
     mPositioningNetLine1 = nullptr;
@@ -754,7 +768,8 @@ bool BoardEditorState_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept {
   }
 }
 
-void BoardEditorState_DrawTrace::updateNetpointPositions() noexcept {
+void BoardEditorState_DrawTrace::updateNetpointPositions(
+    bool force) noexcept {
   BoardGraphicsScene* scene = getActiveBoardScene();
   if ((!scene) || (mSubState != SubState_PositioningNetPoint)) {
     return;
@@ -795,8 +810,33 @@ void BoardEditorState_DrawTrace::updateNetpointPositions() noexcept {
     }
   }
 
-  mPositioningNetPoint1->setPosition(calcMiddlePointPos(
-      mFixedStartAnchor->getPosition(), mTargetPos, mCurrentWireMode));
+  // Most mouse moves do not change the snapped geometry of the trace (e.g.
+  // when moving within the same grid cell). Then the airwires and clearance
+  // violations are still up to date and don't need to be determined again.
+  const Point middlePos = calcMiddlePointPos(mFixedStartAnchor->getPosition(),
+                                             mTargetPos, mCurrentWireMode);
+  const bool viaVisible = mAddVia ? (!isOnVia) : (mTempVia != nullptr);
+  const bool modified = force ||
+      (mPositioningNetPoint1->getPosition() != middlePos) ||
+      (mPositioningNetPoint2 &&
+       (mPositioningNetPoint2->getPosition() != mTargetPos)) ||
+      (viaVisible != (mTempVia != nullptr)) ||
+      (mTempVia &&
+       ((mTempVia->getPosition() != mTargetPos) ||
+        (mTempVia->getSize() != mCurrentViaProperties.getSize()) ||
+        (mTempVia->getDrillDiameter() !=
+         mCurrentViaProperties.getDrillDiameter()) ||
+        (&mTempVia->getVia().getStartLayer() !=
+         &mCurrentViaProperties.getStartLayer()) ||
+        (&mTempVia->getVia().getEndLayer() !=
+         &mCurrentViaProperties.getEndLayer()))) ||
+      (mPositioningNetLine1->getWidth() != mCurrentWidth) ||
+      (mPositioningNetLine2->getWidth() != mCurrentWidth);
+  if (!modified) {
+    return;
+  }
+
+  mPositioningNetPoint1->setPosition(middlePos);
   if (mPositioningNetPoint2) {
     mPositioningNetPoint2->setPosition(mTargetPos);
   }
@@ -811,6 +851,8 @@ void BoardEditorState_DrawTrace::updateNetpointPositions() noexcept {
   // Force updating airwires immediately as they are important for creating
   // traces.
   scene->getBoard().triggerAirWiresRebuild();
+
+  updateClearanceViolations();
 }
 
 void BoardEditorState_DrawTrace::showVia(bool isVisible) noexcept {
@@ -850,12 +892,68 @@ void BoardEditorState_DrawTrace::showVia(bool isVisible) noexcept {
       mTempVia->setPosition(mTargetPos);
       mTempVia->setSize(mCurrentViaProperties.getSize());
       mTempVia->setDrillDiameter(mCurrentViaProperties.getDrillDiameter());
+      mTempVia->setLayers(mCurrentViaProperties.getStartLayer(),
+                          mCurrentViaProperties.getEndLayer());  // can throw
     }
   } catch (const Exception& e) {
     QMessageBox::critical(parentWidget(), tr("Error"), e.getMsg());
   }
 }
 
+void BoardEditorState_DrawTrace::updateClearanceViolations() noexcept {
+  BoardGraphicsScene* scene = getActiveBoardScene();
+  if ((!scene) || (!mClearanceChecker)) {
+    return;
+  }
+
+  try {
+    QVector<Path> locations;
+    const QVector<const BI_NetLine*> netLines = {mPositioningNetLine1,
+                                                 mPositioningNetLine2};
+    foreach (const BI_NetLine* netLine, netLines) {
+      if (netLine) {
+        locations += mClearanceChecker->checkNetLine(*netLine);  // can throw
+      }
+    }
+    if (mTempVia) {
+      locations += mClearanceChecker->checkVia(*mTempVia);  // can throw
+    }
+
+    if (locations.isEmpty()) {
+      clearClearanceViolations();
+    } else {
+      if (!mClearanceViolationGraphicsItem) {
+        const ThemeColor& color =
+            mContext.workspace.getSettings().themes.getActive().getColor(
+                Theme::Color::sBoardOverlays);
+        mClearanceViolationGraphicsItem.reset(new QGraphicsPathItem());
+        mClearanceViolationGraphicsItem->setZValue(
+            BoardGraphicsScene::ZValue_AirWires);
+        mClearanceViolationGraphicsItem->setPen(
+            QPen(color.getPrimaryColor(), 0));
+        mClearanceViolationGraphicsItem->setBrush(color.getSecondaryColor());
+        scene->addItem(*mClearanceViolationGraphicsItem);
+      }
+      mClearanceViolationGraphicsItem->setPath(
+          Path::toQPainterPathPx(locations, true));
+    }
+  } catch (const Exception& e) {
+    qWarning() << "Failed to check clearances:" << e.getMsg();
+    clearClearanceViolations();
+  }
+}
+
+void BoardEditorState_DrawTrace::clearClearanceViolations() noexcept {
+  // Remove the item from the scene before deleting it, the scene must not
+  // keep any reference to it.
+  if (mClearanceViolationGraphicsItem) {
+    if (QGraphicsScene* scene = mClearanceViolationGraphicsItem->scene()) {
+      scene->removeItem(mClearanceViolationGraphicsItem.data());
+    }
+    mClearanceViolationGraphicsItem.reset();
+  }
+}
+
 BI_NetLineAnchor* BoardEditorState_DrawTrace::combineAnchors(
     BI_NetLineAnchor& a, BI_NetLineAnchor& b) {
   BI_NetPoint* removePoint = nullptr;
@@ -921,11 +1019,13 @@ void BoardEditorState_DrawTrace::layerChanged(const Layer& layer) noexcept {
       mAddVia = true;
       showVia(true);
       mViaLayer = layer;
+      updateNetpointPositions(true);
     }
   } else {
     mAddVia = false;
     showVia(false);
     mCurrentLayer = &layer;
+    updateNetpointPositions(true);
   }
 }
 
@@ -30,6 +30,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -41,6 +43,7 @@ class BI_NetLineAnchor;
 class BI_NetPoint;
 class BI_NetSegment;
 class BI_Via;
+class BoardClearanceChecker;
 class Layer;
 class NetSignal;
 
@@ -150,8 +153,14 @@ private:
    * to and how its BI_NetLine are palced. Also determines whether a BI_Via
    * should be added or if the target anchor can provide the desired layer
    * change.
+   *
+   * If the resulting geometry of the trace did not change since the last
+   * call, nothing is done (e.g. no airwire rebuild and clearance check).
+   *
+   * @param force   Update the airwires and clearance violations even if
+   *                the geometry did not change.
    */
-  void updateNetpointPositions() noexcept;
+  void updateNetpointPositions(bool force = false) noexcept;
 
   /**
    * @brief Sets the BI_Via of the currently active trace.
@@ -168,6 +177,19 @@ private:
    */
   void showVia(bool isVisible) noexcept;
 
+  /**
+   * @brief Highlight clearance violations of the currently active trace
+   *
+   * Uses #mClearanceChecker to check the positioning net lines and the via
+   * (if any) against the copper of other nets.
+   */
+  void updateClearanceViolations() noexcept;
+
+  /**
+   * @brief Remove the highlighted clearance violations from the scene
+   */
+  void clearClearanceViolations() noexcept;
+
   BI_NetLineAnchor* combineAnchors(BI_NetLineAnchor& a, BI_NetLineAnchor& b);
 
   // Callback Functions for the Gui elements
@@ -214,6 +236,10 @@ private:
   BI_NetLine* mPositioningNetLine2;  ///< line between p1 and p2
   BI_NetPoint* mPositioningNetPoint2;  ///< the second netpoint to place
 
+  /// Online clearance check of the active trace, created for each segment
+  std::unique_ptr<BoardClearanceChecker> mClearanceChecker;
+  QScopedPointer<QGraphicsPathItem> mClearanceViolationGraphicsItem;
+
   // Widgets for the command toolbar
   QPointer<LayerComboBox> mLayerComboBox;
   QPointer<PositiveLengthEdit> mSizeEdit;
@@ -63,7 +63,6 @@
 #include "../graphicsitems/bgi_via.h"
 #include "../graphicsitems/bgi_zone.h"
 
-#include <librepcb/core/import/dxfreader.h>
 #include <librepcb/core/library/cmp/component.h>
 #include <librepcb/core/library/dev/device.h>
 #include <librepcb/core/library/pkg/package.h>
@@ -83,7 +82,6 @@
 #include <librepcb/core/project/circuit/componentinstance.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/utils/scopeguard.h>
-#include <librepcb/core/utils/tangentpathjoiner.h>
 #include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
@@ -97,6 +95,9 @@
 namespace librepcb {
 namespace editor {
 
+/// Minimum interval [ms] between updates of dragged items (~60 FPS)
+static const int sDragUpdateIntervalMs = 16;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -113,7 +114,14 @@ BoardEditorState_Select::BoardEditorState_Select(
     mCmdPlaneEdit(),
     mSelectedZone(nullptr),
     mSelectedZoneVertices(),
-    mCmdZoneEdit() {
+    mCmdZoneEdit(),
+    mDragTimer() {
+  // Moving many items is expensive, thus mouse move events are coalesced
+  // while dragging to update the items only once per frame.
+  mDragTimer.setSingleShot(true);
+  mDragTimer.setInterval(sDragUpdateIntervalMs);
+  connect(&mDragTimer, &QTimer::timeout, this,
+          &BoardEditorState_Select::applyPendingDragPosition);
 }
 
 BoardEditorState_Select::~BoardEditorState_Select() noexcept {
@@ -172,27 +180,19 @@ bool BoardEditorState_Select::processImportDxf() noexcept {
       auto cursorScopeGuard =
           scopeGuard([this]() { parentWidget()->unsetCursor(); });
 
-      // Read DXF file.
-      DxfReader import;
-      import.setScaleFactor(dialog.getScaleFactor());
-      import.parse(fp);  // can throw
-
-      // If enabled, join tangent paths.
-      QVector<Path> paths = import.getPolygons().toVector();
-      if (dialog.getJoinTangentPolylines()) {
-        paths = TangentPathJoiner::join(paths, 2000);
-      }
+      // Read DXF file and, if enabled, join tangent paths.
+      const DxfImportDialog::Result import = dialog.readFile(fp);  // can throw
 
       // Build board elements to import. ALthough this has nothing to do with
       // the clipboard, we use BoardClipboardData since it works very well :-)
       std::unique_ptr<BoardClipboardData> data(
           new BoardClipboardData(scene->getBoard().getUuid(), Point(0, 0)));
-      foreach (const auto& path, paths) {
+      foreach (const auto& path, import.paths) {
         data->getPolygons().append(
             BoardPolygonData(Uuid::createRandom(), dialog.getLayer(),
                              dialog.getLineWidth(), path, false, false, false));
       }
-      for (const auto& circle : import.getCircles()) {
+      for (const auto& circle : import.circles) {
         if (dialog.getImportCirclesAsDrills()) {
           data->getHoles().append(
               BoardHoleData(Uuid::createRandom(), circle.diameter,
@@ -223,6 +223,9 @@ bool BoardEditorState_Select::processImportDxf() noexcept {
       // Start the paste tool.
       return startPaste(*scene, std::move(data),
                         dialog.getPlacementPosition());  // can throw
+    } catch (const UserCanceled& e) {
+      Q_UNUSED(e);
+      abortCommand(false);
     } catch (const Exception& e) {
       QMessageBox::critical(parentWidget(), tr("Error"), e.getMsg());
       abortCommand(false);
@@ -483,9 +486,13 @@ bool BoardEditorState_Select::processGraphicsSceneMouseMoved(
   if (!scene) return false;
 
   if (mSelectedItemsDragCommand) {
-    // Move selected elements to cursor position
-    Point pos = Point::fromPx(e.scenePos());
-    mSelectedItemsDragCommand->setCurrentPosition(pos);
+    // Move selected elements to cursor position. If the last move was just
+    // now, postpone it to avoid lagging behind the cursor.
+    mPendingDragPosition = Point::fromPx(e.scenePos());
+    if (!mDragTimer.isActive()) {
+      applyPendingDragPosition();
+      mDragTimer.start();
+    }
     return true;
   } else if (mSelectedPolygon && mCmdPolygonEdit) {
     // Move polygon vertices
@@ -1214,6 +1221,7 @@ bool BoardEditorState_Select::startMovingSelectedItems(
   Q_ASSERT(mSelectedItemsDragCommand.isNull());
   mSelectedItemsDragCommand.reset(
       new CmdDragSelectedBoardItems(scene, getIgnoreLocks(), false, startPos));
+  mPendingDragPosition = tl::nullopt;
   return true;
 }
 
@@ -1232,12 +1240,20 @@ bool BoardEditorState_Select::moveSelectedItems(const Point& delta) noexcept {
   }
 }
 
+void BoardEditorState_Select::applyPendingDragPosition() noexcept {
+  if (mSelectedItemsDragCommand && mPendingDragPosition) {
+    mSelectedItemsDragCommand->setCurrentPosition(*mPendingDragPosition);
+  }
+  mPendingDragPosition = tl::nullopt;
+}
+
 bool BoardEditorState_Select::rotateSelectedItems(const Angle& angle) noexcept {
   BoardGraphicsScene* scene = getActiveBoardScene();
   if (!scene) return false;
 
   try {
     if (mSelectedItemsDragCommand) {
+      applyPendingDragPosition();
       mSelectedItemsDragCommand->rotate(angle, true);
     } else {
       QScopedPointer<CmdDragSelectedBoardItems> cmd(
@@ -1594,6 +1610,7 @@ bool BoardEditorState_Select::startPaste(
       // Start moving the selected items.
       mSelectedItemsDragCommand.reset(new CmdDragSelectedBoardItems(
           scene, true, false, startPos));  // can throw
+      mPendingDragPosition = tl::nullopt;
     }
     return true;
   } else {
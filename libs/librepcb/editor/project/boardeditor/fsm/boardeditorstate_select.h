@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include "boardeditorstate.h"
 
+#include <librepcb/core/types/point.h>
 #include <librepcb/core/types/uuid.h>
 
 #include <QtCore>
@@ -48,7 +49,6 @@ class BI_Polygon;
 class BI_StrokeText;
 class BI_Via;
 class BI_Zone;
-class Point;
 
 namespace editor {
 
@@ -121,6 +121,7 @@ private:  // Methods
   bool startMovingSelectedItems(BoardGraphicsScene& scene,
                                 const Point& startPos) noexcept;
   bool moveSelectedItems(const Point& delta) noexcept;
+  void applyPendingDragPosition() noexcept;
   bool rotateSelectedItems(const Angle& angle) noexcept;
   bool flipSelectedItems(Qt::Orientation orientation) noexcept;
   bool snapSelectedItemsToGrid() noexcept;
@@ -195,6 +196,10 @@ private:  // Data
 
   /// When dragging items, this undo command will be active
   QScopedPointer<CmdDragSelectedBoardItems> mSelectedItemsDragCommand;
+  /// Latest cursor position while dragging, not yet applied to the command
+  tl::optional<Point> mPendingDragPosition;
+  /// Timer to apply #mPendingDragPosition at most once per frame
+  QTimer mDragTimer;
 
   /// The current polygon selected for editing (nullptr if none)
   BI_Polygon* mSelectedPolygon;
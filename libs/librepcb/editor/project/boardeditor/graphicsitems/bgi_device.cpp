@@ -57,6 +57,7 @@ BGI_Device::BGI_Device(BI_Device& device,
     mDevice(device),
     mLayerProvider(lp),
     mGrabAreaLayer(nullptr),
+    mRenderData(getRenderData(mDevice.getLibFootprint())),
     mOnEditedSlot(*this, &BGI_Device::deviceEdited),
     mOnLayerEditedSlot(*this, &BGI_Device::layerEdited) {
   setFlag(QGraphicsItem::ItemHasNoContents, true);
@@ -71,25 +72,14 @@ BGI_Device::BGI_Device(BI_Device& device,
     i->setDiameter(positiveToUnsigned(obj.getDiameter()));
     i->setLineWidth(obj.getLineWidth());
     i->setFlag(QGraphicsItem::ItemStacksBehindParent, true);
-    if (obj.isGrabArea()) {
-      const qreal r = (obj.getDiameter() + obj.getLineWidth())->toPx() / 2;
-      QPainterPath path;
-      path.addEllipse(obj.getCenter().toPxQPointF(), r, r);
-      mShape |= path;
-    }
     mCircleGraphicsItems.append(i);
   }
 
   for (auto& obj : mDevice.getLibFootprint().getPolygons()) {
     auto i = std::make_shared<PrimitivePathGraphicsItem>(this);
-    i->setPath(obj.getPathForRendering().toQPainterPathPx());
+    i->setPath(mRenderData->polygonPaths.value(mPolygonGraphicsItems.count()));
     i->setLineWidth(obj.getLineWidth());
     i->setFlag(QGraphicsItem::ItemStacksBehindParent, true);
-    if (obj.isGrabArea()) {
-      mShape |= Toolbox::shapeFromPath(obj.getPath().toQPainterPathPx(),
-                                       QPen(Qt::SolidPattern, 0),
-                                       Qt::SolidPattern, obj.getLineWidth());
-    }
     mPolygonGraphicsItems.append(i);
   }
 
@@ -126,7 +116,7 @@ BGI_Device::~BGI_Device() noexcept {
 QPainterPath BGI_Device::shape() const noexcept {
   QPainterPath p = mOriginCrossGraphicsItem->shape();
   if (mGrabAreaLayer && mGrabAreaLayer->isVisible()) {
-    p |= mShape;
+    p |= mRenderData->grabAreaShape;
   }
   return p;
 }
@@ -135,6 +125,46 @@ QPainterPath BGI_Device::shape() const noexcept {
  *  Private Methods
  ******************************************************************************/
 
+std::shared_ptr<const BGI_Device::RenderData> BGI_Device::getRenderData(
+    const Footprint& footprint) noexcept {
+  // Note: An entry is alive only as long as any device graphics item of the
+  // footprint exists, thus the footprint is still alive too and its address
+  // can be used as key (footprints of the project library are immutable).
+  static QHash<const Footprint*, std::weak_ptr<const RenderData>> cache;
+  if (std::shared_ptr<const RenderData> data = cache.value(&footprint).lock()) {
+    return data;
+  }
+
+  std::shared_ptr<RenderData> data = std::make_shared<RenderData>();
+  for (const Circle& obj : footprint.getCircles()) {
+    if (obj.isGrabArea()) {
+      const qreal r = (obj.getDiameter() + obj.getLineWidth())->toPx() / 2;
+      QPainterPath path;
+      path.addEllipse(obj.getCenter().toPxQPointF(), r, r);
+      data->grabAreaShape |= path;
+    }
+  }
+  for (const Polygon& obj : footprint.getPolygons()) {
+    data->polygonPaths.append(obj.getPathForRendering().toQPainterPathPx());
+    if (obj.isGrabArea()) {
+      data->grabAreaShape |= Toolbox::shapeFromPath(
+          obj.getPath().toQPainterPathPx(), QPen(Qt::SolidPattern, 0),
+          Qt::SolidPattern, obj.getLineWidth());
+    }
+  }
+
+  // Remove entries of footprints not in use anymore.
+  for (auto it = cache.begin(); it != cache.end();) {
+    if (it->expired()) {
+      it = cache.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  cache.insert(&footprint, data);
+  return data;
+}
+
 void BGI_Device::deviceEdited(const BI_Device& obj,
                               BI_Device::Event event) noexcept {
   Q_UNUSED(obj);
@@ -37,6 +37,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class Footprint;
 class Layer;
 
 namespace editor {
@@ -79,7 +80,16 @@ public:
   // Operator Overloadings
   BGI_Device& operator=(const BGI_Device& rhs) = delete;
 
+private:  // Types
+  /// Render data shared by all devices using the same footprint
+  struct RenderData {
+    QVector<QPainterPath> polygonPaths;
+    QPainterPath grabAreaShape;
+  };
+
 private:  // Methods
+  static std::shared_ptr<const RenderData> getRenderData(
+      const Footprint& footprint) noexcept;
   void deviceEdited(const BI_Device& obj, BI_Device::Event event) noexcept;
   void layerEdited(const GraphicsLayer& layer,
                    GraphicsLayer::Event event) noexcept;
@@ -96,12 +106,12 @@ private:  // Data
   BI_Device& mDevice;
   const IF_GraphicsLayerProvider& mLayerProvider;
   std::shared_ptr<GraphicsLayer> mGrabAreaLayer;
+  std::shared_ptr<const RenderData> mRenderData;
   std::shared_ptr<OriginCrossGraphicsItem> mOriginCrossGraphicsItem;
   QVector<std::shared_ptr<PrimitiveCircleGraphicsItem>> mCircleGraphicsItems;
   QVector<std::shared_ptr<PrimitivePathGraphicsItem>> mPolygonGraphicsItems;
   QVector<std::shared_ptr<PrimitiveZoneGraphicsItem>> mZoneGraphicsItems;
   QVector<std::shared_ptr<PrimitiveHoleGraphicsItem>> mHoleGraphicsItems;
-  QPainterPath mShape;
 
   // Slots
   BI_Device::OnEditedSlot mOnEditedSlot;
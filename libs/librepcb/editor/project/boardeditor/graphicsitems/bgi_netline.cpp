@@ -38,6 +38,9 @@
 namespace librepcb {
 namespace editor {
 
+/// On-screen line width [px] below which the line is drawn as a hairline
+static const qreal sMinDetailWidthPx = 1.5;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -85,9 +88,16 @@ void BGI_NetLine::paint(QPainter* painter,
 
   // draw line
   if (mLayer->isVisible()) {
-    QPen pen(mLayer->getColor(highlight), mNetLine.getWidth()->toPx(),
-             Qt::SolidLine, Qt::RoundCap);
-    painter->setPen(pen);
+    const qreal lod =
+        option->levelOfDetailFromTransform(painter->worldTransform());
+    const qreal widthPx = mNetLine.getWidth()->toPx();
+    if ((widthPx * lod) < sMinDetailWidthPx) {
+      // Draw a cosmetic line without caps, which is much faster.
+      painter->setPen(QPen(mLayer->getColor(highlight), 0));
+    } else {
+      painter->setPen(QPen(mLayer->getColor(highlight), widthPx,
+                           Qt::SolidLine, Qt::RoundCap));
+    }
     painter->drawLine(mLineF);
   }
 }
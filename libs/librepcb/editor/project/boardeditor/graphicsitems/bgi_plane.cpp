@@ -59,6 +59,11 @@ BGI_Plane::BGI_Plane(BI_Plane& plane, const IF_GraphicsLayerProvider& lp,
     mOnLayerEditedSlot(*this, &BGI_Plane::layerEdited) {
   setFlag(QGraphicsItem::ItemIsSelectable, true);
 
+  // Planes are expensive to draw but rarely modified, so cache the rendered
+  // pixmap to avoid repainting them on every panning step. Note that the
+  // cache is automatically invalidated on zoom changes and on update().
+  setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
   updateOutlineAndFragments();
   updateLayer();
   updateVisibility();
@@ -119,6 +124,11 @@ QVector<int> BGI_Plane::getVertexIndicesAtPosition(
 QVariant BGI_Plane::itemChange(GraphicsItemChange change,
                                const QVariant& value) noexcept {
   if (change == ItemSelectedHasChanged) {
+    // While selected, the plane might be modified interactively (e.g. by
+    // dragging vertices), so draw it live instead of re-rendering the cache
+    // on every change.
+    setCacheMode(value.toBool() ? QGraphicsItem::NoCache
+                                : QGraphicsItem::DeviceCoordinateCache);
     updateBoundingRectMargin();
   }
   return QGraphicsItem::itemChange(change, value);
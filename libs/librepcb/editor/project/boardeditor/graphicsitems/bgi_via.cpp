@@ -46,6 +46,9 @@
 namespace librepcb {
 namespace editor {
 
+/// On-screen via size [px] below which the via is drawn simplified
+static const qreal sMinDetailSizePx = 3;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -107,6 +110,17 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
   const NetSignal* netsignal = mVia.getNetSegment().getNetSignal();
   const bool highlight = option->state.testFlag(QStyle::State_Selected) ||
       mHighlightedNetSignals->contains(netsignal);
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  if ((mVia.getSize()->toPx() * lod) < sMinDetailSizePx) {
+    // Too small to see any details, so only draw the via as a plain square.
+    if (mViaLayer && mViaLayer->isVisible()) {
+      const qreal radius = mVia.getSize()->toPx() / 2;
+      painter->fillRect(QRectF(-radius, -radius, radius * 2, radius * 2),
+                        mViaLayer->getColor(highlight));
+    }
+    return;
+  }
 
   if (mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible() &&
       (!mStopMaskBottom.isEmpty())) {
@@ -104,10 +104,16 @@ UnplacedComponentsDock::UnplacedComponentsDock(ProjectEditor& editor,
           .toByteArray());
 
   // Update components list each time a component gets added or removed.
-  connect(&mProject.getCircuit(), &Circuit::componentAdded, this,
+  // Since commands like pasting may add thousands of components at once, the
+  // update is deferred to rebuild the list only once.
+  mListUpdateTimer.setSingleShot(true);
+  mListUpdateTimer.setInterval(0);
+  connect(&mListUpdateTimer, &QTimer::timeout, this,
           &UnplacedComponentsDock::updateComponentsList);
+  connect(&mProject.getCircuit(), &Circuit::componentAdded, this,
+          &UnplacedComponentsDock::scheduleComponentsListUpdate);
   connect(&mProject.getCircuit(), &Circuit::componentRemoved, this,
-          &UnplacedComponentsDock::updateComponentsList);
+          &UnplacedComponentsDock::scheduleComponentsListUpdate);
   updateComponentsList();
 
   // Connect UI events to methods.
@@ -155,9 +161,9 @@ int UnplacedComponentsDock::getUnplacedComponentsCount() const noexcept {
 void UnplacedComponentsDock::setBoard(Board* board) {
   if (mBoard) {
     disconnect(mBoard, &Board::deviceAdded, this,
-               &UnplacedComponentsDock::updateComponentsList);
+               &UnplacedComponentsDock::scheduleComponentsListUpdate);
     disconnect(mBoard, &Board::deviceRemoved, this,
-               &UnplacedComponentsDock::updateComponentsList);
+               &UnplacedComponentsDock::scheduleComponentsListUpdate);
     mBoard = nullptr;
     updateComponentsList();
   }
@@ -165,9 +171,9 @@ void UnplacedComponentsDock::setBoard(Board* board) {
   if (board) {
     mBoard = board;
     connect(mBoard, &Board::deviceAdded, this,
-            &UnplacedComponentsDock::updateComponentsList);
+            &UnplacedComponentsDock::scheduleComponentsListUpdate);
     connect(mBoard, &Board::deviceRemoved, this,
-            &UnplacedComponentsDock::updateComponentsList);
+            &UnplacedComponentsDock::scheduleComponentsListUpdate);
     mNextPosition =
         Point::fromMm(0, -20).mappedToGrid(mBoard->getGridInterval());
     updateComponentsList();
@@ -178,8 +184,13 @@ void UnplacedComponentsDock::setBoard(Board* board) {
  *  Private Methods
  ******************************************************************************/
 
+void UnplacedComponentsDock::scheduleComponentsListUpdate() noexcept {
+  mListUpdateTimer.start();
+}
+
 void UnplacedComponentsDock::updateComponentsList() noexcept {
   if (mDisableListUpdate) return;
+  mListUpdateTimer.stop();  // Discard pending update.
 
   int selectedIndex = mUi->lstUnplacedComponents->currentRow();
   setSelectedComponentInstance(nullptr);
@@ -205,7 +216,7 @@ void UnplacedComponentsDock::updateComponentsList() noexcept {
 
       // Add component to list.
       ProjectAttributeLookup lookup(*component, nullptr,
-                                    component->getParts(tl::nullopt).value(0));
+                                    component->getPart(tl::nullopt));
       const QString value =
           AttributeSubstitutor::substitute(lookup("VALUE"), lookup)
               .split("\n", QString::SkipEmptyParts)
@@ -103,6 +103,7 @@ signals:
                           Uuid footprintUuid);
 
 private:  // Methods
+  void scheduleComponentsListUpdate() noexcept;
   void updateComponentsList() noexcept;
   void currentComponentListItemChanged(QListWidgetItem* current,
                                        QListWidgetItem* previous) noexcept;
@@ -140,6 +141,7 @@ private:  // Data
 
   // State
   bool mDisableListUpdate;
+  QTimer mListUpdateTimer;  ///< Coalesces updates of many added components
   Point mNextPosition;
   QHash<Uuid, Uuid> mLastDeviceOfComponent;
   QHash<Uuid, Uuid> mLastFootprintOfPackage;
@@ -31,6 +31,7 @@
 #include <librepcb/core/export/bom.h>
 #include <librepcb/core/export/bomcsvwriter.h>
 #include <librepcb/core/fileio/csvfile.h>
+#include <librepcb/core/fileio/csvwriter.h>
 #include <librepcb/core/library/dev/device.h>
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/board/items/bi_device.h>
@@ -169,8 +170,9 @@ void BomGeneratorDialog::btnOpenOutputDirectoryClicked() noexcept {
 void BomGeneratorDialog::btnGenerateClicked() noexcept {
   try {
     BomCsvWriter writer(*mBom);
-    std::shared_ptr<CsvFile> csv = writer.generateCsv();  // can throw
-    csv->saveToFile(getOutputFilePath());  // can throw
+    CsvWriter csv;
+    writer.writeCsv(csv);
+    csv.saveToFile(getOutputFilePath());  // can throw
 
     QString btnSuccessText = tr("Success!");
     QString btnGenerateText = mBtnGenerate->text();
@@ -42,9 +42,10 @@ namespace editor {
  *  Constructors / Destructor
  ******************************************************************************/
 
-OrderPcbDialog::OrderPcbDialog(const WorkspaceSettings& settings,
-                               std::function<QByteArray()> createLppzCallback,
-                               QWidget* parent) noexcept
+OrderPcbDialog::OrderPcbDialog(
+    const WorkspaceSettings& settings,
+    std::function<QByteArray(bool)> createLppzCallback,
+    QWidget* parent) noexcept
   : QDialog(parent),
     mSettings(settings),
     mRequest(),
@@ -52,6 +53,7 @@ OrderPcbDialog::OrderPcbDialog(const WorkspaceSettings& settings,
     mUi(new Ui::OrderPcbDialog) {
   mUi->setupUi(this);
   mUi->lblMoreInformation->hide();
+  mUi->cbxInclude3dModels->hide();
   mUi->cbxOpenBrowser->hide();
   mUi->btnUpload->hide();
   mUi->imgError->hide();
@@ -86,6 +88,9 @@ OrderPcbDialog::OrderPcbDialog(const WorkspaceSettings& settings,
   if (size.isValid()) {
     resize(size);
   }
+  mUi->cbxInclude3dModels->setChecked(
+      clientSettings.value("order_pcb_dialog/include_3d_models", true)
+          .toBool());
   mUi->cbxOpenBrowser->setChecked(
       clientSettings.value("order_pcb_dialog/auto_open_browser", true)
           .toBool());
@@ -112,6 +117,8 @@ OrderPcbDialog::~OrderPcbDialog() noexcept {
   clientSettings.setValue("order_pcb_dialog/window_size", size());
   clientSettings.setValue("order_pcb_dialog/auto_open_browser",
                           mUi->cbxOpenBrowser->isChecked());
+  clientSettings.setValue("order_pcb_dialog/include_3d_models",
+                          mUi->cbxInclude3dModels->isChecked());
 }
 
 /*******************************************************************************
@@ -135,6 +142,7 @@ void OrderPcbDialog::infoRequestSucceeded(QUrl infoUrl,
   }
 
   // Enable UI elements required to start the upload.
+  mUi->cbxInclude3dModels->show();
   mUi->cbxOpenBrowser->show();
   mUi->btnUpload->show();
 }
@@ -149,6 +157,7 @@ void OrderPcbDialog::infoRequestFailed(QString errorMsg) noexcept {
 void OrderPcbDialog::uploadButtonClicked() noexcept {
   // Lock UI during work.
   mUi->btnUpload->hide();
+  mUi->cbxInclude3dModels->setEnabled(false);
   mUi->progressBar->setMaximum(100);
   mUi->progressBar->setValue(0);
   mUi->progressBar->show();
@@ -167,7 +176,8 @@ void OrderPcbDialog::startUpload() noexcept {
 
     // Generate *.lppz.
     qDebug() << "Export project to *.lppz for ordering PCBs...";
-    QByteArray lppz = mCreateLppzCallback();  // can throw
+    QByteArray lppz =
+        mCreateLppzCallback(mUi->cbxInclude3dModels->isChecked());  // can throw
     mUi->progressBar->setValue(10);
 
     // Start uploading project.
@@ -221,6 +231,7 @@ void OrderPcbDialog::uploadFailed(const QString& errorMsg) noexcept {
 
   mUi->progressBar->hide();
   mUi->btnUpload->show();
+  mUi->cbxInclude3dModels->setEnabled(true);
   setError(errorMsg);
 }
 
@@ -57,7 +57,7 @@ public:
   OrderPcbDialog() = delete;
   OrderPcbDialog(const OrderPcbDialog& other) = delete;
   explicit OrderPcbDialog(const WorkspaceSettings& settings,
-                          std::function<QByteArray()> createLppzCallback,
+                          std::function<QByteArray(bool)> createLppzCallback,
                           QWidget* parent = nullptr) noexcept;
   ~OrderPcbDialog() noexcept;
 
@@ -78,7 +78,7 @@ private:  // Methods
 private:  // Data
   const WorkspaceSettings& mSettings;
   QScopedPointer<OrderPcbApiRequest> mRequest;
-  std::function<QByteArray()> mCreateLppzCallback;
+  std::function<QByteArray(bool)> mCreateLppzCallback;  ///< Arg: 3D models
   QScopedPointer<Ui::OrderPcbDialog> mUi;
 };
 
@@ -29,13 +29,18 @@
 #include "schematiceditor/schematiceditor.h"
 
 #include <librepcb/core/application.h>
+#include <librepcb/core/export/graphicsexport.h>
+#include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/boardpainter.h>
 #include <librepcb/core/project/erc/electricalrulecheck.h>
 #include <librepcb/core/project/project.h>
+#include <librepcb/core/project/schematic/schematicpainter.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 
 #include <QtCore>
+#include <QtGui>
 
 /*******************************************************************************
  *  Namespace
@@ -53,12 +58,14 @@ ProjectEditor::ProjectEditor(
   : QObject(nullptr),
     mWorkspace(workspace),
     mProject(project),
+    mErc(new ElectricalRuleCheck(project)),
     mHighlightedNetSignals(new QSet<const NetSignal*>()),
     mUndoStack(nullptr),
     mSchematicEditor(nullptr),
     mBoardEditor(nullptr),
     mLastAutosaveStateId(0),
-    mManualModificationsMade(false) {
+    mManualModificationsMade(false),
+    mThumbnailOutdated(false) {
   try {
     if (upgradeMessages) {
       mUpgradeMessages = *upgradeMessages;
@@ -78,7 +85,16 @@ ProjectEditor::ProjectEditor(
     }
 
     mUndoStack = new UndoStack();
+    mUndoStack->setUndoLimit(mWorkspace.getSettings().undoLimit.get());
+    connect(&mWorkspace.getSettings().undoLimit,
+            &WorkspaceSettingsItem::edited, mUndoStack, [this]() {
+              mUndoStack->setUndoLimit(
+                  mWorkspace.getSettings().undoLimit.get());
+            });
     mLastAutosaveStateId = mUndoStack->getUniqueStateId();
+    mThumbnailOutdated =
+        !mWorkspace.getProjectThumbnailFilePath(mProject.getPath())
+             .isExistingFile();
 
     // create the whole schematic/board editor GUI inclusive FSM and so on
     mSchematicEditor = new SchematicEditor(*this, mProject);
@@ -95,6 +111,7 @@ ProjectEditor::ProjectEditor(
   }
 
   // Run the ERC after opening and after every modification.
+  mErc->enableIncrementalChecks();
   QTimer::singleShot(200, this, &ProjectEditor::runErc);
   connect(mUndoStack, &UndoStack::stateModified, this, &ProjectEditor::runErc);
 
@@ -118,6 +135,14 @@ ProjectEditor::~ProjectEditor() noexcept {
   mBoardEditor->abortAllCommands();
   Q_ASSERT(!mUndoStack->isCommandGroupActive());
 
+  // Rendering the thumbnail is expensive, so it is done only once when closing
+  // the project, and only if the content on the disk has changed. Unsaved
+  // modifications would not match the content on the disk, so skip it then.
+  if (mThumbnailOutdated && mUndoStack->isClean() &&
+      (!mManualModificationsMade)) {
+    saveThumbnail();
+  }
+
   // delete all command objects in the undo stack (must be done before other
   // important objects are deleted, as undo command objects can hold
   // pointers/references to them!)
@@ -303,14 +328,20 @@ void ProjectEditor::execLppzExportDialog(QWidget* parent) noexcept {
 }
 
 void ProjectEditor::execOrderPcbDialog(QWidget* parent) noexcept {
-  auto callback = [this]() {
+  auto callback = [this](bool include3dModels) {
     if (Application::isFileFormatStable()) {
       // See explanation in execLppzExportDialog().
       mProject.save();  // can throw
     }
     // Export project to ZIP, but without the output directory since this can
     // be quite large and does not make sense to upload to the API server.
-    auto filter = [](const QString& filePath) {
+    // Optionally leave out the 3D models too, they are not needed to
+    // manufacture the PCB but often make up most of the project size.
+    auto filter = [include3dModels](const QString& filePath) {
+      if ((!include3dModels) && filePath.startsWith("library/pkg/") &&
+          filePath.endsWith(".step")) {
+        return false;
+      }
       return !filePath.startsWith("output/");
     };
     return mProject.getDirectory().getFileSystem()->exportToZip(
@@ -327,6 +358,7 @@ bool ProjectEditor::saveProject() noexcept {
     emit projectAboutToBeSaved();
     mProject.save();  // can throw
     mProject.getDirectory().getFileSystem()->save();  // can throw
+    mThumbnailOutdated = true;
     mLastAutosaveStateId = mUndoStack->getUniqueStateId();
     mManualModificationsMade = false;
 
@@ -436,12 +468,80 @@ void ProjectEditor::clearHighlightedNetSignals() noexcept {
  *  Private Methods
  ******************************************************************************/
 
+void ProjectEditor::saveThumbnail() noexcept {
+  try {
+    // Prefer the first board since it's more distinctive than a schematic.
+    std::unique_ptr<GraphicsPagePainter> page;
+    if (const Board* board = mProject.getBoards().value(0)) {
+      page.reset(new BoardPainter(*board));
+    } else if (const Schematic* schematic = mProject.getSchematics().value(0)) {
+      page.reset(new SchematicPainter(*schematic));
+    } else {
+      return;
+    }
+
+    // Record the painted content to determine its bounding rect.
+    const GraphicsExportSettings settings;
+    QPicture picture;
+    QPainter recorder(&picture);
+    page->paint(recorder, settings);
+    recorder.end();
+    const QRectF sourceRect = picture.boundingRect();
+    if (sourceRect.isEmpty()) {
+      return;
+    }
+
+    // Render the content into a small image.
+    const qreal maxSize = 256;
+    const qreal scale = std::min(maxSize / sourceRect.width(),
+                                 maxSize / sourceRect.height());
+    QImage image(qCeil(sourceRect.width() * scale),
+                 qCeil(sourceRect.height() * scale), QImage::Format_RGB32);
+    image.fill(settings.getBackgroundColor());
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing |
+                           QPainter::SmoothPixmapTransform);
+    painter.scale(scale, scale);
+    painter.translate(-sourceRect.topLeft());
+    painter.drawPicture(0, 0, picture);
+    painter.end();
+    image.setText("Project", mProject.getPath().toStr());
+
+    const FilePath fp =
+        mWorkspace.getProjectThumbnailFilePath(mProject.getPath());
+    FileUtils::makePath(fp.getParentDir());  // can throw
+    if (!image.save(fp.toStr(), "PNG")) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         QString("Failed to write %1.").arg(fp.toNative()));
+    }
+    pruneThumbnails(fp.getParentDir());
+  } catch (const Exception& e) {
+    qWarning() << "Failed to save project thumbnail:" << e.getMsg();
+  }
+}
+
+void ProjectEditor::pruneThumbnails(const FilePath& dir) noexcept {
+  // Remove thumbnails of projects which have been moved or deleted, as well as
+  // thumbnails without the project path (i.e. not written by this method).
+  foreach (const QFileInfo& info,
+           QDir(dir.toStr()).entryInfoList({"*.png"}, QDir::Files)) {
+    const QString projectPath =
+        QImageReader(info.absoluteFilePath()).text("Project");
+    if (projectPath.isEmpty() || (!FilePath(projectPath).isExistingDir())) {
+      try {
+        FileUtils::removeFile(FilePath(info.absoluteFilePath()));  // can throw
+      } catch (const Exception& e) {
+        qWarning() << "Failed to prune project thumbnails:" << e.getMsg();
+      }
+    }
+  }
+}
+
 void ProjectEditor::runErc() noexcept {
   try {
     QElapsedTimer timer;
     timer.start();
-    ElectricalRuleCheck erc(mProject);
-    mErcMessages = erc.runChecks();
+    mErcMessages = mErc->runChecks();
 
     // Detect disappeared messages & remove their approvals.
     QSet<SExpression> approvals =
@@ -40,6 +40,7 @@ class QMainWindow;
 namespace librepcb {
 
 class Board;
+class ElectricalRuleCheck;
 class FilePath;
 class LengthUnit;
 class NetSignal;
@@ -256,6 +257,8 @@ signals:
   void projectEditorClosed();
 
 private:  // Methods
+  void saveThumbnail() noexcept;
+  static void pruneThumbnails(const FilePath& dir) noexcept;
   void runErc() noexcept;
   void saveErcMessageApprovals(const QSet<SExpression>& approvals) noexcept;
   int getCountOfVisibleEditorWindows() const noexcept;
@@ -273,6 +276,7 @@ private:  // Data
   QSet<SExpression> mSupportedErcApprovals;
   QSet<SExpression> mDisappearedErcApprovals;
   RuleCheckMessageList mErcMessages;
+  std::unique_ptr<ElectricalRuleCheck> mErc;  ///< Kept for incremental runs
 
   std::shared_ptr<QSet<const NetSignal*>> mHighlightedNetSignals;
 
@@ -285,6 +289,9 @@ private:  // Data
 
   /// Modifications bypassing the undo stack
   bool mManualModificationsMade;
+
+  /// Whether the thumbnail needs to be rendered when closing the project
+  bool mThumbnailOutdated;
 };
 
 /*******************************************************************************
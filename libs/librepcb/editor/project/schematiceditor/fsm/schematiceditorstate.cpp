@@ -144,6 +144,15 @@ QList<std::shared_ptr<QGraphicsItem>> SchematicEditorState::findItemsAtPos(
     posAreaInGrid.addEllipse(pos.toPxQPointF(), gridDistancePx, gridDistancePx);
   }
 
+  // Mapping the shape of an item to the scene is expensive, so items are
+  // first filtered by their bounding rect which contains the shape anyway.
+  // Thus the expensive checks are only done for items close to the cursor,
+  // independent of the sheet size. Items with an empty bounding rect are
+  // not filtered since QRectF::intersects() would always return false.
+  const QRectF searchRect = posAreaLarge.boundingRect()
+                                .united(posAreaInGrid.boundingRect())
+                                .united(QRectF(posExact, QSizeF(0, 0)));
+
   // Note: The order of adding the items is very important (the top most item
   // must appear as the first item in the list)! For that, we work with
   // priorities (0 = highest priority):
@@ -175,9 +184,14 @@ QList<std::shared_ptr<QGraphicsItem>> SchematicEditorState::findItemsAtPos(
         lowestPriority && (prio > (*lowestPriority));
   };
   auto processItem = [&pos, &posExact, &posArea, &posAreaLarge, &posAreaInGrid,
-                      flags, &except, &addItem, &canSkip](
+                      &searchRect, flags, &except, &addItem, &canSkip](
                          std::shared_ptr<QGraphicsItem> item,
                          const Point& nearestPos, int priority, bool large) {
+    const QRectF itemRect = item->sceneBoundingRect();
+    if ((itemRect.width() > 0) && (itemRect.height() > 0) &&
+        (!itemRect.intersects(searchRect))) {
+      return;
+    }
     if (except.contains(item)) {
       return;
     }
@@ -24,6 +24,7 @@
 
 #include "../../../graphics/graphicslayer.h"
 #include "../../../graphics/linegraphicsitem.h"
+#include "../../../graphics/textlayoutcache.h"
 #include "../schematicgraphicsscene.h"
 
 #include <librepcb/core/application.h>
@@ -31,7 +32,6 @@
 #include <librepcb/core/project/schematic/items/si_netlabel.h>
 #include <librepcb/core/project/schematic/items/si_netsegment.h>
 #include <librepcb/core/types/alignment.h>
-#include <librepcb/core/utils/overlinemarkupparser.h>
 #include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/theme.h>
 
@@ -195,30 +195,28 @@ void SGI_NetLabel::updateText() noexcept {
   const int flags =
       mRotate180 ? align.mirrored().toQtAlign() : align.toQtAlign();
 
-  QString displayText;
-  const QFontMetricsF fm(mFont);
-  OverlineMarkupParser::process(*mNetLabel.getNetSignalOfNetSegment().getName(),
-                                fm, flags, displayText, mOverlines,
-                                mBoundingRect);
+  // The layout is shared with all other labels of the same net, so only the
+  // final, transformed layout needs to be prepared here.
+  const TextLayoutCache::Layout& layout = TextLayoutCache::get(
+      *mNetLabel.getNetSignalOfNetSegment().getName(), mFont, flags, true);
+  const QSizeF size = layout.staticText.size();
+  mOverlines = layout.overlines;
 
-  mStaticText.setText(displayText);
-  mStaticText.prepare(QTransform(), mFont);
+  mStaticText.setText(layout.displayText);
   if (mNetLabel.getMirrored() ^ mRotate180) {
-    mTextOrigin.setX(-mStaticText.size().width());
+    mTextOrigin.setX(-size.width());
   } else {
     mTextOrigin.setX(0);
   }
-  mTextOrigin.setY(mRotate180 ? 0 : -mStaticText.size().height());
+  mTextOrigin.setY(mRotate180 ? 0 : -size.height());
   mStaticText.prepare(QTransform()
                           .rotate(mRotate180 ? 180 : 0)
                           .translate(mTextOrigin.x(), mTextOrigin.y()),
                       mFont);
 
-  QRectF rect =
-      QRectF(0, 0, mStaticText.size().width(), -mStaticText.size().height())
-          .normalized();
+  QRectF rect = QRectF(0, 0, size.width(), -size.height()).normalized();
 
-  if (mNetLabel.getMirrored()) rect.moveLeft(-mStaticText.size().width());
+  if (mNetLabel.getMirrored()) rect.moveLeft(-size.width());
 
   qreal len = sOriginCrossLines[0].length();
   mBoundingRect =
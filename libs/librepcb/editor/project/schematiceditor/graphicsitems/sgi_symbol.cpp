@@ -61,19 +61,14 @@ SGI_Symbol::SGI_Symbol(SI_Symbol& symbol,
   mOriginCrossGraphicsItem->setSize(UnsignedLength(1400000));
   mOriginCrossGraphicsItem->setLayer(
       lp.getLayer(Theme::Color::sSchematicReferences));
-  mShape.addRect(mOriginCrossGraphicsItem->boundingRect());
+  mShape = getShape(mSymbol.getLibSymbol(),
+                    mOriginCrossGraphicsItem->boundingRect());
 
   for (const auto& obj : mSymbol.getLibSymbol().getCircles()) {
     auto i = std::make_shared<CircleGraphicsItem>(const_cast<Circle&>(obj), lp,
                                                   this);
     i->setFlag(QGraphicsItem::ItemIsSelectable, true);
     i->setFlag(QGraphicsItem::ItemStacksBehindParent, true);
-    if (obj.isGrabArea()) {
-      const qreal r = (obj.getDiameter() + obj.getLineWidth())->toPx() / 2;
-      QPainterPath path;
-      path.addEllipse(obj.getCenter().toPxQPointF(), r, r);
-      mShape |= path;
-    }
     mCircleGraphicsItems.append(i);
   }
 
@@ -82,11 +77,6 @@ SGI_Symbol::SGI_Symbol(SI_Symbol& symbol,
                                                    lp, this);
     i->setFlag(QGraphicsItem::ItemIsSelectable, true);
     i->setFlag(QGraphicsItem::ItemStacksBehindParent, true);
-    if (obj.isGrabArea()) {
-      mShape |= Toolbox::shapeFromPath(obj.getPath().toQPainterPathPx(),
-                                       Qt::SolidLine, Qt::SolidPattern,
-                                       obj.getLineWidth());
-    }
     mPolygonGraphicsItems.append(i);
   }
 
@@ -102,6 +92,47 @@ SGI_Symbol::~SGI_Symbol() noexcept {
  *  Private Methods
  ******************************************************************************/
 
+std::shared_ptr<const QPainterPath> SGI_Symbol::getShape(
+    const Symbol& symbol, const QRectF& originCrossRect) noexcept {
+  // Note: An entry is alive only as long as any graphics item of the symbol
+  // exists, thus the symbol is still alive too and its address can be used
+  // as key (symbols of the project library are immutable). The origin cross
+  // has the same size for all symbols.
+  static QHash<const Symbol*, std::weak_ptr<const QPainterPath>> cache;
+  if (std::shared_ptr<const QPainterPath> shape = cache.value(&symbol).lock()) {
+    return shape;
+  }
+
+  std::shared_ptr<QPainterPath> shape = std::make_shared<QPainterPath>();
+  shape->addRect(originCrossRect);
+  for (const Circle& obj : symbol.getCircles()) {
+    if (obj.isGrabArea()) {
+      const qreal r = (obj.getDiameter() + obj.getLineWidth())->toPx() / 2;
+      QPainterPath path;
+      path.addEllipse(obj.getCenter().toPxQPointF(), r, r);
+      *shape |= path;
+    }
+  }
+  for (const Polygon& obj : symbol.getPolygons()) {
+    if (obj.isGrabArea()) {
+      *shape |= Toolbox::shapeFromPath(obj.getPath().toQPainterPathPx(),
+                                       Qt::SolidLine, Qt::SolidPattern,
+                                       obj.getLineWidth());
+    }
+  }
+
+  // Remove entries of symbols not in use anymore.
+  for (auto it = cache.begin(); it != cache.end();) {
+    if (it->expired()) {
+      it = cache.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  cache.insert(&symbol, shape);
+  return shape;
+}
+
 void SGI_Symbol::symbolEdited(const SI_Symbol& obj,
                               SI_Symbol::Event event) noexcept {
   Q_UNUSED(obj);
@@ -34,6 +34,7 @@
 namespace librepcb {
 
 class Point;
+class Symbol;
 
 namespace editor {
 
@@ -69,12 +70,14 @@ public:
   SI_Symbol& getSymbol() noexcept { return mSymbol; }
 
   // Inherited from QGraphicsItem
-  QPainterPath shape() const noexcept override { return mShape; }
+  QPainterPath shape() const noexcept override { return *mShape; }
 
   // Operator Overloadings
   SGI_Symbol& operator=(const SGI_Symbol& rhs) = delete;
 
 private:  // Methods
+  static std::shared_ptr<const QPainterPath> getShape(
+      const Symbol& symbol, const QRectF& originCrossRect) noexcept;
   void symbolEdited(const SI_Symbol& obj, SI_Symbol::Event event) noexcept;
   void updatePosition() noexcept;
   void updateRotationAndMirrored() noexcept;
@@ -86,7 +89,7 @@ private:  // Data
   std::shared_ptr<OriginCrossGraphicsItem> mOriginCrossGraphicsItem;
   QVector<std::shared_ptr<CircleGraphicsItem>> mCircleGraphicsItems;
   QVector<std::shared_ptr<PolygonGraphicsItem>> mPolygonGraphicsItems;
-  QPainterPath mShape;
+  std::shared_ptr<const QPainterPath> mShape;  ///< Shared by all instances
 
   // Slots
   SI_Symbol::OnEditedSlot mOnEditedSlot;
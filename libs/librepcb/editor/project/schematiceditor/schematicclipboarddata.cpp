@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "schematicclipboarddata.h"
 
+#include "../../utils/clipboardmimedata.h"
+
 #include <librepcb/core/application.h>
 #include <librepcb/core/fileio/transactionaldirectory.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
@@ -43,7 +45,15 @@ namespace editor {
 SchematicClipboardData::SchematicClipboardData(
     const Uuid& schematicUuid, const Point& cursorPos,
     const AssemblyVariantList& assemblyVariants) noexcept
-  : mFileSystem(TransactionalFileSystem::openRW(FilePath::getRandomTempPath())),
+  : SchematicClipboardData(createClipboardFileSystem(), schematicUuid,
+                           cursorPos, assemblyVariants) {
+}
+
+SchematicClipboardData::SchematicClipboardData(
+    const std::shared_ptr<TransactionalFileSystem>& fs,
+    const Uuid& schematicUuid, const Point& cursorPos,
+    const AssemblyVariantList& assemblyVariants) noexcept
+  : mFileSystem(fs),
     mSchematicUuid(schematicUuid),
     mCursorPos(cursorPos),
     mAssemblyVariants(assemblyVariants),
@@ -71,11 +81,8 @@ SchematicClipboardData::SchematicClipboardData(const QByteArray& mimeData)
 }
 
 SchematicClipboardData::~SchematicClipboardData() noexcept {
-  // Clean up the temporary directory, but destroy the TransactionalFileSystem
-  // object first since it has a lock on the directory.
-  FilePath fp = mFileSystem->getAbsPath();
-  mFileSystem.reset();
-  QDir(fp.toStr()).removeRecursively();
+  // Note: The temporary directory is removed by the file system once the
+  // last copy of it has been released, see createClipboardFileSystem().
 }
 
 /*******************************************************************************
@@ -92,7 +99,33 @@ std::unique_ptr<TransactionalDirectory> SchematicClipboardData::getDirectory(
  *  General Methods
  ******************************************************************************/
 
-std::unique_ptr<QMimeData> SchematicClipboardData::toMimeData() const {
+std::unique_ptr<QMimeData> SchematicClipboardData::toMimeData() noexcept {
+  // Only a shallow copy is stored in the MIME data, serialization is done
+  // lazily when the content is requested from the clipboard.
+  return std::unique_ptr<QMimeData>(
+      new ClipboardMimeData<SchematicClipboardData>(
+          std::shared_ptr<SchematicClipboardData>(shallowCopy().release()),
+          getMimeType()));
+}
+
+std::unique_ptr<SchematicClipboardData> SchematicClipboardData::fromMimeData(
+    const QMimeData* mime) {
+  // Fast path for data copied within this application instance.
+  typedef ClipboardMimeData<SchematicClipboardData> OwnMimeData;
+  if (const OwnMimeData* own = dynamic_cast<const OwnMimeData*>(mime)) {
+    return own->getData()->shallowCopy();
+  }
+
+  QByteArray content = mime ? mime->data(getMimeType()) : QByteArray();
+  if (!content.isNull()) {
+    return std::unique_ptr<SchematicClipboardData>(
+        new SchematicClipboardData(content));  // can throw
+  } else {
+    return nullptr;
+  }
+}
+
+QByteArray SchematicClipboardData::serializeToZip(QByteArray& content) const {
   SExpression root = SExpression::createList("librepcb_clipboard_schematic");
   root.ensureLineBreak();
   mCursorPos.serialize(root.appendList("cursor_position"));
@@ -112,35 +145,40 @@ std::unique_ptr<QMimeData> SchematicClipboardData::toMimeData() const {
   mTexts.serialize(root);
   root.ensureLineBreak();
 
-  const QByteArray sexpr = root.toByteArray();
-  mFileSystem->write("schematic.lp", sexpr);
-  const QByteArray zip = mFileSystem->exportToZip();
-
-  std::unique_ptr<QMimeData> data(new QMimeData());
-  data->setData(getMimeType(), zip);
-  data->setData("application/zip", zip);
-  // Note: At least on one system the clipboard didn't work if no text was
-  // set, so let's also copy the SExpression as text as a workaround. This
-  // might be useful anyway, e.g. for debugging purposes.
-  data->setText(QString::fromUtf8(sexpr));
-  return data;
-}
-
-std::unique_ptr<SchematicClipboardData> SchematicClipboardData::fromMimeData(
-    const QMimeData* mime) {
-  QByteArray content = mime ? mime->data(getMimeType()) : QByteArray();
-  if (!content.isNull()) {
-    return std::unique_ptr<SchematicClipboardData>(
-        new SchematicClipboardData(content));  // can throw
-  } else {
-    return nullptr;
-  }
+  content = root.toByteArray();
+  mFileSystem->write("schematic.lp", content);
+  return mFileSystem->exportToZip();  // can throw
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+std::unique_ptr<SchematicClipboardData>
+    SchematicClipboardData::shallowCopy() noexcept {
+  std::unique_ptr<SchematicClipboardData> copy(new SchematicClipboardData(
+      mFileSystem, mSchematicUuid, mCursorPos, AssemblyVariantList()));
+  foreach (const auto& obj, mAssemblyVariants.values()) {
+    copy->mAssemblyVariants.append(obj);
+  }
+  foreach (const auto& obj, mComponentInstances.values()) {
+    copy->mComponentInstances.append(obj);
+  }
+  foreach (const auto& obj, mSymbolInstances.values()) {
+    copy->mSymbolInstances.append(obj);
+  }
+  foreach (const auto& obj, mNetSegments.values()) {
+    copy->mNetSegments.append(obj);
+  }
+  foreach (const auto& obj, mPolygons.values()) {
+    copy->mPolygons.append(obj);
+  }
+  foreach (const auto& obj, mTexts.values()) {
+    copy->mTexts.append(obj);
+  }
+  return copy;
+}
+
 QString SchematicClipboardData::getMimeType() noexcept {
   return QString("application/x-librepcb-clipboard.schematic; version=%1")
       .arg(Application::getVersion());
@@ -52,6 +52,11 @@ namespace editor {
 
 /**
  * @brief The SchematicClipboardData class
+ *
+ * Within the same application instance, the clipboard contains the data
+ * object itself (see ::librepcb::editor::ClipboardMimeData), so copy & paste
+ * does not need to serialize and parse the items and library elements. The
+ * serialized Zip file is only generated when requested by another process.
  */
 class SchematicClipboardData final {
 public:
@@ -253,14 +258,35 @@ public:
   TextList& getTexts() noexcept { return mTexts; }
 
   // General Methods
-  std::unique_ptr<QMimeData> toMimeData() const;
+  std::unique_ptr<QMimeData> toMimeData() noexcept;
   static std::unique_ptr<SchematicClipboardData> fromMimeData(
       const QMimeData* mime);
 
+  /**
+   * @brief Serialize the data into a Zip file
+   *
+   * @param content   The content of the main file (S-Expression) is
+   *                  returned here.
+   *
+   * @return The Zip file containing the data and library elements.
+   */
+  QByteArray serializeToZip(QByteArray& content) const;
+
   // Operator Overloadings
   SchematicClipboardData& operator=(const SchematicClipboardData& rhs) = delete;
 
 private:  // Methods
+  SchematicClipboardData(const std::shared_ptr<TransactionalFileSystem>& fs,
+                         const Uuid& schematicUuid, const Point& cursorPos,
+                         const AssemblyVariantList& assemblyVariants) noexcept;
+
+  /**
+   * @brief Create a copy which shares the items and the file system
+   *
+   * @note  The items are not copied, so they must not be modified.
+   */
+  std::unique_ptr<SchematicClipboardData> shallowCopy() noexcept;
+
   static QString getMimeType() noexcept;
 
 private:  // Data
@@ -104,6 +104,8 @@ SchematicEditor::SchematicEditor(ProjectEditor& projectEditor, Project& project)
   mUi->graphicsView->setGridStyle(theme.getSchematicGridStyle());
   mUi->graphicsView->setUseOpenGl(
       mProjectEditor.getWorkspace().getSettings().useOpenGl.get());
+  mUi->graphicsView->setShowRenderStatistics(
+      mProjectEditor.getWorkspace().getSettings().showRenderStatistics.get());
   mUi->graphicsView->setEventHandlerObject(this);
   connect(mUi->graphicsView, &GraphicsView::cursorScenePositionChanged,
           mUi->statusbar, &StatusBar::setAbsoluteCursorPosition);
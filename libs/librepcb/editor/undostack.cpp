@@ -81,7 +81,9 @@ UndoStack::UndoStack() noexcept
   : QObject(nullptr),
     mCurrentIndex(0),
     mCleanIndex(0),
-    mActiveCommandGroup(nullptr) {
+    mUndoLimit(0),
+    mActiveCommandGroup(nullptr),
+    mCommandsMemory("Undo commands") {
 }
 
 UndoStack::~UndoStack() noexcept {
@@ -150,6 +152,11 @@ void UndoStack::setClean() noexcept {
   emit cleanChanged(true);
 }
 
+void UndoStack::setUndoLimit(int limit) noexcept {
+  mUndoLimit = std::max(limit, 0);
+  discardOldCommands();
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -186,6 +193,7 @@ bool UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) {
     mCommands.append(
         cmdScopeGuard.take());  // move ownership of "cmd" to "mCommands"
     mCurrentIndex++;
+    discardOldCommands();
 
     // emit signals
     emit undoTextChanged(tr("Undo: %1").arg(cmd->getText()));
@@ -276,6 +284,7 @@ void UndoStack::abortCmdGroup() {
     mCurrentIndex--;
     delete mCommands.takeLast();  // delete and remove the aborted command group
                                   // from the stack
+    mCommandsMemory.set(mCommands.count(), 0);
   } catch (Exception& e) {
     qCritical() << "Exception thrown in UndoCommand::undo():" << e.getMsg();
     throw;
@@ -357,6 +366,7 @@ void UndoStack::clear() noexcept {
   mCurrentIndex = 0;
   mCleanIndex = 0;
   mActiveCommandGroup = nullptr;
+  mCommandsMemory.set(0, 0);
 
   // emit signals
   emit undoTextChanged(tr("Undo"));
@@ -366,6 +376,21 @@ void UndoStack::clear() noexcept {
   emit cleanChanged(true);
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void UndoStack::discardOldCommands() noexcept {
+  // Note: Undo stays possible since at least #mUndoLimit commands are kept.
+  while ((mUndoLimit > 0) && (mCurrentIndex > mUndoLimit)) {
+    delete mCommands.takeFirst();
+    mCurrentIndex--;
+    // If the clean state was discarded, it can't be reached anymore.
+    mCleanIndex = (mCleanIndex > 0) ? (mCleanIndex - 1) : -1;
+  }
+  mCommandsMemory.set(mCommands.count(), 0);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/core/memoryaccounting.h>
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -184,6 +186,16 @@ public:
    */
   void setClean() noexcept;
 
+  /**
+   * @brief Set the maximum number of commands which can be undone
+   *
+   * If more commands are executed, the oldest ones are deleted to limit the
+   * memory usage of the stack.
+   *
+   * @param limit   Maximum number of undo steps (0 = unlimited).
+   */
+  void setUndoLimit(int limit) noexcept;
+
   // General Methods
 
   /**
@@ -301,6 +313,8 @@ signals:
   void stateModified();
 
 private:
+  void discardOldCommands() noexcept;
+
   /**
    * @brief This list holds all commands of the undo stack
    *
@@ -325,6 +339,11 @@ private:
    */
   int mCleanIndex;
 
+  /**
+   * @brief Maximum number of commands below #mCurrentIndex (0 = unlimited)
+   */
+  int mUndoLimit;
+
   /**
    * @brief If a command group is active at the moment, this is the pointer to
    * it
@@ -334,6 +353,11 @@ private:
    * nullptr.
    */
   UndoCommandGroup* mActiveCommandGroup;
+
+  /**
+   * @brief Accounting of the number of commands in #mCommands
+   */
+  MemoryAccounting::Counter mCommandsMemory;
 };
 
 /*******************************************************************************
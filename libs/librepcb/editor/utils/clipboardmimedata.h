@@ -0,0 +1,145 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_EDITOR_CLIPBOARDMIMEDATA_H
+#define LIBREPCB_EDITOR_CLIPBOARDMIMEDATA_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/filepath.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+/*******************************************************************************
+ *  Non-Member Functions
+ ******************************************************************************/
+
+/**
+ * @brief Create a file system in a new temporary directory for clipboard data
+ *
+ * Since clipboard data objects share their file system with their shallow
+ * copies (and with directories created from it), the temporary directory is
+ * removed as soon as the last reference to the returned file system has been
+ * released.
+ *
+ * @return The file system of the temporary directory.
+ */
+inline std::shared_ptr<TransactionalFileSystem> createClipboardFileSystem() {
+  const FilePath fp = FilePath::getRandomTempPath();
+  std::shared_ptr<TransactionalFileSystem> fs =
+      TransactionalFileSystem::openRW(fp);  // can throw
+  // Destroy the TransactionalFileSystem object before removing the directory
+  // since it has a lock on the directory.
+  return std::shared_ptr<TransactionalFileSystem>(
+      fs.get(), [fs, fp](TransactionalFileSystem*) mutable {
+        fs.reset();
+        QDir(fp.toStr()).removeRecursively();
+      });
+}
+
+/*******************************************************************************
+ *  Class ClipboardMimeData
+ ******************************************************************************/
+
+/**
+ * @brief Clipboard MIME data which keeps the copied objects in memory
+ *
+ * Serializing the copied objects (and the library elements they depend on)
+ * into a Zip file is expensive for large selections. This class holds the
+ * clipboard data object itself, so pasting within the same application
+ * instance can use it directly by #getData(). The Zip file and its
+ * S-Expression content (as text) are only generated lazily when their
+ * content is actually requested, e.g. by another process.
+ *
+ * @tparam T  The clipboard data class. It must provide a method
+ *            `QByteArray serializeToZip(QByteArray& content)` which returns
+ *            the Zip file and its main S-Expression file content.
+ */
+template <typename T>
+class ClipboardMimeData final : public QMimeData {
+public:
+  // Constructors / Destructor
+  ClipboardMimeData() = delete;
+  ClipboardMimeData(const ClipboardMimeData& other) = delete;
+  ClipboardMimeData(const std::shared_ptr<T>& data,
+                    const QString& mimeType) noexcept
+    : QMimeData(), mData(data), mMimeType(mimeType) {}
+  ~ClipboardMimeData() noexcept {}
+
+  // Getters
+  const std::shared_ptr<T>& getData() const noexcept { return mData; }
+
+  // Inherited from QMimeData
+  QStringList formats() const override {
+    return {mMimeType, "application/zip", "text/plain"};
+  }
+
+  // Operator Overloadings
+  ClipboardMimeData& operator=(const ClipboardMimeData& rhs) = delete;
+
+protected:
+  QVariant retrieveData(const QString& mimeType,
+                        QVariant::Type type) const override {
+    if (!formats().contains(mimeType)) {
+      return QVariant();
+    }
+    if (mZip.isNull()) {
+      try {
+        mZip = mData->serializeToZip(mContent);  // can throw
+      } catch (const Exception& e) {
+        qCritical() << "Failed to serialize clipboard data:" << e.getMsg();
+        return QVariant();
+      }
+    }
+    // Note: At least on one system the clipboard didn't work if no text was
+    // set, so let's also provide the SExpression as text as a workaround.
+    // This might be useful anyway, e.g. for debugging purposes.
+    if (mimeType == "text/plain") {
+      return QString::fromUtf8(mContent);
+    }
+    Q_UNUSED(type);
+    return mZip;
+  }
+
+private:  // Data
+  std::shared_ptr<T> mData;
+  QString mMimeType;
+  mutable QByteArray mZip;  ///< Lazily generated Zip file
+  mutable QByteArray mContent;  ///< Lazily generated S-Expression content
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
+
+#endif
@@ -43,6 +43,12 @@
 namespace librepcb {
 namespace editor {
 
+/// Minimum size of the global pixmap cache [kB]
+static const int sPixmapCacheLimitKb = 100 * 1024;
+
+/// Frames taking longer than this time [μs] are logged as slow
+static const qint64 sSlowFrameTimeUs = 100 * 1000;
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -65,6 +71,7 @@ GraphicsView::GraphicsView(QWidget* parent,
     mOriginCrossVisible(true),
     mUseOpenGl(false),
     mGrayOut(false),
+    mShowRenderStatistics(false),
     mSceneCursor(),
     mRulerGauges({
         {1, LengthUnit::millimeters(), " ", Length(100), Length(0)},
@@ -74,7 +81,9 @@ GraphicsView::GraphicsView(QWidget* parent,
     mPanningActive(false),
     mPanningButton(Qt::NoButton),
     mPressedMouseButtons(Qt::NoButton),
-    mIdleTimeMs(0) {
+    mIdleTimeMs(0),
+    mItemsPaintTimer(),
+    mLastFrameTimeUs(0) {
   setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
   setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
   setOptimizationFlags(QGraphicsView::DontSavePainterState);
@@ -83,6 +92,12 @@ GraphicsView::GraphicsView(QWidget* parent,
   setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
   setSceneRect(-2000, -2000, 4000, 4000);
 
+  // Some graphics items cache their rendered content (see
+  // QGraphicsItem::setCacheMode()). The default pixmap cache limit of Qt is
+  // way too small for that on large screens, thus increase it.
+  QPixmapCache::setCacheLimit(
+      std::max(QPixmapCache::cacheLimit(), sPixmapCacheLimitKb));
+
   mWaitingSpinnerWidget->setColor(mGridColor.lighter(120));
   mWaitingSpinnerWidget->hide();
 
@@ -220,6 +235,11 @@ void GraphicsView::setInfoBoxText(const QString& text) noexcept {
   mInfoBoxLabel->setVisible(!text.isEmpty());
 }
 
+void GraphicsView::setShowRenderStatistics(bool show) noexcept {
+  mShowRenderStatistics = show;
+  viewport()->update();
+}
+
 void GraphicsView::setOriginCrossVisible(bool visible) noexcept {
   mOriginCrossVisible = visible;
   setForegroundBrush(foregroundBrush());  // this will repaint the foreground
@@ -445,6 +465,22 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event) {
   return QWidget::eventFilter(obj, event);
 }
 
+void GraphicsView::paintEvent(QPaintEvent* event) {
+  if (!mShowRenderStatistics) {
+    QGraphicsView::paintEvent(event);
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  QGraphicsView::paintEvent(event);
+  mLastFrameTimeUs = timer.nsecsElapsed() / 1000;
+  if (mLastFrameTimeUs > sSlowFrameTimeUs) {
+    qDebug().nospace() << "Slow frame in graphics view: "
+                       << (mLastFrameTimeUs / 1000) << "ms";
+  }
+}
+
 void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect) {
   QPen gridPen(mGridColor);
   gridPen.setCosmetic(true);
@@ -492,6 +528,10 @@ void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect) {
         break;
     }
   }
+
+  if (mShowRenderStatistics) {
+    mItemsPaintTimer.start();
+  }
 }
 
 void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect) {
@@ -641,6 +681,27 @@ void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect) {
       painter->drawEllipse(pos, r / 2, r / 2);
     }
   }
+
+  // If enabled, draw render statistics of the last frame.
+  if (mShowRenderStatistics && mItemsPaintTimer.isValid()) {
+    const qint64 itemsTimeUs = mItemsPaintTimer.nsecsElapsed() / 1000;
+    const int itemCount = mScene ? mScene->items(rect).count() : 0;
+    const QString text =
+        QString("Frame: %1 ms | Items: %2 ms | Visible items: %3")
+            .arg(mLastFrameTimeUs / 1000.0, 0, 'f', 1)
+            .arg(itemsTimeUs / 1000.0, 0, 'f', 1)
+            .arg(itemCount);
+    painter->save();
+    painter->resetTransform();
+    painter->setFont(Application::getDefaultMonospaceFont());
+    QRectF textRect = painter->boundingRect(
+        viewport()->rect(), Qt::AlignRight | Qt::AlignTop, text);
+    textRect.adjust(-4, 0, 0, 4);
+    painter->fillRect(textRect, mOverlayFillColor);
+    painter->setPen(mOverlayContentColor);
+    painter->drawText(textRect, Qt::AlignCenter, text);
+    painter->restore();
+  }
 }
 
 /*******************************************************************************
@@ -106,6 +106,7 @@ public:
       const tl::optional<std::pair<Point, Point>>& pos) noexcept;
   void setInfoBoxText(const QString& text) noexcept;
   void setOriginCrossVisible(bool visible) noexcept;
+  void setShowRenderStatistics(bool show) noexcept;
   void setEventHandlerObject(
       IF_GraphicsViewEventHandler* eventHandler) noexcept;
 
@@ -146,6 +147,7 @@ private:
   // Inherited Methods
   void wheelEvent(QWheelEvent* event);
   bool eventFilter(QObject* obj, QEvent* event);
+  void paintEvent(QPaintEvent* event);
   void drawBackground(QPainter* painter, const QRectF& rect);
   void drawForeground(QPainter* painter, const QRectF& rect);
 
@@ -165,6 +167,7 @@ private:
   bool mOriginCrossVisible;
   bool mUseOpenGl;
   bool mGrayOut;
+  bool mShowRenderStatistics;
 
   /// If not nullopt, a cursor will be shown at the given position
   tl::optional<std::pair<Point, CursorOptions>> mSceneCursor;
@@ -187,6 +190,10 @@ private:
   QCursor mCursorBeforePanning;
   qint64 mIdleTimeMs;
 
+  // Render statistics (only measured if enabled)
+  QElapsedTimer mItemsPaintTimer;  ///< Started after drawing the background
+  qint64 mLastFrameTimeUs;  ///< Total paint time of the last frame
+
   // Static Variables
   static constexpr qreal sZoomStepFactor = 1.3;
 };
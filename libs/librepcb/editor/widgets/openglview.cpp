@@ -60,7 +60,9 @@ OpenGlView::OpenGlView(QWidget* parent) noexcept
     QOpenGLFunctions(),
     mLayout(new QVBoxLayout(this)),
     mErrorLabel(new QLabel(this)),
+    mStatisticsLabel(new QLabel(this)),
     mInitialized(false),
+    mShowRenderStatistics(false),
     mProjectionAspectRatio(1),
     mProjectionFov(sInitialFov),
     mProjectionCenter(0, 0),
@@ -77,6 +79,12 @@ OpenGlView::OpenGlView(QWidget* parent) noexcept
   mErrorLabel->hide();
   mLayout->addWidget(mErrorLabel.data());
 
+  mStatisticsLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+  mStatisticsLabel->setFont(Application::getDefaultMonospaceFont());
+  mStatisticsLabel->setStyleSheet("background-color: rgba(255,255,255,120);");
+  mStatisticsLabel->move(0, 0);
+  mStatisticsLabel->hide();
+
   mAnimation->setDuration(500);
   mAnimation->setEasingCurve(QEasingCurve::InOutCubic);
   connect(mAnimation.data(), &QVariantAnimation::valueChanged, this,
@@ -142,6 +150,12 @@ void OpenGlView::startSpinning() noexcept {
   mWaitingSpinner->show();
 }
 
+void OpenGlView::setShowRenderStatistics(bool show) noexcept {
+  mShowRenderStatistics = show;
+  mStatisticsLabel->setVisible(show);
+  update();
+}
+
 void OpenGlView::stopSpinning(QString errorMsg) noexcept {
   mWaitingSpinner->hide();
   if (errorMsg.isEmpty()) {
@@ -266,6 +280,9 @@ void OpenGlView::paintGL() {
     return;
   }
 
+  QElapsedTimer timer;
+  timer.start();
+
   // Clear color and depth buffer.
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -277,11 +294,28 @@ void OpenGlView::paintGL() {
   projection.perspective(mProjectionFov, mProjectionAspectRatio, zNear, zFar);
   projection.translate(mProjectionCenter.x(), mProjectionCenter.y(),
                        -sCameraPosZ);
-  mProgram.setUniformValue("mvp_matrix", projection * mTransform);
+  const QMatrix4x4 viewProjection = projection * mTransform;
+  mProgram.setUniformValue("mvp_matrix", viewProjection);
 
-  // Draw all objects.
+  // Draw all objects (invisible ones are skipped by the objects).
+  const QSizeF viewportSize(width(), height());
+  int drawnObjects = 0;
   foreach (const auto& obj, mObjects) {
-    obj->draw(*this, mProgram);
+    if (obj->draw(*this, mProgram, viewProjection, viewportSize)) {
+      ++drawnObjects;
+    }
+  }
+
+  // If enabled, show render statistics. Wait for the GPU to get the real
+  // frame time, which is acceptable since it's only for debugging purposes.
+  if (mShowRenderStatistics) {
+    glFinish();
+    const qint64 frameTimeUs = timer.nsecsElapsed() / 1000;
+    mStatisticsLabel->setText(QString("Frame: %1 ms | Objects: %2/%3")
+                                  .arg(frameTimeUs / 1000.0, 0, 'f', 1)
+                                  .arg(drawnObjects)
+                                  .arg(mObjects.count()));
+    mStatisticsLabel->resize(mStatisticsLabel->sizeHint());
   }
 }
 
@@ -66,6 +66,7 @@ public:
   void zoomAll() noexcept;
   void startSpinning() noexcept;
   void stopSpinning(QString errorMsg) noexcept;
+  void setShowRenderStatistics(bool show) noexcept;
 
   // Operator Overloadings
   OpenGlView& operator=(const OpenGlView& rhs) = delete;
@@ -88,7 +89,9 @@ private:
 private:
   QScopedPointer<QVBoxLayout> mLayout;
   QScopedPointer<QLabel> mErrorLabel;
+  QScopedPointer<QLabel> mStatisticsLabel;
   bool mInitialized;
+  bool mShowRenderStatistics;
   QOpenGLShaderProgram mProgram;
   qreal mProjectionAspectRatio;
   qreal mProjectionFov;
@@ -40,6 +40,8 @@ namespace editor {
 RuleCheckDock::RuleCheckDock(Mode mode, QWidget* parent) noexcept
   : QDockWidget(parent), mMode(mode), mUi(new Ui::RuleCheckDock) {
   mUi->setupUi(this);
+  mRunDrcToolTip = mUi->btnRunDrc->toolTip();
+  mRunQuickCheckToolTip = mUi->btnRunQuickCheck->toolTip();
   updateTitle(tl::nullopt);
   mUi->lstMessages->setHandler(this);
   mUi->cbxCenterInView->setVisible(mode == Mode::BoardDesignRuleCheck);
@@ -101,11 +103,37 @@ void RuleCheckDock::setMessages(
   updateTitle(mUi->lstMessages->getUnapprovedMessageCount());
 }
 
+void RuleCheckDock::setIntermediateMessages(
+    const RuleCheckMessageList& messages) noexcept {
+  mUi->lstMessages->setMessages(messages);
+  updateTitle(mUi->lstMessages->getUnapprovedMessageCount());
+}
+
 void RuleCheckDock::setApprovals(const QSet<SExpression>& approvals) noexcept {
   mUi->lstMessages->setApprovals(approvals);
   updateTitle(mUi->lstMessages->getUnapprovedMessageCount());
 }
 
+void RuleCheckDock::setProfiles(const QStringList& names) noexcept {
+  QMenu* menu = nullptr;
+  if (!names.isEmpty()) {
+    menu = new QMenu(this);
+    foreach (const QString& name, names) {
+      QAction* action = menu->addAction(tr("Run Profile '%1'").arg(name));
+      connect(action, &QAction::triggered, this,
+              [this, name]() { emit runProfileRequested(name); });
+    }
+  }
+  delete mUi->btnRunDrc->menu();
+  mUi->btnRunDrc->setMenu(menu);
+}
+
+void RuleCheckDock::setTimingReport(const QString& report) noexcept {
+  const QString suffix = report.isEmpty() ? QString() : ("\n\n" % report);
+  mUi->btnRunDrc->setToolTip(mRunDrcToolTip % suffix);
+  mUi->btnRunQuickCheck->setToolTip(mRunQuickCheckToolTip % suffix);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -75,8 +75,36 @@ public:
   void setProgressPercent(int percent) noexcept;
   void setProgressStatus(const QString& status) noexcept;
   void setMessages(const tl::optional<RuleCheckMessageList>& messages) noexcept;
+
+  /**
+   * @brief Show the messages found so far by a check still in progress
+   *
+   * In contrast to #setMessages(), the progress bar is kept visible.
+   *
+   * @param messages  The messages found so far.
+   */
+  void setIntermediateMessages(const RuleCheckMessageList& messages) noexcept;
   void setApprovals(const QSet<SExpression>& approvals) noexcept;
 
+  /**
+   * @brief Set the names of the custom DRC profiles
+   *
+   * The profiles are offered in a menu of the "Run DRC" button, which is
+   * shown by pressing and holding the button.
+   *
+   * @param names   Profile names (may be empty).
+   */
+  void setProfiles(const QStringList& names) noexcept;
+
+  /**
+   * @brief Set a report about the duration of the last run
+   *
+   * The report is appended to the tool tips of the run buttons.
+   *
+   * @param report  Multi-line report, or an empty string to remove it.
+   */
+  void setTimingReport(const QString& report) noexcept;
+
   // Operator Overloadings
   RuleCheckDock& operator=(const RuleCheckDock& rhs) = delete;
 
@@ -84,6 +112,7 @@ signals:
   void settingsDialogRequested();
   void runDrcRequested();
   void runQuickCheckRequested();
+  void runProfileRequested(const QString& name);
   void messageApprovalRequested(const RuleCheckMessage& msg, bool approve);
   void messageSelected(const RuleCheckMessage& msg, bool zoomTo);
 
@@ -106,6 +135,8 @@ private:  // Methods
 private:
   const Mode mMode;
   QScopedPointer<Ui::RuleCheckDock> mUi;
+  QString mRunDrcToolTip;
+  QString mRunQuickCheckToolTip;
 };
 
 /*******************************************************************************
@@ -46,10 +46,15 @@ RuleCheckListWidget::RuleCheckListWidget(QWidget* parent) noexcept
   QVBoxLayout* layout = new QVBoxLayout(this);
   layout->setContentsMargins(0, 0, 0, 0);
   layout->addWidget(mListWidget.data());
+  mListWidget->setUniformItemSizes(true);
   connect(mListWidget.data(), &QListWidget::currentItemChanged, this,
           &RuleCheckListWidget::currentItemChanged);
   connect(mListWidget.data(), &QListWidget::itemDoubleClicked, this,
           &RuleCheckListWidget::itemDoubleClicked);
+  connect(mListWidget->verticalScrollBar(), &QScrollBar::valueChanged, this,
+          &RuleCheckListWidget::createVisibleItemWidgets);
+  connect(mListWidget->verticalScrollBar(), &QScrollBar::rangeChanged, this,
+          &RuleCheckListWidget::createVisibleItemWidgets);
   updateList();  // Ensure consistent GUI enabled state.
 }
 
@@ -81,27 +86,57 @@ void RuleCheckListWidget::setMessages(
 
 void RuleCheckListWidget::setApprovals(
     const QSet<SExpression>& approvals) noexcept {
-  if (approvals != mApprovals) {
-    mApprovals = approvals;
+  QSet<QByteArray> keys;
+  keys.reserve(approvals.count());
+  foreach (const SExpression& approval, approvals) {
+    keys.insert(RuleCheckMessage::calcApprovalKey(approval));
+  }
+  if (keys != mApprovals) {
+    mApprovals = keys;
     updateList();
   }
 }
 
+/*******************************************************************************
+ *  Protected Methods
+ ******************************************************************************/
+
+void RuleCheckListWidget::resizeEvent(QResizeEvent* e) noexcept {
+  QWidget::resizeEvent(e);
+  // More items might be visible now without a scroll event.
+  createVisibleItemWidgets();
+}
+
+void RuleCheckListWidget::showEvent(QShowEvent* e) noexcept {
+  QWidget::showEvent(e);
+  // The viewport size was not known while the widget was hidden.
+  createVisibleItemWidgets();
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
 void RuleCheckListWidget::updateList() noexcept {
-  // Sort by approval state, severity and message.
+  // Determine the approval state of each message only once, not for every
+  // comparison during sorting.
   mDisplayedMessages = mMessages ? (*mMessages) : RuleCheckMessageList();
+  mApprovedMessages.clear();
+  foreach (const auto& msg, mDisplayedMessages) {
+    if (msg && mApprovals.contains(msg->getApprovalKey())) {
+      mApprovedMessages.insert(msg.get());
+    }
+  }
+
+  // Sort by approval state, severity and message.
   Toolbox::sortNumeric(
       mDisplayedMessages,
       [this](const QCollator& cmp,
              const std::shared_ptr<const RuleCheckMessage>& lhs,
              const std::shared_ptr<const RuleCheckMessage>& rhs) {
         if (lhs && rhs) {
-          const bool lhsApproved = mApprovals.contains(lhs->getApproval());
-          const bool rhsApproved = mApprovals.contains(rhs->getApproval());
+          const bool lhsApproved = mApprovedMessages.contains(lhs.get());
+          const bool rhsApproved = mApprovedMessages.contains(rhs.get());
           if (lhsApproved != rhsApproved) {
             return rhsApproved;
           } else if (lhs->getSeverity() != rhs->getSeverity()) {
@@ -115,21 +150,21 @@ void RuleCheckListWidget::updateList() noexcept {
       },
       Qt::CaseInsensitive, false);
 
-  // Update list widget.
+  // Update list widget. The item widgets are created later, see
+  // createVisibleItemWidgets(). All items get the size of a sample widget to
+  // make the scrollbar working without creating all widgets.
   mListWidget->setUpdatesEnabled(false);  // Avoid flicker.
   const bool signalsBlocked = blockSignals(true);
   mListWidget->clear();
-  int unapprovedMessageCount = 0;
+  const QSize itemSize = mDisplayedMessages.isEmpty()
+      ? QSize()
+      : RuleCheckListItemWidget(mDisplayedMessages.first(), *this, false)
+            .sizeHint();
   foreach (const auto& msg, mDisplayedMessages) {
+    Q_UNUSED(msg);
     QListWidgetItem* item = new QListWidgetItem();
+    item->setSizeHint(itemSize);
     mListWidget->addItem(item);
-    const bool approved = mApprovals.contains(msg->getApproval());
-    RuleCheckListItemWidget* widget =
-        new RuleCheckListItemWidget(msg, *this, approved);
-    mListWidget->setItemWidget(item, widget);
-    if (!approved) {
-      ++unapprovedMessageCount;
-    }
   }
   if (mMessages && mMessages->isEmpty()) {
     mListWidget->addItem(tr("Looks good so far :-)"));
@@ -137,6 +172,9 @@ void RuleCheckListWidget::updateList() noexcept {
   mListWidget->setEnabled(!mDisplayedMessages.isEmpty());
   blockSignals(signalsBlocked);
   mListWidget->setUpdatesEnabled(true);
+  createVisibleItemWidgets();
+  const int unapprovedMessageCount =
+      mDisplayedMessages.count() - mApprovedMessages.count();
 
   // Update count of unapproved messages.
   if (mMessages) {
@@ -146,6 +184,32 @@ void RuleCheckListWidget::updateList() noexcept {
   }
 }
 
+void RuleCheckListWidget::createVisibleItemWidgets() noexcept {
+  if (mDisplayedMessages.isEmpty()) {
+    return;
+  }
+  // Note: If the items are not laid out yet, estimate the visible rows from
+  // the item height to avoid creating the widgets of all items.
+  const QRect rect = mListWidget->viewport()->rect();
+  const int itemHeight =
+      std::max(mListWidget->item(0)->sizeHint().height(), 1);
+  int first = std::max(mListWidget->indexAt(rect.topLeft()).row(), 0);
+  int last = mListWidget->indexAt(rect.bottomLeft()).row();
+  if (last < 0) {
+    last = first + (rect.height() / itemHeight) + 1;
+  }
+  last = std::min(last, mDisplayedMessages.count() - 1);
+  for (int i = first; i <= last; ++i) {
+    QListWidgetItem* item = mListWidget->item(i);
+    if (item && (!mListWidget->itemWidget(item))) {
+      const auto& msg = mDisplayedMessages.at(i);
+      const bool approved = mApprovedMessages.contains(msg.get());
+      mListWidget->setItemWidget(
+          item, new RuleCheckListItemWidget(msg, *this, approved));
+    }
+  }
+}
+
 void RuleCheckListWidget::currentItemChanged(
     QListWidgetItem* current, QListWidgetItem* previous) noexcept {
   Q_UNUSED(previous);
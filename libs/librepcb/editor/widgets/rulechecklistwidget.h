@@ -164,6 +164,9 @@ private:  // Data
 
 /**
  * @brief The RuleCheckListWidget class
+ *
+ * To keep the widget responsive even with many thousands of messages, the
+ * widgets of the list items are created lazily only when they get visible.
  */
 class RuleCheckListWidget final : public QWidget, private IF_RuleCheckHandler {
   Q_OBJECT
@@ -188,8 +191,13 @@ public:
   // Operator Overloadings
   RuleCheckListWidget& operator=(const RuleCheckListWidget& rhs) = delete;
 
+protected:
+  void resizeEvent(QResizeEvent* e) noexcept override;
+  void showEvent(QShowEvent* e) noexcept override;
+
 private:  // Methods
   void updateList() noexcept;
+  void createVisibleItemWidgets() noexcept;
   void currentItemChanged(QListWidgetItem* current,
                           QListWidgetItem* previous) noexcept;
   void itemDoubleClicked(QListWidgetItem* item) noexcept;
@@ -212,7 +220,8 @@ private:  // Data
   IF_RuleCheckHandler* mHandler;
   tl::optional<RuleCheckMessageList> mMessages;
   RuleCheckMessageList mDisplayedMessages;
-  QSet<SExpression> mApprovals;
+  QSet<const RuleCheckMessage*> mApprovedMessages;
+  QSet<QByteArray> mApprovals;  ///< Approval keys
   tl::optional<int> mUnapprovedMessageCount;
 };
 
@@ -46,7 +46,8 @@ CategoryTreeModel::CategoryTreeModel(const WorkspaceLibraryDb& library,
     mLibrary(library),
     mLocaleOrder(localeOrder),
     mFilters(filters),
-    mRootItem(new Item{std::weak_ptr<Item>(), tl::nullopt, {}, {}, {}}) {
+    mRootItem(new Item{std::weak_ptr<Item>(), tl::nullopt, {}, {}, {}, true,
+                       true}) {
   update();
   connect(&mLibrary, &WorkspaceLibraryDb::scanSucceeded, this,
           &CategoryTreeModel::update);
@@ -80,6 +81,35 @@ int CategoryTreeModel::rowCount(const QModelIndex& parent) const noexcept {
   return item ? item->childs.count() : 0;
 }
 
+bool CategoryTreeModel::hasChildren(const QModelIndex& parent) const noexcept {
+  const Item* item = itemFromIndex(parent);
+  if (!item) {
+    return false;
+  }
+  return item->fetched ? (!item->childs.isEmpty()) : item->hasChilds;
+}
+
+bool CategoryTreeModel::canFetchMore(const QModelIndex& parent) const
+    noexcept {
+  const Item* item = itemFromIndex(parent);
+  return item && (!item->fetched);
+}
+
+void CategoryTreeModel::fetchMore(const QModelIndex& parent) noexcept {
+  Item* p = parent.isValid() ? static_cast<Item*>(parent.internalPointer())
+                             : nullptr;
+  std::shared_ptr<Item> item = p ? p->childs.value(parent.row()) : nullptr;
+  if (item && (!item->fetched) && (parent.model() == this)) {
+    item->fetched = true;
+    const QVector<std::shared_ptr<Item>> childs = getChilds(item);
+    if (!childs.isEmpty()) {
+      beginInsertRows(parent, 0, childs.count() - 1);
+      item->childs = childs;
+      endInsertRows();
+    }
+  }
+}
+
 QModelIndex CategoryTreeModel::index(int row, int column,
                                      const QModelIndex& parent) const noexcept {
   Item* p = itemFromIndex(parent);
@@ -137,25 +167,8 @@ void CategoryTreeModel::update() noexcept {
   QElapsedTimer t;
   t.start();
 
-  // Determine new items.
-  QVector<std::shared_ptr<Item>> items = getChilds(nullptr);
-
-  // Add virtual category for library elements with no category assigned.
-  try {
-    if (containsItems(tl::nullopt)) {
-      items.append(std::shared_ptr<Item>(
-          new Item{std::weak_ptr<Item>(),
-                   tl::nullopt,
-                   tr("(Without Category)"),
-                   tr("All library elements without a category"),
-                   {}}));
-    }
-  } catch (const Exception& e) {
-    qCritical() << "Failed to update category tree model:" << e.getMsg();
-  }
-
   // Update tree with new items in a way which keeps the selection in views.
-  updateModelItem(mRootItem, items);
+  updateModelItem(mRootItem);
 
   qDebug() << "Finished category tree model update in" << t.elapsed() << "ms.";
 }
@@ -163,16 +176,16 @@ void CategoryTreeModel::update() noexcept {
 QVector<std::shared_ptr<CategoryTreeModel::Item>> CategoryTreeModel::getChilds(
     std::shared_ptr<Item> parent) const noexcept {
   QVector<std::shared_ptr<Item>> childs;
-  tl::optional<Uuid> parentUuid = parent ? parent->uuid : tl::nullopt;
+  const bool isRoot = (parent == mRootItem);
   try {
-    QSet<Uuid> uuids = listPackageCategories()
-        ? mLibrary.getChilds<PackageCategory>(parentUuid)
-        : mLibrary.getChilds<ComponentCategory>(parentUuid);
-    foreach (const Uuid& uuid, uuids) {
+    foreach (const Uuid& uuid, getChildUuids(isRoot ? tl::nullopt
+                                                    : parent->uuid)) {
+      // Note: The childs of the child are not loaded yet, only check if
+      // there are any to be displayed.
       std::shared_ptr<Item> child(
-          new Item{parent, uuid, QString(), QString(), {}});
-      child->childs = getChilds(child);
-      if (!child->childs.isEmpty() || listAll() || containsItems(uuid)) {
+          new Item{parent, uuid, QString(), QString(), {}, false, false});
+      child->hasChilds = hasVisibleChilds(uuid);
+      if (child->hasChilds || listAll() || containsItems(uuid)) {
         FilePath fp = listPackageCategories()
             ? mLibrary.getLatest<PackageCategory>(uuid)
             : mLibrary.getLatest<ComponentCategory>(uuid);
@@ -201,9 +214,40 @@ QVector<std::shared_ptr<CategoryTreeModel::Item>> CategoryTreeModel::getChilds(
       },
       Qt::CaseInsensitive, false);
 
+  // Add virtual category for library elements with no category assigned.
+  if (isRoot) {
+    try {
+      if (containsItems(tl::nullopt)) {
+        childs.append(std::shared_ptr<Item>(
+            new Item{parent, tl::nullopt, tr("(Without Category)"),
+                     tr("All library elements without a category"), {}, false,
+                     true}));
+      }
+    } catch (const Exception& e) {
+      qCritical() << "Failed to update category tree model:" << e.getMsg();
+    }
+  }
+
   return childs;
 }
 
+QSet<Uuid> CategoryTreeModel::getChildUuids(
+    const tl::optional<Uuid>& parent) const {
+  return listPackageCategories()
+      ? mLibrary.getChilds<PackageCategory>(parent)
+      : mLibrary.getChilds<ComponentCategory>(parent);
+}
+
+bool CategoryTreeModel::hasVisibleChilds(const Uuid& uuid) const {
+  // Stops at the first visible child to avoid traversing the whole subtree.
+  foreach (const Uuid& child, getChildUuids(uuid)) {
+    if (listAll() || containsItems(child) || hasVisibleChilds(child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool CategoryTreeModel::containsItems(const tl::optional<Uuid>& uuid) const {
   if (listPackageCategories()) {
     if (mFilters.testFlag(Filter::PkgCatWithPackages) &&
@@ -237,13 +281,26 @@ bool CategoryTreeModel::listPackageCategories() const noexcept {
 }
 
 void CategoryTreeModel::updateModelItem(
-    std::shared_ptr<Item> parentItem,
-    const QVector<std::shared_ptr<Item>>& newChilds) noexcept {
+    std::shared_ptr<Item> parentItem) noexcept {
+  const QVector<std::shared_ptr<Item>> newChilds = getChilds(parentItem);
   for (int i = 0; i < newChilds.count(); ++i) {
     std::shared_ptr<Item> item = parentItem->childs.value(i);  // Might be null.
     std::shared_ptr<Item> newItem = newChilds.at(i);
     if (item) {
-      // Update existing item.
+      // Update existing item. If it now represents another category, its
+      // loaded childs are obsolete and will be fetched again on demand.
+      if ((item->uuid != newItem->uuid) && item->fetched &&
+          (!item->childs.isEmpty())) {
+        QModelIndex idx = indexFromItem(item.get());
+        Q_ASSERT(idx.isValid());
+        beginRemoveRows(idx, 0, item->childs.count() - 1);
+        item->childs.clear();
+        endRemoveRows();
+      }
+      if (item->uuid != newItem->uuid) {
+        item->fetched = newItem->fetched;
+      }
+      item->hasChilds = newItem->hasChilds;
       if ((item->uuid != newItem->uuid) || (item->text != newItem->text) ||
           (item->tooltip != newItem->tooltip)) {
         item->uuid = newItem->uuid;
@@ -253,7 +310,15 @@ void CategoryTreeModel::updateModelItem(
         Q_ASSERT(idx.isValid());
         emit dataChanged(idx, idx);
       }
-      updateModelItem(item, newItem->childs);
+      if (item->fetched && item->hasChilds) {
+        updateModelItem(item);
+      } else if (item->fetched && (!item->childs.isEmpty())) {
+        // All childs have been removed.
+        QModelIndex idx = indexFromItem(item.get());
+        beginRemoveRows(idx, 0, item->childs.count() - 1);
+        item->childs.clear();
+        endRemoveRows();
+      }
     } else {
       // Add new item.
       newItem->parent = parentItem;  // Update parent of item.
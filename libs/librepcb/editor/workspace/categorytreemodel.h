@@ -44,6 +44,11 @@ namespace editor {
 
 /**
  * @brief The CategoryTreeModel class
+ *
+ * The tree is populated lazily: Only the root categories are loaded
+ * initially, the childs of a category are loaded from the library database
+ * when the category gets expanded (see #canFetchMore() and #fetchMore()).
+ * On library updates, only the already loaded categories are updated.
  */
 class CategoryTreeModel final : public QAbstractItemModel {
   struct Item {
@@ -51,7 +56,9 @@ class CategoryTreeModel final : public QAbstractItemModel {
     tl::optional<Uuid> uuid;  ///< tl::nullopt for items without category
     QString text;
     QString tooltip;
-    QVector<std::shared_ptr<Item>> childs;
+    QVector<std::shared_ptr<Item>> childs;  ///< Only valid if #fetched
+    bool hasChilds;  ///< Whether there are (visible) childs to be fetched
+    bool fetched;  ///< Whether #childs have been loaded already
   };
 
 public:
@@ -88,6 +95,10 @@ public:
       const QModelIndex& parent = QModelIndex()) const noexcept override;
   int rowCount(
       const QModelIndex& parent = QModelIndex()) const noexcept override;
+  bool hasChildren(
+      const QModelIndex& parent = QModelIndex()) const noexcept override;
+  bool canFetchMore(const QModelIndex& parent) const noexcept override;
+  void fetchMore(const QModelIndex& parent) noexcept override;
   QModelIndex index(
       int row, int column,
       const QModelIndex& parent = QModelIndex()) const noexcept override;
@@ -104,12 +115,12 @@ private:  // Methods
   void update() noexcept;
   QVector<std::shared_ptr<Item>> getChilds(
       std::shared_ptr<Item> parent) const noexcept;
+  QSet<Uuid> getChildUuids(const tl::optional<Uuid>& parent) const;
+  bool hasVisibleChilds(const Uuid& uuid) const;
   bool containsItems(const tl::optional<Uuid>& uuid) const;
   bool listAll() const noexcept;
   bool listPackageCategories() const noexcept;
-  void updateModelItem(
-      std::shared_ptr<Item> parentItem,
-      const QVector<std::shared_ptr<Item>>& newChilds) noexcept;
+  void updateModelItem(std::shared_ptr<Item> parentItem) noexcept;
   Item* itemFromIndex(const QModelIndex& index) const noexcept;
   QModelIndex indexFromItem(const Item* item) const noexcept;
 
@@ -48,11 +48,14 @@
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/utils/concurrency.h>
 #include <librepcb/core/utils/scopeguard.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/core/workspace/workspacesettings.h>
 #include <librepcb_build_env.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -78,11 +81,20 @@ ControlPanel::ControlPanel(Workspace& workspace, bool fileFormatIsOutdated)
     mUi(new Ui::ControlPanel),
     mStandardCommandHandler(
         new StandardEditorCommandHandler(mWorkspace.getSettings(), this)),
-    mLibraryManager(new LibraryManager(mWorkspace, this)) {
+    mLibraryManager(new LibraryManager(mWorkspace, this)),
+    mOpeningProject(false) {
   mUi->setupUi(this);
   setWindowTitle(
       tr("Control Panel - LibrePCB %1").arg(Application::getVersion()));
 
+  // Apply the thread limit for background work.
+  Concurrency::setMaxThreadCount(mWorkspace.getSettings().workerThreads.get());
+  connect(&mWorkspace.getSettings().workerThreads,
+          &WorkspaceSettingsItem::edited, this, [this]() {
+            Concurrency::setMaxThreadCount(
+                mWorkspace.getSettings().workerThreads.get());
+          });
+
   // initialize status bar
   mUi->statusBar->setFields(StatusBar::ProgressBar);
   mUi->statusBar->setPermanentMessage(
@@ -195,8 +207,12 @@ ControlPanel::ControlPanel(Workspace& workspace, bool fileFormatIsOutdated)
   // To allow opening files by the MacOS Finder, install event filter.
   qApp->installEventFilter(this);
 
-  // start scanning the workspace library (asynchronously)
-  mWorkspace.getLibraryDb().startLibraryRescan();
+  // Start scanning the workspace library (asynchronously). This is deferred
+  // until the event loop is running to not delay showing the control panel.
+  // Afterwards, rescan automatically when the libraries are modified.
+  QTimer::singleShot(0, &mWorkspace.getLibraryDb(),
+                     &WorkspaceLibraryDb::startLibraryRescan);
+  mWorkspace.getLibraryDb().setWatchingEnabled(true);
 }
 
 ControlPanel::~ControlPanel() noexcept {
@@ -208,6 +224,12 @@ ControlPanel::~ControlPanel() noexcept {
 }
 
 void ControlPanel::closeEvent(QCloseEvent* event) {
+  // don't close while a project is being opened, see openProject()
+  if (mOpeningProject) {
+    event->ignore();
+    return;
+  }
+
   // close all projects, unsaved projects will ask for saving
   if (!closeAllProjects(true)) {
     event->ignore();
@@ -461,11 +483,38 @@ void ControlPanel::switchWorkspace() noexcept {
 
 void ControlPanel::showProjectReadmeInBrowser(
     const FilePath& projectFilePath) noexcept {
+  mReadmeProjectPath = projectFilePath;
   if (projectFilePath.isValid()) {
-    FilePath readmeFilePath = projectFilePath.getPathTo("README.md");
+    // Show the cached content immediately (if any), the file is then loaded
+    // in a worker thread to update the content in case it was modified.
     mUi->textBrowser->setSearchPaths(QStringList(projectFilePath.toStr()));
-    mUi->textBrowser->setHtml(
-        MarkdownConverter::convertMarkdownToHtml(readmeFilePath));
+    mUi->textBrowser->setHtml(mReadmeHtmlCache.value(projectFilePath));
+    const FilePath readmeFilePath = projectFilePath.getPathTo("README.md");
+    const FilePath thumbnailFilePath =
+        mWorkspace.getProjectThumbnailFilePath(projectFilePath);
+    QFutureWatcher<QString>* watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this,
+            [this, watcher, projectFilePath]() {
+              const QString html = watcher->result();
+              watcher->deleteLater();
+              const bool modified =
+                  (html != mReadmeHtmlCache.value(projectFilePath));
+              mReadmeHtmlCache.insert(projectFilePath, html);
+              if ((projectFilePath == mReadmeProjectPath) && modified) {
+                mUi->textBrowser->setHtml(html);
+              }
+            });
+    watcher->setFuture(QtConcurrent::run([readmeFilePath,
+                                          thumbnailFilePath]() {
+      QString html;
+      if (thumbnailFilePath.isExistingFile()) {
+        html += QString("<p><img src=\"%1\"/></p>")
+                    .arg(QUrl::fromLocalFile(thumbnailFilePath.toStr())
+                             .toString()
+                             .toHtmlEscaped());
+      }
+      return html + MarkdownConverter::convertMarkdownToHtml(readmeFilePath);
+    }));
   } else {
     mUi->textBrowser->clear();
   }
@@ -524,6 +573,18 @@ ProjectEditor* ControlPanel::newProject(bool eagleImport,
 }
 
 ProjectEditor* ControlPanel::openProject(FilePath filepath) noexcept {
+  // The progress dialog below processes events while the project is being
+  // loaded, so this method could be called again e.g. by other windows or
+  // the operating system. Opening several projects at the same time is not
+  // supported, so ignore such requests.
+  if (mOpeningProject) {
+    qWarning() << "Ignoring request to open a project while another project "
+                  "is being opened.";
+    return nullptr;
+  }
+  mOpeningProject = true;
+  auto openingScopeGuard = scopeGuard([this]() { mOpeningProject = false; });
+
   if (!filepath.isValid()) {
     QSettings settings;  // client settings
     QString lastOpenedFile = settings
@@ -565,11 +626,24 @@ ProjectEditor* ControlPanel::openProject(FilePath filepath) noexcept {
             filepath.getParentDir(), &askForRestoringBackup,
             DirectoryLockHandlerDialog::createDirectoryLockCallback());
       }
+      // Show the progress of opening large projects, which also allows to
+      // cancel it.
       ProjectLoader loader;
+      QProgressDialog progress(tr("Open project..."), tr("Cancel"), 0, 100,
+                               this);
+      progress.setWindowModality(Qt::WindowModal);
+      progress.setMinimumDuration(500);
+      connect(&loader, &ProjectLoader::progressStatus, &progress,
+              &QProgressDialog::setLabelText);
+      connect(&loader, &ProjectLoader::progressPercent, &progress,
+              &QProgressDialog::setValue);
+      connect(&progress, &QProgressDialog::canceled, &loader,
+              &ProjectLoader::cancel);
       std::unique_ptr<Project> project =
           loader.open(std::unique_ptr<TransactionalDirectory>(
                           new TransactionalDirectory(fs)),
                       projectFileName);  // can throw
+      progress.close();
       editor = new ProjectEditor(mWorkspace, *project.release(),
                                  loader.getUpgradeMessages());
       connect(editor, &ProjectEditor::projectEditorClosed, this,
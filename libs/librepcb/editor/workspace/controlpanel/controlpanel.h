@@ -212,6 +212,12 @@ private:
   QHash<QString, ProjectEditor*> mOpenProjectEditors;
   QHash<FilePath, LibraryEditor*> mOpenLibraryEditors;
   QScopedPointer<ProjectLibraryUpdater> mProjectLibraryUpdater;
+  bool mOpeningProject;  ///< Whether #openProject() is currently running
+
+  // README files are loaded in a worker thread and cached to keep the UI
+  // responsive on slow (e.g. network) file systems.
+  FilePath mReadmeProjectPath;  ///< Project of the currently shown README
+  QHash<FilePath, QString> mReadmeHtmlCache;  ///< Key: Project directory
 
   // Actions
   QScopedPointer<QAction> mActionLibraryManager;
@@ -117,7 +117,9 @@ void AddLibraryWidget::updateOnlineLibraryList() noexcept {
   foreach (const QUrl& url, mWorkspace.getSettings().apiEndpoints.get()) {
     std::shared_ptr<ApiEndpoint> repo = std::make_shared<ApiEndpoint>(url);
     connect(repo.get(), &ApiEndpoint::libraryListReceived, this,
-            &AddLibraryWidget::onlineLibraryListReceived);
+            [this, url](const QJsonArray& libs) {
+              onlineLibraryListReceived(url, libs);
+            });
     connect(repo.get(), &ApiEndpoint::errorWhileFetchingLibraryList, this,
             &AddLibraryWidget::errorWhileFetchingLibraryList);
 
@@ -380,11 +382,40 @@ void AddLibraryWidget::downloadZipFinished(bool success,
 }
 
 void AddLibraryWidget::onlineLibraryListReceived(
-    const QJsonArray& libs) noexcept {
+    const QUrl& apiEndpoint, const QJsonArray& libs) noexcept {
+  // The list replaces any list previously received from the same endpoint
+  // (e.g. the cached list), but keep the check state of the libraries. If
+  // libraries are being downloaded already, keep the current list to not
+  // abort the downloads.
+  QList<QListWidgetItem*> oldItems;
+  QHash<Uuid, bool> checkedLibs;
+  for (int i = 0; i < mUi->lstOnlineLibraries->count(); i++) {
+    QListWidgetItem* item = mUi->lstOnlineLibraries->item(i);
+    Q_ASSERT(item);
+    if (item->data(Qt::UserRole).toUrl() == apiEndpoint) {
+      auto* widget = dynamic_cast<OnlineLibraryListWidgetItem*>(
+          mUi->lstOnlineLibraries->itemWidget(item));
+      if (widget && widget->isDownloading()) {
+        qDebug() << "Not updating library list while downloading libraries.";
+        return;
+      }
+      if (widget && widget->getUuid()) {
+        checkedLibs.insert(*widget->getUuid(), widget->isChecked());
+      }
+      oldItems.append(item);
+    }
+  }
+  foreach (QListWidgetItem* item, oldItems) {
+    delete mUi->lstOnlineLibraries->itemWidget(item);
+    delete item;
+  }
+
   foreach (const QJsonValue& libVal, libs) {
     OnlineLibraryListWidgetItem* widget =
         new OnlineLibraryListWidgetItem(mWorkspace, libVal.toObject());
-    if (mManualCheckStateForAllRemoteLibraries) {
+    if (widget->getUuid() && checkedLibs.contains(*widget->getUuid())) {
+      widget->setChecked(checkedLibs.value(*widget->getUuid()));
+    } else if (mManualCheckStateForAllRemoteLibraries) {
       widget->setChecked(mUi->cbxOnlineLibrariesSelectAll->isChecked());
     }
     connect(mUi->cbxOnlineLibrariesSelectAll, &QCheckBox::clicked, widget,
@@ -392,6 +423,7 @@ void AddLibraryWidget::onlineLibraryListReceived(
     connect(widget, &OnlineLibraryListWidgetItem::checkedChanged, this,
             &AddLibraryWidget::repoLibraryDownloadCheckedChanged);
     QListWidgetItem* item = new QListWidgetItem(mUi->lstOnlineLibraries);
+    item->setData(Qt::UserRole, apiEndpoint);
     // Set item text to make searching by keyboard working (type to find
     // library). However, the text would mess up the look, thus it is made
     // hidden with a stylesheet set in the constructor (see above).
@@ -78,7 +78,8 @@ private:  // Methods
   void createLocalLibraryButtonClicked() noexcept;
   void downloadZippedLibraryButtonClicked() noexcept;
   void downloadZipFinished(bool success, const QString& errMsg) noexcept;
-  void onlineLibraryListReceived(const QJsonArray& libs) noexcept;
+  void onlineLibraryListReceived(const QUrl& apiEndpoint,
+                                 const QJsonArray& libs) noexcept;
   void errorWhileFetchingLibraryList(const QString& errorMsg) noexcept;
   void clearOnlineLibraryList() noexcept;
   void repoLibraryDownloadCheckedChanged(bool checked) noexcept;
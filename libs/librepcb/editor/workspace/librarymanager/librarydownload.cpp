@@ -171,6 +171,13 @@ void LibraryDownload::downloadSucceeded() noexcept {
     return;
   }
 
+  // take over unchanged elements from the backup to keep their modification
+  // times, thus avoiding a time consuming rescan of them
+  if (backupDir.isExistingDir()) {
+    const int count = reuseUnchangedElements(libDir, backupDir);
+    qInfo() << "Kept" << count << "unchanged elements of updated library.";
+  }
+
   // move downloaded directory to destination
   try {
     FileUtils::move(libDir, mDestDir);  // can throw
@@ -214,6 +221,65 @@ FilePath LibraryDownload::getPathToLibDir() noexcept {
   }
 }
 
+int LibraryDownload::reuseUnchangedElements(
+    const FilePath& newLibDir, const FilePath& oldLibDir) noexcept {
+  // Note: The element directories are swapped rather than moved to keep the
+  // backup complete, so it can still be restored if anything fails.
+  int count = 0;
+  const QDir::Filters filter = QDir::Dirs | QDir::NoDotAndDotDot;
+  foreach (const QString& type, QDir(newLibDir.toStr()).entryList(filter)) {
+    const FilePath newTypeDir = newLibDir.getPathTo(type);
+    foreach (const QString& name, QDir(newTypeDir.toStr()).entryList(filter)) {
+      const FilePath newDir = newTypeDir.getPathTo(name);
+      const FilePath oldDir = oldLibDir.getPathTo(type % "/" % name);
+      if ((!oldDir.isExistingDir()) || (!haveSameContent(newDir, oldDir))) {
+        continue;
+      }
+      const FilePath tmpDir(oldDir.toStr() % ".tmp");
+      try {
+        FileUtils::move(oldDir, tmpDir);  // can throw
+        try {
+          FileUtils::move(newDir, oldDir);  // can throw
+        } catch (...) {
+          FileUtils::move(tmpDir, oldDir);  // can throw
+          throw;
+        }
+        FileUtils::move(tmpDir, newDir);  // can throw
+        ++count;
+      } catch (const Exception& e) {
+        qWarning() << "Failed to keep unchanged library element:"
+                   << e.getMsg();
+      }
+    }
+  }
+  return count;
+}
+
+bool LibraryDownload::haveSameContent(const FilePath& dir1,
+                                      const FilePath& dir2) noexcept {
+  try {
+    QList<FilePath> files1 =
+        FileUtils::getFilesInDirectory(dir1, {}, true, false);  // can throw
+    QList<FilePath> files2 =
+        FileUtils::getFilesInDirectory(dir2, {}, true, false);  // can throw
+    if (files1.count() != files2.count()) {
+      return false;
+    }
+    foreach (const FilePath& fp1, files1) {
+      const FilePath fp2 = dir2.getPathTo(fp1.toRelative(dir1));
+      if ((QFileInfo(fp1.toStr()).size() != QFileInfo(fp2.toStr()).size()) ||
+          (FileUtils::readFile(fp1) !=
+           FileUtils::readFile(fp2))) {  // can throw
+        return false;
+      }
+    }
+    return true;
+  } catch (const Exception&) {
+    // Missing file or I/O error, just treat the directories as different.
+    return false;
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
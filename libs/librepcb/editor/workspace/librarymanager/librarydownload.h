@@ -42,6 +42,13 @@ namespace editor {
 
 /**
  * @brief The LibraryDownload class
+ *
+ * Downloads a library ZIP file, extracts it and replaces the library in the
+ * destination directory (if any). When updating an existing library, all
+ * element directories with unchanged content are taken over from the old
+ * library instead of the extracted ones. As they keep their file modification
+ * times, the library scanner skips them without reading any file, so only the
+ * actually modified elements are parsed again.
  */
 class LibraryDownload final : public QObject {
   Q_OBJECT
@@ -96,6 +103,10 @@ private:  // Methods
   void downloadAborted() noexcept;
   void downloadSucceeded() noexcept;
   FilePath getPathToLibDir() noexcept;
+  static int reuseUnchangedElements(const FilePath& newLibDir,
+                                    const FilePath& oldLibDir) noexcept;
+  static bool haveSameContent(const FilePath& dir1,
+                              const FilePath& dir2) noexcept;
 
 private:  // Data
   QScopedPointer<FileDownload> mFileDownload;
@@ -68,6 +68,7 @@ public:
   const QString& getName() const noexcept { return mName; }
   const QSet<Uuid>& getDependencies() const noexcept { return mDependencies; }
   bool isChecked() const noexcept;
+  bool isDownloading() const noexcept { return !mLibraryDownload.isNull(); }
 
   // Setters
   void setChecked(bool checked) noexcept;
@@ -27,6 +27,7 @@
 #include "ui_projectlibraryupdater.h"
 
 #include <librepcb/core/application.h>
+#include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/fileio/versionfile.h>
 #include <librepcb/core/library/cmp/component.h>
@@ -40,6 +41,7 @@
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -79,6 +81,14 @@ void ProjectLibraryUpdater::btnUpdateClicked() {
   setEnabled(false);
   mUi->log->clear();
 
+  // If nothing needs to be updated, there is no need to close the project.
+  log(tr("Search for modified library elements..."));
+  if (findModifiedElements().isEmpty()) {
+    log(tr("[SUCCESS] All library elements are up to date."));
+    setEnabled(true);
+    return;
+  }
+
   // close project if it is currently open
   bool abort = false;
   ProjectEditor* editor = mControlPanel.getOpenProject(mProjectFilePath);
@@ -119,11 +129,17 @@ void ProjectLibraryUpdater::btnUpdateClicked() {
                "be updated."));
       }
 
-      // update all elements
-      updateElements<Component>(fs, "cmp");
-      updateElements<Device>(fs, "dev");
-      updateElements<Package>(fs, "pkg");
-      updateElements<Symbol>(fs, "sym");
+      // update all modified elements (search again since the project might
+      // have been saved when closing it)
+      foreach (const Element& element, findModifiedElements()) {
+        log(tr("Update %1...").arg(element.path));
+        std::shared_ptr<TransactionalFileSystem> srcFs =
+            TransactionalFileSystem::openRO(element.source);  // can throw
+        TransactionalDirectory srcDir(srcFs);
+        TransactionalDirectory dstDir(fs, element.path);
+        fs->removeDirRecursively(element.path);  // can throw
+        srcDir.saveTo(dstDir);  // can throw
+      }
 
       // check whether project can still be opened of if we broke something
       try {
@@ -173,27 +189,61 @@ QString ProjectLibraryUpdater::prettyPath(const FilePath& fp) const noexcept {
   return fp.toRelative(mProjectFilePath.getParentDir());
 }
 
+QList<ProjectLibraryUpdater::Element>
+    ProjectLibraryUpdater::findModifiedElements() const {
+  QList<Element> elements;
+  findElements<Component>("cmp", elements);
+  findElements<Device>("dev", elements);
+  findElements<Package>("pkg", elements);
+  findElements<Symbol>("sym", elements);
+  const QList<bool> modified = QtConcurrent::blockingMapped<QList<bool>>(
+      elements, &ProjectLibraryUpdater::isModified);
+  QList<Element> result;
+  for (int i = 0; i < elements.count(); ++i) {
+    if (modified.at(i)) {
+      result.append(elements.at(i));
+    }
+  }
+  return result;
+}
+
 template <typename T>
-void ProjectLibraryUpdater::updateElements(
-    std::shared_ptr<TransactionalFileSystem> fs, const QString& type) {
-  QString dirpath = "library/" % type;
-  foreach (const QString& dirname, fs->getDirs(dirpath)) {
+void ProjectLibraryUpdater::findElements(const QString& type,
+                                         QList<Element>& elements) const {
+  const QString dirpath = "library/" % type;
+  const FilePath dir = mProjectFilePath.getParentDir().getPathTo(dirpath);
+  foreach (const QString& dirname,
+           QDir(dir.toStr()).entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
     tl::optional<Uuid> uuid = Uuid::tryFromString(dirname);
     FilePath src =
         uuid ? mWorkspace.getLibraryDb().getLatest<T>(*uuid) : FilePath();
-    QString dst = dirpath % "/" % dirname;
-    TransactionalDirectory dstDir(fs, dst);
-    if (src.isValid() && (!dstDir.getFiles().isEmpty())) {
-      log(tr("Update %1...").arg(dst));
-      std::shared_ptr<TransactionalFileSystem> srcFs =
-          TransactionalFileSystem::openRO(src);
-      TransactionalDirectory srcDir(srcFs);
-      fs->removeDirRecursively(dst);
-      srcDir.saveTo(dstDir);
-    } else {
-      log(tr("Skip %1...").arg(dst));
+    const FilePath dst = dir.getPathTo(dirname);
+    const QDir::Filters filter = QDir::Files | QDir::Hidden;
+    if (src.isValid() && (!QDir(dst.toStr()).entryList(filter).isEmpty())) {
+      elements.append(Element{dirpath % "/" % dirname, src, dst});
+    }
+  }
+}
+
+bool ProjectLibraryUpdater::isModified(const Element& element) noexcept {
+  return readElementFiles(element.source) !=
+      readElementFiles(element.destination);
+}
+
+QHash<QString, QByteArray> ProjectLibraryUpdater::readElementFiles(
+    const FilePath& dir) noexcept {
+  QHash<QString, QByteArray> files;
+  try {
+    foreach (const FilePath& fp,
+             FileUtils::getFilesInDirectory(dir, {}, true)) {  // can throw
+      if (fp.getFilename() != ".lock") {
+        files.insert(fp.toRelative(dir), FileUtils::readFile(fp));  // can throw
+      }
     }
+  } catch (const Exception& e) {
+    qWarning() << "Failed to read library element:" << e.getMsg();
   }
+  return files;
 }
 
 /*******************************************************************************
@@ -70,14 +70,33 @@ public:
 private slots:
   void btnUpdateClicked();
 
-private:
+private:  // Types
+  struct Element {
+    QString path;  ///< Relative path within the project directory
+    FilePath source;  ///< Element directory in the workspace library
+    FilePath destination;  ///< Element directory in the project library
+  };
+
+private:  // Methods
   void log(const QString& msg) noexcept;
   QString prettyPath(const FilePath& fp) const noexcept;
+
+  /**
+   * @brief Find all project library elements which differ from the workspace
+   *
+   * The element directories are compared in worker threads, directly on the
+   * file system of the project (i.e. without unsaved modifications).
+   *
+   * @return  All elements which need to be updated.
+   */
+  QList<Element> findModifiedElements() const;
   template <typename T>
-  void updateElements(std::shared_ptr<TransactionalFileSystem> fs,
-                      const QString& type);
+  void findElements(const QString& type, QList<Element>& elements) const;
+  static bool isModified(const Element& element) noexcept;
+  static QHash<QString, QByteArray> readElementFiles(
+      const FilePath& dir) noexcept;
 
-private:
+private:  // Data
   Workspace& mWorkspace;
   FilePath mProjectFilePath;
   ControlPanel& mControlPanel;
@@ -665,9 +665,19 @@ void WorkspaceSettingsDialog::loadSettings() noexcept {
   mUi->spbAutosaveInterval->setValue(
       mSettings.projectAutosaveIntervalSeconds.get());
 
+  // Undo Limit
+  mUi->spbUndoLimit->setValue(mSettings.undoLimit.get());
+
+  // Worker Threads
+  mUi->spbWorkerThreads->setValue(mSettings.workerThreads.get());
+
   // Use OpenGL
   mUi->cbxUseOpenGl->setChecked(mSettings.useOpenGl.get());
 
+  // Show Render Statistics
+  mUi->cbxShowRenderStatistics->setChecked(
+      mSettings.showRenderStatistics.get());
+
   // Library Locale Order
   mLibLocaleOrderModel->setValues(mSettings.libraryLocaleOrder.get());
 
@@ -714,9 +724,19 @@ void WorkspaceSettingsDialog::saveSettings() noexcept {
     mSettings.projectAutosaveIntervalSeconds.set(
         mUi->spbAutosaveInterval->value());
 
+    // Undo Limit
+    mSettings.undoLimit.set(mUi->spbUndoLimit->value());
+
+    // Worker Threads
+    mSettings.workerThreads.set(mUi->spbWorkerThreads->value());
+
     // Use OpenGL
     mSettings.useOpenGl.set(mUi->cbxUseOpenGl->isChecked());
 
+    // Show Render Statistics
+    mSettings.showRenderStatistics.set(
+        mUi->cbxShowRenderStatistics->isChecked());
+
     // Library Locale Order
     mSettings.libraryLocaleOrder.set(mLibLocaleOrderModel->getValues());
 
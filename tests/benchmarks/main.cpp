@@ -0,0 +1,427 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/core/algorithm/airwiresbuilder.h>
+#include <librepcb/core/application.h>
+#include <librepcb/core/debug.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/export/gerbergenerator.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/cat/componentcategory.h>
+#include <librepcb/core/library/cat/packagecategory.h>
+#include <librepcb/core/library/cmp/component.h>
+#include <librepcb/core/library/dev/device.h>
+#include <librepcb/core/library/library.h>
+#include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardnetsegmentsplitter.h>
+#include <librepcb/core/project/board/boardfabricationoutputsettings.h>
+#include <librepcb/core/project/board/boardgerberexport.h>
+#include <librepcb/core/project/board/boardplanefragmentsbuilder.h>
+#include <librepcb/core/project/board/drc/boarddesignrulecheck.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/serialization/sexpression.h>
+#include <librepcb/core/types/layer.h>
+#include <librepcb/core/utils/clipperhelpers.h>
+
+#include <QtCore>
+#include <QtGui>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+using namespace librepcb;
+
+/*******************************************************************************
+ *  Benchmark Helpers
+ ******************************************************************************/
+
+/**
+ * @brief Runs benchmarks and collects their timings as JSON
+ */
+class BenchmarkRunner final {
+public:
+  BenchmarkRunner(int iterations, int size) noexcept
+    : mIterations(iterations), mSize(size), mSuccess(true) {}
+
+  /**
+   * @brief Run a benchmark
+   *
+   * @param name    Unique name of the benchmark.
+   * @param setup   Prepares the fixture, executed before every iteration
+   *                without being measured.
+   * @param run     The measured code.
+   */
+  void run(const QString& name, std::function<void()> setup,
+           std::function<void()> run) noexcept {
+    QVector<qint64> timings;
+    try {
+      for (int i = 0; i < mIterations; ++i) {
+        setup();  // can throw
+        QElapsedTimer timer;
+        timer.start();
+        run();  // can throw
+        timings.append(timer.nsecsElapsed());
+      }
+    } catch (const Exception& e) {
+      qCritical().noquote() << "Benchmark" << name << "failed:" << e.getMsg();
+      mSuccess = false;
+      return;
+    }
+    std::sort(timings.begin(), timings.end());
+    const qint64 sum = std::accumulate(timings.begin(), timings.end(), 0LL);
+    QJsonObject result;
+    result["name"] = name;
+    result["size"] = mSize;
+    result["iterations"] = mIterations;
+    result["min_ms"] = timings.first() / 1e6;
+    result["median_ms"] = timings.at(timings.count() / 2) / 1e6;
+    result["mean_ms"] = (sum / timings.count()) / 1e6;
+    result["max_ms"] = timings.last() / 1e6;
+    mResults.append(result);
+  }
+
+  QJsonDocument getResults() const noexcept {
+    QJsonObject root;
+    root["version"] = Application::getVersion();
+    root["git_revision"] = Application::getGitRevision();
+    root["benchmarks"] = mResults;
+    return QJsonDocument(root);
+  }
+
+  bool isSuccessful() const noexcept { return mSuccess; }
+
+private:
+  const int mIterations;
+  const int mSize;
+  QJsonArray mResults;
+  bool mSuccess;
+};
+
+/*******************************************************************************
+ *  Synthetic Fixtures
+ ******************************************************************************/
+
+/**
+ * @brief Generate an S-Expression document similar to a board file
+ *
+ * @param traces  Number of traces to generate.
+ *
+ * @return The generated S-Expression document.
+ */
+static QByteArray generateSExpression(int traces) noexcept {
+  QByteArray content = "(librepcb_board 00000000-0000-4000-8000-000000000000";
+  for (int i = 0; i < traces; ++i) {
+    content += QString(
+                   "\n (trace %1 (layer top_cu) (width 0.25)"
+                   "\n  (from (junction %2)) (to (via %3))"
+                   "\n  (name \"Trace %1 \\\"quoted\\\"\") (lock false)"
+                   "\n  (position %4 %5) (rotation 45.0)"
+                   "\n )")
+                   .arg(i)
+                   .arg(i * 2)
+                   .arg(i * 2 + 1)
+                   .arg((i % 100) * 2.54)
+                   .arg((i / 100) * 2.54)
+                   .toUtf8();
+  }
+  content += "\n)\n";
+  return content;
+}
+
+/**
+ * @brief Generate reproducible, pseudo-random points on a board
+ *
+ * @param count   Number of points to generate.
+ *
+ * @return The generated points.
+ */
+static QVector<Point> generatePoints(int count) noexcept {
+  std::mt19937 generator(42);  // Fixed seed for reproducibility.
+  std::uniform_int_distribution<int> distribution(0, 100000000);
+  QVector<Point> points;
+  for (int i = 0; i < count; ++i) {
+    points.append(Point(distribution(generator), distribution(generator)));
+  }
+  return points;
+}
+
+/*******************************************************************************
+ *  Benchmarks
+ ******************************************************************************/
+
+static void runSyntheticBenchmarks(BenchmarkRunner& runner, int size) {
+  // S-Expression parse & serialize
+  const QByteArray content = generateSExpression(size);
+  SExpression root;
+  runner.run(
+      "sexpression_parse", []() {},
+      [&]() { root = SExpression::parse(content, FilePath()); });
+  runner.run(
+      "sexpression_serialize", []() {}, [&]() { root.toByteArray(); });
+
+  // Airwires
+  const QVector<Point> points = generatePoints(size);
+  std::unique_ptr<AirWiresBuilder> builder;
+  runner.run(
+      "airwires",
+      [&]() {
+        builder.reset(new AirWiresBuilder());
+        int previousId = -1;
+        for (int i = 0; i < points.count(); ++i) {
+          const int id = builder->addPoint(points.at(i));
+          if ((i % 3) == 2) {
+            builder->addEdge(previousId, id);  // Some already connected points.
+          }
+          previousId = id;
+        }
+      },
+      [&]() { builder->buildAirWires(); });
+
+  // Net segment splitting (one long chain of traces, in reversed order)
+  QVector<Junction> junctions;
+  for (const Point& pos : points) {
+    junctions.append(Junction(Uuid::createRandom(), pos));
+  }
+  std::unique_ptr<BoardNetSegmentSplitter> splitter;
+  runner.run(
+      "netsegment_split",
+      [&]() {
+        splitter.reset(new BoardNetSegmentSplitter());
+        for (const Junction& junction : junctions) {
+          splitter->addJunction(junction);
+        }
+        for (int i = junctions.count() - 1; i > 0; --i) {
+          splitter->addTrace(Trace(
+              Uuid::createRandom(), Layer::topCopper(), PositiveLength(250000),
+              TraceAnchor::junction(junctions.at(i).getUuid()),
+              TraceAnchor::junction(junctions.at(i - 1).getUuid())));
+        }
+      },
+      [&]() { splitter->split(); });
+
+  // Geometry kernels (pads as circles, traces as obrounds)
+  ClipperLib::Paths pads, traces, paths;
+  for (int i = 1; i < points.count(); ++i) {
+    pads.push_back(ClipperHelpers::convert(
+        Path::circle(PositiveLength(600000)).translated(points.at(i)),
+        PositiveLength(5000)));
+    traces.push_back(ClipperHelpers::convert(
+        Path::obround(points.at(i - 1), points.at(i), PositiveLength(250000)),
+        PositiveLength(5000)));
+  }
+  runner.run(
+      "clipper_offset", [&]() { paths = pads; },
+      [&]() {
+        ClipperHelpers::offset(paths, Length(200000),
+                               PositiveLength(5000));  // can throw
+      });
+  runner.run(
+      "clipper_unite", [&]() { paths = traces; },
+      [&]() {
+        ClipperHelpers::unite(paths, pads, ClipperLib::pftNonZero,
+                              ClipperLib::pftNonZero);  // can throw
+      });
+  runner.run(
+      "clipper_intersect_pairs", []() {},
+      [&]() {
+        for (std::size_t i = 0; i < pads.size(); ++i) {
+          ClipperHelpers::intersectToTree(
+              {pads.at(i)}, {traces.at(i)}, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);  // can throw
+          ClipperHelpers::intersectToTree(
+              {pads.at(i)}, {traces.at((i * 7919) % traces.size())},
+              ClipperLib::pftNonZero, ClipperLib::pftNonZero);  // can throw
+        }
+      });
+
+  // Gerber generator
+  runner.run(
+      "gerber_generate", []() {},
+      [&]() {
+        GerberGenerator gen(QDateTime(QDate(2000, 1, 1), QTime(0, 0)),
+                            "Benchmark",
+                            Uuid::fromString(
+                                "00000000-0000-4000-8000-000000000000"),
+                            "rev-1");
+        for (int i = 1; i < points.count(); ++i) {
+          gen.drawLine(points.at(i - 1), points.at(i), UnsignedLength(250000),
+                       tl::nullopt, QString("Net%1").arg(i % 50), QString());
+          gen.flashCircle(points.at(i), PositiveLength(600000), tl::nullopt,
+                          QString("Net%1").arg(i % 50), QString(), QString(),
+                          QString());
+        }
+        gen.generate();
+      });
+}
+
+static void runProjectBenchmarks(BenchmarkRunner& runner,
+                                 const FilePath& projectFp) {
+  std::shared_ptr<TransactionalFileSystem> fs;
+  std::unique_ptr<Project> project;
+  auto openFs = [&]() {
+    project.reset();
+    fs = TransactionalFileSystem::openRO(projectFp.getParentDir());
+  };
+  auto openProject = [&]() {
+    ProjectLoader loader;
+    project = loader.open(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(fs)),
+        projectFp.getFilename());  // can throw
+  };
+  auto reopenProject = [&]() {
+    if (!project) {
+      openFs();  // can throw
+      openProject();  // can throw
+    }
+  };
+
+  // Project load
+  runner.run("project_load", openFs, openProject);
+
+  // Plane build
+  runner.run("board_planes", reopenProject, [&]() {
+    foreach (Board* board, project->getBoards()) {
+      BoardPlaneFragmentsBuilder builder;
+      builder.runSynchronously(*board);  // can throw
+    }
+  });
+
+  // DRC
+  runner.run("board_drc", reopenProject, [&]() {
+    foreach (Board* board, project->getBoards()) {
+      BoardDesignRuleCheck drc(*board, board->getDrcSettings());
+      drc.execute(false);
+    }
+  });
+
+  // Gerber export (into a temporary directory)
+  QTemporaryDir outDir;
+  runner.run("board_gerber_export", reopenProject, [&]() {
+    foreach (const Board* board, project->getBoards()) {
+      BoardFabricationOutputSettings settings =
+          board->getFabricationOutputSettings();
+      settings.setOutputBasePath(
+          QDir(outDir.path()).filePath("{{BOARD}}/{{PROJECT}}"));
+      BoardGerberExport grbExport(*board);
+      grbExport.exportPcbLayers(settings);  // can throw
+    }
+  });
+}
+
+template <typename T>
+static void openLibraryElements(const FilePath& libFp, const Library& lib) {
+  foreach (const QString& dir, lib.searchForElements<T>()) {
+    T::open(std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+        TransactionalFileSystem::openRO(libFp.getPathTo(dir)))));  // can throw
+  }
+}
+
+static void runLibraryBenchmarks(BenchmarkRunner& runner,
+                                 const FilePath& libFp) {
+  runner.run(
+      "library_scan", []() {},
+      [&]() {
+        std::unique_ptr<Library> lib =
+            Library::open(std::unique_ptr<TransactionalDirectory>(
+                new TransactionalDirectory(
+                    TransactionalFileSystem::openRO(libFp))));  // can throw
+        openLibraryElements<ComponentCategory>(libFp, *lib);  // can throw
+        openLibraryElements<PackageCategory>(libFp, *lib);  // can throw
+        openLibraryElements<Symbol>(libFp, *lib);  // can throw
+        openLibraryElements<Package>(libFp, *lib);  // can throw
+        openLibraryElements<Component>(libFp, *lib);  // can throw
+        openLibraryElements<Device>(libFp, *lib);  // can throw
+      });
+}
+
+/*******************************************************************************
+ *  The Benchmark Program
+ ******************************************************************************/
+
+int main(int argc, char* argv[]) {
+  Debug::instance();
+  Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::Critical);
+
+  QGuiApplication app(argc, argv);
+  QGuiApplication::setOrganizationName("LibrePCB");
+  QGuiApplication::setOrganizationDomain("librepcb.org");
+  QGuiApplication::setApplicationName("LibrePCB-Benchmarks");
+  Application::loadBundledFonts();
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Runs performance benchmarks and prints the results as JSON.");
+  parser.addHelpOption();
+  QCommandLineOption iterationsOption("iterations",
+                                      "Number of iterations per benchmark.",
+                                      "count", "5");
+  parser.addOption(iterationsOption);
+  QCommandLineOption sizeOption(
+      "size", "Number of items in the synthetic fixtures.", "count", "10000");
+  parser.addOption(sizeOption);
+  QCommandLineOption projectOption(
+      "project", "Project (*.lpp) to run the project benchmarks with.", "file");
+  parser.addOption(projectOption);
+  QCommandLineOption libraryOption(
+      "library", "Library (*.lplib) to run the library benchmarks with.",
+      "dir");
+  parser.addOption(libraryOption);
+  QCommandLineOption outputOption(
+      "output", "Write the results to this file instead of stdout.", "file");
+  parser.addOption(outputOption);
+  parser.process(app);
+
+  const int iterations = std::max(parser.value(iterationsOption).toInt(), 1);
+  const int size = std::max(parser.value(sizeOption).toInt(), 1);
+  BenchmarkRunner runner(iterations, size);
+  runSyntheticBenchmarks(runner, size);
+  if (parser.isSet(projectOption)) {
+    runProjectBenchmarks(
+        runner,
+        FilePath(QFileInfo(parser.value(projectOption)).absoluteFilePath()));
+  }
+  if (parser.isSet(libraryOption)) {
+    runLibraryBenchmarks(
+        runner,
+        FilePath(QFileInfo(parser.value(libraryOption)).absoluteFilePath()));
+  }
+
+  const QByteArray json = runner.getResults().toJson();
+  if (parser.isSet(outputOption)) {
+    QFile file(parser.value(outputOption));
+    if (!file.open(QIODevice::WriteOnly) || (file.write(json) != json.size())) {
+      qCritical().noquote() << "Failed to write" << file.fileName();
+      return 1;
+    }
+  } else {
+    QTextStream(stdout) << json;
+  }
+  return runner.isSuccessful() ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import json
+
+"""
+Test command "batch"
+"""
+
+HELP_TEXT = """\
+Usage: {executable} [options] batch [command_options] file
+LibrePCB Command Line Interface
+
+Options:
+  -h, --help      Print this message.
+  -V, --version   Displays version information.
+  -v, --verbose   Verbose output.
+  --trace <file>  Write a timing trace of expensive operations to this file, in
+                  the Chrome trace JSON format (e.g. for Perfetto).
+  --jobs <count>  Maximum number of threads used by each parallelized operation
+                  (default: number of CPU cores). Nested operations may use
+                  additional threads.
+
+Arguments:
+  batch           Execute multiple commands from a file in a single process.
+  file            Path to a JSON file containing an array of commands, each
+                  given as an array of command line arguments. Use '-' to read
+                  from stdin.
+"""
+
+
+def write_batch_file(cli, commands):
+    fp = cli.abspath('batch.json')
+    with open(fp, 'w') as f:
+        json.dump(commands, f)
+    return fp
+
+
+def test_help(cli):
+    code, stdout, stderr = cli.run('batch', '--help')
+    assert stderr == ''
+    assert stdout == HELP_TEXT.format(executable=cli.executable)
+    assert code == 0
+
+
+def test_multiple_commands(cli):
+    cli.add_library('Empty Library.lplib')
+    fp = write_batch_file(cli, [
+        ['open-library', 'Empty Library.lplib'],
+        ['open-library', 'Empty Library.lplib', '--all'],
+    ])
+    code, stdout, stderr = cli.run('batch', fp)
+    assert stderr == ''
+    assert stdout == \
+        "Open batch file '{path}'...\n" \
+        "Execute command 1 of 2: open-library Empty Library.lplib\n" \
+        "Open library 'Empty Library.lplib'...\n" \
+        "SUCCESS\n" \
+        "Execute command 2 of 2: open-library Empty Library.lplib --all\n" \
+        "Open library 'Empty Library.lplib'...\n" \
+        "Process 0 component categories...\n" \
+        "Process 0 package categories...\n" \
+        "Process 0 symbols...\n" \
+        "Process 0 packages...\n" \
+        "Process 0 components...\n" \
+        "Process 0 devices...\n" \
+        "SUCCESS\n" \
+        "SUCCESS\n".format(path=fp)
+    assert code == 0
+
+
+def test_failing_command(cli):
+    fp = write_batch_file(cli, [
+        ['open-library', 'nonexistent.lplib'],
+    ])
+    code, stdout, stderr = cli.run('batch', fp)
+    assert len(stderr) > 0
+    assert "Execute command 1 of 1: open-library nonexistent.lplib\n" in stdout
+    assert stdout.endswith("Finished with errors!\n")
+    assert code == 1
@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import json
+
+import params
+import pytest
+
+"""
+Test command "benchmark"
+"""
+
+
+@pytest.mark.parametrize("project", [
+    params.EMPTY_PROJECT_LPP_PARAM,
+    params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM,
+])
+def test_output_and_baseline(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    output = cli.abspath('benchmark.json')
+    code, stdout, stderr = cli.run('benchmark', '--iterations=1',
+                                   '--output=' + output, project.path)
+    assert stderr == ''
+    assert code == 0
+    with open(output, 'r') as f:
+        result = json.load(f)
+    assert result['iterations'] == 1
+    for name in ['load', 'planes', 'erc', 'drc-full', 'drc-quick', 'save']:
+        assert name in result['operations']
+        assert name in stdout
+
+    # Compare with a generous threshold since timings are not deterministic.
+    code, stdout, stderr = cli.run('benchmark', '--iterations=1',
+                                   '--baseline=' + output,
+                                   '--threshold=100000', project.path)
+    assert stderr == ''
+    assert code == 0
+
+
+@pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
+def test_regression(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    baseline = cli.abspath('baseline.json')
+    with open(baseline, 'w') as f:
+        json.dump({'operations': {'load': {'median_ms': 0.001}}}, f)
+    code, stdout, stderr = cli.run('benchmark', '--iterations=1',
+                                   '--baseline=' + baseline, project.path)
+    assert 'load' in stderr
+    assert code == 1
+
+
+def test_invalid_iterations(cli):
+    code, stdout, stderr = cli.run('benchmark', '--iterations=0', 'foo.lpp')
+    assert stderr == "ERROR: Invalid number of iterations: '0'\n"
+    assert code == 1
+
+
+@pytest.mark.parametrize("content", [
+    'foo',
+    '{}',
+    '{"operations": []}',
+    '{"operations": {"load": {}}}',
+])
+def test_invalid_baseline(cli, content):
+    project = params.EMPTY_PROJECT_LPP_PARAM
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    baseline = cli.abspath('baseline.json')
+    with open(baseline, 'w') as f:
+        f.write(content)
+    code, stdout, stderr = cli.run('benchmark', '--iterations=1',
+                                   '--baseline=' + baseline, project.path)
+    assert stderr.startswith('ERROR: ')
+    assert stdout == ''
+    assert code == 1
@@ -10,25 +10,30 @@ Usage: {executable} [options] open-library [command_options] library
 LibrePCB Command Line Interface
 
 Options:
-  -h, --help     Print this message.
-  -V, --version  Displays version information.
-  -v, --verbose  Verbose output.
-  --all          Perform the selected action(s) on all elements contained in
-                 the opened library.
-  --check        Run the library element check, print all non-approved messages
-                 and report failure (exit code = 1) if there are non-approved
-                 messages.
-  --minify-step  Minify the STEP models of all packages. Only works in
-                 conjunction with '--all'. Pass '--save' to write the minified
-                 files to disk.
-  --save         Save library (and contained elements if '--all' is given)
-                 before closing them (useful to upgrade file format).
-  --strict       Fail if the opened files are not strictly canonical, i.e.
-                 there would be changes when saving the library elements.
+  -h, --help      Print this message.
+  -V, --version   Displays version information.
+  -v, --verbose   Verbose output.
+  --trace <file>  Write a timing trace of expensive operations to this file, in
+                  the Chrome trace JSON format (e.g. for Perfetto).
+  --jobs <count>  Maximum number of threads used by each parallelized operation
+                  (default: number of CPU cores). Nested operations may use
+                  additional threads.
+  --all           Perform the selected action(s) on all elements contained in
+                  the opened library.
+  --check         Run the library element check, print all non-approved
+                  messages and report failure (exit code = 1) if there are
+                  non-approved messages.
+  --minify-step   Minify the STEP models of all packages. Only works in
+                  conjunction with '--all'. Pass '--save' to write the minified
+                  files to disk.
+  --save          Save library (and contained elements if '--all' is given)
+                  before closing them (useful to upgrade file format).
+  --strict        Fail if the opened files are not strictly canonical, i.e.
+                  there would be changes when saving the library elements.
 
 Arguments:
-  open-library   Open a library to execute library-related tasks.
-  library        Path to library directory (*.lplib).
+  open-library    Open a library to execute library-related tasks.
+  library         Path to library directory (*.lplib).
 """
 
 ERROR_TEXT = """\
@@ -403,6 +403,56 @@ def test_export_with_custom_settings(cli, project):
     assert len(os.listdir(dir)) == 10
 
 
+@pytest.mark.parametrize("project", [
+    params.EMPTY_PROJECT_LPP_PARAM,
+    params.EMPTY_PROJECT_LPPZ_PARAM,
+])
+def test_export_with_multiple_custom_settings(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    settings = """
+      (fabrication_output_settings
+        (base_path "./out/{name}/")
+        (outlines (suffix "OUTLINES.gbr"))
+        (copper_top (suffix "COPPER-TOP.gbr"))
+        (copper_inner (suffix "COPPER-IN{{{{CU_LAYER}}}}.gbr"))
+        (copper_bot (suffix "COPPER-BOTTOM.gbr"))
+        (soldermask_top (suffix "SOLDERMASK-TOP.gbr"))
+        (soldermask_bot (suffix "SOLDERMASK-BOTTOM.gbr"))
+        (silkscreen_top (suffix "SILKSCREEN-TOP.gbr")
+          (layers top_placement top_names)
+        )
+        (silkscreen_bot (suffix "SILKSCREEN-BOTTOM.gbr")
+          (layers bot_placement bot_names)
+        )
+        (drills (merge {merge})
+          (suffix_pth "DRILLS-PTH.drl")
+          (suffix_npth "DRILLS-NPTH.drl")
+          (suffix_merged "DRILLS.drl")
+          (suffix_buried "_DRILLS-{{{{START_LAYER}}}}-{{{{END_LAYER}}}}.drl")
+          (g85_slots false)
+        )
+        (solderpaste_top (create false) (suffix "SOLDERPASTE-TOP.gbr"))
+        (solderpaste_bot (create false) (suffix "SOLDERPASTE-BOTTOM.gbr"))
+      )
+    """
+    with open(cli.abspath('merged.lp'), mode='w') as f:
+        f.write(settings.format(name='merged', merge='true'))
+    with open(cli.abspath('split.lp'), mode='w') as f:
+        f.write(settings.format(name='split', merge='false'))
+    out_dir = os.path.dirname(cli.abspath(project.path)) + '/out'
+    assert not os.path.exists(out_dir)
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-pcb-fabrication-data',
+                                   '--pcb-fabrication-settings=merged.lp',
+                                   '--pcb-fabrication-settings=split.lp',
+                                   project.path)
+    assert stderr == ''
+    assert stdout.count('=>') == 17
+    assert code == 0
+    assert len(os.listdir(out_dir + '/merged')) == 8
+    assert len(os.listdir(out_dir + '/split')) == 9
+
+
 @pytest.mark.parametrize("project", [
     params.EMPTY_PROJECT_LPP_PARAM,
     params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM,
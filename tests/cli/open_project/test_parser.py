@@ -15,6 +15,13 @@ Options:
   -h, --help                         Print this message.
   -V, --version                      Displays version information.
   -v, --verbose                      Verbose output.
+  --trace <file>                     Write a timing trace of expensive
+                                     operations to this file, in the Chrome
+                                     trace JSON format (e.g. for Perfetto).
+  --jobs <count>                     Maximum number of threads used by each
+                                     parallelized operation (default: number of
+                                     CPU cores). Nested operations may use
+                                     additional threads.
   --erc                              Run the electrical rule check, print all
                                      non-approved warnings/errors and report
                                      failure (exit code = 1) if there are
@@ -27,6 +34,13 @@ Options:
                                      file containing custom settings. If not
                                      set, the settings from the boards will be
                                      used instead.
+  --drc-profile <name>               Name of the DRC profile to use, either
+                                     'full' (default), 'quick' or a custom
+                                     profile defined in the DRC settings.
+  --drc-timings <file>               Write the execution time and the number of
+                                     messages of each DRC check to this JSON
+                                     file. Only makes sense in conjunction with
+                                     '--drc'.
   --run-job <name>                   Run a particular output job. Can be given
                                      multiple times to run multiple jobs.
   --run-jobs                         Run all existing output jobs.
@@ -36,6 +50,15 @@ Options:
   --outdir <path>                    Override the output base directory of
                                      jobs. If not set, the standard output
                                      directory from the project is used.
+  --output-cache                     Reuse the output files of jobs whose
+                                     inputs did not change since their last run
+                                     with this option, instead of running these
+                                     jobs again.
+  --skip-unchanged                   Do not overwrite output files whose
+                                     content did not change (ignoring creation
+                                     dates), to keep their modification time.
+                                     Afterwards, the files which actually
+                                     changed are listed.
   --export-schematics <file>         Export schematics to given file(s).
                                      Existing files will be overwritten.
                                      Supported file extensions: pdf, svg, ***
@@ -54,8 +77,10 @@ Options:
                                      will be overwritten.
   --pcb-fabrication-settings <file>  Override PCB fabrication output settings
                                      by providing a *.lp file containing custom
-                                     settings. If not set, the settings from the
-                                     boards will be used instead.
+                                     settings. Can be given multiple times to
+                                     export several settings profiles at once.
+                                     If not set, the settings from the boards
+                                     will be used instead.
   --export-pnp-top <file>            Export pick&place file for automated
                                      assembly of the top board side. Existing
                                      files will be overwritten. Supported file
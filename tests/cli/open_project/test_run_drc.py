@@ -1,6 +1,7 @@
 #!/usr/bin/env python
 # -*- coding: utf-8 -*-
 
+import json
 import params
 import pytest
 
@@ -40,6 +41,30 @@ def test_project_with_two_boards_explicit_one(cli, project):
     assert code == 0
 
 
+@pytest.mark.parametrize("project", [params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM])
+def test_timings(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run('open-project', '--drc', '--board=copy',
+                                   '--drc-timings=timings.json', project.path)
+    assert stderr == ''
+    assert stdout == \
+        "Open project '{project.path}'...\n" \
+        "Run DRC...\n" \
+        "  Board 'copy':\n" \
+        "    Approved messages: 0\n" \
+        "    Non-approved messages: 0\n" \
+        "  => 'timings.json'\n" \
+        "SUCCESS\n".format(project=project)
+    assert code == 0
+    with open(cli.abspath('timings.json'), 'r') as f:
+        timings = json.load(f)
+    assert [t['board'] for t in timings] == ['copy']
+    checks = {c['name']: c for c in timings[0]['checks']}
+    assert 'copper_copper_clearances' in checks
+    assert checks['copper_copper_clearances']['duration_ms'] >= 0
+    assert checks['copper_copper_clearances']['messages'] == 0
+
+
 @pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
 def test_board_with_approved_message(cli, project):
     cli.add_project(project.dir, as_lppz=project.is_lppz)
@@ -172,3 +197,79 @@ def test_with_custom_settings(cli, project):
         "    Non-approved messages: 1\n" \
         "Finished with errors!\n".format(project=project)
     assert code == 1
+
+
+@pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
+def test_with_custom_profile(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    settings = """
+      (design_rule_check
+       (min_copper_copper_clearance 0.2)
+       (min_copper_board_clearance 0.3)
+       (min_copper_npth_clearance 0.2)
+       (min_drill_drill_clearance 0.35)
+       (min_drill_board_clearance 0.5)
+       (min_silkscreen_stopmask_clearance 0.127)
+       (min_copper_width 0.2)
+       (min_annular_ring 0.15)
+       (min_npth_drill_diameter 0.1234)
+       (min_pth_drill_diameter 0.25)
+       (min_npth_slot_width 1.0)
+       (min_pth_slot_width 0.7)
+       (min_silkscreen_width 0.1)
+       (min_silkscreen_text_height 0.8)
+       (min_outline_tool_diameter 2.0)
+       (blind_vias_allowed true)
+       (buried_vias_allowed true)
+       (allowed_npth_slots single_segment_straight)
+       (allowed_pth_slots single_segment_straight)
+       (profile "routing" (planes false) (arc_tolerance 0.05)
+        (check copper_copper_clearances)
+        (check copper_board_clearances)
+       )
+       (approvals_version "0.2")
+      )
+    """
+    with open(cli.abspath('settings.lp'), mode='w') as f:
+        f.write(settings)
+    # Add a hole with small diameter, which is not checked by the profile.
+    with open(cli.abspath(project.dir + '/boards/default/board.lp'), 'r') as f:
+        board_content = f.read()
+    board_content = board_content.replace(
+        '\n)\n',
+        '\n (hole 82506db2-3323-4732-8480-f3517f10dd44 '
+        '  (diameter 0.1) (stop_mask auto) (lock false)\n'
+        '  (vertex (position 50.0 50.0) (angle 0.0))\n'
+        ' )\n'
+        ')\n'
+    )
+    with open(cli.abspath(project.dir + '/boards/default/board.lp'), 'w') as f:
+        f.write(board_content)
+    code, stdout, stderr = cli.run('open-project',
+                                   '--drc',
+                                   '--drc-settings', 'settings.lp',
+                                   '--drc-profile', 'routing',
+                                   project.path)
+    assert stderr == ''
+    assert stdout == \
+        "Open project '{project.path}'...\n" \
+        "Run DRC...\n" \
+        "  Board 'default':\n" \
+        "    Approved messages: 0\n" \
+        "    Non-approved messages: 0\n" \
+        "SUCCESS\n".format(project=project)
+    assert code == 0
+
+
+@pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
+def test_with_unknown_profile(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run('open-project', '--drc',
+                                   '--drc-profile=foo', project.path)
+    assert stderr == "    ERROR: Unknown DRC profile: 'foo'\n"
+    assert stdout == \
+        "Open project '{project.path}'...\n" \
+        "Run DRC...\n" \
+        "  Board 'default':\n" \
+        "Finished with errors!\n".format(project=project)
+    assert code == 1
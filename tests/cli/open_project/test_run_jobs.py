@@ -351,3 +351,91 @@ def test_custom_outdir_absolute(cli, project):
     assert code == 0
     assert os.path.exists(dir)
     assert len(os.listdir(dir)) == 11
+
+
+@pytest.mark.parametrize("project", [
+    params.PROJECT_WITH_TWO_BOARDS_LPP_PARAM,
+])
+def test_output_cache(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    dir = cli.abspath(project.output_dir)
+    fp = os.path.join(dir, 'Empty_Project_v1_Netlist.d356')
+    expected_stdout = \
+        "Open project '{project.path}'...\n" \
+        "Run output job 'Netlist'...\n" \
+        "  => '{project.output_dir_native}//Empty_Project_v1_Netlist.d356'\n" \
+        "SUCCESS\n".format(project=project).replace('//', os.sep)
+
+    # First run generates the file.
+    code, stdout, stderr = cli.run('open-project',
+                                   '--run-job=Netlist',
+                                   '--output-cache',
+                                   project.path)
+    assert stderr == ''
+    assert stdout == expected_stdout
+    assert code == 0
+    assert os.path.exists(os.path.join(dir, '.librepcb-output-hashes'))
+
+    # Second run reuses the file since the project did not change.
+    with open(fp, 'w') as f:
+        f.write('cached')
+    code, stdout, stderr = cli.run('open-project',
+                                   '--run-job=Netlist',
+                                   '--output-cache',
+                                   project.path)
+    assert stderr == ''
+    assert stdout == expected_stdout
+    assert code == 0
+    with open(fp, 'r') as f:
+        assert f.read() == 'cached'
+
+    # Without the cache, the file is generated again and the hash removed.
+    code, stdout, stderr = cli.run('open-project',
+                                   '--run-job=Netlist',
+                                   project.path)
+    assert stderr == ''
+    assert stdout == expected_stdout
+    assert code == 0
+    with open(fp, 'r') as f:
+        assert f.read() != 'cached'
+    assert not os.path.exists(os.path.join(dir, '.librepcb-output-hashes'))
+
+
+@pytest.mark.parametrize("project", [
+    params.PROJECT_WITH_TWO_BOARDS_LPP_PARAM,
+])
+def test_skip_unchanged(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    dir = cli.abspath(project.output_dir)
+    fp = os.path.join(dir, 'Empty_Project_v1_Netlist.d356')
+    expected_stdout = \
+        "Open project '{project.path}'...\n" \
+        "Run output job 'Netlist'...\n" \
+        "  => '{project.output_dir_native}//Empty_Project_v1_Netlist.d356'\n" \
+        "Changed output files: {changed} of 1\n" \
+        "{list}" \
+        "SUCCESS\n"
+
+    # First run writes the file.
+    code, stdout, stderr = cli.run('open-project',
+                                   '--run-job=Netlist',
+                                   '--skip-unchanged',
+                                   project.path)
+    assert stderr == ''
+    assert stdout == expected_stdout.format(
+        project=project, changed=1,
+        list="  * '{project.output_dir_native}//Empty_Project_v1_Netlist.d356'"
+             "\n".format(project=project)).replace('//', os.sep)
+    assert code == 0
+
+    # Second run does not touch the file since only its date would change.
+    os.utime(fp, (0, 0))
+    code, stdout, stderr = cli.run('open-project',
+                                   '--run-job=Netlist',
+                                   '--skip-unchanged',
+                                   project.path)
+    assert stderr == ''
+    assert stdout == expected_stdout.format(
+        project=project, changed=0, list='').replace('//', os.sep)
+    assert code == 0
+    assert os.path.getmtime(fp) == 0
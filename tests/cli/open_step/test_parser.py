@@ -13,6 +13,11 @@ Options:
   -h, --help        Print this message.
   -V, --version     Displays version information.
   -v, --verbose     Verbose output.
+  --trace <file>    Write a timing trace of expensive operations to this file,
+                    in the Chrome trace JSON format (e.g. for Perfetto).
+  --jobs <count>    Maximum number of threads used by each parallelized
+                    operation (default: number of CPU cores). Nested operations
+                    may use additional threads.
   --minify          Minify the STEP model before validating it. Use in
                     conjunction with '--save-to' to save the output of the
                     operation.
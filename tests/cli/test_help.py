@@ -14,14 +14,21 @@ Usage: {executable} [options] command
 LibrePCB Command Line Interface
 
 Options:
-  -h, --help     Print this message.
-  -V, --version  Displays version information.
-  -v, --verbose  Verbose output.
+  -h, --help      Print this message.
+  -V, --version   Displays version information.
+  -v, --verbose   Verbose output.
+  --trace <file>  Write a timing trace of expensive operations to this file, in
+                  the Chrome trace JSON format (e.g. for Perfetto).
+  --jobs <count>  Maximum number of threads used by each parallelized operation
+                  (default: number of CPU cores). Nested operations may use
+                  additional threads.
 
 Arguments:
-  command        The command to execute (see list below).
+  command         The command to execute (see list below).
 
 Commands:
+  batch          Execute multiple commands from a file in a single process.
+  benchmark      Measure the execution time of common operations on a project.
   open-library   Open a library to execute library-related tasks.
   open-project   Open a project to execute project-related tasks.
   open-step      Open a STEP model to execute STEP-related tasks outside of a library.
@@ -180,6 +180,22 @@ TEST_F(AirWiresBuilderTest, testPartlyConnectedColinearPoints) {
   EXPECT_EQ(expected, airwires);
 }
 
+TEST_F(AirWiresBuilderTest, testManyUnconnectedColinearPoints) {
+  // Enough points to not build the MST directly, added in shuffled order.
+  AirWiresBuilder builder;
+  QVector<int> ids(100);
+  for (int i = 0; i < ids.count(); ++i) {
+    const int index = (i * 37) % ids.count();
+    ids[index] = builder.addPoint(Point(index * 100000, 0));
+  }
+  AirWiresBuilder::AirWires airwires = sorted(builder.buildAirWires());
+  AirWiresBuilder::AirWires expected;
+  for (int i = 1; i < ids.count(); ++i) {
+    expected.append(std::make_pair(ids.at(i - 1), ids.at(i)));
+  }
+  EXPECT_EQ(sorted(expected), airwires);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -263,6 +263,31 @@ TEST_F(GerberApertureListTest, testSamePropertiesAndAttributes) {
   EXPECT_EQ("%ADD10C,0.0*%\n", l.generateString().toStdString());
 }
 
+// Test if the same aperture ID is returned when creating multiple apertures
+// with different parameters but leading in exactly the same image.
+TEST_F(GerberApertureListTest, testDifferentParametersSameImage) {
+  GerberApertureList l;
+
+  EXPECT_EQ(10, l.addCircle(UnsignedLength(100000), tl::nullopt));
+  EXPECT_EQ(10,
+            l.addObround(PositiveLength(100000), PositiveLength(100000),
+                         Angle::deg45(), tl::nullopt));
+  EXPECT_EQ(10,
+            l.addObround(PositiveLength(100000), PositiveLength(100000),
+                         Angle::deg0(), tl::nullopt));
+  EXPECT_EQ(11,
+            l.addRect(PositiveLength(100000), PositiveLength(200000),
+                      UnsignedLength(0), Angle::deg0(), tl::nullopt));
+  EXPECT_EQ(11,
+            l.addRect(PositiveLength(200000), PositiveLength(100000),
+                      UnsignedLength(0), Angle::deg90(), tl::nullopt));
+  EXPECT_EQ(11,
+            l.addRect(PositiveLength(100000), PositiveLength(200000),
+                      UnsignedLength(0), Angle::deg0(), tl::nullopt));
+  EXPECT_EQ("%ADD10C,0.1*%\n%ADD11R,0.1X0.2*%\n",
+            l.generateString().toStdString());
+}
+
 // Test if a new aperture ID is returned when creating multiple apertures
 // with different properties but with the same attributes.
 TEST_F(GerberApertureListTest, testDifferentProperties) {
@@ -234,6 +234,32 @@ TEST_F(GerberGeneratorTest, testDoesNotContainZeroSizeApertures) {
   ASSERT_GE(checkedCircles, 3);  // Sanity check if test works.
 }
 
+// Check if streaming the output into a device produces exactly the same output
+// (including the MD5 checksum over all non-linebreak characters).
+TEST_F(GerberGeneratorTest, testStreamingEqualsInMemoryOutput) {
+  GerberGenerator gen(QDateTime(QDate(2000, 2, 1), QTime(1, 2, 3, 4)),
+                      "Project Name",
+                      Uuid::fromString("bdf7bea5-b88e-41b2-be85-c1604e8ddfca"),
+                      "rev-1.0");
+  gen.drawLine(Point(500, 600), Point(700, 800), UnsignedLength(100000),
+               tl::nullopt, tl::nullopt, QString());
+  gen.flashCircle(Point(1000, 2000), PositiveLength(300000), tl::nullopt,
+                  tl::nullopt, QString(), QString(), QString());
+  gen.generate();
+
+  QByteArray streamed;
+  QBuffer buffer(&streamed);
+  ASSERT_TRUE(buffer.open(QIODevice::WriteOnly));
+  gen.generate(buffer);
+  EXPECT_EQ(gen.toByteArray().toStdString(), streamed.toStdString());
+
+  QByteArray data = streamed.left(streamed.indexOf("G04 #@! TF.MD5,"));
+  data.replace("\n", "");
+  const QByteArray md5 =
+      QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex();
+  EXPECT_TRUE(streamed.contains("G04 #@! TF.MD5," + md5 + "*\n"));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -192,6 +192,32 @@ TEST_F(AsyncCopyOperationTest, testExistingDestinationDir) {
   EXPECT_TRUE(mPopulatedDir.getPathTo(".dotfile").isExistingFile());
 }
 
+TEST_F(AsyncCopyOperationTest, testManyFiles) {
+  for (bool parallel : {true, false}) {
+    const FilePath dst = mDestinationDir.getPathTo(parallel ? "par" : "seq");
+    for (int i = 0; i < 200; ++i) {
+      FileUtils::writeFile(
+          mPopulatedDir.getPathTo(QString("many/%1/%2").arg(i % 7).arg(i)),
+          QByteArray::number(i));
+    }
+
+    // Perform copy operation.
+    AsyncCopyOperation copy(mPopulatedDir, dst);
+    copy.setParallelCopy(parallel);
+    EXPECT_TRUE(run(copy, 10000));
+    EXPECT_EQ(mSignalFailed.count(), 0);
+
+    // Verify copied directoy.
+    for (int i = 0; i < 200; ++i) {
+      EXPECT_EQ(QByteArray::number(i),
+                FileUtils::readFile(
+                    dst.getPathTo(QString("many/%1/%2").arg(i % 7).arg(i))));
+    }
+    EXPECT_EQ(FileUtils::readFile(dst.getPathTo("foo/a dir/f")), "A");
+    EXPECT_EQ(mSignalProgressPercent.last(), 100);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
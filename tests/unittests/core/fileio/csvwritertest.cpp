@@ -0,0 +1,89 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/csvfile.h>
+#include <librepcb/core/fileio/csvwriter.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class CsvWriterTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(CsvWriterTest, testDefaultConstructor) {
+  CsvWriter w;
+  EXPECT_EQ("", w.getData().toStdString());
+}
+
+TEST_F(CsvWriterTest, testSameContentAsCsvFile) {
+  const QString comment = "Foo\n\nBar ";
+  const QStringList header = {"Column", "With,Comma", "\"With Quotes\""};
+  const QList<QStringList> values = {
+      {"", "", ""},
+      {"-1.2345", "Foo\r\nBar", "äöü"},
+  };
+
+  CsvFile f;
+  f.setComment(comment);
+  f.setHeader(header);
+  CsvWriter w;
+  w.writeComment(comment);
+  w.writeHeader(header);
+  foreach (const QStringList& row, values) {
+    f.addValue(row);
+    w.writeRow(row);
+  }
+  EXPECT_EQ(f.toString().toStdString(), w.getData().toStdString());
+}
+
+TEST_F(CsvWriterTest, testRowsAdjustedToHeaderCount) {
+  CsvWriter w;
+  w.writeHeader({"Foo", "Bar"});
+  w.writeRow({"V1"});
+  w.writeRow({"V1", "V2", "V3"});
+  EXPECT_EQ(
+      "Foo,Bar\n"
+      "V1,\n"
+      "V1,V2\n",
+      w.getData().toStdString());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
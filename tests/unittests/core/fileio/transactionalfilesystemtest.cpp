@@ -27,6 +27,8 @@
 #include <librepcb/core/utils/toolbox.h>
 #include <quazip/quazip.h>
 
+#include <QtConcurrent>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -162,6 +164,48 @@ TEST_F(TransactionalFileSystemTest, testWriteIsDelayedUntilSave) {
   EXPECT_EQ("content", FileUtils::readFile(fp));
 }
 
+TEST_F(TransactionalFileSystemTest, testWriteLargeFile) {
+  const QByteArray content(5 * 1024 * 1024, 'x');
+  const FilePath fp = mPopulatedDir.getPathTo("large/file");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("large/file", content);
+  EXPECT_TRUE(fs.fileExists("large/file"));
+  EXPECT_TRUE(fs.getDirs().contains("large"));
+  EXPECT_EQ(content, fs.read("large/file"));
+  EXPECT_EQ(QStringList{"large/file"}, fs.checkForModifications());
+  EXPECT_FALSE(fp.isExistingFile());
+
+  // overwrite
+  fs.write("large/file", content + "y");
+  EXPECT_EQ(content + "y", fs.read("large/file"));
+
+  // save
+  fs.save();
+  EXPECT_EQ(content + "y", FileUtils::readFile(fp));
+  EXPECT_EQ(content + "y", fs.read("large/file"));
+}
+
+TEST_F(TransactionalFileSystemTest, testConcurrentReads) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("new.txt", "new");
+  const QStringList paths = {"1.txt", "1/1a.txt", "1/2/3/4.txt", "new.txt"};
+  QStringList allPaths;
+  for (int i = 0; i < 100; ++i) {
+    allPaths += paths;
+  }
+  const std::function<QByteArray(const QString&)> read =
+      [&fs](const QString& path) { return fs.read(path); };
+  const QList<QByteArray> contents =
+      QtConcurrent::blockingMapped<QList<QByteArray>>(allPaths, read);
+  ASSERT_EQ(allPaths.count(), contents.count());
+  for (int i = 0; i < contents.count(); i += paths.count()) {
+    EXPECT_EQ("1", contents.at(i).toStdString());
+    EXPECT_EQ("1a", contents.at(i + 1).toStdString());
+    EXPECT_EQ("4", contents.at(i + 2).toStdString());
+    EXPECT_EQ("new", contents.at(i + 3).toStdString());
+  }
+}
+
 TEST_F(TransactionalFileSystemTest, testRemoveExistingFile) {
   FilePath fp = mPopulatedDir.getPathTo("1/1a.txt");
   TransactionalFileSystem fs(mPopulatedDir, true);
@@ -441,6 +485,35 @@ TEST_F(TransactionalFileSystemTest, testAutosaveIsRemovedInDestructor) {
   EXPECT_FALSE(fp.isExistingDir());
 }
 
+TEST_F(TransactionalFileSystemTest, testIncrementalAutosave) {
+  const FilePath fp = mPopulatedDir.getPathTo(".autosave");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("new 1.txt", "1");
+  fs.write("new 2.txt", "2");
+  fs.autosave();
+  QThread::msleep(5);  // Ensure a different subdirectory name.
+  fs.write("new 1.txt", "1");  // Not modified.
+  fs.write("new 2.txt", "new 2");
+  fs.autosave();
+
+  // Only the modified file is written by the second autosave.
+  const QStringList dirs = Toolbox::sorted(
+      QDir(fp.toStr()).entryList(QDir::Dirs | QDir::NoDotAndDotDot));
+  ASSERT_EQ(2, dirs.count());
+  EXPECT_EQ(QStringList{"new 2.txt"},
+            QDir(fp.getPathTo(dirs.last()).toStr()).entryList(QDir::Files));
+
+  // remove lock because we can't get a stale lock without crashing the app
+  FileUtils::removeFile(mPopulatedDir.getPathTo(".lock"));
+
+  // restore the autosave
+  TransactionalFileSystem fs2(mPopulatedDir, true,
+                              &TransactionalFileSystem::RestoreMode::yes);
+  EXPECT_TRUE(fs2.isRestoredFromAutosave());
+  EXPECT_EQ("1", fs2.read("new 1.txt"));
+  EXPECT_EQ("new 2", fs2.read("new 2.txt"));
+}
+
 TEST_F(TransactionalFileSystemTest, testRestoreAutosave) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -612,6 +685,25 @@ TEST_F(TransactionalFileSystemTest, testExportImportZipByFilePath) {
   }
 }
 
+TEST_F(TransactionalFileSystemTest, testModifyFilesLoadedFromZip) {
+  FilePath zipFp = mTmpDir.getPathTo("export.zip");
+  TransactionalFileSystem(mPopulatedDir, false).exportToZip(zipFp);
+  TransactionalFileSystem fs(mEmptyDir, true);
+  fs.loadFromZip(zipFp);
+  fs.write("1.txt", "new 1");
+  fs.removeFile("2.txt");
+  fs.removeDirRecursively("a");
+  EXPECT_EQ("new 1", fs.read("1.txt"));
+  EXPECT_FALSE(fs.fileExists("2.txt"));
+  EXPECT_FALSE(fs.fileExists("a/b/c"));
+  EXPECT_EQ("4", fs.read("1/2/3/4.txt"));
+  fs.save();
+  EXPECT_EQ("new 1", FileUtils::readFile(mEmptyDir.getPathTo("1.txt")));
+  EXPECT_EQ("4", FileUtils::readFile(mEmptyDir.getPathTo("1/2/3/4.txt")));
+  EXPECT_FALSE(mEmptyDir.getPathTo("2.txt").isExistingFile());
+  EXPECT_FALSE(mEmptyDir.getPathTo("a/b/c").isExistingFile());
+}
+
 TEST_F(TransactionalFileSystemTest, testExportZipByFilePathWithFilter) {
   FilePath zipFp = mPopulatedDir.getPathTo("export to filter.zip");
   TransactionalFileSystem fs(mPopulatedDir, true);
@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/fileio/zipwriter.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ZipWriterTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+
+  ZipWriterTest() : mTmpDir(FilePath::getRandomTempPath()) {
+    FileUtils::makePath(mTmpDir);
+  }
+
+  virtual ~ZipWriterTest() { QDir(mTmpDir.toStr()).removeRecursively(); }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ZipWriterTest, testWriteToDevice) {
+  QHash<QString, QByteArray> files = {
+      {"empty.txt", QByteArray()},
+      {"foo/bar.txt", "bar"},
+      {"large.bin", QByteArray(3 * 1024 * 1024, 'x')},
+  };
+  for (int i = 0; i < 100; ++i) {
+    files.insert(QString("many/%1.txt").arg(i), QByteArray::number(i));
+  }
+  QBuffer buffer;
+  {
+    ZipWriter zip(buffer);
+    for (auto it = files.begin(); it != files.end(); ++it) {
+      zip.addFile(it.key(), it.value());
+    }
+    zip.finish();
+  }
+
+  TransactionalFileSystem fs(mTmpDir.getPathTo("fs"), false);
+  fs.loadFromZip(buffer.buffer());
+  for (auto it = files.begin(); it != files.end(); ++it) {
+    EXPECT_EQ(it.value(), fs.read(it.key())) << qPrintable(it.key());
+  }
+  EXPECT_EQ(100, fs.getFiles("many").count());
+}
+
+TEST_F(ZipWriterTest, testIncompleteFileIsRemoved) {
+  const FilePath fp = mTmpDir.getPathTo("test.zip");
+  {
+    ZipWriter zip(fp);
+    zip.addFile("foo.txt", "foo");
+    EXPECT_TRUE(fp.isExistingFile());
+  }
+  EXPECT_FALSE(fp.isExistingFile());
+}
+
+TEST_F(ZipWriterTest, testWriteToFile) {
+  const FilePath fp = mTmpDir.getPathTo("test.zip");
+  {
+    ZipWriter zip(fp);
+    zip.addFile("foo.txt", "foo");
+    zip.finish();
+  }
+  ASSERT_TRUE(fp.isExistingFile());
+
+  TransactionalFileSystem fs(mTmpDir.getPathTo("fs"), false);
+  fs.loadFromZip(fp);
+  EXPECT_EQ(QStringList{"foo.txt"}, fs.getFiles());
+  EXPECT_EQ("foo", fs.read("foo.txt"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
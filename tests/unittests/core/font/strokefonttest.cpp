@@ -0,0 +1,91 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/application.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/font/strokefont.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StrokeFontTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StrokeFontTest, testGlyphCacheFilePathDependsOnContent) {
+  EXPECT_EQ(StrokeFont::getGlyphCacheFilePath("foo"),
+            StrokeFont::getGlyphCacheFilePath("foo"));
+  EXPECT_NE(StrokeFont::getGlyphCacheFilePath("foo"),
+            StrokeFont::getGlyphCacheFilePath("bar"));
+}
+
+TEST_F(StrokeFontTest, testCachedGlyphsEqualParsedGlyphs) {
+  const FilePath fp = Application::getResourcesDir().getPathTo(
+      "fonts/" % Application::getDefaultStrokeFontName());
+  const QByteArray content = FileUtils::readFile(fp);
+  const FilePath cacheFp = StrokeFont::getGlyphCacheFilePath(content);
+  if (cacheFp.isExistingFile()) {
+    FileUtils::removeFile(cacheFp);
+  }
+
+  // Parse the font file, which also writes the cache file.
+  const StrokeFont parsed(fp, content);
+  parsed.getLetterSpacing();  // Blocks until the font is loaded.
+  ASSERT_TRUE(cacheFp.isExistingFile());
+
+  // Load the same font again, now from the cache file.
+  const StrokeFont cached(fp, content);
+  EXPECT_EQ(parsed.getLetterSpacing(), cached.getLetterSpacing());
+  EXPECT_EQ(parsed.getLineSpacing(), cached.getLineSpacing());
+  const PositiveLength height(2500000);
+  for (uint codepoint = 0; codepoint <= 0xFFFF; ++codepoint) {
+    const QChar glyph(codepoint);
+    Length parsedSpacing;
+    Length cachedSpacing;
+    const QVector<Path> parsedPaths =
+        parsed.strokeGlyph(glyph, height, parsedSpacing);
+    const QVector<Path> cachedPaths =
+        cached.strokeGlyph(glyph, height, cachedSpacing);
+    ASSERT_EQ(parsedSpacing, cachedSpacing) << "U+" << std::hex << codepoint;
+    ASSERT_EQ(parsedPaths, cachedPaths) << "U+" << std::hex << codepoint;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
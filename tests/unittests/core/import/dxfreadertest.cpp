@@ -21,10 +21,13 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/import/dxfreader.h>
 #include <librepcb/core/serialization/sexpression.h>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -524,6 +527,81 @@ TEST_F(DxfReaderTest, testLwPolylineClosed) {
   EXPECT_EQ(str(expected), str(reader.getPolygons().first()));
 }
 
+TEST_F(DxfReaderTest, testLayerFilter) {
+  reader.setLayerFilter({"OUTLINE"});  // Case insensitive.
+  parse(
+      "0\nSECTION\n"
+      "2\nENTITIES\n"
+      "0\nPOINT\n"
+      "8\nOutline\n"  // LAYER
+      "10\n1.0\n"  // X
+      "20\n2.0\n"  // Y
+      "0\nPOINT\n"
+      "8\nOther\n"  // LAYER
+      "10\n3.0\n"  // X
+      "20\n4.0\n"  // Y
+      "0\nLINE\n"
+      "8\nOther\n"  // LAYER
+      "10\n4.0\n"  // X1
+      "20\n5.0\n"  // Y1
+      "11\n8.0\n"  // X2
+      "21\n10.0\n"  // Y2
+      "0\nLWPOLYLINE\n"
+      "8\nOther\n"  // LAYER
+      "90\n2\n"  // VERTICES
+      "70\n0\n"  // FLAGS (0=open, 1=closed)
+      "10\n4.0\n"  // X1
+      "20\n5.0\n"  // Y1
+      "10\n4.0\n"  // X2
+      "20\n7.0\n"  // Y2
+      "0\nENDSEC\n"
+      "0\nEOF\n");
+
+  // Assert(!) for number of elements to avoid illegal list item access below.
+  ASSERT_EQ(1, reader.getPoints().count());
+  ASSERT_EQ(0, reader.getPolygons().count());
+  ASSERT_EQ(0, reader.getCircles().count());
+
+  Point expected(Length(1000000), Length(2000000));
+  EXPECT_EQ(str(expected), str(reader.getPoints().first()));
+}
+
+TEST_F(DxfReaderTest, testProgressCallback) {
+  QByteArray dxf = "0\nSECTION\n2\nENTITIES\n";
+  for (int i = 0; i < 5000; ++i) {
+    dxf += "0\nPOINT\n10\n1.0\n20\n2.0\n";
+  }
+  dxf += "0\nENDSEC\n0\nEOF\n";
+  QVector<int> progress;
+  reader.setProgressCallback([&progress](int percent) {
+    progress.append(percent);
+    return true;
+  });
+  parse(dxf);
+  EXPECT_EQ(5000, reader.getPoints().count());
+  ASSERT_FALSE(progress.isEmpty());
+  EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+  EXPECT_GE(progress.first(), 0);
+  EXPECT_LE(progress.last(), 100);
+}
+
+TEST_F(DxfReaderTest, testProgressCallbackAbort) {
+  QByteArray dxf = "0\nSECTION\n2\nENTITIES\n";
+  for (int i = 0; i < 5000; ++i) {
+    dxf += "0\nPOINT\n10\n1.0\n20\n2.0\n";
+  }
+  dxf += "0\nENDSEC\n0\nEOF\n";
+  int calls = 0;
+  reader.setProgressCallback([&calls](int percent) {
+    Q_UNUSED(percent);
+    ++calls;
+    return false;
+  });
+  EXPECT_THROW(parse(dxf), UserCanceled);
+  EXPECT_EQ(1, calls);
+  EXPECT_LT(reader.getPoints().count(), 5000);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,74 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/memoryaccounting.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class MemoryAccountingTest : public ::testing::Test {
+protected:
+  static MemoryAccounting::Usage getUsage(const QString& category) {
+    return MemoryAccounting::instance().getUsage().value(
+        category, MemoryAccounting::Usage{0, 0});
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(MemoryAccountingTest, testCounters) {
+  {
+    MemoryAccounting::Counter c1("test");
+    MemoryAccounting::Counter c2("test");
+    c1.set(2, 100);
+    c2.add(1, 50);
+    c2.add(1, 50);
+    EXPECT_EQ(4, getUsage("test").objects);
+    EXPECT_EQ(200, getUsage("test").bytes);
+
+    c1.set(1, 10);
+    EXPECT_EQ(3, getUsage("test").objects);
+    EXPECT_EQ(110, getUsage("test").bytes);
+  }
+  EXPECT_EQ(0, getUsage("test").objects);
+  EXPECT_EQ(0, getUsage("test").bytes);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
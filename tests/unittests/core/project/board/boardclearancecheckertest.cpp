@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/drc/boardclearancechecker.h>
+#include <librepcb/core/project/board/items/bi_netline.h>
+#include <librepcb/core/project/board/items/bi_netpoint.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/board/items/bi_via.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/netclass.h>
+#include <librepcb/core/project/circuit/netsignal.h>
+#include <librepcb/core/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardClearanceCheckerTest : public ::testing::Test {
+protected:
+  BoardClearanceCheckerTest() {
+    mProject = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(FilePath::getRandomTempPath()))),
+        "project.lpp");
+    mBoard = new Board(
+        *mProject,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board"));
+    mProject->addBoard(*mBoard);
+    mNetA = addNetSignal("A");
+    mNetB = addNetSignal("B");
+  }
+
+  NetSignal* addNetSignal(const QString& name) {
+    Circuit& circuit = mProject->getCircuit();
+    NetSignal* netSignal =
+        new NetSignal(circuit, Uuid::createRandom(),
+                      *circuit.getNetClasses().first(),
+                      CircuitIdentifier(name), false);
+    circuit.addNetSignal(*netSignal);
+    return netSignal;
+  }
+
+  BI_NetLine& addNetLine(NetSignal* netSignal, const Point& p1,
+                         const Point& p2) {
+    BI_NetSegment* segment =
+        new BI_NetSegment(*mBoard, Uuid::createRandom(), netSignal);
+    mBoard->addNetSegment(*segment);
+    BI_NetPoint* np1 = new BI_NetPoint(*segment, Uuid::createRandom(), p1);
+    BI_NetPoint* np2 = new BI_NetPoint(*segment, Uuid::createRandom(), p2);
+    BI_NetLine* netLine =
+        new BI_NetLine(*segment, Uuid::createRandom(), *np1, *np2,
+                       Layer::topCopper(), PositiveLength(500000));
+    segment->addElements({}, {np1, np2}, {netLine});
+    return *netLine;
+  }
+
+  BI_Via& addVia(NetSignal* netSignal, const Point& pos) {
+    BI_NetSegment* segment =
+        new BI_NetSegment(*mBoard, Uuid::createRandom(), netSignal);
+    mBoard->addNetSegment(*segment);
+    BI_Via* via = new BI_Via(
+        *segment,
+        Via(Uuid::createRandom(), Layer::topCopper(), Layer::botCopper(), pos,
+            PositiveLength(600000), PositiveLength(300000), MaskConfig::off()));
+    segment->addElements({via}, {}, {});
+    return *via;
+  }
+
+  std::unique_ptr<Project> mProject;
+  Board* mBoard;
+  NetSignal* mNetA;
+  NetSignal* mNetB;
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardClearanceCheckerTest, testNetLineClearance) {
+  // Distance between the copper of both net lines is 0.5mm.
+  BI_NetLine& netLine = addNetLine(mNetA, Point(0, 0), Point(10000000, 0));
+  addNetLine(mNetB, Point(0, 1000000), Point(10000000, 1000000));
+
+  BoardClearanceChecker checker1(*mBoard, UnsignedLength(400000));
+  EXPECT_EQ(0, checker1.checkNetLine(netLine).count());
+
+  BoardClearanceChecker checker2(*mBoard, UnsignedLength(600000));
+  EXPECT_EQ(1, checker2.checkNetLine(netLine).count());
+}
+
+TEST_F(BoardClearanceCheckerTest, testSameNetSignalIsIgnored) {
+  BI_NetLine& netLine = addNetLine(mNetA, Point(0, 0), Point(10000000, 0));
+  addNetLine(mNetA, Point(0, 1000000), Point(10000000, 1000000));
+
+  BoardClearanceChecker checker(*mBoard, UnsignedLength(600000));
+  EXPECT_EQ(0, checker.checkNetLine(netLine).count());
+}
+
+TEST_F(BoardClearanceCheckerTest, testUnconnectedItemsAreNotChecked) {
+  BI_NetLine& netLine = addNetLine(nullptr, Point(0, 0), Point(10000000, 0));
+  addNetLine(mNetB, Point(0, 1000000), Point(10000000, 1000000));
+
+  BoardClearanceChecker checker(*mBoard, UnsignedLength(600000));
+  EXPECT_EQ(0, checker.checkNetLine(netLine).count());
+}
+
+TEST_F(BoardClearanceCheckerTest, testViaClearance) {
+  // The via overlaps the net line on the top layer only.
+  BI_Via& via = addVia(mNetA, Point(5000000, 1500000));
+  addNetLine(mNetB, Point(0, 1000000), Point(10000000, 1000000));
+
+  BoardClearanceChecker checker(*mBoard, UnsignedLength(100000));
+  EXPECT_EQ(1, checker.checkVia(via).count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
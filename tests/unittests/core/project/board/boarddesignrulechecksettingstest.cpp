@@ -0,0 +1,87 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/project/board/drc/boarddesignrulechecksettings.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardDesignRuleCheckSettingsTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardDesignRuleCheckSettingsTest, testProfilesRoundTrip) {
+  typedef BoardDesignRuleCheckSettings::Profile Profile;
+  BoardDesignRuleCheckSettings obj1;
+  obj1.setProfiles({
+      Profile("quick", {"minimum_copper_width"}, true, PositiveLength(1000)),
+      Profile("custom", {"copper_board_clearances", "copper_copper_clearances"},
+              false, PositiveLength(20000)),
+  });
+  SExpression sexpr1 = SExpression::createList("obj");
+  obj1.serialize(sexpr1);
+
+  BoardDesignRuleCheckSettings obj2(sexpr1);
+  EXPECT_EQ(obj1.getProfiles(), obj2.getProfiles());
+  EXPECT_TRUE(obj1 == obj2);
+  SExpression sexpr2 = SExpression::createList("obj");
+  obj2.serialize(sexpr2);
+  EXPECT_EQ(sexpr1.toByteArray(), sexpr2.toByteArray());
+
+  // The custom profile overrides the built-in profile of the same name.
+  EXPECT_EQ(obj1.getProfiles().first(), obj2.findProfile("quick"));
+  EXPECT_EQ(BoardDesignRuleCheckSettings::getFullProfile(),
+            obj2.findProfile("full"));
+  EXPECT_FALSE(obj2.findProfile("unknown"));
+}
+
+TEST_F(BoardDesignRuleCheckSettingsTest, testSerializeWithoutProfiles) {
+  BoardDesignRuleCheckSettings obj1;
+  SExpression sexpr1 = SExpression::createList("obj");
+  obj1.serialize(sexpr1);
+  EXPECT_EQ(nullptr, sexpr1.tryGetChild("profile"));
+
+  BoardDesignRuleCheckSettings obj2(sexpr1);
+  EXPECT_TRUE(obj2.getProfiles().isEmpty());
+  EXPECT_EQ(BoardDesignRuleCheckSettings::getQuickProfile(),
+            obj2.findProfile("quick"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
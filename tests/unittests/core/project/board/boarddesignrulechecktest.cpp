@@ -0,0 +1,146 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/drc/boarddesignrulecheck.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/board/items/bi_via.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardDesignRuleCheckTest : public ::testing::TestWithParam<bool> {
+protected:
+  static std::unique_ptr<Project> openProject() {
+    FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    ProjectLoader loader;
+    return loader.open(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(projectFs)),
+                       projectFp.getFilename());  // can throw
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_P(BoardDesignRuleCheckTest, testExecute) {
+  std::unique_ptr<Project> project = openProject();  // can throw
+  Board* board = project->getBoards().first();
+  BoardDesignRuleCheck drc(*board, board->getDrcSettings());
+  drc.setParallelExecution(GetParam());
+  int finishedCount = 0;
+  QObject::connect(&drc, &BoardDesignRuleCheck::finished,
+                   [&finishedCount]() { ++finishedCount; });
+  drc.execute(false);  // can throw
+  EXPECT_EQ(1, finishedCount);
+  EXPECT_FALSE(drc.getTimings().isEmpty());
+}
+
+TEST_P(BoardDesignRuleCheckTest, testCancel) {
+  std::unique_ptr<Project> project = openProject();  // can throw
+  Board* board = project->getBoards().first();
+  BoardDesignRuleCheck drc(*board, board->getDrcSettings());
+  drc.setParallelExecution(GetParam());
+
+  // Cancel as soon as the first check reports its progress, like the
+  // progress dialog of the board editor does.
+  int lastPercent = 0;
+  int finishedCount = 0;
+  QObject::connect(&drc, &BoardDesignRuleCheck::progressPercent,
+                   [&drc, &lastPercent](int percent) {
+                     lastPercent = percent;
+                     if (percent > 0) {
+                       drc.cancel();
+                     }
+                   });
+  QObject::connect(&drc, &BoardDesignRuleCheck::finished,
+                   [&finishedCount]() { ++finishedCount; });
+  EXPECT_THROW(drc.execute(false), UserCanceled);
+  EXPECT_EQ(0, finishedCount);
+  EXPECT_GT(lastPercent, 0);
+  EXPECT_LT(lastPercent, 100);
+}
+
+TEST_P(BoardDesignRuleCheckTest, testCacheDoesNotGrowWithRegionRuns) {
+  std::unique_ptr<Project> project = openProject();  // can throw
+  Board* board = project->getBoards().first();
+  auto cache = std::make_shared<BoardDesignRuleCheckCache>();
+  {
+    BoardDesignRuleCheck drc(*board, board->getDrcSettings());
+    drc.setParallelExecution(GetParam());
+    drc.setCache(cache);
+    drc.execute(false);  // can throw
+  }
+  const int itemAreas = cache->itemAreas.count();
+  EXPECT_GT(itemAreas, 0);
+
+  // Modify the board between region runs to get new cache keys.
+  for (int i = 0; i < 3; ++i) {
+    foreach (BI_NetSegment* netSegment, board->getNetSegments()) {
+      foreach (BI_Via* via, netSegment->getVias()) {
+        via->setPosition(via->getPosition() + Point(100000, 0));
+      }
+    }
+    BoardDesignRuleCheck drc(*board, board->getDrcSettings());
+    drc.setParallelExecution(GetParam());
+    drc.setCache(cache);
+    drc.setRegion({Path::rect(Point(0, 0), Point(1000000, 1000000))});
+    drc.execute(false);  // can throw
+    EXPECT_EQ(itemAreas, cache->itemAreas.count());
+    foreach (const QByteArray& key, cache->intersections.keys()) {
+      const int size = key.size() / 2;
+      EXPECT_TRUE(cache->itemAreas.contains(key.left(size)));
+      EXPECT_TRUE(cache->itemAreas.contains(key.mid(size)));
+    }
+  }
+}
+
+/*******************************************************************************
+ *  Test Data
+ ******************************************************************************/
+
+INSTANTIATE_TEST_SUITE_P(BoardDesignRuleCheckTest, BoardDesignRuleCheckTest,
+                         ::testing::Values(false, true));
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/project/board/boardnetsegmentsplitter.h>
+#include <librepcb/core/types/layer.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardNetSegmentSplitterTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardNetSegmentSplitterTest, testLargeSegment) {
+  const PositiveLength size(1000000);
+  const PositiveLength drill(500000);
+  const Via connectedVia(Uuid::createRandom(), Layer::topCopper(),
+                         Layer::botCopper(), Point(0, 1000000), size, drill,
+                         MaskConfig::off());
+  const Via unconnectedVia(Uuid::createRandom(), Layer::topCopper(),
+                           Layer::botCopper(), Point(0, 2000000), size, drill,
+                           MaskConfig::off());
+
+  // A long chain of traces, added in reversed order to make sure the segment
+  // is not just found by following the order of the traces.
+  const int count = 10000;
+  QVector<Junction> junctions;
+  for (int i = 0; i <= count; ++i) {
+    junctions.append(Junction(Uuid::createRandom(), Point(i * 1000, 0)));
+  }
+  BoardNetSegmentSplitter splitter;
+  splitter.addVia(unconnectedVia, false);
+  splitter.addVia(connectedVia, false);
+  for (const Junction& junction : junctions) {
+    splitter.addJunction(junction);
+  }
+  for (int i = count; i > 0; --i) {
+    const Uuid start = junctions.at(i).getUuid();
+    const Uuid end = junctions.at(i - 1).getUuid();
+    splitter.addTrace(Trace(Uuid::createRandom(), Layer::topCopper(), size,
+                            TraceAnchor::junction(start),
+                            TraceAnchor::junction(end)));
+  }
+  splitter.addTrace(Trace(Uuid::createRandom(), Layer::topCopper(), size,
+                          TraceAnchor::via(connectedVia.getUuid()),
+                          TraceAnchor::junction(junctions.first().getUuid())));
+  const Junction separateJunction(Uuid::createRandom(), Point(0, -1000000));
+  splitter.addJunction(separateJunction);
+  splitter.addTrace(Trace(Uuid::createRandom(), Layer::topCopper(), size,
+                          TraceAnchor::junction(separateJunction.getUuid()),
+                          TraceAnchor::junction(separateJunction.getUuid())));
+
+  const QList<BoardNetSegmentSplitter::Segment> segments = splitter.split();
+  ASSERT_EQ(3, segments.count());
+  EXPECT_EQ(count + 1, segments.at(0).traces.count());
+  EXPECT_EQ(count + 1, segments.at(0).junctions.count());
+  EXPECT_EQ(1, segments.at(0).vias.count());
+  EXPECT_EQ(1, segments.at(1).traces.count());
+  EXPECT_EQ(1, segments.at(1).junctions.count());
+  EXPECT_EQ(0, segments.at(1).vias.count());
+  EXPECT_EQ(0, segments.at(2).traces.count());
+  EXPECT_EQ(unconnectedVia.getUuid(), segments.at(2).vias.value(0)->getUuid());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -51,26 +51,71 @@ namespace tests {
  * with the expected paths of all plane fragments. This test then re-calculates
  * all plane fragments and compares them with the expected fragments.
  */
-class BoardPlaneFragmentsBuilderTest : public ::testing::Test {};
+class BoardPlaneFragmentsBuilderTest : public ::testing::Test {
+protected:
+  BoardPlaneFragmentsBuilderTest()
+    : mCacheDir(FilePath::getRandomTempPath()) {}
+
+  ~BoardPlaneFragmentsBuilderTest() {
+    QDir(mCacheDir.toStr()).removeRecursively();
+  }
+
+  static std::unique_ptr<Project> openProject() {
+    FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    ProjectLoader loader;
+    return loader.open(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(projectFs)),
+                       projectFp.getFilename());  // can throw
+  }
+
+  QList<FilePath> getCacheFiles() const {
+    QList<FilePath> files;
+    foreach (const QFileInfo& info,
+             QDir(mCacheDir.toStr()).entryInfoList({"*.fragments"})) {
+      files.append(FilePath(info.absoluteFilePath()));
+    }
+    return files;
+  }
+
+  static void writeCacheFile(const FilePath& fp, const QString& appVersion,
+                             const Board& board) {
+    // Valid cache file, but without any fragments.
+    QByteArray content;
+    QDataStream stream(&content, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_5);
+    stream << QByteArray("librepcb-planes-1") << appVersion
+           << static_cast<quint32>(1)
+           << static_cast<quint32>(board.getPlanes().count());
+    foreach (const BI_Plane* plane, board.getPlanes()) {
+      stream << plane->getUuid().toStr() << static_cast<quint32>(0);
+    }
+    FileUtils::writeFile(fp, content);  // can throw
+  }
+
+  static int countFragments(const Board& board) {
+    int count = 0;
+    foreach (const BI_Plane* plane, board.getPlanes()) {
+      count += plane->getFragments().count();
+    }
+    return count;
+  }
+
+  FilePath mCacheDir;
+};
 
 /*******************************************************************************
  *  Test Methods
  ******************************************************************************/
 
-TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
+TEST_F(BoardPlaneFragmentsBuilderTest, testFragments) {
   FilePath testDataDir(
       TEST_DATA_DIR
       "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest");
 
   // open project from test data directory
-  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
-  std::shared_ptr<TransactionalFileSystem> projectFs =
-      TransactionalFileSystem::openRO(projectFp.getParentDir());
-  ProjectLoader loader;
-  std::unique_ptr<Project> project =
-      loader.open(std::unique_ptr<TransactionalDirectory>(
-                      new TransactionalDirectory(projectFs)),
-                  projectFp.getFilename());  // can throw
+  std::unique_ptr<Project> project = openProject();  // can throw
   Board* board = project->getBoards().first();
 
   // force planes rebuild
@@ -106,6 +151,66 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expected.toStdString(), actual.toStdString());
 }
 
+TEST_F(BoardPlaneFragmentsBuilderTest, testFileCacheDisabledByDefault) {
+  std::unique_ptr<Project> project = openProject();  // can throw
+  BoardPlaneFragmentsBuilder builder;
+  builder.runSynchronously(*project->getBoards().first());  // can throw
+  EXPECT_FALSE(mCacheDir.isExistingDir());
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testFileCacheMissAndHit) {
+  std::unique_ptr<Project> project = openProject();  // can throw
+  Board* board = project->getBoards().first();
+
+  // Cache miss: Fragments are calculated and stored in the cache.
+  BoardPlaneFragmentsBuilder builder;
+  builder.setFileCache(mCacheDir);
+  builder.runSynchronously(*board);  // can throw
+  EXPECT_GT(countFragments(*board), 0);
+  const QList<FilePath> files = getCacheFiles();
+  ASSERT_EQ(1, files.count());
+
+  // Cache hit: Replace the cache file by one without fragments to verify
+  // they are restored from the cache and not calculated again.
+  writeCacheFile(files.first(), Application::getVersion(), *board);
+  BoardPlaneFragmentsBuilder builder2;
+  builder2.setFileCache(mCacheDir);
+  builder2.runSynchronously(*board);  // can throw
+  EXPECT_EQ(0, countFragments(*board));
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testFileCacheOfOtherVersionIgnored) {
+  std::unique_ptr<Project> project = openProject();  // can throw
+  Board* board = project->getBoards().first();
+
+  BoardPlaneFragmentsBuilder builder;
+  builder.setFileCache(mCacheDir);
+  builder.runSynchronously(*board);  // can throw
+  const int expectedCount = countFragments(*board);
+  const QList<FilePath> files = getCacheFiles();
+  ASSERT_EQ(1, files.count());
+
+  // A cache file of another application version must not be used.
+  writeCacheFile(files.first(), "0.0.0-other", *board);
+  BoardPlaneFragmentsBuilder builder2;
+  builder2.setFileCache(mCacheDir);
+  builder2.runSynchronously(*board);  // can throw
+  EXPECT_EQ(expectedCount, countFragments(*board));
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testFileCacheSizeLimit) {
+  std::unique_ptr<Project> project = openProject();  // can throw
+  const FilePath oldFp = mCacheDir.getPathTo("old.fragments");
+  FileUtils::writeFile(oldFp, "old");  // can throw
+
+  // The least recently used file gets pruned, the new one is kept.
+  BoardPlaneFragmentsBuilder builder;
+  builder.setFileCache(mCacheDir, 1);
+  builder.runSynchronously(*project->getBoards().first());  // can throw
+  EXPECT_FALSE(oldFp.isExistingFile());
+  EXPECT_EQ(1, getCacheFiles().count());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
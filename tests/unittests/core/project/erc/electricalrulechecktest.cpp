@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/netclass.h>
+#include <librepcb/core/project/circuit/netsignal.h>
+#include <librepcb/core/project/erc/electricalrulecheck.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/schematic/items/si_netline.h>
+#include <librepcb/core/project/schematic/items/si_netpoint.h>
+#include <librepcb/core/project/schematic/items/si_netsegment.h>
+#include <librepcb/core/project/schematic/schematic.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ElectricalRuleCheckTest : public ::testing::Test {
+protected:
+  ElectricalRuleCheckTest() {
+    mProject = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(FilePath::getRandomTempPath()))),
+        "project.lpp");
+  }
+
+  Schematic& addSchematic(const QString& name) {
+    Schematic* schematic = new Schematic(
+        *mProject,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        name, Uuid::createRandom(), ElementName(name));
+    mProject->addSchematic(*schematic);
+    return *schematic;
+  }
+
+  NetSignal& addNetSignal(const QString& name) {
+    Circuit& circuit = mProject->getCircuit();
+    NetSignal* netSignal =
+        new NetSignal(circuit, Uuid::createRandom(),
+                      *circuit.getNetClasses().first(),
+                      CircuitIdentifier(name), false);
+    circuit.addNetSignal(*netSignal);
+    return *netSignal;
+  }
+
+  SI_NetSegment& addNetSegment(Schematic& schematic, NetSignal& netSignal) {
+    SI_NetSegment* segment =
+        new SI_NetSegment(schematic, Uuid::createRandom(), netSignal);
+    schematic.addNetSegment(*segment);
+    return *segment;
+  }
+
+  SI_NetPoint& addNetPoint(SI_NetSegment& segment, const Point& pos) {
+    SI_NetPoint* netPoint = new SI_NetPoint(segment, Uuid::createRandom(), pos);
+    segment.addNetPointsAndNetLines({netPoint}, {});
+    return *netPoint;
+  }
+
+  void addNetLine(SI_NetSegment& segment, const Point& p1, const Point& p2) {
+    SI_NetPoint* np1 = new SI_NetPoint(segment, Uuid::createRandom(), p1);
+    SI_NetPoint* np2 = new SI_NetPoint(segment, Uuid::createRandom(), p2);
+    SI_NetLine* netLine = new SI_NetLine(segment, Uuid::createRandom(), *np1,
+                                         *np2, UnsignedLength(0));
+    segment.addNetPointsAndNetLines({np1, np2}, {netLine});
+  }
+
+  static std::vector<std::string> str(const RuleCheckMessageList& msgs) {
+    std::vector<std::string> result;
+    foreach (const auto& msg, msgs) {
+      result.push_back(msg->getMessage().toStdString() + ": " +
+                       msg->getApproval().toByteArray().toStdString());
+    }
+    return result;
+  }
+
+  std::vector<std::string> runFullCheck() const {
+    ElectricalRuleCheck erc(*mProject);
+    return str(erc.runChecks());
+  }
+
+  std::unique_ptr<Project> mProject;
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ElectricalRuleCheckTest, testIncrementalEqualsFullCheck) {
+  Schematic& schematic1 = addSchematic("s1");
+  Schematic& schematic2 = addSchematic("s2");
+  NetSignal& netA = addNetSignal("A");
+  NetSignal& netB = addNetSignal("B");
+  SI_NetSegment& segment1 = addNetSegment(schematic1, netA);
+  addNetPoint(segment1, Point(0, 0));
+  SI_NetSegment& segment2 = addNetSegment(schematic2, netB);
+  addNetLine(segment2, Point(0, 0), Point(1000000, 0));
+
+  ElectricalRuleCheck erc(*mProject);
+  erc.enableIncrementalChecks();
+  const std::vector<std::string> initial = runFullCheck();
+  EXPECT_EQ(3u, initial.size());  // 2x open net, 1x unconnected junction
+  EXPECT_EQ(initial, str(erc.runChecks()));
+  EXPECT_EQ(initial, str(erc.runChecks()));
+
+  // Modify items of a schematic.
+  SI_NetPoint& netPoint = addNetPoint(segment2, Point(0, 1000000));
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+  segment2.removeNetPointsAndNetLines({&netPoint}, {});
+  delete &netPoint;
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+
+  // Add and remove net segments.
+  SI_NetSegment& segment3 = addNetSegment(schematic1, netB);
+  addNetPoint(segment3, Point(0, 2000000));
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+  schematic1.removeNetSegment(segment1);
+  delete &segment1;
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+
+  // Modify the circuit.
+  netB.setName(CircuitIdentifier("C"), false);
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+  NetSignal& netD = addNetSignal("D");
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+  mProject->getCircuit().removeNetSignal(netD);
+  delete &netD;
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+
+  // Add and remove schematics.
+  Schematic& schematic3 = addSchematic("s3");
+  addNetPoint(addNetSegment(schematic3, netA), Point(0, 0));
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+  mProject->removeSchematic(schematic2, true);
+  EXPECT_EQ(runFullCheck(), str(erc.runChecks()));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,80 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/rulecheck/rulecheckmessage.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class RuleCheckMessageTest : public ::testing::Test {
+protected:
+  static std::string key(const QByteArray& approval) {
+    return RuleCheckMessage::calcApprovalKey(
+               SExpression::parse(approval, FilePath()))
+        .toHex()
+        .toStdString();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(RuleCheckMessageTest, testApprovalKeyIsStable) {
+  const QByteArray approval =
+      "(approved unused_net (net 7c7d6574-cde9-4136-a882-6a208c0ed1d0))";
+  EXPECT_EQ("8e00fd9fd1853411c4549e3b46d031b1", key(approval));
+  EXPECT_EQ(key(approval), key(approval));
+
+  const SExpression sexpr = SExpression::parse(approval, FilePath());
+  const SExpression copy = sexpr;
+  EXPECT_EQ(RuleCheckMessage::calcApprovalKey(sexpr),
+            RuleCheckMessage::calcApprovalKey(copy));
+}
+
+TEST_F(RuleCheckMessageTest, testApprovalKeyChangesWithContent) {
+  const std::string reference = key("(approved unused_net (net a))");
+  EXPECT_NE(reference, key("(approved unused_net (net b))"));
+  EXPECT_NE(reference, key("(approved unused_net (net \"a\"))"));
+  EXPECT_NE(reference, key("(approved unused_net (netclass a))"));
+  EXPECT_NE(reference, key("(approved unused_net (net a) (net a))"));
+  EXPECT_NE(reference, key("(approved unused_net (net) a)"));
+  EXPECT_NE(reference, key("(approved unused_net (net a)\n)"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
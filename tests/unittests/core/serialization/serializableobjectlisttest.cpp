@@ -156,6 +156,22 @@ TEST_F(SerializableObjectListTest, testIndexOfUuid) {
   EXPECT_EQ(1, l.indexOf(mMocks[1]->mUuid));
 }
 
+TEST_F(SerializableObjectListTest, testIndexOfUuidAfterModifications) {
+  List l{mMocks[0], mMocks[1]};
+  EXPECT_EQ(-1, l.indexOf(mMocks[2]->mUuid));  // Indexes all elements.
+  l.append(mMocks[2]);
+  EXPECT_EQ(2, l.indexOf(mMocks[2]->mUuid));
+  l.swap(0, 2);
+  EXPECT_EQ(0, l.indexOf(mMocks[2]->mUuid));
+  EXPECT_EQ(2, l.indexOf(mMocks[0].get()));
+  l.remove(1);
+  EXPECT_EQ(-1, l.indexOf(mMocks[1]->mUuid));
+  EXPECT_EQ(1, l.indexOf(mMocks[0]->mUuid));
+  l.insert(0, mMocks[1]);
+  EXPECT_EQ(0, l.indexOf(mMocks[1]->mUuid));
+  EXPECT_EQ(2, l.indexOf(mMocks[0]->mUuid));
+}
+
 TEST_F(SerializableObjectListTest, testIndexOfName) {
   List l{mMocks[0], mMocks[1], mMocks[2]};
   EXPECT_EQ(2, l.indexOf(mMocks[2]->mName));
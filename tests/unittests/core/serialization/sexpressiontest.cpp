@@ -100,6 +100,18 @@ TEST(SExpressionTest, testParseStringWithBackslash) {
   EXPECT_EQ("foo\\bar", s.getChild("@0").getValue());
 }
 
+TEST(SExpressionTest, testParseStringWithUtf8) {
+  SExpression s =
+      SExpression::parse(u8"(test \"äöü Ω\" \"µ\\\"€\\\"\")", FilePath());
+  EXPECT_EQ(2, s.getChildren().count());
+  EXPECT_EQ(QString::fromUtf8(u8"äöü Ω"), s.getChild("@0").getValue());
+  EXPECT_EQ(QString::fromUtf8(u8"µ\"€\""), s.getChild("@1").getValue());
+}
+
+TEST(SExpressionTest, testParseInvalidTokenCharacter) {
+  EXPECT_THROW(SExpression::parse(u8"(test ä)", FilePath()), RuntimeError);
+}
+
 TEST(SExpressionTest, testParseExpressionWithChildrenAndComments) {
   QByteArray input =
       "; (This whole line is a comment with CRLF line ending)\r\n"
@@ -216,6 +228,52 @@ TEST(SExpressionTest, testGetChildSkipsLineBreaks) {
   EXPECT_EQ("2", s.getChild("child/@2").getValue().toStdString());
 }
 
+TEST(SExpressionTest, testGetChildrenOfLargeList) {
+  // Enough children to get the lookups indexed.
+  SExpression s = SExpression::parse(
+      "(root \n (a 0) (b 1) \n (a 2) x (c 3) (d 4) (e 5) \n (f 6) (a 7))",
+      FilePath());
+  const SExpression& c = s;
+  EXPECT_EQ("2", c.getChild("@2/@0").getValue().toStdString());
+  EXPECT_EQ("x", c.getChild("@3").getValue().toStdString());
+  EXPECT_EQ("6", c.getChild("f/@0").getValue().toStdString());
+  EXPECT_EQ(nullptr, c.tryGetChild("g"));
+  EXPECT_EQ(nullptr, c.tryGetChild("@10"));
+  QList<const SExpression*> children = c.getChildren("a");
+  ASSERT_EQ(3, children.count());
+  EXPECT_EQ("7", children.at(2)->getChild("@0").getValue().toStdString());
+
+  // Modifications must be taken into account by subsequent lookups.
+  s.getChild("f").setName("g");
+  s.appendList("h").appendChild(SExpression::createToken("8"));
+  EXPECT_EQ(nullptr, c.tryGetChild("f"));
+  EXPECT_EQ("6", c.getChild("g/@0").getValue().toStdString());
+  EXPECT_EQ("8", c.getChild("h/@0").getValue().toStdString());
+  s.removeChild(*c.getChildren("a").first());
+  EXPECT_EQ(2, c.getChildren("a").count());
+  EXPECT_EQ("1", c.getChild("@0/@0").getValue().toStdString());
+}
+
+TEST(SExpressionTest, testGetChildrenOfLargeListAfterModifyingChildren) {
+  SExpression s = SExpression::parse(
+      "(root (a 0) (b 1) (c 2) (d 3) (e 4) (f 5) (g 6) (h 7) (i 8))",
+      FilePath());
+  const SExpression& c = s;
+  SExpression& b = s.getChild("b");
+  SExpression& i = s.getChild("i");
+  EXPECT_EQ("1", c.getChild("b/@0").getValue().toStdString());
+
+  // Modifying children through previously obtained references must be taken
+  // into account as well.
+  b.setName("x");
+  EXPECT_EQ(nullptr, c.tryGetChild("b"));
+  EXPECT_EQ("1", c.getChild("x/@0").getValue().toStdString());
+  i = SExpression::createList("b");
+  EXPECT_EQ(nullptr, c.tryGetChild("i"));
+  EXPECT_EQ(&c.getChildren().last(), &c.getChild("b"));
+  EXPECT_EQ(1, c.getChildren("b").count());
+}
+
 TEST(SExpressionTest, testRemoveChild) {
   const QByteArray input =
       "(test value\n"
@@ -244,6 +302,21 @@ TEST(SExpressionTest, testRemoveInvalidChild) {
   EXPECT_THROW(s.removeChild(child), LogicError);
 }
 
+TEST(SExpressionTest, testReplaceTokensRecursive) {
+  const QByteArray input =
+      "(test a \"a\"\n"
+      " (a b (c a))\n"
+      ")\n";
+  SExpression s = SExpression::parse(input, FilePath());
+  s.replaceTokensRecursive({{"a", "x"}, {"c", "y"}});
+  const QByteArray actual = s.toByteArray();
+  const QByteArray expected =
+      "(test x \"a\"\n"
+      " (a b (y x))\n"
+      ")\n";
+  EXPECT_EQ(expected.toStdString(), actual.toStdString());
+}
+
 TEST(SExpressionTest, testToByteArrayEmptyList) {
   SExpression s = SExpression::createList("test");
   EXPECT_EQ("(test)\n", s.toByteArray().toStdString());
@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/tracer.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TracerTest : public ::testing::Test {
+protected:
+  virtual void SetUp() override {
+    mTmpDir = FilePath::getRandomTempPath();
+    FileUtils::makePath(mTmpDir);
+  }
+
+  virtual void TearDown() override {
+    Tracer::instance().setOutputFile(FilePath());  // Disable tracing.
+    FileUtils::removeDirRecursively(mTmpDir);
+  }
+
+  static QHash<QString, QJsonObject> readEvents(const FilePath& fp) {
+    const QJsonDocument doc = QJsonDocument::fromJson(FileUtils::readFile(fp));
+    QHash<QString, QJsonObject> events;
+    foreach (const QJsonValue& value, doc.object()["traceEvents"].toArray()) {
+      const QJsonObject obj = value.toObject();
+      if (obj["cat"].toString() == "test") {
+        events.insert(obj["name"].toString(), obj);
+      }
+    }
+    return events;
+  }
+
+  FilePath mTmpDir;
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(TracerTest, testNestedSpans) {
+  const FilePath fp = mTmpDir.getPathTo("trace.json");
+  Tracer::instance().setOutputFile(fp);
+  {
+    Tracer::Span outer("test", "outer");
+    Tracer::Span inner("test", "inner", "foo");
+  }
+  Tracer::instance().save();
+
+  const QHash<QString, QJsonObject> events = readEvents(fp);
+  ASSERT_TRUE(events.contains("outer"));
+  ASSERT_TRUE(events.contains("inner"));
+  const QJsonObject outer = events["outer"];
+  const QJsonObject inner = events["inner"];
+  EXPECT_EQ("X", outer["ph"].toString());
+  EXPECT_EQ(outer["tid"].toInt(), inner["tid"].toInt());
+  EXPECT_LE(outer["ts"].toDouble(), inner["ts"].toDouble());
+  EXPECT_GE(outer["ts"].toDouble() + outer["dur"].toDouble(),
+            inner["ts"].toDouble() + inner["dur"].toDouble());
+  EXPECT_EQ("foo", inner["args"].toObject()["detail"].toString());
+}
+
+TEST_F(TracerTest, testDisabled) {
+  const FilePath fp = mTmpDir.getPathTo("trace.json");
+  Tracer::instance().setOutputFile(FilePath());
+  EXPECT_FALSE(Tracer::instance().isEnabled());
+  { Tracer::Span span("test", "disabled"); }
+  Tracer::instance().setOutputFile(fp);
+  EXPECT_TRUE(Tracer::instance().isEnabled());
+  { Tracer::Span span("test", "enabled"); }
+  Tracer::instance().save();
+
+  const QHash<QString, QJsonObject> events = readEvents(fp);
+  EXPECT_FALSE(events.contains("disabled"));
+  EXPECT_TRUE(events.contains("enabled"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
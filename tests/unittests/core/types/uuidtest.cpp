@@ -267,6 +267,10 @@ INSTANTIATE_TEST_SUITE_P(UuidTest, UuidTest, ::testing::Values(
     UuidTestData({false, "bdf7bea5b88e41b2be85c1604e8ddfca"      }),    // missing '-'
     UuidTestData({false, "{bdf7bea5-b88e-41b2-be85-c1604e8ddfca}"}),    // '{', '}'
     UuidTestData({false, "bdf7bea5-b88g-41b2-be85-c1604e8ddfca"  }),    // 'g'
+    UuidTestData({false, "bdf7bea5-b88e-41b2-be85-c1604e8ddfc`"  }),    // '`'
+    UuidTestData({false, "bdf7bea5-b88e-41b2-be85-c1604e8ddfc/"  }),    // '/'
+    UuidTestData({false, "bdf7bea5-b88e-41b2-be85-:1604e8ddfca"  }),    // ':'
+    UuidTestData({false, "bdf7bea5-b88e-41b2-be85-c1604e8ddfcš"}), // U+0161
     UuidTestData({false, "bdf7bea5_b88e_41b2_be85_c1604e8ddfca"  }),    // '_'
     UuidTestData({false, "bdf7bea5 b88e 41b2 be85 c1604e8ddfca"  })     // spaces
 ));
@@ -0,0 +1,97 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/geometry/path.h>
+#include <librepcb/core/utils/cachekeybuilder.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class CacheKeyBuilderTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(CacheKeyBuilderTest, testKeyIsStable) {
+  const Path path = Path::line(Point(0, 0), Point(1000, 2000));
+  EXPECT_EQ(CacheKeyBuilder::calcKey("a", {path}, {1, 2}),
+            CacheKeyBuilder::calcKey("a", {path}, {1, 2}));
+}
+
+TEST_F(CacheKeyBuilderTest, testKeyDependsOnContent) {
+  const Path path = Path::line(Point(0, 0), Point(1000, 2000));
+  const QByteArray key = CacheKeyBuilder::calcKey("a", {path}, {1, 2});
+  EXPECT_NE(key, CacheKeyBuilder::calcKey("b", {path}, {1, 2}));
+  EXPECT_NE(key, CacheKeyBuilder::calcKey("a", {}, {1, 2}));
+  EXPECT_NE(key, CacheKeyBuilder::calcKey("a", {path.reversed()}, {1, 2}));
+  EXPECT_NE(key, CacheKeyBuilder::calcKey("a", {path}, {2, 1}));
+  EXPECT_NE(key, CacheKeyBuilder::calcKey("a", {path}, {1, 2, 0}));
+}
+
+TEST_F(CacheKeyBuilderTest, testCalcKeyFormat) {
+  const Path path = Path::line(Point(0, 0), Point(1000, 2000));
+  CacheKeyBuilder builder;
+  builder.addType("a");
+  builder.addPaths(QVector<Path>{path});
+  builder.addValue(1);
+  builder.addValue(2);
+  EXPECT_EQ(CacheKeyBuilder::calcKey("a", {path}, {1, 2}),
+            builder.getResult());
+}
+
+TEST_F(CacheKeyBuilderTest, testStringsAreNotAmbiguous) {
+  CacheKeyBuilder builder1;
+  builder1.addString("ab");
+  builder1.addString("c");
+  CacheKeyBuilder builder2;
+  builder2.addString("a");
+  builder2.addString("bc");
+  EXPECT_NE(builder1.getResult(), builder2.getResult());
+}
+
+TEST_F(CacheKeyBuilderTest, testClipperPathsAreNotAmbiguous) {
+  const ClipperLib::Path path1 = {{0, 0}, {10, 0}};
+  const ClipperLib::Path path2 = {{10, 10}};
+  CacheKeyBuilder builder1;
+  builder1.addPaths(ClipperLib::Paths{path1, path2});
+  CacheKeyBuilder builder2;
+  builder2.addPaths(ClipperLib::Paths{path1});
+  builder2.addPaths(ClipperLib::Paths{path2});
+  EXPECT_NE(builder1.getResult(), builder2.getResult());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
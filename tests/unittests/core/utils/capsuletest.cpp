@@ -0,0 +1,90 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/geometry/padgeometry.h>
+#include <librepcb/core/utils/capsule.h>
+#include <librepcb/core/utils/transform.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class CapsuleTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(CapsuleTest, testDistanceBetweenCircles) {
+  const Capsule c1(Point(0, 0), Point(0, 0), UnsignedLength(1000));
+  const Capsule c2(Point(3000, 0), Point(3000, 0), UnsignedLength(1000));
+  Point p1, p2;
+  EXPECT_EQ(Length(2000), c1.getDistance(c2, &p1, &p2));
+  EXPECT_EQ(Point(500, 0), p1);
+  EXPECT_EQ(Point(2500, 0), p2);
+}
+
+TEST_F(CapsuleTest, testDistanceBetweenParallelSegments) {
+  const Capsule c1(Point(0, 0), Point(1000, 0), UnsignedLength(100));
+  const Capsule c2(Point(0, 500), Point(1000, 500), UnsignedLength(100));
+  EXPECT_EQ(Length(400), c1.getDistance(c2));
+  EXPECT_EQ(Length(400), c2.getDistance(c1));
+}
+
+TEST_F(CapsuleTest, testDistanceBetweenCrossingSegments) {
+  const Capsule c1(Point(-1000, 0), Point(1000, 0), UnsignedLength(200));
+  const Capsule c2(Point(0, -1000), Point(0, 1000), UnsignedLength(200));
+  EXPECT_EQ(Length(-200), c1.getDistance(c2));
+}
+
+TEST_F(CapsuleTest, testFromPadGeometry) {
+  const PadGeometry obround = PadGeometry::roundedRect(
+      PositiveLength(2000), PositiveLength(1000),
+      UnsignedLimitedRatio(Ratio::fromPercent(100)), PadHoleList());
+  tl::optional<QVector<Capsule>> capsules =
+      Capsule::fromPadGeometry(obround, Transform(Point(10000, 0)));
+  ASSERT_TRUE(capsules.has_value());
+  ASSERT_EQ(1, capsules->count());
+  EXPECT_EQ(Point(9500, 0), capsules->first().getP1());
+  EXPECT_EQ(Point(10500, 0), capsules->first().getP2());
+  EXPECT_EQ(UnsignedLength(1000), capsules->first().getDiameter());
+
+  const PadGeometry rect = PadGeometry::roundedRect(
+      PositiveLength(2000), PositiveLength(1000),
+      UnsignedLimitedRatio(Ratio::fromPercent(0)), PadHoleList());
+  EXPECT_FALSE(Capsule::fromPadGeometry(rect, Transform()).has_value());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
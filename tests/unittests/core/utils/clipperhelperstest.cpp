@@ -24,6 +24,11 @@
 #include <gtest/gtest.h>
 #include <librepcb/core/utils/clipperhelpers.h>
 
+#include <QtCore>
+
+#include <cmath>
+#include <limits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -34,7 +39,27 @@ namespace tests {
  *  Test Class
  ******************************************************************************/
 
-class ClipperHelpersTest : public ::testing::Test {};
+class ClipperHelpersTest : public ::testing::Test {
+protected:
+  static qreal distanceToOutline(const ClipperLib::IntPoint& p,
+                                 const ClipperLib::Path& path) {
+    qreal distance = std::numeric_limits<qreal>::infinity();
+    for (std::size_t i = 0; i < path.size(); ++i) {
+      const ClipperLib::IntPoint& p1 = path[i];
+      const ClipperLib::IntPoint& p2 = path[(i + 1) % path.size()];
+      const qreal dx = p2.X - p1.X;
+      const qreal dy = p2.Y - p1.Y;
+      const qreal len2 = dx * dx + dy * dy;
+      const qreal t = (len2 > 0)
+          ? qBound(qreal(0), ((p.X - p1.X) * dx + (p.Y - p1.Y) * dy) / len2,
+                   qreal(1))
+          : qreal(0);
+      distance = std::min(
+          distance, std::hypot(p.X - p1.X - t * dx, p.Y - p1.Y - t * dy));
+    }
+    return distance;
+  }
+};
 
 /*******************************************************************************
  *  Test Methods
@@ -59,6 +84,95 @@ TEST_F(ClipperHelpersTest, testConvertPathWithApproximate) {
       outputStr.toStdString());
 }
 
+TEST_F(ClipperHelpersTest, testConvertPathIntoExistingPath) {
+  Path input({Vertex(Point(0, 0), Angle::deg90()),
+              Vertex(Point(1000000, 1000000), Angle::deg0()),
+              Vertex(Point(2000000, 0), Angle::deg0())});
+  PositiveLength maxArcTolerance(10000);
+  ClipperLib::Path output{ClipperLib::IntPoint(1, 2)};
+  ClipperHelpers::convert(input, maxArcTolerance, output);
+  EXPECT_EQ(ClipperHelpers::convert(input.flattenedArcs(maxArcTolerance),
+                                    maxArcTolerance),
+            output);
+}
+
+TEST_F(ClipperHelpersTest, testConvertStrokes) {
+  Path input({Vertex(Point(0, 0), Angle::deg90()),
+              Vertex(Point(1000000, 1000000), Angle::deg0()),
+              Vertex(Point(2000000, 0), Angle::deg0())});
+  PositiveLength width(200000);
+  PositiveLength maxArcTolerance(10000);
+  EXPECT_EQ(ClipperHelpers::convert(input.toOutlineStrokes(width),
+                                    maxArcTolerance),
+            ClipperHelpers::convertStrokes(input, width, maxArcTolerance));
+}
+
+TEST_F(ClipperHelpersTest, testIntersectToTreeDisjointAndOverlapping) {
+  const ClipperLib::Paths a{ClipperHelpers::convert(
+      Path::rect(Point(0, 0), Point(1000, 1000)), PositiveLength(1))};
+  const ClipperLib::Paths b{ClipperHelpers::convert(
+      Path::rect(Point(2000, 0), Point(3000, 1000)), PositiveLength(1))};
+  const ClipperLib::Paths c{ClipperHelpers::convert(
+      Path::rect(Point(500, 500), Point(1500, 1500)), PositiveLength(1))};
+
+  std::unique_ptr<ClipperLib::PolyTree> disjoint =
+      ClipperHelpers::intersectToTree(a, b, ClipperLib::pftEvenOdd,
+                                      ClipperLib::pftEvenOdd);
+  EXPECT_EQ(0, disjoint->Total());
+
+  std::unique_ptr<ClipperLib::PolyTree> overlapping =
+      ClipperHelpers::intersectToTree(a, c, ClipperLib::pftEvenOdd,
+                                      ClipperLib::pftEvenOdd);
+  const ClipperLib::Paths paths = ClipperHelpers::treeToPaths(*overlapping);
+  ASSERT_EQ(1U, paths.size());
+  EXPECT_DOUBLE_EQ(250000.0, std::abs(ClipperLib::Area(paths.front())));
+}
+
+TEST_F(ClipperHelpersTest, testSimplifyWithinTolerance) {
+  // A finely flattened circle, where removing many consecutive vertices
+  // would accumulate the deviation.
+  ClipperLib::Path circle;
+  for (int i = 0; i < 2000; ++i) {
+    const qreal angle = 2 * M_PI * i / 2000;
+    circle.push_back(ClipperLib::IntPoint(std::lround(1e6 * std::cos(angle)),
+                                          std::lround(1e6 * std::sin(angle))));
+  }
+  const qreal tolerance = 1000;
+  ClipperLib::Paths paths = {circle};
+  ClipperHelpers::simplify(paths, PositiveLength(1000));
+  ASSERT_EQ(1u, paths.size());
+  const ClipperLib::Path& simplified = paths.front();
+  EXPECT_GT(simplified.size(), 3u);
+  EXPECT_LT(simplified.size(), circle.size() / 10);
+
+  // Original outline must be within the tolerance of the simplified outline.
+  for (const ClipperLib::IntPoint& p : circle) {
+    EXPECT_LE(distanceToOutline(p, simplified), tolerance);
+  }
+
+  // Simplified outline must be within the tolerance of the original outline,
+  // checked at some points along each simplified segment.
+  for (std::size_t i = 0; i < simplified.size(); ++i) {
+    const ClipperLib::IntPoint& p1 = simplified[i];
+    const ClipperLib::IntPoint& p2 = simplified[(i + 1) % simplified.size()];
+    for (int j = 0; j <= 10; ++j) {
+      const ClipperLib::IntPoint p(p1.X + (p2.X - p1.X) * j / 10,
+                                   p1.Y + (p2.Y - p1.Y) * j / 10);
+      EXPECT_LE(distanceToOutline(p, circle), tolerance + 1);
+    }
+  }
+}
+
+TEST_F(ClipperHelpersTest, testSimplifyRemovesDegeneratedPaths) {
+  ClipperLib::Paths paths = {
+      {{0, 0}, {1000000, 0}, {1000000, 500}, {0, 500}},  // Narrow sliver
+      {{0, 0}, {1000000, 0}, {1000000, 1000000}, {0, 1000000}},  // Square
+  };
+  ClipperHelpers::simplify(paths, PositiveLength(1000));
+  ASSERT_EQ(1u, paths.size());
+  EXPECT_EQ(4u, paths.front().size());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,102 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/geometry/path.h>
+#include <librepcb/core/utils/polygoncontainmentindex.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PolygonContainmentIndexTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PolygonContainmentIndexTest, testEmpty) {
+  PolygonContainmentIndex index({});
+  EXPECT_FALSE(index.contains(Point(0, 0)));
+}
+
+TEST_F(PolygonContainmentIndexTest, testConcavePolygon) {
+  // L-shaped polygon, implicitly closed.
+  const PolygonContainmentIndex index({
+      Vertex(Point(0, 0)),
+      Vertex(Point(1000, 0)),
+      Vertex(Point(1000, 400)),
+      Vertex(Point(400, 400)),
+      Vertex(Point(400, 1000)),
+      Vertex(Point(0, 1000)),
+  });
+  EXPECT_EQ(0, index.getBounds().left);
+  EXPECT_EQ(0, index.getBounds().top);
+  EXPECT_EQ(1000, index.getBounds().right);
+  EXPECT_EQ(1000, index.getBounds().bottom);
+  EXPECT_TRUE(index.contains(Point(200, 200)));
+  EXPECT_TRUE(index.contains(Point(800, 200)));
+  EXPECT_TRUE(index.contains(Point(200, 800)));
+  EXPECT_FALSE(index.contains(Point(800, 800)));
+  EXPECT_FALSE(index.contains(Point(-100, 200)));
+  EXPECT_FALSE(index.contains(Point(200, 1100)));
+}
+
+TEST_F(PolygonContainmentIndexTest, testSameResultAsQPainterPath) {
+  // Comb-like polygon with many edges to get several bands.
+  QVector<Vertex> vertices;
+  for (int i = 0; i < 100; ++i) {
+    vertices.append(Vertex(Point(i * 20000, 0)));
+    vertices.append(Vertex(Point(i * 20000 + 10000, 500000 + (i % 7) * 3000)));
+  }
+  vertices.append(Vertex(Point(2000000, 0)));
+  vertices.append(Vertex(Point(2000000, -100000)));
+  vertices.append(Vertex(Point(0, -100000)));
+  const PolygonContainmentIndex index(vertices);
+  const QPainterPath reference = Path(vertices).toQPainterPathPx();
+
+  // Deterministic pseudo-random points (not exactly on the outline).
+  quint32 seed = 2023;
+  auto random = [&seed](int max) {
+    seed = seed * 1103515245U + 12345U;
+    return static_cast<int>((seed >> 8) % max);
+  };
+  for (int i = 0; i < 500; ++i) {
+    const Point p(random(2100000) - 50000 + 1, random(700000) - 150000 + 1);
+    EXPECT_EQ(reference.contains(p.toPxQPointF()), index.contains(p))
+        << p.getX().toNm() << "/" << p.getY().toNm();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -100,6 +100,27 @@ TEST(SignalSlotTest, testDuringCallbackDetachedSlotsAreNotCalled) {
   EXPECT_EQ(1, callbackCounter);
 }
 
+TEST(SignalSlotTest, testDeferredNotificationsAreCoalesced) {
+  Sender sender;
+  QList<int> values;
+  Slot<Sender, int> slot(
+      [&](const Sender&, int value) { values.append(value); });
+  sender.signal.attach(slot);
+  {
+    Signal<Sender, int>::Deferrer deferrer(sender.signal);
+    {
+      Signal<Sender, int>::Deferrer nestedDeferrer(sender.signal);
+      sender.signal.notify(1);
+      sender.signal.notify(2);
+    }
+    sender.signal.notify(1);
+    EXPECT_EQ(QList<int>{}, values);
+  }
+  EXPECT_EQ((QList<int>{1, 2}), values);
+  sender.signal.notify(1);
+  EXPECT_EQ((QList<int>{1, 2, 1}), values);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
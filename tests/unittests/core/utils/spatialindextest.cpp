@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/utils/spatialindex.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SpatialIndexTest : public ::testing::Test {
+protected:
+  static ClipperLib::IntRect rect(ClipperLib::cInt x, ClipperLib::cInt y,
+                                  ClipperLib::cInt size) {
+    return ClipperLib::IntRect{x, y, x + size, y + size};
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SpatialIndexTest, testEmpty) {
+  SpatialIndex index;
+  EXPECT_EQ(0, index.getCount());
+  EXPECT_TRUE(index.query(rect(0, 0, 10)).isEmpty());
+  EXPECT_TRUE(index.findOverlappingPairs().isEmpty());
+}
+
+TEST_F(SpatialIndexTest, testInvalidRectsAreIgnored) {
+  const ClipperLib::IntRect invalid{10, 10, 0, 0};
+  SpatialIndex index({invalid, rect(0, 0, 10), invalid});
+  EXPECT_EQ(3, index.getCount());
+  EXPECT_EQ(QVector<int>{1}, index.query(rect(5, 5, 100)));
+  EXPECT_TRUE(index.query(invalid).isEmpty());
+  EXPECT_TRUE(index.findOverlappingPairs().isEmpty());
+}
+
+TEST_F(SpatialIndexTest, testTouchingRectsOverlap) {
+  SpatialIndex index({rect(0, 0, 10), rect(10, 0, 10), rect(21, 0, 10)});
+  const QVector<std::pair<int, int>> expected = {std::make_pair(0, 1)};
+  EXPECT_EQ(expected, index.findOverlappingPairs());
+}
+
+TEST_F(SpatialIndexTest, testCompareWithBruteForce) {
+  // Pseudo-random but deterministic rectangles of very different sizes, to
+  // get a tree with several levels.
+  QVector<ClipperLib::IntRect> rects;
+  quint32 seed = 42;
+  auto next = [&seed]() {
+    seed = seed * 1103515245u + 12345u;
+    return static_cast<ClipperLib::cInt>((seed >> 8) % 100000);
+  };
+  for (int i = 0; i < 2000; ++i) {
+    rects.append(rect(next(), next(), next() / ((i % 10) ? 100 : 5)));
+  }
+  SpatialIndex index(rects);
+
+  QVector<std::pair<int, int>> expected;
+  for (int i = 0; i < rects.count(); ++i) {
+    for (int k = i + 1; k < rects.count(); ++k) {
+      if (SpatialIndex::intersects(rects.at(i), rects.at(k))) {
+        expected.append(std::make_pair(i, k));
+      }
+    }
+  }
+  EXPECT_EQ(expected, index.findOverlappingPairs());
+
+  const ClipperLib::IntRect area = rect(20000, 30000, 15000);
+  QVector<int> expectedQuery;
+  for (int i = 0; i < rects.count(); ++i) {
+    if (SpatialIndex::intersects(rects.at(i), area)) {
+      expectedQuery.append(i);
+    }
+  }
+  EXPECT_EQ(expectedQuery, index.query(area));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
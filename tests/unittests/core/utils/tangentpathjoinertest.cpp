@@ -351,6 +351,28 @@ TEST_F(TangentPathJoinerTest, testManyTangentPaths) {
   EXPECT_EQ(str(expected), str(output)) << debug(expected, output);
 }
 
+// For testing performance with many ambiguous junctions, which took
+// exponential time with an exhaustive search.
+TEST_F(TangentPathJoinerTest, testLadder) {
+  QVector<Path> input;
+  for (int i = 0; i < 100; ++i) {
+    input.append(Path::line(Point(i, 0), Point(i + 1, 0)));
+    input.append(Path::line(Point(i, 1), Point(i + 1, 1)));
+    input.append(Path::line(Point(i, 0), Point(i, 1)));
+  }
+  input.append(Path::line(Point(100, 0), Point(100, 1)));
+  bool timedOut = false;
+  QVector<Path> output = TangentPathJoiner::join(input, 10000, &timedOut);
+  EXPECT_FALSE(timedOut);
+  int segments = 0;
+  foreach (const Path& path, output) {
+    segments += path.getVertices().count() - 1;
+  }
+  EXPECT_EQ(input.count(), segments);
+  ASSERT_FALSE(output.isEmpty());
+  EXPECT_TRUE(output.first().isClosed());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -331,6 +331,77 @@ static ToolboxFloatToStringTestData
 INSTANTIATE_TEST_SUITE_P(ToolboxFloatToStringTest, ToolboxFloatToStringTest,
                          ::testing::ValuesIn(sToolboxFloatToStringTestData));
 
+/*******************************************************************************
+ *  Tests for appendInteger() and appendDecimalFixedPoint()
+ ******************************************************************************/
+
+TEST_F(ToolboxTest, testAppendInteger) {
+  const QVector<qint64> values = {
+      0,
+      1,
+      -1,
+      10,
+      -10,
+      123456789,
+      -987654321,
+      std::numeric_limits<qint64>::max(),
+      std::numeric_limits<qint64>::min(),
+  };
+  foreach (qint64 value, values) {
+    QByteArray output("prefix");
+    Toolbox::appendInteger(output, value);
+    EXPECT_EQ(("prefix" + QString::number(value)).toStdString(),
+              output.toStdString());
+  }
+}
+
+TEST_F(ToolboxTest, testDecimalFixedPointToString) {
+  const QVector<std::tuple<qint64, int, QString>> values = {
+      std::make_tuple(0, 6, "0.0"),
+      std::make_tuple(1, 6, "0.000001"),
+      std::make_tuple(-5, 1, "-0.5"),
+      std::make_tuple(100000, 6, "0.1"),
+      std::make_tuple(-1000000, 6, "-1.0"),
+      std::make_tuple(1234567, 3, "1234.567"),
+      std::make_tuple(12000000, 6, "12.0"),
+      std::make_tuple(std::numeric_limits<qint64>::max(), 6,
+                      "9223372036854.775807"),
+  };
+  for (const auto& value : values) {
+    const QString str = Toolbox::decimalFixedPointToString(std::get<0>(value),
+                                                           std::get<1>(value));
+    EXPECT_EQ(std::get<2>(value).toStdString(), str.toStdString());
+    EXPECT_EQ(std::get<0>(value),
+              Toolbox::decimalFixedPointFromString<qint64>(
+                  str, std::get<1>(value)));
+  }
+}
+
+TEST_F(ToolboxTest, testAppendDecimalFixedPoint) {
+  const QVector<qint64> values = {
+      0,
+      1,
+      -5,
+      100000,
+      -1000000,
+      1234567,
+      12000000,
+      -999999999,
+      123456789012345,
+      std::numeric_limits<qint64>::max(),
+  };
+  foreach (qint64 value, values) {
+    for (int pointPos : {1, 3, 6}) {
+      QByteArray output("prefix");
+      Toolbox::appendDecimalFixedPoint(output, value, pointPos);
+      EXPECT_EQ(
+          ("prefix" + Toolbox::decimalFixedPointToString(value, pointPos))
+              .toStdString(),
+          output.toStdString());
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
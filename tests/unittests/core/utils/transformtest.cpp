@@ -143,6 +143,20 @@ TEST_F(TransformTest, testMapPathMirrored) {
   EXPECT_EQ(str(expected), str(t.map(input)));
 }
 
+TEST_F(TransformTest, testMapTemporaryPathMirrored) {
+  Transform t(Point(1000, 2000), Angle(30000000), true);
+  Path input({
+      Vertex(Point(0, 0), Angle::deg90()),
+      Vertex(Point(4567, 9876), Angle::deg0()),
+  });
+  Path expected({
+      Vertex(Point(1000, 2000), -Angle::deg90()),
+      Vertex(Point(-7893, 8269), Angle::deg0()),
+  });
+  EXPECT_EQ(str(expected), str(t.map(Path(input))));
+  EXPECT_EQ(str(expected), str(t.map(input.translated(Point(0, 0)))));
+}
+
 TEST_F(TransformTest, testMapLayerNonMirrored) {
   Transform t(Point(1000, 2000), Angle(3000), false);
   EXPECT_EQ(str(Layer::symbolOutlines()), str(t.map(Layer::symbolOutlines())));
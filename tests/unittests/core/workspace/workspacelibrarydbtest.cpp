@@ -34,6 +34,8 @@
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 #include <librepcb/core/workspace/workspacelibrarydbwriter.h>
 
+#include <QSignalSpy>
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -202,6 +204,15 @@ TEST_F(WorkspaceLibraryDbTest, testGetAll) {
             str(mWsDb->getAll<Device>()));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testGetAllFromOtherThread) {
+  mWriter->addElement<Symbol>(0, toAbs("sym"), uuid(), version("0.1"), false);
+
+  // Uses a read-only connection of the worker thread.
+  QFuture<QMultiMap<Version, FilePath>> future =
+      QtConcurrent::run([this]() { return mWsDb->getAll<Symbol>(); });
+  EXPECT_EQ(str({{version("0.1"), toAbs("sym")}}), str(future.result()));
+}
+
 // Further tests only check with Symbol, since the implementation is the same
 // for all library element types and the tests above have proven that each
 // element type is generally working.
@@ -405,6 +416,31 @@ TEST_F(WorkspaceLibraryDbTest, testFindWithMultipleTranslations) {
             str(mWsDb->find<Symbol>("sym1 en_US name")));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testFindSubstring) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray(), QString());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym1 name"),
+                                  "the sym1 desc", "the sym1 keywords");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.2"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("the sym2 name"),
+                                  "the sym2 desc", "the sym2 keywords");
+
+  // Keywords shorter than 3 characters are not supported by the search
+  // index, so test both short and long keywords.
+  EXPECT_EQ(str(QList<Uuid>{uuid(1), uuid(2)}),
+            str(mWsDb->find<Symbol>("ym")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}), str(mWsDb->find<Symbol>("m2")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->find<Symbol>("YM1 NA")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}), str(mWsDb->find<Symbol>("2 keyw")));
+
+  // Removed elements must not be found anymore.
+  mWriter->removeElement<Symbol>(toAbs("sym1"));
+  EXPECT_EQ(str(QList<Uuid>{uuid(2)}), str(mWsDb->find<Symbol>("name")));
+}
+
 /*******************************************************************************
  *  Tests for getTranslations()
  ******************************************************************************/
@@ -651,6 +687,53 @@ TEST_F(WorkspaceLibraryDbTest, testGetMetadataNullptr) {
   EXPECT_TRUE(retDeprecated);
 }
 
+TEST_F(WorkspaceLibraryDbTest, testGetMetadataCachedUntilScanSucceeded) {
+  FilePath fp = toAbs("fp");
+  mWriter->addElement<Symbol>(0, fp, uuid(1), version("1.1"), true);
+  testGetMetadata<Symbol>(*mWsDb, fp, true, uuid(1), version("1.1"), true);
+
+  // Modifications are not visible until the database signals a finished scan.
+  mWriter->removeElement<Symbol>(fp);
+  mWriter->addElement<Symbol>(0, fp, uuid(2), version("2.2"), false);
+  testGetMetadata<Symbol>(*mWsDb, fp, true, uuid(1), version("1.1"), true);
+  emit mWsDb->scanSucceeded(1);
+  testGetMetadata<Symbol>(*mWsDb, fp, true, uuid(2), version("2.2"), false);
+}
+
+/*******************************************************************************
+ *  Tests for preloadMetadata()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testPreloadMetadata) {
+  int lib1 = mWriter->addLibrary(toAbs("lib1"), uuid(), version("1"), false,
+                                 QByteArray(), QString());
+  int lib2 = mWriter->addLibrary(toAbs("lib2"), uuid(), version("2"), false,
+                                 QByteArray(), QString());
+  int sym1 = mWriter->addElement<Symbol>(lib1, toAbs("lib1/sym1"), uuid(1),
+                                         version("0.1"), true);
+  mWriter->addTranslation<Symbol>(sym1, "", ElementName("foo"), tl::nullopt,
+                                  tl::nullopt);
+  mWriter->addElement<Symbol>(lib1, toAbs("lib1/sym2"), uuid(2),
+                              version("0.2"), false);
+  mWriter->addElement<Symbol>(lib2, toAbs("lib2/sym3"), uuid(3),
+                              version("0.3"), false);
+  mWsDb->preloadMetadata<Symbol>(toAbs("lib1"));
+
+  // Modifications are not visible for the preloaded elements, proving that
+  // their data is returned from the cache.
+  mWriter->removeElement<Symbol>(toAbs("lib1/sym1"));
+  mWriter->removeElement<Symbol>(toAbs("lib1/sym2"));
+  mWriter->removeElement<Symbol>(toAbs("lib2/sym3"));
+  testGetMetadata<Symbol>(*mWsDb, toAbs("lib1/sym1"), true, uuid(1),
+                          version("0.1"), true);
+  testGetMetadata<Symbol>(*mWsDb, toAbs("lib1/sym2"), true, uuid(2),
+                          version("0.2"), false);
+  testGetMetadata<Symbol>(*mWsDb, toAbs("lib2/sym3"), false, tl::nullopt,
+                          tl::nullopt, tl::nullopt);
+  testGetTr<Symbol>(*mWsDb, toAbs("lib1/sym1"), {}, true, "foo", "", "");
+  testGetTr<Symbol>(*mWsDb, toAbs("lib1/sym2"), {}, false, "", "", "");
+}
+
 /*******************************************************************************
  *  Tests for getLibraryMetadata()
  ******************************************************************************/
@@ -795,6 +878,33 @@ TEST_F(WorkspaceLibraryDbTest, testGetDeviceMetadataNullptr) {
   EXPECT_EQ(str(uuid(2)), str(pkgUuid));
 }
 
+/*******************************************************************************
+ *  Tests for getCheckMessages()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testGetCheckMessagesInexistent) {
+  EXPECT_EQ(0, mWsDb->getCheckMessages<Symbol>(toAbs("fp")).count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetCheckMessages) {
+  FilePath fp = toAbs("fp");
+  int id = mWriter->addElement<Symbol>(0, fp, uuid(), version("1"), false);
+  mWriter->addCheckMessage<Symbol>(id, RuleCheckMessage::Severity::Hint, "a");
+  mWriter->addCheckMessage<Symbol>(id, RuleCheckMessage::Severity::Error, "b");
+
+  QList<WorkspaceLibraryDb::CheckMessage> messages =
+      mWsDb->getCheckMessages<Symbol>(fp);
+  ASSERT_EQ(2, messages.count());
+  EXPECT_EQ(RuleCheckMessage::Severity::Error, messages.at(0).severity);
+  EXPECT_EQ("b", messages.at(0).message.toStdString());
+  EXPECT_EQ(RuleCheckMessage::Severity::Hint, messages.at(1).severity);
+  EXPECT_EQ("a", messages.at(1).message.toStdString());
+
+  // Messages are removed together with the element.
+  mWriter->removeElement<Symbol>(fp);
+  EXPECT_EQ(0, mWsDb->getCheckMessages<Symbol>(fp).count());
+}
+
 /*******************************************************************************
  *  Tests for getChilds()
  ******************************************************************************/
@@ -1012,6 +1122,31 @@ TEST_F(WorkspaceLibraryDbTest, testGetComponentDevicesDuplicates) {
   EXPECT_EQ(str(QSet<Uuid>{uuid(1)}), str(mWsDb->getComponentDevices(uuid(0))));
 }
 
+/*******************************************************************************
+ *  Tests for setWatchingEnabled()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testWatchingAddedElementTriggersRescan) {
+  const FilePath symDir = toAbs("local/lib.lplib/sym");
+  FileUtils::makePath(symDir);
+  mWsDb->setWatchingEnabled(true);
+
+  QSignalSpy spy(mWsDb.get(), &WorkspaceLibraryDb::scanStarted);
+  FileUtils::makePath(symDir.getPathTo(uuid().toStr()));
+  EXPECT_TRUE(spy.wait(5000));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testWatchingIgnoresHiddenEntries) {
+  const FilePath libDir = toAbs("local/lib.lplib");
+  FileUtils::makePath(libDir.getPathTo("sym"));
+  mWsDb->setWatchingEnabled(true);
+
+  QSignalSpy spy(mWsDb.get(), &WorkspaceLibraryDb::scanStarted);
+  FileUtils::writeFile(libDir.getPathTo(".lock"), "lock");
+  FileUtils::makePath(libDir.getPathTo(".autosave"));
+  EXPECT_FALSE(spy.wait(2000));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,125 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/library.h>
+#include <librepcb/core/library/sym/symbol.h>
+#include <librepcb/core/sqlitedatabase.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
+
+#include <QSignalSpy>
+#include <QtCore>
+#include <QtSql>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryScannerTest : public ::testing::Test {
+protected:
+  FilePath mWsDir;
+  FilePath mSymDir;
+  std::unique_ptr<WorkspaceLibraryDb> mWsDb;
+  QLocale mOldLocale;
+
+  WorkspaceLibraryScannerTest() : mWsDir(FilePath::getRandomTempPath()) {
+    // Create a library containing a symbol which has some check messages.
+    const FilePath libDir = mWsDir.getPathTo("local/lib.lplib");
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(libDir);
+    TransactionalDirectory dir(fs);
+    Library lib(Uuid::createRandom(), Version::fromString("1"), "",
+                ElementName("lib"), "", "");
+    lib.moveTo(dir);
+    Symbol sym(Uuid::createRandom(), Version::fromString("1"), "",
+               ElementName("sym"), "", "");
+    TransactionalDirectory symDir(fs, "sym/" % sym.getUuid().toStr());
+    sym.saveTo(symDir);
+    fs->save();
+    mSymDir = libDir.getPathTo("sym/" % sym.getUuid().toStr());
+
+    mWsDb.reset(new WorkspaceLibraryDb(mWsDir));
+  }
+
+  virtual ~WorkspaceLibraryScannerTest() {
+    mWsDb.reset();
+    QLocale::setDefault(mOldLocale);
+    QDir(mWsDir.toStr()).removeRecursively();
+  }
+
+  void scan() {
+    QSignalSpy spy(mWsDb.get(), &WorkspaceLibraryDb::scanSucceeded);
+    mWsDb->startLibraryRescan();
+    ASSERT_TRUE(spy.wait(10000));
+  }
+
+  std::string getCheckMessagesLocale() {
+    SQLiteDatabase db(mWsDb->getFilePath());
+    QSqlQuery query = db.prepareQuery(
+        "SELECT value_text FROM internal WHERE key = 'check_messages_locale'");
+    db.exec(query);
+    return query.next() ? query.value(0).toString().toStdString() : "";
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryScannerTest, testCheckMessagesStored) {
+  Symbol sym(Uuid::createRandom(), Version::fromString("1"), "",
+             ElementName("sym"), "", "");
+  const int expected = sym.runChecks().count();
+  ASSERT_GT(expected, 0);
+
+  scan();
+  EXPECT_EQ(expected, mWsDb->getCheckMessages<Symbol>(mSymDir).count());
+}
+
+TEST_F(WorkspaceLibraryScannerTest, testCheckMessagesUpdatedOnLocaleChange) {
+  QLocale::setDefault(QLocale("en_US"));
+  scan();
+  EXPECT_EQ("en_US", getCheckMessagesLocale());
+  const int count = mWsDb->getCheckMessages<Symbol>(mSymDir).count();
+  EXPECT_GT(count, 0);
+
+  // The unmodified element is checked again in the new language.
+  QLocale::setDefault(QLocale("de_DE"));
+  scan();
+  EXPECT_EQ("de_DE", getCheckMessagesLocale());
+  EXPECT_EQ(count, mWsDb->getCheckMessages<Symbol>(mSymDir).count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
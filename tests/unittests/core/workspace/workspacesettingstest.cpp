@@ -87,7 +87,10 @@ TEST_F(WorkspaceSettingsTest, testLoadFromSExpressionCurrentVersion) {
       " (application_locale \"de_CH\")\n"
       " (default_length_unit micrometers)\n"
       " (project_autosave_interval 120)\n"
+      " (undo_limit 500)\n"
+      " (worker_threads 4)\n"
       " (use_opengl true)\n"
+      " (show_render_statistics true)\n"
       " (library_locale_order\n"
       "  (locale \"de_DE\")\n"
       " )\n"
@@ -119,7 +122,10 @@ TEST_F(WorkspaceSettingsTest, testLoadFromSExpressionCurrentVersion) {
   EXPECT_EQ("de_CH", obj.applicationLocale.get());
   EXPECT_EQ(LengthUnit::micrometers(), obj.defaultLengthUnit.get());
   EXPECT_EQ(120U, obj.projectAutosaveIntervalSeconds.get());
+  EXPECT_EQ(500U, obj.undoLimit.get());
+  EXPECT_EQ(4U, obj.workerThreads.get());
   EXPECT_EQ(true, obj.useOpenGl.get());
+  EXPECT_EQ(true, obj.showRenderStatistics.get());
   EXPECT_EQ(QStringList{"de_DE"}, obj.libraryLocaleOrder.get());
   EXPECT_EQ(QStringList{"IEC 60617"}, obj.libraryNormOrder.get());
   EXPECT_EQ(QList<QUrl>{QUrl("https://api.librepcb.org")},
@@ -141,7 +147,10 @@ TEST_F(WorkspaceSettingsTest, testStoreAndLoad) {
   obj1.applicationLocale.set("de_CH");
   obj1.defaultLengthUnit.set(LengthUnit::nanometers());
   obj1.projectAutosaveIntervalSeconds.set(1234);
+  obj1.undoLimit.set(42);
+  obj1.workerThreads.set(3);
   obj1.useOpenGl.set(!obj1.useOpenGl.get());
+  obj1.showRenderStatistics.set(!obj1.showRenderStatistics.get());
   obj1.libraryLocaleOrder.set({"de_CH", "en_US"});
   obj1.libraryNormOrder.set({"foo", "bar"});
   obj1.apiEndpoints.set({QUrl("https://foo"), QUrl("https://bar")});
@@ -161,7 +170,11 @@ TEST_F(WorkspaceSettingsTest, testStoreAndLoad) {
   EXPECT_EQ(obj1.defaultLengthUnit.get(), obj2.defaultLengthUnit.get());
   EXPECT_EQ(obj1.projectAutosaveIntervalSeconds.get(),
             obj2.projectAutosaveIntervalSeconds.get());
+  EXPECT_EQ(obj1.undoLimit.get(), obj2.undoLimit.get());
+  EXPECT_EQ(obj1.workerThreads.get(), obj2.workerThreads.get());
   EXPECT_EQ(obj1.useOpenGl.get(), obj2.useOpenGl.get());
+  EXPECT_EQ(obj1.showRenderStatistics.get(),
+            obj2.showRenderStatistics.get());
   EXPECT_EQ(obj1.libraryLocaleOrder.get(), obj2.libraryLocaleOrder.get());
   EXPECT_EQ(obj1.libraryNormOrder.get(), obj2.libraryNormOrder.get());
   EXPECT_EQ(obj1.apiEndpoints.get(), obj2.apiEndpoints.get());
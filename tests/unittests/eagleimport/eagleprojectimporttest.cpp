@@ -125,6 +125,35 @@ TEST_F(EagleProjectImportTest, testImportWithBoard) {
   }
 }
 
+TEST_F(EagleProjectImportTest, testMessagesLoggedOnce) {
+  // Capture all printed messages.
+  static QStringList printed;
+  printed.clear();
+  QtMessageHandler oldHandler = qInstallMessageHandler(
+      [](QtMsgType type, const QMessageLogContext& context,
+         const QString& msg) {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        printed.append(msg);
+      });
+
+  {
+    EagleProjectImport import;
+    import.open(getSch(), getBrd());
+    std::unique_ptr<Project> project =
+        Project::create(getProjectDir(), "test.lpp");
+    import.import(*project);
+
+    // Each recorded message must have been printed exactly once, also those
+    // collected in worker threads.
+    const QStringList recorded = import.getLogger()->getMessagesPlain();
+    qInstallMessageHandler(oldHandler);
+    foreach (const QString& msg, recorded) {
+      EXPECT_EQ(recorded.count(msg), printed.count(msg)) << msg.toStdString();
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
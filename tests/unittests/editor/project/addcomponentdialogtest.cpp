@@ -195,6 +195,7 @@ TEST_F(AddComponentDialogTest, testChooseComponentDevice) {
   // Select cat 2
   QModelIndex cat1Index = catView.model()->index(0, 0);
   EXPECT_EQ("cat 1", cat1Index.data().toString().toStdString());
+  catView.model()->fetchMore(cat1Index);  // Childs are loaded on demand.
   QModelIndex cat2Index = catView.model()->index(0, 0, cat1Index);
   EXPECT_EQ("cat 2", cat2Index.data().toString().toStdString());
   catView.setCurrentIndex(cat2Index);
@@ -296,9 +297,10 @@ TEST_F(AddComponentDialogTest, testSearch) {
   QTreeWidget& cmpView =
       TestHelpers::getChild<QTreeWidget>(dialog, "treeComponents");
 
-  // Search "cmp" -> 2 results
+  // Search "cmp" -> 2 results (search is delayed while typing)
   edtSearch.setText("cmp");
-  EXPECT_EQ(2, cmpView.model()->rowCount());
+  EXPECT_TRUE(TestHelpers::waitFor(
+      [&]() { return cmpView.model()->rowCount() == 2; }));
   EXPECT_EQ("cmp 1",
             cmpView.model()->index(0, 0).data().toString().toStdString());
   EXPECT_EQ("cmp 2",
@@ -306,11 +308,13 @@ TEST_F(AddComponentDialogTest, testSearch) {
 
   // Search "foo" -> 0 results
   edtSearch.setText("foo");
-  EXPECT_EQ(0, cmpView.model()->rowCount());
+  EXPECT_TRUE(TestHelpers::waitFor(
+      [&]() { return cmpView.model()->rowCount() == 0; }));
 
   // Search "key" -> 1 results
   edtSearch.setText("key");
-  EXPECT_EQ(1, cmpView.model()->rowCount());
+  EXPECT_TRUE(TestHelpers::waitFor(
+      [&]() { return cmpView.model()->rowCount() == 1; }));
   EXPECT_EQ("cmp 1",
             cmpView.model()->index(0, 0).data().toString().toStdString());
 }
@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 #include <librepcb/core/attribute/attrtypestring.h>
 #include <librepcb/core/attribute/attrtypevoltage.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
 #include <librepcb/core/types/layer.h>
 #include <librepcb/editor/project/boardeditor/boardclipboarddata.h>
 
@@ -238,6 +239,42 @@ TEST(BoardClipboardDataTest, testToFromMimeDataPopulated) {
   EXPECT_EQ(obj1.getStrokeTexts(), obj2->getStrokeTexts());
   EXPECT_EQ(obj1.getHoles(), obj2->getHoles());
   EXPECT_EQ(obj1.getPadPositions(), obj2->getPadPositions());
+
+  // Load from a plain copy of the MIME data (like pasting into another
+  // application instance) to validate the serialized content
+  QMimeData mime2;
+  foreach (const QString& format, mime1->formats()) {
+    mime2.setData(format, mime1->data(format));
+  }
+  std::unique_ptr<BoardClipboardData> obj3 =
+      BoardClipboardData::fromMimeData(&mime2);
+  EXPECT_EQ(uuid, obj3->getBoardUuid());
+  EXPECT_EQ(pos, obj3->getCursorPos());
+  EXPECT_EQ(obj1.getDevices(), obj3->getDevices());
+  EXPECT_EQ(obj1.getNetSegments(), obj3->getNetSegments());
+  EXPECT_EQ(obj1.getPlanes(), obj3->getPlanes());
+  EXPECT_EQ(obj1.getZones(), obj3->getZones());
+  EXPECT_EQ(obj1.getPolygons(), obj3->getPolygons());
+  EXPECT_EQ(obj1.getStrokeTexts(), obj3->getStrokeTexts());
+  EXPECT_EQ(obj1.getHoles(), obj3->getHoles());
+  EXPECT_EQ(obj1.getPadPositions(), obj3->getPadPositions());
+}
+
+TEST(BoardClipboardDataTest, testTemporaryDirectoryRemoved) {
+  std::unique_ptr<BoardClipboardData> obj1(
+      new BoardClipboardData(Uuid::createRandom(), Point()));
+  std::unique_ptr<QMimeData> mime1 = obj1->toMimeData();
+  std::unique_ptr<TransactionalDirectory> dir = obj1->getDirectory();
+  const FilePath fp = dir->getAbsPath();
+  EXPECT_TRUE(fp.isExistingDir());
+
+  // The directory must be kept as long as any copy of the data exists.
+  obj1.reset();
+  EXPECT_TRUE(fp.isExistingDir());
+  mime1.reset();
+  EXPECT_TRUE(fp.isExistingDir());
+  dir.reset();
+  EXPECT_FALSE(fp.isExistingDir());
 }
 
 /*******************************************************************************
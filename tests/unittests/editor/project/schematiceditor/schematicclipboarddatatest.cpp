@@ -209,6 +209,22 @@ TEST(SchematicClipboardDataTest, testToFromMimeDataPopulated) {
   EXPECT_EQ(obj1.getSymbolInstances(), obj2->getSymbolInstances());
   EXPECT_EQ(obj1.getPolygons(), obj2->getPolygons());
   EXPECT_EQ(obj1.getTexts(), obj2->getTexts());
+
+  // Load from a plain copy of the MIME data (like pasting into another
+  // application instance) to validate the serialized content
+  QMimeData mime2;
+  foreach (const QString& format, mime1->formats()) {
+    mime2.setData(format, mime1->data(format));
+  }
+  std::unique_ptr<SchematicClipboardData> obj3 =
+      SchematicClipboardData::fromMimeData(&mime2);
+  EXPECT_EQ(uuid, obj3->getSchematicUuid());
+  EXPECT_EQ(pos, obj3->getCursorPos());
+  EXPECT_EQ(obj1.getComponentInstances(), obj3->getComponentInstances());
+  EXPECT_EQ(obj1.getNetSegments(), obj3->getNetSegments());
+  EXPECT_EQ(obj1.getSymbolInstances(), obj3->getSymbolInstances());
+  EXPECT_EQ(obj1.getPolygons(), obj3->getPolygons());
+  EXPECT_EQ(obj1.getTexts(), obj3->getTexts());
 }
 
 /*******************************************************************************
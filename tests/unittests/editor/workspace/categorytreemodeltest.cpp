@@ -78,8 +78,11 @@ protected:
     return s + "]";
   }
 
-  QVector<Item> getItems(const CategoryTreeModel& model,
+  QVector<Item> getItems(CategoryTreeModel& model,
                          const QModelIndex& index = QModelIndex()) {
+    if (model.canFetchMore(index)) {
+      model.fetchMore(index);
+    }
     QVector<Item> items;
     for (int i = 0; i < model.rowCount(index); ++i) {
       QModelIndex child = model.index(i, 0, index);
@@ -146,12 +149,39 @@ TEST_F(CategoryTreeModelTest, testData) {
   EXPECT_EQ("cat 1", str(i1.data(Qt::DisplayRole)));
   EXPECT_EQ("desc 1", str(i1.data(Qt::ToolTipRole)));
   EXPECT_EQ(str(uuid(1)), str(i1.data(Qt::UserRole)));
+  model.fetchMore(i1);
   QModelIndex i2 = model.index(0, 0, i1);
   EXPECT_EQ("cat 2", str(i2.data(Qt::DisplayRole)));
   EXPECT_EQ("", str(i2.data(Qt::ToolTipRole)));
   EXPECT_EQ(str(uuid(2)), str(i2.data(Qt::UserRole)));
 }
 
+TEST_F(CategoryTreeModelTest, testLazyLoading) {
+  // - cat 1
+  //   - cat 2
+  int cat = mWriter->addCategory<ComponentCategory>(
+      0, toAbs("cat1"), uuid(1), version("0.1"), false, tl::nullopt);
+  mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 1"),
+                                             tl::nullopt, tl::nullopt);
+  cat = mWriter->addCategory<ComponentCategory>(0, toAbs("cat2"), uuid(2),
+                                                version("0.1"), false, uuid(1));
+  mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 2"),
+                                             tl::nullopt, tl::nullopt);
+
+  CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::CmpCat);
+  QModelIndex i1 = model.index(0, 0);
+  EXPECT_TRUE(model.hasChildren(i1));
+  EXPECT_TRUE(model.canFetchMore(i1));
+  EXPECT_EQ(0, model.rowCount(i1));
+
+  model.fetchMore(i1);
+  EXPECT_FALSE(model.canFetchMore(i1));
+  ASSERT_EQ(1, model.rowCount(i1));
+  QModelIndex i2 = model.index(0, 0, i1);
+  EXPECT_EQ("cat 2", str(i2.data(Qt::DisplayRole)));
+  EXPECT_FALSE(model.hasChildren(i2));
+}
+
 TEST_F(CategoryTreeModelTest, testComponentCategories) {
   // - cat 1
   //   - cat 2